@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "cinn/ir/buffer.h"
 #include "cinn/ir/collect_ir_nodes.h"
@@ -26,6 +27,7 @@
 #include "cinn/ir/ir_base.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/ir_schedule_util.h"
 #include "cinn/ir/lowered_func.h"
 #include "cinn/ir/tensor.h"
 #include "cinn/lang/lower.h"
@@ -89,6 +91,11 @@ std::unordered_set<std::string> GetOutputNamesFromLoweredFunc(const std::vector<
   return result;
 }
 
+bool OnlyIndexLastDim(const std::vector<ir::Expr>& indices, const std::string& var_name) {
+  if (indices.empty()) return true;
+  return !ir::ContainVar(std::vector<ir::Expr>(indices.begin(), indices.end() - 1), var_name);
+}
+
 bool NeedsMultiLevelTiling(const ir::ScheduleBlockRealize& sche_block_realize) {
   const ir::ScheduleBlock* sche_block = sche_block_realize.schedule_block.As<ir::ScheduleBlock>();
   if (sche_block->write_buffers.size() != 1 || sche_block->read_buffers.empty()) {
@@ -16,6 +16,7 @@
 
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "cinn/ir/ir.h"
 #include "cinn/ir/ir_base.h"
@@ -39,6 +40,11 @@ std::unordered_set<std::string> GetOutputNamesFromLoweredFunc(const std::vector<
  */
 bool NeedsMultiLevelTiling(const ir::ScheduleBlockRealize& sche_block_realize);
 
+/**
+ * Check whether the var only appears in the last index of the accessed tensor, or does not appear at all
+ */
+bool OnlyIndexLastDim(const std::vector<ir::Expr>& indices, const std::string& var_name);
+
 /**
  * Update a LoweredFunc by regenerating related fields with a new function body
  */
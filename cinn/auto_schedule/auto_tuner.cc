@@ -18,6 +18,8 @@
 #include <pybind11/embed.h>
 
 #include <algorithm>
+#include <chrono>
+#include <limits>
 #include <memory>
 #include <utility>
 
@@ -46,26 +48,32 @@ void AutoTuner::Initialize(const Config& config, hlir::framework::GraphCompiler*
   runner_            = std::make_unique<SimpleRunner>(config.runner_repeat_times);
   schedule_measurer_ = std::make_unique<ScheduleMeasurer>(builder_.get(), runner_.get());
 
-  // initialize database
-  database_ = std::move(Database::Make(config.database_config));
-
   // create tasks
   TaskCreator task_creator;
-  tasks_ = task_creator.CreateTuneTaskOpLevel(graph_);
+  subgraph_tasks_ = task_creator.CreateTuneTaskOpLevel(graph_);
 
   const auto& dtype_dict = graph_->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
   const auto& shape_dict = graph_->GetAttrs<absl::flat_hash_map<std::string, hlir::framework::shape_t>>("infershape");
 
   op_lowerer_                        = std::make_unique<hlir::framework::OpLowerer>(dtype_dict, shape_dict, target_);
   InitialTaskRegistry* task_registry = InitialTaskRegistry::Global();
+  for (auto&& task : subgraph_tasks_) {
+    task.Initialize(shape_dict, dtype_dict, op_lowerer_.get());
+  }
+  // the identical sub-graphs are tuned once
+  tasks_ = task_creator.MergeDuplicateTasks(subgraph_tasks_, &tuned_task_ids_);
+  tuned_function_groups_.assign(tasks_.size(), FunctionGroup());
   for (auto i = 0; i < tasks_.size(); ++i) {
     auto&& task = tasks_[i];
-    task.Initialize(shape_dict, dtype_dict, op_lowerer_.get());
     // Register the initial ModuleExpr corresponding to the task
     task_registry->Regist(task.serialized_key, ir::ModuleExpr(task.GetLoweredFuncBodyExprs()));
-    VLOG(3) << "Add a task, id:" << i << ", serialized_key:\n" << task.serialized_key;
+    VLOG(3) << "Add a task, id:" << i << ", multiplicity:" << task.multiplicity << ", serialized_key:\n"
+            << task.serialized_key;
   }
 
+  // initialize database after the tasks are registered, so the records of them and their similar tasks are loaded
+  database_ = std::move(Database::Make(config.database_config));
+
   // create task optimizers
   utils::LinearRandomEngine::StateType initial_seed = utils::LinearRandomEngine::GetDeviceRandomValue();
   task_optimizers_.resize(tasks_.size());
@@ -129,35 +137,108 @@ TuningResult AutoTuner::Tune(const TuningOptions& options) {
   CHECK_GT(options.num_tuning_rounds, 0) << "Invalid config";
   VLOG(3) << "Begin tuning with round num=" << options.num_tuning_rounds << ", tasks size=" << tasks_.size();
 
-  TuningResult result;
-  result.subgraphs.resize(tasks_.size());
-  result.function_groups.resize(tasks_.size());
-  // A task only tunes schedule now, so we populate its sub_graph
-  // as default result of graph tuning, and that should be updated
-  // once we support graph tuning.
-  for (auto i = 0; i < tasks_.size(); ++i) {
-    auto&& task         = tasks_.at(i);
-    result.subgraphs[i] = task.subgraph;
+  using Clock = std::chrono::steady_clock;
+
+  auto start = Clock::now();
+  // no more task is scheduled and the measurement in progress stops once the time budget is exhausted
+  auto deadline = Clock::time_point::max();
+  if (options.time_budget_seconds > 0) {
+    auto budget = std::chrono::duration<double>(options.time_budget_seconds);
+    deadline    = start + std::chrono::duration_cast<Clock::duration>(budget);
   }
 
-  for (int r = 0; r < options.num_tuning_rounds; ++r) {
+  int total_trials = 0;
+  bool exhausted   = false;
+  for (int r = 0; r < options.num_tuning_rounds && !exhausted; ++r) {
     VLOG(3) << "<<<<<< Round " << r << " >>>>>>";
     int run_id = -1;
     task_scheduler_->Reset();
     while ((run_id = task_scheduler_->NextTaskId()) != -1) {
+      if (Clock::now() >= deadline) {
+        LOG(INFO) << "The time budget of tuning is exhausted, return the best results found so far";
+        exhausted = true;
+        break;
+      }
       VLOG(3) << "Start tuning Task-" << run_id;
       auto* opt           = task_optimizers_.at(run_id).get();
-      auto function_group = opt->Optimize(options);
+      auto function_group = opt->Optimize(options, deadline);
       VLOG(3) << "Task-" << run_id << " finished, print optimized functions:\n";
       PrintResult(function_group);
+      task_scheduler_->UpdateTaskCost(run_id, opt->BestCost(), opt->NumTrials());
       // update the best schedules searched so far.
-      result.function_groups.at(run_id) = std::move(function_group);
+      tuned_function_groups_.at(run_id) = std::move(function_group);
+
+      total_trials += opt->NumTrials();
+      ReportProgress(r, run_id, total_trials, std::chrono::duration<double>(Clock::now() - start).count());
     }
   }
 
+  TuningResult result = BestResult();
   PrintResult(result);
   return result;
 }
 
+TuningResult AutoTuner::BestResult() {
+  TuningResult result;
+  result.subgraphs.resize(subgraph_tasks_.size());
+  result.function_groups.resize(subgraph_tasks_.size());
+  // A task only tunes schedule now, so we populate its sub_graph
+  // as default result of graph tuning, and that should be updated
+  // once we support graph tuning.
+  for (auto i = 0; i < subgraph_tasks_.size(); ++i) {
+    auto&& task         = subgraph_tasks_.at(i);
+    result.subgraphs[i] = task.subgraph;
+  }
+
+  // share the tuned results to the identical sub-graphs
+  for (auto i = 0; i < subgraph_tasks_.size(); ++i) {
+    int task_id = tuned_task_ids_.at(i);
+    if (tuned_function_groups_.at(task_id).empty()) {
+      result.function_groups[i] = LowerWithManualSchedule(&subgraph_tasks_[i]);
+    } else if (subgraph_tasks_[i].subgraph == tasks_.at(task_id).subgraph) {
+      result.function_groups[i] = tuned_function_groups_.at(task_id);
+    } else {
+      result.function_groups[i] = task_optimizers_.at(task_id)->ShareResult(&subgraph_tasks_[i]);
+    }
+  }
+  return result;
+}
+
+void AutoTuner::ReportProgress(int round, int task_id, int total_trials, double elapsed_seconds) {
+  if (observers_.empty()) {
+    return;
+  }
+  const auto* opt = task_optimizers_.at(task_id).get();
+  TuningProgress progress;
+  progress.round           = round;
+  progress.task_id         = task_id;
+  progress.num_trials      = opt->NumTrials();
+  progress.total_trials    = total_trials;
+  progress.best_cost       = opt->BestCost();
+  progress.converged       = opt->Converged();
+  progress.elapsed_seconds = elapsed_seconds;
+
+  // estimate the end-to-end gain by the tasks measured with both the manual and the best schedules
+  auto is_measured     = [](double cost) { return cost > 0.0 && cost < std::numeric_limits<double>::max(); };
+  double initial_total = 0.0;
+  double tuned_total   = 0.0;
+  for (auto i = 0; i < tasks_.size(); ++i) {
+    double initial_cost = task_optimizers_[i]->InitialCost();
+    double best_cost    = task_optimizers_[i]->BestCost();
+    progress.best_costs.push_back(best_cost);
+    if (is_measured(initial_cost) && is_measured(best_cost)) {
+      initial_total += tasks_[i].multiplicity * initial_cost;
+      tuned_total += tasks_[i].multiplicity * best_cost;
+    }
+  }
+  if (tuned_total > 0.0) {
+    progress.estimated_gain = initial_total / tuned_total;
+  }
+
+  for (auto&& observer : observers_) {
+    observer(progress);
+  }
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -54,13 +54,29 @@ class AutoTuner {
   // Perform the tuning process and return the final result
   TuningResult Tune(const TuningOptions& options);
 
+  // Add an observer notified of the progress every time a task is tuned
+  void AddObserver(const TuningObserver& observer) { observers_.push_back(observer); }
+
+  // Return the best result found so far, it can be called by an observer during tuning to take an anytime
+  // result, and the sub-graphs whose tasks are not tuned yet are lowered with the manual schedule
+  TuningResult BestResult();
+
  private:
+  // Notify the observers of the progress after a task is tuned
+  void ReportProgress(int round, int task_id, int total_trials, double elapsed_seconds);
+
   const common::Target& target_;
   hlir::framework::Graph* graph_;
   std::unique_ptr<hlir::framework::OpLowerer> op_lowerer_;
 
-  // Tasks to tune
+  // Tasks of all the sub-graphs in the graph
+  std::vector<TuneTask> subgraph_tasks_;
+  // Index of the task in tasks_ tuned on behalf of each sub-graph
+  std::vector<int> tuned_task_ids_;
+  // Tasks to tune, each one is tuned on behalf of the sub-graphs identical to it
   std::vector<TuneTask> tasks_;
+  // The best functions of each task searched so far, empty if the task is not tuned yet
+  std::vector<FunctionGroup> tuned_function_groups_;
   // Scheduler that select a task to tune at every turn.
   std::unique_ptr<TaskScheduler> task_scheduler_;
   // The actor to perform auto-tune, each optimizer take a task.
@@ -73,6 +89,9 @@ class AutoTuner {
 
   // The database to store tuning record
   std::unique_ptr<Database> database_;
+
+  // The observers of the tuning progress
+  std::vector<TuningObserver> observers_;
 };
 
 }  // namespace auto_schedule
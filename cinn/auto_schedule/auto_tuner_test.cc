@@ -15,11 +15,22 @@
 #include "cinn/auto_schedule/auto_tuner.h"
 
 #include <glog/logging.h>
+#include <google/protobuf/util/json_util.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
 
+#include "cinn/auto_schedule/auto_schedule.pb.h"
+#include "cinn/auto_schedule/cost_model/expr_cost_model.h"
+#include "cinn/auto_schedule/database/jsonfile_database.h"
+#include "cinn/auto_schedule/task/task_registry.h"
 #include "cinn/common/target.h"
 #include "cinn/frontend/net_builder.h"
 #include "cinn/frontend/optimize.h"
@@ -29,6 +40,8 @@
 #include "cinn/hlir/framework/node.h"
 #include "cinn/hlir/framework/pass.h"
 #include "cinn/ir/ir_base.h"
+#include "cinn/ir/schedule_desc.h"
+#include "cinn/optim/ir_copy.h"
 #include "cinn/runtime/flags.h"
 
 DECLARE_bool(auto_schedule_use_cost_model);
@@ -160,5 +173,324 @@ TEST_F(TestAutoTuner, NonZeroMeasure_EnableCostModel) {
   NonZeroMeasure();
 }
 
+TEST(AutoTuner, ShareResultToIdenticalSubgraphs) {
+  FLAGS_cinn_ir_schedule             = true;
+  FLAGS_auto_schedule_use_cost_model = false;
+#ifdef CINN_WITH_CUDA
+  Target target = common::DefaultNVGPUTarget();
+#else
+  Target target = common::DefaultHostTarget();
+#endif
+  // three additions identical except for the variable names, each one is a sub-graph without fusion
+  frontend::NetBuilder builder("test");
+  auto a   = builder.CreateInput(Float(32), {64, 128}, "A");
+  auto b   = builder.CreateInput(Float(32), {64, 128}, "B");
+  auto out = a;
+  for (int i = 0; i < 3; ++i) {
+    out = builder.Add(out, b);
+  }
+  auto graph          = std::make_shared<Graph>(builder.Build(), std::unordered_set<std::string>{out->id}, target);
+  auto scope          = BuildScope(target, graph);
+  auto graph_compiler = std::make_unique<GraphCompiler>(target, scope, graph);
+
+  AutoTuner tuner(target, graph.get());
+  AutoTuner::Config tuning_config;
+  tuning_config.task_schedule_strategy = "gradient_priority";
+  tuner.Initialize(tuning_config, graph_compiler.get());
+  TuningOptions tuning_options;
+  tuning_options.num_measure_trials = 0;
+  auto result                       = tuner.Tune(tuning_options);
+
+  ASSERT_EQ(result.subgraphs.size(), 3UL);
+  ASSERT_EQ(result.function_groups.size(), 3UL);
+  for (auto i = 0; i < result.subgraphs.size(); ++i) {
+    ASSERT_EQ(result.function_groups[i].size(), 1UL);
+    // the shared functions are generated for their own sub-graphs
+    ASSERT_EQ(result.function_groups[i][0]->name, result.subgraphs[i]->GetFuncName());
+  }
+
+  GraphCompiler::CompileOptions compile_options;
+  compile_options.with_instantiate_variables = true;
+  compile_options.Apply(result);
+  auto runtime_program = graph_compiler->Build(compile_options).runtime_program;
+  ASSERT_EQ(3, runtime_program->size());
+  if (target == common::DefaultHostTarget()) {
+    auto* a_data = scope->GetTensor("A")->mutable_data<float>(target);
+    auto* b_data = scope->GetTensor("B")->mutable_data<float>(target);
+    for (int i = 0; i < 64 * 128; ++i) {
+      a_data[i] = i % 7;
+      b_data[i] = i % 5;
+    }
+    runtime_program->Execute();
+    const float* out_data = scope->GetTensor(out->id)->data<float>();
+    for (int i = 0; i < 64 * 128; ++i) {
+      ASSERT_FLOAT_EQ(out_data[i], a_data[i] + 3 * b_data[i]);
+    }
+  }
+}
+
+// The number of trials measured until a candidate within 5% of the best one is found, the records of the
+// task are picked from the record file by the shape of its variables
+int TrialsToNearBest(const std::string& record_file_path, const std::string& shape_str) {
+  std::vector<double> costs;
+  for (auto&& line : ReadLinesFromFile(record_file_path)) {
+    proto::TuningRecord record;
+    CHECK(google::protobuf::util::JsonStringToMessage(line, &record).ok()) << "Failed to parse JSON: " << line;
+    if (record.task_key().find(shape_str) != std::string::npos) {
+      costs.push_back(record.execution_cost());
+    }
+  }
+  CHECK(!costs.empty()) << "No record of the task with shape " << shape_str;
+  double best = *std::min_element(costs.begin(), costs.end());
+  int trials  = 1;
+  while (costs[trials - 1] > best * 1.05) {
+    ++trials;
+  }
+  return trials;
+}
+
+TEST(AutoTuner, TransferFromSimilarShapes) {
+  FLAGS_cinn_ir_schedule             = true;
+  FLAGS_auto_schedule_use_cost_model = true;
+#ifdef CINN_WITH_CUDA
+  Target target = common::DefaultNVGPUTarget();
+#else
+  Target target = common::DefaultHostTarget();
+#endif
+  // the warm tuning of each shape shares the records of the shapes tuned before
+  std::string warm_file_path = "/tmp/transfer_warm_records.json";
+  std::remove(warm_file_path.c_str());
+  for (int extent : {64, 96, 128, 192}) {
+    std::vector<int> trials;
+    for (bool warm : {false, true}) {
+      std::string record_file_path = warm ? warm_file_path : "/tmp/transfer_cold_records.json";
+      if (!warm) {
+        std::remove(record_file_path.c_str());
+      }
+      frontend::NetBuilder builder("transfer");
+      auto a              = builder.CreateInput(Float(32), {extent, extent}, "A");
+      auto b              = builder.CreateInput(Float(32), {extent, extent}, "B");
+      auto c              = builder.Relu(builder.Add(a, b));
+      auto program        = builder.Build();
+      auto graph          = cinn::frontend::Optimize(&program, {c->id}, target);
+      auto scope          = BuildScope(target, graph);
+      auto graph_compiler = std::make_unique<GraphCompiler>(target, scope, graph);
+
+      AutoTuner tuner(target, graph.get());
+      AutoTuner::Config tuning_config;
+      tuning_config.database_config.type             = DatabaseType::kJSONFile;
+      tuning_config.database_config.record_file_path = record_file_path;
+      tuner.Initialize(tuning_config, graph_compiler.get());
+      TuningOptions tuning_options;
+      tuning_options.num_measure_trials        = 8;
+      tuning_options.num_samples_per_iteration = 2;
+      tuner.Tune(tuning_options);
+
+      auto shape_str = "[" + std::to_string(extent) + "," + std::to_string(extent) + "]";
+      trials.push_back(TrialsToNearBest(record_file_path, shape_str));
+    }
+    LOG(INFO) << "Trials to within 5% of the best with extent " << extent << ": cold=" << trials[0]
+              << ", warm=" << trials[1];
+  }
+}
+
+// Build an AutoTuner on the graph of Add+Relu with the specific database config
+struct AddReluTuner {
+  std::shared_ptr<Graph> graph;
+  std::shared_ptr<Scope> scope;
+  std::unique_ptr<GraphCompiler> graph_compiler;
+  std::unique_ptr<AutoTuner> tuner;
+
+  AddReluTuner(const Target& target, const DatabaseConfig& database_config) {
+    frontend::NetBuilder builder("budget");
+    auto a         = builder.CreateInput(Float(32), {128, 128}, "A");
+    auto b         = builder.CreateInput(Float(32), {128, 128}, "B");
+    auto c         = builder.Relu(builder.Add(a, b));
+    auto program   = builder.Build();
+    graph          = cinn::frontend::Optimize(&program, {c->id}, target);
+    scope          = BuildScope(target, graph);
+    graph_compiler = std::make_unique<GraphCompiler>(target, scope, graph);
+    tuner          = std::make_unique<AutoTuner>(target, graph.get());
+
+    AutoTuner::Config tuning_config;
+    tuning_config.database_config = database_config;
+    tuner->Initialize(tuning_config, graph_compiler.get());
+  }
+};
+
+TEST(AutoTuner, TimeBudgetWithObserver) {
+  FLAGS_cinn_ir_schedule             = true;
+  FLAGS_auto_schedule_use_cost_model = false;
+#ifdef CINN_WITH_CUDA
+  Target target = common::DefaultNVGPUTarget();
+#else
+  Target target = common::DefaultHostTarget();
+#endif
+  AddReluTuner add_relu(target, DatabaseConfig());
+  std::vector<TuningProgress> progresses;
+  add_relu.tuner->AddObserver([&](const TuningProgress& progress) {
+    LOG(INFO) << "Round " << progress.round << ", task " << progress.task_id << ": trials=" << progress.num_trials
+              << ", total trials=" << progress.total_trials << ", best cost=" << progress.best_cost
+              << ", estimated gain=" << progress.estimated_gain << ", elapsed=" << progress.elapsed_seconds << "s";
+    progresses.push_back(progress);
+    // the anytime result is available during tuning
+    auto result = add_relu.tuner->BestResult();
+    ASSERT_EQ(result.function_groups.size(), 1UL);
+    ASSERT_FALSE(result.function_groups[0].empty());
+  });
+
+  // far more rounds than the budget allows
+  TuningOptions tuning_options;
+  tuning_options.num_tuning_rounds         = 1000;
+  tuning_options.num_measure_trials        = 2;
+  tuning_options.num_samples_per_iteration = 2;
+  tuning_options.time_budget_seconds       = 3.0;
+  auto result                              = add_relu.tuner->Tune(tuning_options);
+
+  ASSERT_FALSE(progresses.empty());
+  ASSERT_LT(progresses.size(), 1000UL);
+  for (size_t i = 1; i < progresses.size(); ++i) {
+    ASSERT_GE(progresses[i].total_trials, progresses[i - 1].total_trials);
+    ASSERT_LE(progresses[i].best_costs[0], progresses[i - 1].best_costs[0]);
+  }
+  ASSERT_GE(progresses.back().estimated_gain, 1.0);
+
+  GraphCompiler::CompileOptions compile_options;
+  compile_options.with_instantiate_variables = true;
+  compile_options.Apply(result);
+  auto runtime_program = add_relu.graph_compiler->Build(compile_options).runtime_program;
+  runtime_program->Execute();
+}
+
+TEST(AutoTuner, EarlyStoppingAndResume) {
+  FLAGS_cinn_ir_schedule             = true;
+  FLAGS_auto_schedule_use_cost_model = false;
+#ifdef CINN_WITH_CUDA
+  Target target = common::DefaultNVGPUTarget();
+#else
+  Target target = common::DefaultHostTarget();
+#endif
+  DatabaseConfig database_config;
+  database_config.type             = DatabaseType::kJSONFile;
+  database_config.record_file_path = "/tmp/early_stopping_records.json";
+  std::remove(database_config.record_file_path.c_str());
+
+  TuningOptions tuning_options;
+  tuning_options.num_measure_trials        = 20;
+  tuning_options.num_samples_per_iteration = 2;
+  // no improvement is large enough, so the measurement stops after the first iteration
+  tuning_options.early_stopping_patience        = 1;
+  tuning_options.early_stopping_min_improvement = 1.0f;
+  int num_trials                                = 0;
+  {
+    AddReluTuner add_relu(target, database_config);
+    std::vector<TuningProgress> progresses;
+    add_relu.tuner->AddObserver([&](const TuningProgress& progress) { progresses.push_back(progress); });
+    add_relu.tuner->Tune(tuning_options);
+    ASSERT_EQ(progresses.size(), 1UL);
+    ASSERT_TRUE(progresses[0].converged);
+    ASSERT_GT(progresses[0].num_trials, 0);
+    ASSERT_LE(progresses[0].num_trials, tuning_options.num_samples_per_iteration);
+    num_trials = progresses[0].num_trials;
+  }
+
+  // the best cost of the searched candidates, excluding the records of the manual schedule
+  double best_cost = std::numeric_limits<double>::max();
+  for (auto&& line : ReadLinesFromFile(database_config.record_file_path)) {
+    proto::TuningRecord record;
+    CHECK(google::protobuf::util::JsonStringToMessage(line, &record).ok()) << "Failed to parse JSON: " << line;
+    if (InitialTaskRegistry::Global()->Has(record.task_key())) {
+      best_cost = std::min(best_cost, record.execution_cost());
+    }
+  }
+
+  // the interrupted tuning resumes from the records, the recorded trials are not measured again
+  tuning_options.early_stopping_patience   = 0;
+  tuning_options.num_measure_trials        = num_trials;
+  tuning_options.num_samples_per_iteration = 1;
+  tuning_options.resume_from_database      = true;
+  {
+    AddReluTuner add_relu(target, database_config);
+    std::vector<TuningProgress> progresses;
+    add_relu.tuner->AddObserver([&](const TuningProgress& progress) { progresses.push_back(progress); });
+    add_relu.tuner->Tune(tuning_options);
+    ASSERT_EQ(progresses.size(), 1UL);
+    ASSERT_EQ(progresses[0].num_trials, 0);
+    ASSERT_LE(progresses[0].best_cost, best_cost);
+  }
+}
+
+TEST(AutoTuner, CostModelRankingOnRecords) {
+  FLAGS_cinn_ir_schedule             = true;
+  FLAGS_auto_schedule_use_cost_model = false;
+#ifdef CINN_WITH_CUDA
+  Target target = common::DefaultNVGPUTarget();
+#else
+  Target target = common::DefaultHostTarget();
+#endif
+  // record the measured candidates of a task
+  std::string record_file_path = "/tmp/cost_model_ranking_records.json";
+  std::remove(record_file_path.c_str());
+  frontend::NetBuilder builder("ranking");
+  auto a              = builder.CreateInput(Float(32), {256, 256}, "A");
+  auto b              = builder.CreateInput(Float(32), {256, 256}, "B");
+  auto c              = builder.Relu(builder.Add(a, b));
+  auto program        = builder.Build();
+  auto graph          = cinn::frontend::Optimize(&program, {c->id}, target);
+  auto scope          = BuildScope(target, graph);
+  auto graph_compiler = std::make_unique<GraphCompiler>(target, scope, graph);
+
+  AutoTuner tuner(target, graph.get());
+  AutoTuner::Config tuning_config;
+  tuning_config.database_config.type             = DatabaseType::kJSONFile;
+  tuning_config.database_config.record_file_path = record_file_path;
+  tuner.Initialize(tuning_config, graph_compiler.get());
+  TuningOptions tuning_options;
+  tuning_options.num_measure_trials        = 32;
+  tuning_options.num_samples_per_iteration = 8;
+  tuner.Tune(tuning_options);
+
+  // replay the recorded traces on the initial ModuleExpr of the task
+  std::vector<ir::ModuleExpr> samples;
+  std::vector<float> labels;
+  for (auto&& line : ReadLinesFromFile(record_file_path)) {
+    proto::TuningRecord record;
+    CHECK(google::protobuf::util::JsonStringToMessage(line, &record).ok()) << "Failed to parse JSON: " << line;
+    // skip the records of the manual schedule, which are stored with prefixed keys
+    if (!InitialTaskRegistry::Global()->Has(record.task_key())) {
+      continue;
+    }
+    ir::IRSchedule ir_sch(optim::IRCopy(InitialTaskRegistry::Global()->Get(record.task_key())->module_expr));
+    ir::ScheduleDesc::ReplayWithProto(record.trace(), &ir_sch);
+    samples.push_back(ir_sch.GetModule());
+    labels.push_back(record.execution_cost());
+  }
+  ASSERT_GE(samples.size(), 4UL);
+
+  // train on the first half of the records in measured order and evaluate on the second half
+  size_t num_train = samples.size() / 2;
+  std::vector<const ir::ModuleExpr*> train_samples, test_samples;
+  for (size_t i = 0; i < samples.size(); ++i) {
+    (i < num_train ? train_samples : test_samples).push_back(&samples[i]);
+  }
+  std::vector<float> train_labels(labels.begin(), labels.begin() + num_train);
+  std::vector<float> test_labels(labels.begin() + num_train, labels.end());
+  std::map<FeatureVersion, float> test_accuracies;
+  for (FeatureVersion version : {FeatureVersion::kV1, FeatureVersion::kV2}) {
+    ExprCostModel cost_model(version);
+    cost_model.Train(train_samples, train_labels, target);
+    float train_accuracy = cost_model.RankingAccuracy(train_samples, train_labels, target);
+    float test_accuracy  = cost_model.RankingAccuracy(test_samples, test_labels, target);
+    LOG(INFO) << "Ranking accuracy of feature version " << static_cast<int>(version) << " on " << train_samples.size()
+              << " trained and " << test_samples.size() << " held-out recorded candidates: " << train_accuracy
+              << ", " << test_accuracy;
+    // the model learns the ranking of the candidates it is trained with better than a random guess
+    ASSERT_GT(train_accuracy, 0.5f);
+    test_accuracies[version] = test_accuracy;
+  }
+  // the memory access features added in kV2 don't rank the held-out candidates worse
+  ASSERT_GE(test_accuracies[FeatureVersion::kV2], test_accuracies[FeatureVersion::kV1]);
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -17,6 +17,8 @@
 #include <glog/logging.h>
 
 #include <atomic>
+#include <fstream>
+#include <string>
 #include <vector>
 
 #include "cinn/auto_schedule/cost_model/feature.h"
@@ -34,7 +36,7 @@ float ExprCostModel::Predict(const ir::ModuleExpr& sample, const common::Target&
   }
   FeatureExtractor extractor;
   Feature feature                    = extractor.Extract(sample, target);
-  std::vector<float> feature_numbers = feature.ToFixedSizeVector();
+  std::vector<float> feature_numbers = feature.ToFixedSizeVector(feature_version_);
   std::vector<float> pred            = XgbCostModel::Predict({feature_numbers});
   return pred[0];
 }
@@ -50,7 +52,7 @@ void ExprCostModel::Train(const std::vector<const ir::ModuleExpr*>& samples,
   for (size_t i = 0; i < total_size; ++i) {
     CHECK(samples[i] != nullptr) << "Train samples cannot be nullptr";
     Feature feature          = extractor.Extract(*samples[i], target);
-    train_feature_numbers[i] = feature.ToFixedSizeVector();
+    train_feature_numbers[i] = feature.ToFixedSizeVector(feature_version_);
   }
 
   XgbCostModel::Train(train_feature_numbers, labels);
@@ -67,11 +69,59 @@ void ExprCostModel::Update(const std::vector<const ir::ModuleExpr*>& samples,
   for (size_t i = 0; i < total_size; ++i) {
     CHECK(samples[i] != nullptr) << "Train samples cannot be nullptr";
     Feature feature          = extractor.Extract(*samples[i], target);
-    train_feature_numbers[i] = feature.ToFixedSizeVector();
+    train_feature_numbers[i] = feature.ToFixedSizeVector(feature_version_);
   }
 
   XgbCostModel::Update(train_feature_numbers, labels);
 }
 
+void ExprCostModel::Save(const std::string& path) {
+  XgbCostModel::Save(path);
+  std::ofstream version_file(path + ".feature_version");
+  CHECK(version_file.is_open()) << "Failed to open file: " << path << ".feature_version";
+  version_file << static_cast<int>(feature_version_);
+}
+
+void ExprCostModel::Load(const std::string& path) {
+  XgbCostModel::Load(path);
+  trained_times_.store(1);
+  feature_version_ = FeatureVersion::kV1;
+  std::ifstream version_file(path + ".feature_version");
+  int version;
+  if (version_file.is_open() && version_file >> version) {
+    CHECK(version >= static_cast<int>(FeatureVersion::kV1) && version <= static_cast<int>(FeatureVersion::kLatest))
+        << "Unsupported feature version " << version << " of the model " << path;
+    feature_version_ = static_cast<FeatureVersion>(version);
+  }
+  // the features of another version don't match the ones the model is trained with
+  CHECK_EQ(NumFeatures(), Feature::FixedSizeVectorLength(feature_version_))
+      << "The model " << path << " is trained with " << NumFeatures() << " features, which mismatches the "
+      << Feature::FixedSizeVectorLength(feature_version_) << " features of version "
+      << static_cast<int>(feature_version_);
+  VLOG(3) << "Load the model " << path << " with feature version " << static_cast<int>(feature_version_);
+}
+
+float ExprCostModel::RankingAccuracy(const std::vector<const ir::ModuleExpr*>& samples,
+                                     const std::vector<float>& labels,
+                                     const common::Target& target) const {
+  CHECK_EQ(samples.size(), labels.size()) << "Samples must have same size as labels";
+  std::vector<float> predictions;
+  for (const ir::ModuleExpr* sample : samples) {
+    CHECK(sample != nullptr) << "Evaluated samples cannot be nullptr";
+    predictions.push_back(Predict(*sample, target));
+  }
+  int num_pairs = 0, num_ordered_pairs = 0;
+  for (size_t i = 0; i < labels.size(); ++i) {
+    for (size_t j = i + 1; j < labels.size(); ++j) {
+      if (labels[i] == labels[j]) continue;
+      ++num_pairs;
+      if ((labels[i] < labels[j]) == (predictions[i] < predictions[j])) {
+        ++num_ordered_pairs;
+      }
+    }
+  }
+  return num_pairs > 0 ? static_cast<float>(num_ordered_pairs) / num_pairs : 1.0f;
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -15,8 +15,10 @@
 #pragma once
 
 #include <atomic>
+#include <string>
 #include <vector>
 
+#include "cinn/auto_schedule/cost_model/feature.h"
 #include "cinn/auto_schedule/cost_model/xgb_cost_model.h"
 #include "cinn/ir/ir_schedule.h"
 
@@ -29,6 +31,8 @@ namespace auto_schedule {
  */
 class ExprCostModel : public XgbCostModel {
  public:
+  ExprCostModel(FeatureVersion feature_version = FeatureVersion::kLatest) : feature_version_(feature_version) {}
+
   virtual float Predict(const ir::ModuleExpr& sample, const common::Target& target) const;
   void Train(const std::vector<const ir::ModuleExpr*>& samples,
              const std::vector<float>& labels,
@@ -37,8 +41,23 @@ class ExprCostModel : public XgbCostModel {
               const std::vector<float>& labels,
               const common::Target& target);
 
+  // Save the model with the version of its features in a file named path + ".feature_version"
+  void Save(const std::string& path) override;
+  // Load a model and the version of its features, the models saved without the version use FeatureVersion::kV1.
+  // The number of features the model is trained with must match the version.
+  void Load(const std::string& path) override;
+
+  // Evaluate the ranking of the samples by the predicted costs, return the ratio of the pairs of samples with
+  // different labels that are ordered the same by the predicted costs as by the labels
+  float RankingAccuracy(const std::vector<const ir::ModuleExpr*>& samples,
+                        const std::vector<float>& labels,
+                        const common::Target& target) const;
+
+  FeatureVersion feature_version() const { return feature_version_; }
+
  private:
   std::atomic<int> trained_times_{0};
+  FeatureVersion feature_version_;
 };
 
 }  // namespace auto_schedule
@@ -0,0 +1,115 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/cost_model/expr_cost_model.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <pybind11/embed.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "cinn/cinn.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/lang/lower.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// Schedules of an elementwise computation whose inner loop is split by different factors
+std::vector<ir::ModuleExpr> CreateSplitSamples(const common::Target& target, const std::vector<int>& factors) {
+  Expr M(64);
+  Expr N(64);
+  Placeholder<float> A("A", {M, N});
+  Placeholder<float> B("B", {M, N});
+  ir::Tensor C = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) + B(i, j); }, "C");
+
+  std::vector<ir::ModuleExpr> samples;
+  for (int factor : factors) {
+    auto stages = CreateStages({C});
+    auto funcs  = lang::LowerVec("test_expr_cost_model", stages, {A, B, C}, {}, {}, nullptr, target, true);
+    ir::IRSchedule ir_schedule(ir::ModuleExpr({funcs[0]->body}));
+    ir_schedule.Split(ir_schedule.GetLoops("C")[1], {-1, factor});
+    samples.push_back(ir_schedule.GetModule());
+  }
+  return samples;
+}
+
+TEST(ExprCostModel, SaveAndLoadFeatureVersion) {
+  Target target                       = common::DefaultHostTarget();
+  std::vector<ir::ModuleExpr> samples = CreateSplitSamples(target, {1, 2, 4, 8, 16, 32, 64});
+  std::vector<const ir::ModuleExpr*> sample_ptrs;
+  std::vector<float> labels;
+  for (size_t i = 0; i < samples.size(); ++i) {
+    sample_ptrs.push_back(&samples[i]);
+    labels.push_back(1.0f / (i + 1));
+  }
+
+  std::string path = "./test_expr_cost_model.cpp_save_model";
+  for (FeatureVersion version : {FeatureVersion::kV1, FeatureVersion::kV2}) {
+    ExprCostModel cost_model(version);
+    cost_model.Train(sample_ptrs, labels, target);
+    float accuracy = cost_model.RankingAccuracy(sample_ptrs, labels, target);
+    LOG(INFO) << "Ranking accuracy on the training samples with feature version " << static_cast<int>(version)
+              << ": " << accuracy;
+    ASSERT_GE(accuracy, 0.0f);
+    ASSERT_LE(accuracy, 1.0f);
+    cost_model.Save(path);
+
+    // the loaded model predicts with the version of the features it is trained with
+    ExprCostModel load_cost_model;
+    load_cost_model.Load(path);
+    ASSERT_EQ(load_cost_model.feature_version(), version);
+    for (auto* sample : sample_ptrs) {
+      ASSERT_FLOAT_EQ(cost_model.Predict(*sample, target), load_cost_model.Predict(*sample, target));
+    }
+  }
+
+  // a model saved without the version is an old one using kV1
+  ExprCostModel old_cost_model(FeatureVersion::kV1);
+  old_cost_model.Train(sample_ptrs, labels, target);
+  old_cost_model.Save(path);
+  std::remove((path + ".feature_version").c_str());
+  ExprCostModel load_cost_model;
+  load_cost_model.Load(path);
+  ASSERT_EQ(load_cost_model.feature_version(), FeatureVersion::kV1);
+  ASSERT_FLOAT_EQ(old_cost_model.Predict(samples[0], target), load_cost_model.Predict(samples[0], target));
+
+  // a model whose recorded version mismatches its features or is unknown is rejected
+  for (std::string version : {"2", "3"}) {
+    std::ofstream(path + ".feature_version") << version;
+    ASSERT_DEATH(ExprCostModel().Load(path), "");
+  }
+  std::remove((path + ".feature_version").c_str());
+  std::remove(path.c_str());
+}
+
+TEST(ExprCostModel, RankingAccuracy) {
+  Target target                       = common::DefaultHostTarget();
+  std::vector<ir::ModuleExpr> samples = CreateSplitSamples(target, {1, 2});
+  ExprCostModel cost_model;
+  cost_model.Train({&samples[0], &samples[1]}, {1.0f, 2.0f}, target);
+  // no pair of samples has different labels
+  ASSERT_FLOAT_EQ(cost_model.RankingAccuracy({&samples[0], &samples[1]}, {1.0f, 1.0f}, target), 1.0f);
+  // the ratio of the ordered pairs is either 0 or 1 with two samples
+  float accuracy = cost_model.RankingAccuracy({&samples[0], &samples[1]}, {1.0f, 2.0f}, target);
+  ASSERT_TRUE(accuracy == 0.0f || accuracy == 1.0f);
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
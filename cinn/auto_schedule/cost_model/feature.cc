@@ -29,6 +29,10 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "cinn/common/target.h"
@@ -48,7 +52,7 @@ Feature::Feature(const common::Target& target)
       current_loop_block_index_(0),
       parent_indices_(1, -1) {}
 
-std::vector<float> Feature::ToFixedSizeVector() {
+std::vector<float> Feature::ToFixedSizeVector(FeatureVersion version) {
   std::vector<float> ret(LoopBlockFeature::kTotalSize + 1, 0);  // LoopBlockFeature::kTotalSize plus 1 for target
 
   if (target_ == common::DefaultNVGPUTarget()) {
@@ -151,6 +155,11 @@ std::vector<float> Feature::ToFixedSizeVector() {
     ++j;
   }
 
+  if (static_cast<int>(version) >= static_cast<int>(FeatureVersion::kV2)) {
+    std::vector<float> memory_access_features = MemoryAccessFeatures();
+    ret.insert(ret.end(), memory_access_features.begin(), memory_access_features.end());
+  }
+
   for (size_t i = 0; i < ret.size(); ++i) {
     ret[i] = slog(ret[i]);
   }
@@ -158,6 +167,14 @@ std::vector<float> Feature::ToFixedSizeVector() {
   return ret;
 }
 
+int Feature::FixedSizeVectorLength(FeatureVersion version) {
+  int length = LoopBlockFeature::kTotalSize + 1;
+  if (static_cast<int>(version) >= static_cast<int>(FeatureVersion::kV2)) {
+    length += kMemoryAccessSize;
+  }
+  return length;
+}
+
 void Feature::IntoLoopBlock() {
   stack_encoded_feature_.emplace_back(LoopBlockFeature());
   stack_encoded_feature_[current_loop_block_index_].num_sub_loops += 1;
@@ -171,5 +188,178 @@ LoopBlockFeature& Feature::CurrentLoopBlock() { return stack_encoded_feature_[cu
 
 const LoopBlockFeature& Feature::CurrentLoopBlock() const { return stack_encoded_feature_[current_loop_block_index_]; }
 
+void Feature::AddBufferAccess(BufferAccess access) { buffer_accesses_.emplace_back(std::move(access)); }
+
+// Capacities of the cache levels in bytes from the innermost one, a target with fewer levels repeats its last
+// level cache
+static std::vector<double> CacheCapacities(const common::Target& target) {
+  if (target.arch == common::Target::Arch::NVGPU) {
+    return {128 * 1024.0, 6 * 1024 * 1024.0, 6 * 1024 * 1024.0};
+  }
+  return {32 * 1024.0, 1024 * 1024.0, 32 * 1024 * 1024.0};
+}
+
+// The stride of an access on its innermost enclosing loop in elements, kUnknownCoefficient if it is not constant
+static int64_t InnermostStride(const BufferAccess& access) {
+  int64_t stride = 0;
+  int64_t step   = 1;
+  for (int d = static_cast<int>(access.shape.size()) - 1; d >= 0; --d) {
+    int64_t coefficient = access.coefficients[d].back();
+    if (coefficient == BufferAccess::kUnknownCoefficient || (coefficient != 0 && step <= 0)) {
+      return BufferAccess::kUnknownCoefficient;
+    }
+    stride += coefficient * step;
+    step = access.shape[d] > 0 ? step * access.shape[d] : -1;
+  }
+  return std::abs(stride);
+}
+
+std::vector<float> Feature::MemoryAccessFeatures() const {
+  std::vector<float> ret(kMemoryAccessSize, 0);
+  int num_blocks = stack_encoded_feature_.size();
+
+  // the number of executions of the body of each loop block, an unknown loop length is counted as 1, and the
+  // height of each loop block, which is 0 for a loop without sub-loops
+  std::vector<double> num_executions(num_blocks, 1);
+  std::vector<int> heights(num_blocks, 0);
+  for (int i = 1; i < num_blocks; ++i) {
+    num_executions[i] = num_executions[parent_indices_[i]] * std::max(1, stack_encoded_feature_[i].loop_length);
+  }
+  for (int i = num_blocks - 1; i > 0; --i) {
+    heights[parent_indices_[i]] = std::max(heights[parent_indices_[i]], heights[i] + 1);
+  }
+
+  // unique bytes of each buffer touched by one execution of each loop block, the union of the accesses to a
+  // buffer is approximated by the largest one, and the bytes accessed directly in each loop block
+  std::vector<std::unordered_map<std::string, double>> unique_bytes(num_blocks);
+  std::vector<double> direct_bytes(num_blocks, 0);
+  auto record_unique_bytes = [&unique_bytes](const BufferAccess& access, const std::vector<double>& ranges, int i) {
+    double bytes = access.element_bytes;
+    for (double range : ranges) {
+      bytes *= range;
+    }
+    double& value = unique_bytes[i][access.buffer_name];
+    value         = std::max(value, bytes);
+  };
+  for (const BufferAccess& access : buffer_accesses_) {
+    const std::vector<int>& loops = access.loop_block_indices;
+    direct_bytes[loops.empty() ? 0 : loops.back()] += access.element_bytes;
+    // the range of each dimension grows from the innermost loop to the outermost one
+    std::vector<double> ranges(access.shape.size(), 1);
+    for (int k = static_cast<int>(loops.size()) - 1; k >= 0; --k) {
+      int length = std::max(1, stack_encoded_feature_[loops[k]].loop_length);
+      for (size_t d = 0; d < ranges.size(); ++d) {
+        int64_t coefficient = access.coefficients[d][k];
+        if (coefficient == BufferAccess::kUnknownCoefficient) {
+          ranges[d] = access.shape[d] > 0 ? access.shape[d] : ranges[d] * length;
+        } else {
+          ranges[d] += std::abs(coefficient) * static_cast<double>(length - 1);
+        }
+        if (access.shape[d] > 0) {
+          ranges[d] = std::min<double>(ranges[d], access.shape[d]);
+        }
+      }
+      record_unique_bytes(access, ranges, loops[k]);
+    }
+    record_unique_bytes(access, ranges, 0);
+  }
+  std::vector<double> footprints(num_blocks, 0);
+  for (int i = 0; i < num_blocks; ++i) {
+    for (auto&& buffer_bytes : unique_bytes[i]) {
+      footprints[i] += buffer_bytes.second;
+    }
+  }
+
+  // accessed bytes, stride categories and the most executed access of each buffer
+  struct BufferFeature {
+    double accessed_bytes = 0;
+    double max_executions = 0;
+    int64_t stride        = 0;
+  };
+  std::unordered_map<std::string, BufferFeature> buffer_features;
+  for (const BufferAccess& access : buffer_accesses_) {
+    const std::vector<int>& loops = access.loop_block_indices;
+    double executions             = num_executions[loops.empty() ? 0 : loops.back()];
+    double bytes                  = executions * access.element_bytes;
+    ret[access.is_write ? 1 : 0] += bytes;
+
+    int64_t stride = loops.empty() ? 0 : InnermostStride(access);
+    if (!loops.empty()) {
+      if (stride == 1) {
+        ret[2] += executions;
+      } else if (stride == 0) {
+        ret[3] += executions;
+      } else if (stride != BufferAccess::kUnknownCoefficient) {
+        ret[4] += executions;
+      } else {
+        ret[5] += executions;
+      }
+    }
+
+    BufferFeature& buffer = buffer_features[access.buffer_name];
+    buffer.accessed_bytes += bytes;
+    if (executions > buffer.max_executions) {
+      buffer.max_executions = executions;
+      buffer.stride         = stride;
+    }
+  }
+  int j = 6;
+
+  // a loop whose footprint fits in a cache level but its parent's does not loads its footprint from the next
+  // level in each execution, and the accesses directly in a loop that does not fit always go to the next level
+  std::vector<double> capacities = CacheCapacities(target_);
+  for (int c = 0; c < kNumCacheLevels; ++c) {
+    for (int i = 0; i < num_blocks; ++i) {
+      bool fits = footprints[i] <= capacities[c];
+      if (fits && (i == 0 || footprints[parent_indices_[i]] > capacities[c])) {
+        ret[j] += (i == 0 ? 1 : num_executions[parent_indices_[i]]) * footprints[i];
+      } else if (!fits) {
+        ret[j] += num_executions[i] * direct_bytes[i];
+      }
+    }
+    ++j;
+  }
+  double memory_traffic = ret[j - 1];
+
+  double float_ops = 0;
+  for (int i = 0; i < num_blocks; ++i) {
+    const LoopBlockFeature& loop_feature = stack_encoded_feature_[i];
+    float_ops += num_executions[i] *
+                 (loop_feature.float_add_or_sub + loop_feature.float_mul + loop_feature.float_div_or_mod +
+                  loop_feature.float_cmp + loop_feature.float_math_func + loop_feature.float_reduce_sum_or_sub +
+                  loop_feature.float_reduce_mul + loop_feature.float_reduce_div + loop_feature.float_reduce_max_or_min);
+  }
+  ret[j] = footprints[0];
+  ++j;
+  ret[j] = float_ops / std::max(1.0, memory_traffic);
+  ++j;
+
+  std::vector<std::pair<std::string, BufferFeature>> sorted_buffers(buffer_features.begin(), buffer_features.end());
+  std::sort(sorted_buffers.begin(), sorted_buffers.end(), [](const auto& lhs, const auto& rhs) {
+    if (lhs.second.accessed_bytes != rhs.second.accessed_bytes) {
+      return lhs.second.accessed_bytes > rhs.second.accessed_bytes;
+    }
+    return lhs.first < rhs.first;
+  });
+  for (int b = 0; b < kNumBufferFeatures; ++b, j += 4) {
+    if (b >= static_cast<int>(sorted_buffers.size())) continue;
+    const BufferFeature& buffer = sorted_buffers[b].second;
+    double buffer_unique_bytes  = unique_bytes[0].at(sorted_buffers[b].first);
+    ret[j]                      = buffer.accessed_bytes;
+    ret[j + 1]                  = buffer_unique_bytes;
+    // an unknown stride is counted as the unique bytes of the buffer
+    ret[j + 2] = buffer.stride == BufferAccess::kUnknownCoefficient ? buffer_unique_bytes : buffer.stride;
+    ret[j + 3] = buffer.accessed_bytes / std::max(1.0, buffer_unique_bytes);
+  }
+
+  for (int i = 1; i < num_blocks; ++i) {
+    ret[j + std::min(heights[i], kNumLoopLevels - 1)] += num_executions[parent_indices_[i]] * footprints[i];
+  }
+  j += kNumLoopLevels;
+  CHECK_EQ(j, kMemoryAccessSize);
+
+  return ret;
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
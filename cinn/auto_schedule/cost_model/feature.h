@@ -15,6 +15,9 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
 #include <vector>
 
 #include "cinn/common/target.h"
@@ -23,6 +26,13 @@
 namespace cinn {
 namespace auto_schedule {
 
+/* Version of the fixed-size feature vector. A cost model must predict with the version of the features it
+ * was trained with, so a new version only appends features and the older ones are kept unchanged.
+ *   kV1: arithmetic, memory operation, reduce/broadcast, loop type and thread features
+ *   kV2: kV1 plus the memory access features, see Feature::MemoryAccessFeatures
+ */
+enum class FeatureVersion : int { kV1 = 1, kV2 = 2, kLatest = kV2 };
+
 /* Loop feature enums */
 enum class ForOptimizeFeatureEnum : int { kNone, kGpuBind, kParallel, kUnroll, kVectorize };
 
@@ -117,6 +127,22 @@ class LoopBlockFeature {
   int loop_length = 1;
 };
 
+/* A load or store of a buffer, collected to compute the memory access features */
+struct BufferAccess {
+  std::string buffer_name;
+  int element_bytes = 0;
+  bool is_write     = false;
+  // Extents of the buffer dimensions, -1 represents unknown
+  std::vector<int64_t> shape;
+  // Indices of the loop blocks of the loops enclosing the access, from outer to inner
+  std::vector<int> loop_block_indices;
+  // coefficients[d][k] is the coefficient of the k-th enclosing loop var in the index of the d-th dimension,
+  // kUnknownCoefficient if the index is not affine on the loop vars
+  std::vector<std::vector<int64_t>> coefficients;
+
+  static constexpr int64_t kUnknownCoefficient = std::numeric_limits<int64_t>::min();
+};
+
 /**
  * Feature of Expr. It is used in CostModel
  */
@@ -127,7 +153,9 @@ class Feature {
   Feature(const common::Target& target);
 
   // Convert the various-length loop block features to fixed-size vector
-  std::vector<float> ToFixedSizeVector();
+  std::vector<float> ToFixedSizeVector(FeatureVersion version = FeatureVersion::kV1);
+  // Length of the fixed-size vector of the features in a version
+  static int FixedSizeVectorLength(FeatureVersion version);
 
   // Call when visit into a loop block to collect LoopBlockFeature
   void IntoLoopBlock();
@@ -137,8 +165,34 @@ class Feature {
   LoopBlockFeature& CurrentLoopBlock();
   // The current loop block which we should collect feature on
   const LoopBlockFeature& CurrentLoopBlock() const;
+  // Index of the current loop block in the stack encoded features
+  int CurrentLoopBlockIndex() const { return current_loop_block_index_; }
+  // Record a buffer access, it belongs to the loop block of its innermost enclosing loop
+  void AddBufferAccess(BufferAccess access);
+
+  // Number of the cache levels whose traffic is estimated
+  static constexpr int kNumCacheLevels = 3;
+  // Number of the buffers with the most accessed bytes whose features are encoded
+  static constexpr int kNumBufferFeatures = 4;
+  // Number of the loop levels counted from the innermost loops whose unique bytes are encoded
+  static constexpr int kNumLoopLevels = 4;
+  // Size of the memory access features appended in FeatureVersion::kV2
+  static constexpr int kMemoryAccessSize = 6 + kNumCacheLevels + 2 + 4 * kNumBufferFeatures + kNumLoopLevels;
 
  private:
+  // Compute the memory access features from the buffer accesses, they are:
+  //   bytes read and written by all the executions of the accesses,
+  //   number of the executed accesses whose stride on the innermost enclosing loop is 1 (contiguous),
+  //   0 (reused), greater than 1 (strided) or unknown,
+  //   bytes transferred from the next level of each cache level, estimated by the cache residency of loops,
+  //   unique bytes touched by the whole computation and the arithmetic intensity on the main memory traffic,
+  //   accessed bytes, unique bytes, innermost stride and reuse ratio of the buffers with the most accessed bytes,
+  //   unique bytes touched by all the executions of the loops at each level counted from the innermost
+  std::vector<float> MemoryAccessFeatures() const;
+
+  // The buffer accesses collected by the feature extractor
+  std::vector<BufferAccess> buffer_accesses_;
+
   // We treat a computation feature to be encoded as variable-length vector.
   // The root compute block is not a loop, but we treat it as a size-1 loop.
   // Blocks are encoded like a stack. Each LoopBlockFeature contains a
@@ -27,6 +27,8 @@
 
 #include "cinn/auto_schedule/cost_model/feature_extractor.h"
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
 #include "cinn/common/target.h"
@@ -49,6 +51,9 @@ void FeatureExtractor::Visit(const Expr *x) { IRVisitor::Visit(x); }
 
 Feature FeatureExtractor::Extract(const ir::ModuleExpr &mod_expr, const common::Target &target) {
   feature_ = Feature(target);
+  loop_var_names_.clear();
+  loop_block_indices_.clear();
+  iter_var_coefficients_.clear();
   for (const ir::Expr &e : mod_expr.GetExprs()) {
     Visit(&e);
   }
@@ -75,7 +80,6 @@ VisitDoNothing(_Module_);
 VisitDoNothing(_Var_);
 VisitDoNothing(_LoweredFunc_);
 VisitDoNothing(ScheduleBlock);
-VisitDoNothing(ScheduleBlockRealize);
 VisitDoNothing(Ramp);
 VisitDoNothing(_Buffer_);
 VisitDoNothing(_BufferRange_);
@@ -156,13 +160,130 @@ VisitCountMemberPattern(IfThenElse, select_op);
 VisitCountMemberPattern(Select, select_op);
 VisitCountMemberPattern(Alloc, mem_alloc);
 VisitCountMemberPattern(Free, mem_free);
-VisitCountMemberPattern(Load, mem_read);
-VisitCountMemberPattern(Store, mem_write);
+
+/* Visit for memory accesses */
+
+void FeatureExtractor::Visit(const ScheduleBlockRealize *x) {
+  const ScheduleBlock *schedule_block = x->schedule_block.As<ScheduleBlock>();
+  if (schedule_block) {
+    for (size_t i = 0; i < schedule_block->iter_vars.size() && i < x->iter_values.size(); ++i) {
+      iter_var_coefficients_[schedule_block->iter_vars[i]->name] = GetLoopCoefficients(x->iter_values[i]);
+    }
+  }
+  std::vector<const Expr *> sub_exprs = x->expr_fields();
+  for (const Expr *e : sub_exprs) {
+    if (e->defined()) {
+      Visit(e);
+    }
+  }
+}
+
+void FeatureExtractor::Visit(const Load *x) {
+  feature_.CurrentLoopBlock().mem_read += 1;
+  AddBufferAccess(x->tensor, x->indices, false);
+  std::vector<const Expr *> sub_exprs = x->expr_fields();
+  for (const Expr *e : sub_exprs) {
+    if (e->defined()) {
+      Visit(e);
+    }
+  }
+}
+
+void FeatureExtractor::Visit(const Store *x) {
+  feature_.CurrentLoopBlock().mem_write += 1;
+  AddBufferAccess(x->tensor, x->indices, true);
+  std::vector<const Expr *> sub_exprs = x->expr_fields();
+  for (const Expr *e : sub_exprs) {
+    if (e->defined()) {
+      Visit(e);
+    }
+  }
+}
+
+void FeatureExtractor::AddBufferAccess(const Expr &tensor, const std::vector<Expr> &indices, bool is_write) {
+  const _Tensor_ *tensor_node = tensor.as_tensor();
+  if (!tensor_node) return;
+
+  BufferAccess access;
+  access.buffer_name        = tensor_node->buffer.defined() ? tensor_node->buffer->name : tensor_node->name;
+  access.element_bytes      = std::max(1, (tensor_node->type().bits() + 7) / 8);
+  access.is_write           = is_write;
+  access.loop_block_indices = loop_block_indices_;
+  for (size_t d = 0; d < indices.size(); ++d) {
+    const Expr &extent = d < tensor_node->shape.size() ? tensor_node->shape[d] : Expr();
+    access.shape.push_back(extent.defined() && extent.is_constant() ? static_cast<int64_t>(extent.get_constant()) : -1);
+    access.coefficients.emplace_back(GetLoopCoefficients(indices[d]));
+  }
+  feature_.AddBufferAccess(std::move(access));
+}
+
+std::vector<int64_t> FeatureExtractor::GetLoopCoefficients(const Expr &index) const {
+  const int64_t kUnknown = BufferAccess::kUnknownCoefficient;
+  std::vector<int64_t> ret(loop_var_names_.size(), 0);
+  if (!index.defined()) return ret;
+
+  if (const _Var_ *var = index.As<_Var_>()) {
+    for (int k = static_cast<int>(loop_var_names_.size()) - 1; k >= 0; --k) {
+      if (loop_var_names_[k] == var->name) {
+        ret[k] = 1;
+        return ret;
+      }
+    }
+    auto it = iter_var_coefficients_.find(var->name);
+    if (it != iter_var_coefficients_.end()) {
+      std::copy_n(it->second.begin(), std::min(it->second.size(), ret.size()), ret.begin());
+    }
+    return ret;
+  }
+  if (index.As<Cast>()) {
+    return GetLoopCoefficients(index.As<Cast>()->v());
+  }
+  if (index.As<Minus>()) {
+    ret = GetLoopCoefficients(index.As<Minus>()->v());
+    for (int64_t &coefficient : ret) {
+      coefficient = coefficient == kUnknown ? kUnknown : -coefficient;
+    }
+    return ret;
+  }
+  if (index.As<Add>() || index.As<Sub>()) {
+    int sign = index.As<Add>() ? 1 : -1;
+    auto lhs = GetLoopCoefficients(index.As<Add>() ? index.As<Add>()->a() : index.As<Sub>()->a());
+    auto rhs = GetLoopCoefficients(index.As<Add>() ? index.As<Add>()->b() : index.As<Sub>()->b());
+    for (size_t k = 0; k < ret.size(); ++k) {
+      ret[k] = lhs[k] == kUnknown || rhs[k] == kUnknown ? kUnknown : lhs[k] + sign * rhs[k];
+    }
+    return ret;
+  }
+  if (index.As<Mul>()) {
+    const Expr &a = index.As<Mul>()->a();
+    const Expr &b = index.As<Mul>()->b();
+    if (a.As<IntImm>() || b.As<IntImm>()) {
+      int64_t factor = a.As<IntImm>() ? a.As<IntImm>()->value : b.As<IntImm>()->value;
+      ret            = GetLoopCoefficients(a.As<IntImm>() ? b : a);
+      for (int64_t &coefficient : ret) {
+        coefficient = coefficient == kUnknown ? kUnknown : coefficient * factor;
+      }
+      return ret;
+    }
+  }
+  // the loop vars in other expressions, such as division, are not affine
+  for (const Expr *field : index.ptr()->expr_fields()) {
+    auto sub_coefficients = GetLoopCoefficients(*field);
+    for (size_t k = 0; k < ret.size(); ++k) {
+      if (sub_coefficients[k] != 0) {
+        ret[k] = kUnknown;
+      }
+    }
+  }
+  return ret;
+}
 
 /* Visit for loops */
 
 void FeatureExtractor::Visit(const For *x) {
   feature_.IntoLoopBlock();
+  loop_var_names_.push_back(x->loop_var->name);
+  loop_block_indices_.push_back(feature_.CurrentLoopBlockIndex());
 
   LoopBlockFeature &loop_feature = feature_.CurrentLoopBlock();
   if (x->min.is_constant() && x->extent.is_constant()) {
@@ -207,6 +328,8 @@ void FeatureExtractor::Visit(const For *x) {
     Visit(e);
   }
 
+  loop_var_names_.pop_back();
+  loop_block_indices_.pop_back();
   feature_.ExitLoopBlock();
 }
 
@@ -27,6 +27,10 @@
 
 #pragma once
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "cinn/auto_schedule/cost_model/feature.h"
 #include "cinn/common/target.h"
 #include "cinn/ir/ir.h"
@@ -53,7 +57,18 @@ class FeatureExtractor : public ir::IRVisitor {
 #undef __
 
  private:
+  // Record a load or store of the tensor with the indices in the feature
+  void AddBufferAccess(const Expr& tensor, const std::vector<Expr>& indices, bool is_write);
+  // Get the coefficients of the enclosing loop vars in an index, a coefficient is BufferAccess::kUnknownCoefficient
+  // if the loop var is in a non-affine part of the index
+  std::vector<int64_t> GetLoopCoefficients(const Expr& index) const;
+
   Feature feature_;
+  // Names of the loop vars of the enclosing loops from outer to inner, and the indices of their loop blocks
+  std::vector<std::string> loop_var_names_;
+  std::vector<int> loop_block_indices_;
+  // Coefficients of the loop vars in the values bound to the iter vars of the visited schedule blocks
+  std::unordered_map<std::string, std::vector<int64_t>> iter_var_coefficients_;
 };
 
 }  // namespace auto_schedule
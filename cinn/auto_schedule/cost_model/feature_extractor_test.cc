@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 #include <pybind11/embed.h>
 
+#include <algorithm>
 #include <cmath>
 #include <unordered_set>
 #include <vector>
@@ -154,5 +155,67 @@ TEST(FeatureExtractor, MatrixMultiply) {
   ASSERT_EQ(to_check[37], slog(out_loop));
 }
 
+TEST(FeatureExtractor, MemoryAccess) {
+  Context::Global().ResetNameId();
+  Target target = common::DefaultHostTarget();
+  ir::Expr M(32);
+  ir::Expr N(32);
+
+  lang::Placeholder<float> A("A", {M, N});
+  ir::Tensor B = lang::Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j); }, "B");
+  ir::Tensor C = lang::Compute(
+      {M, N}, [&](Var i, Var j) { return A(j, i); }, "C");
+
+  auto extract = [&](ir::Tensor tensor, FeatureVersion version) {
+    poly::StageMap stages = poly::CreateStages({A, tensor});
+    std::vector<ir::LoweredFunc> funcs =
+        lang::LowerVec("MemoryAccess", stages, {A, tensor}, {}, {}, nullptr, target, true);
+    ir::ModuleExpr mod_expr({funcs[0]->body});
+    FeatureExtractor extractor;
+    return extractor.Extract(mod_expr, target).ToFixedSizeVector(version);
+  };
+
+  // the features of kV2 are appended to the ones of kV1
+  std::vector<float> v1_features = extract(B, FeatureVersion::kV1);
+  std::vector<float> to_check    = extract(B, FeatureVersion::kV2);
+  ASSERT_EQ(to_check.size(), static_cast<size_t>(LoopBlockFeature::kTotalSize + 1 + Feature::kMemoryAccessSize));
+  ASSERT_TRUE(std::equal(v1_features.begin(), v1_features.end(), to_check.begin()));
+
+  int base          = LoopBlockFeature::kTotalSize + 1;
+  float total_bytes = M.get_constant() * N.get_constant() * 4;
+  // bytes read and written
+  ASSERT_EQ(to_check[base], slog(total_bytes));
+  ASSERT_EQ(to_check[base + 1], slog(total_bytes));
+  // all the accesses are contiguous
+  ASSERT_EQ(to_check[base + 2], slog(M.get_constant() * N.get_constant() * 2));
+  ASSERT_EQ(to_check[base + 3], 0);
+  ASSERT_EQ(to_check[base + 4], 0);
+  ASSERT_EQ(to_check[base + 5], 0);
+  // the footprint fits in the caches, so each byte is transferred once
+  for (int c = 0; c < Feature::kNumCacheLevels; ++c) {
+    ASSERT_EQ(to_check[base + 6 + c], slog(total_bytes * 2));
+  }
+  // unique bytes, and no arithmetic
+  ASSERT_EQ(to_check[base + 9], slog(total_bytes * 2));
+  ASSERT_EQ(to_check[base + 10], 0);
+  // accessed bytes, unique bytes, innermost stride and reuse ratio of A and B
+  for (int b = 0; b < 2; ++b) {
+    ASSERT_EQ(to_check[base + 11 + 4 * b], slog(total_bytes));
+    ASSERT_EQ(to_check[base + 12 + 4 * b], slog(total_bytes));
+    ASSERT_EQ(to_check[base + 13 + 4 * b], slog(1));
+    ASSERT_EQ(to_check[base + 14 + 4 * b], slog(1));
+  }
+  // the unique bytes of all the executions of the inner loop and the outer loop
+  int loop_level_offset = base + 11 + 4 * Feature::kNumBufferFeatures;
+  ASSERT_EQ(to_check[loop_level_offset], slog(total_bytes * 2));
+  ASSERT_EQ(to_check[loop_level_offset + 1], slog(total_bytes * 2));
+
+  // the transposed read of A is strided by a row on the inner loop
+  to_check = extract(C, FeatureVersion::kV2);
+  ASSERT_EQ(to_check[base + 2], slog(M.get_constant() * N.get_constant()));
+  ASSERT_EQ(to_check[base + 4], slog(M.get_constant() * N.get_constant()));
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
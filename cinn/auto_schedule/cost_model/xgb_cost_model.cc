@@ -131,5 +131,7 @@ void XgbCostModel::Save(const std::string& path) { xgb_booster_.attr("save_model
 
 void XgbCostModel::Load(const std::string& path) { xgb_booster_.attr("load_model")(pybind11::str(path)); }
 
+int XgbCostModel::NumFeatures() const { return xgb_booster_.attr("num_features")().cast<int>(); }
+
 }  // namespace auto_schedule
 }  // namespace cinn
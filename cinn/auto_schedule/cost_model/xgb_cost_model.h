@@ -57,6 +57,9 @@ class XgbCostModel : public CostModel {
 
   void Load(const std::string& path) override;
 
+  // Number of the features the booster is trained with
+  int NumFeatures() const;
+
  private:
   // Python xgboost module
   pybind11::module xgb_module_;
@@ -18,8 +18,12 @@
 #include <google/protobuf/text_format.h>
 #include <google/protobuf/util/json_util.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "cinn/auto_schedule/database/jsonfile_database.h"
 #include "cinn/auto_schedule/task/task_registry.h"
+#include "cinn/auto_schedule/task/tune_task.h"
 #include "cinn/ir/ir_schedule.h"
 #include "cinn/ir/schedule_desc.h"
 
@@ -56,7 +60,11 @@ std::unique_ptr<Database> Database::Make(const DatabaseConfig& config) {
 
 void Database::Insert(const TuningRecord& record) {
   auto& records = key2record_[record.task_key];
+  if (records.empty()) {
+    similar_key2keys_[SimilarTaskKey(record.task_key)].insert(record.task_key);
+  }
   records.emplace(record);
+  ++key2total_count_[record.task_key];
   if (records.size() > capacity_per_task_) {
     records.erase(std::prev(records.end()));
   }
@@ -102,6 +110,41 @@ std::vector<TuningRecord> Database::GetTopK(const std::string& task_key, int k)
   return results;
 }
 
+std::vector<TuningRecord> Database::GetSimilarTopK(const std::string& task_key, int k) {
+  auto sit = similar_key2keys_.find(SimilarTaskKey(task_key));
+  if (sit == similar_key2keys_.end() || k <= 0) {
+    return {};
+  }
+
+  // the distance between the shapes of two similar tasks is the sum of the log ratios of the extents
+  auto variables   = ParseVariablesFromKey(task_key);
+  auto distance_fn = [&variables](const std::string& other_key) {
+    auto other_variables = ParseVariablesFromKey(other_key);
+    double distance      = 0.0;
+    for (size_t i = 0; i < variables.size(); ++i) {
+      const auto& shape       = variables[i].second;
+      const auto& other_shape = other_variables.at(i).second;
+      for (size_t j = 0; j < shape.size(); ++j) {
+        distance += std::abs(std::log(static_cast<double>(shape[j]) / other_shape.at(j)));
+      }
+    }
+    return distance;
+  };
+  std::vector<std::pair<double, std::string>> similar_keys;
+  for (const std::string& key : sit->second) {
+    if (key != task_key) {
+      similar_keys.emplace_back(distance_fn(key), key);
+    }
+  }
+  std::sort(similar_keys.begin(), similar_keys.end());
+
+  std::vector<TuningRecord> results;
+  for (size_t i = 0; i < similar_keys.size() && results.size() < k; ++i) {
+    results.emplace_back(*key2record_.at(similar_keys[i].second).begin());
+  }
+  return results;
+}
+
 size_t Database::Size() {
   auto res =
       std::accumulate(key2record_.begin(), key2record_.end(), size_t(0), [](size_t res, const auto& kv) -> size_t {
@@ -118,5 +161,13 @@ size_t Database::Count(const std::string& task_key) {
   return fit->second.size();
 }
 
+size_t Database::TotalCount(const std::string& task_key) {
+  auto fit = key2total_count_.find(task_key);
+  if (fit == key2total_count_.end()) {
+    return 0;
+  }
+  return fit->second;
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
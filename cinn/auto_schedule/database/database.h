@@ -14,6 +14,7 @@
 
 #pragma once
 #include <unordered_map>
+#include <unordered_set>
 
 #include "cinn/auto_schedule/auto_schedule.pb.h"
 #include "cinn/auto_schedule/search_space/search_state.h"
@@ -81,10 +82,16 @@ class Database {
   std::vector<TuningRecord> LookUp(const std::string& task_key);
   // return the states of the top k in sorted candidates
   std::vector<TuningRecord> GetTopK(const std::string& task_key, int k);
+  // return the best records of at most k tasks similar to the specified one but with different shapes,
+  // one record for each task, and the tasks with closer shapes to the specified one are in the front
+  std::vector<TuningRecord> GetSimilarTopK(const std::string& task_key, int k);
   // return the total number of stored candidates
   size_t Size();
   // return the number of stored candidates with specified key
   size_t Count(const std::string& task_key);
+  // return the number of candidates ever inserted with specified key, including the ones
+  // dropped beyond the capacity, i.e. the number of measured trials of the task
+  size_t TotalCount(const std::string& task_key);
 
  protected:
   // commit the newly added record into underlying storage
@@ -94,6 +101,10 @@ class Database {
 
   // map task_key to its records
   std::unordered_map<std::string, std::multiset<TuningRecord, TuningRecord::Compare>> key2record_;
+  // map task_key to the number of its records ever inserted
+  std::unordered_map<std::string, size_t> key2total_count_;
+  // map the key shared by similar tasks to their task_keys, see SimilarTaskKey
+  std::unordered_map<std::string, std::unordered_set<std::string>> similar_key2keys_;
   // the max number of candidates stored
   const int capacity_per_task_;
 };
@@ -16,6 +16,7 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
 #include <vector>
 
 #include "cinn/auto_schedule/auto_schedule.pb.h"
@@ -48,6 +49,9 @@ TEST_F(TestDatabase, Basic) {
   // check the max number of stored candidates will
   // be restricted to capacity_per_task
   ASSERT_EQ(test_db.Count("k3"), 2);
+  // but the total count includes the dropped ones
+  ASSERT_EQ(test_db.TotalCount("k3"), 3);
+  ASSERT_EQ(test_db.TotalCount("k5"), 0);
   ASSERT_EQ(records.size(), 2);
   EXPECT_EQ(records[0].execution_cost, 3.0);
   EXPECT_EQ(records[1].execution_cost, 4.0);
@@ -66,5 +70,28 @@ TEST_F(TestDatabase, GetTopK) {
   EXPECT_FLOAT_EQ(records[1].predicted_cost, 1.0);
 }
 
+TEST_F(TestDatabase, GetSimilarTopK) {
+  auto relu_key = [](const std::string& name, int extent) {
+    auto shape = "[" + std::to_string(extent) + "]";
+    return "(" + name + "->float32" + shape + ") = relu(x->float32" + shape + ")";
+  };
+  auto state = SearchState(ir::IRSchedule());
+  test_db.AddRecord(TuningRecord(relu_key("y", 16), state, 2.0));
+  test_db.AddRecord(TuningRecord(relu_key("y", 16), state, 1.0));
+  test_db.AddRecord(TuningRecord(relu_key("z", 256), state, 8.0));
+  test_db.AddRecord(TuningRecord(relu_key("y", 32), state, 4.0));
+  // not similar since the extent is 1
+  test_db.AddRecord(TuningRecord(relu_key("y", 1), state, 0.5));
+
+  ASSERT_TRUE(test_db.GetSimilarTopK("k1", 2).empty());
+  auto records = test_db.GetSimilarTopK(relu_key("y", 32), 3);
+  ASSERT_EQ(records.size(), 2UL);
+  // the best record of the task with the closest shape is in the front
+  EXPECT_EQ(records[0].task_key, relu_key("y", 16));
+  EXPECT_EQ(records[0].execution_cost, 1.0);
+  EXPECT_EQ(records[1].task_key, relu_key("z", 256));
+  ASSERT_EQ(test_db.GetSimilarTopK(relu_key("w", 64), 3).size(), 3UL);
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
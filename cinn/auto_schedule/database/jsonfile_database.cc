@@ -19,9 +19,11 @@
 #include <google/protobuf/util/json_util.h>
 
 #include <fstream>
+#include <unordered_set>
 
 #include "cinn/auto_schedule/auto_schedule.pb.h"
 #include "cinn/auto_schedule/task/task_registry.h"
+#include "cinn/auto_schedule/task/tune_task.h"
 #include "cinn/utils/multi_threading.h"
 
 namespace cinn {
@@ -67,10 +69,15 @@ JSONFileDatabase::JSONFileDatabase(int capacity_per_task, const std::string& rec
   utils::parallel_run(worker_fn, utils::SequenceDispatcher(0, json_lines.size()), -1);
 
   InitialTaskRegistry* task_registry = InitialTaskRegistry::Global();
+  // the records of the tasks similar to the registered ones are also loaded to be transferred
+  std::unordered_set<std::string> similar_keys;
+  for (auto&& registered_key : task_registry->ListAllNames()) {
+    similar_keys.insert(SimilarTaskKey(registered_key));
+  }
 
   for (const auto& record_proto : all_records_proto) {
     std::string task_key = record_proto.task_key();
-    if (task_registry->Has(task_key)) {
+    if (task_registry->Has(task_key) || similar_keys.count(SimilarTaskKey(task_key))) {
       VLOG(4) << "Add a measured TuningRecord with task_key=" << task_key;
       Insert(TuningRecord(record_proto));
     }
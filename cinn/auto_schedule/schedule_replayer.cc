@@ -0,0 +1,98 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/schedule_replayer.h"
+
+#include <glog/logging.h>
+
+#include <utility>
+
+#include "cinn/auto_schedule/task/task_creator.h"
+#include "cinn/auto_schedule/task/task_optimizer.h"
+#include "cinn/auto_schedule/task/task_registry.h"
+#include "cinn/auto_schedule/task/tune_task.h"
+#include "cinn/common/type.h"
+#include "cinn/utils/string.h"
+#include "cinn/utils/timer.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+std::string ScheduleReplayer::Report::DebugString() const {
+  int num_groups = num_replayed + fallback_funcs.size();
+  return utils::StringFormat("Replayed %d of %d sub-graphs, %lu fell back to the manual schedule, costs %f ms",
+                             num_replayed,
+                             num_groups,
+                             fallback_funcs.size(),
+                             replay_time_ms);
+}
+
+ScheduleReplayer::ScheduleReplayer(const common::Target& target, hlir::framework::Graph* graph)
+    : target_(target), graph_(graph) {}
+
+TuningResult ScheduleReplayer::Replay(const DatabaseConfig& database_config) {
+  utils::Timer timer;
+  timer.Start();
+  report_ = Report();
+
+  TaskCreator task_creator;
+  std::vector<TuneTask> tasks = task_creator.CreateTuneTaskOpLevel(graph_);
+
+  const auto& dtype_dict = graph_->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+  const auto& shape_dict = graph_->GetAttrs<absl::flat_hash_map<std::string, hlir::framework::shape_t>>("infershape");
+
+  op_lowerer_ = std::make_unique<hlir::framework::OpLowerer>(dtype_dict, shape_dict, target_);
+  for (auto&& task : tasks) {
+    task.Initialize(shape_dict, dtype_dict, op_lowerer_.get());
+  }
+  // the identical sub-graphs are tuned once on behalf of all, and so are their records
+  std::vector<int> tuned_task_ids;
+  std::vector<TuneTask> tuned_tasks  = task_creator.MergeDuplicateTasks(tasks, &tuned_task_ids);
+  InitialTaskRegistry* task_registry = InitialTaskRegistry::Global();
+  for (auto&& task : tuned_tasks) {
+    task_registry->Regist(task.serialized_key, ir::ModuleExpr(task.GetLoweredFuncBodyExprs()));
+  }
+  // create database after the tasks are registered, so the records of them are loaded
+  auto database = Database::Make(database_config);
+
+  TuningResult result;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    auto&& task            = tasks[i];
+    const auto& tuned_task = tuned_tasks.at(tuned_task_ids[i]);
+    auto records           = database->GetTopK(tuned_task.serialized_key, 1);
+    result.subgraphs.push_back(task.subgraph);
+    if (records.empty()) {
+      VLOG(3) << "No record of sub-graph " << task.subgraph->GetFuncName() << ", lower it with the manual schedule";
+      result.function_groups.push_back(LowerWithManualSchedule(&task));
+      report_.fallback_funcs.push_back(task.subgraph->GetFuncName());
+      continue;
+    }
+
+    VLOG(3) << "Replay the record with cost " << records[0].execution_cost << "us on sub-graph "
+            << task.subgraph->GetFuncName();
+    if (task.subgraph == tuned_task.subgraph) {
+      result.function_groups.push_back(ReplayTrace(records[0].trace, &task));
+    } else {
+      result.function_groups.push_back(ReplayTraceOnIdenticalTask(records[0].trace, &tuned_task, &task));
+    }
+    ++report_.num_replayed;
+  }
+
+  report_.replay_time_ms = timer.Stop();
+  VLOG(3) << report_.DebugString();
+  return result;
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,64 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinn/auto_schedule/database/database.h"
+#include "cinn/auto_schedule/tuning.h"
+#include "cinn/common/target.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/op_lowering.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// This class applies a finished tuning at deploy time: the sub-graphs of a graph are lowered by
+// replaying the best schedules recorded in a tuning database, looked up by the serialized_key of
+// their tasks, without searching, measuring or predicting by the cost model. The sub-graphs without
+// records are lowered with the manual schedule instead.
+class ScheduleReplayer {
+ public:
+  // Statistics of the latest replay
+  struct Report {
+    // the number of sub-graphs lowered with the replayed schedules
+    int num_replayed = 0;
+    // the function names of the sub-graphs lowered with the manual schedule as no record is found
+    std::vector<std::string> fallback_funcs;
+    // the wall-clock time of loading the records and lowering all the sub-graphs in milliseconds
+    double replay_time_ms = 0.0;
+
+    std::string DebugString() const;
+  };
+
+  ScheduleReplayer(const common::Target& target, hlir::framework::Graph* graph);
+
+  // Lower the sub-graphs with the best records of the database created by the config, the result
+  // can be applied by GraphCompiler::CompileOptions::Apply as the one of AutoTuner::Tune
+  TuningResult Replay(const DatabaseConfig& database_config);
+
+  const Report& GetReport() const { return report_; }
+
+ private:
+  const common::Target& target_;
+  hlir::framework::Graph* graph_;
+  std::unique_ptr<hlir::framework::OpLowerer> op_lowerer_;
+  Report report_;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
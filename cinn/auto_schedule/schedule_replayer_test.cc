@@ -0,0 +1,156 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/schedule_replayer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinn/auto_schedule/database/jsonfile_database.h"
+#include "cinn/auto_schedule/search_space/search_state.h"
+#include "cinn/auto_schedule/task/task_creator.h"
+#include "cinn/auto_schedule/task/tune_task.h"
+#include "cinn/common/target.h"
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/op_lowering.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_schedule.h"
+
+DECLARE_bool(cinn_ir_schedule);
+
+namespace cinn {
+namespace auto_schedule {
+
+using ::cinn::hlir::framework::BuildScope;
+using ::cinn::hlir::framework::Graph;
+using ::cinn::hlir::framework::GraphCompiler;
+
+// whether the functions have a loop of the specific constant extent
+bool HasLoopOfExtent(const FunctionGroup& functions, int extent) {
+  for (auto&& func : functions) {
+    auto loops = ir::CollectIRNodesWithoutTensor(func->body, [&](const Expr* x) {
+      return x->As<ir::For>() && x->As<ir::For>()->extent.is_constant() &&
+             x->As<ir::For>()->extent.get_constant() == extent;
+    });
+    if (!loops.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+class TestScheduleReplayer : public ::testing::Test {
+ public:
+  Target target = common::DefaultHostTarget();
+  std::string record_file_path;
+  std::shared_ptr<Graph> graph;
+  std::string output_id;
+
+  void SetUp() override {
+    FLAGS_cinn_ir_schedule = true;
+    record_file_path       = "/tmp/schedule_replayer_records.json";
+    std::remove(record_file_path.c_str());
+    // two additions identical except for the variable names and a relu, each one is a sub-graph without fusion
+    frontend::NetBuilder builder("replay");
+    auto a    = builder.CreateInput(Float(32), {64, 128}, "A");
+    auto b    = builder.CreateInput(Float(32), {64, 128}, "B");
+    auto c    = builder.Add(a, b);
+    auto d    = builder.Add(c, b);
+    auto e    = builder.Relu(d);
+    output_id = e->id;
+    graph     = std::make_shared<Graph>(builder.Build(), std::unordered_set<std::string>{output_id}, target);
+  }
+
+  // record a schedule splitting the outermost loop by 4 for the first addition
+  void RecordSplitSchedule() {
+    TaskCreator task_creator;
+    std::vector<TuneTask> tasks = task_creator.CreateTuneTaskOpLevel(graph.get());
+    ASSERT_EQ(tasks.size(), 3UL);
+    const auto& shape_dict = graph->GetAttrs<absl::flat_hash_map<std::string, hlir::framework::shape_t>>("infershape");
+    const auto& dtype_dict = graph->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+    hlir::framework::OpLowerer op_lowerer(dtype_dict, shape_dict, target);
+    auto&& task = tasks.front();
+    task.Initialize(shape_dict, dtype_dict, &op_lowerer);
+
+    ir::IRSchedule ir_sch(ir::ModuleExpr(task.GetLoweredFuncBodyExprs()));
+    auto loops = ir_sch.GetLoops(ir_sch.GetAllBlocks().front());
+    ir_sch.Split(loops.front(), {4, -1});
+    JSONFileDatabase database(2, record_file_path, true);
+    database.AddRecord(TuningRecord(task.serialized_key, SearchState(ir_sch), 1.0));
+  }
+};
+
+TEST_F(TestScheduleReplayer, ReplayAndFallback) {
+  RecordSplitSchedule();
+  DatabaseConfig database_config;
+  database_config.type             = DatabaseType::kJSONFile;
+  database_config.record_file_path = record_file_path;
+
+  ScheduleReplayer replayer(target, graph.get());
+  auto result = replayer.Replay(database_config);
+  LOG(INFO) << replayer.GetReport().DebugString();
+  // the identical additions share the record, and the relu falls back to the manual schedule
+  ASSERT_EQ(replayer.GetReport().num_replayed, 2);
+  ASSERT_EQ(replayer.GetReport().fallback_funcs.size(), 1UL);
+  ASSERT_EQ(result.subgraphs.size(), 3UL);
+  ASSERT_EQ(result.function_groups.size(), 3UL);
+  for (auto i = 0; i < result.subgraphs.size(); ++i) {
+    ASSERT_EQ(result.function_groups[i].size(), 1UL);
+    ASSERT_EQ(result.function_groups[i][0]->name, result.subgraphs[i]->GetFuncName());
+    ASSERT_EQ(HasLoopOfExtent(result.function_groups[i], 4), i < 2);
+  }
+  ASSERT_EQ(replayer.GetReport().fallback_funcs[0], result.subgraphs[2]->GetFuncName());
+
+  auto scope = BuildScope(target, graph);
+  GraphCompiler graph_compiler(target, scope, graph);
+  GraphCompiler::CompileOptions compile_options;
+  compile_options.with_instantiate_variables = true;
+  compile_options.Apply(result);
+  auto runtime_program = graph_compiler.Build(compile_options).runtime_program;
+  ASSERT_EQ(3, runtime_program->size());
+  auto* a_data = scope->GetTensor("A")->mutable_data<float>(target);
+  auto* b_data = scope->GetTensor("B")->mutable_data<float>(target);
+  for (int i = 0; i < 64 * 128; ++i) {
+    a_data[i] = i % 7 - 5;
+    b_data[i] = i % 5;
+  }
+  runtime_program->Execute();
+  const float* out_data = scope->GetTensor(output_id)->data<float>();
+  for (int i = 0; i < 64 * 128; ++i) {
+    ASSERT_FLOAT_EQ(out_data[i], std::max(a_data[i] + 2 * b_data[i], 0.0f));
+  }
+}
+
+TEST_F(TestScheduleReplayer, NoRecord) {
+  DatabaseConfig database_config;
+  database_config.type             = DatabaseType::kJSONFile;
+  database_config.record_file_path = record_file_path;
+
+  ScheduleReplayer replayer(target, graph.get());
+  auto result = replayer.Replay(database_config);
+  ASSERT_EQ(replayer.GetReport().num_replayed, 0);
+  ASSERT_EQ(replayer.GetReport().fallback_funcs.size(), 3UL);
+  for (auto&& functions : result.function_groups) {
+    ASSERT_FALSE(HasLoopOfExtent(functions, 4));
+  }
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -24,6 +24,12 @@
 namespace cinn {
 namespace auto_schedule {
 
+// check whether the input ir::For is a spatial loop
+bool IsSpatialLoop(const ir::For* for_node);
+
+// count the number of loops that can be binded from the input for_node to bottom
+int CountLoopCanBinded(const ir::For* for_node);
+
 // Auto bind GPU index(BlockIdx, ThreadIdx) to the loops around the block
 class AutoBind : public AutoGenRule {
  public:
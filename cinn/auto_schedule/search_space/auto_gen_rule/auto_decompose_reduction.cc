@@ -0,0 +1,135 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_decompose_reduction.h"
+
+#include <glog/logging.h>
+
+#include "cinn/auto_schedule/analysis/analyze_ir.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_printer.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/ir_schedule_util.h"
+#include "cinn/ir/tensor.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+int AutoDecomposeReduction::GetDecomposeLoop(const ir::IRSchedule& ir_schedule, const Expr& block_expr) const {
+  if (target_->arch != common::Target::Arch::X86) return -1;
+  auto* block_realize   = block_expr.As<ir::ScheduleBlockRealize>();
+  auto* schedule_block  = block_realize->schedule_block.As<ir::ScheduleBlock>();
+  std::string init_name = ir::GenReduceInitTensorNameOf(schedule_block->name);
+  if (!ir_schedule.HasBlock(init_name)) return -1;
+  auto all_loops = ir_schedule.GetLoops(block_expr);
+
+  // the innermost loops are bound to the reduction axes only
+  int first_reduce = all_loops.size();
+  for (int i = static_cast<int>(all_loops.size()) - 1; i >= 0; --i) {
+    const std::string& loop_var_name = all_loops[i].As<ir::For>()->loop_var->name;
+    bool bound_to_reduce             = false;
+    bool bound_to_spatial            = false;
+    for (int j = 0; j < block_realize->iter_values.size(); ++j) {
+      if (!ir::ContainVar({block_realize->iter_values[j]}, loop_var_name)) continue;
+      if (schedule_block->iter_vars[j]->is_reduce_axis) {
+        bound_to_reduce = true;
+      } else {
+        bound_to_spatial = true;
+      }
+    }
+    if (!bound_to_reduce || bound_to_spatial) break;
+    first_reduce = i;
+  }
+  if (first_reduce == 0 || first_reduce == all_loops.size()) return -1;
+
+  // the spatial loop right above contains the reduction and its init only
+  const Expr& loop_expr = all_loops[first_reduce - 1];
+  const ir::For* loop   = loop_expr.As<ir::For>();
+  if (!loop->is_serial() || !loop->extent.is_constant() || loop->extent.as_int32() < 2) return -1;
+  auto blocks_in_loop =
+      ir::CollectIRNodesWithoutTensor(loop_expr, [](const Expr* x) { return x->As<ir::ScheduleBlockRealize>(); });
+  if (blocks_in_loop.size() != 2 || !ir::Contains(loop_expr, ir_schedule.GetBlock(init_name))) return -1;
+
+  // the loop var is bound to a single spatial iter var of the block
+  int bound_index = -1;
+  for (int i = 0; i < block_realize->iter_values.size(); ++i) {
+    if (ir::ContainVar({block_realize->iter_values[i]}, loop->loop_var->name)) {
+      if (bound_index != -1 || !block_realize->iter_values[i].as_var()) return -1;
+      bound_index = i;
+    }
+  }
+  if (bound_index == -1) return -1;
+
+  // the iter var only indexes the last dimension of the tensors, so the loop accesses contiguous elements once it is
+  // the innermost one
+  const std::string& iter_var_name = schedule_block->iter_vars[bound_index]->name;
+  auto stores = ir::CollectIRNodesWithoutTensor(schedule_block->body, [](const Expr* x) { return x->As<ir::Store>(); });
+  if (stores.size() != 1) return -1;
+  const ir::Store* store = stores.begin()->As<ir::Store>();
+  if (store->indices.empty() || !store->indices.back().as_var() ||
+      store->indices.back().as_var()->name != iter_var_name || !OnlyIndexLastDim(store->indices, iter_var_name)) {
+    return -1;
+  }
+  auto loads = ir::CollectIRNodesWithoutTensor(schedule_block->body, [&iter_var_name](const Expr* x) {
+    return x->As<ir::Load>() && !OnlyIndexLastDim(x->As<ir::Load>()->indices, iter_var_name);
+  });
+  if (!loads.empty()) return -1;
+  return first_reduce - 1;
+}
+
+void AutoDecomposeReduction::DecomposeBlock(ir::IRSchedule* ir_schedule, const Expr& block_expr) const {
+  int loop_index = GetDecomposeLoop(*ir_schedule, block_expr);
+  CHECK_GE(loop_index, 0) << "The reduction can't be decomposed:" << block_expr;
+  std::string block_name = block_expr.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->name;
+  ir_schedule->DecomposeReduction(block_expr, ir_schedule->GetLoops(block_expr)[loop_index]);
+
+  // the loops are fetched again since the loop decomposed at is changed
+  auto loops = ir_schedule->GetLoops(block_name);
+  std::vector<Expr> reordered_loops(loops.begin() + loop_index + 1, loops.end());
+  reordered_loops.push_back(loops[loop_index]);
+  ir_schedule->Reorder(reordered_loops);
+}
+
+RuleApplyType AutoDecomposeReduction::Init(ir::IRSchedule* ir_schedule) {
+  ir_schedule_ = ir_schedule;
+  applicable_schedule_blocks_.clear();
+
+  for (auto&& block_realize : ir_schedule->GetAllBlocks()) {
+    if (GetDecomposeLoop(*ir_schedule, block_realize) >= 0) {
+      applicable_schedule_blocks_.emplace_back(block_realize);
+    }
+  }
+  num_applicable_ = applicable_schedule_blocks_.size();
+  VLOG(6) << "Collect applicable_schedule_blocks_:" << num_applicable_;
+  return num_applicable_ > 0 ? RuleApplyType::kApply : RuleApplyType::kCannotApply;
+}
+
+void AutoDecomposeReduction::Apply(int index) {
+  CHECK_LT(index, applicable_schedule_blocks_.size()) << "invalid apply index:" << index;
+  DecomposeBlock(ir_schedule_, applicable_schedule_blocks_.at(index));
+}
+
+RuleApplyType AutoDecomposeReduction::AnalyseApplyType(SearchState state, const std::string& block_name) const {
+  Expr block_expr = state->ir_schedule.GetBlock(block_name);
+  return GetDecomposeLoop(state->ir_schedule, block_expr) >= 0 ? RuleApplyType::kApply : RuleApplyType::kCannotApply;
+}
+
+std::vector<SearchState> AutoDecomposeReduction::ApplyOnBlock(SearchState state, const std::string& block_name) {
+  SearchState new_state = state.Copy();
+  DecomposeBlock(&new_state->ir_schedule, new_state->ir_schedule.GetBlock(block_name));
+  return {new_state};
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
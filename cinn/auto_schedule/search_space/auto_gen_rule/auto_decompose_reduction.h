@@ -0,0 +1,58 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_gen_rule.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_schedule.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// Decompose the init of a reduction block on CPU out of the spatial loop right above its reduction loops by
+// IRSchedule::DecomposeReduction, and reorder the reduction loops outside that spatial loop. The spatial loop
+// should only index the last dimension of the tensors accessed in the block, so it becomes an innermost loop accessing
+// contiguous elements, which can be vectorized by AutoVectorize, such as the columns of matmuls and column reductions.
+class AutoDecomposeReduction : public AutoGenRule {
+ public:
+  AutoDecomposeReduction(const common::Target& target) : AutoGenRule(target) {}
+  ~AutoDecomposeReduction() = default;
+
+  RuleApplyType Init(ir::IRSchedule* init_schedule) override;
+
+  void Apply(int index) override;
+
+  std::string GetRuleName() const override { return "AutoDecomposeReduction"; }
+
+  RuleApplyType AnalyseApplyType(SearchState state, const std::string& block_name) const override;
+
+  std::vector<SearchState> ApplyOnBlock(SearchState state, const std::string& block_name) override;
+
+ private:
+  // Get the index of the loop of a block to decompose the reduction at, -1 if the rule can't be applied
+  int GetDecomposeLoop(const ir::IRSchedule& ir_schedule, const Expr& block_expr) const;
+
+  // Decompose the reduction of a block and move the reduction loops outside the spatial loop
+  void DecomposeBlock(ir::IRSchedule* ir_schedule, const Expr& block_expr) const;
+
+ private:
+  std::vector<Expr> applicable_schedule_blocks_;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,88 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_decompose_reduction.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_vectorize.h"
+#include "cinn/cinn.h"
+#include "cinn/lang/lower.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+TEST(AutoDecomposeReduction, Matmul) {
+  Context::Global().ResetNameId();
+  Target target = common::DefaultHostTarget();
+  Placeholder<float> A("A", {Expr(32), Expr(16)});
+  Placeholder<float> B("B", {Expr(16), Expr(64)});
+  Var k(16, "k0");
+  ir::Tensor C = Compute(
+      {Expr(32), Expr(64)}, [&](Var i, Var j) { return lang::ReduceSum(A(i, k) * B(k, j), {k}); }, "C");
+
+  auto stages = CreateStages({A, B, C});
+  auto funcs  = cinn::lang::LowerVec("test_auto_decompose_reduction", stages, {A, B, C}, {}, {}, nullptr, target, true);
+  ir::IRSchedule init_schedule(ir::ModuleExpr({funcs[0]->body}));
+  SearchState state(init_schedule, 0, {});
+
+  AutoDecomposeReduction test_rule(target);
+  ASSERT_EQ(test_rule.Init(&init_schedule), RuleApplyType::kApply);
+  ASSERT_EQ(test_rule.NumberApplicable(), 1);
+  ASSERT_EQ(test_rule.AnalyseApplyType(state, "C__reduce_init"), RuleApplyType::kCannotApply);
+  ASSERT_EQ(test_rule.AnalyseApplyType(state, "C"), RuleApplyType::kApply);
+  // the innermost loop of the reduction is the reduction loop, which can't be vectorized
+  AutoVectorize auto_vectorize(target);
+  ASSERT_EQ(auto_vectorize.AnalyseApplyType(state, "C"), RuleApplyType::kCannotApply);
+
+  auto new_states = test_rule.ApplyOnBlock(state, "C");
+  ASSERT_EQ(new_states.size(), 1UL);
+  const ir::IRSchedule& new_schedule = new_states[0]->ir_schedule;
+  VLOG(6) << "Decomposed:\n" << new_schedule.GetModule().GetExprs().front();
+  // the init is computed by its own loops, and the reduction loop is moved outside the loop j
+  auto init_loops = new_schedule.GetLoops("C__reduce_init");
+  auto loops      = new_schedule.GetLoops("C");
+  ASSERT_EQ(init_loops.size(), 2UL);
+  ASSERT_EQ(loops.size(), 3UL);
+  ASSERT_EQ(init_loops[0], loops[0]);
+  ASSERT_NE(init_loops[1], loops[2]);
+  ASSERT_EQ(loops[1].As<ir::For>()->loop_var->name, "k0");
+  ASSERT_EQ(loops[2].As<ir::For>()->extent.as_int32(), 64);
+  ASSERT_EQ(test_rule.AnalyseApplyType(new_states[0], "C"), RuleApplyType::kCannotApply);
+  // the innermost loop j reads B and C contiguously
+  ASSERT_EQ(auto_vectorize.AnalyseApplyType(new_states[0], "C"), RuleApplyType::kApply);
+}
+
+TEST(AutoDecomposeReduction, RowReduction) {
+  Context::Global().ResetNameId();
+  Target target = common::DefaultHostTarget();
+  Placeholder<float> A("A", {Expr(32), Expr(64)});
+  Var k(64, "k0");
+  ir::Tensor B = Compute(
+      {Expr(32)}, [&](Var i) { return lang::ReduceSum(A(i, k), {k}); }, "B");
+
+  auto stages = CreateStages({A, B});
+  auto funcs  = cinn::lang::LowerVec("test_auto_decompose_reduction", stages, {A, B}, {}, {}, nullptr, target, true);
+  ir::IRSchedule init_schedule(ir::ModuleExpr({funcs[0]->body}));
+  SearchState state(init_schedule, 0, {});
+
+  // the loop i indexes the rows of A, the reduction loop is kept innermost
+  AutoDecomposeReduction test_rule(target);
+  ASSERT_EQ(test_rule.Init(&init_schedule), RuleApplyType::kCannotApply);
+  ASSERT_EQ(test_rule.AnalyseApplyType(state, "B"), RuleApplyType::kCannotApply);
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
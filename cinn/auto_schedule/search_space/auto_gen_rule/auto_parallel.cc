@@ -0,0 +1,105 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_parallel.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_bind.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_printer.h"
+#include "cinn/ir/ir_schedule.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// the granularity is sampled to leave at least this number of tasks to run in parallel
+static constexpr int kMinParallelTasks = 8;
+
+int CountLoopsToParallel(const std::vector<Expr>& loops) {
+  if (loops.empty()) return 0;
+  // nested parallel loops are not supported, so a loop nest is parallelized once
+  auto parallel_loops = ir::CollectIRNodesWithoutTensor(loops[0], [](const Expr* x) {
+    return x->As<ir::For>() && x->As<ir::For>()->is_parallel();
+  });
+  if (!parallel_loops.empty()) return 0;
+
+  int num_loops = CountLoopCanBinded(loops[0].As<ir::For>());
+  if (loops.size() > 1) {
+    num_loops = std::min<int>(num_loops, loops.size() - 1);
+  }
+  int64_t fused_extent = 1;
+  for (int i = 0; i < num_loops; ++i) {
+    const ir::For* for_node = loops[i].As<ir::For>();
+    if (!for_node->extent.is_constant()) return 0;
+    fused_extent *= for_node->extent.as_int32();
+  }
+  return fused_extent >= 2 ? num_loops : 0;
+}
+
+static void ParallelOuterLoops(ir::IRSchedule* ir_schedule, const std::string& block_name) {
+  auto all_loops = ir_schedule->GetLoops(block_name);
+  int num_loops  = CountLoopsToParallel(all_loops);
+  CHECK_GT(num_loops, 0) << "No loop of block " << block_name << " can be parallelized";
+  Expr fused_loop = all_loops[0];
+  if (num_loops > 1) {
+    fused_loop = ir_schedule->Fuse({all_loops.begin(), all_loops.begin() + num_loops});
+  }
+  int extent               = fused_loop.As<ir::For>()->extent.as_int32();
+  int max_innermost_factor = std::max(1, extent / kMinParallelTasks);
+  auto factors             = ir_schedule->SamplePerfectTile(fused_loop, 2, max_innermost_factor);
+  auto splits              = ir_schedule->Split(fused_loop, factors);
+  CHECK_EQ(splits.size(), 2);
+  ir_schedule->Parallel(splits[0]);
+}
+
+RuleApplyType AutoParallel::Init(ir::IRSchedule* ir_schedule) {
+  ir_schedule_ = ir_schedule;
+  applicable_schedule_blocks_.clear();
+
+  if (target_->arch == common::Target::Arch::X86) {
+    for (auto&& block_realize : ir_schedule->GetAllBlocks()) {
+      if (CountLoopsToParallel(ir_schedule->GetLoops(block_realize)) > 0) {
+        applicable_schedule_blocks_.emplace_back(block_realize);
+      }
+    }
+  }
+  num_applicable_ = applicable_schedule_blocks_.size();
+  VLOG(6) << "Collect applicable_schedule_blocks_:" << num_applicable_;
+  return num_applicable_ > 0 ? RuleApplyType::kApply : RuleApplyType::kCannotApply;
+}
+
+void AutoParallel::Apply(int index) {
+  CHECK_LT(index, applicable_schedule_blocks_.size()) << "invalid apply index:" << index;
+  auto applied_block = applicable_schedule_blocks_.at(index);
+  ParallelOuterLoops(ir_schedule_,
+                     applied_block.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->name);
+}
+
+RuleApplyType AutoParallel::AnalyseApplyType(SearchState state, const std::string& block_name) const {
+  if (target_->arch != common::Target::Arch::X86) return RuleApplyType::kCannotApply;
+  auto all_loops = state->ir_schedule.GetLoops(block_name);
+  return CountLoopsToParallel(all_loops) > 0 ? RuleApplyType::kApply : RuleApplyType::kCannotApply;
+}
+
+std::vector<SearchState> AutoParallel::ApplyOnBlock(SearchState state, const std::string& block_name) {
+  SearchState new_state = state.Copy();
+  ParallelOuterLoops(&new_state->ir_schedule, block_name);
+  return {new_state};
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,82 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_parallel.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include "cinn/cinn.h"
+#include "cinn/lang/lower.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+ir::IRSchedule MakeElementwiseSchedule(const Target& target, int M, int N) {
+  Placeholder<float> A("A", {Expr(M), Expr(N)});
+  Placeholder<float> B("B", {Expr(M), Expr(N)});
+  ir::Tensor C = Compute(
+      {Expr(M), Expr(N)}, [&](Var i, Var j) { return A(i, j) + B(i, j); }, "C");
+
+  auto stages = CreateStages({C});
+  auto funcs  = cinn::lang::LowerVec("test_auto_parallel", stages, {A, B, C}, {}, {}, nullptr, target, true);
+  return ir::IRSchedule(ir::ModuleExpr({funcs[0]->body}));
+}
+
+TEST(AutoParallel, ApplyOnBlock) {
+  Context::Global().ResetNameId();
+  Target target                = common::DefaultHostTarget();
+  ir::IRSchedule init_schedule = MakeElementwiseSchedule(target, 64, 32);
+  SearchState state(init_schedule, 0, {});
+
+  AutoParallel test_rule(target);
+  ASSERT_EQ(test_rule.Init(&init_schedule), RuleApplyType::kApply);
+  ASSERT_EQ(test_rule.NumberApplicable(), 1);
+  ASSERT_EQ(test_rule.AnalyseApplyType(state, "C"), RuleApplyType::kApply);
+
+  auto new_states = test_rule.ApplyOnBlock(state, "C");
+  ASSERT_EQ(new_states.size(), 1UL);
+  auto loops = new_states[0]->ir_schedule.GetLoops("C");
+  VLOG(6) << "Expr after AutoParallel: " << new_states[0]->ir_schedule.GetModule().GetExprs()[0];
+  // the outer loop is split by the sampled granularity, and the innermost loop is kept for vectorization
+  ASSERT_EQ(loops.size(), 3UL);
+  const ir::For* outer_loop = loops[0].As<ir::For>();
+  const ir::For* inner_loop = loops[1].As<ir::For>();
+  ASSERT_TRUE(outer_loop->is_parallel());
+  ASSERT_TRUE(inner_loop->is_serial());
+  ASSERT_EQ(outer_loop->extent.as_int32() * inner_loop->extent.as_int32(), 64);
+  ASSERT_LE(inner_loop->extent.as_int32(), 8);
+  ASSERT_EQ(loops[2].As<ir::For>()->extent.as_int32(), 32);
+
+  // a loop nest is parallelized once
+  ASSERT_EQ(test_rule.AnalyseApplyType(new_states[0], "C"), RuleApplyType::kCannotApply);
+}
+
+TEST(AutoParallel, CannotApply) {
+  Context::Global().ResetNameId();
+  Target target                = common::DefaultHostTarget();
+  ir::IRSchedule init_schedule = MakeElementwiseSchedule(target, 1, 32);
+
+  // the fused extent of the outer loops is 1
+  AutoParallel test_rule(target);
+  ASSERT_EQ(test_rule.Init(&init_schedule), RuleApplyType::kCannotApply);
+
+  // only CPU loops are parallelized
+  AutoParallel nvgpu_rule(common::DefaultNVGPUTarget());
+  ir::IRSchedule nvgpu_schedule = MakeElementwiseSchedule(target, 64, 32);
+  ASSERT_EQ(nvgpu_rule.Init(&nvgpu_schedule), RuleApplyType::kCannotApply);
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,140 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_prefetch.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_printer.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/ir_schedule_util.h"
+#include "cinn/runtime/intrinsic.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+static const std::vector<int> prefetch_distance_options = {4, 8, 16};
+
+std::vector<int> AutoPrefetch::GetPrefetchReads(const ir::IRSchedule& ir_schedule, const Expr& block_expr) const {
+  if (target_->arch != common::Target::Arch::X86) return {};
+  auto all_loops = ir_schedule.GetLoops(block_expr);
+  if (all_loops.empty()) return {};
+  const ir::For* loop = all_loops.back().As<ir::For>();
+  // the loop is prefetched in once
+  auto prefetches = ir::CollectIRNodesWithoutTensor(
+      loop->body,
+      [](const Expr* x) { return x->As<ir::Call>() && x->As<ir::Call>()->name == runtime::intrinsic::prefetch; },
+      true);
+  if (!prefetches.empty()) return {};
+
+  // the iter vars bound to the loop
+  auto* block_realize  = block_expr.As<ir::ScheduleBlockRealize>();
+  auto* schedule_block = block_realize->schedule_block.As<ir::ScheduleBlock>();
+  std::vector<std::string> iter_var_names;
+  for (int i = 0; i < block_realize->iter_values.size(); ++i) {
+    if (ir::ContainVar({block_realize->iter_values[i]}, loop->loop_var->name)) {
+      iter_var_names.push_back(schedule_block->iter_vars[i]->name);
+    }
+  }
+  if (iter_var_names.empty()) return {};
+
+  // the reads are numbered in the same order as IRSchedule::Prefetch does
+  std::vector<Expr> loads;
+  ir::CollectIRNodesWithoutTensor(schedule_block->body, [&loads](const Expr* x) {
+    if (x->As<ir::Load>()) loads.push_back(*x);
+    return false;
+  });
+  auto stores = ir::CollectIRNodesWithoutTensor(schedule_block->body, [](const Expr* x) { return x->As<ir::Store>(); });
+
+  auto indexed_by_loop = [&iter_var_names](const std::vector<Expr>& indices) {
+    return std::any_of(iter_var_names.begin(), iter_var_names.end(), [&indices](const std::string& name) {
+      return ir::ContainVar(indices, name);
+    });
+  };
+  std::vector<int> prefetch_reads;
+  for (int i = 0; i < loads.size(); ++i) {
+    const ir::Load* load = loads[i].As<ir::Load>();
+    // the tensor written is accessed at the same element
+    bool is_written = std::any_of(stores.begin(), stores.end(), [load](const Expr& store) {
+      return store.As<ir::Store>()->tensor.as_tensor()->name == load->tensor.as_tensor()->name;
+    });
+    if (is_written || load->indices.empty()) continue;
+    // the dimensions other than the last one are indexed by the loop
+    bool is_strided = indexed_by_loop(std::vector<Expr>(load->indices.begin(), load->indices.end() - 1));
+    // the indices read another tensor indexed by the loop
+    bool is_indirect = std::any_of(load->indices.begin(), load->indices.end(), [&](const Expr& index) {
+      auto indirect_loads = ir::CollectIRNodesWithoutTensor(
+          index, [&](const Expr* x) { return x->As<ir::Load>() && indexed_by_loop(x->As<ir::Load>()->indices); }, true);
+      return !indirect_loads.empty();
+    });
+    if (is_strided || is_indirect) {
+      prefetch_reads.push_back(i);
+    }
+  }
+  return prefetch_reads;
+}
+
+void AutoPrefetch::PrefetchBlock(ir::IRSchedule* ir_schedule, const Expr& block_expr) const {
+  auto prefetch_reads = GetPrefetchReads(*ir_schedule, block_expr);
+  CHECK(!prefetch_reads.empty()) << "The block has no read to prefetch:" << block_expr;
+  std::vector<float> probs(prefetch_distance_options.size(), 1.0f / prefetch_distance_options.size());
+  int distance = ir_schedule->SampleCategorical(prefetch_distance_options, probs).as_int32();
+  Expr loop    = ir_schedule->GetLoops(block_expr).back();
+  // the options count the iterations of the loop, while a vectorized loop issues the prefetch of lane 0 once every
+  // `factor` elements, so the distance is scaled to keep the same number of iterations ahead
+  const ir::For* for_node = loop.As<ir::For>();
+  if (for_node->is_vectorized() && for_node->vectorize_info().factor > 1) {
+    distance *= for_node->vectorize_info().factor;
+  }
+  for (int read_buffer_index : prefetch_reads) {
+    ir_schedule->Prefetch(block_expr, read_buffer_index, loop, distance);
+  }
+}
+
+RuleApplyType AutoPrefetch::Init(ir::IRSchedule* ir_schedule) {
+  ir_schedule_ = ir_schedule;
+  applicable_schedule_blocks_.clear();
+
+  for (auto&& block_realize : ir_schedule->GetAllBlocks()) {
+    if (!GetPrefetchReads(*ir_schedule, block_realize).empty()) {
+      applicable_schedule_blocks_.emplace_back(block_realize);
+    }
+  }
+  num_applicable_ = applicable_schedule_blocks_.size();
+  VLOG(6) << "Collect applicable_schedule_blocks_:" << num_applicable_;
+  return num_applicable_ > 0 ? RuleApplyType::kApply : RuleApplyType::kCannotApply;
+}
+
+void AutoPrefetch::Apply(int index) {
+  CHECK_LT(index, applicable_schedule_blocks_.size()) << "invalid apply index:" << index;
+  PrefetchBlock(ir_schedule_, applicable_schedule_blocks_.at(index));
+}
+
+RuleApplyType AutoPrefetch::AnalyseApplyType(SearchState state, const std::string& block_name) const {
+  Expr block_expr = state->ir_schedule.GetBlock(block_name);
+  return GetPrefetchReads(state->ir_schedule, block_expr).empty() ? RuleApplyType::kCannotApply
+                                                                   : RuleApplyType::kApply;
+}
+
+std::vector<SearchState> AutoPrefetch::ApplyOnBlock(SearchState state, const std::string& block_name) {
+  SearchState new_state = state.Copy();
+  PrefetchBlock(&new_state->ir_schedule, new_state->ir_schedule.GetBlock(block_name));
+  return {new_state};
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,59 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_gen_rule.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_schedule.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// Prefetch the strided and indirect reads of a block on CPU by IRSchedule::Prefetch. A read is strided if the innermost
+// loop of the block indexes a dimension other than the last one of the tensor read, such as the reads of transposes,
+// and it is indirect if its indices contain another read, such as the reads of gathers. The prefetches are issued in
+// the innermost loop, and the distance is sampled from a few candidates of loop iterations, which are scaled by the
+// vector factor if AutoVectorize has vectorized the loop.
+class AutoPrefetch : public AutoGenRule {
+ public:
+  AutoPrefetch(const common::Target& target) : AutoGenRule(target) {}
+  ~AutoPrefetch() = default;
+
+  RuleApplyType Init(ir::IRSchedule* init_schedule) override;
+
+  void Apply(int index) override;
+
+  std::string GetRuleName() const override { return "AutoPrefetch"; }
+
+  RuleApplyType AnalyseApplyType(SearchState state, const std::string& block_name) const override;
+
+  std::vector<SearchState> ApplyOnBlock(SearchState state, const std::string& block_name) override;
+
+ private:
+  // Get the indices of the reads of a block to be prefetched, empty if the rule can't be applied
+  std::vector<int> GetPrefetchReads(const ir::IRSchedule& ir_schedule, const Expr& block_expr) const;
+
+  // Prefetch the strided and indirect reads of a block in its innermost loop
+  void PrefetchBlock(ir::IRSchedule* ir_schedule, const Expr& block_expr) const;
+
+ private:
+  std::vector<Expr> applicable_schedule_blocks_;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,120 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_prefetch.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include "cinn/cinn.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/lang/lower.h"
+#include "cinn/runtime/intrinsic.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// Apply AutoPrefetch on the block computing the last tensor of args, return the number of the reads prefetched, 0 if
+// the rule can't be applied
+int PrefetchReads(const std::vector<ir::Tensor>& args) {
+  Target target = common::DefaultHostTarget();
+  auto stages   = CreateStages({args.back()});
+  auto funcs    = cinn::lang::LowerVec("test_auto_prefetch", stages, args, {}, {}, nullptr, target, true);
+  ir::IRSchedule init_schedule(ir::ModuleExpr({funcs[0]->body}));
+  SearchState state(init_schedule, 0, {});
+
+  AutoPrefetch test_rule(target);
+  const std::string& block_name = args.back()->name;
+  if (test_rule.AnalyseApplyType(state, block_name) == RuleApplyType::kCannotApply) {
+    EXPECT_EQ(test_rule.Init(&init_schedule), RuleApplyType::kCannotApply);
+    return 0;
+  }
+  EXPECT_EQ(test_rule.Init(&init_schedule), RuleApplyType::kApply);
+  EXPECT_EQ(test_rule.NumberApplicable(), 1);
+
+  auto new_states = test_rule.ApplyOnBlock(state, block_name);
+  EXPECT_EQ(new_states.size(), 1UL);
+  VLOG(6) << "Prefetched:\n" << new_states[0]->ir_schedule.GetModule().GetExprs().front();
+  // the prefetches are issued at the beginning of the innermost loop
+  Expr innermost_loop = new_states[0]->ir_schedule.GetLoops(block_name).back();
+  auto& stmts         = innermost_loop.As<ir::For>()->body.As<ir::Block>()->stmts;
+  int num_prefetches  = 0;
+  while (num_prefetches < static_cast<int>(stmts.size()) && stmts[num_prefetches].As<ir::Call>()) {
+    EXPECT_EQ(stmts[num_prefetches].As<ir::Call>()->name, runtime::intrinsic::prefetch);
+    ++num_prefetches;
+  }
+  // the prefetched loop isn't prefetched again
+  EXPECT_EQ(test_rule.AnalyseApplyType(new_states[0], block_name), RuleApplyType::kCannotApply);
+  return num_prefetches;
+}
+
+TEST(AutoPrefetch, Transpose) {
+  Context::Global().ResetNameId();
+  Placeholder<float> A("A", {Expr(64), Expr(32)});
+  ir::Tensor B = Compute(
+      {Expr(32), Expr(64)}, [&](Var i, Var j) { return A(j, i); }, "B");
+  // the innermost loop indexes the rows of A
+  ASSERT_EQ(PrefetchReads({A, B}), 1);
+}
+
+TEST(AutoPrefetch, Gather) {
+  Context::Global().ResetNameId();
+  Placeholder<float> A("A", {Expr(1024)});
+  Placeholder<int> index("index", {Expr(64)});
+  ir::Tensor B = Compute(
+      {Expr(64)}, [&](Var i) { return A(index(i)); }, "B");
+  // A is read indirectly, and the index is read contiguously
+  ASSERT_EQ(PrefetchReads({A, index, B}), 1);
+}
+
+TEST(AutoPrefetch, VectorizedLoop) {
+  Context::Global().ResetNameId();
+  Placeholder<float> A("A", {Expr(1024), Expr(32)});
+  ir::Tensor B = Compute(
+      {Expr(32), Expr(1024)}, [&](Var i, Var j) { return A(j, i); }, "B");
+  Target target = common::DefaultHostTarget();
+  auto stages   = CreateStages({B});
+  auto funcs    = cinn::lang::LowerVec("test_auto_prefetch", stages, {A, B}, {}, {}, nullptr, target, true);
+  ir::IRSchedule init_schedule(ir::ModuleExpr({funcs[0]->body}));
+  // AutoVectorize runs before AutoPrefetch
+  init_schedule.Vectorize(init_schedule.GetLoops("B").back(), 8);
+  SearchState state(init_schedule, 0, {});
+
+  AutoPrefetch test_rule(target);
+  auto new_states = test_rule.ApplyOnBlock(state, "B");
+  ASSERT_EQ(new_states.size(), 1UL);
+  Expr innermost_loop = new_states[0]->ir_schedule.GetLoops("B").back();
+  auto* prefetch      = innermost_loop.As<ir::For>()->body.As<ir::Block>()->stmts.front().As<ir::Call>();
+  ASSERT_TRUE(prefetch);
+  ASSERT_EQ(prefetch->name, runtime::intrinsic::prefetch);
+  // the distance sampled from {4, 8, 16} iterations is scaled by the 8 lanes of the loop
+  auto mins = ir::CollectIRNodesWithoutTensor(prefetch->read_args[0], [](const Expr* x) { return x->As<ir::Min>(); });
+  ASSERT_EQ(mins.size(), 1U);
+  auto distances = ir::CollectIRNodesWithoutTensor(mins.begin()->As<ir::Min>()->a, [](const Expr* x) {
+    return x->As<ir::IntImm>() && (x->as_int32() == 32 || x->as_int32() == 64 || x->as_int32() == 128);
+  });
+  ASSERT_EQ(distances.size(), 1U);
+}
+
+TEST(AutoPrefetch, Contiguous) {
+  Context::Global().ResetNameId();
+  Placeholder<float> A("A", {Expr(32), Expr(64)});
+  Placeholder<float> B("B", {Expr(32), Expr(64)});
+  ir::Tensor C = Compute(
+      {Expr(32), Expr(64)}, [&](Var i, Var j) { return A(i, j) + B(i, j); }, "C");
+  ASSERT_EQ(PrefetchReads({A, B, C}), 0);
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,96 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_storage_align.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_printer.h"
+#include "cinn/ir/ir_schedule.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// the rows a multiple of the way size apart map to the same cache set
+static constexpr int kCacheWayBytes  = 4096;
+static constexpr int kCacheLineBytes = 64;
+
+bool AutoStorageAlign::MeetCondition(const Expr& block_expr) const {
+  if (target_->arch != common::Target::Arch::X86) return false;
+  auto* schedule_block = block_expr.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>();
+  auto stores = ir::CollectIRNodesWithoutTensor(schedule_block->body, [](const Expr* x) { return x->As<ir::Store>(); });
+  // the block writes a single tensor by itself, instead of by the blocks inside it such as the root block
+  auto inner_blocks = ir::CollectIRNodesWithoutTensor(
+      schedule_block->body, [](const Expr* x) { return x->As<ir::ScheduleBlockRealize>(); }, true);
+  if (!inner_blocks.empty() || stores.size() != 1) return false;
+  ir::Tensor tensor = stores.begin()->As<ir::Store>()->tensor.as_tensor_ref();
+  if (!tensor->buffer.defined() || tensor->shape.size() < 2 || !tensor->shape.back().is_constant()) return false;
+  // the buffer is intermediate, including the buffers shared with the outputs such as the init tensor of a reduction
+  const auto& binded_names = tensor->buffer->binded_tensor_names();
+  if (output_names_.count(tensor->name) || std::any_of(binded_names.begin(), binded_names.end(), [this](auto& name) {
+        return output_names_.count(name) > 0;
+      })) {
+    return false;
+  }
+  int row_bytes = tensor->shape.back().as_int32() * tensor->type().bytes();
+  return row_bytes % kCacheWayBytes == 0;
+}
+
+void AutoStorageAlign::AlignBlock(ir::IRSchedule* ir_schedule, const Expr& block_expr) const {
+  CHECK(MeetCondition(block_expr)) << "The buffer written by the block needn't be aligned:" << block_expr;
+  auto* schedule_block = block_expr.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>();
+  auto stores = ir::CollectIRNodesWithoutTensor(schedule_block->body, [](const Expr* x) { return x->As<ir::Store>(); });
+  ir::Tensor tensor = stores.begin()->As<ir::Store>()->tensor.as_tensor_ref();
+  int row_stride    = tensor->shape.back().as_int32();
+  int line_stride   = std::max(kCacheLineBytes / tensor->type().bytes(), 1);
+  std::vector<std::string> output_names(output_names_.begin(), output_names_.end());
+  ir_schedule->StorageAlign(block_expr, 0, tensor->shape.size() - 2, row_stride, line_stride, output_names);
+}
+
+RuleApplyType AutoStorageAlign::Init(ir::IRSchedule* ir_schedule) {
+  ir_schedule_ = ir_schedule;
+  applicable_schedule_blocks_.clear();
+
+  for (auto&& block_realize : ir_schedule->GetAllBlocks()) {
+    if (MeetCondition(block_realize)) {
+      applicable_schedule_blocks_.emplace_back(block_realize);
+    }
+  }
+  num_applicable_ = applicable_schedule_blocks_.size();
+  VLOG(6) << "Collect applicable_schedule_blocks_:" << num_applicable_;
+  return num_applicable_ > 0 ? RuleApplyType::kApply : RuleApplyType::kCannotApply;
+}
+
+void AutoStorageAlign::Apply(int index) {
+  CHECK_LT(index, applicable_schedule_blocks_.size()) << "invalid apply index:" << index;
+  AlignBlock(ir_schedule_, applicable_schedule_blocks_.at(index));
+}
+
+RuleApplyType AutoStorageAlign::AnalyseApplyType(SearchState state, const std::string& block_name) const {
+  return MeetCondition(state->ir_schedule.GetBlock(block_name)) ? RuleApplyType::kApply : RuleApplyType::kCannotApply;
+}
+
+std::vector<SearchState> AutoStorageAlign::ApplyOnBlock(SearchState state, const std::string& block_name) {
+  SearchState new_state = state.Copy();
+  AlignBlock(&new_state->ir_schedule, new_state->ir_schedule.GetBlock(block_name));
+  return {new_state};
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,60 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_gen_rule.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_schedule.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// Align the row stride of the intermediate buffers on CPU whose rows are a multiple of the cache way size apart, so
+// the same columns of different rows don't map to the same cache set. The stride is padded by a cache line by
+// IRSchedule::StorageAlign. The outputs are not aligned since their strides are decided by the callers.
+class AutoStorageAlign : public AutoGenRule {
+ public:
+  AutoStorageAlign(const common::Target& target, const std::unordered_set<std::string>& output_names)
+      : AutoGenRule(target), output_names_(output_names) {}
+  ~AutoStorageAlign() = default;
+
+  RuleApplyType Init(ir::IRSchedule* init_schedule) override;
+
+  void Apply(int index) override;
+
+  std::string GetRuleName() const override { return "AutoStorageAlign"; }
+
+  RuleApplyType AnalyseApplyType(SearchState state, const std::string& block_name) const override;
+
+  std::vector<SearchState> ApplyOnBlock(SearchState state, const std::string& block_name) override;
+
+ private:
+  // Check whether the row stride of the buffer written by a block should be aligned
+  bool MeetCondition(const Expr& block_expr) const;
+
+  // Align the row stride of the buffer written by a block
+  void AlignBlock(ir::IRSchedule* ir_schedule, const Expr& block_expr) const;
+
+ private:
+  std::vector<Expr> applicable_schedule_blocks_;
+  std::unordered_set<std::string> output_names_;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,70 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_storage_align.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include "cinn/cinn.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/lang/lower.h"
+#include "cinn/utils/string.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// Get the tensor written by a block
+ir::Tensor GetWrittenTensor(const ir::IRSchedule& ir_schedule, const std::string& block_name) {
+  auto stores = ir::CollectIRNodesWithoutTensor(ir_schedule.GetBlock(block_name),
+                                                [](const Expr* x) { return x->As<ir::Store>(); });
+  CHECK_EQ(stores.size(), 1UL);
+  return stores.begin()->As<ir::Store>()->tensor.as_tensor_ref();
+}
+
+TEST(AutoStorageAlign, Basic) {
+  Context::Global().ResetNameId();
+  Target target = common::DefaultHostTarget();
+  Placeholder<float> A("A", {Expr(64), Expr(1024)});
+  ir::Tensor B = Compute(
+      {Expr(64), Expr(1024)}, [&](Var i, Var j) { return A(i, j) * Expr(2.f); }, "B");
+  ir::Tensor C = Compute(
+      {Expr(64), Expr(1024)}, [&](Var i, Var j) { return B(i, j) + Expr(1.f); }, "C");
+
+  auto stages = CreateStages({A, B, C});
+  auto funcs  = cinn::lang::LowerVec("test_auto_storage_align", stages, {A, C}, {}, {}, nullptr, target, true);
+  ir::IRSchedule init_schedule(ir::ModuleExpr({funcs[0]->body}));
+  SearchState state(init_schedule, 0, {});
+
+  AutoStorageAlign test_rule(target, {"C"});
+  ASSERT_EQ(test_rule.Init(&init_schedule), RuleApplyType::kApply);
+  ASSERT_EQ(test_rule.NumberApplicable(), 1);
+  // the strides of the outputs are decided by the callers
+  ASSERT_EQ(test_rule.AnalyseApplyType(state, "C"), RuleApplyType::kCannotApply);
+  ASSERT_EQ(test_rule.AnalyseApplyType(state, "B"), RuleApplyType::kApply);
+
+  auto new_states = test_rule.ApplyOnBlock(state, "B");
+  ASSERT_EQ(new_states.size(), 1UL);
+  VLOG(6) << "Aligned:\n" << new_states[0]->ir_schedule.GetModule().GetExprs().front();
+  // the rows of B are 4KB apart, they are padded by a cache line
+  ir::Tensor aligned_tensor = GetWrittenTensor(new_states[0]->ir_schedule, "B");
+  ASSERT_EQ(utils::Join(aligned_tensor->shape, ", "), "64, 1040");
+  ASSERT_EQ(utils::Join(aligned_tensor->buffer->shape, ", "), "64, 1040");
+  ASSERT_EQ(test_rule.AnalyseApplyType(new_states[0], "B"), RuleApplyType::kCannotApply);
+  // the original state is unchanged
+  ASSERT_EQ(utils::Join(GetWrittenTensor(state->ir_schedule, "B")->shape, ", "), "64, 1024");
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,144 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_vectorize.h"
+
+#include <glog/logging.h>
+
+#include "cinn/auto_schedule/analysis/analyze_ir.h"
+#include "cinn/hlir/pe/schedule.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_printer.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/ir_schedule_util.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// check whether the index is exactly the var
+static bool IsVar(const Expr& index, const std::string& var_name) {
+  return index.as_var() && index.as_var()->name == var_name;
+}
+
+int AutoVectorize::GetVectorizeFactor(const ir::IRSchedule& ir_schedule, const Expr& block_expr, int* pad_axis) const {
+  if (pad_axis) *pad_axis = -1;
+  if (target_->arch != common::Target::Arch::X86) return 0;
+  auto all_loops = ir_schedule.GetLoops(block_expr);
+  if (all_loops.empty()) return 0;
+  const ir::For* loop = all_loops.back().As<ir::For>();
+  if (!loop->is_serial() || !loop->extent.is_constant()) return 0;
+  // the loop contains the block only
+  const ir::Block* body = loop->body.As<ir::Block>();
+  if (!body || body->stmts.size() != 1 || !body->stmts[0].As<ir::ScheduleBlockRealize>()) return 0;
+
+  // the loop var is bound to a single spatial iter var of the block
+  auto* block_realize  = block_expr.As<ir::ScheduleBlockRealize>();
+  auto* schedule_block = block_realize->schedule_block.As<ir::ScheduleBlock>();
+  int bound_index      = -1;
+  for (int i = 0; i < block_realize->iter_values.size(); ++i) {
+    if (ir::ContainVar({block_realize->iter_values[i]}, loop->loop_var->name)) {
+      if (bound_index != -1) return 0;
+      bound_index = i;
+    }
+  }
+  if (bound_index == -1 || schedule_block->iter_vars[bound_index]->is_reduce_axis) return 0;
+
+  // the iter var only indexes the last dimension of the tensors, so the lanes access contiguous elements
+  const std::string& iter_var_name = schedule_block->iter_vars[bound_index]->name;
+  auto stores = ir::CollectIRNodesWithoutTensor(schedule_block->body, [](const Expr* x) { return x->As<ir::Store>(); });
+  if (stores.size() != 1) return 0;
+  const ir::Store* store = stores.begin()->As<ir::Store>();
+  if (store->indices.empty() || !ir::ContainVar({store->indices.back()}, iter_var_name) ||
+      !OnlyIndexLastDim(store->indices, iter_var_name)) {
+    return 0;
+  }
+  auto loads = ir::CollectIRNodesWithoutTensor(schedule_block->body, [&iter_var_name](const Expr* x) {
+    return x->As<ir::Load>() && !OnlyIndexLastDim(x->As<ir::Load>()->indices, iter_var_name);
+  });
+  if (!loads.empty()) return 0;
+
+  int extent       = loop->extent.as_int32();
+  int basic_factor = hlir::pe::GetBasicFactor(store->tensor.as_tensor()->type(), *target_);
+  int factor       = basic_factor;
+  while (factor >= 2 && extent % factor != 0) {
+    factor /= 2;
+  }
+  if (factor >= 2) return factor;
+  if (!pad_axis_) return 0;
+
+  // pad the axis if it is bound to the loop directly, the loop nest contains the block only, and the block doesn't
+  // read the tensor it writes, see IRSchedule::PadAxis
+  auto blocks_in_nest = ir::CollectIRNodesWithoutTensor(
+      all_loops.front(), [](const Expr* x) { return x->As<ir::ScheduleBlockRealize>(); });
+  if (!IsVar(block_realize->iter_values[bound_index], loop->loop_var->name) || blocks_in_nest.size() != 1) return 0;
+  const std::string& tensor_name = store->tensor.as_tensor()->name;
+
+  auto unpaddable_loads = ir::CollectIRNodesWithoutTensor(schedule_block->body, [&](const Expr* x) {
+    const ir::Load* load = x->As<ir::Load>();
+    return load && (load->tensor.as_tensor()->name == tensor_name ||
+                    (ir::ContainVar(load->indices, iter_var_name) && !IsVar(load->indices.back(), iter_var_name)));
+  });
+  if (!IsVar(store->indices.back(), iter_var_name) || !unpaddable_loads.empty()) return 0;
+
+  // the factor is halved while its half still covers the extent, so the lanes wasted by padding are fewer
+  factor = basic_factor;
+  while (factor / 2 >= extent) {
+    factor /= 2;
+  }
+  if (factor < 2) return 0;
+  if (pad_axis) *pad_axis = bound_index;
+  return factor;
+}
+
+void AutoVectorize::VectorizeBlock(ir::IRSchedule* ir_schedule, const Expr& block_expr) const {
+  int pad_axis = -1;
+  int factor   = GetVectorizeFactor(*ir_schedule, block_expr, &pad_axis);
+  CHECK_GT(factor, 0) << "The innermost loop can't be vectorized:" << block_expr;
+  Expr block = pad_axis >= 0 ? ir_schedule->PadAxis(block_expr, pad_axis, factor) : block_expr;
+  ir_schedule->Vectorize(ir_schedule->GetLoops(block).back(), factor);
+}
+
+RuleApplyType AutoVectorize::Init(ir::IRSchedule* ir_schedule) {
+  ir_schedule_ = ir_schedule;
+  applicable_schedule_blocks_.clear();
+
+  for (auto&& block_realize : ir_schedule->GetAllBlocks()) {
+    if (GetVectorizeFactor(*ir_schedule, block_realize) > 0) {
+      applicable_schedule_blocks_.emplace_back(block_realize);
+    }
+  }
+  num_applicable_ = applicable_schedule_blocks_.size();
+  VLOG(6) << "Collect applicable_schedule_blocks_:" << num_applicable_;
+  return num_applicable_ > 0 ? RuleApplyType::kApply : RuleApplyType::kCannotApply;
+}
+
+void AutoVectorize::Apply(int index) {
+  CHECK_LT(index, applicable_schedule_blocks_.size()) << "invalid apply index:" << index;
+  VectorizeBlock(ir_schedule_, applicable_schedule_blocks_.at(index));
+}
+
+RuleApplyType AutoVectorize::AnalyseApplyType(SearchState state, const std::string& block_name) const {
+  Expr block_expr = state->ir_schedule.GetBlock(block_name);
+  return GetVectorizeFactor(state->ir_schedule, block_expr) > 0 ? RuleApplyType::kApply
+                                                                : RuleApplyType::kCannotApply;
+}
+
+std::vector<SearchState> AutoVectorize::ApplyOnBlock(SearchState state, const std::string& block_name) {
+  SearchState new_state = state.Copy();
+  VectorizeBlock(&new_state->ir_schedule, new_state->ir_schedule.GetBlock(block_name));
+  return {new_state};
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,60 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_gen_rule.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_schedule.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// Vectorize the innermost loop of a block on CPU. The loop should only index the last dimension of the
+// tensors accessed in the block, and the factor is the number of lanes of the vector registers of the target
+// for the stored type, halved until it divides the extent of the loop. If `pad_axis` is true and no factor divides
+// the extent, the axis of the loop is padded to a multiple of the factor by IRSchedule::PadAxis instead.
+class AutoVectorize : public AutoGenRule {
+ public:
+  AutoVectorize(const common::Target& target, bool pad_axis = false) : AutoGenRule(target), pad_axis_(pad_axis) {}
+  ~AutoVectorize() = default;
+
+  RuleApplyType Init(ir::IRSchedule* init_schedule) override;
+
+  void Apply(int index) override;
+
+  std::string GetRuleName() const override { return "AutoVectorize"; }
+
+  RuleApplyType AnalyseApplyType(SearchState state, const std::string& block_name) const override;
+
+  std::vector<SearchState> ApplyOnBlock(SearchState state, const std::string& block_name) override;
+
+ private:
+  // Get the factor to vectorize the innermost loop of a block, 0 if the loop can't be vectorized. The axis to be
+  // padded before vectorizing is returned by `pad_axis`, -1 if the loop is vectorized without padding
+  int GetVectorizeFactor(const ir::IRSchedule& ir_schedule, const Expr& block_expr, int* pad_axis = nullptr) const;
+
+  // Vectorize the innermost loop of a block, pad its axis first if needed
+  void VectorizeBlock(ir::IRSchedule* ir_schedule, const Expr& block_expr) const;
+
+ private:
+  std::vector<Expr> applicable_schedule_blocks_;
+  bool pad_axis_;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,84 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_vectorize.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include "cinn/cinn.h"
+#include "cinn/lang/lower.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// Vectorize the innermost loop of C = A + B, return the factor, 0 if the rule can't be applied
+int VectorizeElementwise(int M, int N, bool transpose_b, bool pad_axis = false) {
+  Context::Global().ResetNameId();
+  Target target = common::DefaultHostTarget();
+  Placeholder<float> A("A", {Expr(M), Expr(N)});
+  Placeholder<float> B("B", transpose_b ? std::vector<Expr>{Expr(N), Expr(M)} : std::vector<Expr>{Expr(M), Expr(N)});
+  ir::Tensor C = Compute(
+      {Expr(M), Expr(N)}, [&](Var i, Var j) { return A(i, j) + (transpose_b ? B(j, i) : B(i, j)); }, "C");
+
+  auto stages = CreateStages({C});
+  auto funcs  = cinn::lang::LowerVec("test_auto_vectorize", stages, {A, B, C}, {}, {}, nullptr, target, true);
+  ir::IRSchedule init_schedule(ir::ModuleExpr({funcs[0]->body}));
+  SearchState state(init_schedule, 0, {});
+
+  AutoVectorize test_rule(target, pad_axis);
+  if (test_rule.AnalyseApplyType(state, "C") == RuleApplyType::kCannotApply) {
+    EXPECT_EQ(test_rule.Init(&init_schedule), RuleApplyType::kCannotApply);
+    return 0;
+  }
+  EXPECT_EQ(test_rule.Init(&init_schedule), RuleApplyType::kApply);
+  EXPECT_EQ(test_rule.NumberApplicable(), 1);
+
+  auto new_states = test_rule.ApplyOnBlock(state, "C");
+  EXPECT_EQ(new_states.size(), 1UL);
+  VLOG(6) << "Expr after AutoVectorize: " << new_states[0]->ir_schedule.GetModule().GetExprs()[0];
+  // the padded block is renamed after the padded copy of C
+  std::string block_name        = new_states[0]->ir_schedule.HasBlock("C_pad") ? "C_pad" : "C";
+  const ir::For* innermost_loop = new_states[0]->ir_schedule.GetLoops(block_name).back().As<ir::For>();
+  EXPECT_TRUE(innermost_loop->is_vectorized());
+  EXPECT_EQ(innermost_loop->extent.as_int32() % innermost_loop->vectorize_info().factor, 0);
+  // the vectorized loop can't be vectorized again
+  EXPECT_EQ(test_rule.AnalyseApplyType(new_states[0], block_name), RuleApplyType::kCannotApply);
+  return innermost_loop->vectorize_info().factor;
+}
+
+TEST(AutoVectorize, ApplyOnBlock) {
+  // the factor is the number of float lanes of the vector registers
+  ASSERT_EQ(VectorizeElementwise(32, 64, false), 16);
+  // and halved until it divides the extent
+  ASSERT_EQ(VectorizeElementwise(32, 24, false), 8);
+  ASSERT_EQ(VectorizeElementwise(32, 7, false), 0);
+  // the lanes don't access contiguous elements of B
+  ASSERT_EQ(VectorizeElementwise(32, 64, true), 0);
+}
+
+TEST(AutoVectorize, PadAxis) {
+  // no factor divides the odd extent unless the axis is padded to a multiple of the factor
+  ASSERT_EQ(VectorizeElementwise(32, 31, false), 0);
+  ASSERT_EQ(VectorizeElementwise(32, 31, false, true), 16);
+  // the factor is halved while its half still covers the extent
+  ASSERT_EQ(VectorizeElementwise(32, 7, false, true), 8);
+  // the divisible extents are not padded
+  ASSERT_EQ(VectorizeElementwise(32, 24, false, true), 8);
+  // the lanes of the padded loop should still access contiguous elements
+  ASSERT_EQ(VectorizeElementwise(32, 31, true, true), 0);
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
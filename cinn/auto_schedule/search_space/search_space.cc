@@ -21,9 +21,14 @@
 #include <vector>
 
 #include "cinn/auto_schedule/cost_model/expr_cost_model.h"
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_decompose_reduction.h"
 #include "cinn/auto_schedule/search_space/auto_gen_rule/auto_gen_rule.h"
 #include "cinn/auto_schedule/search_space/auto_gen_rule/auto_inline.h"
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_parallel.h"
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_prefetch.h"
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_storage_align.h"
 #include "cinn/auto_schedule/search_space/auto_gen_rule/auto_unroll.h"
+#include "cinn/auto_schedule/search_space/auto_gen_rule/auto_vectorize.h"
 #include "cinn/auto_schedule/search_space/auto_gen_rule/multi_level_tiling.h"
 #include "cinn/auto_schedule/search_space/auto_gen_rule/skip_rule.h"
 #include "cinn/auto_schedule/search_space/block_sampler.h"
@@ -46,6 +51,15 @@ SearchSpace::SearchSpace(const TuneTask& tune_task, utils::LinearRandomEngine::S
   // TODO(zhhsplendid): pass correct output names to AutoInline
   // sketch_rules_.emplace_back(new AutoInline(target, tune_task_.output_names));
   sketch_rules_.emplace_back(new MultiLevelTiling(target, MultiLevelTiling::kConfigs.at(target.arch)));
+  if (target.arch == common::Target::Arch::X86) {
+    // decompose the reductions first, so their spatial loops can be moved innermost and vectorized
+    sketch_rules_.emplace_back(new AutoDecomposeReduction(target));
+    // parallelize before vectorizing, so the loop split for parallelism can still leave a vectorized inner loop
+    sketch_rules_.emplace_back(new AutoParallel(target));
+    sketch_rules_.emplace_back(new AutoVectorize(target));
+    sketch_rules_.emplace_back(new AutoPrefetch(target));
+    sketch_rules_.emplace_back(new AutoStorageAlign(target, tune_task_.output_names));
+  }
   sketch_rules_.emplace_back(new AutoUnroll(target));
   sketch_rules_.emplace_back(new SkipRule(target));
 }
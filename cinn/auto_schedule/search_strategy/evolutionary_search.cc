@@ -21,6 +21,7 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <utility>
 
 #include "cinn/auto_schedule/database/database.h"
@@ -28,6 +29,7 @@
 #include "cinn/auto_schedule/search_space/search_space.h"
 #include "cinn/auto_schedule/search_space/search_state.h"
 #include "cinn/auto_schedule/search_strategy/mutate_rule/mutate_tile_size.h"
+#include "cinn/auto_schedule/search_strategy/trace_transfer.h"
 #include "cinn/auto_schedule/task/task_registry.h"
 #include "cinn/auto_schedule/task/tune_task.h"
 #include "cinn/auto_schedule/tuning.h"
@@ -54,6 +56,10 @@ EvolutionarySearch::EvolutionarySearch(const TuneTask& tune_task,
   search_space_ = std::make_unique<SearchSpace>(tune_task, utils::ForkRandomState(&rand_seed_));
   if (mutators_.empty()) {
     mutators_.push_back(std::make_tuple("mutate_tile_size", 1.0));
+    // the granularity of parallel loops is sampled as a tile size, and the vectorize factor is mutated on CPU
+    if (tune_task.target.arch == common::Target::Arch::X86) {
+      mutators_.push_back(std::make_tuple("mutate_vectorize_factor", 1.0));
+    }
   }
   double accum_weight = 0.0;
   for (const auto& mutator : mutators_) {
@@ -116,9 +122,47 @@ std::vector<SearchState> EvolutionarySearch::GetTopKCandidatesFromDatabase(int t
     ir::ScheduleDesc::ReplayWithProto(record.trace, &ir_sch);
     results.emplace_back(SearchState(std::move(ir_sch), record.predicted_cost));
   }
+  // fill up with the candidates transferred from similar tasks
+  for (auto&& candidate : TransferFromSimilarTasks(topk)) {
+    if (results.size() >= topk) {
+      break;
+    }
+    results.emplace_back(candidate.first);
+  }
   return results;
 }
 
+const std::vector<std::pair<SearchState, double>>& EvolutionarySearch::TransferFromSimilarTasks(int topk) {
+  if (transferred_) {
+    return transferred_candidates_;
+  }
+  transferred_ = true;
+
+  // the size of a task is the total number of elements of its variables
+  auto size_fn = [](const std::string& task_key) {
+    double size = 0.0;
+    for (auto&& variable : ParseVariablesFromKey(task_key)) {
+      const auto& shape = variable.second;
+      size += std::accumulate(shape.begin(), shape.end(), 1.0, std::multiplies<double>());
+    }
+    return size;
+  };
+  const auto& task_key = tune_task_.serialized_key;
+  for (auto&& record : database_->GetSimilarTopK(task_key, topk)) {
+    const auto& module_expr = InitialTaskRegistry::Global()->Get(task_key)->module_expr;
+    ir::proto::ScheduleDesc trace;
+    if (!TransferTrace(record.trace, record.task_key, task_key, module_expr, &trace)) {
+      continue;
+    }
+    ir::IRSchedule ir_sch(optim::IRCopy(module_expr), utils::ForkRandomState(&rand_seed_));
+    ir::ScheduleDesc::ReplayWithProto(trace, &ir_sch);
+    double scaled_cost = record.execution_cost * size_fn(task_key) / size_fn(record.task_key);
+    transferred_candidates_.emplace_back(SearchState(std::move(ir_sch)), scaled_cost);
+  }
+  VLOG(4) << "Transferred " << transferred_candidates_.size() << " candidates from similar tasks";
+  return transferred_candidates_;
+}
+
 void ApplyPostScheduleRules(ir::IRSchedule* schedule,
                             const std::vector<std::unique_ptr<PostScheduleRule>>& post_schedule_rules) {
   schedule->TagPostSchedule();
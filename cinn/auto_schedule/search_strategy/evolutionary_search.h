@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "cinn/auto_schedule/cost_model/expr_cost_model.h"
@@ -79,6 +80,18 @@ class EvolutionarySearch {
    */
   std::vector<SearchState> SearchModuleExprEpsGreedy(const TuningOptions& options);
 
+  /**
+   * Transfer the best records of at most topk tasks similar to this one from
+   * the database, see TransferTrace. The candidates are transferred once, and
+   * they join the initial population of each iteration if the database hasn't
+   * enough records of this task.
+   *
+   * @return The transferred candidates, each one with the execution cost of
+   *     its record scaled by the ratio of the sizes of variables in this task
+   *     to those in the similar task.
+   */
+  const std::vector<std::pair<SearchState, double>>& TransferFromSimilarTasks(int topk);
+
 #ifdef CINN_WITH_TEST
   /**
    * Method only be called during testing. It is used to set mock search
@@ -140,6 +153,9 @@ class EvolutionarySearch {
   // schedule rules used after mutation
   std::vector<std::unique_ptr<PostScheduleRule>> post_schedule_rules_;
   utils::LinearRandomEngine::StateType rand_seed_;
+  // candidates transferred from similar tasks and their scaled execution costs
+  bool transferred_ = false;
+  std::vector<std::pair<SearchState, double>> transferred_candidates_;
 };
 
 }  // namespace auto_schedule
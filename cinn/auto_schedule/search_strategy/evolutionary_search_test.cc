@@ -16,7 +16,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <numeric>
 #include <utility>
 
 #include "cinn/auto_schedule/cost_model/expr_cost_model.h"
@@ -192,5 +195,53 @@ TEST(EvolutionarySearch, Evolve) {
   }
 }
 
+TEST(EvolutionarySearch, TransferFromSimilarTasks) {
+  auto target      = common::DefaultNVGPUTarget();
+  auto small_tasks = CreateTasks(tests::OpBuilder("matmul").Build({{"X", {32, 32}}, {"Y", {32, 32}}}), target);
+  auto large_tasks = CreateTasks(tests::OpBuilder("matmul").Build({{"X", {64, 64}}, {"Y", {64, 64}}}), target);
+  ASSERT_EQ(small_tasks.size(), 1UL);
+  ASSERT_EQ(large_tasks.size(), 1UL);
+  ASSERT_EQ(SimilarTaskKey(small_tasks[0].serialized_key), SimilarTaskKey(large_tasks[0].serialized_key));
+
+  // record a sketch of the small matmul
+  ExprCostModel cost_model;
+  Database db(2);
+  EvolutionarySearch small_search(small_tasks[0], cost_model, &db);
+  auto sketches = small_search.TestInitSketch(1, "rule_prune");
+  ASSERT_EQ(sketches.size(), 1UL);
+  db.AddRecord(TuningRecord(small_tasks[0].serialized_key, sketches[0], 10.0));
+
+  EvolutionarySearch large_search(large_tasks[0], cost_model, &db);
+  const auto& transferred = large_search.TransferFromSimilarTasks(2);
+  ASSERT_EQ(transferred.size(), 1UL);
+  // the cost is scaled by the sizes of the variables
+  EXPECT_DOUBLE_EQ(transferred[0].second, 40.0);
+  // the tiles of the 32-extent loops are rescaled to the 64-extent ones
+  auto source_steps = sketches[0]->ir_schedule.GetTraceDesc().Steps();
+  auto steps        = transferred[0].first->ir_schedule.GetTraceDesc().Steps();
+  ASSERT_EQ(steps.size(), source_steps.size());
+  int num_tiles = 0;
+  for (size_t i = 0; i < steps.size(); ++i) {
+    ASSERT_EQ(steps[i].type, source_steps[i].type);
+    if (steps[i].type == "SamplePerfectTile") {
+      auto source_factors = absl::get<std::vector<int>>(source_steps[i].attrs.at("decision"));
+      auto factors        = absl::get<std::vector<int>>(steps[i].attrs.at("decision"));
+      if (std::count(source_factors.begin(), source_factors.end(), -1)) {
+        // the tiles inferred by Split are kept
+        EXPECT_EQ(factors, source_factors);
+        continue;
+      }
+      auto product_fn = [](const std::vector<int>& v) {
+        return std::accumulate(v.begin(), v.end(), 1, std::multiplies<int>());
+      };
+      EXPECT_EQ(product_fn(source_factors), 32);
+      EXPECT_EQ(product_fn(factors), 64);
+      EXPECT_EQ(factors.back(), source_factors.back());
+      ++num_tiles;
+    }
+  }
+  VLOG(6) << "Transferred " << num_tiles << " tiles:\n" << transferred[0].first->ir_schedule.GetModule().GetExprs()[0];
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -15,6 +15,7 @@
 #include "cinn/auto_schedule/search_strategy/mutate_rule/mutate_rule.h"
 
 #include "cinn/auto_schedule/search_strategy/mutate_rule/mutate_tile_size.h"
+#include "cinn/auto_schedule/search_strategy/mutate_rule/mutate_vectorize_factor.h"
 
 namespace cinn {
 namespace auto_schedule {
@@ -22,6 +23,8 @@ namespace auto_schedule {
 std::unique_ptr<MutateRule> MutateRule::Make(const std::string& name) {
   if (name == "mutate_tile_size") {
     return std::make_unique<MutateTileSize>();
+  } else if (name == "mutate_vectorize_factor") {
+    return std::make_unique<MutateVectorizeFactor>();
   } else {
     LOG(FATAL) << "MutateRule " << name << " is not supported.";
   }
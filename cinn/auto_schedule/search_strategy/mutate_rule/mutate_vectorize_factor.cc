@@ -0,0 +1,78 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_strategy/mutate_rule/mutate_vectorize_factor.h"
+
+#include <glog/logging.h>
+
+#include <vector>
+
+#include "cinn/ir/ir.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+using ::cinn::ir::ScheduleDesc;
+using ::cinn::utils::LinearRandomEngine;
+
+// the widest vector is 512 bits of 8-bit lanes
+static constexpr int kMaxVectorizeFactor = 64;
+
+// Get the factors a Vectorize step can be mutated to, the extent of the loop is the one recorded in the step
+static std::vector<int> GetOptionalFactors(const ScheduleDesc::Step& step) {
+  int factor          = absl::get<int>(step.attrs.at("factor"));
+  const ir::For* loop = step.inputs.at("loop").front().As<ir::For>();
+  if (!loop || !loop->extent.is_constant()) return {};
+
+  int extent = loop->extent.as_int32();
+  std::vector<int> res;
+  for (int candidate : {factor / 2, factor * 2}) {
+    if (candidate >= 2 && candidate <= kMaxVectorizeFactor && extent % candidate == 0) {
+      res.push_back(candidate);
+    }
+  }
+  return res;
+}
+
+ScheduleDesc MutateVectorizeFactor::Apply(const ScheduleDesc& trace, LinearRandomEngine::StateType* rand_seed) {
+  VLOG(6) << "Start applying MutateVectorizeFactor, old trace: \n" << trace.DebugString();
+  std::vector<ScheduleDesc::Step> steps;
+  std::vector<int> mutable_step_indices;
+  for (auto&& step : trace.Steps()) {
+    if (step.type == "TagPostSchedule") {
+      break;
+    }
+    if (step.type == "Vectorize" && !GetOptionalFactors(step).empty()) {
+      mutable_step_indices.push_back(steps.size());
+    }
+    steps.push_back(step);
+  }
+  if (mutable_step_indices.empty()) {
+    VLOG(6) << "MutateVectorizeFactor failed, try other mutate rules.";
+    return trace;
+  }
+
+  int step_idx   = mutable_step_indices.at(utils::SampleUniformInt(0, mutable_step_indices.size(), rand_seed));
+  auto factors   = GetOptionalFactors(steps.at(step_idx));
+  int new_factor = factors.at(utils::SampleUniformInt(0, factors.size(), rand_seed));
+  VLOG(6) << "Mutate the factor of step " << step_idx << " from " << absl::get<int>(steps[step_idx].attrs.at("factor"))
+          << " to " << new_factor;
+  steps[step_idx].attrs["factor"] = new_factor;
+  ScheduleDesc new_trace(std::move(steps));
+  VLOG(6) << "End applying MutateVectorizeFactor, new trace: \n" << new_trace.DebugString();
+  return new_trace;
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,77 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_strategy/mutate_rule/mutate_vectorize_factor.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include "cinn/cinn.h"
+#include "cinn/ir/ir_schedule.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+TEST(MutateVectorizeFactor, Basic) {
+  Context::Global().ResetNameId();
+  Target target = common::DefaultHostTarget();
+
+  const int kSize = 64;
+  Expr M(kSize);
+  Expr N(kSize);
+
+  Placeholder<float> A("A", {M, N});
+  Placeholder<float> B("B", {M, N});
+  ir::Tensor C = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) + B(i, j); }, "C");
+
+  poly::StageMap stages = CreateStages({C});
+  std::vector<ir::LoweredFunc> funcs =
+      lang::LowerVec("TestMutateVectorizeFactor_Basic", stages, {A, B, C}, {}, {}, nullptr, target, true);
+
+  ir::ModuleExpr module_expr({funcs[0]->body});
+  utils::LinearRandomEngine::StateType rand_seed = 123;
+  ir::IRSchedule ir_schedule(module_expr, rand_seed);
+  ir::IRSchedule new_ir_schedule(ir_schedule);
+
+  auto loops = ir_schedule.GetLoops("C");
+  ir_schedule.Vectorize(loops[1], 16);
+
+  MutateVectorizeFactor mutator;
+  ir::ScheduleDesc sch_desc = mutator.Apply(ir_schedule.GetTraceDesc(), &rand_seed);
+  int last_factor           = 16;
+  for (int i = 0; i < 10; ++i) {
+    int factor = absl::get<int>(sch_desc.Steps().back().attrs.at("factor"));
+    // the factor is doubled or halved while it divides the extent
+    ASSERT_TRUE(factor == last_factor * 2 || factor * 2 == last_factor);
+    ASSERT_GE(factor, 2);
+    ASSERT_EQ(kSize % factor, 0);
+    last_factor = factor;
+    sch_desc    = mutator.Apply(sch_desc, &rand_seed);
+  }
+
+  // the mutated trace is replayed with the new factor
+  sch_desc.Replay(&new_ir_schedule, true);
+  const ir::For* vectorized_loop = new_ir_schedule.GetLoops("C")[1].As<ir::For>();
+  ASSERT_TRUE(vectorized_loop->is_vectorized());
+  ASSERT_EQ(vectorized_loop->vectorize_info().factor, absl::get<int>(sch_desc.Steps().back().attrs.at("factor")));
+
+  // the trace without Vectorize steps is not changed
+  ir::IRSchedule unvectorized_schedule(module_expr, rand_seed);
+  unvectorized_schedule.Parallel(unvectorized_schedule.GetLoops("C")[0]);
+  ASSERT_EQ(mutator.Apply(unvectorized_schedule.GetTraceDesc(), &rand_seed).Steps().size(), 1UL);
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
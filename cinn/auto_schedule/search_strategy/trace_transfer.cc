@@ -0,0 +1,133 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_strategy/trace_transfer.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+#include "cinn/auto_schedule/task/tune_task.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/schedule_desc.h"
+#include "cinn/optim/ir_copy.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+std::vector<int> RescaleTileFactors(const std::vector<int>& factors, int extent) {
+  CHECK(!factors.empty()) << "The factors to be rescaled should not be empty";
+  CHECK_GT(extent, 0) << "The extent of a tiled loop should be positive";
+  std::vector<int> rescaled(factors.size());
+  int remaining = extent;
+  for (int i = factors.size() - 1; i > 0; --i) {
+    int factor = std::min(factors[i], remaining);
+    while (factor > 1 && remaining % factor != 0) {
+      --factor;
+    }
+    rescaled[i] = std::max(factor, 1);
+    remaining /= rescaled[i];
+  }
+  rescaled[0] = remaining;
+  return rescaled;
+}
+
+// Translate a block name by the longest name to be replaced appearing in it as a whole part separated by '_'
+std::string TranslateBlockName(const std::string& name,
+                               const std::vector<std::pair<std::string, std::string>>& sorted_name_map) {
+  for (auto&& names : sorted_name_map) {
+    auto& from = names.first;
+    for (auto pos = name.find(from); pos != std::string::npos; pos = name.find(from, pos + 1)) {
+      auto end = pos + from.size();
+      if ((pos == 0 || name[pos - 1] == '_') && (end == name.size() || name[end] == '_')) {
+        return name.substr(0, pos) + names.second + name.substr(end);
+      }
+    }
+  }
+  return name;
+}
+
+void TranslateBlockNames(const std::vector<std::pair<std::string, std::string>>& name_map,
+                         ir::proto::ScheduleDesc* trace) {
+  auto sorted_name_map = name_map;
+  std::sort(sorted_name_map.begin(), sorted_name_map.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first.size() > rhs.first.size();
+  });
+  for (auto& step : *trace->mutable_steps()) {
+    for (auto& attr : *step.mutable_attrs()) {
+      if (attr.name() == "block_name") {
+        attr.set_s(TranslateBlockName(attr.s(), sorted_name_map));
+      }
+    }
+  }
+}
+
+bool TransferTrace(const ir::proto::ScheduleDesc& trace,
+                   const std::string& from_key,
+                   const std::string& to_key,
+                   const ir::ModuleExpr& module_expr,
+                   ir::proto::ScheduleDesc* transferred) {
+  // the similar tasks print their variables in the same order
+  auto from_variables = ParseVariablesFromKey(from_key);
+  auto to_variables   = ParseVariablesFromKey(to_key);
+  CHECK_EQ(from_variables.size(), to_variables.size()) << "The tasks to transfer a trace between are not similar";
+  std::vector<std::pair<std::string, std::string>> name_map;
+  for (size_t i = 0; i < from_variables.size(); ++i) {
+    if (from_variables[i].first != to_variables[i].first) {
+      name_map.emplace_back(from_variables[i].first, to_variables[i].first);
+    }
+  }
+  *transferred = trace;
+  TranslateBlockNames(name_map, transferred);
+
+  // replay the steps before each sampled tile to get the extent of the tiled loop, the tiles sampled
+  // before are rescaled already so the replay is valid
+  for (int i = 0; i < transferred->steps_size(); ++i) {
+    auto* step = transferred->mutable_steps(i);
+    if (step->type() != "SamplePerfectTile") {
+      continue;
+    }
+    auto decision = std::find_if(step->mutable_attrs()->begin(), step->mutable_attrs()->end(), [](const auto& attr) {
+      return attr.name() == "decision";
+    });
+    CHECK(decision != step->mutable_attrs()->end()) << "The decision of SamplePerfectTile is not recorded";
+    std::vector<int> factors(decision->ints().begin(), decision->ints().end());
+    // a factor -1 is inferred from the extent by Split, such as the tiles recorded by Split with int factors
+    if (std::find(factors.begin(), factors.end(), -1) != factors.end()) {
+      continue;
+    }
+
+    ir::proto::ScheduleDesc prefix;
+    prefix.mutable_steps()->CopyFrom(transferred->steps());
+    prefix.mutable_steps()->DeleteSubrange(i + 1, transferred->steps_size() - i - 1);
+    ir::IRSchedule ir_sch(optim::IRCopy(module_expr));
+    ir::ScheduleDesc::ReplayWithProto(prefix, &ir_sch);
+    auto replayed_steps = ir_sch.GetTraceDesc().Steps();
+    ir::Expr loop       = replayed_steps.back().inputs.at("loop").front();
+    CHECK(loop.As<ir::For>()) << "The sampled tile is not on a loop:" << loop;
+    ir::Expr extent = loop.As<ir::For>()->extent;
+    if (!extent.is_constant()) {
+      VLOG(4) << "Can't transfer the trace with a tiled loop of non-constant extent:" << extent;
+      return false;
+    }
+    decision->clear_ints();
+    for (int factor : RescaleTileFactors(factors, extent.as_int32())) {
+      decision->add_ints(factor);
+    }
+  }
+  return true;
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,62 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/schedule_desc.pb.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+/**
+ * Rescale the factors of a perfect tile to a new extent of the tiled loop. The inner factors are kept as much
+ * as possible: from the innermost one, each factor is replaced by the largest divisor of the remaining extent
+ * not greater than it, and the outermost factor takes the rest. So the product of the result is `extent`.
+ */
+std::vector<int> RescaleTileFactors(const std::vector<int>& factors, int extent);
+
+/**
+ * Replace the names of schedule blocks recorded in a trace. The blocks created by schedule are named after
+ * the initial ones, such as "rf_var_1" and "var_1_write_cache", so the longest name to be replaced appearing
+ * in a block name as a whole part separated by '_' is replaced.
+ * @param name_map The pairs of names to be replaced and their replacements.
+ * @param trace The trace to be updated.
+ */
+void TranslateBlockNames(const std::vector<std::pair<std::string, std::string>>& name_map,
+                         ir::proto::ScheduleDesc* trace);
+
+/**
+ * Transfer the trace of a task to a similar task with different variable names and shapes, see SimilarTaskKey.
+ * The block names are translated by the variables of the tasks and the sampled tile factors are rescaled to
+ * the extents of loops on the initial ModuleExpr of the similar task.
+ * @param trace The trace of the source task.
+ * @param from_key The serialized_key of the source task.
+ * @param to_key The serialized_key of the similar task.
+ * @param module_expr The initial ModuleExpr of the similar task.
+ * @param transferred The transferred trace.
+ * @return Whether the trace can be transferred, false if any tiled loop hasn't a constant extent.
+ */
+bool TransferTrace(const ir::proto::ScheduleDesc& trace,
+                   const std::string& from_key,
+                   const std::string& to_key,
+                   const ir::ModuleExpr& module_expr,
+                   ir::proto::ScheduleDesc* transferred);
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,55 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/search_strategy/trace_transfer.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cinn {
+namespace auto_schedule {
+
+TEST(TraceTransfer, RescaleTileFactors) {
+  // the same extent
+  EXPECT_EQ(RescaleTileFactors({4, 2, 8}, 64), std::vector<int>({4, 2, 8}));
+  // the inner factors are kept for a larger extent
+  EXPECT_EQ(RescaleTileFactors({4, 2, 8}, 256), std::vector<int>({16, 2, 8}));
+  // the inner factors are shrunk to divide a smaller or an odd extent
+  EXPECT_EQ(RescaleTileFactors({4, 2, 8}, 4), std::vector<int>({1, 1, 4}));
+  EXPECT_EQ(RescaleTileFactors({1, 32}, 96), std::vector<int>({3, 32}));
+  EXPECT_EQ(RescaleTileFactors({1, 32}, 100), std::vector<int>({4, 25}));
+  EXPECT_EQ(RescaleTileFactors({2, 4}, 7), std::vector<int>({7, 1}));
+}
+
+TEST(TraceTransfer, TranslateBlockNames) {
+  ir::proto::ScheduleDesc trace;
+  for (auto&& name : {"var_1", "var_12", "rf_var_1", "var_1_write_cache", "A"}) {
+    auto* attr = trace.add_steps()->add_attrs();
+    attr->set_name("block_name");
+    attr->set_dtype(ir::proto::ScheduleDesc_Attr_DataType_STRING);
+    attr->set_s(name);
+  }
+  TranslateBlockNames({{"var_1", "var_5"}, {"var_12", "var_6"}}, &trace);
+  std::vector<std::string> names;
+  for (auto&& step : trace.steps()) {
+    names.push_back(step.attrs(0).s());
+  }
+  EXPECT_EQ(names, std::vector<std::string>({"var_5", "var_6", "rf_var_5", "var_5_write_cache", "A"}));
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
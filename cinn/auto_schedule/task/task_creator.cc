@@ -17,7 +17,9 @@
 #include <glog/logging.h>
 
 #include <memory>
+#include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "cinn/hlir/framework/graph.h"
@@ -53,5 +55,25 @@ std::vector<TuneTask> TaskCreator::CreateTuneTaskOpLevel(Graph* graph) {
   return ret_tasks;
 }
 
+std::vector<TuneTask> TaskCreator::MergeDuplicateTasks(const std::vector<TuneTask>& tasks,
+                                                       std::vector<int>* tuned_task_ids) {
+  std::vector<TuneTask> ret_tasks;
+  std::unordered_map<std::string, int> key2task_id;
+  tuned_task_ids->clear();
+  for (const auto& task : tasks) {
+    CHECK(!task.structural_key.empty()) << "The task should be initialized before merging";
+    auto it = key2task_id.find(task.structural_key);
+    if (it == key2task_id.end()) {
+      it = key2task_id.emplace(task.structural_key, ret_tasks.size()).first;
+      ret_tasks.emplace_back(task);
+      ret_tasks.back().multiplicity = 0;
+    }
+    ret_tasks.at(it->second).multiplicity += task.multiplicity;
+    tuned_task_ids->push_back(it->second);
+  }
+  VLOG(3) << "Merge " << tasks.size() << " tasks into " << ret_tasks.size() << " distinct ones";
+  return ret_tasks;
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -30,6 +30,11 @@ namespace auto_schedule {
 class TaskCreator {
  public:
   std::vector<TuneTask> CreateTuneTaskOpLevel(hlir::framework::Graph* graph);
+
+  // Merge the initialized tasks with the same structural_key. The first one of the identical tasks is
+  // kept to be tuned on behalf of all of them, and its multiplicity counts them. The index of the kept
+  // task for each input task is returned by `tuned_task_ids`.
+  std::vector<TuneTask> MergeDuplicateTasks(const std::vector<TuneTask>& tasks, std::vector<int>* tuned_task_ids);
 };
 
 }  // namespace auto_schedule
@@ -25,6 +25,9 @@
 #include "cinn/hlir/framework/graph.h"
 #include "cinn/hlir/framework/graph_compiler.h"
 #include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op_lowering.h"
+
+DECLARE_bool(cinn_ir_schedule);
 
 namespace cinn {
 namespace auto_schedule {
@@ -68,5 +71,45 @@ TEST(TaskCreator, Basic) {
   }
 }
 
+TEST(TaskCreator, MergeDuplicateTasks) {
+  FLAGS_cinn_ir_schedule = true;
+#ifdef CINN_WITH_CUDA
+  Target target = common::DefaultNVGPUTarget();
+#else
+  Target target = common::DefaultHostTarget();
+#endif
+  // the two additions are identical except for the variable names
+  NetBuilder builder("net_builder");
+  auto a = builder.CreateInput(Float(32), {32, 24}, "A");
+  auto b = builder.CreateInput(Float(32), {32, 24}, "B");
+  auto c = builder.Add(a, b);
+  auto d = builder.Add(c, b);
+  builder.Relu(d);
+  auto graph = std::make_shared<hlir::framework::Graph>(builder.Build(), target);
+
+  TaskCreator task_creator;
+  std::vector<TuneTask> tasks = task_creator.CreateTuneTaskOpLevel(graph.get());
+  ASSERT_EQ(tasks.size(), 3UL);
+
+  const auto& shape_dict = graph->GetAttrs<absl::flat_hash_map<std::string, hlir::framework::shape_t>>("infershape");
+  const auto& dtype_dict = graph->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+  hlir::framework::OpLowerer op_lowerer(dtype_dict, shape_dict, target);
+  for (TuneTask& task : tasks) {
+    task.Initialize(shape_dict, dtype_dict, &op_lowerer);
+  }
+  ASSERT_NE(tasks[0].serialized_key, tasks[1].serialized_key);
+  ASSERT_EQ(tasks[0].structural_key, tasks[1].structural_key);
+  ASSERT_NE(tasks[0].structural_key, tasks[2].structural_key);
+
+  std::vector<int> tuned_task_ids;
+  std::vector<TuneTask> merged_tasks = task_creator.MergeDuplicateTasks(tasks, &tuned_task_ids);
+  ASSERT_EQ(merged_tasks.size(), 2UL);
+  ASSERT_EQ(merged_tasks[0].subgraph, tasks[0].subgraph);
+  ASSERT_EQ(merged_tasks[0].multiplicity, 2);
+  ASSERT_EQ(merged_tasks[1].subgraph, tasks[2].subgraph);
+  ASSERT_EQ(merged_tasks[1].multiplicity, 1);
+  ASSERT_EQ(tuned_task_ids, std::vector<int>({0, 0, 1}));
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -16,13 +16,19 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <limits>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "cinn/auto_schedule/analysis/analyze_ir.h"
 #include "cinn/auto_schedule/cost_model/expr_cost_model.h"
 #include "cinn/auto_schedule/measure/measure.h"
 #include "cinn/auto_schedule/search_strategy/evolutionary_search.h"
+#include "cinn/auto_schedule/search_strategy/trace_transfer.h"
 #include "cinn/common/target.h"
 #include "cinn/hlir/framework/op_lowering.h"
 #include "cinn/hlir/op/external_api_registry.h"
@@ -58,6 +64,8 @@ bool IsForbiddenToTune(const TuneTask* task);
 bool IsWrappedByCustomCall(const TuneTask* task);
 // tell whether the task has registered external api
 bool HasExternalApi(const TuneTask* task);
+// lower the task by wrapping its op as custom_call to call the external api
+FunctionGroup LowerWithExternalApi(TuneTask* task);
 
 TaskOptimizer::TaskOptimizer(TuneTask* task,
                              ScheduleMeasurer* schedule_measurer,
@@ -69,10 +77,14 @@ TaskOptimizer::TaskOptimizer(TuneTask* task,
       cost_model_(),
       rand_seed_(utils::LinearRandomEngine::NormalizeState(rand_seed)) {}
 
-FunctionGroup TaskOptimizer::Optimize(const TuningOptions& options) {
+FunctionGroup TaskOptimizer::Optimize(const TuningOptions& options, std::chrono::steady_clock::time_point deadline) {
   CHECK(task_->subgraph != nullptr) << "subgraph can't be empty";
+  num_trials_ = 0;
   // task with forbidden or custom_call ops can't be tuned
   if (IsForbiddenToTune(task_) || IsWrappedByCustomCall(task_)) {
+    best_from_ = "Manual";
+    best_cost_ = std::numeric_limits<double>::max();
+    best_trace_.reset();
     return task_->op_lowerer->Lower(task_->subgraph);
   }
   // TODO(CtfGo): the input/output names of a Graph::Group will be changed in Lowering by OpLowerer currently,
@@ -82,14 +94,18 @@ FunctionGroup TaskOptimizer::Optimize(const TuningOptions& options) {
   auto initial_output_names = task_->subgraph->output_names;
 
   std::vector<TaskOptimizer::Result> candidates;
-  candidates.emplace_back(OptimizeByEvolution(options));
+  candidates.emplace_back(OptimizeByEvolution(options, deadline));
   candidates.emplace_back(OptimizeByManual(options.num_measure_trials > 0));
+  initial_cost_ = candidates.back().cost;
   if (HasExternalApi(task_)) {
     candidates.emplace_back(OptimizeByExternal(options.num_measure_trials > 0));
   }
   sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) { return lhs.cost < rhs.cost; });
   auto&& best = candidates.front();
   VLOG(4) << "Total candidates=" << candidates.size() << ", the best from=" << best.from << ", cost=" << best.cost;
+  best_from_  = best.from;
+  best_cost_  = best.cost;
+  best_trace_ = best.trace;
 
   // revert input/output names
   task_->subgraph->input_names  = initial_input_names;
@@ -133,14 +149,7 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByManual(bool need_measured) {
 TaskOptimizer::Result TaskOptimizer::OptimizeByExternal(bool need_measured) {
   static constexpr char* kExternalMeasuredKeyPrefix = "@ExternalMeasured:\n";
   TaskOptimizer::Result result("External");
-  auto nodes       = task_->subgraph->CollectNodes();
-  auto* first_node = nodes.front();
-
-  // set the necessary field for lowering with external api
-  std::string original_op                     = first_node->op()->name;
-  first_node->attrs.attr_store["original_op"] = original_op;
-  first_node->attrs.op                        = hlir::framework::Operator::Get("custom_call");
-  result.functions                            = task_->op_lowerer->Lower(task_->subgraph);
+  result.functions = LowerWithExternalApi(task_);
 
   // add the specific prefix in front of serialized_key to be store/load measured record for external api
   result.cost              = -1.0;  // the external is regarded as the best in default, so we set its cost -1.0
@@ -162,6 +171,99 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByExternal(bool need_measured) {
   return result;
 }
 
+FunctionGroup TaskOptimizer::ShareResult(TuneTask* task) const {
+  CHECK(task->subgraph != nullptr) << "subgraph can't be empty";
+  CHECK(!best_from_.empty()) << "The task should be optimized before sharing its result";
+  auto initial_input_names  = task->subgraph->input_names;
+  auto initial_output_names = task->subgraph->output_names;
+
+  FunctionGroup functions;
+  if (best_from_ == "External") {
+    functions = LowerWithExternalApi(task);
+  } else if (best_from_ == "Evolution") {
+    functions = best_trace_ ? ReplayTraceOnIdenticalTask(best_trace_->ToProto(), task_, task)
+                            : optim::IRCopy(task->lowered_funcs);
+  } else {
+    functions = task->op_lowerer->Lower(task->subgraph);
+  }
+
+  // revert input/output names
+  task->subgraph->input_names  = initial_input_names;
+  task->subgraph->output_names = initial_output_names;
+  return functions;
+}
+
+// collect the names of the schedule blocks in the initial functions of a task in order
+std::vector<std::string> GetBlockNames(const TuneTask* task) {
+  ir::IRSchedule ir_sch(ir::ModuleExpr(task->GetLoweredFuncBodyExprs()));
+  std::vector<std::string> names;
+  for (auto&& block : ir_sch.GetAllBlocks()) {
+    names.push_back(block.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->name);
+  }
+  return names;
+}
+
+FunctionGroup ReplayTraceOnIdenticalTask(const ir::proto::ScheduleDesc& trace,
+                                         const TuneTask* source_task,
+                                         TuneTask* target_task) {
+  // the identical tasks have the same blocks in the same order, differing only in names
+  auto source_names = GetBlockNames(source_task);
+  auto target_names = GetBlockNames(target_task);
+  if (source_names.size() != target_names.size()) {
+    LOG(WARNING) << "The blocks of the identical tasks mismatch, lower the task with manual schedule instead";
+    return target_task->op_lowerer->Lower(target_task->subgraph);
+  }
+  std::vector<std::pair<std::string, std::string>> name_map;
+  for (size_t i = 0; i < source_names.size(); ++i) {
+    name_map.emplace_back(source_names[i], target_names[i]);
+  }
+
+  auto translated = trace;
+  TranslateBlockNames(name_map, &translated);
+  return ReplayTrace(translated, target_task);
+}
+
+FunctionGroup LowerWithManualSchedule(TuneTask* task) {
+  auto initial_input_names  = task->subgraph->input_names;
+  auto initial_output_names = task->subgraph->output_names;
+  auto functions            = task->op_lowerer->Lower(task->subgraph);
+
+  task->subgraph->input_names  = initial_input_names;
+  task->subgraph->output_names = initial_output_names;
+  return functions;
+}
+
+FunctionGroup ReplayTrace(const ir::proto::ScheduleDesc& trace,
+                          const TuneTask* task,
+                          absl::optional<ir::ScheduleDesc>* replayed_trace) {
+  ir::IRSchedule ir_sch(ir::ModuleExpr(optim::IRCopy(task->GetLoweredFuncBodyExprs())));
+  ir::ScheduleDesc::ReplayWithProto(trace, &ir_sch);
+  if (replayed_trace != nullptr) {
+    *replayed_trace = ir_sch.GetTraceDesc();
+  }
+
+  std::vector<ir::Expr> exprs = ir_sch.GetModule().GetExprs();
+  CHECK_EQ(exprs.size(), task->lowered_funcs.size())
+      << "RuntimeError: Expr size is not equal to LoweredFunc size in TaskOptimizer";
+  auto init_funcs = optim::IRCopy(task->lowered_funcs);
+  FunctionGroup functions;
+  for (size_t i = 0; i < exprs.size(); ++i) {
+    functions.emplace_back(UpdateFuncWithNewBody(task->target, init_funcs[i], exprs[i]));
+  }
+  return functions;
+}
+
+FunctionGroup LowerWithExternalApi(TuneTask* task) {
+  auto nodes       = task->subgraph->CollectNodes();
+  auto* first_node = nodes.front();
+
+  // set the necessary field for lowering with external api
+  std::string original_op                     = first_node->op()->name;
+  first_node->attrs.attr_store["original_op"] = original_op;
+  first_node->attrs.op                        = hlir::framework::Operator::Get("custom_call");
+  return task->op_lowerer->Lower(task->subgraph);
+}
+
 bool IsForbiddenToTune(const TuneTask* task) {
   // TODO(CtfGo): some operators may change its linked edges in
   // TransToCustomCallPass, like conv2d, we will skip these ops in auto-schedule
@@ -199,7 +301,8 @@ bool IsWrappedByCustomCall(const TuneTask* task) {
   return false;
 }
 
-TaskOptimizer::Result TaskOptimizer::OptimizeByEvolution(const TuningOptions& options) {
+TaskOptimizer::Result TaskOptimizer::OptimizeByEvolution(const TuningOptions& options,
+                                                         std::chrono::steady_clock::time_point deadline) {
   CHECK_EQ(options.num_measure_trials % options.num_samples_per_iteration, 0)
       << "TuningOptions.num_measure_trials % TuningOptions.num_samples_per_iteration must be 0.";
 
@@ -210,11 +313,28 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByEvolution(const TuningOptions& op
     VLOG(4) << "lowered_funcs[" << i << "] detail:\n" << task_->lowered_funcs[i];
   }
 
+  if (pending_resumed_trials_ < 0) {
+    // count the trials recorded before this tuning, the ones measured from now on are not included
+    pending_resumed_trials_ = options.resume_from_database ? database_->TotalCount(task_->serialized_key) : 0;
+  }
+
   if (evolutionary_search_ == nullptr) {
     // TODO(zhhsplendid): check whether the options is same as previous,
     // if not, we should create new EvolutionarySearch
     evolutionary_search_ =
         std::make_unique<EvolutionarySearch>(*task_, cost_model_, database_, utils::ForkRandomState(&rand_seed_));
+    // pre-train the cost model with the candidates transferred from similar tasks
+    const auto& transferred = evolutionary_search_->TransferFromSimilarTasks(options.evolution_pick_database_topk);
+    if (FLAGS_auto_schedule_use_cost_model && !transferred.empty()) {
+      std::vector<const ir::ModuleExpr*> cost_model_samples;
+      std::vector<float> cost_model_labels;
+      for (auto&& candidate : transferred) {
+        cost_model_samples.push_back(&(candidate.first->ir_schedule.GetModule()));
+        cost_model_labels.push_back(candidate.second);
+      }
+      VLOG(4) << "Pre-train CostModel with transferred samples size=" << cost_model_samples.size();
+      cost_model_.Update(cost_model_samples, cost_model_labels, task_->target);
+    }
   }
 
   TaskOptimizer::Result result("Evolution");
@@ -230,15 +350,34 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByEvolution(const TuningOptions& op
         best_cost = cost_model_.Predict(states.front()->ir_schedule.GetModule(), task_->target);
       }
       optimized_funcs = measure_candidates[0].lowered_funcs;
+      result.trace    = states.front()->ir_schedule.GetTraceDesc();
     } else {
       LOG(WARNING) << "No valid candidate searched, will return initial state";
     }
     return result;
   }
 
-  int measured_count            = 0;
+  // the best record of the task in the database, measured in the previous rounds or by an interrupted tuning,
+  // is taken as the initial best so that a later round never returns a worse result
+  auto best_records = database_->GetTopK(task_->serialized_key, 1);
+  if (!best_records.empty()) {
+    best_cost       = best_records[0].execution_cost;
+    optimized_funcs = ReplayTrace(best_records[0].trace, task_, &result.trace);
+  }
+
+  int resumed_trials = std::min(pending_resumed_trials_, options.num_measure_trials);
+  pending_resumed_trials_ -= resumed_trials;
+  if (resumed_trials > 0) {
+    VLOG(3) << "Resume " << resumed_trials << " trials recorded in the database, best cost=" << best_cost;
+  }
+
+  int measured_count            = resumed_trials;
   uint32_t continuous_empty_cnt = 0;
-  while (measured_count < options.num_measure_trials) {
+  while (measured_count < options.num_measure_trials && !converged_) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      LOG(INFO) << "OptimizeByEvolution stops as the time budget is exhausted, measured_count=" << measured_count;
+      break;
+    }
     VLOG(4) << "Launch a new search, current measured_count:" << measured_count;
     std::vector<MeasureInput> measure_inputs;
     std::vector<SearchState> states = SearchOneRound(options, &measure_inputs);
@@ -281,16 +420,30 @@ TaskOptimizer::Result TaskOptimizer::OptimizeByEvolution(const TuningOptions& op
     }
 
     // update the best
+    double last_best_cost = best_cost;
     for (size_t i = 0; i < measure_outputs.size(); ++i) {
       if (measure_outputs[i].execution_cost < best_cost) {
         VLOG(4) << "Update best candidate with execution_cost:" << measure_outputs[i].execution_cost << "us";
         best_cost       = measure_outputs[i].execution_cost;
         optimized_funcs = measure_inputs[i].lowered_funcs;
+        result.trace    = states[i]->ir_schedule.GetTraceDesc();
       }
     }
 
     // count result size
     measured_count += states.size();
+    num_trials_ += states.size();
+
+    // stop early if the best cost plateaus
+    if (options.early_stopping_patience > 0) {
+      if (best_cost < last_best_cost * (1.0 - options.early_stopping_min_improvement)) {
+        num_iterations_without_improvement_ = 0;
+      } else if (++num_iterations_without_improvement_ >= options.early_stopping_patience) {
+        converged_ = true;
+        LOG(INFO) << "OptimizeByEvolution stops early as the best cost plateaus, best cost=" << best_cost
+                  << ", measured_count=" << measured_count;
+      }
+    }
   }
   return result;
 }
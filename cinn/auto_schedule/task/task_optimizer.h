@@ -14,7 +14,12 @@
 
 #pragma once
 
+#include <absl/types/optional.h>
+
+#include <chrono>
+#include <limits>
 #include <memory>
+#include <string>
 
 #include "cinn/auto_schedule/cost_model/expr_cost_model.h"
 #include "cinn/auto_schedule/database/database.h"
@@ -23,6 +28,7 @@
 #include "cinn/auto_schedule/task/tune_task.h"
 #include "cinn/auto_schedule/tuning.h"
 #include "cinn/ir/lowered_func.h"
+#include "cinn/ir/schedule_desc.h"
 #include "cinn/utils/random_engine.h"
 
 namespace cinn {
@@ -38,19 +44,40 @@ class TaskOptimizer {
                 Database* database,
                 utils::LinearRandomEngine::StateType rand_seed = -1);
 
-  FunctionGroup Optimize(const TuningOptions& options);
+  // Optimize the task within the measurement trials of options, the measurement stops once the deadline is passed
+  FunctionGroup Optimize(const TuningOptions& options,
+                         std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+  // The cost of the best candidate chosen by the last Optimize
+  double BestCost() const { return best_cost_; }
+
+  // The measured cost of the task with the manual schedule, it is 0 if not measured
+  double InitialCost() const { return initial_cost_; }
+
+  // The number of candidates measured by the last Optimize
+  int NumTrials() const { return num_trials_; }
+
+  // Whether the measurement is stopped early as the best measured cost plateaus, see
+  // TuningOptions.early_stopping_patience, the following Optimize won't measure any more
+  bool Converged() const { return converged_; }
+
+  // Generate the functions of a task structurally identical to the optimized one in the same
+  // way as the best candidate chosen by the last Optimize, so the task needn't be tuned again.
+  FunctionGroup ShareResult(TuneTask* task) const;
 
  private:
   struct Result {
     std::string from;
     double cost;
     FunctionGroup functions;
+    // the schedule applied on the initial functions, absent if the functions are not searched
+    absl::optional<ir::ScheduleDesc> trace;
     Result(const std::string& from_type) : from(from_type), cost(std::numeric_limits<double>::max()) {}
   };
 
   Result OptimizeByManual(bool need_measure);
   Result OptimizeByExternal(bool need_measure);
-  Result OptimizeByEvolution(const TuningOptions& options);
+  Result OptimizeByEvolution(const TuningOptions& options, std::chrono::steady_clock::time_point deadline);
 
   // call search candidates once by EvolutionarySearch and prune invalid ones
   std::vector<SearchState> SearchOneRound(const TuningOptions& options, std::vector<MeasureInput>* measure_candidates);
@@ -64,7 +91,34 @@ class TaskOptimizer {
   ExprCostModel cost_model_;
   Database* database_;
   utils::LinearRandomEngine::StateType rand_seed_;
+  // where the best candidate of the last Optimize comes from, and its cost and schedule
+  std::string best_from_;
+  double best_cost_ = std::numeric_limits<double>::max();
+  absl::optional<ir::ScheduleDesc> best_trace_;
+  // the measured cost with the manual schedule, and the number of candidates measured by the last Optimize
+  double initial_cost_ = 0.0;
+  int num_trials_      = 0;
+  // the number of continuous iterations without improving the best measured cost
+  int num_iterations_without_improvement_ = 0;
+  bool converged_                          = false;
+  // the number of trials recorded in the database before tuning and not yet counted against the budget,
+  // it is negative before the first Optimize
+  int pending_resumed_trials_ = -1;
 };
 
+// Lower the sub-graph of a task with the manual schedule, keeping its input/output names
+FunctionGroup LowerWithManualSchedule(TuneTask* task);
+
+// Replay a schedule on the initial functions of a task, and output the replayed schedule if required
+FunctionGroup ReplayTrace(const ir::proto::ScheduleDesc& trace,
+                          const TuneTask* task,
+                          absl::optional<ir::ScheduleDesc>* replayed_trace = nullptr);
+
+// Replay the schedule of a task on the initial functions of another task structurally identical to it, the names
+// of blocks in the schedule are translated, and the task is lowered with the manual schedule if they mismatch
+FunctionGroup ReplayTraceOnIdenticalTask(const ir::proto::ScheduleDesc& trace,
+                                         const TuneTask* source_task,
+                                         TuneTask* target_task);
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -17,6 +17,9 @@
 #include <glog/logging.h>
 
 #include <iostream>
+#include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "cinn/auto_schedule/analysis/analyze_ir.h"
@@ -40,6 +43,7 @@ void TuneTask::Initialize(const absl::flat_hash_map<std::string, hlir::framework
   this->lowered_funcs  = op_lowerer->LowerWithoutSchedule(subgraph);
   this->output_names   = GetOutputNamesFromLoweredFunc(this->lowered_funcs);
   this->serialized_key = SerializeToString(shape_dict, dtype_dict);
+  this->structural_key = SerializeToString(shape_dict, dtype_dict, false);
 }
 
 std::vector<ir::Expr> TuneTask::GetLoweredFuncBodyExprs() const {
@@ -51,10 +55,14 @@ std::vector<ir::Expr> TuneTask::GetLoweredFuncBodyExprs() const {
 }
 
 std::string TuneTask::SerializeToString(const absl::flat_hash_map<std::string, hlir::framework::shape_t>& shape_dict,
-                                        const absl::flat_hash_map<std::string, cinn::common::Type>& dtype_dict) {
+                                        const absl::flat_hash_map<std::string, cinn::common::Type>& dtype_dict,
+                                        bool with_variable_names) {
   std::stringstream ss;
   ss << target << "\n\n";  // print target
 
+  // number of each variable in order of appearance, used when the names are not printed
+  absl::flat_hash_map<std::string, int> var_numbers;
+
   // local function to print dtype,shape of out/in variables of the specified node
   auto print_node_links_fn = [&](const std::vector<common::Shared<common::GraphEdge>>& links, bool is_input) {
     int printed_num = 0;
@@ -75,7 +83,13 @@ std::string TuneTask::SerializeToString(const absl::flat_hash_map<std::string, h
       // operator. Here we add `var_node->id()` into the serialized_key to distinguish them, otherwise AutoTuner will
       // get wrong TuningRecords when querying cached results from database.  In the future, we should remove
       // name-related limit in Lower process, to avoid duplicate tuning tasks with same operators.
-      ss << var_node->id() << "->" << cinn::common::Type2Str(dit->second) << "[" + utils::Join(sit->second, ",") << "]";
+      if (with_variable_names) {
+        ss << var_node->id();
+      } else {
+        auto nit = var_numbers.emplace(var_node->id(), var_numbers.size()).first;
+        ss << "v" << nit->second;
+      }
+      ss << "->" << cinn::common::Type2Str(dit->second) << "[" + utils::Join(sit->second, ",") << "]";
     }
   };
 
@@ -86,12 +100,102 @@ std::string TuneTask::SerializeToString(const absl::flat_hash_map<std::string, h
     print_node_links_fn(node->outlinks_in_order(), false);
     ss << ") = " << node->op()->name << "(";
     print_node_links_fn(node->inlinks_in_order(), true);
-    ss << ")\n";
+    ss << ")";
+    if (!with_variable_names) {
+      // the variable names distinguish the nodes already, otherwise the ops differing in attributes should be told
+      std::map<std::string, utils::Attribute> sorted_attrs(node->attrs.attr_store.begin(),
+                                                           node->attrs.attr_store.end());
+      for (auto&& attr : sorted_attrs) {
+        ss << " " << attr.first << "=" << utils::Attribute2String(attr.second);
+      }
+      // the outputs of a group are kept as arguments of the lowered function
+      if (subgraph->output_nodes.count(node)) {
+        ss << " [output]";
+      }
+      if (subgraph->internal_nodes.count(node)) {
+        ss << " [internal]";
+      }
+    }
+    ss << "\n";
   }
   ss << "}\n";
 
   return ss.str();
 }
 
+namespace {
+
+// The positions of a variable printed as "name->dtype[d0,d1,...]" in a serialized_key
+struct VariableSpan {
+  size_t name_begin;
+  size_t name_end;
+  size_t shape_begin;  // position of '['
+  size_t shape_end;    // position of ']'
+};
+
+std::vector<VariableSpan> ParseVariableSpans(const std::string& serialized_key) {
+  std::vector<VariableSpan> spans;
+  for (auto pos = serialized_key.find("->"); pos != std::string::npos; pos = serialized_key.find("->", pos + 2)) {
+    VariableSpan span;
+    // a variable is printed after "(" or ", "
+    span.name_begin  = serialized_key.find_last_of("( ", pos) + 1;
+    span.name_end    = pos;
+    span.shape_begin = serialized_key.find('[', pos);
+    span.shape_end   = serialized_key.find(']', span.shape_begin);
+    CHECK(span.shape_begin != std::string::npos && span.shape_end != std::string::npos)
+        << "Can't find the shape of variable:" << serialized_key.substr(span.name_begin, pos - span.name_begin);
+    spans.push_back(span);
+    pos = span.shape_end;
+  }
+  return spans;
+}
+
+std::vector<int> ParseShape(const std::string& serialized_key, const VariableSpan& span) {
+  std::vector<int> shape;
+  auto dims = serialized_key.substr(span.shape_begin + 1, span.shape_end - span.shape_begin - 1);
+  for (auto&& dim : utils::Split(dims, ",")) {
+    shape.push_back(std::stoi(dim));
+  }
+  return shape;
+}
+
+}  // namespace
+
+std::vector<std::pair<std::string, std::vector<int>>> ParseVariablesFromKey(const std::string& serialized_key) {
+  std::vector<std::pair<std::string, std::vector<int>>> variables;
+  for (auto&& span : ParseVariableSpans(serialized_key)) {
+    variables.emplace_back(serialized_key.substr(span.name_begin, span.name_end - span.name_begin),
+                           ParseShape(serialized_key, span));
+  }
+  return variables;
+}
+
+std::string SimilarTaskKey(const std::string& serialized_key) {
+  // the variables are numbered in order of appearance, and so are the distinct extents except 1
+  absl::flat_hash_map<std::string, int> var_numbers;
+  absl::flat_hash_map<int, int> extent_numbers;
+  std::stringstream ss;
+  size_t printed = 0;
+  for (auto&& span : ParseVariableSpans(serialized_key)) {
+    auto name = serialized_key.substr(span.name_begin, span.name_end - span.name_begin);
+    auto nit  = var_numbers.emplace(name, var_numbers.size()).first;
+    ss << serialized_key.substr(printed, span.name_begin - printed) << "v" << nit->second;
+    ss << serialized_key.substr(span.name_end, span.shape_begin + 1 - span.name_end);
+    std::vector<std::string> dims;
+    for (int extent : ParseShape(serialized_key, span)) {
+      if (extent == 1) {
+        dims.emplace_back("1");
+      } else {
+        auto eit = extent_numbers.emplace(extent, extent_numbers.size()).first;
+        dims.emplace_back("d" + std::to_string(eit->second));
+      }
+    }
+    ss << utils::Join(dims, ",");
+    printed = span.shape_end;
+  }
+  ss << serialized_key.substr(printed);
+  return ss.str();
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cinn/common/target.h"
@@ -58,12 +59,28 @@ class TuneTask {
   // serialized string of this task, it contains struct,shape,dtype,input/output variable name
   // of the subgraph and can be further used to hash
   std::string serialized_key;
+  // serialized string of this task without variable names but with the attributes of ops, the
+  // tasks with the same structural_key only differ in variable names and can share a tuned result
+  std::string structural_key;
+  // the number of sub-graphs sharing the tuned result of this task, including its own
+  int multiplicity = 1;
 
  private:
-  // Serialize this task as a string contains specific fields of it
+  // Serialize this task as a string contains specific fields of it, the variables are numbered
+  // in order of appearance instead of their names if `with_variable_names` is false
   std::string SerializeToString(const absl::flat_hash_map<std::string, hlir::framework::shape_t>& shape_dict,
-                                const absl::flat_hash_map<std::string, cinn::common::Type>& dtype_dict);
+                                const absl::flat_hash_map<std::string, cinn::common::Type>& dtype_dict,
+                                bool with_variable_names = true);
 };
 
+// Parse the variables printed in the serialized_key of a task, return the name and shape of each one in order
+// of appearance, a variable appears as many times as it is printed
+std::vector<std::pair<std::string, std::vector<int>>> ParseVariablesFromKey(const std::string& serialized_key);
+
+// Get the key shared by the tasks similar to a task from its serialized_key. The similar tasks differ only in
+// the names of variables and the extents of dimensions, but the dimensions of extent 1 and which dimensions
+// have the same extent are kept, so they are lowered to loops of the same structure with different extents
+std::string SimilarTaskKey(const std::string& serialized_key);
+
 }  // namespace auto_schedule
 }  // namespace cinn
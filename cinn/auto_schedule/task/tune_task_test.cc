@@ -335,5 +335,38 @@ Group {
   EXPECT_EQ(fused_tasks[0].serialized_key, fused_expected_str);
 }
 
+TEST(TuneTask, SimilarTaskKey) {
+  std::string key = R"ROC(Target<linux,x86,64>
+
+Group {
+  (var_1->float32[32,24]) = elementwise_add(A->float32[32,24], B->float32[1,24])
+  (var_2->float32[32]) = reduce_sum(var_1->float32[32,24])
+}
+)ROC";
+  auto variables = ParseVariablesFromKey(key);
+  ASSERT_EQ(variables.size(), 5UL);
+  EXPECT_EQ(variables[2].first, "B");
+  EXPECT_EQ(variables[2].second, std::vector<int>({1, 24}));
+  EXPECT_EQ(variables[3].first, "var_2");
+  EXPECT_EQ(variables[3].second, std::vector<int>({32}));
+
+  std::string similar_key = R"ROC(Target<linux,x86,64>
+
+Group {
+  (v0->float32[d0,d1]) = elementwise_add(v1->float32[d0,d1], v2->float32[1,d1])
+  (v3->float32[d0]) = reduce_sum(v0->float32[d0,d1])
+}
+)ROC";
+  EXPECT_EQ(SimilarTaskKey(key), similar_key);
+  // the same structure with other names and extents
+  std::string other_key = key;
+  utils::Replace(&other_key, "var_", "tmp_");
+  utils::Replace(&other_key, "[32", "[64");
+  EXPECT_EQ(SimilarTaskKey(other_key), similar_key);
+  // the reduced dimension is different
+  utils::Replace(&other_key, "float32[64]", "float32[24]");
+  EXPECT_NE(SimilarTaskKey(other_key), similar_key);
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
@@ -0,0 +1,91 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/auto_schedule/task_scheduler/gradient_priority.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace cinn {
+namespace auto_schedule {
+
+GradientPriority::GradientPriority(const std::vector<TuneTask>& tasks, const Config& config)
+    : TaskScheduler(tasks, config),
+      num_picked_(tasks.size(), 0),
+      cost_history_(tasks.size()),
+      trials_history_(tasks.size()) {
+  CHECK_GT(config_.gradient_backward_window, 0) << "gradient_backward_window should be greater than 0";
+}
+
+int GradientPriority::NextTaskId() {
+  // a round picks as many times as the number of tasks
+  if (cur_task_id_ >= tasks_->size()) {
+    return -1;
+  }
+  ++cur_task_id_;
+
+  int best_id      = 0;
+  double best_gain = EstimateGain(0);
+  for (int i = 1; i < tasks_->size(); ++i) {
+    double gain = EstimateGain(i);
+    // the task picked fewer times goes first if they are equally promising
+    if (gain > best_gain || (gain == best_gain && num_picked_[i] < num_picked_[best_id])) {
+      best_id   = i;
+      best_gain = gain;
+    }
+  }
+  ++num_picked_[best_id];
+  VLOG(4) << "Pick task-" << best_id << " with estimated gain " << best_gain;
+  return best_id;
+}
+
+void GradientPriority::UpdateTaskCost(int task_id, double cost, int num_trials) {
+  CHECK_LT(task_id, tasks_->size()) << "Invalid task id";
+  auto& trials_history = trials_history_[task_id];
+  int total_trials     = (trials_history.empty() ? 0 : trials_history.back()) + std::max(num_trials, 1);
+  trials_history.push_back(total_trials);
+  cost_history_[task_id].push_back(cost);
+}
+
+double GradientPriority::EstimateGain(int task_id) const {
+  // every task is tuned once at first to know its cost
+  if (num_picked_[task_id] == 0) {
+    return std::numeric_limits<double>::max();
+  }
+  const auto& costs  = cost_history_[task_id];
+  const auto& trials = trials_history_[task_id];
+  // the costs are not measured, or measured invalid
+  auto is_valid = [](double cost) { return cost > 0.0 && cost < std::numeric_limits<double>::max(); };
+  if (costs.empty() || !is_valid(costs.back())) {
+    return 0.0;
+  }
+
+  // the decrease of the cost per trial in the latest tunings
+  double backward = 0.0;
+  int window      = std::min<int>(config_.gradient_backward_window, costs.size() - 1);
+  if (window > 0 && is_valid(costs[costs.size() - 1 - window])) {
+    int start = costs.size() - 1 - window;
+    backward  = (costs[start] - costs.back()) / (trials.back() - trials[start]);
+  }
+  // optimistically assume the cost keeps decreasing at the average speed since the beginning
+  double forward = costs.back() / trials.back();
+
+  double slope = config_.gradient_alpha * backward + (1 - config_.gradient_alpha) * forward;
+  return tasks_->at(task_id).multiplicity * slope;
+}
+
+}  // namespace auto_schedule
+}  // namespace cinn
@@ -0,0 +1,52 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/auto_schedule/task_scheduler/task_scheduler.h"
+
+namespace cinn {
+namespace auto_schedule {
+
+// Schedule tasks with gradient_priority strategy, that is picking the task
+// promising the maximum gain of the end-to-end latency per measurement trial,
+// estimated by its multiplicity times the decreasing slope of its cost.
+// Every round picks as many tasks as the number of tasks, and a promising
+// task may be picked several times while a converged one is skipped.
+class GradientPriority : public TaskScheduler {
+ public:
+  GradientPriority(const std::vector<TuneTask>& tasks, const Config& config);
+
+  const char* Name() const override { return "gradient_priority"; };
+
+  int NextTaskId() override;
+
+  void UpdateTaskCost(int task_id, double cost, int num_trials) override;
+
+ private:
+  // Estimate the decrease of the end-to-end latency per trial if the task is tuned once more
+  double EstimateGain(int task_id) const;
+
+  // The number of times each task is picked
+  std::vector<int> num_picked_;
+  // The best costs of each task after every tuning, and the accumulated trials to achieve them
+  std::vector<std::vector<double>> cost_history_;
+  std::vector<std::vector<int>> trials_history_;
+};
+
+}  // namespace auto_schedule
+}  // namespace cinn
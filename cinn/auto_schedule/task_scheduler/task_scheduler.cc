@@ -18,6 +18,7 @@
 
 #include "cinn/auto_schedule/task/tune_task.h"
 #include "cinn/auto_schedule/task_scheduler/efficiency_priority.h"
+#include "cinn/auto_schedule/task_scheduler/gradient_priority.h"
 #include "cinn/auto_schedule/task_scheduler/round_robin.h"
 
 namespace cinn {
@@ -31,6 +32,8 @@ std::unique_ptr<TaskScheduler> TaskScheduler::Make(const std::vector<TuneTask>&
     return std::make_unique<RoundRobin>(tasks, config);
   } else if (strategy == "efficiency_priority") {
     return std::make_unique<EfficiencyPriority>(tasks, config);
+  } else if (strategy == "gradient_priority") {
+    return std::make_unique<GradientPriority>(tasks, config);
   }
 
   LOG(FATAL) << "Unimplemented strategy:" << strategy;
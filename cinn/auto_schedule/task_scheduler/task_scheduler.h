@@ -34,6 +34,10 @@ class TaskScheduler {
   struct Config {
     // The minimum threshold of earnings ratio, used by EfficiencyPriority
     float minimum_gain_threshold = 0.0;
+    // The number of latest tunings to estimate the improvement of a task, used by GradientPriority
+    int gradient_backward_window = 3;
+    // The weight of the measured improvement against the optimistic one, used by GradientPriority
+    float gradient_alpha = 0.2;
   };
 
   // Create a TaskScheduler with the specific strategy name
@@ -51,6 +55,10 @@ class TaskScheduler {
   // Select a task to tune
   virtual int NextTaskId() = 0;
 
+  // Feed back the cost of the best schedule of a task after it is tuned with `num_trials`
+  // measurements, the strategies depending on the tuning progress should override it
+  virtual void UpdateTaskCost(int task_id, double cost, int num_trials) {}
+
  protected:
   // A taskScheduler object should be created with the static function Make
   TaskScheduler(const std::vector<TuneTask>& tasks, const Config& config);
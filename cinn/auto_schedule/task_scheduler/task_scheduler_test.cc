@@ -16,9 +16,11 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
 #include <type_traits>
 
 #include "cinn/auto_schedule/task_scheduler/efficiency_priority.h"
+#include "cinn/auto_schedule/task_scheduler/gradient_priority.h"
 #include "cinn/auto_schedule/task_scheduler/round_robin.h"
 
 namespace cinn {
@@ -32,6 +34,8 @@ TEST(TaskScheduler, Make) {
   ASSERT_STREQ(round_robin->Name(), "round_robin");
   auto efficiency_priority = TaskScheduler::Make(tasks, config, "efficiency_priority");
   ASSERT_STREQ(efficiency_priority->Name(), "efficiency_priority");
+  auto gradient_priority = TaskScheduler::Make(tasks, config, "gradient_priority");
+  ASSERT_STREQ(gradient_priority->Name(), "gradient_priority");
 }
 
 TEST(RoundRobinScheduler, NextTaskId) {
@@ -52,5 +56,33 @@ TEST(EfficiencyPriorityScheduler, NextTaskId) {
   ASSERT_EQ(-1, efficiency_priority->NextTaskId());
 }
 
+TEST(GradientPriorityScheduler, NextTaskId) {
+  std::vector<TuneTask> tasks(3);
+  tasks[1].multiplicity = 4;
+  TaskScheduler::Config config;
+  auto gradient_priority = TaskScheduler::Make(tasks, config, "gradient_priority");
+
+  // every task is tuned once at first
+  ASSERT_EQ(0, gradient_priority->NextTaskId());
+  ASSERT_EQ(1, gradient_priority->NextTaskId());
+  ASSERT_EQ(2, gradient_priority->NextTaskId());
+  ASSERT_EQ(-1, gradient_priority->NextTaskId());
+  gradient_priority->UpdateTaskCost(0, 100.0, 10);
+  gradient_priority->UpdateTaskCost(1, 10.0, 10);
+  gradient_priority->UpdateTaskCost(2, std::numeric_limits<double>::max(), 10);
+
+  // the estimated gains are 0.8 * 100 / 10 = 8 for task-0, 4 * 0.8 * 10 / 10 = 3.2 for task-1
+  // and 0 for task-2 whose cost is invalid
+  gradient_priority->Reset();
+  ASSERT_EQ(0, gradient_priority->NextTaskId());
+  gradient_priority->UpdateTaskCost(0, 100.0, 10);
+  // task-0 doesn't improve, its gain drops to 0.8 * 100 / 20 = 4
+  ASSERT_EQ(0, gradient_priority->NextTaskId());
+  gradient_priority->UpdateTaskCost(0, 100.0, 10);
+  // and then 0.8 * 100 / 30 < 3.2
+  ASSERT_EQ(1, gradient_priority->NextTaskId());
+  ASSERT_EQ(-1, gradient_priority->NextTaskId());
+}
+
 }  // namespace auto_schedule
 }  // namespace cinn
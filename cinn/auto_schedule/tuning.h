@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -77,8 +78,51 @@ struct TuningOptions {
   //
   // It explores the cases evolutionary search won't predict precisely
   float evolution_eps_greedy = 0.1f;
+
+  //////////////////////////////////////
+  // Budget and Resuming Related Options
+  //////////////////////////////////////
+
+  // The wall-clock budget of the whole tuning in seconds. Once it is exhausted, the measurement
+  // in progress stops, no more tasks are scheduled and the best results found so far are returned.
+  // There is no limit if it is not positive.
+  double time_budget_seconds = 0.0;
+
+  // A task stops being measured, in this round and the following ones, once its best measured cost
+  // doesn't decrease by more than early_stopping_min_improvement (a ratio of the cost) in
+  // early_stopping_patience continuous iterations. Early stopping is disabled if the patience is 0.
+  int early_stopping_patience          = 0;
+  float early_stopping_min_improvement = 0.01f;
+
+  // Count the records of a task already in the database against its measurement trials, so a tuning
+  // interrupted with a persistent database (such as DatabaseType::kJSONFile) resumes from where it
+  // stopped instead of measuring the same number of trials again.
+  bool resume_from_database = false;
+};
+
+// Progress of the tuning process, reported every time a task is tuned
+struct TuningProgress {
+  // the round and the id of the task just tuned
+  int round   = 0;
+  int task_id = -1;
+  // the number of candidates measured in the latest tuning of the task, and of all tasks so far
+  int num_trials   = 0;
+  int total_trials = 0;
+  // the cost of the best schedule of the task, and whether its measurement has stopped early
+  double best_cost = 0.0;
+  bool converged   = false;
+  // the best costs of all tasks indexed by task id, the ones not tuned yet are the max of double
+  std::vector<double> best_costs;
+  // the estimated end-to-end speedup: the total cost of the measured tasks with the manual schedule
+  // over the one with the best schedules, weighted by the number of sub-graphs sharing each task
+  double estimated_gain = 1.0;
+  // the wall-clock time since the tuning began
+  double elapsed_seconds = 0.0;
 };
 
+// The callback to observe the progress of the tuning process
+using TuningObserver = std::function<void(const TuningProgress&)>;
+
 // Result of the tuning process
 struct TuningResult {
   // Result of graph tuning
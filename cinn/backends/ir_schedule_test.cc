@@ -17,19 +17,28 @@
 #include <gtest/gtest.h>
 #include <stdlib.h>
 
+#include <string>
 #include <tuple>
 #include <vector>
 
 #include "cinn/backends/codegen_c.h"
 #include "cinn/backends/codegen_c_x86.h"
 #include "cinn/backends/codegen_cuda_dev.h"
+#include "cinn/backends/llvm/simple_jit.h"
 #include "cinn/cinn.h"
+#include "cinn/common/test_helper.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/intrinsic_ops.h"
 #include "cinn/ir/ir_printer.h"
+#include "cinn/ir/tensor_intrinsic.h"
 #include "cinn/lang/lower.h"
+#include "cinn/optim/ir_copy.h"
 #include "cinn/optim/ir_simplify.h"
+#include "cinn/optim/optimize.h"
 #include "cinn/optim/remove_schedule_block.h"
 #include "cinn/optim/unroll_loops.h"
 #include "cinn/optim/vectorize_loops.h"
+#include "cinn/runtime/intrinsic.h"
 
 namespace cinn {
 namespace backends {
@@ -2231,6 +2240,438 @@ void test_rfactor(void* _args, int32_t num_args)
   ASSERT_EQ(utils::Trim(target_code), utils::Trim(source_code));
 }
 
+TEST(IrSchedule, tensorize) {
+  Context::Global().ResetNameId();
+  Expr M(96);
+  Expr N(64);
+  Expr K(64);
+
+  Target target = common::DefaultHostTarget();
+
+  Placeholder<float> A("A", {M, K});
+  Placeholder<float> B("B", {K, N});
+  Var k(64, "k0");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return lang::ReduceSum(A(i, k) * B(k, j), {k}); }, "C");
+
+  auto stages = CreateStages({A, B, C});
+  auto func   = cinn::lang::LowerVec("test_tensorize", stages, {A, B, C}, {}, {}, nullptr, target, true);
+  CHECK(!func.empty());
+  auto ast_expr = func[0]->body;
+  std::vector<Expr> vec_ast{ast_expr};
+  ir::ModuleExpr mod_expr(vec_ast);
+  ir::IRSchedule ir_sch(mod_expr);
+
+  ir_sch.Split("C", 0, {-1, 6});
+  ir_sch.Split("C", 2, {-1, 16});
+  auto loops = ir_sch.GetLoops("C");
+  ir_sch.Reorder({loops[2], loops[1]});
+  loops = ir_sch.GetLoops("C");
+  CHECK_EQ(loops.size(), 5U);
+
+  // the init of C is in the loop nest, so it doesn't match the intrinsic accumulating to C, and the tile of i must
+  // be 6 rows and its inner loops must be kept
+  auto* registry = ir::TensorIntrinsicRegistry::Global();
+  ASSERT_FALSE(registry->Get("gemm_6x16_fp32_update")->Match(loops[2]).defined());
+  ASSERT_FALSE(registry->Get("gemm_6x16_fp32")->Match(loops[1]).defined());
+  ASSERT_FALSE(registry->Get("gemm_6x16_fp32")->Match(loops[3]).defined());
+  ASSERT_FALSE(registry->Get("dot_4x16_int8")->Match(loops[2]).defined());
+
+  ir_sch.Tensorize(loops[2], "gemm_6x16_fp32");
+  ASSERT_FALSE(ir_sch.HasBlock("C"));
+  ASSERT_FALSE(ir_sch.HasBlock("C__reduce_init"));
+
+  Module::Builder builder("module1", target);
+  for (auto& i : func) {
+    builder.AddFunction(i);
+  }
+  auto module = builder.Build();
+  CodeGenC codegen(target);
+  codegen.SetInlineBuiltinCodes(false);
+  auto source_code = codegen.Compile(module, CodeGenC::OutputKind::CImpl);
+  VLOG(3) << "tensorize source code is :\n" << source_code;
+
+  // the tiles start at row 6 * i_outer of A and C, and column 16 * j_outer of B and C, whose leading dimensions
+  // are 64, and the reduction extent is 64
+  ASSERT_NE(source_code.find("cinn_host_gemm_6x16_fp32(_A, "), std::string::npos);
+  ASSERT_NE(source_code.find(", 64, _B, "), std::string::npos);
+  ASSERT_NE(source_code.find(", 64, 64, 0);"), std::string::npos);
+  ASSERT_EQ(source_code.find("C__reduce_init["), std::string::npos);
+}
+
+TEST(IrSchedule, transform_layout) {
+  Context::Global().ResetNameId();
+  Expr N(2);
+  Expr C(32);
+  Expr H(7);
+  Expr W(7);
+
+  Target target = common::DefaultHostTarget();
+
+  Placeholder<float> A("A", {N, C, H, W});
+  auto B = Compute(
+      {N, C, H, W}, [&](Var n, Var c, Var h, Var w) { return A(n, c, h, w) + Expr(1.f); }, "B");
+  auto D = Compute(
+      {N, C, H, W}, [&](Var n, Var c, Var h, Var w) { return B(n, c, h, w) * Expr(2.f); }, "D");
+
+  auto stages = CreateStages({A, B, D});
+  auto func   = cinn::lang::LowerVec("test_transform_layout", stages, {A, D}, {}, {}, nullptr, target, true);
+  CHECK(!func.empty());
+  auto ast_expr = func[0]->body;
+  std::vector<Expr> vec_ast{ast_expr};
+  ir::ModuleExpr mod_expr(vec_ast);
+  ir::IRSchedule ir_sch(mod_expr);
+
+  // transform B from NCHW to NCHW16c
+  ir_sch.TransformLayout(ir_sch.GetBlock("B"), 0, {1, 16, 1, 1}, {0, 1, 3, 4, 2}, {"D"});
+  ASSERT_TRUE(ir_sch.HasBlock("B"));
+
+  // both the producer and the consumer access B in the new layout
+  std::vector<Expr> accesses;
+  ir::CollectIRNodesWithoutTensor(ir_sch.GetModule().GetExprs()[0], [&](const Expr* x) {
+    if (x->As<ir::Load>() && x->As<ir::Load>()->tensor.as_tensor()->name != "A") accesses.push_back(*x);
+    if (x->As<ir::Store>() && x->As<ir::Store>()->tensor.as_tensor()->name != "D") accesses.push_back(*x);
+    return false;
+  });
+  ASSERT_EQ(accesses.size(), 2U);
+  for (auto& access : accesses) {
+    auto* load   = access.As<ir::Load>();
+    auto tensor  = (load ? load->tensor : access.As<ir::Store>()->tensor).as_tensor_ref();
+    auto indices = load ? load->indices : access.As<ir::Store>()->indices;
+    ASSERT_EQ(tensor->name, "B_layout");
+    ASSERT_EQ(utils::Join(tensor->shape, ", "), "2, 2, 7, 7, 16");
+    ASSERT_EQ(tensor->buffer->shape.size(), 5U);
+    ASSERT_EQ(indices.size(), 5U);
+    ASSERT_TRUE(indices[1].As<ir::Div>());
+    ASSERT_TRUE(indices[4].As<ir::Mod>());
+  }
+
+  // the axes can't be split unevenly
+  ASSERT_DEATH(ir_sch.TransformLayout(ir_sch.GetBlock("B"), 0, {1, 1, 1, 2}, {}, {"D"}), "");
+  // the layout of the output is decided by the caller
+  ASSERT_DEATH(ir_sch.TransformLayout(ir_sch.GetBlock("D"), 0, {1, 16, 1, 1}, {}, {"D"}), "");
+}
+
+// Make the function of the scheduled body, the temp buffers are collected again since the schedule may add new ones.
+static ir::LoweredFunc MakeScheduledFunc(const ir::LoweredFunc& func,
+                                         const std::string& name,
+                                         const Expr& body,
+                                         const Target& target) {
+  auto new_func = ir::_LoweredFunc_::Make(name, func->args, body, lang::GetTempBuffers(func->args, body));
+  new_func      = optim::Optimize(Expr(new_func), target, false).as_lowered_func_ref();
+  new_func->PrepareBufferCastExprs(/*with_expr_gen_tensor = */ false);
+  return new_func;
+}
+
+// Run the unscheduled function `ref_name` and the scheduled function `name` of the module on the same random input,
+// and check they write the same output. Both functions take the input and the output as arguments.
+static void CheckScheduledResult(const ir::Module& module,
+                                 const std::string& ref_name,
+                                 const std::string& name,
+                                 const std::vector<int>& in_shape,
+                                 const std::vector<int>& out_shape) {
+  auto jit = SimpleJIT::Create();
+  jit->Link(module);
+  auto ref_fn = reinterpret_cast<lower_func_ptr_t>(jit->Lookup(ref_name));
+  auto fn     = reinterpret_cast<lower_func_ptr_t>(jit->Lookup(name));
+  ASSERT_TRUE(ref_fn);
+  ASSERT_TRUE(fn);
+
+  auto* in_buf      = common::BufferBuilder(Float(32), in_shape).set_random().Build();
+  auto* ref_out_buf = common::BufferBuilder(Float(32), out_shape).set_zero().Build();
+  auto* out_buf     = common::BufferBuilder(Float(32), out_shape).set_zero().Build();
+  auto ref_args     = common::ArgsBuilder().Add(in_buf).Add(ref_out_buf).Build();
+  auto args         = common::ArgsBuilder().Add(in_buf).Add(out_buf).Build();
+  ref_fn(ref_args.data(), ref_args.size());
+  fn(args.data(), args.size());
+
+  auto* ref_out = reinterpret_cast<float*>(ref_out_buf->memory);
+  auto* out     = reinterpret_cast<float*>(out_buf->memory);
+  for (uint64_t i = 0; i < ref_out_buf->num_elements(); ++i) {
+    ASSERT_FLOAT_EQ(out[i], ref_out[i]) << " idx is " << i;
+  }
+  cinn_buffer_free(nullptr, in_buf);
+  cinn_buffer_free(nullptr, ref_out_buf);
+  cinn_buffer_free(nullptr, out_buf);
+}
+
+TEST(IrSchedule, transform_layout_run) {
+  Context::Global().ResetNameId();
+  Expr N(2);
+  Expr C(32);
+  Expr H(7);
+  Expr W(7);
+
+  Target target = common::DefaultHostTarget();
+
+  Placeholder<float> A("A", {N, C, H, W});
+  auto B = Compute(
+      {N, C, H, W}, [&](Var n, Var c, Var h, Var w) { return A(n, c, h, w) + Expr(1.f); }, "B");
+  auto D = Compute(
+      {N, C, H, W}, [&](Var n, Var c, Var h, Var w) { return B(n, c, h, w) * Expr(2.f) + B(n, c, h, w); }, "D");
+
+  auto stages = CreateStages({A, B, D});
+  auto func   = cinn::lang::LowerVec("test_transform_layout_run", stages, {A, D}, {}, {}, nullptr, target, true);
+  CHECK(!func.empty());
+  Expr ref_body = optim::IRCopy(func[0]->body);
+  ir::IRSchedule ir_sch(ir::ModuleExpr({func[0]->body}));
+  ir_sch.TransformLayout(ir_sch.GetBlock("B"), 0, {1, 16, 1, 1}, {0, 1, 3, 4, 2}, {"D"});
+
+  Module::Builder builder("module1", target);
+  builder.AddFunction(MakeScheduledFunc(func[0], "test_transform_layout_ref", ref_body, target));
+  builder.AddFunction(
+      MakeScheduledFunc(func[0], "test_transform_layout_run", ir_sch.GetModule().GetExprs()[0], target));
+  CheckScheduledResult(
+      builder.Build(), "test_transform_layout_ref", "test_transform_layout_run", {2, 32, 7, 7}, {2, 32, 7, 7});
+}
+
+TEST(IrSchedule, pad_axis) {
+  Context::Global().ResetNameId();
+  Expr M(32);
+  Expr N(30);
+
+  Target target = common::DefaultHostTarget();
+
+  Placeholder<float> A("A", {M, N});
+  auto B = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) * Expr(2.f); }, "B");
+
+  auto stages = CreateStages({A, B});
+  auto func   = cinn::lang::LowerVec("test_pad_axis", stages, {A, B}, {}, {}, nullptr, target, true);
+  CHECK(!func.empty());
+  auto ast_expr = func[0]->body;
+  std::vector<Expr> vec_ast{ast_expr};
+  ir::ModuleExpr mod_expr(vec_ast);
+  ir::IRSchedule ir_sch(mod_expr);
+
+  auto padded_block = ir_sch.PadAxis(ir_sch.GetBlock("B"), 1, 8);
+  ASSERT_EQ(padded_block.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->name, "B_pad");
+
+  // the padded block computes 32 columns, while the input is copied in and the output is written back by 30 columns
+  ASSERT_EQ(ir_sch.GetLoops(padded_block).back().As<ir::For>()->extent.as_int32(), 32);
+  ASSERT_EQ(ir_sch.GetLoops("A_pad").back().As<ir::For>()->extent.as_int32(), 30);
+  ASSERT_EQ(ir_sch.GetLoops("B").back().As<ir::For>()->extent.as_int32(), 30);
+  // the padded tail of the input is filled by zero
+  ASSERT_EQ(ir_sch.GetLoops("A_pad__pad_init").back().As<ir::For>()->extent.as_int32(), 2);
+  Expr root_block    = ir_sch.GetRootBlock(padded_block);
+  Expr root_body     = root_block.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->body;
+  const auto& stmts = root_body.As<ir::Block>()->stmts;
+  ASSERT_EQ(stmts.size(), 4U);
+  ASSERT_TRUE(ir::Contains(stmts[0], ir_sch.GetBlock("A_pad")));
+  ASSERT_TRUE(ir::Contains(stmts[1], ir_sch.GetBlock("A_pad__pad_init")));
+  ASSERT_TRUE(ir::Contains(stmts[2], padded_block));
+  ASSERT_TRUE(ir::Contains(stmts[3], ir_sch.GetBlock("B")));
+
+  Module::Builder builder("module1", target);
+  for (auto& i : func) {
+    builder.AddFunction(i);
+  }
+  auto module = builder.Build();
+  CodeGenC codegen(target);
+  codegen.SetInlineBuiltinCodes(false);
+  auto source_code = codegen.Compile(module, CodeGenC::OutputKind::CImpl);
+  VLOG(3) << "pad_axis source code is :\n" << source_code;
+  ASSERT_NE(source_code.find("B_pad[((32 * i) + j)] = "), std::string::npos);
+  ASSERT_NE(source_code.find("A_pad[((32 * i) + j)]"), std::string::npos);
+}
+
+TEST(IrSchedule, pad_axis_run) {
+  Context::Global().ResetNameId();
+  Expr M(32);
+  Expr N(30);
+
+  Target target = common::DefaultHostTarget();
+
+  Placeholder<float> A("A", {M, N});
+  auto B = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) * Expr(2.f) + Expr(1.f); }, "B");
+
+  auto stages = CreateStages({A, B});
+  auto func   = cinn::lang::LowerVec("test_pad_axis_run", stages, {A, B}, {}, {}, nullptr, target, true);
+  CHECK(!func.empty());
+  Expr ref_body = optim::IRCopy(func[0]->body);
+  ir::IRSchedule ir_sch(ir::ModuleExpr({func[0]->body}));
+  // vectorize the padded loop, the lanes out of the original extent only write the padded copy
+  auto padded_block = ir_sch.PadAxis(ir_sch.GetBlock("B"), 1, 8);
+  ir_sch.Vectorize(ir_sch.GetLoops(padded_block).back(), 8);
+
+  Module::Builder builder("module1", target);
+  builder.AddFunction(MakeScheduledFunc(func[0], "test_pad_axis_ref", ref_body, target));
+  builder.AddFunction(MakeScheduledFunc(func[0], "test_pad_axis_run", ir_sch.GetModule().GetExprs()[0], target));
+  CheckScheduledResult(builder.Build(), "test_pad_axis_ref", "test_pad_axis_run", {32, 30}, {32, 30});
+}
+
+TEST(IrSchedule, prefetch) {
+  Context::Global().ResetNameId();
+  Expr M(32);
+  Expr N(64);
+
+  Target target = common::DefaultHostTarget();
+
+  Placeholder<float> A("A", {N, M});
+  auto B = Compute(
+      {M, N}, [&](Var i, Var j) { return A(j, i); }, "B");
+
+  auto stages = CreateStages({A, B});
+  auto func   = cinn::lang::LowerVec("test_prefetch", stages, {A, B}, {}, {}, nullptr, target, true);
+  CHECK(!func.empty());
+  auto ast_expr = func[0]->body;
+  std::vector<Expr> vec_ast{ast_expr};
+  ir::ModuleExpr mod_expr(vec_ast);
+  ir::IRSchedule ir_sch(mod_expr);
+
+  auto loops = ir_sch.GetLoops("B");
+  ir_sch.Prefetch(ir_sch.GetBlock("B"), 0, loops[1], 8);
+
+  // the prefetch is issued at the beginning of the loop body, before the block
+  auto& stmts = ir_sch.GetLoops("B")[1].As<ir::For>()->body.As<ir::Block>()->stmts;
+  ASSERT_EQ(stmts.size(), 2U);
+  ASSERT_TRUE(stmts[0].As<ir::Call>());
+  ASSERT_EQ(stmts[0].As<ir::Call>()->name, runtime::intrinsic::prefetch);
+
+  // the prefetched address is clamped to the last iteration of the loop
+  auto* addr = stmts[0].As<ir::Call>()->read_args[0].As<ir::intrinsics::GetAddr>();
+  ASSERT_TRUE(addr);
+  auto* load = addr->data.As<ir::Load>();
+  ASSERT_TRUE(load);
+  ASSERT_EQ(load->tensor.as_tensor()->name, "A");
+  auto mins = ir::CollectIRNodesWithoutTensor(load->indices[0], [](const Expr* x) { return x->As<ir::Min>(); });
+  ASSERT_EQ(mins.size(), 1U);
+
+  Module::Builder builder("module1", target);
+  for (auto& i : func) {
+    builder.AddFunction(i);
+  }
+  auto module = builder.Build();
+  CodeGenC codegen(target);
+  codegen.SetInlineBuiltinCodes(false);
+  auto source_code = codegen.Compile(module, CodeGenC::OutputKind::CImpl);
+  VLOG(3) << "prefetch source code is :\n" << source_code;
+  ASSERT_NE(source_code.find("__builtin_prefetch(&(A["), std::string::npos);
+  ASSERT_LT(source_code.find("__builtin_prefetch"), source_code.find("B[((64 * i) + j)] = "));
+
+  // the loop must be an outer loop of the block
+  Expr other_loop = ir::For::Make(
+      Var("k"), Expr(0), Expr(4), ir::ForType::Serial, ir::DeviceAPI::Host, ir::Block::Make({}));
+  ASSERT_DEATH(ir_sch.Prefetch(ir_sch.GetBlock("B"), 0, other_loop, 8), "");
+}
+
+TEST(IrSchedule, storage_align) {
+  Context::Global().ResetNameId();
+  Expr M(32);
+  Expr N(1024);
+
+  Target target = common::DefaultHostTarget();
+
+  Placeholder<float> A("A", {M, N});
+  auto B = Compute(
+      {M, N}, [&](Var i, Var j) { return A(i, j) + Expr(1.f); }, "B");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return B(i, j) * Expr(2.f); }, "C");
+
+  auto stages = CreateStages({A, B, C});
+  auto func   = cinn::lang::LowerVec("test_storage_align", stages, {A, C}, {}, {}, nullptr, target, true);
+  CHECK(!func.empty());
+  auto ast_expr = func[0]->body;
+  std::vector<Expr> vec_ast{ast_expr};
+  ir::ModuleExpr mod_expr(vec_ast);
+  ir::IRSchedule ir_sch(mod_expr);
+
+  // the rows of B are padded so that their strides are 16 floats more than a multiple of 1024
+  ir_sch.StorageAlign(ir_sch.GetBlock("B"), 0, 0, 1024, 16, {"C"});
+
+  // both the producer and the consumer access B with the padded strides and the same indices
+  std::vector<Expr> accesses;
+  ir::CollectIRNodesWithoutTensor(ir_sch.GetModule().GetExprs()[0], [&](const Expr* x) {
+    if (x->As<ir::Load>() && x->As<ir::Load>()->tensor.as_tensor()->name == "B") accesses.push_back(*x);
+    if (x->As<ir::Store>() && x->As<ir::Store>()->tensor.as_tensor()->name == "B") accesses.push_back(*x);
+    return false;
+  });
+  ASSERT_EQ(accesses.size(), 2U);
+  for (auto& access : accesses) {
+    auto* load  = access.As<ir::Load>();
+    auto tensor = (load ? load->tensor : access.As<ir::Store>()->tensor).as_tensor_ref();
+    ASSERT_EQ(utils::Join(tensor->shape, ", "), "32, 1040");
+    ASSERT_EQ(utils::Join(tensor->buffer->shape, ", "), "32, 1040");
+    ASSERT_EQ((load ? load->indices : access.As<ir::Store>()->indices).size(), 2U);
+  }
+
+  Module::Builder builder("module1", target);
+  for (auto& i : func) {
+    builder.AddFunction(i);
+  }
+  auto module = builder.Build();
+  CodeGenC codegen(target);
+  codegen.SetInlineBuiltinCodes(false);
+  auto source_code = codegen.Compile(module, CodeGenC::OutputKind::CImpl);
+  VLOG(3) << "storage_align source code is :\n" << source_code;
+  ASSERT_NE(source_code.find("B[((1040 * i) + j)] = "), std::string::npos);
+
+  // the offset must be less than the factor
+  ASSERT_DEATH(ir_sch.StorageAlign(ir_sch.GetBlock("B"), 0, 0, 16, 16, {"C"}), "");
+  // the strides of the outputs are decided by the callers
+  ASSERT_DEATH(ir_sch.StorageAlign(ir_sch.GetBlock("C"), 0, 0, 1024, 16, {"C"}), "");
+}
+
+TEST(IrSchedule, decompose_reduction) {
+  Context::Global().ResetNameId();
+  Expr M(32);
+  Expr N(64);
+  Expr K(16);
+
+  Target target = common::DefaultHostTarget();
+
+  Placeholder<float> A("A", {M, K});
+  Placeholder<float> B("B", {K, N});
+  Var k(16, "k0");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return lang::ReduceSum(A(i, k) * B(k, j), {k}); }, "C");
+
+  auto stages = CreateStages({A, B, C});
+  auto func   = cinn::lang::LowerVec("test_decompose_reduction", stages, {A, B, C}, {}, {}, nullptr, target, true);
+  CHECK(!func.empty());
+  auto ast_expr = func[0]->body;
+  std::vector<Expr> vec_ast{ast_expr};
+  ir::ModuleExpr mod_expr(vec_ast);
+  ir::IRSchedule ir_sch(mod_expr);
+
+  auto loops      = ir_sch.GetLoops("C");
+  auto init_block = ir_sch.DecomposeReduction(ir_sch.GetBlock("C"), loops[1]);
+  ASSERT_EQ(init_block.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>()->name, "C__reduce_init");
+
+  // the init block is computed by a copy of the loop j right before it, and the loop j contains the update only
+  auto init_loops = ir_sch.GetLoops(init_block);
+  ASSERT_EQ(init_loops.size(), 2U);
+  ASSERT_EQ(init_loops[0], loops[0]);
+  ASSERT_EQ(init_loops[1].As<ir::For>()->loop_var->name, "j_init");
+  const auto& stmts = loops[0].As<ir::For>()->body.As<ir::Block>()->stmts;
+  ASSERT_EQ(stmts.size(), 2U);
+  ASSERT_EQ(stmts[0], init_loops[1]);
+  ASSERT_EQ(stmts[1], loops[1]);
+  ASSERT_EQ(loops[1].As<ir::For>()->body.As<ir::Block>()->stmts.size(), 1U);
+
+  // the reduction loop can be moved outside the loop j now
+  ir_sch.Reorder({loops[2], loops[1]});
+  ASSERT_EQ(ir_sch.GetLoops("C")[1].As<ir::For>()->loop_var->name, "k0");
+
+  Module::Builder builder("module1", target);
+  for (auto& i : func) {
+    builder.AddFunction(i);
+  }
+  auto module = builder.Build();
+  CodeGenC codegen(target);
+  codegen.SetInlineBuiltinCodes(false);
+  auto source_code = codegen.Compile(module, CodeGenC::OutputKind::CImpl);
+  VLOG(3) << "decompose_reduction source code is :\n" << source_code;
+  auto init_pos = source_code.find("C__reduce_init[((64 * i) + j_init)] = 0.00000000f");
+  ASSERT_NE(init_pos, std::string::npos);
+  ASSERT_LT(init_pos, source_code.find("for (int32_t k0 = 0"));
+  ASSERT_LT(source_code.find("for (int32_t k0 = 0"), source_code.find("for (int32_t j = 0"));
+
+  // the init block isn't inside the loop j anymore
+  ASSERT_DEATH(ir_sch.DecomposeReduction(ir_sch.GetBlock("C"), ir_sch.GetLoops("C")[2]), "");
+}
+
 TEST(IrSchedule, compute_inline1) {
   Context::Global().ResetNameId();
   Expr M(32);
@@ -673,6 +673,8 @@ llvm::Value *CodeGenLLVM::Visit(const ir::ScheduleBlockRealize *) { CINN_NOT_IMP
 llvm::Value *CodeGenLLVM::Visit(const ir::Call *op) {
   if (op->name == runtime::intrinsic::debug_log_repr) {
     return EmitCall_debug_info(op);
+  } else if (op->name == runtime::intrinsic::prefetch) {
+    return EmitCall_prefetch(op);
   } else if (op->is_extern_call()) {
     auto emitter_id     = ExternFuncID{backend_llvm_host, op->name.c_str()};
     const auto &fn_name = ExternFunctionEmitterRegistry::Global().Lookup(emitter_id);
@@ -1110,6 +1112,27 @@ llvm::Value *CodeGenLLVM::EmitCall_debug_info(const ir::Call *op) {
   return Call(callee, args, "call debug_info");
 }
 
+llvm::Value *CodeGenLLVM::EmitCall_prefetch(const ir::Call *op) {
+  CHECK_EQ(op->read_args.size(), 1UL);
+  auto *addr = op->read_args[0].As<ir::intrinsics::GetAddr>();
+  CHECK(addr && addr->data.As<ir::Load>()) << "The argument of prefetch should be the address of an element, but got "
+                                           << op->read_args[0];
+  auto *load      = addr->data.As<ir::Load>();
+  auto *tensor_op = load->tensor.As<ir::_Tensor_>();
+  CHECK(tensor_op) << "The element to prefetch should be in a tensor: " << addr->data;
+  ir::Expr index = load->index();
+  CHECK_EQ(index.type().lanes(), 1) << "Only the address of a scalar element can be prefetched: " << addr->data;
+
+  // get the address of the element without loading it
+  std::vector<llvm::Value *> indices{Visit(&index)};
+  llvm::Value *ptr = BitCast(InBoundsGEP(GetVar(tensor_op->name), std::move(indices)), ll_void_p_ty(), "prefetch_addr");
+  std::vector<llvm::Type *> arg_types{ptr->getType(), ll_int32_ty(), ll_int32_ty(), ll_int32_ty()};
+  llvm::Function *fn = GetIntrinsicDecl(llvm::Intrinsic::prefetch, b_->getVoidTy(), arg_types);
+  CHECK(fn) << "Cannot find the declaration of llvm.prefetch";
+  // read, high temporal locality, data cache
+  return b_->CreateCall(fn, {ptr, ll_const_int32(0), ll_const_int32(3), ll_const_int32(1)});
+}
+
 llvm::Value *CodeGenLLVM::GetVar(const std::string &name, bool lazy) {
   auto symbol = symbol_table_->Lookup(name);
   if (!lazy) {
@@ -200,6 +200,7 @@ class CodeGenLLVM : public LLVMIRVisitor, public IrBuilderMixin<CodeGenLLVM> {
   llvm::Value *EmitCall_buffer_malloc(const ir::Call *op);
   llvm::Value *EmitCall_get_address(const ir::Call *op);
   llvm::Value *EmitCall_debug_info(const ir::Call *op);
+  llvm::Value *EmitCall_prefetch(const ir::Call *op);
   // @}
 
   llvm::Value *EmitBinaryOp(llvm::Value *lhs, llvm::Value *rhs, char opcode, bool is_integral, bool is_signed = true);
@@ -16,9 +16,19 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "cinn/backends/llvm/simple_jit.h"
 #include "cinn/cinn.h"
 #include "cinn/common/test_helper.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/lang/lower.h"
+#include "cinn/optim/optimize.h"
 #include "cinn/runtime/cinn_runtime.h"
 
 namespace cinn {
@@ -69,5 +79,199 @@ TEST(Vectorize, basic) {
   }
 }
 
+using ScheduleFunc = std::function<void(ir::IRSchedule*, const std::string&)>;
+
+// Lower the computation of the last tensor returned by `compute`, its block is scheduled by `schedule` if defined.
+ir::LoweredFunc LowerWithSchedule(const std::string& name,
+                                  const std::function<std::vector<ir::Tensor>()>& compute,
+                                  const ScheduleFunc& schedule = nullptr) {
+  Context::Global().ResetNameId();
+  Target target = common::DefaultHostTarget();
+  auto args     = compute();
+  auto funcs    = lang::LowerVec(name, CreateStages({args.back()}), args, {}, {}, nullptr, target, true);
+  CHECK_EQ(funcs.size(), 1U);
+
+  ir::IRSchedule ir_sch(ir::ModuleExpr({funcs[0]->body}));
+  if (schedule) {
+    schedule(&ir_sch, args.back()->name);
+  }
+
+  auto func = ir::_LoweredFunc_::Make(name, funcs[0]->args, ir_sch.GetModule().GetExprs()[0], {});
+  func      = optim::Optimize(Expr(func), target, false).as_lowered_func_ref();
+  func->PrepareBufferCastExprs(/*with_expr_gen_tensor = */ false);
+  return func;
+}
+
+// Prefetch the first read of a block `distance` iterations ahead in its innermost loop
+ScheduleFunc PrefetchFirstRead(int distance) {
+  return [distance](ir::IRSchedule* ir_sch, const std::string& block_name) {
+    ir_sch->Prefetch(ir_sch->GetBlock(block_name), 0, ir_sch->GetLoops(block_name).back(), distance);
+  };
+}
+
+// Return the average cost in milliseconds of calling a lowered function, the first call is a warm-up
+double TimeFunction(lower_func_ptr_t fn, std::vector<cinn_pod_value_t>* args) {
+  int repeat = 10;
+  fn(args->data(), args->size());
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; ++i) {
+    fn(args->data(), args->size());
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeat;
+}
+
+TEST(Prefetch, transpose_benchmark) {
+  int m = 2048, n = 2048;
+  auto transpose = [&]() {
+    Placeholder<float> A("A", {Expr(n), Expr(m)});
+    auto B = Compute(
+        {Expr(m), Expr(n)}, [&](Var i, Var j) { return A(j, i); }, "B");
+    return std::vector<ir::Tensor>({A, B});
+  };
+
+  Module::Builder builder("module", common::DefaultHostTarget());
+  builder.AddFunction(LowerWithSchedule("transpose", transpose));
+  builder.AddFunction(LowerWithSchedule("prefetched_transpose", transpose, PrefetchFirstRead(8)));
+  auto jit = SimpleJIT::Create();
+  jit->Link(builder.Build());
+  auto naive_fn      = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("transpose"));
+  auto prefetched_fn = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("prefetched_transpose"));
+  ASSERT_TRUE(naive_fn);
+  ASSERT_TRUE(prefetched_fn);
+
+  auto* a_buf          = common::BufferBuilder(Float(32), {n, m}).set_random().Build();
+  auto* expect_buf     = common::BufferBuilder(Float(32), {m, n}).set_zero().Build();
+  auto* out_buf        = common::BufferBuilder(Float(32), {m, n}).set_zero().Build();
+  auto naive_args      = common::ArgsBuilder().Add(a_buf).Add(expect_buf).Build();
+  auto prefetched_args = common::ArgsBuilder().Add(a_buf).Add(out_buf).Build();
+  LOG(INFO) << "transpose costs " << TimeFunction(naive_fn, &naive_args) << " ms, and "
+            << TimeFunction(prefetched_fn, &prefetched_args) << " ms with prefetching";
+
+  auto* expect = reinterpret_cast<float*>(expect_buf->memory);
+  auto* out    = reinterpret_cast<float*>(out_buf->memory);
+  for (int i = 0; i < m * n; ++i) {
+    ASSERT_EQ(out[i], expect[i]) << "B at " << i;
+  }
+}
+
+TEST(Prefetch, gather_benchmark) {
+  int num_rows = 1 << 22, num_indices = 1 << 20;
+  auto gather = [&]() {
+    Placeholder<float> A("A", {Expr(num_rows)});
+    Placeholder<int> index("index", {Expr(num_indices)});
+    auto B = Compute(
+        {Expr(num_indices)}, [&](Var i) { return A(index(i)); }, "B");
+    return std::vector<ir::Tensor>({A, index, B});
+  };
+
+  Module::Builder builder("module", common::DefaultHostTarget());
+  builder.AddFunction(LowerWithSchedule("gather", gather));
+  builder.AddFunction(LowerWithSchedule("prefetched_gather", gather, PrefetchFirstRead(16)));
+  auto jit = SimpleJIT::Create();
+  jit->Link(builder.Build());
+  auto naive_fn      = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("gather"));
+  auto prefetched_fn = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("prefetched_gather"));
+  ASSERT_TRUE(naive_fn);
+  ASSERT_TRUE(prefetched_fn);
+
+  auto* a_buf     = common::BufferBuilder(Float(32), {num_rows}).set_random().Build();
+  auto* index_buf = common::BufferBuilder(Int(32), {num_indices}).set_zero().Build();
+  auto* index     = reinterpret_cast<int32_t*>(index_buf->memory);
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int32_t> dist(0, num_rows - 1);
+  for (int i = 0; i < num_indices; ++i) {
+    index[i] = dist(rng);
+  }
+
+  auto* expect_buf     = common::BufferBuilder(Float(32), {num_indices}).set_zero().Build();
+  auto* out_buf        = common::BufferBuilder(Float(32), {num_indices}).set_zero().Build();
+  auto naive_args      = common::ArgsBuilder().Add(a_buf).Add(index_buf).Add(expect_buf).Build();
+  auto prefetched_args = common::ArgsBuilder().Add(a_buf).Add(index_buf).Add(out_buf).Build();
+  LOG(INFO) << "gather costs " << TimeFunction(naive_fn, &naive_args) << " ms, and "
+            << TimeFunction(prefetched_fn, &prefetched_args) << " ms with prefetching";
+
+  auto* a      = reinterpret_cast<float*>(a_buf->memory);
+  auto* expect = reinterpret_cast<float*>(expect_buf->memory);
+  auto* out    = reinterpret_cast<float*>(out_buf->memory);
+  for (int i = 0; i < num_indices; ++i) {
+    ASSERT_EQ(expect[i], a[index[i]]) << "B at " << i;
+    ASSERT_EQ(out[i], expect[i]) << "B at " << i;
+  }
+}
+
+// Decompose the init of a reduction block out of the spatial loop right above the reduction loop, move the
+// reduction loop outside and vectorize the spatial loop
+void DecomposeAndVectorize(ir::IRSchedule* ir_sch, const std::string& block_name) {
+  auto loops = ir_sch->GetLoops(block_name);
+  ir_sch->DecomposeReduction(ir_sch->GetBlock(block_name), loops[loops.size() - 2]);
+  loops = ir_sch->GetLoops(block_name);
+  ir_sch->Reorder({loops.back(), loops[loops.size() - 2]});
+  ir_sch->Vectorize(ir_sch->GetLoops(block_name).back(), 8);
+}
+
+// Run the naive and the decomposed lowerings of a reduction on the same random inputs, log their costs and check
+// their outputs are equal
+void BenchmarkDecomposeReduction(const std::string& name,
+                                 const std::function<std::vector<ir::Tensor>()>& compute,
+                                 const std::vector<std::vector<int>>& shapes) {
+  Module::Builder builder("module", common::DefaultHostTarget());
+  builder.AddFunction(LowerWithSchedule(name, compute));
+  builder.AddFunction(LowerWithSchedule("decomposed_" + name, compute, DecomposeAndVectorize));
+  auto jit = SimpleJIT::Create();
+  jit->Link(builder.Build());
+  auto naive_fn      = reinterpret_cast<lower_func_ptr_t>(jit->Lookup(name));
+  auto decomposed_fn = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("decomposed_" + name));
+  ASSERT_TRUE(naive_fn);
+  ASSERT_TRUE(decomposed_fn);
+
+  // the last shape is the one of the output
+  common::ArgsBuilder naive_args_builder;
+  common::ArgsBuilder decomposed_args_builder;
+  for (int i = 0; i < static_cast<int>(shapes.size()) - 1; ++i) {
+    auto* buf = common::BufferBuilder(Float(32), shapes[i]).set_random().Build();
+    naive_args_builder.Add(buf);
+    decomposed_args_builder.Add(buf);
+  }
+  auto* expect_buf     = common::BufferBuilder(Float(32), shapes.back()).set_zero().Build();
+  auto* out_buf        = common::BufferBuilder(Float(32), shapes.back()).set_zero().Build();
+  auto naive_args      = naive_args_builder.Add(expect_buf).Build();
+  auto decomposed_args = decomposed_args_builder.Add(out_buf).Build();
+  LOG(INFO) << name << " costs " << TimeFunction(naive_fn, &naive_args) << " ms, and "
+            << TimeFunction(decomposed_fn, &decomposed_args) << " ms decomposed and vectorized";
+
+  auto* expect = reinterpret_cast<float*>(expect_buf->memory);
+  auto* out    = reinterpret_cast<float*>(out_buf->memory);
+  for (int i = 0; i < expect_buf->num_elements(); ++i) {
+    ASSERT_NEAR(out[i], expect[i], std::abs(expect[i]) * 1e-4 + 1e-4) << name << " at " << i;
+  }
+}
+
+TEST(DecomposeReduction, reduce_sum_benchmark) {
+  int m = 4096, n = 1024;
+  auto reduce_sum = [&]() {
+    Placeholder<float> A("A", {Expr(m), Expr(n)});
+    Var k(m, "k0");
+    auto B = Compute(
+        {Expr(n)}, [&](Var j) { return lang::ReduceSum(A(k, j), {k}); }, "B");
+    return std::vector<ir::Tensor>({A, B});
+  };
+  BenchmarkDecomposeReduction("reduce_sum", reduce_sum, {{m, n}, {n}});
+}
+
+TEST(DecomposeReduction, matmul_benchmark) {
+  int m = 256, n = 256, k = 256;
+  auto matmul = [&]() {
+    Placeholder<float> A("A", {Expr(m), Expr(k)});
+    Placeholder<float> B("B", {Expr(k), Expr(n)});
+    Var reduce_k(k, "reduce_k");
+    auto C = Compute(
+        {Expr(m), Expr(n)},
+        [&](Var i, Var j) { return lang::ReduceSum(A(i, reduce_k) * B(reduce_k, j), {reduce_k}); },
+        "C");
+    return std::vector<ir::Tensor>({A, B, C});
+  };
+  BenchmarkDecomposeReduction("matmul", matmul, {{m, k}, {k, n}, {m, n}});
+}
+
 }  // namespace backends
 }  // namespace cinn
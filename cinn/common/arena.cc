@@ -0,0 +1,99 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/common/arena.h"
+
+#include <new>
+
+namespace cinn {
+namespace common {
+
+namespace {
+
+thread_local NodeArena* current_node_arena = nullptr;
+
+// The size class of the blocks holding `size` bytes, the blocks of class `c` hold (c + 1) * kAlignment bytes.
+inline size_t SizeClass(size_t size) { return (size + NodeArena::kAlignment - 1) / NodeArena::kAlignment - 1; }
+
+}  // namespace
+
+NodeArena::NodeArena(size_t max_cached_bytes) : max_cached_bytes_(max_cached_bytes) {}
+
+NodeArena::~NodeArena() {
+  for (auto*& head : free_lists_) {
+    while (head) {
+      FreeBlock* next = head->next;
+      ::operator delete(head);
+      head = next;
+    }
+  }
+}
+
+NodeArena* NodeArena::Current() { return current_node_arena; }
+
+void* NodeArena::Allocate(size_t size) {
+  if (size == 0 || size > kMaxPooledSize) {
+    return ::operator new(size);
+  }
+  size_t size_class = SizeClass(size);
+  NodeArena* arena  = current_node_arena;
+  if (arena) {
+    ++arena->alloc_count_;
+    FreeBlock* block = arena->free_lists_[size_class];
+    if (block) {
+      arena->free_lists_[size_class] = block->next;
+      arena->cached_bytes_ -= (size_class + 1) * kAlignment;
+      ++arena->reuse_count_;
+      return block;
+    }
+  }
+  // the block is always rounded up to its size class, so that it can be reused by any arena once freed
+  return ::operator new((size_class + 1) * kAlignment);
+}
+
+void NodeArena::Deallocate(void* p, size_t size) {
+  if (!p) return;
+  NodeArena* arena = current_node_arena;
+  if (size == 0 || size > kMaxPooledSize || !arena) {
+    ::operator delete(p);
+    return;
+  }
+  size_t size_class  = SizeClass(size);
+  size_t block_bytes = (size_class + 1) * kAlignment;
+  if (arena->cached_bytes_ + block_bytes > arena->max_cached_bytes_) {
+    ::operator delete(p);
+    return;
+  }
+  auto* block                    = static_cast<FreeBlock*>(p);
+  block->next                    = arena->free_lists_[size_class];
+  arena->free_lists_[size_class] = block;
+  arena->cached_bytes_ += block_bytes;
+}
+
+NodeArenaScope::NodeArenaScope(bool enable) : prev_(current_node_arena) {
+  if (enable) {
+    arena_             = new NodeArena;
+    current_node_arena = arena_;
+  }
+}
+
+NodeArenaScope::~NodeArenaScope() {
+  if (arena_) {
+    current_node_arena = prev_;
+    delete arena_;
+  }
+}
+
+}  // namespace common
+}  // namespace cinn
@@ -0,0 +1,87 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace cinn {
+namespace common {
+
+/**
+ * The thread local allocator of the IR nodes in a lowering session.
+ *
+ * The small nodes are allocated in blocks rounded up to a size class, the freed blocks are kept in the free list of
+ * their size class and handed out again to the later nodes of the same class, so the short-lived nodes created by the
+ * passes (e.g. the copies made by `optim::IRCopy`) stop going to the system allocator. Every block is an independent
+ * heap block, a node can escape the session or be released by another thread safely, the free lists are returned to
+ * the system when the arena is destroyed.
+ */
+class NodeArena {
+ public:
+  static constexpr size_t kAlignment      = 16;
+  static constexpr size_t kMaxPooledSize  = 512;
+  static constexpr size_t kNumSizeClasses = kMaxPooledSize / kAlignment;
+
+  //! @param max_cached_bytes The capacity of the free lists, the blocks freed beyond it go back to the system.
+  explicit NodeArena(size_t max_cached_bytes = 64UL << 20);
+  ~NodeArena();
+
+  //! Get the arena installed on the current thread by `NodeArenaScope`, nullptr if there is none.
+  static NodeArena* Current();
+
+  //! Allocate a block of `size` bytes from the arena of the current thread, or from the system if there is none.
+  static void* Allocate(size_t size);
+  //! Release a block returned by `Allocate`, `size` must be the requested size.
+  static void Deallocate(void* p, size_t size);
+
+  //! The number of the blocks allocated in the arena, and the number of them reused from the free lists.
+  int64_t alloc_count() const { return alloc_count_; }
+  int64_t reuse_count() const { return reuse_count_; }
+  size_t cached_bytes() const { return cached_bytes_; }
+
+ private:
+  NodeArena(const NodeArena&) = delete;
+  NodeArena& operator=(const NodeArena&) = delete;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  FreeBlock* free_lists_[kNumSizeClasses]{};
+  size_t max_cached_bytes_;
+  size_t cached_bytes_{0};
+  int64_t alloc_count_{0};
+  int64_t reuse_count_{0};
+};
+
+/**
+ * Install a `NodeArena` on the current thread during the life time of the scope, the previous one is restored when the
+ * scope exits. Nothing is installed if `enable` is false.
+ */
+class NodeArenaScope {
+ public:
+  explicit NodeArenaScope(bool enable = true);
+  ~NodeArenaScope();
+
+  //! The arena of the scope, nullptr if it is disabled.
+  NodeArena* arena() { return arena_; }
+
+ private:
+  NodeArena* arena_{nullptr};
+  NodeArena* prev_{nullptr};
+};
+
+}  // namespace common
+}  // namespace cinn
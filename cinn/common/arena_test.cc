@@ -0,0 +1,95 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/common/arena.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_operators.h"
+#include "cinn/ir/ir_printer.h"
+#include "cinn/optim/ir_copy.h"
+#include "cinn/utils/string.h"
+
+namespace cinn {
+namespace common {
+
+namespace {
+
+Expr MakeIndex(int depth) {
+  Expr index(0);
+  for (int i = 0; i < depth; ++i) {
+    index = index * 32 + ir::_Var_::Make("i" + std::to_string(i), Int(32));
+  }
+  return index;
+}
+
+}  // namespace
+
+TEST(NodeArena, reuse) {
+  NodeArenaScope scope;
+  ASSERT_TRUE(scope.arena());
+  ASSERT_EQ(NodeArena::Current(), scope.arena());
+  { Expr e = MakeIndex(8); }
+  EXPECT_GT(scope.arena()->cached_bytes(), 0);
+  int64_t reuse_count = scope.arena()->reuse_count();
+  { Expr e = MakeIndex(8); }
+  EXPECT_GT(scope.arena()->reuse_count(), reuse_count);
+}
+
+TEST(NodeArena, escape) {
+  Expr escaped;
+  std::string expect;
+  {
+    NodeArenaScope scope;
+    escaped = MakeIndex(4);
+    expect  = utils::GetStreamCnt(escaped);
+    { NodeArenaScope nested(false); }
+    EXPECT_EQ(NodeArena::Current(), scope.arena());
+  }
+  EXPECT_EQ(NodeArena::Current(), nullptr);
+  EXPECT_EQ(utils::GetStreamCnt(escaped), expect);
+
+  // the nodes allocated in an arena can be released by another thread
+  std::thread worker([&]() {
+    NodeArenaScope scope;
+    escaped = Expr();
+  });
+  worker.join();
+}
+
+TEST(NodeArena, benchmark) {
+  Expr index            = MakeIndex(16);
+  constexpr int kRepeat = 2000;
+  auto run              = [&]() {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRepeat; ++i) {
+      Expr copied = optim::IRCopy(index);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+  double system_time = run();
+  NodeArenaScope scope;
+  double arena_time = run();
+  LOG(INFO) << "Copy the expression " << kRepeat << " times costs " << system_time << " ms without arena and "
+            << arena_time << " ms with arena, " << scope.arena()->reuse_count() << " of "
+            << scope.arena()->alloc_count() << " allocations reused.";
+}
+
+}  // namespace common
+}  // namespace cinn
@@ -21,6 +21,7 @@
 
 #include "cinn/common/arithmatic.h"
 #include "cinn/common/ir_util.h"
+#include "cinn/common/simplify_cache.h"
 #include "cinn/ir/collect_ir_nodes.h"
 #include "cinn/ir/ir_mutator.h"
 #include "cinn/ir/ir_operators.h"
@@ -34,8 +35,9 @@ namespace cinn {
 namespace common {
 using namespace ir;  // NOLINT
 
-Expr AutoSimplify(Expr u, const absl::flat_hash_map<std::string, CasInterval>& var_intervals) {
-  VLOG(7) << "Begin AutoSimplify: " << u;
+namespace {
+
+Expr AutoSimplifyImpl(Expr u, const absl::flat_hash_map<std::string, CasInterval>& var_intervals) {
   u = detail::ConvertCinnToCAS(u);
   absl::flat_hash_map<std::string, CasInterval> s_var_intervals;
   for (auto& item : var_intervals) {
@@ -49,6 +51,19 @@ Expr AutoSimplify(Expr u, const absl::flat_hash_map<std::string, CasInterval>& v
   }
   u = CasSimplify(u, s_var_intervals);
   u = detail::ConvertCasToCinn(u);
+  return u;
+}
+
+}  // namespace
+
+Expr AutoSimplify(Expr u, const absl::flat_hash_map<std::string, CasInterval>& var_intervals) {
+  VLOG(7) << "Begin AutoSimplify: " << u;
+  auto* cache = SimplifyCache::Current();
+  if (cache) {
+    u = cache->Simplify(u, var_intervals, [&] { return AutoSimplifyImpl(u, var_intervals); });
+  } else {
+    u = AutoSimplifyImpl(u, var_intervals);
+  }
   VLOG(7) << "End AutoSimplify " << u;
   return u;
 }
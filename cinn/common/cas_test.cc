@@ -16,9 +16,13 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 #include "cinn/cinn.h"
 #include "cinn/common/common.h"
 #include "cinn/common/ir_util.h"
+#include "cinn/common/simplify_cache.h"
+#include "cinn/ir/collect_ir_nodes.h"
 #include "cinn/ir/ir_operators.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/utils/string.h"
@@ -428,5 +432,79 @@ TEST(CAS, SimplifyFracOp) {
   EXPECT_EQ(GetStreamCnt(AutoSimplify(frac_f)), "2.00000000f");
 }
 
+TEST(CAS, SimplifyCache) {
+  Var x = ir::_Var_::Make("x", Int(32));
+  Var y = ir::_Var_::Make("y", Int(32));
+  std::vector<Expr> exprs({(x * 4 + y) / 4, (x * 32 + y) % 32, x * 2 + x * 3 - y + 0, Max::Make(x + 1, x + 2)});
+  absl::flat_hash_map<std::string, CasInterval> var_intervals;
+  var_intervals.emplace("y", CasInterval{0, 3});
+  absl::flat_hash_map<std::string, CasInterval> other_intervals;
+  other_intervals.emplace("y", CasInterval{0, 7});
+
+  std::vector<std::string> expects;
+  for (auto& e : exprs) {
+    expects.push_back(GetStreamCnt(AutoSimplify(e, var_intervals)));
+  }
+  std::string other_expect = GetStreamCnt(AutoSimplify(exprs[0], other_intervals));
+
+  SimplifyCache cache;
+  SimplifyCacheScope scope(&cache);
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < exprs.size(); ++i) {
+      auto res = AutoSimplify(exprs[i], var_intervals);
+      EXPECT_EQ(GetStreamCnt(res), expects[i]);
+      // the result is rebuilt on each hit, mutating it does not pollute the cache
+      for (auto& var : ir::CollectIRNodes(res, [](const Expr* e) { return e->as_var(); })) {
+        Expr(var).as_var()->name = "mutated";
+      }
+    }
+  }
+  EXPECT_EQ(cache.miss_count(), exprs.size());
+  EXPECT_EQ(cache.hit_count(), 2 * exprs.size());
+  EXPECT_EQ(cache.size(), exprs.size());
+
+  // the intervals are a part of the key
+  EXPECT_EQ(GetStreamCnt(AutoSimplify(exprs[0], other_intervals)), other_expect);
+  EXPECT_EQ(cache.miss_count(), exprs.size() + 1);
+
+  // the expressions with other nodes are not memoized
+  Placeholder<float> A("A", {Expr(10)});
+  AutoSimplify(A(x) + 1.f);
+  EXPECT_EQ(cache.bypass_count(), 1);
+}
+
+TEST(CAS, SimplifyCacheBenchmark) {
+  std::vector<Var> vars;
+  for (int i = 0; i < 8; ++i) {
+    vars.push_back(ir::_Var_::Make("i" + std::to_string(i), Int(32)));
+  }
+  absl::flat_hash_map<std::string, CasInterval> var_intervals;
+  for (auto& var : vars) {
+    var_intervals.emplace(var->name, CasInterval{0, 31});
+  }
+  // the flattened indices of a rank-8 tensor, simplified repeatedly as in the lowering of a large fused group
+  Expr index(0);
+  for (auto& var : vars) {
+    index = index * 32 + var;
+  }
+  Expr expr = (index / 32) * 32 + index % 32;
+
+  constexpr int kRepeat = 200;
+  auto run              = [&]() {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRepeat; ++i) {
+      AutoSimplify(expr, var_intervals);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+  double uncached = run();
+  SimplifyCache cache;
+  SimplifyCacheScope scope(&cache);
+  double cached = run();
+  EXPECT_EQ(cache.hit_count(), kRepeat - 1);
+  LOG(INFO) << "Simplify " << kRepeat << " times costs " << uncached << " ms without cache and " << cached
+            << " ms with cache.";
+}
+
 }  // namespace common
 }  // namespace cinn
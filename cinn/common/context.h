@@ -39,6 +39,8 @@ namespace common {
 extern const char* kRuntimeIncludeDirEnvironKey;
 
 struct NameGenerator {
+  using IdMap = absl::flat_hash_map<std::string, uint32_t>;
+
   std::string New(const std::string& name_hint);
 
   // Reset id to initial.
@@ -47,8 +49,18 @@ struct NameGenerator {
     name_hint_idx_.clear();
   }
 
+  // Get and set all the ids, a nested compilation which resets the ids should restore them at the end.
+  IdMap GetID() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return name_hint_idx_;
+  }
+  void SetID(const IdMap& ids) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    name_hint_idx_ = ids;
+  }
+
  private:
-  absl::flat_hash_map<std::string, uint32_t> name_hint_idx_;
+  IdMap name_hint_idx_;
   mutable std::mutex mutex_;
 };
 
@@ -64,6 +76,9 @@ class Context {
 
   void ResetNameId() { name_generator_.ResetID(); }
 
+  NameGenerator::IdMap SaveNameId() const { return name_generator_.GetID(); }
+  void RestoreNameId(const NameGenerator::IdMap& ids) { name_generator_.SetID(ids); }
+
   const std::vector<std::string>& runtime_include_dir();
 
   void AddRuntimeIncludeDir(std::string dir);
@@ -20,6 +20,7 @@
 #include <functional>
 #include <set>
 #include <stack>
+#include <unordered_map>
 
 #include "cinn/common/common.h"
 #include "cinn/utils/dot_lang.h"
@@ -74,10 +75,12 @@ std::tuple<std::vector<GraphNode *>, std::vector<GraphEdge *>> Graph::topologica
   std::vector<GraphEdge *> edge_order;
   std::deque<GraphNode *> queue;
 
-  // collect indegreee.
-  std::map<std::string, int> indegree;
-  for (auto *n : nodes()) {
-    indegree[n->id()] = n->inlinks().size();
+  // collect indegreee, keyed by the nodes rather than their ids to avoid building the id strings.
+  std::unordered_map<const GraphNode *, int> indegree;
+  indegree.reserve(nodes_.size());
+  node_order.reserve(nodes_.size());
+  for (auto &n : nodes_) {
+    indegree[n.get()] = n->inlinks().size();
   }
 
   // insert start points first.
@@ -99,7 +102,7 @@ std::tuple<std::vector<GraphNode *>, std::vector<GraphEdge *>> Graph::topologica
       CHECK_EQ(edge->source(), top_node);
       edge_order.push_back(edge.get());
       auto *sink = edge->sink();
-      if ((--indegree[sink->id()]) == 0) {
+      if ((--indegree[sink]) == 0) {
         queue.push_back(sink);
       }
     }
@@ -26,6 +26,7 @@
 #include <set>
 #include <string>
 #include <tuple>
+#include <unordered_set>
 #include <vector>
 
 #include "cinn/common/object.h"
@@ -261,6 +262,12 @@ class Graph {
     }
   }
 
+  //! Drop all the nodes in \p ns with one scan of the node list.
+  void DropNodes(const std::unordered_set<GraphNode*>& ns) {
+    nodes_.erase(std::remove_if(nodes_.begin(), nodes_.end(), [&](auto& x) { return ns.count(x.get()); }),
+                 nodes_.end());
+  }
+
   //! Get a string representation to visualize a graph.
   std::string Visualize() const;
 
@@ -25,8 +25,10 @@ class RefCount {
   using value_type = int32_t;
   RefCount()       = default;
 
-  value_type Inc() { return ++count_; }
-  value_type Dec() { return --count_; }
+  //! A new reference is always taken from an existing one, so the increment needs no ordering, while the last
+  //! decrement must see all the writes made through the other references before the object is destroyed.
+  value_type Inc() { return count_.fetch_add(1, std::memory_order_relaxed) + 1; }
+  value_type Dec() { return count_.fetch_sub(1, std::memory_order_acq_rel) - 1; }
   bool is_zero() const { return 0 == count_; }
   std::string to_string() { return std::to_string(count_.load()); }
   int32_t val() const { return count_; }
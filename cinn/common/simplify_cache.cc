@@ -0,0 +1,216 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/common/simplify_cache.h"
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "cinn/optim/ir_copy.h"
+
+namespace cinn {
+namespace common {
+
+namespace {
+
+thread_local SimplifyCache* current_simplify_cache = nullptr;
+
+using VarMap = std::map<std::string, Expr>;
+
+void AppendType(const Type& type, std::string* key) {
+  key->push_back('<');
+  key->append(std::to_string(static_cast<int>(type.type())));
+  key->push_back('.');
+  key->append(std::to_string(type.bits()));
+  key->push_back('.');
+  key->append(std::to_string(type.lanes()));
+  key->push_back('>');
+}
+
+// Serialize the structure of `e` into `key` and collect its vars, return false if `e` contains unsupported nodes.
+bool AppendKey(const Expr& e, std::string* key, VarMap* vars) {
+  if (!e.defined()) return false;
+  key->append(std::to_string(static_cast<int>(e->node_type())));
+  AppendType(e.type(), key);
+  switch (e->node_type()) {
+    case ir::IrNodeTy::IntImm:
+      key->append(std::to_string(e.As<ir::IntImm>()->value));
+      return true;
+    case ir::IrNodeTy::UIntImm:
+      key->append(std::to_string(e.As<ir::UIntImm>()->value));
+      return true;
+    case ir::IrNodeTy::FloatImm: {
+      // the hexadecimal form keeps every bit of the value
+      char buf[64];
+      std::snprintf(buf, sizeof(buf), "%a", e.As<ir::FloatImm>()->value);
+      key->append(buf);
+      return true;
+    }
+    case ir::IrNodeTy::_Var_:
+      key->append(e.As<ir::_Var_>()->name);
+      vars->emplace(e.As<ir::_Var_>()->name, e);
+      return true;
+    case ir::IrNodeTy::Cast:
+#define __m(op__) case ir::IrNodeTy::op__:
+      NODETY_OP_FOR_EACH(__m)
+#undef __m
+      key->push_back('(');
+      for (auto& operand : e->operands) {
+        if (!AppendKey(operand, key, vars)) return false;
+        key->push_back(',');
+      }
+      key->push_back(')');
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Rebuild `e` with fresh internal nodes, the leaves are mapped by `leaf_fn`. Return an undefined expr if `e` contains
+// unsupported nodes or `leaf_fn` fails.
+Expr Rebuild(const Expr& e, const std::function<Expr(const Expr&)>& leaf_fn) {
+  if (!e.defined()) return Expr();
+  switch (e->node_type()) {
+    case ir::IrNodeTy::IntImm:
+    case ir::IrNodeTy::UIntImm:
+    case ir::IrNodeTy::FloatImm:
+    case ir::IrNodeTy::_Var_:
+      return leaf_fn(e);
+    case ir::IrNodeTy::Cast: {
+      Expr v = Rebuild(e.As<ir::Cast>()->v(), leaf_fn);
+      return v.defined() ? ir::Cast::Make(e.type(), v) : Expr();
+    }
+#define __m(op__)                                                      \
+  case ir::IrNodeTy::op__: {                                           \
+    Expr a = Rebuild(e.As<ir::op__>()->a(), leaf_fn);                  \
+    Expr b = Rebuild(e.As<ir::op__>()->b(), leaf_fn);                  \
+    return a.defined() && b.defined() ? ir::op__::Make(a, b) : Expr(); \
+  }
+      NODETY_BINARY_OP_FOR_EACH(__m)
+#undef __m
+#define __m(op__)                                     \
+  case ir::IrNodeTy::op__: {                          \
+    Expr v = Rebuild(e.As<ir::op__>()->v(), leaf_fn); \
+    return v.defined() ? ir::op__::Make(v) : Expr();  \
+  }
+      NODETY_UNARY_OP_FOR_EACH(__m)
+#undef __m
+    default:
+      return Expr();
+  }
+}
+
+}  // namespace
+
+SimplifyCache* SimplifyCache::Current() { return current_simplify_cache; }
+
+Expr SimplifyCache::Simplify(const Expr& u,
+                             const cas_intervals_t& var_intervals,
+                             const std::function<Expr()>& simplify) {
+  std::string key;
+  VarMap vars;
+  bool cacheable = AppendKey(u, &key, &vars);
+  // the intervals of the vars in `u` and the vars in their bounds affect the result, they are appended in a
+  // deterministic order: the vars of `u` ordered by name, then the vars in the bounds as they are found
+  std::vector<std::string> worklist;
+  for (auto& item : vars) {
+    worklist.push_back(item.first);
+  }
+  for (size_t i = 0; i < worklist.size() && cacheable; ++i) {
+    auto it = var_intervals.find(worklist[i]);
+    if (it == var_intervals.end()) continue;
+    key.append("|" + worklist[i] + ":");
+    if (it->second.e_l.defined() && it->second.e_r.defined()) {
+      VarMap bound_vars;
+      cacheable = AppendKey(it->second.e_l, &key, &bound_vars) && AppendKey(it->second.e_r, &key, &bound_vars);
+      for (auto& item : bound_vars) {
+        if (vars.emplace(item.first, item.second).second) worklist.push_back(item.first);
+      }
+    } else {
+      key.append(std::to_string(it->second.l) + "," + std::to_string(it->second.r));
+    }
+  }
+  if (!cacheable) {
+    ++bypass_count_;
+    return simplify();
+  }
+  // the result takes the copies of the current vars, as the uncached simplification does
+  auto from_input = [&](const Expr& leaf) -> Expr {
+    if (!leaf.As<ir::_Var_>()) return leaf;
+    auto it = vars.find(leaf.As<ir::_Var_>()->name);
+    return it == vars.end() ? Expr() : optim::IRCopy(it->second);
+  };
+
+  Expr cached;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = results_.find(key);
+    if (it != results_.end()) cached = it->second;
+  }
+  if (cached.defined()) {
+    ++hit_count_;
+    return Rebuild(cached, from_input);
+  }
+
+  ++miss_count_;
+  Expr result = simplify();
+  // the stored result owns its nodes, the vars only keep the names to be looked up in the later inputs
+  Expr stored = Rebuild(result, [&](const Expr& leaf) -> Expr {
+    if (auto* var = leaf.As<ir::_Var_>()) {
+      return vars.count(var->name) ? ir::_Var_::Make(var->name, var->type()) : Expr();
+    }
+    return InternLeaf(leaf);
+  });
+  if (stored.defined()) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    results_.emplace(std::move(key), stored);
+  }
+  return result;
+}
+
+Expr SimplifyCache::InternLeaf(const Expr& imm) {
+  std::string key;
+  VarMap vars;
+  AppendKey(imm, &key, &vars);
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto it = leaves_.find(key);
+  if (it == leaves_.end()) {
+    it = leaves_.emplace(key, optim::IRCopy(imm)).first;
+  }
+  return it->second;
+}
+
+void SimplifyCache::Clear() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  results_.clear();
+  leaves_.clear();
+  hit_count_    = 0;
+  miss_count_   = 0;
+  bypass_count_ = 0;
+}
+
+size_t SimplifyCache::size() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return results_.size();
+}
+
+SimplifyCacheScope::SimplifyCacheScope(SimplifyCache* cache) : prev_(current_simplify_cache) {
+  current_simplify_cache = cache;
+}
+
+SimplifyCacheScope::~SimplifyCacheScope() { current_simplify_cache = prev_; }
+
+}  // namespace common
+}  // namespace cinn
@@ -0,0 +1,86 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <absl/container/flat_hash_map.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "cinn/common/cas.h"
+#include "cinn/ir/ir.h"
+
+namespace cinn {
+namespace common {
+
+/**
+ * The memo of the results of `AutoSimplify` in a lowering session, it can be shared by the lowering threads.
+ *
+ * Only the expressions made of constants, vars, arithmetic, comparison, logical and cast nodes are memoized. They are
+ * keyed by their structure (node types, value types, constants and var names) together with the intervals of their
+ * vars. A cached result is rebuilt on every hit so that the callers can mutate it freely: the vars are copied from the
+ * current input and the constant leaves are hash-consed, i.e. shared from the pool of the cache.
+ */
+class SimplifyCache {
+ public:
+  SimplifyCache() = default;
+
+  //! Get the cache installed on the current thread by `SimplifyCacheScope`, nullptr if there is none.
+  static SimplifyCache* Current();
+
+  //! Return the memoized result of `u`, or compute it by `simplify` and memoize it.
+  Expr Simplify(const Expr& u, const cas_intervals_t& var_intervals, const std::function<Expr()>& simplify);
+
+  void Clear();
+
+  size_t size() const;
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+  //! The number of the expressions which are not memoized since they contain other nodes.
+  size_t bypass_count() const { return bypass_count_; }
+
+ private:
+  SimplifyCache(const SimplifyCache&) = delete;
+  SimplifyCache& operator=(const SimplifyCache&) = delete;
+
+  //! Get the hash-consed node of the constant `imm`.
+  Expr InternLeaf(const Expr& imm);
+
+  mutable std::mutex mtx_;
+  absl::flat_hash_map<std::string, Expr> results_;
+  absl::flat_hash_map<std::string, Expr> leaves_;
+
+  std::atomic<size_t> hit_count_{0};
+  std::atomic<size_t> miss_count_{0};
+  std::atomic<size_t> bypass_count_{0};
+};
+
+/**
+ * Install a `SimplifyCache` on the current thread during the life time of the scope, the previous one is restored when
+ * the scope exits. Installing nullptr disables the memo in the scope.
+ */
+class SimplifyCacheScope {
+ public:
+  explicit SimplifyCacheScope(SimplifyCache* cache);
+  ~SimplifyCacheScope();
+
+ private:
+  SimplifyCache* prev_;
+};
+
+}  // namespace common
+}  // namespace cinn
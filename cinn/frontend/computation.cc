@@ -20,6 +20,9 @@
 #include "cinn/hlir/framework/graph_compiler.h"
 #include "cinn/hlir/framework/pass.h"
 #include "cinn/hlir/framework/scope.h"
+#include "cinn/runtime/flags.h"
+
+DECLARE_bool(cinn_use_param_folding);
 
 namespace cinn {
 namespace frontend {
@@ -44,6 +47,7 @@ std::shared_ptr<ComputationContext> CompileProgram(const Target &target,
                                                    Program &program,
                                                    const std::vector<Variable> &outputs,
                                                    std::shared_ptr<hlir::framework::Scope> scope,
+                                                   const std::unordered_set<std::string> &param_names,
                                                    const CinnComputation::CompileOptions &options,
                                                    void *stream) {
   std::shared_ptr<ComputationContext> ctx(new ComputationContext());
@@ -57,6 +61,11 @@ std::shared_ptr<ComputationContext> CompileProgram(const Target &target,
 
   if (ctx->compile_options.use_default_passes) {
     hlir::framework::ApplyPass(ctx->graph.get(), "InferShape");
+    if (FLAGS_cinn_use_param_folding && scope && !param_names.empty()) {
+      ctx->graph->attrs["param_scope"] = std::make_shared<absl::any>(scope);
+      ctx->graph->attrs["param_names"] = std::make_shared<absl::any>(param_names);
+      hlir::framework::ApplyPass(ctx->graph.get(), "ParamFolding");
+    }
 
 #ifndef CINN_WITH_CUDA
     if (target.arch == Target::Arch::X86) {
@@ -121,6 +130,11 @@ std::shared_ptr<CinnComputation> CinnComputation::CompilePaddleModel(
   auto &varmap                = std::get<1>(loadedProgram);
   auto &varmap_paddle2program = std::get<2>(loadedProgram);
   auto &fetch_names           = std::get<3>(loadedProgram);
+  // the variables in the scope are the parameters loaded from the model
+  std::unordered_set<std::string> param_names;
+  for (auto &name : scope->var_names()) {
+    param_names.emplace(name);
+  }
 
   // std::vector<Variable> input_vars;
   // for (int i = 0; i < input_names.size(); i++) {
@@ -137,7 +151,8 @@ std::shared_ptr<CinnComputation> CinnComputation::CompilePaddleModel(
     output_vars.push_back(varmap.at(name));
   }
 
-  std::shared_ptr<ComputationContext> ctx = CompileProgram(target, *program, output_vars, scope, options, stream);
+  std::shared_ptr<ComputationContext> ctx =
+      CompileProgram(target, *program, output_vars, scope, param_names, options, stream);
   for (auto &v : varmap) {
     ctx->varmap[v.first] = v.second;
   }
@@ -170,7 +185,7 @@ std::shared_ptr<CinnComputation> CinnComputation::Compile(const Target &target,
     output_vars.push_back(program[program.size() - 1].GetOutput(0));
   }
 
-  std::shared_ptr<ComputationContext> ctx = CompileProgram(target, program, output_vars, nullptr, options, stream);
+  std::shared_ptr<ComputationContext> ctx = CompileProgram(target, program, output_vars, nullptr, {}, options, stream);
 
   auto computation      = std::make_shared<CinnComputation>();
   computation->context_ = std::move(ctx);
@@ -0,0 +1,251 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/frontend/computation_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include "cinn/utils/string.h"
+
+namespace cinn {
+namespace frontend {
+
+namespace {
+
+// GraphCompiler::Build resets the global name ids, so the compilations cannot overlap.
+std::mutex &CompileMutex() {
+  static std::mutex compile_mutex;
+  return compile_mutex;
+}
+
+}  // namespace
+
+CinnComputationCache::CinnComputationCache(const Target &target,
+                                           ProgramBuilder builder,
+                                           const Options &options,
+                                           void *stream)
+    : target_(target), builder_(std::move(builder)), options_(options), stream_(stream) {
+  CHECK(builder_) << "The program builder of CinnComputationCache should not be empty.";
+  CHECK_GT(options_.capacity, 0UL) << "The capacity of CinnComputationCache should be positive.";
+  for (auto &dynamic_dim : options_.dynamic_dims) {
+    CHECK(std::is_sorted(dynamic_dim.buckets.begin(), dynamic_dim.buckets.end()))
+        << "The buckets should be in ascending order: " << utils::Join(dynamic_dim.buckets, ", ");
+  }
+  prefetch_thread_ = std::thread(&CinnComputationCache::PrefetchLoop, this);
+}
+
+CinnComputationCache::~CinnComputationCache() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  prefetch_cv_.notify_all();
+  // the queued buckets are dropped, only the running compilation is waited for
+  prefetch_thread_.join();
+}
+
+std::vector<hlir::framework::shape_t> CinnComputationCache::GetBucketedShapes(
+    const std::vector<hlir::framework::shape_t> &input_shapes) const {
+  auto shapes = input_shapes;
+  for (auto &dynamic_dim : options_.dynamic_dims) {
+    int size = 0;
+    for (auto &dim : dynamic_dim.dims) {
+      CHECK_LT(dim.first, shapes.size()) << "The input " << dim.first << " of the dynamic dim does not exist.";
+      CHECK_LT(dim.second, shapes[dim.first].size()) << "The axis " << dim.second << " of input " << dim.first
+                                                     << " does not exist.";
+      size = std::max(size, shapes[dim.first][dim.second]);
+    }
+    auto bucket = std::lower_bound(dynamic_dim.buckets.begin(), dynamic_dim.buckets.end(), size);
+    if (bucket == dynamic_dim.buckets.end()) {
+      VLOG(3) << "The size " << size << " is larger than all the buckets, it is not padded.";
+    } else {
+      size = *bucket;
+    }
+    for (auto &dim : dynamic_dim.dims) {
+      shapes[dim.first][dim.second] = size;
+    }
+  }
+  return shapes;
+}
+
+std::string CinnComputationCache::GetKey(const std::vector<hlir::framework::shape_t> &shapes) const {
+  std::vector<std::string> dims;
+  for (auto &shape : shapes) {
+    dims.push_back(utils::Join(shape, ","));
+  }
+  return utils::Join(dims, ";");
+}
+
+std::shared_ptr<CinnComputation> CinnComputationCache::Get(const std::vector<hlir::framework::shape_t> &input_shapes) {
+  auto shapes = GetBucketedShapes(input_shapes);
+  auto key    = GetKey(shapes);
+
+  ComputationFuture computation;
+  // the promise of the computation to compile by this caller
+  ComputationPromise promise;
+  bool miss = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      ++metrics_.hits;
+      if (it->second.prefetched) {
+        ++metrics_.prefetch_hits;
+        it->second.prefetched = false;
+      }
+      lru_.splice(lru_.begin(), lru_, it->second.lru_pos);
+      computation = it->second.computation;
+      // the prefetching of the bucket has not started, compile it here instead of waiting for the queue
+      auto pending = pending_prefetches_.find(key);
+      if (pending != pending_prefetches_.end()) {
+        promise = pending->second.promise;
+        pending_prefetches_.erase(pending);
+      }
+    } else {
+      ++metrics_.misses;
+      miss        = true;
+      promise     = Insert(key, false);
+      computation = entries_.at(key).computation;
+      Evict();
+    }
+    if (promise) {
+      ++num_foreground_compiles_;
+    }
+  }
+  if (promise) {
+    promise->set_value(Compile(shapes));
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --num_foreground_compiles_;
+    }
+    prefetch_cv_.notify_all();
+  }
+  if (miss) {
+    Prefetch(shapes);
+  }
+  return computation.get();
+}
+
+std::shared_ptr<CinnComputation> CinnComputationCache::Compile(const std::vector<hlir::framework::shape_t> &shapes) {
+  std::lock_guard<std::mutex> compile_lock(CompileMutex());
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<Variable> outputs;
+  auto program     = builder_(shapes, &outputs);
+  auto fingerprint = std::hash<std::string>()(utils::GetStreamCnt(program));
+  auto computation = CinnComputation::Compile(target_, program, options_.compile_options, outputs, stream_);
+
+  double compile_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  VLOG(3) << "Compile the program " << fingerprint << " for shapes [" << GetKey(shapes) << "] costs " << compile_time
+          << " ms.";
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++metrics_.compiles;
+  metrics_.compile_time_ms += compile_time;
+  return computation;
+}
+
+CinnComputationCache::ComputationPromise CinnComputationCache::Insert(const std::string &key, bool prefetch) {
+  auto promise      = std::make_shared<std::promise<std::shared_ptr<CinnComputation>>>();
+  auto &entry       = entries_[key];
+  entry.computation = promise->get_future().share();
+  entry.prefetched  = prefetch;
+  // the prefetched computations have not been used, they are the first to be evicted
+  entry.lru_pos = prefetch ? lru_.insert(lru_.end(), key) : lru_.insert(lru_.begin(), key);
+  return promise;
+}
+
+void CinnComputationCache::Evict() {
+  auto it = lru_.end();
+  while (entries_.size() > options_.capacity && it != lru_.begin()) {
+    --it;
+    auto &computation = entries_.at(*it).computation;
+    // the computations being compiled or waiting in the prefetch queue are kept
+    if (computation.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      continue;
+    }
+    VLOG(3) << "Evict the computation for shapes [" << *it << "]";
+    ++metrics_.evictions;
+    entries_.erase(*it);
+    it = lru_.erase(it);
+  }
+}
+
+void CinnComputationCache::Prefetch(const std::vector<hlir::framework::shape_t> &shapes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &dynamic_dim : options_.dynamic_dims) {
+    if (dynamic_dim.dims.empty()) {
+      continue;
+    }
+    auto &first_dim = dynamic_dim.dims.front();
+    auto bucket     = std::upper_bound(
+        dynamic_dim.buckets.begin(), dynamic_dim.buckets.end(), shapes[first_dim.first][first_dim.second]);
+    for (int i = 0; i < options_.num_prefetch && bucket != dynamic_dim.buckets.end(); ++i, ++bucket) {
+      // the prefetching never evicts the computations in use
+      if (entries_.size() >= options_.capacity) {
+        return;
+      }
+      auto next_shapes = shapes;
+      for (auto &dim : dynamic_dim.dims) {
+        next_shapes[dim.first][dim.second] = *bucket;
+      }
+      auto key = GetKey(next_shapes);
+      if (!entries_.count(key)) {
+        VLOG(3) << "Prefetch the computation for shapes [" << key << "]";
+        pending_prefetches_[key] = {next_shapes, Insert(key, true)};
+        prefetch_queue_.push_back(key);
+        prefetch_cv_.notify_all();
+      }
+    }
+  }
+}
+
+void CinnComputationCache::PrefetchLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    // compile one bucket at a time when no caller of Get is compiling, so a miss waits for one prefetching at most
+    prefetch_cv_.wait(
+        lock, [this]() { return stopped_ || (!prefetch_queue_.empty() && num_foreground_compiles_ == 0); });
+    if (stopped_) {
+      return;
+    }
+    auto key = prefetch_queue_.front();
+    prefetch_queue_.pop_front();
+    auto pending = pending_prefetches_.find(key);
+    // the bucket has been compiled by a caller of Get
+    if (pending == pending_prefetches_.end()) {
+      continue;
+    }
+    auto prefetch = std::move(pending->second);
+    pending_prefetches_.erase(pending);
+    lock.unlock();
+    prefetch.promise->set_value(Compile(prefetch.shapes));
+    lock.lock();
+  }
+}
+
+CinnComputationCache::Metrics CinnComputationCache::GetMetrics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return metrics_;
+}
+
+size_t CinnComputationCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace frontend
+}  // namespace cinn
@@ -0,0 +1,152 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cinn/frontend/computation.h"
+
+namespace cinn {
+namespace frontend {
+
+/**
+ * CinnComputationCache holds the CinnComputations of a model compiled for different input shapes, such as variable
+ * batch sizes and sequence lengths, so that a shape seen before needs no recompilation.
+ *
+ * The dynamic dims are padded to the next configured bucket, the caller should pad the input data to the shapes of
+ * the input tensors of the returned computation. At most `capacity` computations are kept in the least recently used
+ * order, and after a miss the next larger buckets are compiled in background.
+ *
+ * A miss is compiled by the caller of Get. The prefetched buckets are compiled one at a time by a background thread
+ * owned by the cache, which yields to the callers of Get: it only starts a compilation when no caller is compiling,
+ * and a caller asking for a prefetched bucket not started yet compiles it in place.
+ */
+class CinnComputationCache {
+ public:
+  /**
+   * Build the program of the model for the input shapes, it is called by the compilations one at a time.
+   * @param input_shapes The shapes of the inputs, in the order of Options::dynamic_dims referring to.
+   * @param outputs The output variables of the program, the output of the last instruction is used if it is empty.
+   */
+  using ProgramBuilder =
+      std::function<Program(const std::vector<hlir::framework::shape_t> &input_shapes, std::vector<Variable> *outputs)>;
+
+  struct DynamicDim {
+    // the input dims sharing the same size, such as the batch dims of all the inputs, as (input index, axis) pairs
+    std::vector<std::pair<int, int>> dims;
+    // the ascending bucket sizes, a size larger than the last bucket is not padded
+    std::vector<int> buckets;
+  };
+
+  struct Options {
+    size_t capacity = 8;
+    std::vector<DynamicDim> dynamic_dims;
+    // the number of larger buckets of each dynamic dim compiled in background after a miss
+    int num_prefetch                                = 1;
+    CinnComputation::CompileOptions compile_options = CinnComputation::DefaultCompileOptions();
+  };
+
+  struct Metrics {
+    int64_t hits{0};
+    int64_t misses{0};
+    // the hits of the computations compiled in background
+    int64_t prefetch_hits{0};
+    int64_t evictions{0};
+    int64_t compiles{0};
+    double compile_time_ms{0};
+  };
+
+  CinnComputationCache(const Target &target, ProgramBuilder builder, const Options &options, void *stream = nullptr);
+  ~CinnComputationCache();
+
+  /**
+   * Get the computation for the input shapes, which are padded to the buckets first. It is compiled if not cached.
+   * @param input_shapes The shapes of the input data.
+   */
+  std::shared_ptr<CinnComputation> Get(const std::vector<hlir::framework::shape_t> &input_shapes);
+
+  //! Pad the dynamic dims of the input shapes to their buckets.
+  std::vector<hlir::framework::shape_t> GetBucketedShapes(
+      const std::vector<hlir::framework::shape_t> &input_shapes) const;
+
+  Metrics GetMetrics() const;
+
+  size_t size() const;
+
+ private:
+  using ComputationFuture  = std::shared_future<std::shared_ptr<CinnComputation>>;
+  using ComputationPromise = std::shared_ptr<std::promise<std::shared_ptr<CinnComputation>>>;
+
+  struct Entry {
+    ComputationFuture computation;
+    std::list<std::string>::iterator lru_pos;
+    bool prefetched{false};
+  };
+
+  std::string GetKey(const std::vector<hlir::framework::shape_t> &shapes) const;
+
+  std::shared_ptr<CinnComputation> Compile(const std::vector<hlir::framework::shape_t> &shapes);
+
+  struct PendingPrefetch {
+    std::vector<hlir::framework::shape_t> shapes;
+    ComputationPromise promise;
+  };
+
+  // insert the entry of a computation to be compiled and return its promise, the caller should hold mutex_
+  ComputationPromise Insert(const std::string &key, bool prefetch);
+
+  // evict the least recently used computations which have been compiled, the caller should hold mutex_
+  void Evict();
+
+  // queue the next larger buckets of the shapes for the prefetch thread
+  void Prefetch(const std::vector<hlir::framework::shape_t> &shapes);
+
+  // the loop of prefetch_thread_, which compiles the queued buckets until the cache is destroyed
+  void PrefetchLoop();
+
+  Target target_;
+  ProgramBuilder builder_;
+  Options options_;
+  void *stream_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  // the keys from the most recently used to the least
+  std::list<std::string> lru_;
+  Metrics metrics_;
+
+  // the keys of the prefetched buckets in the order to compile, and the ones not started yet
+  std::deque<std::string> prefetch_queue_;
+  std::unordered_map<std::string, PendingPrefetch> pending_prefetches_;
+  // the number of the callers of Get compiling, the prefetch thread waits for them
+  int num_foreground_compiles_{0};
+  bool stopped_{false};
+  std::condition_variable prefetch_cv_;
+  std::thread prefetch_thread_;
+};
+
+}  // namespace frontend
+}  // namespace cinn
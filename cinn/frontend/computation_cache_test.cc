@@ -0,0 +1,114 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/frontend/computation_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "cinn/common/target.h"
+#include "cinn/frontend/net_builder.h"
+
+namespace cinn {
+namespace frontend {
+
+Program CreateReluAddProgram(const std::vector<hlir::framework::shape_t>& input_shapes, std::vector<Variable>* outputs) {
+  NetBuilder builder("relu_add");
+  auto a = builder.CreateInput(Float(32), input_shapes[0], "A");
+  auto b = builder.CreateInput(Float(32), input_shapes[1], "B");
+  auto c = builder.Relu(a);
+  auto d = builder.Add(b, c);
+  outputs->push_back(d);
+  return builder.Build();
+}
+
+TEST(CinnComputationCache, bucket_and_lru) {
+  CinnComputationCache::Options options;
+  options.capacity     = 2;
+  options.num_prefetch = 1;
+  // the batch dims of A and B
+  options.dynamic_dims = {{{{0, 0}, {1, 0}}, {4, 8, 16}}};
+  CinnComputationCache cache(common::DefaultTarget(), CreateReluAddProgram, options);
+
+  // the batch 3 is padded to 4, and the bucket 8 is compiled in background
+  auto computation = cache.Get({{3, 16}, {3, 16}});
+  auto inputs      = computation->GetInputTensors();
+  ASSERT_EQ(inputs.size(), 2UL);
+  ASSERT_EQ(inputs[0]->shape().data(), std::vector<int>({4, 16}));
+  ASSERT_EQ(cache.Get({{4, 16}, {4, 16}}), computation);
+  auto prefetched = cache.Get({{6, 16}, {6, 16}});
+  ASSERT_EQ(prefetched->GetInputTensors()[0]->shape().data(), std::vector<int>({8, 16}));
+
+  auto metrics = cache.GetMetrics();
+  ASSERT_EQ(metrics.misses, 1);
+  ASSERT_EQ(metrics.hits, 2);
+  ASSERT_EQ(metrics.prefetch_hits, 1);
+
+  // the batch larger than all the buckets is not padded, and the least recently used bucket 4 is evicted
+  auto unpadded = cache.Get({{20, 16}, {20, 16}});
+  ASSERT_EQ(unpadded->GetInputTensors()[0]->shape().data(), std::vector<int>({20, 16}));
+  ASSERT_EQ(cache.size(), 2UL);
+  metrics = cache.GetMetrics();
+  ASSERT_EQ(metrics.misses, 2);
+  ASSERT_EQ(metrics.evictions, 1);
+  ASSERT_EQ(metrics.compiles, 3);
+  ASSERT_GT(metrics.compile_time_ms, 0.0);
+  LOG(INFO) << "Compile " << metrics.compiles << " programs costs " << metrics.compile_time_ms << " ms";
+
+  // the evicted computation is still alive
+  std::vector<float> a(4 * 16), b(4 * 16), out(4 * 16);
+  for (int i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>(i % 7) - 3.0f;
+    b[i] = static_cast<float>(i % 5);
+  }
+  computation->SetTensorData(inputs[0], a.data(), a.size() * sizeof(float));
+  computation->SetTensorData(inputs[1], b.data(), b.size() * sizeof(float));
+  computation->Execute();
+  auto output = computation->GetOutputTensors()[0];
+  computation->GetTensorData(output, out.data(), out.size() * sizeof(float));
+  for (int i = 0; i < out.size(); ++i) {
+    ASSERT_FLOAT_EQ(out[i], b[i] + std::max(a[i], 0.0f));
+  }
+}
+
+TEST(CinnComputationCache, destroy_with_queued_prefetches) {
+  CinnComputationCache::Options options;
+  options.num_prefetch = 3;
+  options.dynamic_dims = {{{{0, 0}, {1, 0}}, {4, 8, 16, 32}}};
+  std::atomic<int> num_builds{0};
+  auto builder = [&num_builds](const std::vector<hlir::framework::shape_t>& input_shapes,
+                               std::vector<Variable>* outputs) {
+    ++num_builds;
+    return CreateReluAddProgram(input_shapes, outputs);
+  };
+  {
+    CinnComputationCache cache(common::DefaultTarget(), builder, options);
+    // the miss is compiled by the caller, the buckets 8, 16 and 32 are queued for the prefetch thread
+    auto computation = cache.Get({{3, 16}, {3, 16}});
+    ASSERT_EQ(computation->GetInputTensors()[0]->shape().data(), std::vector<int>({4, 16}));
+    ASSERT_EQ(cache.size(), 4UL);
+  }
+  // the destructor drops the queued buckets and joins the prefetch thread, nothing is compiled after it
+  int num_builds_after_destroy = num_builds;
+  ASSERT_LE(num_builds_after_destroy, 4);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ(num_builds, num_builds_after_destroy);
+}
+
+}  // namespace frontend
+}  // namespace cinn
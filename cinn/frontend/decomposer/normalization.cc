@@ -0,0 +1,328 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <absl/types/optional.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cinn/frontend/decomposer_registry.h"
+#include "cinn/frontend/syntax.h"
+#include "cinn/utils/string.h"
+
+DECLARE_bool(cinn_use_custom_call);
+DECLARE_string(cinn_custom_call_deny_ops);
+
+namespace cinn {
+namespace frontend {
+namespace decomposer {
+
+namespace {
+
+// Whether the op is kept on the host to run its extern kernel by custom call, the kernels compute in the type of the
+// input and support float32 and float64 only.
+bool UseHostKernel(const Instruction& instr) {
+  if (!FLAGS_cinn_use_custom_call) {
+    return false;
+  }
+  auto deny_ops = utils::Split(FLAGS_cinn_custom_call_deny_ops, ";");
+  if (std::find(deny_ops.begin(), deny_ops.end(), instr->op_type) != deny_ops.end()) {
+    return false;
+  }
+  auto type = instr->inputs[0]->type;
+  if (!type.is_float(32) && !type.is_float(64)) {
+    return false;
+  }
+  return std::all_of(
+      instr->inputs.begin(), instr->inputs.end(), [&](const Variable& input) { return input->type == type; });
+}
+
+// view x as [left, right], the axes from begin_norm_axis are normalized
+std::pair<int, int> GetNormRows(const std::vector<int>& x_shape, int begin_norm_axis) {
+  int ndim = x_shape.size();
+  if (begin_norm_axis < 0) {
+    begin_norm_axis += ndim;
+  }
+  CHECK(begin_norm_axis >= 0 && begin_norm_axis < ndim)
+      << "`begin_norm_axis` must be in the range of the dimensions of X, but received " << begin_norm_axis;
+  int left = 1;
+  for (int i = 0; i < begin_norm_axis; i++) {
+    left *= x_shape[i];
+  }
+  int right = 1;
+  for (int i = begin_norm_axis; i < ndim; i++) {
+    right *= x_shape[i];
+  }
+  return {left, right};
+}
+
+// the scale and bias of layer_norm are optional, the attributes `has_scale` and `has_bias` record which ones follow x
+std::pair<absl::optional<Variable>, absl::optional<Variable>> GetScaleAndBias(const Instruction& instr) {
+  auto has_input = [&](const std::string& key) { return !instr->attrs.count(key) || instr.GetAttrs<bool>(key); };
+  absl::optional<Variable> scale;
+  absl::optional<Variable> bias;
+  size_t idx = 1;
+  if (has_input("has_scale")) {
+    scale = instr->inputs.at(idx++);
+  }
+  if (has_input("has_bias")) {
+    bias = instr->inputs.at(idx++);
+  }
+  CHECK_EQ(idx, instr->inputs.size()) << "The inputs of " << instr->op_type << " mismatch its has_scale and has_bias";
+  return {scale, bias};
+}
+
+}  // namespace
+
+void softmax(const Instruction& instr, const DecomposerContext& context) {
+  CHECK_EQ(instr->inputs.size(), 1UL) << " 1 input tensor for " << instr->op_type;
+  CHECK_EQ(instr->outputs.size(), 1UL) << "1 output tensor for " << instr->op_type;
+  auto x        = instr->inputs[0];
+  auto output   = instr->outputs[0];
+  auto* builder = context.builder();
+
+  std::vector<int> b_axes;
+  auto axes = instr.GetAttrs<std::vector<int>>("axes");
+  CHECK(axes.size());
+  for (auto& axis : axes) {
+    if (axis < 0) {
+      axis += x->shape.size();
+    }
+  }
+  for (int idx = 0; idx < x->shape.size(); ++idx) {
+    if (std::find(axes.begin(), axes.end(), idx) == axes.end()) {
+      b_axes.push_back(idx);
+    }
+  }
+
+  // When the rank of x is 1, broadcast axes will be empty, so we need to insert last dim as broadcast axis.
+  if (b_axes.empty()) {
+    b_axes.emplace_back(-1);
+  }
+
+  auto mode = instr.GetAttrs<std::string>("mode");
+  if (mode == "fast") {
+    // x_sum = sum(exp(x))
+    auto x_sum = builder->BroadcastTo(builder->ReduceSum(builder->Exp(x), axes), x->shape, b_axes);
+    // x_exp / x_sum
+    auto out = builder->Divide(builder->Exp(x), x_sum);
+
+    // map the the output of decomposed operator to the original.
+    context.MapOutToOrigin(out, output);
+  } else {
+    // x = max(x)
+    auto x_max = builder->BroadcastTo(builder->ReduceMax(x, axes), x->shape, b_axes);
+    // x_exp = exp(x - x_max)
+    auto x_exp = builder->Exp(builder->Subtract(x, x_max));
+    // x_sum = sum(x_exp)
+    auto x_sum = builder->BroadcastTo(builder->ReduceSum(x_exp, axes), x->shape, b_axes);
+    // x_exp / x_sum
+    auto out = builder->Divide(builder->Exp(builder->Subtract(x, x_max)), x_sum);
+
+    // map the the output of decomposed operator to the original.
+    context.MapOutToOrigin(out, output);
+  }
+}
+
+// The host keeps the softmax along a single axis, whose kernel subtracts the max in both modes.
+void softmax_host(const Instruction& instr, const DecomposerContext& context) {
+  if (UseHostKernel(instr) && instr.GetAttrs<std::vector<int>>("axes").size() == 1UL) {
+    context.builder()->AppendInstruction(instr);
+    return;
+  }
+  softmax(instr, context);
+}
+
+void layer_norm(const Instruction& instr, const DecomposerContext& context) {
+  CHECK_EQ(instr->outputs.size(), 3UL) << "3 output tensors for " << instr->op_type;
+  auto x          = instr->inputs[0];
+  auto scale_bias = GetScaleAndBias(instr);
+  auto& scale     = scale_bias.first;
+  auto& bias      = scale_bias.second;
+  auto* builder   = context.builder();
+
+  float epsilon = instr.GetAttrs<float>("epsilon");
+  auto rows     = GetNormRows(x->shape, instr.GetAttrs<int>("begin_norm_axis"));
+  int left      = rows.first;
+  int right     = rows.second;
+  auto x_shape  = x->shape;
+  auto x_type   = x->type;
+  if (x_type.is_float16() || x_type.is_bfloat16()) {
+    x = builder->Cast(x, "float32");
+  }
+  if (scale && ((*scale)->type.is_float16() || (*scale)->type.is_bfloat16())) {
+    scale = builder->Cast(*scale, "float32");
+  }
+  if (bias && ((*bias)->type.is_float16() || (*bias)->type.is_bfloat16())) {
+    bias = builder->Cast(*bias, "float32");
+  }
+
+  // compute mean
+  std::vector<int> shape{left, right};
+  auto x_reshape = builder->Reshape(x, shape);
+  auto x_reduce  = builder->ReduceSum(x_reshape, {1});
+  auto ele_num   = builder->FillConstant(
+      {left}, static_cast<float>(right), common::UniqName("layer_norm_ele_num"), common::Type2Str(x->type));
+  auto x_mean = builder->Divide(x_reduce, ele_num);
+
+  // use `E[|x|^2] - |E[x]|^2` instead of `E[|x - E[x]|^2])` to compute variance, both reductions read x only
+  auto x2        = builder->Multiply(x_reshape, builder->Identity(x_reshape));
+  auto x2_reduce = builder->ReduceSum(x2, {1});
+  auto x2_mean   = builder->Divide(x2_reduce, ele_num);
+  auto x_mean2   = builder->Multiply(x_mean, builder->Identity(x_mean));
+  auto zero      = builder->FillConstant({left}, 0.f, common::UniqName("layer_norm_zero"), common::Type2Str(x->type));
+  auto x_var     = builder->Max(builder->Subtract(x2_mean, x_mean2), zero);
+
+  // compute x norm
+  auto x_mean_broadcast = builder->BroadcastTo(x_mean, shape, {0});
+  auto y_sub            = builder->Subtract(x_reshape, x_mean_broadcast);
+  auto epsilon_var =
+      builder->FillConstant({left}, epsilon, common::UniqName("layer_norm_epsilon"), common::Type2Str(x->type));
+  auto x_var_eps  = builder->Add(x_var, epsilon_var);
+  auto x_var_sqrt = builder->Sqrt(x_var_eps);
+  auto y_out      = builder->Divide(y_sub, builder->BroadcastTo(x_var_sqrt, shape, {0}));
+
+  // multiply scale and add bias
+  if (scale) {
+    y_out = builder->Multiply(y_out, builder->BroadcastTo(*scale, shape, {1}));
+  }
+  if (bias) {
+    y_out = builder->Add(y_out, builder->BroadcastTo(*bias, shape, {1}));
+  }
+
+  // reshape to the original shape
+  y_out = builder->Reshape(y_out, x_shape);
+  if (x_type.is_float16()) {
+    y_out = builder->Cast(y_out, "float16");
+  } else if (x_type.is_bfloat16()) {
+    y_out = builder->Cast(y_out, "bfloat16");
+  }
+
+  // map the the output of decomposed operator to the original.
+  context.MapOutToOrigin(y_out, instr->outputs[0]);
+  context.MapOutToOrigin(x_mean, instr->outputs[1]);
+  context.MapOutToOrigin(x_var, instr->outputs[2]);
+}
+
+void layer_norm_host(const Instruction& instr, const DecomposerContext& context) {
+  if (!UseHostKernel(instr)) {
+    layer_norm(instr, context);
+    return;
+  }
+  if (instr->inputs.size() == 3UL) {
+    context.builder()->AppendInstruction(instr);
+    return;
+  }
+  // the host kernel reads both scale and bias, fill the missing ones by the identities
+  auto x          = instr->inputs[0];
+  auto scale_bias = GetScaleAndBias(instr);
+  auto* builder   = context.builder();
+  float epsilon   = instr.GetAttrs<float>("epsilon");
+  int norm_axis   = instr.GetAttrs<int>("begin_norm_axis");
+  int right       = GetNormRows(x->shape, norm_axis).second;
+  auto dtype      = common::Type2Str(x->type);
+  auto scale      = scale_bias.first;
+  auto bias       = scale_bias.second;
+  if (!scale) {
+    scale = builder->FillConstant({right}, 1.0f, common::UniqName("layer_norm_scale"), dtype);
+  }
+  if (!bias) {
+    bias = builder->FillConstant({right}, 0.0f, common::UniqName("layer_norm_bias"), dtype);
+  }
+  auto outs = builder->LayerNorm(x, *scale, *bias, epsilon, norm_axis);
+  for (size_t i = 0; i < outs.size(); ++i) {
+    context.MapOutToOrigin(outs[i], instr->outputs[i]);
+  }
+}
+
+void rms_norm(const Instruction& instr, const DecomposerContext& context) {
+  CHECK_EQ(instr->inputs.size(), 2UL) << " 2 input tensors for " << instr->op_type;
+  CHECK_EQ(instr->outputs.size(), 1UL) << "1 output tensor for " << instr->op_type;
+  auto x        = instr->inputs[0];
+  auto scale    = instr->inputs[1];
+  auto* builder = context.builder();
+
+  float epsilon = instr.GetAttrs<float>("epsilon");
+  auto rows     = GetNormRows(x->shape, instr.GetAttrs<int>("begin_norm_axis"));
+  int left      = rows.first;
+  int right     = rows.second;
+  auto x_shape  = x->shape;
+  auto x_type   = x->type;
+  if (x_type.is_float16() || x_type.is_bfloat16()) {
+    x = builder->Cast(x, "float32");
+  }
+  if (scale->type.is_float16() || scale->type.is_bfloat16()) {
+    scale = builder->Cast(scale, "float32");
+  }
+
+  // y = x / sqrt(E[|x|^2] + epsilon) * scale
+  std::vector<int> shape{left, right};
+  auto x_reshape = builder->Reshape(x, shape);
+  auto x2_reduce = builder->ReduceSum(builder->Multiply(x_reshape, builder->Identity(x_reshape)), {1});
+  auto ele_num   = builder->FillConstant(
+      {left}, static_cast<float>(right), common::UniqName("rms_norm_ele_num"), common::Type2Str(x->type));
+  auto epsilon_var =
+      builder->FillConstant({left}, epsilon, common::UniqName("rms_norm_epsilon"), common::Type2Str(x->type));
+  auto rms   = builder->Sqrt(builder->Add(builder->Divide(x2_reduce, ele_num), epsilon_var));
+  auto y_out = builder->Divide(x_reshape, builder->BroadcastTo(rms, shape, {0}));
+  y_out      = builder->Multiply(y_out, builder->BroadcastTo(scale, shape, {1}));
+
+  y_out = builder->Reshape(y_out, x_shape);
+  if (x_type.is_float16()) {
+    y_out = builder->Cast(y_out, "float16");
+  } else if (x_type.is_bfloat16()) {
+    y_out = builder->Cast(y_out, "bfloat16");
+  }
+
+  // map the the output of decomposed operator to the original.
+  context.MapOutToOrigin(y_out, instr->outputs[0]);
+}
+
+void rms_norm_host(const Instruction& instr, const DecomposerContext& context) {
+  if (UseHostKernel(instr)) {
+    context.builder()->AppendInstruction(instr);
+    return;
+  }
+  rms_norm(instr, context);
+}
+
+}  // namespace decomposer
+}  // namespace frontend
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(softmax_decomposers) {
+  CINN_DECOMPOSER_REGISTER(softmax, ::cinn::common::DefaultNVGPUTarget(), cinn::frontend::decomposer::softmax);
+  // the host keeps the ops which run the `cinn_call_*_host` kernels if custom call is enabled.
+  CINN_DECOMPOSER_REGISTER(softmax, ::cinn::common::DefaultHostTarget(), cinn::frontend::decomposer::softmax_host);
+
+  return true;
+}
+
+CINN_REGISTER_HELPER(layer_norm_decomposer) {
+  CINN_DECOMPOSER_REGISTER(layer_norm, ::cinn::common::DefaultNVGPUTarget(), cinn::frontend::decomposer::layer_norm);
+  CINN_DECOMPOSER_REGISTER(
+      layer_norm, ::cinn::common::DefaultHostTarget(), cinn::frontend::decomposer::layer_norm_host);
+
+  return true;
+}
+
+CINN_REGISTER_HELPER(rms_norm_decomposer) {
+  CINN_DECOMPOSER_REGISTER(rms_norm, ::cinn::common::DefaultNVGPUTarget(), cinn::frontend::decomposer::rms_norm);
+  CINN_DECOMPOSER_REGISTER(rms_norm, ::cinn::common::DefaultHostTarget(), cinn::frontend::decomposer::rms_norm_host);
+
+  return true;
+}
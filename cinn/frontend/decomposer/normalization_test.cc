@@ -0,0 +1,189 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+
+#include "cinn/frontend/decomposer/test_helper.h"
+
+DECLARE_bool(cinn_use_custom_call);
+
+namespace cinn::frontend {
+
+namespace {
+
+using BuildFunc = std::function<std::vector<Variable>(NetBuilder*)>;
+
+// Run the program built by `build_func` on host and return the outputs. When `use_custom_call` is true the
+// normalization ops are kept and run by the host kernels, otherwise they are decomposed into the primitive ops.
+std::vector<std::vector<float>> RunOnHost(const BuildFunc& build_func,
+                                          const std::vector<std::pair<std::string, std::vector<float>>>& inputs,
+                                          bool use_custom_call,
+                                          int repeat = 10) {
+  bool origin_use_custom_call = FLAGS_cinn_use_custom_call;
+  FLAGS_cinn_use_custom_call  = use_custom_call;
+
+  NetBuilder net_builder("normalization_decomposer");
+  auto outputs = build_func(&net_builder);
+  std::unordered_set<std::string> output_names;
+  for (auto& output : outputs) {
+    output_names.insert(output->id);
+  }
+  auto program = net_builder.Build();
+
+  auto target = common::DefaultHostTarget();
+  RunDecomposer(&program, target);
+
+  auto graph = std::make_shared<hlir::framework::Graph>(program, output_names, target);
+  if (use_custom_call) {
+    hlir::framework::ApplyPass(graph.get(), "TransToCustomCallPass");
+  }
+  hlir::framework::ApplyPass(graph.get(), "OpFusionPass");
+  hlir::framework::ApplyPass(graph.get(), "FusionMergePass");
+
+  auto scope = BuildScope(target, graph);
+  hlir::framework::GraphCompiler gc(target, scope, graph);
+  auto run_program = gc.Build();
+
+  for (auto& input : inputs) {
+    scope->Var<hlir::framework::Tensor>(input.first);
+    CopyFromVector(input.second, scope->GetTensor(input.first), target);
+  }
+  run_program->Execute();
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; ++i) {
+    run_program->Execute();
+  }
+  auto cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeat;
+  LOG(INFO) << (use_custom_call ? "host kernel" : "decomposed") << " path costs " << cost << " ms";
+
+  std::vector<std::vector<float>> results;
+  for (auto& output : outputs) {
+    std::vector<float> vec;
+    CopyToVector(scope->GetTensor(output->id), &vec);
+    results.emplace_back(std::move(vec));
+  }
+  FLAGS_cinn_use_custom_call = origin_use_custom_call;
+  return results;
+}
+
+// Compare the host kernel path against the decomposed path of the same program.
+void CompareWithDecomposed(const BuildFunc& build_func,
+                           const std::vector<std::pair<std::string, std::vector<float>>>& inputs) {
+  auto actual = RunOnHost(build_func, inputs, true);
+  auto expect = RunOnHost(build_func, inputs, false);
+  ASSERT_EQ(actual.size(), expect.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    LOG(INFO) << "Check the " << i << "-th output";
+    CheckOutput<float>(actual[i], expect[i], 1e-4, 1e-3);
+  }
+}
+
+}  // namespace
+
+TEST(Decomposer, layer_norm_decomposer) {
+  int rows = 128, cols = 1024;
+  std::vector<float> x, scale, bias;
+  InitRandomVector<float>(&x, rows * cols, -1.0f, 1.0f, 1e-3);
+  InitRandomVector<float>(&scale, cols, 0.5f, 1.5f, 1e-3);
+  InitRandomVector<float>(&bias, cols, -1.0f, 1.0f, 1e-3);
+
+  CompareWithDecomposed(
+      [&](NetBuilder* builder) {
+        auto x_var     = builder->CreateInput(Float(32), {rows, 8, cols / 8}, "x");
+        auto scale_var = builder->CreateInput(Float(32), {cols}, "scale");
+        auto bias_var  = builder->CreateInput(Float(32), {cols}, "bias");
+        return builder->LayerNorm(x_var, scale_var, bias_var, 1e-5f, 1);
+      },
+      {{"x", x}, {"scale", scale}, {"bias", bias}});
+}
+
+TEST(Decomposer, layer_norm_decomposer_without_scale) {
+  int rows = 64, cols = 256;
+  std::vector<float> x, bias;
+  InitRandomVector<float>(&x, rows * cols, -1.0f, 1.0f, 1e-3);
+  InitRandomVector<float>(&bias, cols, -1.0f, 1.0f, 1e-3);
+
+  // the paddle mapper omits the missing scale, the host path fills it by ones before running the kernel
+  CompareWithDecomposed(
+      [&](NetBuilder* builder) {
+        auto x_var    = builder->CreateInput(Float(32), {rows, cols}, "x");
+        auto bias_var = builder->CreateInput(Float(32), {cols}, "bias");
+        return builder->CustomInstr(
+            "layer_norm",
+            {x_var, bias_var},
+            {{"epsilon", 1e-5f}, {"begin_norm_axis", 1}, {"has_scale", false}, {"has_bias", true}});
+      },
+      {{"x", x}, {"bias", bias}});
+}
+
+TEST(Decomposer, rms_norm_decomposer) {
+  int rows = 128, cols = 1024;
+  std::vector<float> x, scale;
+  InitRandomVector<float>(&x, rows * cols, -1.0f, 1.0f, 1e-3);
+  InitRandomVector<float>(&scale, cols, 0.5f, 1.5f, 1e-3);
+
+  CompareWithDecomposed(
+      [&](NetBuilder* builder) {
+        auto x_var     = builder->CreateInput(Float(32), {rows, cols}, "x");
+        auto scale_var = builder->CreateInput(Float(32), {cols}, "scale");
+        return std::vector<Variable>{builder->RmsNorm(x_var, scale_var, 1e-6f, -1)};
+      },
+      {{"x", x}, {"scale", scale}});
+}
+
+TEST(Decomposer, softmax_decomposer) {
+  std::vector<float> x;
+  InitRandomVector<float>(&x, 64 * 128 * 16, -5.0f, 5.0f, 1e-3);
+
+  for (int axis : {-1, 1}) {
+    CompareWithDecomposed(
+        [&](NetBuilder* builder) {
+          auto x_var = builder->CreateInput(Float(32), {64, 128, 16}, "x");
+          return std::vector<Variable>{builder->Softmax(x_var, {axis})};
+        },
+        {{"x", x}});
+  }
+}
+
+TEST(TransToCustomCallPass, keep_unsupported_softmax) {
+  NetBuilder net_builder("keep_unsupported_softmax");
+  auto x_fp32      = net_builder.CreateInput(Float(32), {64, 128, 16}, "x_fp32");
+  auto x_fp16      = net_builder.CreateInput(Float(16), {64, 128, 16}, "x_fp16");
+  auto single_fp32 = net_builder.Softmax(x_fp32, {-1});
+  auto multi_fp32  = net_builder.Softmax(x_fp32, {1, 2});
+  auto single_fp16 = net_builder.Softmax(x_fp16, {-1});
+  auto program     = net_builder.Build();
+
+  std::unordered_set<std::string> output_names = {single_fp32->id, multi_fp32->id, single_fp16->id};
+  auto graph = std::make_shared<hlir::framework::Graph>(program, output_names, common::DefaultHostTarget());
+  hlir::framework::ApplyPass(graph.get(), "TransToCustomCallPass");
+
+  // only the float32 softmax along a single axis runs the host kernel, the others keep the compute implement
+  std::unordered_map<std::string, int> op_count;
+  auto nodes = graph->CollectNodes(
+      [](const common::GraphNode* node) { return node->safe_as<hlir::framework::Node>() != nullptr; });
+  for (auto* node : nodes) {
+    op_count[node->safe_as<hlir::framework::Node>()->op()->name]++;
+  }
+  ASSERT_EQ(op_count["custom_call"], 1);
+  ASSERT_EQ(op_count["softmax"], 2);
+}
+
+}  // namespace cinn::frontend
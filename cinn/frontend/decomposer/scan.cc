@@ -0,0 +1,112 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <limits>
+
+#include "cinn/frontend/decomposer_registry.h"
+#include "cinn/frontend/syntax.h"
+
+namespace cinn {
+namespace frontend {
+namespace decomposer {
+
+namespace {
+
+// the identity of the scan operator, the same as the initial value of the corresponding reduction
+template <typename T>
+T GetScanInit(const std::string& scan_type) {
+  if (scan_type == "sum") {
+    return T(0);
+  } else if (scan_type == "prod") {
+    return T(1);
+  } else if (scan_type == "max") {
+    return std::numeric_limits<T>::lowest();
+  } else if (scan_type == "min") {
+    return std::numeric_limits<T>::max();
+  }
+  LOG(FATAL) << "Unsupported scan type " << scan_type << ", it should be one of sum, prod, max and min.";
+  return T(0);
+}
+
+Variable FillScanInit(NetBuilder* builder, const std::vector<int>& shape, const std::string& scan_type, Type type) {
+  auto dtype = common::Type2Str(type);
+  if (type.is_float(32)) {
+    return builder->FillConstant<float>(shape, GetScanInit<float>(scan_type), "", dtype);
+  } else if (type.is_float(64)) {
+    return builder->FillConstant<double>(shape, GetScanInit<double>(scan_type), "", dtype);
+  } else if (type.is_int(32)) {
+    return builder->FillConstant<int>(shape, GetScanInit<int>(scan_type), "", dtype);
+  } else if (type.is_int(64)) {
+    return builder->FillConstant<int64_t>(shape, GetScanInit<int64_t>(scan_type), "", dtype);
+  }
+  LOG(FATAL) << "Unsupported data type " << dtype << " of scan.";
+  return Variable();
+}
+
+}  // namespace
+
+// out[..., j, ...] = reduce_i(select(mask[i, j], x[..., i, ...], init)), where mask[i, j] tells whether the element i
+// is accumulated into the element j in the scan order.
+void scan(const Instruction& instr, const DecomposerContext& context) {
+  CHECK_EQ(instr->inputs.size(), 1UL) << " 1 input tensor for " << instr->op_type;
+  CHECK_EQ(instr->outputs.size(), 1UL) << "1 output tensor for " << instr->op_type;
+  auto x      = instr->inputs[0];
+  auto output = instr->outputs[0];
+
+  auto* builder  = context.builder();
+  int axis       = instr.GetAttrs<int>("axis");
+  auto scan_type = instr.GetAttrs<std::string>("scan_type");
+  bool exclusive = instr.GetAttrs<bool>("exclusive");
+  bool reverse   = instr.GetAttrs<bool>("reverse");
+  int ndim       = x->shape.size();
+  if (axis < 0) {
+    axis += ndim;
+  }
+
+  // mask is [axis_size, axis_size, 1, ...], the input is expanded to [..., axis_size, 1, ...] and both are broadcast
+  // to [..., axis_size, axis_size, ...], then the axis i is reduced
+  auto rg     = builder->Arange(0.0f, static_cast<float>(x->shape[axis]), 1.0f, "int32");
+  auto rg_col = builder->ExpandDims(rg, {1});
+  Variable mask;
+  if (reverse) {
+    mask = exclusive ? builder->GreaterThan(rg_col, rg) : builder->GreaterEqual(rg_col, rg);
+  } else {
+    mask = exclusive ? builder->LessThan(rg_col, rg) : builder->LessEqual(rg_col, rg);
+  }
+  for (int i = 0; i < ndim - axis - 1; i++) {
+    mask = builder->ExpandDims(mask, {-1});
+  }
+  auto expand_x = builder->ExpandDims(x, {axis + 1});
+
+  std::vector<int> broadcast_shape(expand_x->shape);
+  broadcast_shape[axis + 1] = x->shape[axis];
+  mask                      = builder->BroadcastTo(mask, broadcast_shape);
+  expand_x                  = builder->BroadcastTo(expand_x, broadcast_shape);
+  auto init                 = FillScanInit(builder, broadcast_shape, scan_type, x->type);
+  auto selected_x           = builder->Select(mask, expand_x, init);
+  auto out                  = builder->Reduce("reduce_" + scan_type, selected_x, {axis});
+
+  // map the the output of decomposed operator to the original.
+  context.MapOutToOrigin(out, output);
+}
+
+}  // namespace decomposer
+}  // namespace frontend
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(scan_decomposer) {
+  // the host keeps scan, which runs the `cinn_call_scan_host` kernel in linear time.
+  CINN_DECOMPOSER_REGISTER(scan, ::cinn::common::DefaultNVGPUTarget(), cinn::frontend::decomposer::scan);
+  return true;
+}
@@ -49,6 +49,7 @@ void top_k(const Instruction& instr, const DecomposerContext& context) {
 }  // namespace cinn
 
 CINN_REGISTER_HELPER(top_k_decomposer) {
-  CINN_DECOMPOSER_REGISTER(top_k, cinn::frontend::decomposer::top_k);
+  // the host keeps top_k, which is selected by the `cinn_call_top_k_host` kernel instead of a full sort.
+  CINN_DECOMPOSER_REGISTER(top_k, ::cinn::common::DefaultNVGPUTarget(), cinn::frontend::decomposer::top_k);
   return true;
 }
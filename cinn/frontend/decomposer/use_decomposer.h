@@ -26,3 +26,6 @@ CINN_USE_REGISTER(batch_norm_decomposer)
 CINN_USE_REGISTER(batch_norm_train_decomposer)
 CINN_USE_REGISTER(batch_norm_grad_decomposer)
 CINN_USE_REGISTER(top_k_decomposer)
+CINN_USE_REGISTER(scan_decomposer)
+CINN_USE_REGISTER(layer_norm_decomposer)
+CINN_USE_REGISTER(rms_norm_decomposer)
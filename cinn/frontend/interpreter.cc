@@ -15,6 +15,7 @@
 #include "cinn/frontend/interpreter.h"
 
 #include "cinn/auto_schedule/auto_tuner.h"
+#include "cinn/auto_schedule/schedule_replayer.h"
 #include "cinn/auto_schedule/tuning.h"
 #include "cinn/frontend/optimize.h"
 #include "cinn/frontend/syntax.h"
@@ -25,6 +26,7 @@
 #include "cinn/runtime/flags.h"
 
 DECLARE_bool(enable_auto_tuner);
+DECLARE_string(cinn_tuning_record_file);
 
 namespace cinn::frontend {
 
@@ -47,6 +49,8 @@ struct Interpreter::Impl {
   std::vector<hlir::framework::shape_t> input_shapes_;
 
   std::shared_ptr<hlir::framework::Scope> scope_;
+  // the parameters loaded from the model, which are the only variables in the scope before building
+  std::unordered_set<std::string> param_names_;
   std::unique_ptr<frontend::Program> program_;
   std::unique_ptr<hlir::framework::GraphCompiler> graph_compiler_;
 
@@ -76,6 +80,9 @@ void Interpreter::LoadPaddleModel(const std::string& model_dir,
   impl_->var_map_                = var_map;
   impl_->var_map_paddle_to_cinn_ = var_map_paddle_to_program;
   impl_->fetch_names_            = fetch_names;
+  for (auto& name : impl_->scope_->var_names()) {
+    impl_->param_names_.emplace(name);
+  }
 
   impl_->Build(target, model_name);
 }
@@ -108,7 +115,10 @@ void Interpreter::Impl::Build(const Target& target, const std::string& model_nam
     fetch_var_ids.insert(var_map_.at(name)->id);
   }
 
-  auto graph = Optimize(program_.get(), fetch_var_ids, target);
+  auto options        = DefaultTrainingOptimizeOptions();
+  options.param_scope = scope_;
+  options.param_names = param_names_;
+  auto graph          = Optimize(program_.get(), fetch_var_ids, target, options);
   // auto graph                 = std::make_shared<hlir::framework::Graph>(*program_, target);
   graph->attrs["model_name"] = std::make_shared<absl::any>(model_name);
   scope_                     = hlir::framework::BuildScope(target, graph, scope_);
@@ -123,6 +133,14 @@ void Interpreter::Impl::Build(const Target& target, const std::string& model_nam
     auto_schedule::TuningOptions tuning_options;
     auto_schedule::TuningResult tuning_result = auto_tuner.Tune(tuning_options);
     options.Apply(tuning_result);
+  } else if (!FLAGS_cinn_tuning_record_file.empty()) {
+    VLOG(4) << "Compile with the schedules replayed from " << FLAGS_cinn_tuning_record_file;
+    auto_schedule::DatabaseConfig database_config;
+    database_config.type             = auto_schedule::DatabaseType::kJSONFile;
+    database_config.record_file_path = FLAGS_cinn_tuning_record_file;
+    auto_schedule::ScheduleReplayer replayer(target, graph.get());
+    options.Apply(replayer.Replay(database_config));
+    VLOG(3) << replayer.GetReport().DebugString();
   }
   runtime_program_ = graph_compiler_->Build(options, std::move(fetch_var_ids)).runtime_program;
   runtime_program_->PreRun();
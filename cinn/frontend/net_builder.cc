@@ -239,6 +239,20 @@ Placeholder NetBuilder::CreateInput(const Type& type, const std::vector<int>& sh
   return Placeholder(var);
 }
 
+Placeholder NetBuilder::CreateInput(const Type& type,
+                                    const std::vector<int>& shape,
+                                    const std::map<int, std::string>& symbolic_dims,
+                                    const std::string& id_hint) {
+  auto input = CreateInput(type, shape, id_hint);
+  for (auto& dim : symbolic_dims) {
+    CHECK(dim.first >= 0 && dim.first < shape.size())
+        << "The symbolic axis " << dim.first << " of input " << input.id() << " is out of range.";
+    CheckVarNameValid(dim.second);
+  }
+  inputs_.back()->symbolic_dims = symbolic_dims;
+  return input;
+}
+
 Placeholder NetBuilder::CreateInput(const Variable& var) {
   VLOG_IF(4, var->shape.empty()) << "The input's shape is empty, Create 0D-Tensor for " << var->id;
   CHECK(!var->type.is_unk()) << "The input's type is not set yet";
@@ -444,6 +458,38 @@ Variable NetBuilder::BitcastConvert(const Variable& operand, const std::string&
   return CustomInstr("bitcast_convert", {operand}, {{"dtype", dtype}, {"input_data_type", input_data_type}}).front();
 }
 
+Variable NetBuilder::Quantize(const Variable& x, float scale, int zero_point, const std::string& dtype) {
+  return CustomInstr("quantize", {x}, {{"scale", scale}, {"zero_point", zero_point}, {"dtype", dtype}}).front();
+}
+
+Variable NetBuilder::Dequantize(const Variable& x, float scale, int zero_point, const std::string& dtype) {
+  return CustomInstr("dequantize", {x}, {{"scale", scale}, {"zero_point", zero_point}, {"dtype", dtype}}).front();
+}
+
+Variable NetBuilder::Requantize(
+    const Variable& x, float input_scale, float output_scale, int zero_point, const std::string& dtype) {
+  return CustomInstr("requantize",
+                     {x},
+                     {{"input_scale", input_scale},
+                      {"output_scale", output_scale},
+                      {"zero_point", zero_point},
+                      {"dtype", dtype}})
+      .front();
+}
+
+Variable NetBuilder::MatmulInt8(const Variable& x, const Variable& y, bool trans_y) {
+  return CustomInstr("matmul_int8", {x, y}, {{"trans_b", trans_y}}).front();
+}
+
+Variable NetBuilder::Conv2dInt8(const Variable& x,
+                                const Variable& weights,
+                                const std::vector<int>& strides,
+                                const std::vector<int>& paddings,
+                                const std::vector<int>& dilations) {
+  return CustomInstr("conv2d_int8", {x, weights}, {{"stride", strides}, {"padding", paddings}, {"dilation", dilations}})
+      .front();
+}
+
 Variable NetBuilder::OneHot(const Variable& indices,
                             const Variable& on_value,
                             const Variable& off_value,
@@ -493,6 +539,20 @@ Variable NetBuilder::Sort(const Variable& operand, const int& axis, const bool&
   return CustomInstr("sort", {operand}, {{"axis", axis}, {"is_ascend", is_ascend}}).front();
 }
 
+Variable NetBuilder::Scan(const Variable& x, int axis, const std::string& scan_type, bool exclusive, bool reverse) {
+  return CustomInstr(
+             "scan", {x}, {{"axis", axis}, {"scan_type", scan_type}, {"exclusive", exclusive}, {"reverse", reverse}})
+      .front();
+}
+
+Variable NetBuilder::Cumsum(const Variable& x, int axis, bool exclusive, bool reverse) {
+  return Scan(x, axis, "sum", exclusive, reverse);
+}
+
+Variable NetBuilder::Cumprod(const Variable& x, int axis, bool exclusive, bool reverse) {
+  return Scan(x, axis, "prod", exclusive, reverse);
+}
+
 Variable NetBuilder::Argmax(const Variable& x, const int& axis, const bool& keep_dim) {
   return CustomInstr("argmax", {x}, {{"axis", axis}, {"keep_dim", keep_dim}}).front();
 }
@@ -800,6 +860,15 @@ Variable NetBuilder::Softmax(const Variable& a,
   return CustomInstr("softmax", {a}, {{"axes", axes}, {"mode", mode}, {"data_format", data_format}}).front();
 }
 
+std::vector<Variable> NetBuilder::LayerNorm(
+    const Variable& x, const Variable& scale, const Variable& bias, float epsilon, int begin_norm_axis) {
+  return CustomInstr("layer_norm", {x, scale, bias}, {{"epsilon", epsilon}, {"begin_norm_axis", begin_norm_axis}});
+}
+
+Variable NetBuilder::RmsNorm(const Variable& x, const Variable& scale, float epsilon, int begin_norm_axis) {
+  return CustomInstr("rms_norm", {x, scale}, {{"epsilon", epsilon}, {"begin_norm_axis", begin_norm_axis}}).front();
+}
+
 Variable NetBuilder::DropoutInfer(const Variable& a, float dropout_prob, const std::string& dropout_implementation) {
   return CustomInstr(
              "dropout_infer", {a}, {{"dropout_prob", dropout_prob}, {"dropout_implementation", dropout_implementation}})
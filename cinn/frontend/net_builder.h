@@ -17,6 +17,7 @@
 #include <glog/logging.h>
 
 #include <cstdint>
+#include <map>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -349,6 +350,20 @@ class NetBuilder {
                           const cinn::utils::ShapeType& shape,
                           const std::string& id_hint = "");
 
+  /**
+   * @brief Create new input with symbolic dims, such as a dynamic batch axis, so that the compiled program serves all
+   * the sizes of these dims. The inputs sharing a symbol should have the same size at runtime.
+   * @param type The input variable's data type.
+   * @param shape The input variable's shape, the extents of the symbolic dims are their upper bounds.
+   * @param symbolic_dims The symbolic axes and their symbol names.
+   * @param id_hint The input variable's name. Default is None.
+   * @return The new input.
+   */
+  Placeholder CreateInput(const common::Type& type,
+                          const cinn::utils::ShapeType& shape,
+                          const std::map<int, std::string>& symbolic_dims,
+                          const std::string& id_hint = "");
+
   /**
    * @brief Create constant tensor with the specific value/vector and type
    * @param value The constant value to be set.
@@ -784,6 +799,33 @@ class NetBuilder {
                    const std::string& mode        = "fast",
                    const std::string& data_format = "AnyLayout");
 
+  /**
+   * @brief Layer normalization over the axes from begin_norm_axis, x is viewed as [rows, cols], and
+   * `y = (x - mean) / sqrt(variance + epsilon) * scale + bias` is computed for every row.
+   * @param x An N-D variable.
+   * @param scale A 1-D variable of size cols.
+   * @param bias A 1-D variable of size cols.
+   * @param epsilon The small value added to the variance to prevent division by zero. Default: 1e-5f.
+   * @param begin_norm_axis The first axis to be normalized, negative for counting from the last axis. Default: 1.
+   * @return `{y, mean, variance}`, mean and variance are 1-D variables of size rows.
+   */
+  std::vector<Variable> LayerNorm(const Variable& x,
+                                  const Variable& scale,
+                                  const Variable& bias,
+                                  float epsilon       = 1e-5f,
+                                  int begin_norm_axis = 1);
+
+  /**
+   * @brief Root mean square normalization over the axes from begin_norm_axis, x is viewed as [rows, cols], and
+   * `y = x / sqrt(mean(x^2) + epsilon) * scale` is computed for every row.
+   * @param x An N-D variable.
+   * @param scale A 1-D variable of size cols.
+   * @param epsilon The small value added to the mean square to prevent division by zero. Default: 1e-6f.
+   * @param begin_norm_axis The first axis to be normalized, negative for counting from the last axis. Default: -1.
+   * @return Output of rms_norm. The data type and shape are the same as input.
+   */
+  Variable RmsNorm(const Variable& x, const Variable& scale, float epsilon = 1e-6f, int begin_norm_axis = -1);
+
   // *******************************************
   // Type converter Operator
   /**
@@ -809,6 +851,66 @@ class NetBuilder {
    */
   Variable BitcastConvert(const Variable& x, const std::string& dtype);
 
+  /**
+   * @brief Quantize the float variable `x` into low precision integers: out = clamp(round(x / scale) + zero_point).
+   * @param x An input N-D float variable.
+   * @param scale The quantization step of the whole tensor.
+   * @param zero_point The integer value which the float 0 is mapped to. Default: 0.
+   * @param dtype Data type of the output, "int8" or "uint8". Default: "int8".
+   * @return A quantized variable with the same shape as input's.
+   */
+  Variable Quantize(const Variable& x, float scale, int zero_point = 0, const std::string& dtype = "int8");
+
+  /**
+   * @brief Map the integer variable `x` back to float: out = (x - zero_point) * scale.
+   * @param x An input N-D integer variable.
+   * @param scale The quantization step of the whole tensor.
+   * @param zero_point The integer value which the float 0 is mapped to. Default: 0.
+   * @param dtype Data type of the output. Default: "float32".
+   * @return A dequantized variable with the same shape as input's.
+   */
+  Variable Dequantize(const Variable& x, float scale, int zero_point = 0, const std::string& dtype = "float32");
+
+  /**
+   * @brief Rescale the int32 accumulator `x` whose scale is `input_scale` into low precision integers whose scale is
+   * `output_scale`.
+   * @param x An input N-D int32 variable.
+   * @param input_scale The scale of `x`.
+   * @param output_scale The scale of the output.
+   * @param zero_point The zero point of the output. Default: 0.
+   * @param dtype Data type of the output, "int8" or "uint8". Default: "int8".
+   * @return A requantized variable with the same shape as input's.
+   */
+  Variable Requantize(const Variable& x,
+                      float input_scale,
+                      float output_scale,
+                      int zero_point           = 0,
+                      const std::string& dtype = "int8");
+
+  /**
+   * @brief Multiply two int8 matrices and accumulate into int32.
+   * @param x The int8 variable of shape [M, K].
+   * @param y The int8 variable of shape [K, N], or [N, K] if `trans_y` is true.
+   * @param trans_y Whether to transpose `y` before multiplication. Default: false.
+   * @return The int32 variable of shape [M, N].
+   */
+  Variable MatmulInt8(const Variable& x, const Variable& y, bool trans_y = false);
+
+  /**
+   * @brief Compute the int8 NCHW convolution-2d with groups = 1 and accumulate into int32.
+   * @param x The int8 image variable.
+   * @param weights The int8 filter variable.
+   * @param strides The stride size, (stride_H, stride_W). Default: {1, 1}.
+   * @param paddings The padding size, (padding_H, padding_W). Default: {0, 0}.
+   * @param dilations The dilation size, (dilation_H, dilation_W). Default: {1, 1}.
+   * @return The int32 convolution-2d result variable.
+   */
+  Variable Conv2dInt8(const Variable& x,
+                      const Variable& weights,
+                      const std::vector<int>& strides   = {1, 1},
+                      const std::vector<int>& paddings  = {0, 0},
+                      const std::vector<int>& dilations = {1, 1});
+
   /**
    *  @brief Returns a one-hot tensor where the locations repsented by indices take value `on_value`,
    *  other locations take value `off_value`.
@@ -1045,6 +1147,32 @@ class NetBuilder {
    */
   Variable Sort(const Variable& operand, const int& axis, const bool& is_ascend = true);
 
+  /**
+   * @brief Cumulative sum/prod/max/min of Variable x along the given axis.
+   * @param x The input variable.
+   * @param axis Specify the axis to scan along.
+   * @param scan_type The binary operator of the scan, one of "sum", "prod", "max" and "min".
+   * @param exclusive Whether the element itself is excluded, the first element of the result is the identity of the
+   * operator, e.g. 0 for sum.
+   * @param reverse Whether scan from the last element of the axis.
+   * @return `Scanned variable`.
+   */
+  Variable Scan(const Variable& x,
+                int axis,
+                const std::string& scan_type = "sum",
+                bool exclusive               = false,
+                bool reverse                 = false);
+
+  /**
+   * @brief Cumulative sum of Variable x along the given axis, see `Scan`.
+   */
+  Variable Cumsum(const Variable& x, int axis, bool exclusive = false, bool reverse = false);
+
+  /**
+   * @brief Cumulative product of Variable x along the given axis, see `Scan`.
+   */
+  Variable Cumprod(const Variable& x, int axis, bool exclusive = false, bool reverse = false);
+
   /**
    * @brief Lookup embeddings vector of ids provided by x .
    * @param table A variable with shape of lookup table parameter
@@ -14,9 +14,11 @@
 
 #include "cinn/frontend/net_builder.h"
 
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <random>
 #include <vector>
@@ -29,6 +31,9 @@
 #include "cinn/hlir/framework/tensor.h"
 #include "cinn/hlir/op/use_ops.h"
 #include "cinn/utils/data_util.h"
+
+DECLARE_bool(cinn_use_custom_call);
+
 #ifdef CINN_WITH_CUDA
 #include <cuda_runtime.h>
 #endif
@@ -902,6 +907,50 @@ TEST(net_build, program_execute_sort) {
   }
 }
 
+// the host sort kernels are called by the x86 strategy even if custom call is disabled
+TEST(net_build, program_execute_top_k_without_custom_call) {
+  const int B = 16;
+  const int H = 512;
+  const int K = 8;
+
+  NetBuilder builder("net_builder");
+  Placeholder input = builder.CreateInput(Float(32), {B, H}, "In");
+  auto outputs      = builder.TopK(input, K, -1, true);
+  auto program      = builder.Build();
+
+  bool use_custom_call       = FLAGS_cinn_use_custom_call;
+  FLAGS_cinn_use_custom_call = false;
+  Target target              = common::DefaultHostTarget();
+  std::unordered_set<std::string> fetch_ids;
+  auto graph                 = Optimize(&program, fetch_ids, target);
+  FLAGS_cinn_use_custom_call = use_custom_call;
+
+  auto scope = BuildScope(target, graph);
+  hlir::framework::GraphCompiler gc(target, scope, graph);
+  auto runtime_program = gc.Build();
+
+  scope->Var<hlir::framework::Tensor>(std::string(input.id()));
+  auto input_tensor = scope->GetTensor(std::string(input.id()));
+  SetRandData<float>(input_tensor, target);
+  std::vector<float> input_data = GetTensorData<float>(input_tensor, target);
+
+  runtime_program->Execute();
+
+  auto value_tensor = scope->GetTensor(std::string(outputs[0]->id));
+  auto index_tensor = scope->GetTensor(std::string(outputs[1]->id));
+  EXPECT_EQ(value_tensor->shape().data(), std::vector<int>({B, K}));
+  std::vector<float> value_data = GetTensorData<float>(value_tensor, target);
+  const int64_t* index_data     = index_tensor->data<int64_t>();
+  for (int b = 0; b < B; ++b) {
+    std::vector<float> row(input_data.begin() + b * H, input_data.begin() + (b + 1) * H);
+    std::stable_sort(row.begin(), row.end(), std::greater<float>());
+    for (int k = 0; k < K; ++k) {
+      EXPECT_EQ(value_data[b * K + k], row[k]);
+      EXPECT_EQ(input_data[b * H + index_data[b * K + k]], row[k]);
+    }
+  }
+}
+
 TEST(net_build, program_execute_arange_float) {
   const float start       = 1.5F;
   const float stop        = 31.5F;
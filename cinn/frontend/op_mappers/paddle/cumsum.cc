@@ -46,42 +46,7 @@ void CumsumOpMapper(const paddle::cpp::OpDesc& op_desc, const OpMapperContext& c
   if (axis < 0) {
     axis = ndim + axis;
   }
-  x       = ctx.Builder()->ExpandDims(x, {axis + 1});
-  auto rg = ctx.Builder()->Arange(0.0f, static_cast<float>(x->shape[axis]), 1.0f, "int32");
-  cinn::frontend::Variable mask;
-  if (reverse) {
-    mask = ctx.Builder()->GreaterEqual(ctx.Builder()->ExpandDims(rg, {1}), rg);
-  } else {
-    mask = ctx.Builder()->LessEqual(ctx.Builder()->ExpandDims(rg, {1}), rg);
-  }
-  for (int i = 0; i < ndim - axis - 1; i++) {
-    mask = ctx.Builder()->ExpandDims(mask, {-1});
-  }
-  // Infer broadcast shape for x and mask
-  int x_ndim    = x->shape.size();
-  int mask_ndim = mask->shape.size();
-  std::vector<int> broadcast_shape(std::max(x_ndim, mask_ndim), 0);
-  int broadcast_shape_size = broadcast_shape.size();
-  for (int i = broadcast_shape.size() - 1; i >= 0; --i) {
-    if (i - (broadcast_shape_size - x_ndim) >= 0) {
-      broadcast_shape[i] = std::max(broadcast_shape[i], x->shape[i - (broadcast_shape_size - x_ndim)]);
-    }
-    if (i - (broadcast_shape_size - mask_ndim) >= 0) {
-      broadcast_shape[i] = std::max(broadcast_shape[i], mask->shape[i - (broadcast_shape_size - mask_ndim)]);
-    }
-  }
-  // Do broadcast shape on mask, x and false_value
-  mask             = ctx.Builder()->BroadcastTo(mask, broadcast_shape);
-  x                = ctx.Builder()->BroadcastTo(x, broadcast_shape);
-  auto false_value = ctx.Builder()->FillConstant(x->shape, 0, UniqName("false_value"), common::Type2Str(x->type));
-  // Select elements with mask
-  auto selected_x = ctx.Builder()->Select(mask, x, false_value);
-  // Do reduce sum
-  auto output = ctx.Builder()->ReduceSum(selected_x, {axis});
-  // Exclusive
-  if (exclusive) {
-    output = ctx.Builder()->Subtract(output, input);
-  }
+  auto output = ctx.Builder()->Cumsum(x, axis, exclusive, reverse);
   ctx.AddVar(out_name, output);
   ctx.AddVarModelToProgram(out_name, output->id);
 }
@@ -15,6 +15,7 @@
 #include <absl/types/optional.h>
 
 #include <string>
+#include <vector>
 
 #include "cinn/common/context.h"
 #include "cinn/frontend/op_mapper_registry.h"
@@ -59,83 +60,33 @@ void LayerNormOpMapper(const paddle::cpp::OpDesc& op_desc, const OpMapperContext
     bias = ctx.GetVar(*bias_name);
   }
 
-  VLOG(4) << "layer_norm X=" << x_name << "[" << x << "], Scale=" << scale_name.value() << "[" << scale.value()
-          << "], Bias=" << bias_name.value() << "[" << bias.value() << "], epsilon=" << epsilon
+  VLOG(4) << "layer_norm X=" << x_name << "[" << x << "], Scale=" << scale_name.value_or("None")
+          << ", Bias=" << bias_name.value_or("None") << ", epsilon=" << epsilon
           << ", begin_norm_axis=" << begin_norm_axis;
 
   const auto& x_shape = x->shape;
   auto x_ndim         = x_shape.size();
   CHECK_LT(begin_norm_axis, x_ndim) << "`begin_norm_axis` must be less than the dimensions of X, but received "
                                     << begin_norm_axis;
-  VLOG(4) << "-- [layer_norm] begin_norm_axis = " << begin_norm_axis;
-  int left = 1;
-  for (int i = 0; i < begin_norm_axis; i++) {
-    left *= x_shape[i];
-  }
-  int right = 1;
-  for (int i = begin_norm_axis; i < x_ndim; i++) {
-    right *= x_shape[i];
-  }
-  VLOG(4) << "-- [layer_norm] left = " << left << ", right = " << right;
-
-  // compute mean
-  auto* builder = ctx.Builder();
-
-  const auto& x_type = x->type;
-  if (x_type.is_float16() || x_type.is_bfloat16()) {
-    x = builder->Cast(x, "float32");
-  }
-
-  std::vector<int> shape{left, right};
-  auto x_reshape = builder->Reshape(x, shape);
-  auto x_reduce  = builder->ReduceSum(x_reshape, {1});
-  auto ele_num   = builder->FillConstant(
-      {left}, static_cast<float>(right), common::UniqName("layer_norm_ele_num"), common::Type2Str(x->type));
-  auto x_mean = builder->Divide(x_reduce, ele_num);
 
-  // use `E[|x|^2] - |E[x]|^2` instead of `E[|x - E[x]|^2])` to compute variance
-  auto x2        = builder->Multiply(x_reshape, builder->Identity(x_reshape));
-  auto x2_reduce = builder->ReduceSum(x2, {1});
-  auto x2_mean   = builder->Divide(x2_reduce, ele_num);
-  auto x_mean2   = builder->Multiply(x_mean, builder->Identity(x_mean));
-  auto zero      = builder->FillConstant({left}, 0.f, common::UniqName("layer_norm_zero"), common::Type2Str(x->type));
-  auto x_var     = builder->Max(builder->Subtract(x2_mean, x_mean2), zero);
-
-  // compute x norm
-  auto x_mean_broadcast = builder->BroadcastTo(x_mean, shape, {0});
-  auto y_sub            = builder->Subtract(x_reshape, x_mean_broadcast);
-  auto epsilon_var =
-      builder->FillConstant({left}, epsilon, common::UniqName("layer_norm_epsilon"), common::Type2Str(x->type));
-  auto x_var_eps  = builder->Add(x_var, epsilon_var);
-  auto x_var_sqrt = builder->Sqrt(x_var_eps);
-  auto y_out      = builder->Divide(y_sub, builder->BroadcastTo(x_var_sqrt, shape, {0}));
-
-  // multiply scale
+  // the missing scale and bias are recorded by the attributes, only the host kernel needs their identities
+  std::vector<Variable> inputs{x};
   if (scale) {
-    if (scale.value()->type.is_float16() || scale.value()->type.is_bfloat16()) {
-      scale = ctx.Builder()->Cast(scale.value(), "float32");
-    }
-    auto scale_broadcast = builder->BroadcastTo(*scale, shape, {1});
-    y_out                = builder->Multiply(y_out, scale_broadcast);
+    inputs.push_back(*scale);
   }
-
-  // add bias
   if (bias) {
-    if (bias.value()->type.is_float16() || bias.value()->type.is_bfloat16()) {
-      bias = ctx.Builder()->Cast(bias.value(), "float32");
-    }
-    auto bias_broadcast = builder->BroadcastTo(*bias, shape, {1});
-    y_out               = builder->Add(y_out, bias_broadcast);
-  }
-
-  // reshape to the original shape
-  y_out = builder->Reshape(y_out, x_shape);
-
-  if (x_type.is_float16()) {
-    y_out = builder->Cast(y_out, "float16");
-  } else if (x_type.is_bfloat16()) {
-    y_out = builder->Cast(y_out, "bfloat16");
+    inputs.push_back(*bias);
   }
+  // decomposed into primitive ops by the layer_norm decomposer except on the host, which runs a one-pass kernel
+  auto outs = ctx.Builder()->CustomInstr("layer_norm",
+                                         inputs,
+                                         {{"epsilon", epsilon},
+                                          {"begin_norm_axis", begin_norm_axis},
+                                          {"has_scale", scale.has_value()},
+                                          {"has_bias", bias.has_value()}});
+  auto y_out  = outs[0];
+  auto x_mean = outs[1];
+  auto x_var  = outs[2];
 
   // get output names
   auto y_name        = get_output("Y");
@@ -30,12 +30,14 @@
 #include "cinn/runtime/flags.h"
 
 DECLARE_bool(cinn_use_fill_constant_folding);
+DECLARE_bool(cinn_use_param_folding);
 DECLARE_bool(cinn_use_op_fusion);
 DECLARE_bool(cinn_use_common_subexpression_elimination);
 DECLARE_string(cinn_check_fusion_accuracy_pass);
 DECLARE_bool(cinn_use_custom_call);
 DECLARE_bool(use_reduce_split_pass);
 DECLARE_bool(cinn_use_dense_merge_pass);
+DECLARE_bool(cinn_use_horizontal_packing);
 DECLARE_string(cinn_custom_call_deny_ops);
 
 namespace cinn {
@@ -47,6 +49,7 @@ OptimizeOptions DefaultTrainingOptimizeOptions() {
   options.program_passes.emplace_back("AutoCast");
   options.program_passes.emplace_back("Decomposer");
   options.program_passes.emplace_back("RemoveIdentity");
+  options.program_passes.emplace_back("QuantizeFolding");
 
   options.program_passes.emplace_back("CastCollapsing");
   options.program_passes.emplace_back("TransposeCollapsing");
@@ -76,6 +79,9 @@ OptimizeOptions DefaultTrainingOptimizeOptions() {
   options.program_passes.emplace_back("DeadCodeEliminate");
 
   options.graph_passes = {"ConstantFolding"};
+  if (FLAGS_cinn_use_param_folding) {
+    options.graph_passes.push_back("ParamFolding");
+  }
   if (FLAGS_cinn_use_dense_merge_pass) {
     options.graph_passes.push_back("DenseMergePass");
   }
@@ -96,6 +102,9 @@ OptimizeOptions DefaultTrainingOptimizeOptions() {
   if (FLAGS_cinn_use_op_fusion) {
     options.graph_passes.emplace_back("OpFusionPass");
     options.graph_passes.emplace_back("FusionMergePass");
+    if (FLAGS_cinn_use_horizontal_packing) {
+      options.graph_passes.emplace_back("HorizontalPackingPass");
+    }
   } else {
     options.graph_passes.emplace_back("BuildNonFusedGroupsPass");
   }
@@ -132,6 +141,10 @@ std::shared_ptr<hlir::framework::Graph> Optimize(frontend::Program* program,
   frontend::ProgramPass::Apply(program, fetch_ids, target, options.program_passes);
   // Apply graph passes
   auto graph = std::make_shared<hlir::framework::Graph>(*program, fetch_ids, target);
+  if (options.param_scope) {
+    graph->attrs["param_scope"] = std::make_shared<absl::any>(options.param_scope);
+    graph->attrs["param_names"] = std::make_shared<absl::any>(options.param_names);
+  }
 
   VLOG(3) << "Before hlir::framework::ApplyPasses";
   hlir::framework::ApplyPasses(graph.get(), options.graph_passes);
@@ -22,6 +22,7 @@
 #include "cinn/common/target.h"
 #include "cinn/frontend/syntax.h"
 #include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/scope.h"
 
 namespace cinn {
 namespace frontend {
@@ -29,6 +30,10 @@ namespace frontend {
 struct OptimizeOptions {
   std::vector<std::string> program_passes;
   std::vector<std::string> graph_passes;
+  // the scope holding the loaded parameters, the ParamFolding pass evaluates the subgraphs depending only on them
+  std::shared_ptr<hlir::framework::Scope> param_scope;
+  // the names of the parameters in `param_scope`, the other variables of the scope are not folded
+  std::unordered_set<std::string> param_names;
 };
 
 OptimizeOptions DefaultTrainingOptimizeOptions();
@@ -14,7 +14,16 @@
 
 #include "cinn/frontend/paddle/model_parser.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <fstream>
+#include <utility>
 #include <vector>
 
 #include "cinn/backends/codegen_cuda_dev.h"
@@ -23,6 +32,7 @@
 #include "cinn/backends/cuda_util.h"
 #include "cinn/common/common.h"
 #include "cinn/frontend/paddle/compatible_pb.h"
+#include "cinn/utils/multi_threading.h"
 
 namespace cinn::frontend::paddle {
 
@@ -47,6 +57,152 @@ int SizeOfType(framework_proto::VarType::Type type) {
   return -1;
 }
 
+namespace {
+
+// A whole file mapped into memory. The mapping is private, so the tensors sharing the memory can be written without
+// touching the file.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    CHECK_NE(fd, -1) << "Cannot open file: " << path << ", " << std::strerror(errno);
+    struct stat file_stat;
+    CHECK_EQ(fstat(fd, &file_stat), 0) << "Cannot stat file: " << path << ", " << std::strerror(errno);
+    size_ = file_stat.st_size;
+    if (size_ > 0) {
+      void *addr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      CHECK(addr != MAP_FAILED) << "Cannot map file: " << path << ", " << std::strerror(errno);
+      // the parameters are parsed from the beginning to the end
+      madvise(addr, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<char *>(addr);
+    }
+    close(fd);
+  }
+
+  ~MappedFile() {
+    if (data_) munmap(data_, size_);
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  char *data_{};
+  size_t size_{};
+};
+
+// Reads the serialized values from a piece of memory in place. If the memory is kept alive by `holder`, the host
+// tensors may share it instead of copying.
+class MemoryReader {
+ public:
+  MemoryReader(char *data, size_t size, std::shared_ptr<void> holder)
+      : data_(data), size_(size), holder_(std::move(holder)) {}
+
+  // Return the address of the next `bytes` bytes and skip over them.
+  char *Skip(size_t bytes) {
+    CHECK_LE(bytes, size_ - offset_) << "There is a problem with loading model parameters: cannot read " << bytes
+                                     << " bytes at offset " << offset_ << " of " << size_ << " bytes";
+    char *ptr = data_ + offset_;
+    offset_ += bytes;
+    return ptr;
+  }
+
+  template <typename T>
+  T Read() {
+    T value;
+    std::memcpy(&value, Skip(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  bool eof() const { return offset_ == size_; }
+  const std::shared_ptr<void> &holder() const { return holder_; }
+
+ private:
+  char *data_;
+  size_t size_;
+  size_t offset_{0};
+  std::shared_ptr<void> holder_;
+};
+
+common::Type TensorTypeOf(framework_proto::VarType::Type type) {
+  using Type = framework_proto::VarType::Type;
+  switch (static_cast<int>(type)) {
+#define DO(desc, precision)       \
+  case Type::VarType_Type_##desc: \
+    return precision;
+    DO(FP32, Float(32));
+    DO(INT8, Int(8));
+    DO(INT16, Int(16));
+    DO(INT32, Int(32));
+    DO(INT64, Int(64));
+#undef DO
+    default:
+      LOG(FATAL) << "unknown type " << type;
+  }
+  return common::Type();
+}
+
+void TensorFromMemory(MemoryReader *reader, hlir::framework::_Tensor_ *tensor, const common::Target &target) {
+  auto version = reader->Read<uint32_t>();
+  CHECK_EQ(version, 0U) << "Only version 0 is supported";
+  // parse the tensor desc in place
+  framework_proto::VarType::TensorDesc desc;
+  auto desc_size = reader->Read<int32_t>();
+  CHECK_GE(desc_size, 0) << "Invalid size of tensor desc";
+  CHECK(desc.ParseFromArray(reader->Skip(desc_size), desc_size)) << "Cannot parse tensor desc";
+
+  std::vector<int32_t> dims_vec;
+  std::copy(desc.dims().begin(), desc.dims().end(), std::back_inserter(dims_vec));
+  hlir::framework::Shape dims(dims_vec);
+  tensor->Resize(dims);
+  size_t size = tensor->shape().numel() * SizeOfType(desc.data_type());
+  char *src   = reader->Skip(size);
+  if (target.arch == Target::Arch::X86) {
+    auto type = TensorTypeOf(desc.data_type());
+    // The LLVM backend marks the scalar loads and stores with `align 8` and the vector ones with the element size, so
+    // the tensor can share the mapped memory only if the data is aligned to 8 bytes, otherwise it is copied into an
+    // aligned buffer.
+    constexpr int kHostAccessAlignment = 8;
+    if (reader->holder() && reinterpret_cast<uintptr_t>(src) % std::max(kHostAccessAlignment, type.bytes()) == 0) {
+      tensor->set_type(type);
+      tensor->get_buffer()->ShareExternalMemory(reinterpret_cast<uint8_t *>(src), size, reader->holder(), target);
+    } else {
+      std::memcpy(tensor->mutable_data(target, type), src, size);
+    }
+  } else if (target.arch == Target::Arch::NVGPU) {
+#ifdef CINN_WITH_CUDA
+    if (desc.data_type() != framework_proto::VarType_Type_FP32) LOG(FATAL) << "[CUDA] The type is not fp32!!";
+    auto *data = tensor->mutable_data<float>(target);
+    tensor->set_type(Float(32));
+    CUDA_CALL(cudaMemcpy(reinterpret_cast<void *>(data), src, size, cudaMemcpyHostToDevice));
+#else
+    LOG(FATAL) << "To use CUDA backends, you need to set WITH_CUDA ON!";
+#endif
+  } else {
+    CINN_NOT_IMPLEMENTED
+  }
+}
+
+void LoadLoDTensor(MemoryReader *reader, hlir::framework::Variable *var, const common::Target &target) {
+  auto &tensor = absl::get<hlir::framework::Tensor>(*var);
+  auto version = reader->Read<uint32_t>();
+  VLOG(3) << "model version " << version;
+
+  // Skip LoD information
+  auto lod_level = reader->Read<uint64_t>();
+  for (uint64_t i = 0; i < lod_level; ++i) {
+    auto size = reader->Read<uint64_t>();
+    reader->Skip(size);
+  }
+
+  TensorFromMemory(reader, tensor.operator->(), target);
+}
+
+}  // namespace
+
 void TensorFromStream(std::istream &is, hlir::framework::_Tensor_ *tensor, const common::Target &target) {
   using Type = framework_proto::VarType::Type;
   uint32_t version;
@@ -131,23 +287,16 @@ void LoadLoDTensor(std::istream &is, hlir::framework::Variable *var, const commo
 }
 
 void ReadBinaryFile(const std::string &filename, std::string *contents) {
-  std::ifstream fin(filename, std::ios::in | std::ios::binary);
-  CHECK(fin.is_open()) << "Cannot open file: " << filename;
-  fin.seekg(0, std::ios::end);
-  auto size = fin.tellg();
-  contents->clear();
-  contents->resize(size);
-  fin.seekg(0, std::ios::beg);
-  fin.read(&(contents->at(0)), contents->size());
-  fin.close();
+  MappedFile file(filename);
+  contents->assign(file.data(), file.size());
 }
 
 std::unique_ptr<framework_proto::ProgramDesc> LoadProgram(const std::string &path, bool program_from_memory) {
   std::unique_ptr<framework_proto::ProgramDesc> main_program(new framework_proto::ProgramDesc);
   if (!program_from_memory) {
-    std::string desc_str;
-    ReadBinaryFile(path, &desc_str);
-    main_program->ParseFromString(desc_str);
+    // parse the program from the mapped file without reading it into a string
+    MappedFile file(path);
+    main_program->ParseFromArray(file.data(), file.size());
   } else {
     main_program->ParseFromString(path);
   }
@@ -158,9 +307,9 @@ void LoadParams(const std::string &path) {}
 
 // Load directly to CPU, and latter transfer to other devices.
 void LoadParam(const std::string &path, hlir::framework::Variable *out, const common::Target &target) {
-  std::ifstream fin(path, std::ios::binary);
-  CHECK(fin.is_open()) << "failed to open file " << path;
-  LoadLoDTensor(fin, out, target);
+  auto file = std::make_shared<MappedFile>(path);
+  MemoryReader reader(file->data(), file->size(), file);
+  LoadLoDTensor(&reader, out, target);
 }
 
 bool IsPersistable(const cpp::VarDesc &var) {
@@ -190,25 +339,23 @@ void LoadCombinedParamsPb(const std::string &path,
   std::sort(paramlist.begin(), paramlist.end());
 
   // Load vars
-  auto load_var_func = [&](std::istream &is) {
+  auto load_var_func = [&](MemoryReader *reader) {
     for (size_t i = 0; i < paramlist.size(); ++i) {
       auto *var = scope->Var<hlir::framework::Tensor>(utils::TransValidVarName(paramlist[i]));
-      // Error checking
-      CHECK(static_cast<bool>(is)) << "There is a problem with loading model parameters";
-      LoadLoDTensor(is, var, target);
+      LoadLoDTensor(reader, var, target);
     }
-    is.peek();
-    CHECK(is.eof()) << "You are not allowed to load partial data via"
-                    << " LoadCombinedParamsPb, use LoadParam instead.";
+    CHECK(reader->eof()) << "You are not allowed to load partial data via"
+                         << " LoadCombinedParamsPb, use LoadParam instead.";
   };
 
   if (params_from_memory) {
-    std::stringstream fin(path, std::ios::in | std::ios::binary);
-    load_var_func(fin);
+    // the parameters are owned by the caller, so they are copied into the tensors
+    MemoryReader reader(const_cast<char *>(path.data()), path.size(), nullptr);
+    load_var_func(&reader);
   } else {
-    std::ifstream fin(path, std::ios::binary);
-    CHECK(fin.is_open());
-    load_var_func(fin);
+    auto file = std::make_shared<MappedFile>(path);
+    MemoryReader reader(file->data(), file->size(), file);
+    load_var_func(&reader);
   }
 }
 
@@ -248,22 +395,27 @@ void LoadModelPb(const std::string &model_dir,
   if (combined) {
     LoadCombinedParamsPb(param_file_temp, scope, *cpp_prog, model_from_memory, target);
   } else {
+    // The scope is not thread-safe, so the variables are created before loading the files in parallel.
+    std::vector<std::pair<std::string, hlir::framework::Variable *>> params;
     auto main_block = pb_proto_prog.blocks(0);
     for (auto &var : main_block.vars()) {
       if (var.name() == "feed" || var.name() == "fetch" || !var.persistable()) continue;
-
-      std::string file_path = model_dir + "/" + var.name();
-      VLOG(4) << "reading weight " << var.name();
-
-      std::ifstream file(file_path, std::ios::binary);
-      switch (var.type().type()) {
-        case framework_proto::VarType_Type_LOD_TENSOR:
-          LoadLoDTensor(file, scope->Var<hlir::framework::Tensor>(utils::TransValidVarName(var.name())), target);
-          break;
-        default:
-          LOG(FATAL) << "unknown weight type";
+      if (var.type().type() != framework_proto::VarType_Type_LOD_TENSOR) {
+        LOG(FATAL) << "unknown weight type";
       }
+      params.emplace_back(model_dir + "/" + var.name(),
+                          scope->Var<hlir::framework::Tensor>(utils::TransValidVarName(var.name())));
     }
+
+    // the copies to the device are serialized anyway, and each thread would have to bind the current device
+    int num_threads = target.arch == Target::Arch::X86 ? -1 : 1;
+    utils::parallel_run(
+        [&](int index) {
+          VLOG(4) << "reading weight " << params[index].first;
+          LoadParam(params[index].first, params[index].second, target);
+        },
+        utils::SequenceDispatcher(0, params.size()),
+        num_threads);
   }
 
   VLOG(4) << "Load protobuf model in [" << model_dir << "] successfully";
@@ -16,6 +16,17 @@
 
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cinn/utils/timer.h"
 
 DEFINE_string(model_dir, "<NOTEXIST>", "model directory path");
 
@@ -42,4 +53,148 @@ TEST(LoadModelPb, naive_model) {
   // fetch
 }
 
+namespace {
+
+using ParamList = std::vector<std::pair<std::string, std::vector<int64_t>>>;
+
+// Peak resident set size of this process in MB.
+double PeakRSS() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss / 1024.0;
+}
+
+// Serialize a LoDTensor of float32 filled by `value` in the format of paddle.
+void WriteLoDTensor(std::ostream& os, const std::vector<int64_t>& dims, float value) {
+  uint32_t version   = 0;
+  uint64_t lod_level = 0;
+  os.write(reinterpret_cast<const char*>(&version), sizeof(version));
+  os.write(reinterpret_cast<const char*>(&lod_level), sizeof(lod_level));
+  os.write(reinterpret_cast<const char*>(&version), sizeof(version));
+
+  framework_proto::VarType::TensorDesc desc;
+  desc.set_data_type(framework_proto::VarType_Type_FP32);
+  int64_t numel = 1;
+  for (auto dim : dims) {
+    desc.add_dims(dim);
+    numel *= dim;
+  }
+  std::string desc_str = desc.SerializeAsString();
+  int32_t desc_size    = desc_str.size();
+  os.write(reinterpret_cast<const char*>(&desc_size), sizeof(desc_size));
+  os.write(desc_str.data(), desc_size);
+
+  std::vector<float> data(numel, value);
+  os.write(reinterpret_cast<const char*>(data.data()), numel * sizeof(float));
+}
+
+// Write a model only containing the persistable parameters, the i-th parameter is filled by i.
+std::string WriteModel(const std::string& name, const ParamList& params, bool combined) {
+  std::string model_dir = "/tmp/cinn_model_parser_test_" + name;
+  mkdir(model_dir.c_str(), 0755);
+
+  framework_proto::ProgramDesc program;
+  auto* block = program.add_blocks();
+  block->set_idx(0);
+  block->set_parent_idx(-1);
+  for (auto& param : params) {
+    auto* var = block->add_vars();
+    var->set_name(param.first);
+    var->set_persistable(true);
+    var->mutable_type()->set_type(framework_proto::VarType_Type_LOD_TENSOR);
+    auto* tensor_desc = var->mutable_type()->mutable_lod_tensor()->mutable_tensor();
+    tensor_desc->set_data_type(framework_proto::VarType_Type_FP32);
+    for (auto dim : param.second) {
+      tensor_desc->add_dims(dim);
+    }
+  }
+  std::ofstream model_file(model_dir + "/__model__", std::ios::binary);
+  program.SerializeToOstream(&model_file);
+
+  if (combined) {
+    // the combined parameters are sorted by name
+    std::vector<int> order(params.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return params[a].first < params[b].first; });
+    std::ofstream params_file(model_dir + "/params", std::ios::binary);
+    for (int i : order) {
+      WriteLoDTensor(params_file, params[i].second, i);
+    }
+  } else {
+    for (int i = 0; i < params.size(); ++i) {
+      std::ofstream param_file(model_dir + "/" + params[i].first, std::ios::binary);
+      WriteLoDTensor(param_file, params[i].second, i);
+    }
+  }
+  return model_dir;
+}
+
+void CheckParams(hlir::framework::Scope* scope, const ParamList& params) {
+  for (int i = 0; i < params.size(); ++i) {
+    auto tensor = scope->GetTensor(params[i].first);
+    ASSERT_EQ(tensor->type(), Float(32));
+    std::vector<int> dims(params[i].second.begin(), params[i].second.end());
+    ASSERT_EQ(tensor->shape().data(), dims);
+    const float* data = tensor->data<float>();
+    for (int j = 0; j < tensor->shape().numel(); ++j) {
+      ASSERT_EQ(data[j], static_cast<float>(i)) << "The " << j << "-th element of " << params[i].first << " is wrong";
+    }
+  }
+}
+
+}  // namespace
+
+TEST(LoadModelPb, zero_copy_params) {
+  // The header before the data of "aligned" takes 32 bytes, "four_byte_aligned" takes 28 bytes and "misaligned" takes
+  // 25 bytes. In the combined file, the data of "four_byte_aligned" starts at 32 + 65536 + 28 bytes, which is aligned
+  // to 4 bytes but not the 8 bytes assumed by the host loads.
+  ParamList params = {{"aligned", {128, 128, 1, 1}}, {"four_byte_aligned", {16384, 4}}, {"misaligned", {200}}};
+  for (bool combined : {false, true}) {
+    auto model_dir = WriteModel(combined ? "zero_copy_combined" : "zero_copy", params, combined);
+    {
+      hlir::framework::Scope scope;
+      cpp::ProgramDesc program_desc;
+      LoadModelPb(model_dir, "__model__", "", &scope, &program_desc, combined);
+      CheckParams(&scope, params);
+
+      // the copied tensors are allocated with 1024 bytes alignment, while the shared ones are at the mapped offsets
+      auto* aligned           = scope.GetTensor("aligned")->mutable_data<float>(common::DefaultHostTarget());
+      auto* four_byte_aligned = scope.GetTensor("four_byte_aligned")->data<float>();
+      auto* misaligned        = scope.GetTensor("misaligned")->data<float>();
+      ASSERT_NE(reinterpret_cast<uintptr_t>(aligned) % 1024, 0UL);
+      ASSERT_EQ(reinterpret_cast<uintptr_t>(four_byte_aligned) % 1024, 0UL);
+      ASSERT_EQ(reinterpret_cast<uintptr_t>(misaligned) % 1024, 0UL);
+      // writing the shared tensor never changes the file
+      std::fill(aligned, aligned + 128 * 128, -1.0f);
+    }
+    hlir::framework::Scope scope;
+    cpp::ProgramDesc program_desc;
+    LoadModelPb(model_dir, "__model__", "", &scope, &program_desc, combined);
+    CheckParams(&scope, params);
+  }
+}
+
+TEST(LoadModelPb, large_model_benchmark) {
+  // 16 parameters of 1MB
+  ParamList params;
+  for (int i = 0; i < 16; ++i) {
+    params.emplace_back("param_" + std::to_string(i), std::vector<int64_t>{16384, 16});
+  }
+
+  for (bool combined : {false, true}) {
+    auto model_dir = WriteModel(combined ? "large_model_combined" : "large_model", params, combined);
+    hlir::framework::Scope scope;
+    cpp::ProgramDesc program_desc;
+
+    double rss_before = PeakRSS();
+    utils::Timer timer;
+    timer.Start();
+    LoadModelPb(model_dir, "__model__", "", &scope, &program_desc, combined);
+    auto cost = timer.Stop();
+    LOG(INFO) << "Loading " << (combined ? "combined" : "separate") << " parameters of 16MB costs " << cost
+              << " ms, peak RSS " << rss_before << " MB -> " << PeakRSS() << " MB";
+    CheckParams(&scope, params);
+  }
+}
+
 }  // namespace cinn::frontend::paddle
@@ -0,0 +1,226 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/program_pass.h"
+#include "cinn/frontend/syntax.h"
+
+namespace cinn::frontend::pass {
+
+// Pass `QuantizeFolding` rewrites the "fake quantized" sub-graphs into real low precision computation:
+//   1. dot(dequantize(x_q, s_x), dequantize(w_q, s_w))             -> dequantize(dot_int8(x_q, w_q), s_x * s_w)
+//   2. quantize(dot(dequantize(x_q, s_x), dequantize(w_q, s_w)), s) -> requantize(dot_int8(x_q, w_q), s_x * s_w, s)
+//   3. quantize(dequantize(q, s, zp), s, zp)                         -> identity(q)
+// where `dot` is `matmul` or `conv2d`. Only symmetric (zero_point = 0) operands are folded into the int8 dot, the
+// dequantize ops left without users are removed by `DeadCodeEliminate` later. The pass does nothing on the targets
+// other than X86, which have no int8 dot kernels.
+class QuantizeFoldingPass : public ProgramPass {
+ public:
+  using ProgramPass::ProgramPass;
+  using OutputToOpMap = std::unordered_map<std::string, Instruction*>;
+  using InputToOpMap  = std::unordered_map<std::string, std::unordered_set<Instruction*>>;
+
+ protected:
+  void Clear() override {}
+
+  void ApplyImpl(Program* program,
+                 const std::unordered_set<std::string>& fetch_ids,
+                 const common::Target& target) const override {
+    // matmul_int8 and conv2d_int8 are only implemented on X86
+    if (target.arch != common::Target::Arch::X86) {
+      return;
+    }
+    OutputToOpMap out2instr;
+    InputToOpMap in2instr;
+    for (size_t i = 0; i < program->size(); ++i) {
+      auto& instr = (*program)[i];
+      for (const auto& out : instr->outputs) {
+        out2instr[out->id] = &instr;
+      }
+      for (const auto& in : instr->inputs) {
+        in2instr[in->id].insert(&instr);
+      }
+    }
+
+    // the dot instruction -> the quantize instruction consuming its output, or nullptr
+    std::unordered_map<Instruction*, Instruction*> fold_dots;
+    std::unordered_set<Instruction*> remove_instrs;
+    for (size_t i = 0; i < program->size(); ++i) {
+      auto* instr = &(*program)[i];
+      if ("quantize" == (*instr)->op_type) {
+        FoldQuantizeDequantize(instr, out2instr);
+        continue;
+      }
+      if (!CanFoldDot(instr, out2instr)) {
+        continue;
+      }
+      Instruction* quantize   = nullptr;
+      const auto& out_name    = (*instr)->outputs.front()->id;
+      const auto& out_instrs  = in2instr[out_name];
+      bool only_used_by_quant = !fetch_ids.count(out_name) && out_instrs.size() == 1 &&
+                                "quantize" == (**out_instrs.begin())->op_type;
+      if (only_used_by_quant) {
+        quantize = *out_instrs.begin();
+        remove_instrs.insert(quantize);
+      }
+      VLOG(4) << "Fold the dequantized " << (*instr)->op_type << " whose output is [" << out_name << "] into "
+              << (*instr)->op_type << "_int8" << (quantize ? " + requantize" : " + dequantize");
+      fold_dots[instr] = quantize;
+    }
+
+    if (fold_dots.empty()) {
+      return;
+    }
+
+    NetBuilder builder("quantize_folding_builder");
+    for (auto& var : program->GetInputs()) {
+      builder.CreateInput(var);
+    }
+    for (size_t i = 0; i < program->size(); i++) {
+      auto* instr = &(*program)[i];
+      if (remove_instrs.count(instr)) {
+        continue;
+      }
+      if (!fold_dots.count(instr)) {
+        builder.AppendInstruction(*instr);
+        continue;
+      }
+      auto* x_deq = out2instr.at((*instr)->inputs[0]->id);
+      auto* y_deq = out2instr.at((*instr)->inputs[1]->id);
+      auto x_q    = (*x_deq)->inputs.front();
+      auto y_q    = (*y_deq)->inputs.front();
+      float scale = x_deq->GetAttrs<float>("scale") * y_deq->GetAttrs<float>("scale");
+
+      Variable acc;
+      if ("matmul" == (*instr)->op_type) {
+        acc = builder.MatmulInt8(x_q, y_q, GetAttrOr(*instr, "trans_b", false));
+      } else {
+        acc = builder.Conv2dInt8(x_q,
+                                 y_q,
+                                 instr->GetAttrs<std::vector<int>>("stride"),
+                                 instr->GetAttrs<std::vector<int>>("padding"),
+                                 instr->GetAttrs<std::vector<int>>("dilation"));
+      }
+
+      auto* quantize = fold_dots.at(instr);
+      if (quantize) {
+        Instruction requant("requantize", {acc});
+        requant.SetAttr("input_scale", scale);
+        requant.SetAttr("output_scale", quantize->GetAttrs<float>("scale"));
+        requant.SetAttr("zero_point", quantize->GetAttrs<int>("zero_point"));
+        requant.SetAttr("dtype", quantize->GetAttrs<std::string>("dtype"));
+        requant->outputs = (*quantize)->outputs;
+        builder.AppendInstruction(requant);
+      } else {
+        Instruction dequant("dequantize", {acc});
+        dequant.SetAttr("scale", scale);
+        dequant.SetAttr("zero_point", 0);
+        dequant.SetAttr("dtype", common::Type2Str((*instr)->outputs.front()->type));
+        dequant->outputs = (*instr)->outputs;
+        builder.AppendInstruction(dequant);
+      }
+    }
+    *program = builder.Build();
+  }
+
+ private:
+  template <typename T>
+  static T GetAttrOr(const Instruction& instr, const std::string& key, T default_value) {
+    if (instr->attrs.count(key)) {
+      return instr.GetAttrs<T>(key);
+    }
+    return default_value;
+  }
+
+  // return the dequantize instruction producing `var` if its input is symmetrically quantized int8/uint8
+  Instruction* GetSymmetricDequantize(const Variable& var, const OutputToOpMap& out2instr) const {
+    if (!out2instr.count(var->id)) {
+      return nullptr;
+    }
+    auto* instr = out2instr.at(var->id);
+    if ("dequantize" != (*instr)->op_type) {
+      return nullptr;
+    }
+    const auto& in_type = (*instr)->inputs.front()->type;
+    if (!(in_type.is_int(8) || in_type.is_uint(8)) || GetAttrOr(*instr, "zero_point", 0) != 0) {
+      return nullptr;
+    }
+    return instr;
+  }
+
+  bool CanFoldDot(Instruction* instr, const OutputToOpMap& out2instr) const {
+    const auto& op_type = (*instr)->op_type;
+    if (("matmul" != op_type && "conv2d" != op_type) || (*instr)->inputs.size() != 2) {
+      return false;
+    }
+    if (!GetSymmetricDequantize((*instr)->inputs[0], out2instr) ||
+        !GetSymmetricDequantize((*instr)->inputs[1], out2instr)) {
+      return false;
+    }
+    const auto& x_shape = (*instr)->inputs[0]->shape;
+    const auto& y_shape = (*instr)->inputs[1]->shape;
+    if ("matmul" == op_type) {
+      return x_shape.size() == 2 && y_shape.size() == 2 && !GetAttrOr(*instr, "trans_a", false) &&
+             GetAttrOr(*instr, "alpha", 1.0f) == 1.0f;
+    }
+    // conv2d_int8 only accepts the 2-D stride, padding and dilation
+    for (const char* key : {"stride", "padding", "dilation"}) {
+      if (GetAttrOr(*instr, key, std::vector<int>{}).size() != 2U) {
+        return false;
+      }
+    }
+    return x_shape.size() == 4 && y_shape.size() == 4 && x_shape[1] == y_shape[1] &&
+           GetAttrOr(*instr, "groups", 1) == 1 && GetAttrOr(*instr, "conv_type", std::string("forward")) == "forward" &&
+           GetAttrOr(*instr, "data_format", std::string("NCHW")) == "NCHW" &&
+           GetAttrOr(*instr, "padding_algorithm", std::string("EXPLICIT")) == "EXPLICIT";
+  }
+
+  // quantize(dequantize(q)) with the same quantization parameters is q itself
+  void FoldQuantizeDequantize(Instruction* quantize, const OutputToOpMap& out2instr) const {
+    const auto& input = (*quantize)->inputs.front();
+    if (!out2instr.count(input->id)) {
+      return;
+    }
+    auto* dequantize = out2instr.at(input->id);
+    if ("dequantize" != (*dequantize)->op_type) {
+      return;
+    }
+    const auto& q = (*dequantize)->inputs.front();
+    if (q->type != (*quantize)->outputs.front()->type ||
+        dequantize->GetAttrs<float>("scale") != quantize->GetAttrs<float>("scale") ||
+        GetAttrOr(*dequantize, "zero_point", 0) != GetAttrOr(*quantize, "zero_point", 0)) {
+      return;
+    }
+    VLOG(4) << "The quantize op whose output is [" << (*quantize)->outputs.front()->id
+            << "] restores the input of its dequantize, replace with identity.";
+    (*quantize)->op_type = "identity";
+    (*quantize)->inputs  = {q};
+    (*quantize)->attrs.clear();
+    (*quantize)->attrs_ordered.clear();
+  }
+};
+
+}  // namespace cinn::frontend::pass
+
+CINN_REGISTER_HELPER(QuantizeFolding) {
+  CINN_REGISTER_PROGRAM_PASS(QuantizeFolding, ::cinn::frontend::pass::QuantizeFoldingPass);
+
+  return true;
+}
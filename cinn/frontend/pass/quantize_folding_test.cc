@@ -0,0 +1,179 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "cinn/cinn.h"
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/pass/pass_test_helper.h"
+#include "cinn/frontend/pass/use_program_pass.h"
+#include "cinn/frontend/program_pass.h"
+#include "cinn/frontend/syntax.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/pass.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/hlir/pass/use_pass.h"
+#include "cinn/utils/data_util.h"
+#include "cinn/utils/timer.h"
+
+namespace cinn::frontend {
+
+namespace {
+constexpr float kScale = 1.0f / 127.0f;
+
+bool ContainsOp(const Program& program, const std::string& op_type) {
+  for (size_t i = 0; i < program.size(); ++i) {
+    if (op_type == program[i]->op_type) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// run the program on host with the same random inputs, return the output and the average time of one execution
+std::vector<float> RunHostProgram(const Program& program,
+                                  const std::vector<std::string>& input_ids,
+                                  const std::string& output_id,
+                                  double* time_ms) {
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<hlir::framework::Graph>(program, std::unordered_set<std::string>{output_id}, target);
+  hlir::framework::ApplyPasses(graph.get(), {"OpFusionPass", "FusionMergePass"});
+  auto scope = hlir::framework::BuildScope(target, graph);
+  hlir::framework::GraphCompiler gc(target, scope, graph);
+  auto runtime_program = gc.Build();
+
+  for (size_t i = 0; i < input_ids.size(); ++i) {
+    scope->Var<hlir::framework::Tensor>(input_ids[i]);
+    SetRandData<float>(scope->GetTensor(input_ids[i]), target, 123 + i);
+  }
+  runtime_program->Execute();
+
+  constexpr int kRepeat = 10;
+  utils::Timer timer;
+  timer.Start();
+  for (int i = 0; i < kRepeat; ++i) {
+    runtime_program->Execute();
+  }
+  *time_ms = timer.Stop() / kRepeat;
+  return GetTensorData<float>(scope->GetTensor(output_id), target);
+}
+}  // namespace
+
+TEST(QuantizeFolding, FoldMatmul) {
+  NetBuilder builder("net_builder");
+  auto x       = builder.CreateInput(Float(32), {32, 64}, "X");
+  auto w       = builder.CreateInput(Float(32), {64, 48}, "W");
+  auto x_deq   = builder.Dequantize(builder.Quantize(x, kScale), kScale);
+  auto w_deq   = builder.Dequantize(builder.Quantize(w, kScale), kScale);
+  auto out     = builder.Matmul(x_deq, w_deq);
+  auto program = builder.Build();
+
+  auto target = common::DefaultHostTarget();
+  // the two dequantize ops are removed, and the matmul is replaced by matmul_int8 + dequantize
+  std::pair<std::vector<std::string>, std::vector<std::string>> passes{{"Decomposer"},
+                                                                       {"QuantizeFolding", "DeadCodeEliminate"}};
+  ASSERT_TRUE(CompareProgramPassResult(&program, target, {out->id}, 1, passes));
+  ASSERT_TRUE(ContainsOp(program, "matmul_int8"));
+  ASSERT_FALSE(ContainsOp(program, "matmul"));
+}
+
+TEST(QuantizeFolding, KeepMatmulOnNVGPU) {
+  NetBuilder builder("net_builder");
+  auto x       = builder.CreateInput(Float(32), {32, 64}, "X");
+  auto w       = builder.CreateInput(Float(32), {64, 48}, "W");
+  auto x_deq   = builder.Dequantize(builder.Quantize(x, kScale), kScale);
+  auto w_deq   = builder.Dequantize(builder.Quantize(w, kScale), kScale);
+  auto out     = builder.Matmul(x_deq, w_deq);
+  auto program = builder.Build();
+
+  // the int8 dot kernels only exist on X86, the program is kept as it is on the other targets
+  ProgramPass::Apply(&program, {out->id}, common::DefaultNVGPUTarget(), {"QuantizeFolding", "DeadCodeEliminate"});
+  ASSERT_TRUE(ContainsOp(program, "matmul"));
+  ASSERT_FALSE(ContainsOp(program, "matmul_int8"));
+  ASSERT_TRUE(ContainsOp(program, "dequantize"));
+}
+
+TEST(QuantizeFolding, FoldMatmulRequantize) {
+  NetBuilder builder("net_builder");
+  auto x       = builder.CreateInput(Float(32), {32, 64}, "X");
+  auto w       = builder.CreateInput(Float(32), {64, 48}, "W");
+  auto x_deq   = builder.Dequantize(builder.Quantize(x, kScale), kScale);
+  auto w_deq   = builder.Dequantize(builder.Quantize(w, kScale), kScale);
+  auto out     = builder.Dequantize(builder.Quantize(builder.Matmul(x_deq, w_deq), 0.5f), 0.5f);
+  auto program = builder.Build();
+
+  auto target = common::DefaultHostTarget();
+  // matmul + quantize -> matmul_int8 + requantize, and the two dequantize ops are removed
+  std::pair<std::vector<std::string>, std::vector<std::string>> passes{{"Decomposer"},
+                                                                       {"QuantizeFolding", "DeadCodeEliminate"}};
+  ASSERT_TRUE(CompareProgramPassResult(&program, target, {out->id}, 2, passes));
+  ASSERT_TRUE(ContainsOp(program, "requantize"));
+}
+
+TEST(QuantizeFolding, FoldQuantizeDequantize) {
+  NetBuilder builder("net_builder");
+  auto x       = builder.CreateInput(Float(32), {4, 16}, "X");
+  auto x_q     = builder.Quantize(x, kScale);
+  auto out     = builder.Relu(builder.Quantize(builder.Dequantize(x_q, kScale), kScale));
+  auto program = builder.Build();
+
+  auto target = common::DefaultHostTarget();
+  std::pair<std::vector<std::string>, std::vector<std::string>> passes{
+      {"Decomposer"}, {"QuantizeFolding", "RemoveIdentity", "DeadCodeEliminate"}};
+  ASSERT_TRUE(CompareProgramPassResult(&program, target, {out->id}, 2, passes));
+}
+
+TEST(QuantizeFolding, MatmulInt8Accuracy) {
+  int M = 128, K = 256, N = 128;
+  NetBuilder builder("net_builder");
+  auto x       = builder.CreateInput(Float(32), {M, K}, "X");
+  auto w       = builder.CreateInput(Float(32), {K, N}, "W");
+  auto x_deq   = builder.Dequantize(builder.Quantize(x, kScale), kScale);
+  auto w_deq   = builder.Dequantize(builder.Quantize(w, kScale), kScale);
+  auto out     = builder.Matmul(x_deq, w_deq);
+  auto program = builder.Build();
+
+  NetBuilder ref_builder("ref_builder");
+  auto ref_x       = ref_builder.CreateInput(Float(32), {M, K}, "X");
+  auto ref_w       = ref_builder.CreateInput(Float(32), {K, N}, "W");
+  auto ref_out     = ref_builder.Matmul(ref_x, ref_w);
+  auto ref_program = ref_builder.Build();
+
+  auto target = common::DefaultHostTarget();
+  std::unordered_set<std::string> fetch_ids{out->id};
+  ProgramPass::Apply(&program, fetch_ids, target, {"Decomposer"});
+  double fake_quant_time = 0.0, int8_time = 0.0, float_time = 0.0;
+  auto fake_quant_out = RunHostProgram(program, {x->id, w->id}, out->id, &fake_quant_time);
+
+  ProgramPass::Apply(&program, fetch_ids, target, {"QuantizeFolding", "DeadCodeEliminate"});
+  ASSERT_TRUE(ContainsOp(program, "matmul_int8"));
+  auto int8_out  = RunHostProgram(program, {x->id, w->id}, out->id, &int8_time);
+  auto float_out = RunHostProgram(ref_program, {ref_x->id, ref_w->id}, ref_out->id, &float_time);
+
+  ASSERT_EQ(int8_out.size(), fake_quant_out.size());
+  ASSERT_EQ(int8_out.size(), float_out.size());
+  // each product carries at most one rounding error of half a quantization step on both operands
+  float quant_tol = K * 2 * 0.5f * kScale;
+  for (size_t i = 0; i < int8_out.size(); ++i) {
+    ASSERT_NEAR(int8_out[i], fake_quant_out[i], 1e-3f * std::abs(fake_quant_out[i]) + 1e-3f) << " i is " << i;
+    ASSERT_NEAR(int8_out[i], float_out[i], quant_tol) << " i is " << i;
+  }
+  LOG(INFO) << "matmul [" << M << ", " << K << "] x [" << K << ", " << N << "]: fake quantized " << fake_quant_time
+            << " ms, int8 " << int8_time << " ms, float " << float_time << " ms";
+}
+
+}  // namespace cinn::frontend
@@ -29,3 +29,4 @@ CINN_USE_REGISTER(FillConstantRewriter)
 CINN_USE_REGISTER(FillConstantFolding)
 CINN_USE_REGISTER(CastCollapsing)
 CINN_USE_REGISTER(AutoBroadcast)
+CINN_USE_REGISTER(QuantizeFolding)
@@ -21,6 +21,7 @@
 #include <absl/strings/string_view.h>
 #include <glog/logging.h>
 
+#include <map>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -46,6 +47,8 @@ struct _Variable_ : public common::Object {
   common::Type type;
   std::vector<int> shape;
   bool is_const = false;
+  // the axes whose extents are only known at runtime and their symbol names, the shape holds their upper bounds
+  std::map<int, std::string> symbolic_dims;
 
   const char* type_info() const override { return __type_info__; }
   static constexpr char* __type_info__ = "cinn_frontend_variable";
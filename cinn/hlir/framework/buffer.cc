@@ -14,6 +14,8 @@
 
 #include "cinn/hlir/framework/buffer.h"
 
+#include <utility>
+
 namespace cinn {
 namespace hlir {
 namespace framework {
@@ -49,6 +51,19 @@ void Buffer::SetTarget(const common::Target& target) {
   memory_mng_cache_ = MemoryManager::Global().RetrieveSafely(target_.arch);
 }
 
+void Buffer::ShareExternalMemory(uint8_t* memory,
+                                 uint64_t size,
+                                 std::shared_ptr<void> holder,
+                                 const common::Target& target) {
+  CHECK(holder) << "The external memory should be held by someone";
+  Free();
+  SetTarget(target);
+  data_.memory      = memory;
+  data_.memory_size = size;
+  size_             = size;
+  external_holder_  = std::move(holder);
+}
+
 void Buffer::ResizeLazy(uint32_t size) {
   if (size <= size_) return;
   Resize(size);
@@ -56,8 +56,19 @@ struct Buffer final {
   const cinn_buffer_t* data() const { return &data_; }
   cinn_buffer_t* data() { return &data_; }
 
+  /**
+   * Let this buffer refer to the \p size bytes of memory at \p memory without copying it, the memory is owned by
+   * \p holder and is kept alive until the buffer is freed or resized. The memory should locate in \p target.
+   */
+  void ShareExternalMemory(uint8_t* memory, uint64_t size, std::shared_ptr<void> holder, const common::Target& target);
+
   //! Free all the memory owned by this buffer.
   void Free() {
+    if (external_holder_) {
+      external_holder_.reset();
+      data_.memory = nullptr;
+      return;
+    }
     if (!data_.memory) return;
     memory_mng_cache_->free(data_.memory);
   }
@@ -79,11 +90,13 @@ struct Buffer final {
   //! The place where this buffer locates.
   common::Target target_;
 
-  //! Number of bytes of this buffer.
-  uint32_t size_{};
+  //! Number of bytes of this buffer, the shared external memory may exceed 4GB.
+  uint64_t size_{};
 
   //! Hold the corresponding memory manager for speed.
   MemoryInterface* memory_mng_cache_{};
+  //! The owner of the external memory shared by this buffer, null if the memory is allocated by this buffer.
+  std::shared_ptr<void> external_holder_;
 };
 
 }  // namespace framework
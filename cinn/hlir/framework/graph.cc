@@ -36,6 +36,7 @@ void Graph::Initialize(const frontend::Program& prog,
   target_ = target;
   ShapeDict shape_dict;
   DTypeDict dtype_dict;
+  SymbolicDimDict symbolic_dims;
   int counter = 0;
   for (size_t i = 0; i < prog.size(); i++) {
     auto temp = prog[i];
@@ -50,7 +51,10 @@ void Graph::Initialize(const frontend::Program& prog,
       if (!graph_node) {
         dtype_dict[input_v->id] = input_v->type;
         shape_dict[input_v->id] = input_v->shape;
-        NodeData* input_data    = new NodeData(nullptr, 0, 0, input_v->id, input_v.is_const());
+        if (!input_v->symbolic_dims.empty()) {
+          symbolic_dims[input_v->id] = input_v->symbolic_dims;
+        }
+        NodeData* input_data = new NodeData(nullptr, 0, 0, input_v->id, input_v.is_const());
         input_data->LinkTo(node_tmp);
         this->RegisterNode(input_v->id, input_data);
       } else {
@@ -80,6 +84,24 @@ void Graph::Initialize(const frontend::Program& prog,
   }
   this->attrs["infershape"] = std::make_shared<absl::any>(shape_dict);
   this->attrs["inferdtype"] = std::make_shared<absl::any>(dtype_dict);
+  if (!symbolic_dims.empty()) {
+    this->attrs["symbolic_dims"] = std::make_shared<absl::any>(symbolic_dims);
+  }
+}
+
+void Graph::InvalidateAnalyses(const std::unordered_set<std::string>& preserved) {
+  for (auto it = analyses_.begin(); it != analyses_.end();) {
+    if (preserved.count(it->first)) {
+      ++it;
+    } else {
+      analyses_.erase(it++);
+    }
+  }
+}
+
+const std::vector<common::GraphNode*>& Graph::CachedTopologicalOrder() {
+  return GetAnalysis<std::vector<common::GraphNode*>>(
+      kTopologicalOrder, [](Graph* graph) { return std::get<0>(graph->topological_order()); });
 }
 
 std::vector<std::vector<Node*>> Graph::FusionGroupsToGroups() {
@@ -17,8 +17,11 @@
 #include <absl/types/any.h>
 
 #include <atomic>
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "cinn/common/graph_utils.h"
@@ -29,6 +32,9 @@ namespace cinn {
 namespace hlir {
 namespace framework {
 
+// the symbolic dims of the graph inputs, from the input ids to their symbolic axes and symbol names
+using SymbolicDimDict = absl::flat_hash_map<std::string, std::map<int, std::string>>;
+
 /**
  * \brief Symbolic computation graph.
  *  This is the intermediate representation for optimization pass.
@@ -97,10 +103,14 @@ class Graph : public cinn::common::Graph {
     std::vector<std::shared_ptr<Group>> fused_sub_groups;
     // if as sub-group, used for belong groups.
     std::unordered_set<std::shared_ptr<Group>, SharedGroupHasher, SharedGroupComparator> belong_groups;
+    // the independent groups packed by HorizontalPackingPass, each of them is lowered separately.
+    std::vector<std::shared_ptr<Group>> packed_groups;
 
     // for op lowering.
     std::vector<std::string> input_names;
     std::vector<std::string> output_names;
+    // the symbolic dims passed to the lowered function ahead of the buffers
+    std::vector<std::string> symbol_names;
 
     std::vector<Node*> CollectNodes() {
       if (fused_sub_groups.size()) {
@@ -176,6 +186,37 @@ class Graph : public cinn::common::Graph {
     return it != attrs.end();
   }
 
+  /**
+   * \brief Get the analysis cached in the graph. It is computed at the first query and kept until dropped by
+   * InvalidateAnalyses, which ApplyPasses calls after every pass for the analyses the pass does not preserve. A pass
+   * changing the graph should call InvalidateAnalyses itself before it queries the analyses again.
+   * @param name the name of the analysis
+   * @param compute the function computing the analysis of the graph
+   * @return the reference to the cached analysis
+   * @tparam T the type of the analysis.
+   */
+  template <typename T>
+  inline const T& GetAnalysis(const std::string& name, const std::function<T(Graph*)>& compute) {
+    auto it = analyses_.find(name);
+    if (it == analyses_.end()) {
+      it = analyses_.emplace(name, std::make_shared<absl::any>(compute(this))).first;
+    }
+    return absl::any_cast<const T&>(*it->second);
+  }
+
+  /**
+   * \brief Drop the cached analyses.
+   * @param preserved the names of the analyses to keep
+   */
+  void InvalidateAnalyses(const std::unordered_set<std::string>& preserved = {});
+
+  /**
+   * \brief Get the nodes in topological order, cached as the analysis named kTopologicalOrder.
+   */
+  const std::vector<common::GraphNode*>& CachedTopologicalOrder();
+
+  static constexpr char kTopologicalOrder[] = "topological_order";
+
   /**
    * \brief Debug the grouped graph according to fusion_groups.
    */
@@ -224,6 +265,8 @@ class Graph : public cinn::common::Graph {
   std::string viz_path_;
   static std::atomic_size_t viz_count_;
 
+  absl::flat_hash_map<std::string, std::shared_ptr<absl::any>> analyses_;
+
   CINN_DISALLOW_COPY_AND_ASSIGN(Graph);
 };
 
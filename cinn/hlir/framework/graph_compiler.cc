@@ -746,6 +746,7 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
                                                       std::unordered_set<std::string>&& fetch_var_ids,
                                                       void* stream) {
   Context::Global().ResetNameId();
+  InferSymbolicShape(graph_.get());
   if (FLAGS_cinn_parallel_compile_size) {
     // write group's information into FLAGS_cinn_fusion_groups_graphviz_dir
     graph_->VisualizeGroupedGraph(fetch_var_ids.empty() ? fetch_var_ids_ : fetch_var_ids);
@@ -830,6 +831,9 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
       auto& shape_dict = graph_->GetMutableAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape");
 
       OpLowerer op_lowerer(dtype_dict, shape_dict, target_);
+      if (graph_->HasAttr("symbolic_shapes")) {
+        op_lowerer.SetSymbolicShapes(&graph_->GetAttrs<SymbolicShapeDict>("symbolic_shapes"));
+      }
       for (auto& group : graph_->fusion_groups) {
         VLOG(3) << "group_id is : " << group->group_id << ", and its number is : " << group->nodes.size();
         groups.push_back(std::move(group->CollectNodes()));
@@ -839,6 +843,7 @@ GraphCompiler::CompilationResult GraphCompiler::Build(const GraphCompiler::Compi
       }
     } else {
       VLOG(3) << "fusion_groups is empty";
+      CHECK(!graph_->HasAttr("symbolic_dims")) << "The symbolic dims are only supported by the fusion groups.";
       std::vector<ir::LoweredFunc> lowered_func;
       if (FLAGS_cinn_ir_schedule) {
         auto& dtype_dict = graph_->GetMutableAttrs<absl::flat_hash_map<std::string, Type>>("inferdtype");
@@ -1031,6 +1036,9 @@ std::vector<std::unique_ptr<Instruction>> GraphCompiler::BuildInstructions(
                           fusion_group.get() ? fusion_group->input_names : OpGetInputNames(node),
                           fusion_group.get() ? fusion_group->output_names : OpGetOutputNames(node),
                           instr_name));
+      if (fusion_group.get() && !fusion_group->symbol_names.empty()) {
+        instr->SetSymbolicDims(BindSymbolicDims(graph_.get(), fusion_group->symbol_names));
+      }
 
       if (target_.arch == Target::Arch::NVGPU) {
         if (node->op()->name == "conv2d") {
@@ -1239,6 +1247,9 @@ std::vector<std::unique_ptr<Instruction>> GraphCompiler::BuildInstructions(
                                                        fusion_group.get() ? fusion_group->input_names : inputNames,
                                                        fusion_group.get() ? fusion_group->output_names : outputNames,
                                                        fuse_name));
+      if (fusion_group.get() && !fusion_group->symbol_names.empty()) {
+        instr->SetSymbolicDims(BindSymbolicDims(graph_.get(), fusion_group->symbol_names));
+      }
 
       auto* fn_ptr = compiler_->Lookup(fuse_name);
       CHECK(fn_ptr);
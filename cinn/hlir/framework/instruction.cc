@@ -78,8 +78,24 @@ void Instruction::UpdateArgsCache(const std::map<std::string, cinn_pod_value_t>*
   int cache_size = size();
   args_cached_.resize(cache_size);
 
+  symbolic_buffers_.clear();
+  for (auto& dim : symbolic_dims_) {
+    if (name2podargs != nullptr) {
+      CHECK_NE(name2podargs->count(dim.first), 0) << "Argument [" << dim.first << "] not found in the name2podargs";
+      symbolic_buffers_.push_back(name2podargs->at(dim.first));
+    } else {
+      auto* var = scope_->FindVar(dim.first);
+      CHECK(var) << "Argument [" << dim.first << "] not found in the scope";
+      symbolic_buffers_.push_back(absl::get<Tensor>(*var)->buffer());
+    }
+  }
+
   for (int i = 0; i < cache_size; ++i) {
     common::ArgsBuilder builder;
+    // the values of the symbolic dims are filled before every run
+    for (int j = 0; j < symbolic_dims_.size(); ++j) {
+      builder.Add(0);
+    }
     std::vector<std::string> all_args = in_args_[i];
     all_args.insert(std::end(all_args), out_args_[i].begin(), out_args_[i].end());
 
@@ -133,6 +149,15 @@ void Instruction::Run(const std::map<std::string, cinn_pod_value_t>* name2podarg
     if (!use_cache || args_cached_.size() != size()) {
       UpdateArgsCache(name2podargs);
     }
+    for (int i = 0; i < symbolic_dims_.size(); ++i) {
+      auto& dim    = symbolic_dims_[i];
+      auto* buffer = symbolic_buffers_[i];
+      CHECK_LT(dim.second, buffer->dimensions) << "The symbolic axis " << dim.second << " of " << dim.first
+                                               << " is out of range.";
+      for (auto& pod_args : args_cached_) {
+        pod_args[i] = cinn_pod_value_t(static_cast<int32_t>(buffer->dims[dim.second]));
+      }
+    }
   }
 
   utils::RecordEvent record_args("Instruction::Run", cinn::utils::EventType::kInstruction);
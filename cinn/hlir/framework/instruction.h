@@ -64,6 +64,15 @@ class Instruction {
     fn_names_.push_back(name);
   }
 
+  /**
+   * Bind the symbolic dims, the leading scalar arguments of the lowered functions, to the dims of the input buffers,
+   * whose values are read before every run.
+   * @param symbolic_dims The (buffer name, axis) pairs in the order of the scalar arguments.
+   */
+  void SetSymbolicDims(const std::vector<std::pair<std::string, int>>& symbolic_dims) {
+    symbolic_dims_ = symbolic_dims;
+  }
+
   // explicitly finalize the instruction, and can't append function again after call it
   void Finalize();
 
@@ -141,6 +150,10 @@ class Instruction {
 
   std::vector<std::vector<cinn_pod_value_t>> args_cached_;
 
+  std::vector<std::pair<std::string, int>> symbolic_dims_;
+  // the buffers the symbolic dims are read from
+  std::vector<cinn_buffer_t*> symbolic_buffers_;
+
   std::vector<void*> fn_ptrs_{};
   std::vector<std::string> fn_names_;
 };
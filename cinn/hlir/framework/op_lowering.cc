@@ -14,13 +14,19 @@
 
 #include "cinn/hlir/framework/op_lowering.h"
 
+#include <set>
+#include <unordered_set>
+
 #include "cinn/hlir/framework/op_lowering_util.h"
 #include "cinn/hlir/op/external_api_registry.h"
+#include "cinn/hlir/pe/ir_schedule_pe.h"
+#include "cinn/ir/collect_ir_nodes.h"
 #include "cinn/ir/ir_schedule.h"
 #include "cinn/optim/transform_gpu_forloop.h"
 
 DECLARE_bool(cinn_ir_schedule);
 DECLARE_bool(cinn_use_cuda_vectorize);
+DECLARE_bool(cinn_use_cpu_reduce_schedule);
 
 namespace cinn {
 namespace hlir {
@@ -49,6 +55,10 @@ std::vector<ir::LoweredFunc> OpLowerer::Lower(GroupPtr& group) {
   VLOG(3) << "Lowering Group : " << group->group_id << " , Op Pattern : " << group->op_pattern_kind;
   group->input_names.clear();
   group->output_names.clear();
+  group->symbol_names.clear();
+  if (!group->packed_groups.empty()) {
+    return LowerPackedGroups(group, /*apply_schedule = */ true);
+  }
   if (FLAGS_cinn_ir_schedule) {
     switch (group->op_pattern_kind) {
       case framework::kElementWise:
@@ -71,6 +81,9 @@ std::vector<ir::LoweredFunc> OpLowerer::Lower(GroupPtr& group) {
 
 std::vector<ir::LoweredFunc> OpLowerer::LowerWithoutSchedule(GroupPtr& group) {
   VLOG(3) << "Lowering Group : " << group->group_id << " , Op Pattern : " << group->op_pattern_kind;
+  if (!group->packed_groups.empty()) {
+    return LowerPackedGroups(group, /*apply_schedule = */ false);
+  }
   if (FLAGS_cinn_ir_schedule) {
     switch (group->op_pattern_kind) {
       case framework::kElementWise:
@@ -91,6 +104,67 @@ std::vector<ir::LoweredFunc> OpLowerer::LowerWithoutSchedule(GroupPtr& group) {
   }
 }
 
+std::vector<ir::LoweredFunc> OpLowerer::LowerPackedGroups(GroupPtr& group, bool apply_schedule) {
+  VLOG(3) << "Lowering " << group->packed_groups.size() << " packed groups of " << group->group_id;
+  group->input_names.clear();
+  group->output_names.clear();
+  std::vector<ir::Argument> input_args;
+  std::vector<ir::Argument> output_args;
+  std::unordered_set<std::string> arg_names;
+  std::vector<ir::Buffer> temp_buffers;
+  std::vector<Expr> bodies;
+  for (auto& sub_group : group->packed_groups) {
+    auto funcs = apply_schedule ? Lower(sub_group) : LowerWithoutSchedule(sub_group);
+    CHECK_EQ(funcs.size(), 1) << "Lowered Function Is Not Equal 1!";
+    CHECK(sub_group->symbol_names.empty()) << "The groups with symbolic dims can't be packed.";
+    auto& func = funcs[0];
+    CHECK_EQ(func->args.size(), sub_group->input_names.size() + sub_group->output_names.size());
+    // the args of the packed groups are in the order of their input names and output names, the shared inputs are
+    // passed once
+    int num_inputs = sub_group->input_names.size();
+    for (int idx = 0; idx < func->args.size(); ++idx) {
+      bool is_input = idx < num_inputs;
+      auto& name    = is_input ? sub_group->input_names[idx] : sub_group->output_names[idx - num_inputs];
+      if (!arg_names.insert(name).second) {
+        CHECK(is_input) << "The output " << name << " is written by more than one packed group.";
+        continue;
+      }
+      if (is_input) {
+        group->input_names.push_back(name);
+        input_args.push_back(func->args[idx]);
+      } else {
+        group->output_names.push_back(name);
+        output_args.push_back(func->args[idx]);
+      }
+    }
+    // the nested parallel loops are not supported, the packed bodies are run by one thread each
+    auto parallel_loops = ir::CollectIRNodesWithoutTensor(
+        func->body, [](const Expr* x) { return x->As<ir::For>() && x->As<ir::For>()->is_parallel(); });
+    for (auto& loop : parallel_loops) {
+      const_cast<ir::For*>(loop.As<ir::For>())->set_parallel(false);
+    }
+    temp_buffers.insert(temp_buffers.end(), func->temp_bufs.begin(), func->temp_bufs.end());
+    bodies.push_back(func->body);
+  }
+
+  ir::Var task_id(common::UniqName("packed_task_id"), common::Int(32));
+  Expr dispatch = bodies.back();
+  for (int idx = static_cast<int>(bodies.size()) - 2; idx >= 0; --idx) {
+    dispatch = ir::IfThenElse::Make(ir::EQ::Make(task_id, Expr(idx)), bodies[idx], dispatch);
+  }
+  auto func_body = ir::For::Make(task_id,
+                                 Expr(0),
+                                 Expr(static_cast<int>(bodies.size())),
+                                 ir::ForType::Parallel,
+                                 ir::DeviceAPI::Host,
+                                 ir::Block::Make({dispatch}));
+
+  std::vector<ir::Argument> func_args(input_args);
+  func_args.insert(func_args.end(), output_args.begin(), output_args.end());
+  auto func = ir::_LoweredFunc_::Make(group->GetFuncName(), func_args, ir::Block::Make({func_body}), temp_buffers);
+  return {func};
+}
+
 std::vector<ir::LoweredFunc> OpLowerer::IRLowerOp(IRComputeFunction compute, GroupPtr& group) {
   poly::StageMap stages;
   std::vector<ir::Tensor> arg_tensors;
@@ -154,6 +228,7 @@ std::vector<ir::LoweredFunc> OpLowerer::IRLowerOp(IRComputeFunction compute, Gro
   optim::OptimizeExprGPU(&(func_body));
 #endif
 
+  AddSymbolicArgs(arg_tensors, group, &func_args);
   auto temp_buffers = lang::GetTempBuffers(arg_tensors, stages, func_body);
   auto func =
       ir::_LoweredFunc_::Make(group->GetFuncName(), func_args, ir_sch.GetModule().GetExprs().at(0), temp_buffers);
@@ -235,6 +310,7 @@ std::vector<ir::LoweredFunc> OpLowerer::IRLowerOpWithoutSchedule(IRComputeFuncti
   optim::OptimizeExprGPU(&(func_body));
 #endif
 
+  AddSymbolicArgs(arg_tensors, group, &func_args);
   auto temp_buffers = lang::GetTempBuffers(arg_tensors, stages, func_body);
   auto func =
       ir::_LoweredFunc_::Make(group->GetFuncName(), func_args, ir_sch.GetModule().GetExprs().at(0), temp_buffers);
@@ -259,8 +335,8 @@ std::vector<Expr> OpLowerer::IRElementwiseCompute(poly::StageMap& stages,
     auto node_data = GetNodeData(node);
     CHECK_EQ(GetAllNodeData(node).size(), 1U);
     std::vector<common::CINNValue> cinn_inputs;
-    std::vector<ir::Tensor> tensor_inputs =
-        std::move(CollectInputTensor(node, func_tensors, tensor_map, this->type_dict_, this->shape_dict_));
+    std::vector<ir::Tensor> tensor_inputs = std::move(CollectInputTensor(
+        node, func_tensors, tensor_map, this->type_dict_, this->shape_dict_, symbolic_shapes_));
     for (auto& tensor : tensor_inputs) {
       cinn_inputs.push_back(common::CINNValue(ir::Expr(tensor)));
     }
@@ -325,8 +401,8 @@ std::vector<Expr> OpLowerer::IRReduceCompute(poly::StageMap& stages,
     VLOG(3) << "In ReduceCompute, process node: " << node->id() << " with op type: " << node->op()->name;
 
     std::vector<common::CINNValue> cinn_inputs;
-    std::vector<ir::Tensor> tensor_inputs =
-        std::move(CollectInputTensor(node, func_args, tensor_map, this->type_dict_, this->shape_dict_));
+    std::vector<ir::Tensor> tensor_inputs = std::move(
+        CollectInputTensor(node, func_args, tensor_map, this->type_dict_, this->shape_dict_, symbolic_shapes_));
     for (auto& tensor : tensor_inputs) {
       cinn_inputs.push_back(common::CINNValue(ir::Expr(tensor)));
     }
@@ -406,7 +482,7 @@ std::vector<ir::LoweredFunc> OpLowerer::IRLowerNonFusibleOp(GroupPtr& group, boo
     CHECK(node_data);
     ir::Tensor tensor;
     if (!tensor_map.count(node_data->id())) {
-      tensor = GetTensor(node_data, this->type_dict_, this->shape_dict_);
+      tensor = GetTensor(node_data, this->type_dict_, this->shape_dict_, symbolic_shapes_);
       // record tensor.
       tensor_map[node_data->id()] = tensor;
       // input name.
@@ -432,8 +508,8 @@ std::vector<ir::LoweredFunc> OpLowerer::IRLowerNonFusibleOp(GroupPtr& group, boo
   }
 
   auto impl = OpStrategy::SelectImpl(cinn_strategy[node->op()](node->attrs, inputs, out_types, out_shapes, target_));
-  // if node op is custom_call, apply custom_call compute.
-  if (node->op()->name == "custom_call") {
+  // if node op is custom_call, or its strategy calls the external api directly, apply custom_call compute.
+  if (node->op()->name == "custom_call" || impl->name == "strategy.custom_call.x86") {
     std::string external_api;
     if (node->attrs.attr_store.count("custom_call")) {
       external_api = absl::get<std::string>(node->attrs.attr_store.at("custom_call"));
@@ -487,6 +563,7 @@ std::vector<ir::LoweredFunc> OpLowerer::IRLowerNonFusibleOp(GroupPtr& group, boo
     if (args.size() > input_output_nodes.size()) {
       args = lang::GetArgs(func_body, input_output_nodes);
     }
+    AddSymbolicArgs(inputs, group, &args);
     std::vector<ir::LoweredFunc> res;
     for (int i = 0; i < expr_pack.size(); i++) {
       ir::Expr func_body = expr_pack[0];
@@ -512,6 +589,33 @@ std::vector<ir::LoweredFunc> OpLowerer::IRLowerNonFusibleOp(GroupPtr& group, boo
   }
 }
 
+void OpLowerer::AddSymbolicArgs(const std::vector<ir::Tensor>& arg_tensors,
+                                const GroupPtr& group,
+                                std::vector<ir::Argument>* func_args) {
+  group->symbol_names.clear();
+  if (!symbolic_shapes_) {
+    return;
+  }
+  std::set<std::string> symbols;
+  for (auto& tensor : arg_tensors) {
+    for (auto& dim : tensor->shape) {
+      ir::CollectIRNodes(dim, [&](const Expr* x) {
+        if (x->as_var()) {
+          symbols.insert(x->as_var()->name);
+        }
+        return false;
+      });
+    }
+  }
+  // the symbols are the leading scalar arguments in the order of their names
+  std::vector<ir::Argument> symbolic_args;
+  for (auto& symbol : symbols) {
+    group->symbol_names.push_back(symbol);
+    symbolic_args.emplace_back(ir::Var(symbol), ir::Argument::IO::kInput);
+  }
+  func_args->insert(func_args->begin(), symbolic_args.begin(), symbolic_args.end());
+}
+
 // group schedule
 void OpLowerer::IRSchedule(ir::IRSchedule& ir_sch,
                            const GroupPtr& group,
@@ -627,7 +731,7 @@ void OpLowerer::IRSchedule(ir::IRSchedule& ir_sch,
     // auto loops = ir_sch.GetLoops(GetNodeData(node)->id());
     auto loops = ir_sch.GetLoops(block);
     VLOG(4) << "Op Pattern : " << loops.size();
-    if (loops.size() >= 1) {
+    if (loops.size() >= 1 && loops.back().As<ir::For>()->extent.is_constant()) {
       VLOG(4) << "Before vectorize, ir is: \n" << ir_sch.GetModule().GetExprs().at(0);
       auto loop_inner  = loops.back();
       int vector_width = 1;
@@ -652,6 +756,11 @@ void OpLowerer::IRSchedule(ir::IRSchedule& ir_sch,
     }
   }
 
+  if (FLAGS_cinn_use_cpu_reduce_schedule && target_.arch == Target::Arch::X86 &&
+      group->op_pattern_kind == framework::kReduction) {
+    pe::IRScheduleReduceCPU(ir_sch, target_);
+  }
+
   VLOG(3) << "Before Sync IRLowerOp schedule, ir is: \n" << ir_sch.GetModule().GetExprs().at(0);
   SyncThreadWithShared(ir_sch, group, nodes_inline, nodes_set, this->shape_dict_, tensor_map);
   VLOG(4) << "After IRSchedule,  ir is: \n" << ir_sch.GetModule().GetExprs().at(0);
@@ -37,6 +37,8 @@ namespace framework {
 
 using GroupPtr = std::shared_ptr<Graph::Group>;
 using common::Target;
+// the shapes of the tensors depending on the symbolic dims, whose extents are exprs of the symbols
+using SymbolicShapeDict = absl::flat_hash_map<std::string, std::vector<ir::Expr>>;
 
 class OpLowerer;
 typedef std::vector<Expr> (OpLowerer::*IRComputeFunction)(poly::StageMap&,
@@ -53,11 +55,15 @@ class OpLowerer {
             const Target&);
   std::vector<ir::LoweredFunc> Lower(GroupPtr& group);
   std::vector<ir::LoweredFunc> LowerWithoutSchedule(GroupPtr& group);
+  // lower the tensors in `symbolic_shapes` with their symbolic shapes instead of the upper bounds in the shape dict
+  void SetSymbolicShapes(const SymbolicShapeDict* symbolic_shapes) { symbolic_shapes_ = symbolic_shapes; }
 
  private:
   std::vector<ir::LoweredFunc> IRLowerOp(IRComputeFunction, GroupPtr&);
   std::vector<ir::LoweredFunc> IRLowerNonFusibleOp(GroupPtr&, bool);
   std::vector<ir::LoweredFunc> IRLowerOpWithoutSchedule(IRComputeFunction, GroupPtr&);
+  // lower the packed groups separately and dispatch across their function bodies in an outer parallel loop
+  std::vector<ir::LoweredFunc> LowerPackedGroups(GroupPtr& group, bool apply_schedule);
 #define DEFINE_IR_COMPUTE(type)                                                                \
   std::vector<Expr> IR##type##Compute(poly::StageMap& stages,                                  \
                                       std::vector<ir::Tensor>& func_args,                      \
@@ -75,9 +81,15 @@ class OpLowerer {
                   const GroupPtr& group,
                   const std::unordered_map<std::string, ir::Tensor>& tensor_map);
 
+  // prepend the symbols used by the shapes of `arg_tensors` to `func_args` and record them in the group
+  void AddSymbolicArgs(const std::vector<ir::Tensor>& arg_tensors,
+                       const GroupPtr& group,
+                       std::vector<ir::Argument>* func_args);
+
   Target target_;
   const absl::flat_hash_map<std::string, Type>& type_dict_;
   const absl::flat_hash_map<std::string, shape_t>& shape_dict_;
+  const SymbolicShapeDict* symbolic_shapes_{nullptr};
 
   // fucntion name prefix
   const std::string func_name_prefix = "fn_";
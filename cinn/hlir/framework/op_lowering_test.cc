@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 #include "cinn/backends/codegen_c_x86.h"
 #include "cinn/backends/codegen_cuda_dev.h"
 #include "cinn/backends/codegen_cuda_util.h"
@@ -25,6 +27,8 @@
 #include "cinn/common/target.h"
 #include "cinn/frontend/decomposer/test_helper.h"
 
+DECLARE_bool(cinn_use_cpu_reduce_schedule);
+
 namespace cinn {
 namespace hlir {
 namespace framework {
@@ -74,6 +78,93 @@ void Compile(NetBuilder& net_builder) {
   }
 }
 
+// Run the program on host with and without the CPU reduction schedule, check the outputs are the same and report the
+// average time of each run.
+void BenchmarkReduceOnHost(NetBuilder& net_builder, const std::string& input_name, const std::string& output_name) {
+  auto target  = common::DefaultHostTarget();
+  auto program = net_builder.Build();
+  RunDecomposer(&program, target);
+
+  constexpr int kRepeat = 100;
+  std::vector<float> input;
+  std::vector<std::vector<float>> outputs(2);
+  std::vector<double> costs(2);
+  for (int i = 0; i < 2; ++i) {
+    FLAGS_cinn_use_cpu_reduce_schedule = i == 1;
+    auto graph                         = std::make_shared<Graph>(program, target);
+    ApplyPasses(graph.get(), DefaultOpFusionPasses());
+    auto scope = BuildScope(target, graph);
+    GraphCompiler gc(target, scope, graph);
+    auto runtime_program = gc.Build();
+
+    auto tensor = scope->GetTensor(input_name);
+    if (input.empty()) {
+      InitRandomVector<float>(&input, tensor->shape().numel(), 0.0f, 1.0f);
+    }
+    CopyFromVector<float>(input, tensor, target);
+    runtime_program->Execute();
+    CopyToVector<float>(scope->GetTensor(output_name), &outputs[i]);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int j = 0; j < kRepeat; ++j) {
+      runtime_program->Execute();
+    }
+    costs[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kRepeat;
+  }
+  FLAGS_cinn_use_cpu_reduce_schedule = true;
+  LOG(INFO) << net_builder.name() << " costs " << costs[0] << " us without the CPU reduction schedule and " << costs[1]
+            << " us with it.";
+  CheckOutput<float>(outputs[1], outputs[0], 1e-5, 1e-4);
+}
+
+TEST(OP_LOWERING, Reduce_Schedule_CPU_Layernorm) {
+  int h = 256, w = 768;
+  NetBuilder net_builder("Reduce_Schedule_CPU_Layernorm");
+  auto A  = net_builder.CreateInput(Float(32), {h, w}, "A");
+  auto B  = net_builder.ReduceSum(A, {1});
+  auto C  = net_builder.ReduceSum(net_builder.Multiply(A, A), {1});
+  auto N  = net_builder.FillConstant<float>({h}, static_cast<float>(w), "N");
+  auto M  = net_builder.Divide(B, N);
+  auto V  = net_builder.Subtract(net_builder.Divide(C, N), net_builder.Multiply(M, M));
+  auto S  = net_builder.Sqrt(net_builder.Add(V, net_builder.FillConstant<float>({h}, 1e-5f, "eps")));
+  auto MM = net_builder.BroadcastTo(M, {h, w}, {0});
+  auto SS = net_builder.BroadcastTo(S, {h, w}, {0});
+  auto Y  = net_builder.Divide(net_builder.Subtract(A, MM), SS);
+
+  BenchmarkReduceOnHost(net_builder, "A", Y->id);
+}
+
+TEST(OP_LOWERING, Reduce_Schedule_CPU_Softmax) {
+  int h = 256, w = 768;
+  NetBuilder net_builder("Reduce_Schedule_CPU_Softmax");
+  auto A = net_builder.CreateInput(Float(32), {h, w}, "A");
+  auto B = net_builder.BroadcastTo(net_builder.ReduceMax(A, {1}), {h, w}, {0});
+  auto E = net_builder.Exp(net_builder.Subtract(A, B));
+  auto S = net_builder.BroadcastTo(net_builder.ReduceSum(E, {1}), {h, w}, {0});
+  auto Y = net_builder.Divide(E, S);
+
+  BenchmarkReduceOnHost(net_builder, "A", Y->id);
+}
+
+TEST(OP_LOWERING, Reduce_Schedule_CPU_Without_Last_Axis) {
+  int h = 768, w = 256;
+  NetBuilder net_builder("Reduce_Schedule_CPU_Without_Last_Axis");
+  auto A = net_builder.CreateInput(Float(32), {h, w}, "A");
+  auto B = net_builder.ReduceSum(A, {0});
+
+  BenchmarkReduceOnHost(net_builder, "A", B->id);
+}
+
+TEST(OP_LOWERING, Reduce_Schedule_CPU_Partials) {
+  // only 4 outputs, the reduction is split into parallel partials
+  int n = 4, h = 64, w = 1024;
+  NetBuilder net_builder("Reduce_Schedule_CPU_Partials");
+  auto A = net_builder.CreateInput(Float(32), {n, h, w}, "A");
+  auto B = net_builder.ReduceSum(A, {1, 2});
+
+  BenchmarkReduceOnHost(net_builder, "A", B->id);
+}
+
 TEST(OP_LOWERING, Reduce_Without_Last_Axis_3) {
   int h = 128, w = 128;
   NetBuilder net_builder("Reduce_Without_Last_Axis_3");
@@ -20,6 +20,8 @@
 #include "cinn/common/bfloat16.h"
 #include "cinn/common/float16.h"
 #endif
+#include <algorithm>
+#include <map>
 #include <queue>
 
 namespace cinn {
@@ -43,34 +45,43 @@ std::vector<NodeData*> GetInputNodeData(const Node* node) {
 
 ir::Tensor GetTensor(const NodeData* node_data,
                      const absl::flat_hash_map<std::string, Type>& type_dict,
-                     const absl::flat_hash_map<std::string, shape_t>& shape_dict) {
+                     const absl::flat_hash_map<std::string, shape_t>& shape_dict,
+                     const SymbolicShapeDict* symbolic_shapes) {
   auto dtype = type_dict.at(node_data->id());
+  std::vector<Expr> shape;
+  if (symbolic_shapes && symbolic_shapes->count(node_data->id())) {
+    shape = symbolic_shapes->at(node_data->id());
+  } else {
+    for (int dim : shape_dict.at(node_data->id())) {
+      shape.emplace_back(dim);
+    }
+  }
   if (dtype.is_float(32)) {
-    return lang::Placeholder<float>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<float>(node_data->id(), shape);
   } else if (dtype.is_float(64)) {
-    return lang::Placeholder<double>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<double>(node_data->id(), shape);
   } else if (dtype.is_bfloat16()) {
-    return lang::Placeholder<common::bfloat16>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<common::bfloat16>(node_data->id(), shape);
   } else if (dtype.is_float16()) {
-    return lang::Placeholder<common::float16>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<common::float16>(node_data->id(), shape);
   } else if (dtype.is_bool()) {
-    return lang::Placeholder<bool>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<bool>(node_data->id(), shape);
   } else if (dtype.is_int(8)) {
-    return lang::Placeholder<int8_t>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<int8_t>(node_data->id(), shape);
   } else if (dtype.is_int(16)) {
-    return lang::Placeholder<int16_t>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<int16_t>(node_data->id(), shape);
   } else if (dtype.is_int(32)) {
-    return lang::Placeholder<int32_t>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<int32_t>(node_data->id(), shape);
   } else if (dtype.is_int(64)) {
-    return lang::Placeholder<int64_t>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<int64_t>(node_data->id(), shape);
   } else if (dtype.is_uint(8)) {
-    return lang::Placeholder<uint8_t>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<uint8_t>(node_data->id(), shape);
   } else if (dtype.is_uint(16)) {
-    return lang::Placeholder<uint16_t>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<uint16_t>(node_data->id(), shape);
   } else if (dtype.is_uint(32)) {
-    return lang::Placeholder<uint32_t>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<uint32_t>(node_data->id(), shape);
   } else if (dtype.is_uint(64)) {
-    return lang::Placeholder<uint64_t>(node_data->id(), shape_dict.at(node_data->id()));
+    return lang::Placeholder<uint64_t>(node_data->id(), shape);
   } else {
     LOG(FATAL) << "Unsupport dtype: " << dtype;
   }
@@ -80,12 +91,13 @@ std::vector<ir::Tensor> CollectInputTensor(const Node* node,
                                            std::vector<ir::Tensor>& func_args,
                                            std::unordered_map<std::string, ir::Tensor>& tensor_map,
                                            const absl::flat_hash_map<std::string, Type>& type_dict,
-                                           const absl::flat_hash_map<std::string, shape_t>& shape_dict) {
+                                           const absl::flat_hash_map<std::string, shape_t>& shape_dict,
+                                           const SymbolicShapeDict* symbolic_shapes) {
   std::vector<ir::Tensor> tensors;
   // get all input nodes
   for (auto& node_data : GetInputNodeData(node)) {
     CHECK(node_data);
-    auto tensor = GetTensor(node_data, type_dict, shape_dict);
+    auto tensor = GetTensor(node_data, type_dict, shape_dict, symbolic_shapes);
     if (!tensor_map.count(node_data->id())) {
       tensor_map[node_data->id()] = tensor;
       // record func input args
@@ -1656,6 +1668,106 @@ void SyncThreadWithShared(ir::IRSchedule& ir_sch,
   }
 }
 
+void InferSymbolicShape(Graph* graph) {
+  if (!graph->HasAttr("symbolic_dims")) {
+    return;
+  }
+  auto& dtype_dict    = graph->GetAttrs<absl::flat_hash_map<std::string, Type>>("inferdtype");
+  auto& shape_dict    = graph->GetAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape");
+  auto& symbolic_dims = graph->GetAttrs<SymbolicDimDict>("symbolic_dims");
+
+  SymbolicShapeDict symbolic_shapes;
+  absl::flat_hash_map<std::string, int> upper_bounds;
+  for (auto& dims : symbolic_dims) {
+    auto& shape = shape_dict.at(dims.first);
+    std::vector<Expr> symbolic_shape;
+    for (int dim : shape) {
+      symbolic_shape.emplace_back(dim);
+    }
+    for (auto& dim : dims.second) {
+      CHECK_LT(dim.first, shape.size()) << "The symbolic axis " << dim.first << " of " << dims.first
+                                        << " is out of range.";
+      // the buffers of the inputs sharing a symbol are allocated by the same upper bound
+      auto bound = upper_bounds.emplace(dim.second, shape[dim.first]).first;
+      CHECK_EQ(bound->second, shape[dim.first]) << "The upper bounds of the symbol " << dim.second << " differ.";
+      symbolic_shape[dim.first] = ir::Var(dim.second);
+    }
+    symbolic_shapes[dims.first] = symbolic_shape;
+  }
+
+  auto& cinn_strategy   = Operator::GetAttrs<StrategyFunction>("CINNStrategy");
+  auto& op_pattern_dict = Operator::GetAttrs<OpPatternKind>("OpPattern");
+  for (auto graph_node : std::get<0>(graph->topological_order())) {
+    auto node = graph_node->safe_as<Node>();
+    // the external calls are lowered without compute, they process the upper bounds
+    if (!node || !node->op() || node->op()->name == "custom_call") {
+      continue;
+    }
+    std::vector<ir::Tensor> inputs;
+    std::vector<common::CINNValue> cinn_inputs;
+    bool is_symbolic = false;
+    for (auto node_data : GetInputNodeData(node)) {
+      is_symbolic |= symbolic_shapes.count(node_data->id()) > 0;
+      inputs.push_back(GetTensor(node_data, dtype_dict, shape_dict, &symbolic_shapes));
+      cinn_inputs.push_back(common::CINNValue(ir::Expr(inputs.back())));
+    }
+    if (!is_symbolic) {
+      continue;
+    }
+
+    std::vector<Type> out_types;
+    std::vector<shape_t> out_shapes;
+    auto node_datas = GetAllNodeData(node);
+    for (int i = 0; i < node_datas.size(); ++i) {
+      out_types.push_back(dtype_dict.at(node_datas[i]->id()));
+      out_shapes.push_back(shape_dict.at(node_datas[i]->id()));
+      // only the non-fusible ops name all their outputs, the same as lowering
+      if (i == 0 || op_pattern_dict[node->op()] == kNonFusible) {
+        cinn_inputs.push_back(common::CINNValue(node_datas[i]->id()));
+      }
+    }
+    auto impl =
+        OpStrategy::SelectImpl(cinn_strategy[node->op()](node->attrs, inputs, out_types, out_shapes, graph->target_));
+    if (impl->name == "strategy.custom_call.x86") {
+      continue;
+    }
+    common::CINNValuePack pack = impl->fcompute(common::CINNValuePack{cinn_inputs});
+    for (int i = 0; i < node_datas.size() && i + 1 < pack.size(); ++i) {
+      if (!pack[i].is_tensor()) {
+        continue;
+      }
+      auto shape = pack[i].operator ir::Expr().as_tensor_ref()->shape;
+      if (shape.size() == out_shapes[i].size() &&
+          std::any_of(shape.begin(), shape.end(), [](const Expr& dim) { return !dim.is_constant(); })) {
+        symbolic_shapes[node_datas[i]->id()] = shape;
+      } else {
+        VLOG(3) << "The output " << node_datas[i]->id() << " of " << node->id() << " keeps the upper bound shape.";
+      }
+    }
+  }
+  graph->attrs["symbolic_shapes"] = std::make_shared<absl::any>(symbolic_shapes);
+}
+
+std::vector<std::pair<std::string, int>> BindSymbolicDims(const Graph* graph, const std::vector<std::string>& symbols) {
+  std::map<std::string, std::pair<std::string, int>> bindings;
+  for (auto& dims : graph->GetAttrs<SymbolicDimDict>("symbolic_dims")) {
+    for (auto& dim : dims.second) {
+      auto binding = std::make_pair(dims.first, dim.first);
+      auto it      = bindings.find(dim.second);
+      // bind to the smallest input dim to be deterministic
+      if (it == bindings.end() || binding < it->second) {
+        bindings[dim.second] = binding;
+      }
+    }
+  }
+  std::vector<std::pair<std::string, int>> res;
+  for (auto& symbol : symbols) {
+    CHECK(bindings.count(symbol)) << "The symbol " << symbol << " is not a dim of the graph inputs.";
+    res.push_back(bindings.at(symbol));
+  }
+  return res;
+}
+
 }  // namespace framework
 }  // namespace hlir
 }  // namespace cinn
@@ -26,13 +26,27 @@ std::vector<NodeData*> GetInputNodeData(const Node* node);
 
 ir::Tensor GetTensor(const NodeData* node_data,
                      const absl::flat_hash_map<std::string, Type>& type_dict,
-                     const absl::flat_hash_map<std::string, shape_t>& shape_dict);
+                     const absl::flat_hash_map<std::string, shape_t>& shape_dict,
+                     const SymbolicShapeDict* symbolic_shapes = nullptr);
 
 std::vector<ir::Tensor> CollectInputTensor(const Node* node,
                                            std::vector<ir::Tensor>& func_args,
                                            std::unordered_map<std::string, ir::Tensor>& tensor_map,
                                            const absl::flat_hash_map<std::string, Type>& type_dict,
-                                           const absl::flat_hash_map<std::string, shape_t>& shape_dict);
+                                           const absl::flat_hash_map<std::string, shape_t>& shape_dict,
+                                           const SymbolicShapeDict* symbolic_shapes = nullptr);
+
+/**
+ * Propagate the symbolic dims of the graph inputs through the compute of the ops in topological order, and save the
+ * symbolic shapes of the tensors as the graph attr "symbolic_shapes". It does nothing for the graph without
+ * "symbolic_dims". The ops whose output extents do not depend on the input shapes keep their upper bounds.
+ */
+void InferSymbolicShape(Graph* graph);
+
+/**
+ * Bind the symbols to the graph input dims they are read from at runtime, as (input id, axis) pairs.
+ */
+std::vector<std::pair<std::string, int>> BindSymbolicDims(const Graph* graph, const std::vector<std::string>& symbols);
 
 std::unordered_map<Node*, Node*> BuildVirtualConsumer(const GroupPtr& group,
                                                       const absl::flat_hash_map<std::string, shape_t>& shape_dict);
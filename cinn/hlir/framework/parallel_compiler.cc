@@ -25,13 +25,17 @@
 #include "cinn/backends/llvm/codegen_x86.h"
 #include "cinn/backends/llvm/runtime_symbol_registry.h"
 #include "cinn/backends/nvrtc/nvrtc_util.h"
+#include "cinn/common/arena.h"
 #include "cinn/common/context.h"
+#include "cinn/hlir/framework/op_lowering_util.h"
 #include "cinn/hlir/framework/pass.h"
 #include "cinn/ir/module.h"
 #include "cinn/runtime/flags.h"
 
 DECLARE_int32(cinn_parallel_compile_size);
 DECLARE_int32(cinn_parallel_compile_thread);
+DECLARE_bool(cinn_use_simplify_cache);
+DECLARE_bool(cinn_use_ir_node_arena);
 
 namespace cinn {
 namespace hlir {
@@ -46,6 +50,8 @@ std::vector<std::unique_ptr<Instruction>> ParallelCompiler::operator()() {
   SplitTask();
   // launch task
   LaunchTask();
+  VLOG(2) << "Simplify cache: " << simplify_cache_.size() << " entries, " << simplify_cache_.hit_count() << " hits, "
+          << simplify_cache_.miss_count() << " misses, " << simplify_cache_.bypass_count() << " bypasses.";
   // merge instruction
   return MergeResult();
 }
@@ -87,10 +93,18 @@ void ParallelCompiler::SplitTask() {
 
 void RunTask(ParallelCompiler::Task* task) {
   VLOG(2) << "Stark run sub-task, Thread Id : " << std::this_thread::get_id();
-  VLOG(4) << "Start Lowering";
-  task->Lowering();
-  VLOG(4) << "Start CodegenAndJit";
-  task->CodegenAndJit();
+  {
+    // the IR nodes created by lowering and optimizing are mostly released by the same thread, recycle them locally
+    common::NodeArenaScope arena_scope(FLAGS_cinn_use_ir_node_arena);
+    VLOG(4) << "Start Lowering";
+    task->Lowering();
+    VLOG(4) << "Start CodegenAndJit";
+    task->CodegenAndJit();
+    if (arena_scope.arena()) {
+      VLOG(2) << "IR node arena: " << arena_scope.arena()->alloc_count() << " allocations, "
+              << arena_scope.arena()->reuse_count() << " reused.";
+    }
+  }
   VLOG(4) << "Start BuildInstruction";
   task->BuildInstruction();
   VLOG(2) << "Finish run sub-task, Thread Id : " << std::this_thread::get_id();
@@ -127,7 +141,11 @@ void ParallelCompiler::Task::Lowering() {
   auto& dtype_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, Type>>("inferdtype");
   auto& shape_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape");
 
+  common::SimplifyCacheScope simplify_cache_scope(FLAGS_cinn_use_simplify_cache ? &compiler->simplify_cache_ : nullptr);
   OpLowerer op_lowerer(dtype_dict, shape_dict, target);
+  if (graph->HasAttr("symbolic_shapes")) {
+    op_lowerer.SetSymbolicShapes(&graph->GetAttrs<SymbolicShapeDict>("symbolic_shapes"));
+  }
   while (true) {
     int idx = compiler->GetGroupIdx();
     if (idx < 0) {
@@ -206,6 +224,9 @@ void ParallelCompiler::Task::BuildInstruction() {
     CHECK(group->input_names.size() > 0 || group->output_names.size() > 0);
     auto instr = std::unique_ptr<Instruction>(
         new Instruction(target, scope.get(), group->input_names, group->output_names, group->GetFuncName()));
+    if (!group->symbol_names.empty()) {
+      instr->SetSymbolicDims(BindSymbolicDims(graph.get(), group->symbol_names));
+    }
 
     auto fn_ptr = engine->Lookup(group->GetFuncName());
     CHECK(fn_ptr) << "Can't find jit function : " << group->GetFuncName();
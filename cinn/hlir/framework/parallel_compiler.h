@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "cinn/backends/llvm/execution_engine.h"
+#include "cinn/common/simplify_cache.h"
 #include "cinn/common/target.h"
 #include "cinn/hlir/framework/graph.h"
 #include "cinn/hlir/framework/instruction.h"
@@ -85,6 +86,8 @@ class ParallelCompiler {
  private:
   int index{0};
   std::mutex mtx_;
+  // the memo of the simplified expressions shared by the lowering of all tasks
+  common::SimplifyCache simplify_cache_;
 
   const common::Target target_;
   const CompileOptions& option_;
@@ -16,6 +16,8 @@
 
 #include "cinn/hlir/framework/visualize_helper.h"
 #include "cinn/hlir/pass/use_pass.h"
+#include "cinn/utils/profiler.h"
+#include "cinn/utils/timer.h"
 
 namespace cinn {
 namespace hlir {
@@ -29,6 +31,8 @@ void ApplyPasses(Graph* g, const std::vector<std::string>& passes) {
     CHECK(reg) << "Cannot find pass " << name << " in the registry";
     fpass.push_back(reg);
   }
+  // the graph may be changed out of the passes since the last call
+  g->InvalidateAnalyses();
   for (auto* r : fpass) {
     cinn::hlir::framework::PassPrinter::GetInstance()->PassBegin(r->name, g);
     for (auto& dep : r->graph_attr_dependency) {
@@ -39,7 +43,15 @@ void ApplyPasses(Graph* g, const std::vector<std::string>& passes) {
         CHECK(!pass_dep) << "And the attribute is provided by pass [" << pass_dep->name << "].";
       }
     }
-    r->body(g);
+    utils::Timer timer;
+    timer.Start();
+    {
+      utils::RecordEvent pass_event(r->name, utils::EventType::kFusePass);
+      r->body(g);
+    }
+    // the analyses cached before the pass may be stale now
+    g->InvalidateAnalyses(r->preserved_analyses);
+    VLOG(1) << "Pass " << r->name << " costs " << timer.Stop() << " ms, " << g->num_nodes() << " nodes remain";
     cinn::hlir::framework::PassPrinter::GetInstance()->PassEnd(r->name, g);
   }
 }
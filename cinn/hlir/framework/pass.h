@@ -14,6 +14,7 @@
 
 #pragma once
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -46,6 +47,8 @@ class PassFunctionRegister : public FunctionRegEntryBase<PassFunctionRegister, P
   std::vector<std::string> graph_attr_dependency{};
   //! generated targets of graph attributes
   std::vector<std::string> graph_attr_targets{};
+  //! the analyses cached in the graph which are still valid after this pass
+  std::unordered_set<std::string> preserved_analyses{};
 
   /**
    * \brief Imply whether this pass will change the Graph's structure.
@@ -89,6 +92,17 @@ class PassFunctionRegister : public FunctionRegEntryBase<PassFunctionRegister, P
     graph_attr_dependency.push_back(attr_name);
     return *this;
   }
+
+  /**
+   * \brief Declare that this pass keeps the given analysis cached in the graph valid, the other analyses are
+   *        invalidated after the pass is applied.
+   * @param analysis_name Name of the analysis, e.g. Graph::kTopologicalOrder.
+   * @return Reference to self.
+   */
+  PassFunctionRegister& preserve_analysis(const std::string& analysis_name) {
+    preserved_analyses.insert(analysis_name);
+    return *this;
+  }
 };
 
 const PassFunctionRegister* FindPassDep(const std::string& attr_name);
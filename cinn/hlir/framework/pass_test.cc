@@ -0,0 +1,142 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/framework/pass.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "cinn/frontend/net_builder.h"
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/op/use_ops.h"
+#include "cinn/hlir/pass/use_pass.h"
+#include "cinn/utils/event.h"
+#include "cinn/utils/profiler.h"
+#include "cinn/utils/timer.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+int num_test_analysis_computed = 0;
+
+void QueryTestAnalysisPass(Graph* graph) {
+  graph->GetAnalysis<int>("test_analysis", [](Graph*) { return ++num_test_analysis_computed; });
+}
+
+CINN_REGISTER_PASS(QueryTestAnalysis)
+    .describe("This pass queries the test analysis and keeps it.")
+    .set_change_structure(false)
+    .preserve_analysis("test_analysis")
+    .set_body(QueryTestAnalysisPass);
+
+CINN_REGISTER_PASS(DropTestAnalysis)
+    .describe("This pass does not declare the test analysis preserved.")
+    .set_change_structure(false)
+    .set_body([](Graph* graph) {});
+
+std::vector<const std::vector<common::GraphNode*>*> recorded_topological_orders;
+
+CINN_REGISTER_PASS(RecordTopologicalOrder)
+    .describe("This pass records the address of the cached topological order.")
+    .set_change_structure(false)
+    .preserve_analysis(Graph::kTopologicalOrder)
+    .set_body([](Graph* graph) { recorded_topological_orders.push_back(&graph->CachedTopologicalOrder()); });
+
+TEST(ApplyPasses, preserve_analysis) {
+  frontend::NetBuilder builder("preserve_analysis");
+  auto x = builder.CreateInput(Float(32), {32, 16}, "x");
+  builder.Relu(x);
+  auto program = builder.Build();
+  auto graph   = std::make_shared<Graph>(program, common::DefaultHostTarget());
+
+  num_test_analysis_computed = 0;
+  ApplyPasses(graph.get(), {"QueryTestAnalysis", "QueryTestAnalysis"});
+  ASSERT_EQ(num_test_analysis_computed, 1);
+  ApplyPasses(graph.get(), {"QueryTestAnalysis", "DropTestAnalysis", "QueryTestAnalysis"});
+  // the analysis is dropped at the beginning of ApplyPasses and by DropTestAnalysis
+  ASSERT_EQ(num_test_analysis_computed, 3);
+
+  // the cached order is the same as the computed one until the analyses are invalidated
+  const auto& order = graph->CachedTopologicalOrder();
+  ASSERT_EQ(order, std::get<0>(graph->topological_order()));
+  ASSERT_EQ(&order, &graph->CachedTopologicalOrder());
+  graph->InvalidateAnalyses({Graph::kTopologicalOrder});
+  ASSERT_EQ(&order, &graph->CachedTopologicalOrder());
+}
+
+// A graph of num_layers residual blocks, each block has 6 op nodes.
+std::shared_ptr<Graph> BuildLargeGraph(int num_layers) {
+  frontend::NetBuilder builder("large_graph");
+  auto x = builder.CreateInput(Float(32), {64, 128}, "x");
+  auto w = builder.CreateInput(Float(32), {64, 128}, "w");
+
+  std::unordered_set<std::string> fetch_ids;
+  auto out = x;
+  for (int i = 0; i < num_layers; ++i) {
+    auto mul  = builder.Multiply(out, w);
+    auto relu = builder.Relu(mul);
+    auto sum  = builder.ReduceSum(relu, {1}, true);
+    auto bias = builder.BroadcastTo(sum, {64, 128});
+    auto sub  = builder.Subtract(relu, bias);
+    out       = builder.Add(out, sub);
+  }
+  fetch_ids.insert(out->id);
+  return std::make_shared<Graph>(builder.Build(), fetch_ids, common::DefaultHostTarget());
+}
+
+TEST(ApplyPasses, large_graph) {
+  int num_layers = 200;
+  auto graph     = BuildLargeGraph(num_layers);
+  LOG(INFO) << "The graph has " << graph->num_nodes() << " nodes";
+
+  utils::Timer timer;
+  timer.Start();
+  auto order     = std::get<0>(graph->topological_order());
+  auto sort_cost = timer.Stop();
+  ASSERT_EQ(order.size(), graph->num_nodes());
+  LOG(INFO) << "topological_order costs " << sort_cost << " ms";
+
+  // InferShape and ConstPropagate preserve the order, so it is sorted once and shared by the passes after them
+  recorded_topological_orders.clear();
+  ApplyPasses(graph.get(), {"RecordTopologicalOrder", "InferShape", "ConstPropagate", "RecordTopologicalOrder"});
+  ASSERT_EQ(recorded_topological_orders.size(), 2UL);
+  ASSERT_EQ(recorded_topological_orders[0], recorded_topological_orders[1]);
+  ASSERT_EQ(*recorded_topological_orders[0], order);
+
+  utils::ProfilerHelper::EnableCPU();
+  utils::HostEventRecorder::GetInstance().Clear();
+  std::vector<std::string> passes = {"CommonSubexpressionEliminationPass", "OpFusionPass", "FusionMergePass"};
+  timer.Start();
+  ApplyPasses(graph.get(), passes);
+  auto cost = timer.Stop();
+  LOG(INFO) << "ApplyPasses costs " << cost << " ms" << utils::HostEventRecorder::Table();
+
+  // every pass records its time
+  auto& events = utils::HostEventRecorder::GetInstance().Events();
+  for (auto& pass : passes) {
+    ASSERT_TRUE(std::any_of(events.begin(), events.end(), [&](const utils::HostEvent& event) {
+      return event.annotation_ == pass && event.type_ == utils::EventType::kFusePass;
+    })) << "No event of " << pass;
+  }
+  utils::HostEventRecorder::GetInstance().Clear();
+  utils::ProfilerHelper::g_state = utils::ProfilerState::kDisabled;
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
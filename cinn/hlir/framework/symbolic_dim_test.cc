@@ -0,0 +1,138 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "cinn/common/target.h"
+#include "cinn/frontend/net_builder.h"
+#include "cinn/frontend/optimize.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+
+namespace cinn {
+namespace hlir {
+namespace framework {
+
+using namespace frontend;
+
+namespace {
+
+constexpr int kMaxBatch = 64;
+constexpr int kHidden   = 256;
+
+struct CompiledModel {
+  std::shared_ptr<Scope> scope;
+  std::unique_ptr<Program> program;
+  std::string out_id;
+  double compile_time_ms;
+};
+
+// out = relu(x) * 2 + bias, the batch axis of x is symbolic when `symbolic` is true
+CompiledModel CompileModel(int batch, bool symbolic) {
+  auto start = std::chrono::steady_clock::now();
+  NetBuilder builder("symbolic_dim");
+  auto x = symbolic ? builder.CreateInput(Float(32), {batch, kHidden}, {{0, "batch_size"}}, "x")
+                    : builder.CreateInput(Float(32), {batch, kHidden}, "x");
+
+  auto bias = builder.CreateInput(Float(32), {kHidden}, "bias");
+  auto out  = builder.Add(builder.Scale(builder.Relu(x), 2.0f), bias);
+
+  auto target  = common::DefaultHostTarget();
+  auto program = builder.Build();
+  auto graph   = Optimize(&program, {out->id}, target);
+
+  CompiledModel model;
+  model.scope = BuildScope(target, graph);
+  GraphCompiler gc(target, model.scope, graph);
+  // the variables are allocated by the upper bounds of the symbolic dims
+  GraphCompiler::CompileOptions options;
+  options.with_instantiate_variables = true;
+  model.program                      = gc.Build(options).runtime_program;
+  model.out_id                       = out->id;
+
+  model.compile_time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return model;
+}
+
+// set the inputs of `batch` rows, the buffers allocated by the upper bound are reused
+void SetInputs(Scope* scope, int batch) {
+  auto target = common::DefaultHostTarget();
+  auto x      = scope->GetTensor("x");
+  x->Resize(Shape({batch, kHidden}));
+  auto* x_data = x->mutable_data<float>(target);
+  for (int i = 0; i < batch * kHidden; ++i) {
+    x_data[i] = static_cast<float>(i % 13) - 6.0f;
+  }
+  auto* bias_data = scope->GetTensor("bias")->mutable_data<float>(target);
+  for (int i = 0; i < kHidden; ++i) {
+    bias_data[i] = static_cast<float>(i % 7);
+  }
+}
+
+double RunMs(Program* program, int repeat) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; ++i) {
+    program->Execute();
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeat;
+}
+
+}  // namespace
+
+TEST(SymbolicDim, serve_all_batch_sizes) {
+  auto model = CompileModel(kMaxBatch, true);
+  for (int batch : {1, 7, 33, kMaxBatch}) {
+    SetInputs(model.scope.get(), batch);
+    // the tail of the output is filled to check that only `batch` rows are written
+    auto out      = model.scope->GetTensor(model.out_id);
+    auto* out_ptr = out->mutable_data<float>(common::DefaultHostTarget());
+    std::fill(out_ptr, out_ptr + kMaxBatch * kHidden, -1.0f);
+    model.program->Execute();
+
+    auto* x_ptr = model.scope->GetTensor("x")->data<float>();
+    for (int i = 0; i < batch * kHidden; ++i) {
+      ASSERT_FLOAT_EQ(out_ptr[i], std::max(x_ptr[i], 0.0f) * 2.0f + static_cast<float>(i % kHidden % 7))
+          << "batch " << batch << " index " << i;
+    }
+    for (int i = batch * kHidden; i < kMaxBatch * kHidden; ++i) {
+      ASSERT_EQ(out_ptr[i], -1.0f) << "batch " << batch << " index " << i;
+    }
+  }
+}
+
+TEST(SymbolicDim, benchmark_against_static_shape) {
+  constexpr int repeat = 100;
+  auto model           = CompileModel(kMaxBatch, true);
+
+  double static_compile_time_ms = 0;
+  for (int batch : {4, 16, kMaxBatch}) {
+    auto static_model = CompileModel(batch, false);
+    static_compile_time_ms += static_model.compile_time_ms;
+
+    SetInputs(model.scope.get(), batch);
+    SetInputs(static_model.scope.get(), batch);
+    double symbolic_ms = RunMs(model.program.get(), repeat);
+    double static_ms   = RunMs(static_model.program.get(), repeat);
+    LOG(INFO) << "batch " << batch << ": symbolic " << symbolic_ms << " ms, static " << static_ms
+              << " ms, throughput ratio " << static_ms / symbolic_ms;
+  }
+  LOG(INFO) << "Compile once costs " << model.compile_time_ms << " ms, compile per shape costs "
+            << static_compile_time_ms << " ms";
+}
+
+}  // namespace framework
+}  // namespace hlir
+}  // namespace cinn
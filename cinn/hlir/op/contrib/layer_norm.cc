@@ -0,0 +1,342 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/op/contrib/layer_norm.h"
+
+#include <gflags/gflags.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cinn/common/common.h"
+#include "cinn/common/context.h"
+#include "cinn/common/ir_util.h"
+#include "cinn/common/macros.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/op_strategy.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/ir_operators.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/tensor.h"
+#include "cinn/lang/builtin.h"
+#include "cinn/lang/compute.h"
+
+DECLARE_bool(cinn_ir_schedule);
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+using common::CINNValue;
+using common::CINNValuePack;
+
+namespace {
+
+int GetBeginNormAxis(int begin_norm_axis, int ndim) {
+  CHECK(-ndim <= begin_norm_axis && begin_norm_axis < ndim)
+      << "begin_norm_axis expected to be in range of [" << -ndim << "," << ndim << "). But got " << begin_norm_axis
+      << ".";
+  return begin_norm_axis < 0 ? begin_norm_axis + ndim : begin_norm_axis;
+}
+
+// the number of the elements of the axes in [begin, end)
+int GetNumel(const std::vector<Expr> &shape, int begin, int end) {
+  int numel = 1;
+  for (int i = begin; i < end; ++i) {
+    numel *= shape[i].as_int32();
+  }
+  return numel;
+}
+
+// the element (row, col) of x viewed as [rows, cols]
+Expr LoadAsMatrix(const ir::Tensor &x, const Expr &row, const Expr &col, int cols) {
+  Expr offset = row * Expr(cols) + col;
+  std::vector<Expr> indices(x->shape.size());
+  for (int i = static_cast<int>(x->shape.size()) - 1; i >= 0; --i) {
+    indices[i] = offset % x->shape[i];
+    offset     = offset / x->shape[i];
+  }
+  return x(indices);
+}
+
+// the row and the column of the element at `indices` of x viewed as [rows, cols]
+std::pair<Expr, Expr> GetRowAndCol(const ir::Tensor &x, const std::vector<Expr> &indices, int begin_norm_axis) {
+  Expr row(0);
+  Expr col(0);
+  for (int i = 0; i < begin_norm_axis; ++i) {
+    row = row * x->shape[i] + indices[i];
+  }
+  for (int i = begin_norm_axis; i < static_cast<int>(indices.size()); ++i) {
+    col = col * x->shape[i] + indices[i];
+  }
+  return {row, col};
+}
+
+// the sum of f(x[row, k]) over the columns k
+ir::Tensor RowSum(const ir::Tensor &x,
+                  int rows,
+                  int cols,
+                  const std::function<Expr(Expr, Expr)> &f,
+                  const std::string &name) {
+  Var k(Expr(cols), common::UniqName("reduce_k"));
+  return lang::Compute(
+      {Expr(rows)},
+      [=](const std::vector<Expr> &indices) {
+        return lang::ReduceSum(f(LoadAsMatrix(x, indices[0], k, cols), indices[0]), {k});
+      },
+      name);
+}
+
+framework::CINNSchedule GetNormSchedule(const std::string &op_name) {
+  return framework::CINNSchedule([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input argument of " << op_name << " schedule is empty! Please check.\n";
+    CINNValuePack arg_pack = args[0];
+    if (FLAGS_cinn_ir_schedule) {
+      std::vector<Expr> vec_ast;
+      for (int i = 0; i < arg_pack.size(); i++) {
+        if (arg_pack[i].is_expr()) {
+          Expr temp = arg_pack[i];
+          vec_ast.emplace_back(temp);
+        }
+      }
+      CHECK(!vec_ast.empty());
+      ir::ModuleExpr mod_expr(vec_ast);
+      ir::IRSchedule ir_sch(mod_expr);
+      ir_sch.MergeExprs();
+      std::vector<CINNValue> res{CINNValue(ir_sch.GetModule().GetExprs().at(0))};
+      *ret = CINNValuePack{res};
+    } else {
+      *ret = arg_pack;
+    }
+  });
+}
+
+}  // namespace
+
+std::vector<ir::Tensor> LayerNorm(const ir::Tensor &x,
+                                  const ir::Tensor &scale,
+                                  const ir::Tensor &bias,
+                                  int begin_norm_axis,
+                                  float epsilon,
+                                  const std::vector<std::string> &output_names) {
+  CHECK_EQ(output_names.size(), 3UL) << "The names of y, mean and variance are required.";
+  int ndim        = static_cast<int>(x->shape.size());
+  begin_norm_axis = GetBeginNormAxis(begin_norm_axis, ndim);
+  int rows        = GetNumel(x->shape, 0, begin_norm_axis);
+  int cols        = GetNumel(x->shape, begin_norm_axis, ndim);
+  Expr num_cols   = common::make_const(x->type(), cols);
+  Expr eps        = common::make_const(x->type(), epsilon);
+
+  // the variance is computed from the deviations to the mean, which does not cancel as E[x^2] - E[x]^2 does
+  auto sum = RowSum(
+      x, rows, cols, [](Expr value, Expr row) { return value; }, common::UniqName(output_names[1] + "_sum"));
+  auto mean = lang::Compute(
+      {Expr(rows)}, [=](const std::vector<Expr> &indices) { return sum(indices) / num_cols; }, output_names[1]);
+  auto square_sum = RowSum(
+      x,
+      rows,
+      cols,
+      [=](Expr value, Expr row) { return (value - mean(row)) * (value - mean(row)); },
+      common::UniqName(output_names[2] + "_sum"));
+  auto variance = lang::Compute(
+      {Expr(rows)}, [=](const std::vector<Expr> &indices) { return square_sum(indices) / num_cols; }, output_names[2]);
+  auto y = lang::Compute(
+      x->shape,
+      [=](const std::vector<Expr> &indices) {
+        auto row_col = GetRowAndCol(x, indices, begin_norm_axis);
+        return (x(indices) - mean(row_col.first)) / lang::Sqrt(variance(row_col.first) + eps) * scale(row_col.second) +
+               bias(row_col.second);
+      },
+      output_names[0]);
+  return {y, mean, variance, sum, square_sum};
+}
+
+std::vector<ir::Tensor> RmsNorm(const ir::Tensor &x,
+                                const ir::Tensor &scale,
+                                int begin_norm_axis,
+                                float epsilon,
+                                const std::string &output_name) {
+  int ndim        = static_cast<int>(x->shape.size());
+  begin_norm_axis = GetBeginNormAxis(begin_norm_axis, ndim);
+  int rows        = GetNumel(x->shape, 0, begin_norm_axis);
+  int cols        = GetNumel(x->shape, begin_norm_axis, ndim);
+  Expr num_cols   = common::make_const(x->type(), cols);
+  Expr eps        = common::make_const(x->type(), epsilon);
+
+  auto square_sum = RowSum(
+      x, rows, cols, [](Expr value, Expr row) { return value * value; }, common::UniqName(output_name + "_sum"));
+  auto y = lang::Compute(
+      x->shape,
+      [=](const std::vector<Expr> &indices) {
+        auto row_col = GetRowAndCol(x, indices, begin_norm_axis);
+        return x(indices) / lang::Sqrt(square_sum(row_col.first) / num_cols + eps) * scale(row_col.second);
+      },
+      output_name);
+  return {y, square_sum};
+}
+
+std::shared_ptr<framework::OpStrategy> StrategyForLayerNorm(const framework::NodeAttr &attrs,
+                                                            const std::vector<ir::Tensor> &inputs,
+                                                            const std::vector<Type> &out_type,
+                                                            const std::vector<std::vector<int>> &output_shapes,
+                                                            const Target &target) {
+  auto attr_store     = attrs.attr_store;
+  float epsilon       = attr_store.count("epsilon") ? absl::get<float>(attr_store.at("epsilon")) : 1e-5f;
+  int begin_norm_axis = attr_store.count("begin_norm_axis") ? absl::get<int>(attr_store.at("begin_norm_axis")) : 1;
+  CHECK(target.arch != Target::Arch::NVGPU) << "The layer_norm op should be decomposed on NVGPU.";
+
+  framework::CINNCompute layer_norm_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input arguments of LayerNorm compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 3U) << "3 input tensors for LayerNorm compute\n";
+    Expr x     = pack_args[0];
+    Expr scale = pack_args[1];
+    Expr bias  = pack_args[2];
+    CHECK(x.as_tensor() && scale.as_tensor() && bias.as_tensor());
+    auto stages = CreateStages({x.as_tensor_ref(), scale.as_tensor_ref(), bias.as_tensor_ref()});
+    std::vector<std::string> tensor_names{
+        common::UniqName("LayerNorm_out"), common::UniqName("LayerNorm_mean"), common::UniqName("LayerNorm_variance")};
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), 6U);
+      for (int i = 0; i < 3; ++i) {
+        CHECK(pack_args[3 + i].is_string());
+        tensor_names[i] = pack_args[3 + i].operator std::string();
+      }
+    }
+    auto out = LayerNorm(
+        x.as_tensor_ref(), scale.as_tensor_ref(), bias.as_tensor_ref(), begin_norm_axis, epsilon, tensor_names);
+    std::vector<CINNValue> res;
+    for (auto &t : out) {
+      stages->InsertLazily(t);
+      res.push_back(CINNValue(t));
+    }
+    CHECK(!out_type.empty()) << "Output type of LayerNorm is empty! Please check.\n";
+    res.push_back(CINNValue(stages));
+    *ret = CINNValuePack{res};
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(layer_norm_compute, GetNormSchedule("layer_norm"), "strategy.layer_norm", 1);
+  return strategy;
+}
+
+std::shared_ptr<framework::OpStrategy> StrategyForRmsNorm(const framework::NodeAttr &attrs,
+                                                          const std::vector<ir::Tensor> &inputs,
+                                                          const std::vector<Type> &out_type,
+                                                          const std::vector<std::vector<int>> &output_shapes,
+                                                          const Target &target) {
+  auto attr_store     = attrs.attr_store;
+  float epsilon       = attr_store.count("epsilon") ? absl::get<float>(attr_store.at("epsilon")) : 1e-6f;
+  int begin_norm_axis = attr_store.count("begin_norm_axis") ? absl::get<int>(attr_store.at("begin_norm_axis")) : -1;
+  CHECK(target.arch != Target::Arch::NVGPU) << "The rms_norm op should be decomposed on NVGPU.";
+
+  framework::CINNCompute rms_norm_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input arguments of RmsNorm compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 2U) << "2 input tensors for RmsNorm compute\n";
+    Expr x     = pack_args[0];
+    Expr scale = pack_args[1];
+    CHECK(x.as_tensor() && scale.as_tensor());
+    auto stages      = CreateStages({x.as_tensor_ref(), scale.as_tensor_ref()});
+    auto tensor_name = common::UniqName("RmsNorm_out");
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), 3U);
+      CHECK(pack_args[2].is_string());
+      tensor_name = pack_args[2].operator std::string();
+    }
+    auto out = RmsNorm(x.as_tensor_ref(), scale.as_tensor_ref(), begin_norm_axis, epsilon, tensor_name);
+    std::vector<CINNValue> res;
+    for (auto &t : out) {
+      stages->InsertLazily(t);
+      res.push_back(CINNValue(t));
+    }
+    CHECK(!out_type.empty()) << "Output type of RmsNorm is empty! Please check.\n";
+    res.push_back(CINNValue(stages));
+    *ret = CINNValuePack{res};
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(rms_norm_compute, GetNormSchedule("rms_norm"), "strategy.rms_norm", 1);
+  return strategy;
+}
+
+std::vector<std::vector<int>> InferShapeForLayerNorm(const std::vector<std::vector<int>> &inputs_shape,
+                                                     const framework::AttrMapType &attrs) {
+  // the frontend may omit the scale and bias, which the decomposer fills before lowering
+  CHECK(!inputs_shape.empty() && inputs_shape.size() <= 3UL)
+      << "The input's shape size should be 1 to 3! Please check again.";
+  auto &x_shape       = inputs_shape[0];
+  int ndim            = static_cast<int>(x_shape.size());
+  int begin_norm_axis = attrs.count("begin_norm_axis") ? absl::get<int>(attrs.at("begin_norm_axis")) : 1;
+  begin_norm_axis     = GetBeginNormAxis(begin_norm_axis, ndim);
+  int rows            = 1;
+  for (int i = 0; i < begin_norm_axis; ++i) {
+    rows *= x_shape[i];
+  }
+  return {x_shape, {rows}, {rows}};
+}
+
+std::vector<Type> InferDtypeForLayerNorm(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK(!inputs_type.empty() && inputs_type.size() <= 3UL)
+      << "The input's type size should be 1 to 3! Please check again.";
+  // the statistics of the half precision inputs are computed in float32
+  auto stat_type = inputs_type[0].is_float16() || inputs_type[0].is_bfloat16() ? Float(32) : inputs_type[0];
+  return {inputs_type[0], stat_type, stat_type};
+}
+
+std::vector<std::vector<int>> InferShapeForRmsNorm(const std::vector<std::vector<int>> &inputs_shape,
+                                                   const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 2UL) << "The input's shape size should be 2! Please check again.";
+  int begin_norm_axis = attrs.count("begin_norm_axis") ? absl::get<int>(attrs.at("begin_norm_axis")) : -1;
+  GetBeginNormAxis(begin_norm_axis, static_cast<int>(inputs_shape[0].size()));
+  return {inputs_shape[0]};
+}
+
+std::vector<Type> InferDtypeForRmsNorm(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_type.size(), 2UL) << "The input's type size should be 2! Please check again.";
+  return {inputs_type[0]};
+}
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(layer_norm_ops) {
+  CINN_REGISTER_OP(layer_norm)
+      .describe("Layer normalization of x over the axes from begin_norm_axis, also outputs the mean and variance.")
+      .set_num_inputs(3)
+      .set_num_outputs(3)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForLayerNorm)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForLayerNorm))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForLayerNorm))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
+      .set_support_level(4);
+
+  CINN_REGISTER_OP(rms_norm)
+      .describe("Root mean square normalization of x over the axes from begin_norm_axis.")
+      .set_num_inputs(2)
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForRmsNorm)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForRmsNorm))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForRmsNorm))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
+      .set_support_level(4);
+
+  return true;
+}
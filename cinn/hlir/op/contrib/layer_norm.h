@@ -0,0 +1,57 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/tensor.h"
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+/**
+ * @brief Layer normalization of x viewed as [rows, cols], where the axes from begin_norm_axis are the columns:
+ * y = (x - mean) / sqrt(variance + epsilon) * scale + bias. This is the fallback of the host
+ * `cinn_call_layer_norm_host` kernel when custom call is disabled.
+ * @param scale The scale of shape [cols].
+ * @param bias The bias of shape [cols].
+ * @param output_names The names of y, mean and variance.
+ * @return {y, mean, variance, the tensors of the row sums}
+ */
+std::vector<ir::Tensor> LayerNorm(const ir::Tensor& x,
+                                  const ir::Tensor& scale,
+                                  const ir::Tensor& bias,
+                                  int begin_norm_axis,
+                                  float epsilon,
+                                  const std::vector<std::string>& output_names);
+
+/**
+ * @brief Root mean square normalization of x viewed as [rows, cols]: y = x / sqrt(mean(x^2) + epsilon) * scale. This
+ * is the fallback of the host `cinn_call_rms_norm_host` kernel when custom call is disabled.
+ * @return {y, the tensor of the row sums of squares}
+ */
+std::vector<ir::Tensor> RmsNorm(const ir::Tensor& x,
+                                const ir::Tensor& scale,
+                                int begin_norm_axis,
+                                float epsilon,
+                                const std::string& output_name = "T_RmsNorm_out");
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,77 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/op/contrib/layer_norm.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "cinn/backends/codegen_c.h"
+#include "cinn/backends/codegen_c_x86.h"
+#include "cinn/common/context.h"
+#include "cinn/lang/lower.h"
+#include "cinn/lang/placeholder.h"
+#include "cinn/poly/stage.h"
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+TEST(GenerateCode_Cpu, LayerNorm) {
+  common::Context::Global().ResetNameId();
+
+  Target target = common::DefaultHostTarget();
+  lang::Placeholder<float> x("x", {Expr(4), Expr(8), Expr(32)});
+  lang::Placeholder<float> scale("scale", {Expr(256)});
+  lang::Placeholder<float> bias("bias", {Expr(256)});
+
+  auto out = LayerNorm(x, scale, bias, 1, 1e-5f, {"test_layer_norm_y", "test_layer_norm_mean", "test_layer_norm_var"});
+  ASSERT_EQ(out.size(), 5U);
+  ASSERT_EQ(out[0]->name, "test_layer_norm_y");
+  ASSERT_EQ(out[1]->shape.size(), 1U);
+  ASSERT_EQ(out[1]->shape[0].as_int32(), 4);
+  ASSERT_EQ(out[2]->name, "test_layer_norm_var");
+  ASSERT_EQ(RmsNorm(x, scale, -2, 1e-6f, "test_rms_norm_y").size(), 2U);
+
+  std::vector<ir::Tensor> tensors{x, scale, bias};
+  tensors.insert(tensors.end(), out.begin(), out.end());
+  poly::StageMap stages = poly::CreateStages(tensors);
+
+  std::vector<ir::Tensor> func_args{x, scale, bias, out[0], out[1], out[2]};
+  std::vector<ir::LoweredFunc> funcs =
+      lang::LowerVec("TestGenerateCodeCpu_LayerNorm", stages, func_args, {}, {}, nullptr, target, true);
+
+  VLOG(6) << "Expr before CPU codegen:";
+  VLOG(6) << funcs[0]->body;
+
+  ir::Module::Builder builder("LayerNorm_Module", target);
+  for (auto& f : funcs) {
+    builder.AddFunction(f);
+  }
+
+  backends::CodeGenCX86 codegen(target, backends::CodeGenCX86::Feature::AVX512);
+  codegen.SetInlineBuiltinCodes(false);
+  std::string code = codegen.Compile(builder.Build(), backends::CodeGenC::OutputKind::CImpl);
+  VLOG(6) << "Cpu Codegen result:";
+  VLOG(6) << code << std::endl;
+  // the rows are reduced over the 256 normalized elements
+  ASSERT_NE(code.find("256"), std::string::npos);
+}
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
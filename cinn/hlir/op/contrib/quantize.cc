@@ -0,0 +1,574 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/op/contrib/quantize.h"
+
+#include <gflags/gflags.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cinn/common/cas.h"
+#include "cinn/common/common.h"
+#include "cinn/common/context.h"
+#include "cinn/common/ir_util.h"
+#include "cinn/common/macros.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/op_strategy.h"
+#include "cinn/hlir/op/op_util.h"
+#include "cinn/hlir/pe/ir_schedule_pe.h"
+#include "cinn/hlir/pe/schedule.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/ir_operators.h"
+#include "cinn/ir/ir_schedule_util.h"
+#include "cinn/ir/tensor.h"
+#include "cinn/lang/builtin.h"
+#include "cinn/lang/compute.h"
+
+DECLARE_bool(cinn_ir_schedule);
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+using common::CINNValue;
+using common::CINNValuePack;
+using framework::shape_t;
+
+namespace {
+// The number of int8 values accumulated into one int32 lane by a `vpdpbusd`-style dot product.
+constexpr int kInt8DotGroup = 4;
+
+std::pair<float, float> GetQuantizeRange(const Type &type) {
+  if (type.is_int(8)) {
+    return {-128.f, 127.f};
+  } else if (type.is_uint(8)) {
+    return {0.f, 255.f};
+  }
+  LOG(FATAL) << "Quantize only supports int8 and uint8 output, but got " << type;
+  return {0.f, 0.f};
+}
+
+Expr RoundAndClamp(const Expr &value, int zero_point, const Type &out_type) {
+  auto range = GetQuantizeRange(out_type);
+  Expr q     = lang::Round(value) + Expr(static_cast<float>(zero_point));
+  q          = ir::Min::Make(ir::Max::Make(q, Expr(range.first)), Expr(range.second));
+  return ir::Cast::Make(out_type, q);
+}
+
+Expr ToInt32(const Expr &e) { return ir::Cast::Make(Int(32), e); }
+
+void CheckInt8Type(const ir::Tensor &tensor, const std::string &op_name) {
+  CHECK(tensor->type().is_int(8) || tensor->type().is_uint(8))
+      << "The inputs of " << op_name << " should be int8 or uint8, but got " << tensor->type();
+}
+}  // namespace
+
+ir::Tensor Quantize(
+    const ir::Tensor &x, float scale, int zero_point, const Type &out_type, const std::string &output_name) {
+  CHECK(x->type().is_float()) << "The input of quantize should be float, but got " << x->type();
+  CHECK_GT(scale, 0.f) << "The scale of quantize should be positive!";
+  return Compute(
+      x->shape,
+      [=](const std::vector<Expr> &indices) {
+        Expr value = ir::Cast::Make(Float(32), x(indices)) * Expr(1.0f / scale);
+        return RoundAndClamp(value, zero_point, out_type);
+      },
+      output_name);
+}
+
+ir::Tensor Dequantize(
+    const ir::Tensor &x, float scale, int zero_point, const Type &out_type, const std::string &output_name) {
+  CHECK(x->type().is_int() || x->type().is_uint()) << "The input of dequantize should be integer, but got "
+                                                    << x->type();
+  CHECK(out_type.is_float()) << "The output of dequantize should be float, but got " << out_type;
+  return Compute(
+      x->shape,
+      [=](const std::vector<Expr> &indices) {
+        Expr value = (ir::Cast::Make(Float(32), x(indices)) - Expr(static_cast<float>(zero_point))) * Expr(scale);
+        return out_type.is_float(32) ? value : ir::Cast::Make(out_type, value);
+      },
+      output_name);
+}
+
+ir::Tensor Requantize(const ir::Tensor &x,
+                      float input_scale,
+                      float output_scale,
+                      int zero_point,
+                      const Type &out_type,
+                      const std::string &output_name) {
+  CHECK(x->type().is_int(32)) << "The input of requantize should be int32, but got " << x->type();
+  CHECK_GT(output_scale, 0.f) << "The output scale of requantize should be positive!";
+  float multiplier = input_scale / output_scale;
+  return Compute(
+      x->shape,
+      [=](const std::vector<Expr> &indices) {
+        return RoundAndClamp(ir::Cast::Make(Float(32), x(indices)) * Expr(multiplier), zero_point, out_type);
+      },
+      output_name);
+}
+
+int GetInt8DotLanes(int reduce_extent, int spatial_extent, const common::Target &target) {
+  if (target.arch != common::Target::Arch::X86 || reduce_extent % kInt8DotGroup != 0) {
+    return 1;
+  }
+  // start from the native int32 vector width, and fall back to the narrower vnni encodings
+  int lanes = pe::GetBasicFactor(Int(32), target);
+  while (lanes >= kInt8DotGroup && spatial_extent % lanes != 0) {
+    lanes /= 2;
+  }
+  return lanes >= kInt8DotGroup ? lanes : 1;
+}
+
+std::vector<ir::Tensor> MatmulInt8(const ir::Tensor &A,
+                                   const ir::Tensor &B,
+                                   bool trans_b,
+                                   const common::Target &target,
+                                   const std::string &output_name) {
+  CHECK_EQ(A->shape.size(), 2U) << "The first input of matmul_int8 should be 2-D [M, K]!";
+  CHECK_EQ(B->shape.size(), 2U) << "The second input of matmul_int8 should be 2-D!";
+  CheckInt8Type(A, "matmul_int8");
+  CheckInt8Type(B, "matmul_int8");
+
+  Expr M   = A->shape[0];
+  Expr K   = A->shape[1];
+  Expr N   = trans_b ? B->shape[0] : B->shape[1];
+  Expr K_b = trans_b ? B->shape[1] : B->shape[0];
+  CHECK(MathEqual(K, K_b)) << "The reduce dimensions of matmul_int8's inputs should be equal, but got " << K << " vs "
+                           << K_b;
+
+  auto load_b = [=](Expr k, Expr n) { return trans_b ? B(n, k) : B(k, n); };
+
+  int lanes = GetInt8DotLanes(K.as_int32(), N.as_int32(), target);
+  if (lanes == 1) {
+    VLOG(3) << "matmul_int8 cannot use the vnni layout, use the plain reduction instead.";
+    Var k(K, UniqName("reduce_k"));
+    auto out = Compute(
+        {M, N},
+        [=](Expr i, Expr j) { return lang::ReduceSum(ToInt32(A(i, k)) * ToInt32(load_b(k, j)), {k}); },
+        output_name);
+    return {out};
+  }
+
+  // {N / lanes, K / 4, lanes, 4}
+  int k_outer   = K.as_int32() / kInt8DotGroup;
+  auto packed_b = Compute(
+      {Expr(N.as_int32() / lanes), Expr(k_outer), Expr(lanes), Expr(kInt8DotGroup)},
+      [=](Expr no, Expr ko, Expr ni, Expr ki) { return load_b(ko * kInt8DotGroup + ki, no * lanes + ni); },
+      UniqName("packed_b_int8"));
+
+  Var ko(Expr(k_outer), UniqName("reduce_ko"));
+  Var ki(Expr(kInt8DotGroup), UniqName("reduce_ki"));
+  auto out = Compute(
+      {M, N},
+      [=](Expr i, Expr j) {
+        return lang::ReduceSum(
+            ToInt32(A(i, ko * kInt8DotGroup + ki)) * ToInt32(packed_b(j / lanes, ko, j % lanes, ki)), {ko, ki});
+      },
+      output_name);
+  return {out, packed_b};
+}
+
+std::vector<ir::Tensor> Conv2dInt8NCHW(const ir::Tensor &input,
+                                       const ir::Tensor &weight,
+                                       const std::vector<int> &strides,
+                                       const std::vector<int> &paddings,
+                                       const std::vector<int> &dilations,
+                                       const common::Target &target,
+                                       const std::string &output_name) {
+  CHECK_EQ(input->shape.size(), 4U) << "Input's dimension of conv2d_int8 op is not 4! Please check.";
+  CHECK_EQ(weight->shape.size(), 4U) << "Weight's dimension of conv2d_int8 op is not 4! Please check.";
+  CHECK_EQ(strides.size(), 2U);
+  CHECK_EQ(paddings.size(), 2U);
+  CHECK_EQ(dilations.size(), 2U);
+  CheckInt8Type(input, "conv2d_int8");
+  CheckInt8Type(weight, "conv2d_int8");
+  CHECK(MathEqual(input->shape[1], weight->shape[1])) << "conv2d_int8 only supports groups = 1!";
+
+  int stride_h = strides[0], stride_w = strides[1];
+  int pad_h = paddings[0], pad_w = paddings[1];
+  int dilation_h = dilations[0], dilation_w = dilations[1];
+
+  int batch       = input->shape[0].as_int32();
+  int in_channel  = input->shape[1].as_int32();
+  int in_h        = input->shape[2].as_int32();
+  int in_w        = input->shape[3].as_int32();
+  int out_channel = weight->shape[0].as_int32();
+  int kernel_h    = weight->shape[2].as_int32();
+  int kernel_w    = weight->shape[3].as_int32();
+  int out_h       = (in_h - ((kernel_h - 1) * dilation_h + 1) + 2 * pad_h) / stride_h + 1;
+  int out_w       = (in_w - ((kernel_w - 1) * dilation_w + 1) + 2 * pad_w) / stride_w + 1;
+  std::vector<Expr> output_shape{Expr(batch), Expr(out_channel), Expr(out_h), Expr(out_w)};
+
+  auto input_pad = Compute(
+      {Expr(batch), Expr(in_channel), Expr(in_h + 2 * pad_h), Expr(in_w + 2 * pad_w)},
+      [=](Expr nn, Expr cc, Expr yy, Expr xx) {
+        if (pad_h == 0 && pad_w == 0) {
+          return input(nn, cc, yy, xx);
+        }
+        auto cond = lang::logic_and({yy >= pad_h, yy < in_h + pad_h, xx >= pad_w, xx < in_w + pad_w});
+        return ir::Select::Make(cond, input(nn, cc, yy - pad_h, xx - pad_w), ir::Zero(input->type()));
+      },
+      UniqName("input_pad"));
+
+  Var ry(Expr(kernel_h), UniqName("ry"));
+  Var rx(Expr(kernel_w), UniqName("rx"));
+  auto load_input = [=](Expr nn, Expr cc, Expr yy, Expr xx) {
+    return ToInt32(input_pad(nn, cc, yy * stride_h + ry * dilation_h, xx * stride_w + rx * dilation_w));
+  };
+
+  int lanes = GetInt8DotLanes(in_channel, out_channel, target);
+  if (lanes == 1) {
+    VLOG(3) << "conv2d_int8 cannot use the vnni layout, use the plain reduction instead.";
+    Var rc(Expr(in_channel), UniqName("rc"));
+    auto out = Compute(
+        output_shape,
+        [=](Expr nn, Expr ff, Expr yy, Expr xx) {
+          return lang::ReduceSum(load_input(nn, rc, yy, xx) * ToInt32(weight(ff, rc, ry, rx)), {rc, ry, rx});
+        },
+        output_name);
+    return {out, input_pad};
+  }
+
+  // {O / lanes, C / 4, KH, KW, lanes, 4}
+  int c_outer        = in_channel / kInt8DotGroup;
+  auto packed_weight = Compute(
+      {Expr(out_channel / lanes), Expr(c_outer), Expr(kernel_h), Expr(kernel_w), Expr(lanes), Expr(kInt8DotGroup)},
+      [=](Expr oo, Expr co, Expr kh, Expr kw, Expr oi, Expr ci) {
+        return weight(oo * lanes + oi, co * kInt8DotGroup + ci, kh, kw);
+      },
+      UniqName("packed_weight_int8"));
+
+  Var rco(Expr(c_outer), UniqName("rco"));
+  Var rci(Expr(kInt8DotGroup), UniqName("rci"));
+  auto out = Compute(
+      output_shape,
+      [=](Expr nn, Expr ff, Expr yy, Expr xx) {
+        return lang::ReduceSum(load_input(nn, rco * kInt8DotGroup + rci, yy, xx) *
+                                   ToInt32(packed_weight(ff / lanes, rco, ry, rx, ff % lanes, rci)),
+                               {rco, ry, rx, rci});
+      },
+      output_name);
+  return {out, input_pad, packed_weight};
+}
+
+void IRScheduleInt8DotCPU(ir::IRSchedule &ir_sch, const std::string &output_name, const common::Target &target) {
+  VLOG(3) << "Before IRScheduleInt8DotCPU, ir is:\n" << ir_sch.GetModule().GetExprs().at(0);
+  auto out_block = ir_sch.GetBlock(output_name);
+  auto tensor    = ir::GetTensor(out_block);
+  int rank       = tensor->shape.size();
+  auto loops     = ir_sch.GetLoops(out_block);
+  CHECK_GT(loops.size(), rank);
+
+  // the innermost reduce loop is the 4-wide int8 group of the dot product, unroll it so that the
+  // group turns into a straight-line multiply-accumulate which the backend can select to `vpdpbusd`.
+  if (ir::GetLoopExtent(loops.back()) == kInt8DotGroup) {
+    ir_sch.Unroll(loops.back());
+  }
+
+  // the spatial loops share the reduce init, so only the outer ones are fused and parallelized.
+  loops = ir_sch.GetLoops(output_name);
+  if (rank > 2) {
+    ir_sch.Fuse({loops[0], loops[1]});
+    loops = ir_sch.GetLoops(output_name);
+  }
+  if (ir::GetLoopExtent(loops[0]) > 1) {
+    ir_sch.Parallel(loops[0]);
+  }
+  VLOG(3) << "After IRScheduleInt8DotCPU, ir is:\n" << ir_sch.GetModule().GetExprs().at(0);
+}
+
+#define DEFINE_QUANTIZE_STRATEGY(op_name__, compute_expr__)                                                   \
+  framework::CINNCompute op_name__##_compute([=](lang::Args args, lang::RetValue *ret) {                     \
+    CHECK(!args.empty()) << "The input argument of " #op_name__ " compute is empty! Please check.\n";         \
+    CINNValuePack pack_args = args[0];                                                                        \
+    CHECK(!pack_args.empty()) << "at least one input tensor for " #op_name__ " compute\n";                    \
+    std::string tensor_name = UniqName(#op_name__ "_out");                                                    \
+    if (FLAGS_cinn_ir_schedule) {                                                                             \
+      CHECK_EQ(pack_args.size(), 2U);                                                                         \
+      CHECK(pack_args[1].is_string());                                                                        \
+      tensor_name = pack_args[1].operator std::string();                                                      \
+    }                                                                                                         \
+    Expr x_expr = pack_args[0];                                                                               \
+    CHECK(x_expr.as_tensor());                                                                                \
+    ir::Tensor x   = x_expr.as_tensor_ref();                                                                  \
+    auto stages    = CreateStages({x});                                                                       \
+    ir::Tensor out = compute_expr__;                                                                          \
+    stages->InsertLazily(out);                                                                                \
+    *ret = CINNValuePack{{CINNValue(out), CINNValue(stages)}};                                                \
+  });                                                                                                         \
+  auto strategy = std::make_shared<framework::OpStrategy>();                                                  \
+  strategy->AddImpl(                                                                                          \
+      op_name__##_compute, GetElementwiseScheduleFunc(output_shapes, target), "strategy." #op_name__ ".x86", 1); \
+  return strategy;
+
+std::shared_ptr<framework::OpStrategy> StrategyForQuantize(const framework::NodeAttr &attrs,
+                                                           const std::vector<ir::Tensor> &inputs,
+                                                           const std::vector<Type> &out_type,
+                                                           const std::vector<std::vector<int>> &output_shapes,
+                                                           const Target &target) {
+  float scale     = SafeGetAttr(attrs.attr_store, "scale", 1.0f);
+  int zero_point  = SafeGetAttr(attrs.attr_store, "zero_point", 0);
+  Type dtype      = common::Str2Type(SafeGetAttr(attrs.attr_store, "dtype", std::string("int8")));
+  DEFINE_QUANTIZE_STRATEGY(quantize, Quantize(x, scale, zero_point, dtype, tensor_name))
+}
+
+std::shared_ptr<framework::OpStrategy> StrategyForDequantize(const framework::NodeAttr &attrs,
+                                                             const std::vector<ir::Tensor> &inputs,
+                                                             const std::vector<Type> &out_type,
+                                                             const std::vector<std::vector<int>> &output_shapes,
+                                                             const Target &target) {
+  float scale    = SafeGetAttr(attrs.attr_store, "scale", 1.0f);
+  int zero_point = SafeGetAttr(attrs.attr_store, "zero_point", 0);
+  Type dtype     = common::Str2Type(SafeGetAttr(attrs.attr_store, "dtype", std::string("float32")));
+  DEFINE_QUANTIZE_STRATEGY(dequantize, Dequantize(x, scale, zero_point, dtype, tensor_name))
+}
+
+std::shared_ptr<framework::OpStrategy> StrategyForRequantize(const framework::NodeAttr &attrs,
+                                                             const std::vector<ir::Tensor> &inputs,
+                                                             const std::vector<Type> &out_type,
+                                                             const std::vector<std::vector<int>> &output_shapes,
+                                                             const Target &target) {
+  float input_scale  = SafeGetAttr(attrs.attr_store, "input_scale", 1.0f);
+  float output_scale = SafeGetAttr(attrs.attr_store, "output_scale", 1.0f);
+  int zero_point     = SafeGetAttr(attrs.attr_store, "zero_point", 0);
+  Type dtype         = common::Str2Type(SafeGetAttr(attrs.attr_store, "dtype", std::string("int8")));
+  DEFINE_QUANTIZE_STRATEGY(requantize, Requantize(x, input_scale, output_scale, zero_point, dtype, tensor_name))
+}
+
+#undef DEFINE_QUANTIZE_STRATEGY
+
+namespace {
+framework::CINNSchedule GetInt8DotSchedule(const std::string &op_name, const Target &target) {
+  return framework::CINNSchedule([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input argument of " << op_name << " schedule is empty! Please check.\n";
+    CINNValuePack arg_pack = args[0];
+    if (FLAGS_cinn_ir_schedule) {
+      std::vector<Expr> vec_ast;
+      std::string output_name;
+      for (int i = 0; i < arg_pack.size(); i++) {
+        if (arg_pack[i].is_tensor() && output_name.empty()) {
+          Expr out    = arg_pack[i];
+          output_name = out.as_tensor_ref()->name;
+        } else if (arg_pack[i].is_expr()) {
+          Expr temp = arg_pack[i];
+          vec_ast.emplace_back(temp);
+        }
+      }
+      CHECK(!vec_ast.empty());
+      ir::ModuleExpr mod_expr(vec_ast);
+      ir::IRSchedule ir_sch(mod_expr);
+      ir_sch.MergeExprs();
+      IRScheduleInt8DotCPU(ir_sch, output_name, target);
+      std::vector<CINNValue> res{CINNValue(ir_sch.GetModule().GetExprs().at(0))};
+      *ret = CINNValuePack{res};
+    } else {
+      *ret = arg_pack;
+    }
+  });
+}
+}  // namespace
+
+std::shared_ptr<framework::OpStrategy> StrategyForMatmulInt8(const framework::NodeAttr &attrs,
+                                                             const std::vector<ir::Tensor> &inputs,
+                                                             const std::vector<Type> &out_type,
+                                                             const std::vector<std::vector<int>> &output_shapes,
+                                                             const Target &target) {
+  CHECK(target.arch == Target::Arch::X86) << "matmul_int8 only supports X86 now! Please Check.\n";
+  bool trans_b = SafeGetAttr(attrs.attr_store, "trans_b", false);
+
+  framework::CINNCompute matmul_int8_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input arguments of matmul_int8 compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 2U) << "at least 2 input tensors for matmul_int8 compute\n";
+    Expr A = pack_args[0];
+    Expr B = pack_args[1];
+    CHECK(A.as_tensor());
+    CHECK(B.as_tensor());
+    std::string tensor_name = UniqName("MatmulInt8_out");
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), 3U);
+      CHECK(pack_args[2].is_string());
+      tensor_name = pack_args[2].operator std::string();
+    }
+    auto tensor_A = A.as_tensor_ref();
+    auto tensor_B = B.as_tensor_ref();
+    auto stages   = CreateStages({tensor_A, tensor_B});
+
+    auto out = MatmulInt8(tensor_A, tensor_B, trans_b, target, tensor_name);
+    std::vector<CINNValue> res;
+    for (auto &t : out) {
+      stages->InsertLazily(t);
+      res.push_back(CINNValue(t));
+    }
+    res.push_back(CINNValue(stages));
+    *ret = CINNValuePack{res};
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(matmul_int8_compute, GetInt8DotSchedule("matmul_int8", target), "strategy.matmul_int8.x86", 1);
+  return strategy;
+}
+
+std::shared_ptr<framework::OpStrategy> StrategyForConv2dInt8(const framework::NodeAttr &attrs,
+                                                             const std::vector<ir::Tensor> &inputs,
+                                                             const std::vector<Type> &out_type,
+                                                             const std::vector<std::vector<int>> &output_shapes,
+                                                             const Target &target) {
+  CHECK(target.arch == Target::Arch::X86) << "conv2d_int8 only supports X86 now! Please Check.\n";
+  auto strides   = SafeGetAttr(attrs.attr_store, "stride", std::vector<int>{1, 1});
+  auto paddings  = SafeGetAttr(attrs.attr_store, "padding", std::vector<int>{0, 0});
+  auto dilations = SafeGetAttr(attrs.attr_store, "dilation", std::vector<int>{1, 1});
+
+  framework::CINNCompute conv2d_int8_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input arguments of conv2d_int8 compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 2U) << "at least 2 input tensors for conv2d_int8 compute\n";
+    Expr input  = pack_args[0];
+    Expr weight = pack_args[1];
+    CHECK(input.as_tensor());
+    CHECK(weight.as_tensor());
+    std::string tensor_name = UniqName("Conv2dInt8_out");
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), 3U);
+      CHECK(pack_args[2].is_string());
+      tensor_name = pack_args[2].operator std::string();
+    }
+    auto input_tensor  = input.as_tensor_ref();
+    auto weight_tensor = weight.as_tensor_ref();
+    auto stages        = CreateStages({input_tensor, weight_tensor});
+
+    auto out = Conv2dInt8NCHW(input_tensor, weight_tensor, strides, paddings, dilations, target, tensor_name);
+    std::vector<CINNValue> res;
+    for (auto &t : out) {
+      stages->InsertLazily(t);
+      res.push_back(CINNValue(t));
+    }
+    res.push_back(CINNValue(stages));
+    *ret = CINNValuePack{res};
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(conv2d_int8_compute, GetInt8DotSchedule("conv2d_int8", target), "strategy.conv2d_int8.x86", 1);
+  return strategy;
+}
+
+std::vector<shape_t> InferShapeForQuantize(const std::vector<shape_t> &inputs_shape,
+                                           const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 1UL) << "The input's shape size should be 1! Please check again.";
+  return {inputs_shape[0]};
+}
+
+std::vector<Type> InferDtypeForQuantize(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_type.size(), 1UL) << "The input's type size should be 1! Please check again.";
+  return {common::Str2Type(SafeGetAttr(attrs, "dtype", std::string("int8")))};
+}
+
+std::vector<Type> InferDtypeForDequantize(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_type.size(), 1UL) << "The input's type size should be 1! Please check again.";
+  return {common::Str2Type(SafeGetAttr(attrs, "dtype", std::string("float32")))};
+}
+
+std::vector<shape_t> InferShapeForMatmulInt8(const std::vector<shape_t> &inputs_shape,
+                                             const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 2UL) << "The input's shape size should be 2! Please check again.";
+  CHECK_EQ(inputs_shape[0].size(), 2UL) << "matmul_int8 only supports 2-D inputs.";
+  CHECK_EQ(inputs_shape[1].size(), 2UL) << "matmul_int8 only supports 2-D inputs.";
+  bool trans_b = SafeGetAttr(attrs, "trans_b", false);
+  int n        = trans_b ? inputs_shape[1][0] : inputs_shape[1][1];
+  return {{inputs_shape[0][0], n}};
+}
+
+std::vector<shape_t> InferShapeForConv2dInt8(const std::vector<shape_t> &inputs_shape,
+                                             const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 2UL) << "The input's shape size should be 2! Please check again.";
+  CHECK_EQ(inputs_shape[0].size(), 4UL) << "conv2d_int8 only supports NCHW input.";
+  CHECK_EQ(inputs_shape[1].size(), 4UL) << "conv2d_int8 only supports OIHW weight.";
+  auto strides   = SafeGetAttr(attrs, "stride", std::vector<int>{1, 1});
+  auto paddings  = SafeGetAttr(attrs, "padding", std::vector<int>{0, 0});
+  auto dilations = SafeGetAttr(attrs, "dilation", std::vector<int>{1, 1});
+
+  const auto &x_shape = inputs_shape[0];
+  const auto &w_shape = inputs_shape[1];
+  int out_h = (x_shape[2] - ((w_shape[2] - 1) * dilations[0] + 1) + 2 * paddings[0]) / strides[0] + 1;
+  int out_w = (x_shape[3] - ((w_shape[3] - 1) * dilations[1] + 1) + 2 * paddings[1]) / strides[1] + 1;
+  return {{x_shape[0], w_shape[0], out_h, out_w}};
+}
+
+std::vector<Type> InferDtypeForInt8Dot(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_type.size(), 2UL) << "The input's type size should be 2! Please check again.";
+  return {Int(32)};
+}
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(quantize_ops) {
+  CINN_REGISTER_OP(quantize)
+      .describe("Quantize a float variable into int8/uint8 with a per-tensor scale and zero point.")
+      .set_num_inputs(1)
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForQuantize)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForQuantize))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForQuantize))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kElementWise)
+      .set_support_level(4);
+
+  CINN_REGISTER_OP(dequantize)
+      .describe("Dequantize an integer variable into float with a per-tensor scale and zero point.")
+      .set_num_inputs(1)
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForDequantize)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForQuantize))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForDequantize))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kElementWise)
+      .set_support_level(4);
+
+  CINN_REGISTER_OP(requantize)
+      .describe("Rescale an int32 accumulator into int8/uint8.")
+      .set_num_inputs(1)
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForRequantize)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForQuantize))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForQuantize))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kElementWise)
+      .set_support_level(4);
+
+  CINN_REGISTER_OP(matmul_int8)
+      .describe("int8 x int8 -> int32 matrix multiplication.")
+      .set_num_inputs(2)
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForMatmulInt8)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForMatmulInt8))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForInt8Dot))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
+      .set_support_level(4);
+
+  CINN_REGISTER_OP(conv2d_int8)
+      .describe("int8 x int8 -> int32 NCHW convolution.")
+      .set_num_inputs(2)
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForConv2dInt8)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForConv2dInt8))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForInt8Dot))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
+      .set_support_level(4);
+
+  return true;
+}
@@ -0,0 +1,107 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/common/target.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/tensor.h"
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+/**
+ * @brief Quantize a float tensor with a per-tensor affine mapping: out = clamp(round(x / scale) + zero_point).
+ * @param x The float input tensor.
+ * @param scale The quantization step.
+ * @param zero_point The integer value which the float 0 is mapped to.
+ * @param out_type The integer type of the output, int8 or uint8.
+ */
+ir::Tensor Quantize(const ir::Tensor& x,
+                    float scale,
+                    int zero_point,
+                    const Type& out_type,
+                    const std::string& output_name = "T_Quantize_out");
+
+/**
+ * @brief Map an integer tensor back to float: out = (x - zero_point) * scale.
+ */
+ir::Tensor Dequantize(const ir::Tensor& x,
+                      float scale,
+                      int zero_point,
+                      const Type& out_type,
+                      const std::string& output_name = "T_Dequantize_out");
+
+/**
+ * @brief Rescale an int32 accumulator (whose scale is `input_scale`) into a low precision integer tensor whose scale is
+ * `output_scale`.
+ */
+ir::Tensor Requantize(const ir::Tensor& x,
+                      float input_scale,
+                      float output_scale,
+                      int zero_point,
+                      const Type& out_type,
+                      const std::string& output_name = "T_Requantize_out");
+
+/**
+ * @brief int8 x int8 -> int32 matrix multiplication, A is [M, K], B is [K, N] or [N, K] when `trans_b` is true.
+ *
+ * When K is a multiple of 4 and N is a multiple of the int32 vector lanes of the target, B is packed into
+ * [N / lanes, K / 4, lanes, 4] so that each group of 4 consecutive int8 products accumulates into one int32 lane,
+ * which is the operand layout of the `vpdpbusd`-style dot product instructions. Otherwise a plain reduction is used.
+ *
+ * @return {out} or {out, packed_b}
+ */
+std::vector<ir::Tensor> MatmulInt8(const ir::Tensor& A,
+                                   const ir::Tensor& B,
+                                   bool trans_b,
+                                   const common::Target& target,
+                                   const std::string& output_name = "T_MatmulInt8_out");
+
+/**
+ * @brief int8 x int8 -> int32 NCHW convolution with groups = 1. The weight is packed into
+ * [O / lanes, C / 4, KH, KW, lanes, 4] when the channel numbers allow, see `MatmulInt8`.
+ *
+ * @return {out, input_pad} or {out, input_pad, packed_weight}
+ */
+std::vector<ir::Tensor> Conv2dInt8NCHW(const ir::Tensor& input,
+                                       const ir::Tensor& weight,
+                                       const std::vector<int>& strides,
+                                       const std::vector<int>& paddings,
+                                       const std::vector<int>& dilations,
+                                       const common::Target& target,
+                                       const std::string& output_name = "T_Conv2dInt8_out");
+
+//! Get the number of int32 lanes used to pack the int8 weights, return 1 if the vnni layout cannot be applied.
+int GetInt8DotLanes(int reduce_extent, int spatial_extent, const common::Target& target);
+
+/**
+ * @brief Schedule the output block of `matmul_int8` or `conv2d_int8` on the CPU: unroll the innermost 4-wide int8
+ * group of the reduction so that the backend can select it to `vpdpbusd`, then fuse and parallelize the outer
+ * spatial loops.
+ *
+ * The packing of the weight stays in the same kernel and is recomputed in every run. ParamFolding can't fold it as
+ * it is not a graph node, so a constant weight should be packed ahead of time once the layout is exposed as an op.
+ */
+void IRScheduleInt8DotCPU(ir::IRSchedule& ir_sch, const std::string& output_name, const common::Target& target);
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
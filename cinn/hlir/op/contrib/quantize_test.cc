@@ -0,0 +1,218 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/op/contrib/quantize.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cinn/backends/codegen_c.h"
+#include "cinn/backends/codegen_c_x86.h"
+#include "cinn/backends/llvm/simple_jit.h"
+#include "cinn/common/context.h"
+#include "cinn/common/test_helper.h"
+#include "cinn/lang/lower.h"
+#include "cinn/lang/placeholder.h"
+#include "cinn/optim/optimize.h"
+#include "cinn/poly/stage.h"
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+namespace {
+std::string GenerateX86Code(const std::string& func_name, const std::vector<ir::Tensor>& tensors) {
+  common::Target target = common::DefaultHostTarget();
+  poly::StageMap stages = poly::CreateStages(tensors);
+  std::vector<ir::LoweredFunc> funcs =
+      lang::LowerVec(func_name, stages, tensors, {}, {}, nullptr, target, true);
+
+  VLOG(6) << "Expr before CPU codegen:";
+  VLOG(6) << funcs[0]->body;
+
+  ir::Module::Builder builder(func_name + "_Module", target);
+  for (auto& f : funcs) {
+    builder.AddFunction(f);
+  }
+
+  backends::CodeGenCX86 codegen(target, backends::CodeGenCX86::Feature::AVX512);
+  codegen.SetInlineBuiltinCodes(false);
+  std::string code = codegen.Compile(builder.Build(), backends::CodeGenC::OutputKind::CImpl);
+  VLOG(6) << "Cpu Codegen result:";
+  VLOG(6) << code << std::endl;
+  return code;
+}
+}  // namespace
+
+TEST(Int8DotLanes, X86) {
+  common::Target target = common::DefaultHostTarget();
+  // 512-bit vectors hold 16 int32 lanes
+  ASSERT_EQ(GetInt8DotLanes(64, 64, target), 16);
+  ASSERT_EQ(GetInt8DotLanes(64, 24, target), 8);
+  ASSERT_EQ(GetInt8DotLanes(64, 4, target), 4);
+  // reduce extent is not a multiple of 4
+  ASSERT_EQ(GetInt8DotLanes(30, 64, target), 1);
+  // spatial extent cannot be split into at least 4 lanes
+  ASSERT_EQ(GetInt8DotLanes(64, 6, target), 1);
+}
+
+TEST(GenerateCode_Cpu, QuantizeDequantize) {
+  common::Context::Global().ResetNameId();
+
+  lang::Placeholder<float> in("in", {Expr(4), Expr(8)});
+  ir::Tensor q  = Quantize(in, 0.1f, 3, Int(8), "test_quantize_out");
+  ir::Tensor dq = Dequantize(q, 0.1f, 3, Float(32), "test_dequantize_out");
+  ASSERT_EQ(q->type(), Int(8));
+  ASSERT_EQ(dq->type(), Float(32));
+
+  GenerateX86Code("TestGenerateCodeCpu_Quantize", {in, q, dq});
+}
+
+TEST(GenerateCode_Cpu, MatmulInt8) {
+  common::Context::Global().ResetNameId();
+
+  common::Target target = common::DefaultHostTarget();
+  lang::Placeholder<int8_t> A("A", {Expr(32), Expr(64)});
+  lang::Placeholder<int8_t> B("B", {Expr(64), Expr(48)});
+
+  auto res = MatmulInt8(A, B, false, target, "test_matmul_int8_out");
+  ASSERT_EQ(res.size(), 2U);
+  ASSERT_EQ(res[0]->type(), Int(32));
+  // B is packed into {N / lanes, K / 4, lanes, 4}
+  ASSERT_EQ(res[1]->shape.size(), 4U);
+  ASSERT_EQ(res[1]->shape[0].as_int32(), 3);
+  ASSERT_EQ(res[1]->shape[1].as_int32(), 16);
+  ASSERT_EQ(res[1]->shape[2].as_int32(), 16);
+  ASSERT_EQ(res[1]->shape[3].as_int32(), 4);
+
+  GenerateX86Code("TestGenerateCodeCpu_MatmulInt8", {A, B, res[1], res[0]});
+
+  // the plain reduction fallback
+  lang::Placeholder<int8_t> C("C", {Expr(6), Expr(64)});
+  auto fallback = MatmulInt8(A, C, true, target, "test_matmul_int8_fallback_out");
+  ASSERT_EQ(fallback.size(), 1U);
+}
+
+TEST(GenerateCode_Cpu, Conv2dInt8) {
+  common::Context::Global().ResetNameId();
+
+  common::Target target = common::DefaultHostTarget();
+  lang::Placeholder<int8_t> input("input", {Expr(1), Expr(16), Expr(8), Expr(8)});
+  lang::Placeholder<int8_t> weight("weight", {Expr(32), Expr(16), Expr(3), Expr(3)});
+
+  auto res = Conv2dInt8NCHW(input, weight, {1, 1}, {1, 1}, {1, 1}, target, "test_conv2d_int8_out");
+  ASSERT_EQ(res.size(), 3U);
+  ASSERT_EQ(res[0]->shape[2].as_int32(), 8);
+  ASSERT_EQ(res[0]->shape[3].as_int32(), 8);
+
+  GenerateX86Code("TestGenerateCodeCpu_Conv2dInt8", {input, weight, res[1], res[2], res[0]});
+}
+
+TEST(Conv2dInt8, Accuracy) {
+  common::Context::Global().ResetNameId();
+
+  int N = 1, C = 16, H = 8, W = 8, O = 32, K = 3;
+  float scale           = 1.0f / 127.0f;
+  common::Target target = common::DefaultHostTarget();
+  lang::Placeholder<int8_t> input("input", {Expr(N), Expr(C), Expr(H), Expr(W)});
+  lang::Placeholder<int8_t> weight("weight", {Expr(O), Expr(C), Expr(K), Expr(K)});
+  auto res = Conv2dInt8NCHW(input, weight, {1, 1}, {1, 1}, {1, 1}, target, "test_conv2d_int8_out");
+  ASSERT_EQ(res.size(), 3U);
+
+  // lower and schedule the kernel the same way as the x86 strategy of conv2d_int8
+  std::vector<ir::Tensor> tensors{input, weight, res[1], res[2], res[0]};
+  auto funcs = lang::LowerVec("conv2d_int8", poly::CreateStages(tensors), tensors, {}, {}, nullptr, target, true);
+  ASSERT_EQ(funcs.size(), 1U);
+  ir::IRSchedule ir_sch(ir::ModuleExpr({funcs[0]->body}));
+  IRScheduleInt8DotCPU(ir_sch, res[0]->name, target);
+  auto func = ir::_LoweredFunc_::Make(funcs[0]->name, funcs[0]->args, ir_sch.GetModule().GetExprs()[0], {});
+  func      = optim::Optimize(Expr(func), target, false).as_lowered_func_ref();
+  func->PrepareBufferCastExprs(/*with_expr_gen_tensor = */ false);
+
+  ir::Module::Builder builder("conv2d_int8_module", target);
+  builder.AddFunction(func);
+  auto jit = backends::SimpleJIT::Create();
+  jit->Link(builder.Build());
+  auto fn = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("conv2d_int8"));
+  ASSERT_TRUE(fn);
+
+  // quantize the random float operands in [-1, 1] with the symmetric scale
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  auto quantize = [&](std::vector<float>* data, cinn_buffer_t* buf) {
+    auto* q = reinterpret_cast<int8_t*>(buf->memory);
+    for (size_t i = 0; i < data->size(); ++i) {
+      (*data)[i] = dist(rng);
+      q[i]       = static_cast<int8_t>(std::max(-127.0f, std::min(127.0f, std::round((*data)[i] / scale))));
+    }
+  };
+  std::vector<float> x(N * C * H * W), w(O * C * K * K);
+  auto* input_buf  = common::BufferBuilder(Int(8), {N, C, H, W}).set_zero().Build();
+  auto* weight_buf = common::BufferBuilder(Int(8), {O, C, K, K}).set_zero().Build();
+  quantize(&x, input_buf);
+  quantize(&w, weight_buf);
+  // the padded input and the packed weight are computed inside the kernel
+  auto temp_shape = [](const ir::Tensor& tensor) {
+    std::vector<int> shape;
+    for (auto& dim : tensor->shape) {
+      shape.push_back(dim.as_int32());
+    }
+    return shape;
+  };
+  auto* pad_buf    = common::BufferBuilder(Int(8), temp_shape(res[1])).set_zero().Build();
+  auto* packed_buf = common::BufferBuilder(Int(8), temp_shape(res[2])).set_zero().Build();
+  auto* out_buf    = common::BufferBuilder(Int(32), {N, O, H, W}).set_zero().Build();
+  auto args = common::ArgsBuilder().Add(input_buf).Add(weight_buf).Add(pad_buf).Add(packed_buf).Add(out_buf).Build();
+  fn(args.data(), args.size());
+
+  auto* x_q = reinterpret_cast<int8_t*>(input_buf->memory);
+  auto* w_q = reinterpret_cast<int8_t*>(weight_buf->memory);
+  auto* out = reinterpret_cast<int32_t*>(out_buf->memory);
+  // each product carries at most one rounding error of half a quantization step on both operands
+  float quant_tol = C * K * K * 2 * 0.5f * scale;
+  for (int o = 0; o < O; ++o) {
+    for (int y = 0; y < H; ++y) {
+      for (int z = 0; z < W; ++z) {
+        int32_t expect_q = 0;
+        float expect     = 0.0f;
+        for (int c = 0; c < C; ++c) {
+          for (int ky = 0; ky < K; ++ky) {
+            for (int kx = 0; kx < K; ++kx) {
+              int iy = y + ky - 1, ix = z + kx - 1;
+              if (iy < 0 || iy >= H || ix < 0 || ix >= W) {
+                continue;
+              }
+              int x_idx = (c * H + iy) * W + ix, w_idx = ((o * C + c) * K + ky) * K + kx;
+              expect_q += static_cast<int32_t>(x_q[x_idx]) * static_cast<int32_t>(w_q[w_idx]);
+              expect += x[x_idx] * w[w_idx];
+            }
+          }
+        }
+        int idx = (o * H + y) * W + z;
+        ASSERT_EQ(out[idx], expect_q) << " idx is " << idx;
+        ASSERT_NEAR(out[idx] * scale * scale, expect, quant_tol) << " idx is " << idx;
+      }
+    }
+  }
+}
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,251 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/op/contrib/scan.h"
+
+#include <gflags/gflags.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cinn/common/common.h"
+#include "cinn/common/context.h"
+#include "cinn/common/macros.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/op_strategy.h"
+#include "cinn/hlir/pe/ir_schedule_pe.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/ir_operators.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/ir/tensor.h"
+#include "cinn/lang/builtin.h"
+#include "cinn/lang/compute.h"
+
+DECLARE_bool(cinn_ir_schedule);
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+using common::CINNValue;
+using common::CINNValuePack;
+
+namespace {
+
+Expr ScanApply(const std::string &scan_type, const Expr &a, const Expr &b) {
+  if (scan_type == "sum") {
+    return a + b;
+  } else if (scan_type == "prod") {
+    return a * b;
+  } else if (scan_type == "max") {
+    return ir::Max::Make(a, b);
+  } else if (scan_type == "min") {
+    return ir::Min::Make(a, b);
+  }
+  LOG(FATAL) << "Unsupported scan type " << scan_type << ", it should be one of sum, prod, max and min.";
+  return Expr();
+}
+
+}  // namespace
+
+Expr GetScanInit(const std::string &scan_type, const Type &type) {
+  if (scan_type == "sum") {
+    return lang::Zero(type);
+  } else if (scan_type == "prod") {
+    return lang::One(type);
+  } else if (scan_type == "max") {
+    return lang::min_value(type);
+  } else if (scan_type == "min") {
+    return lang::max_value(type);
+  }
+  LOG(FATAL) << "Unsupported scan type " << scan_type << ", it should be one of sum, prod, max and min.";
+  return Expr();
+}
+
+std::vector<ir::Tensor> Scan(const ir::Tensor &x,
+                             int axis,
+                             const std::string &scan_type,
+                             bool exclusive,
+                             bool reverse,
+                             const std::string &output_name) {
+  int ndim = static_cast<int>(x->shape.size());
+  CHECK(-ndim <= axis && axis < ndim) << "Axis expected to be in range of [" << -ndim << "," << ndim << "). But got "
+                                      << axis << ".";
+  if (axis < 0) {
+    axis += ndim;
+  }
+  int axis_size = x->shape[axis].as_int32();
+  Expr init     = GetScanInit(scan_type, x->type());
+
+  // the position of `index` in the scan order, and the index `offset` positions before it, which is clamped into the
+  // axis since the both branches of select may be evaluated
+  auto position = [=](const Expr &index) { return reverse ? Expr(axis_size - 1) - index : index; };
+  auto previous = [=](const Expr &index, int offset) {
+    return reverse ? ir::Min::Make(index + offset, Expr(axis_size - 1)) : ir::Max::Make(index - offset, Expr(0));
+  };
+
+  int num_steps = 0;
+  for (int offset = 1; offset < axis_size; offset *= 2) {
+    ++num_steps;
+  }
+  std::vector<ir::Tensor> steps;
+  ir::Tensor prev = x;
+  if (exclusive || num_steps == 0) {
+    // the exclusive scan is the inclusive scan of the input shifted by one position
+    int shift = exclusive ? 1 : 0;
+    prev      = lang::Compute(
+        x->shape,
+        [=](const std::vector<Expr> &indices) {
+          if (!shift) {
+            return x(indices);
+          }
+          std::vector<Expr> prev_indices(indices);
+          prev_indices[axis] = previous(indices[axis], shift);
+          return ir::Select::Make(position(indices[axis]) >= shift, x(prev_indices), init);
+        },
+        num_steps == 0 ? output_name : common::UniqName(output_name + "_shift"));
+    steps.push_back(prev);
+  }
+  for (int offset = 1, step = 0; offset < axis_size; offset *= 2, ++step) {
+    prev = lang::Compute(
+        x->shape,
+        [=](const std::vector<Expr> &indices) {
+          std::vector<Expr> prev_indices(indices);
+          prev_indices[axis] = previous(indices[axis], offset);
+          return ir::Select::Make(
+              position(indices[axis]) >= offset, ScanApply(scan_type, prev(indices), prev(prev_indices)), prev(indices));
+        },
+        step + 1 == num_steps ? output_name : common::UniqName(output_name + "_step"));
+    steps.push_back(prev);
+  }
+
+  std::vector<ir::Tensor> res{steps.back()};
+  res.insert(res.end(), steps.begin(), steps.end() - 1);
+  return res;
+}
+
+std::shared_ptr<framework::OpStrategy> StrategyForScan(const framework::NodeAttr &attrs,
+                                                       const std::vector<ir::Tensor> &inputs,
+                                                       const std::vector<Type> &out_type,
+                                                       const std::vector<std::vector<int>> &output_shapes,
+                                                       const Target &target) {
+  auto attr_store = attrs.attr_store;
+  CHECK(attr_store.count("axis")) << "find no attr of axis";
+  int axis              = absl::get<int>(attr_store.at("axis"));
+  std::string scan_type = "sum";
+  if (attr_store.count("scan_type")) {
+    scan_type = absl::get<std::string>(attr_store.at("scan_type"));
+  }
+  bool exclusive = attr_store.count("exclusive") ? absl::get<bool>(attr_store.at("exclusive")) : false;
+  bool reverse   = attr_store.count("reverse") ? absl::get<bool>(attr_store.at("reverse")) : false;
+  // the steps of the doubling scan depend on each other as a whole, they cannot run in a single kernel
+  CHECK(target.arch != Target::Arch::NVGPU) << "The scan op should be decomposed on NVGPU.";
+
+  framework::CINNCompute scan_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input arguments of Scan compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 1U) << "At least 1 input tensors for Scan compute\n";
+    Expr A = pack_args[0];
+    CHECK(A.as_tensor());
+    CHECK(!output_shapes.empty());
+    auto tensor_A = A.as_tensor_ref();
+    auto stages   = CreateStages({tensor_A});
+    VLOG(3) << "A shape: " << utils::Join(tensor_A->shape, ", ")
+            << ", output_shapes: " << utils::Join(output_shapes[0], ", ");
+    auto tensor_name = common::UniqName("Scan_out");
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), 2U);
+      CHECK(pack_args[1].is_string());
+      tensor_name = pack_args[1].operator std::string();
+    }
+    auto out = Scan(tensor_A, axis, scan_type, exclusive, reverse, tensor_name);
+    std::vector<CINNValue> res;
+    for (auto &t : out) {
+      stages->InsertLazily(t);
+      res.push_back(CINNValue(t));
+    }
+    CHECK(!out_type.empty()) << "Output type of Scan is empty! Please check.\n";
+    res.push_back(CINNValue(stages));
+    *ret = CINNValuePack{res};
+  });
+
+  framework::CINNSchedule scan_schedule([=](lang::Args args, lang::RetValue *ret) {
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK(!args.empty()) << "The input argument of scan_schedule is empty! Please check.\n";
+      common::CINNValuePack arg_pack = args[0];
+      std::vector<Expr> vec_ast;
+      for (int i = 0; i < arg_pack.size(); i++) {
+        if (arg_pack[i].is_expr()) {
+          Expr temp = arg_pack[i];
+          vec_ast.emplace_back(temp);
+        }
+      }
+      CHECK(!vec_ast.empty());
+      ir::ModuleExpr mod_expr(vec_ast);
+      ir::IRSchedule ir_sch(mod_expr);
+      ir_sch.MergeExprs();
+      std::vector<common::CINNValue> res{common::CINNValue(ir_sch.GetModule().GetExprs().at(0))};
+      *ret = common::CINNValuePack{res};
+    } else {
+      CHECK(!args.empty()) << "The input argument of scan_schedule is empty! Please check.\n";
+      CINNValuePack arg_pack = args[0];
+      Expr out               = arg_pack[0];
+      CHECK(out.as_tensor());
+      *ret = arg_pack;
+    }
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(scan_compute, scan_schedule, "strategy.scan", 1);
+  return strategy;
+}
+
+std::vector<std::vector<int>> InferShapeForScan(const std::vector<std::vector<int>> &inputs_shape,
+                                                const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_shape.size(), 1UL) << "The input's shape size should be 1! Please check again.";
+  auto axis_it = attrs.find("axis");
+  CHECK(axis_it != attrs.end()) << "The attr axis of scan does not exist.";
+  int axis = absl::get<int>(axis_it->second);
+  int ndim = static_cast<int>(inputs_shape[0].size());
+  CHECK(-ndim <= axis && axis < ndim) << "Axis expected to be in range of [" << -ndim << "," << ndim << "). But got "
+                                      << axis << ".";
+  return {inputs_shape[0]};
+}
+
+std::vector<Type> InferDtypeForScan(const std::vector<Type> &inputs_type, const framework::AttrMapType &attrs) {
+  CHECK_EQ(inputs_type.size(), 1UL) << "The input's type size should be 1! Please check again.";
+  return {inputs_type[0]};
+}
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(scan_ops) {
+  CINN_REGISTER_OP(scan)
+      .describe("Cumulative sum/prod/max/min of a variable x along the given axis.")
+      .set_num_inputs(1)
+      .set_num_outputs(1)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForScan)
+      .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForScan))
+      .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForScan))
+      .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
+      .set_support_level(4);
+
+  return true;
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/ir/ir.h"
+#include "cinn/ir/ir_base.h"
+#include "cinn/ir/tensor.h"
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+/**
+ * @brief Cumulative sum/prod/max/min of x along the axis, computed by log2(n) doubling steps (Hillis-Steele scan):
+ * the step d combines every element with the one d positions before it. This is the fallback of the host
+ * `cinn_call_scan_host` kernel when custom call is disabled.
+ * @param scan_type One of "sum", "prod", "max" and "min".
+ * @param exclusive Whether the element itself is excluded, the first element is the identity of the operator.
+ * @param reverse Whether scan from the last element of the axis.
+ * @return {out, the tensors of the intermediate steps}
+ */
+std::vector<ir::Tensor> Scan(const ir::Tensor& x,
+                             int axis,
+                             const std::string& scan_type,
+                             bool exclusive,
+                             bool reverse,
+                             const std::string& output_name = "T_Scan_out");
+
+//! Get the identity of the scan operator, which is the first element of the exclusive scan.
+ir::Expr GetScanInit(const std::string& scan_type, const Type& type);
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
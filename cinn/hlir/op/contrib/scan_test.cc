@@ -0,0 +1,75 @@
+// Copyright (c) 2022 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/op/contrib/scan.h"
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "cinn/backends/codegen_c.h"
+#include "cinn/backends/codegen_c_x86.h"
+#include "cinn/common/context.h"
+#include "cinn/lang/lower.h"
+#include "cinn/lang/placeholder.h"
+#include "cinn/poly/stage.h"
+
+namespace cinn {
+namespace hlir {
+namespace op {
+
+TEST(GenerateCode_Cpu, Scan) {
+  common::Context::Global().ResetNameId();
+
+  Target target = common::DefaultHostTarget();
+  lang::Placeholder<float> in("in", {Expr(4), Expr(28)});
+
+  // 28 elements need 5 doubling steps, the exclusive scan shifts the input first
+  auto inclusive = Scan(in, 1, "sum", false, false, "test_cumsum_out");
+  ASSERT_EQ(inclusive.size(), 5U);
+  ASSERT_EQ(inclusive[0]->name, "test_cumsum_out");
+  auto exclusive = Scan(in, -1, "max", true, true, "test_cummax_out");
+  ASSERT_EQ(exclusive.size(), 6U);
+  // a single element is copied
+  lang::Placeholder<float> single("single", {Expr(4), Expr(1)});
+  ASSERT_EQ(Scan(single, 1, "prod", false, false, "test_cumprod_out").size(), 1U);
+
+  std::vector<ir::Tensor> tensors{in};
+  tensors.insert(tensors.end(), inclusive.rbegin(), inclusive.rend());
+  poly::StageMap stages = poly::CreateStages(tensors);
+  std::vector<ir::LoweredFunc> funcs =
+      lang::LowerVec("TestGenerateCodeCpu_Scan", stages, {in, inclusive[0]}, {}, {}, nullptr, target, true);
+
+  VLOG(6) << "Expr before CPU codegen:";
+  VLOG(6) << funcs[0]->body;
+
+  ir::Module::Builder builder("Scan_Module", target);
+  for (auto& f : funcs) {
+    builder.AddFunction(f);
+  }
+
+  backends::CodeGenCX86 codegen(target, backends::CodeGenCX86::Feature::AVX512);
+  codegen.SetInlineBuiltinCodes(false);
+  std::string code = codegen.Compile(builder.Build(), backends::CodeGenC::OutputKind::CImpl);
+  VLOG(6) << "Cpu Codegen result:";
+  VLOG(6) << code << std::endl;
+  // every step is a loop nest over the whole tensor, there is no [28, 28] mask any more
+  ASSERT_EQ(code.find("784"), std::string::npos);
+}
+
+}  // namespace op
+}  // namespace hlir
+}  // namespace cinn
@@ -16,6 +16,7 @@
 
 #include <gflags/gflags.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -28,6 +29,7 @@
 #include "cinn/hlir/framework/node.h"
 #include "cinn/hlir/framework/op.h"
 #include "cinn/hlir/framework/op_strategy.h"
+#include "cinn/hlir/op/external_api_registry.h"
 #include "cinn/hlir/op/op_util.h"
 #include "cinn/hlir/pe/elementwise.h"
 #include "cinn/hlir/pe/ir_schedule_pe.h"
@@ -142,11 +144,70 @@ std::vector<ir::Tensor> Sort(const ir::Tensor &A,
   return {res, sort_index.at(0), sort_index.at(1)};
 }
 
+std::vector<ir::Tensor> TopK(const ir::Tensor &A,
+                             const common::Target &target,
+                             poly::StageMap stages,
+                             int k,
+                             int axis,
+                             bool largest,
+                             const std::string &value_name,
+                             const std::string &index_name) {
+  int pos_axis = axis;
+  if (pos_axis < 0) {
+    pos_axis += A->shape.size();
+  }
+  k = std::min(k, A->shape[pos_axis].as_int32());
+
+  auto sort_index = ArgSort(A, target, stages, pos_axis, !largest, value_name + "_index");
+  auto out_shape  = A->shape;
+  out_shape[pos_axis] = Expr(k);
+  auto values = Compute(
+      out_shape,
+      [=](const std::vector<Expr> &indices) {
+        std::vector<Expr> A_indices(indices);
+        A_indices[pos_axis] = sort_index.at(0)(indices);
+        return A(A_indices);
+      },
+      value_name);
+  auto index = Compute(
+      out_shape,
+      [=](const std::vector<Expr> &indices) { return ir::Cast::Make(Int(64), sort_index.at(0)(indices)); },
+      index_name);
+  stages->InsertLazily(sort_index.at(0));
+  return {values, index, sort_index.at(0), sort_index.at(1)};
+}
+
+namespace {
+// On X86 the ops call the O(n * log(n)) host kernels `cinn_call_{sort,argsort,top_k}_host` directly, the same as
+// the custom_call op does, so they don't fall back to the O(n^2) `ArgSort` when custom call is disabled or denied.
+// The custom call is only lowered with IR schedule, the old lowering and the dtypes without host kernels keep the
+// compute strategies.
+bool UseHostKernel(const std::string &op_name,
+                   const framework::NodeAttr &attrs,
+                   const std::vector<ir::Tensor> &inputs,
+                   const Target &target) {
+  return target.arch == Target::Arch::X86 && FLAGS_cinn_ir_schedule && !inputs.empty() &&
+         ExternalApiRegistry::Global()->IsSupported(op_name, attrs, {inputs.front()->type()}, target);
+}
+
+std::shared_ptr<framework::OpStrategy> StrategyForHostKernel(const framework::NodeAttr &attrs,
+                                                             const std::vector<ir::Tensor> &inputs,
+                                                             const std::vector<Type> &out_type,
+                                                             const std::vector<std::vector<int>> &output_shapes,
+                                                             const Target &target) {
+  auto &strategy = framework::Operator::GetAttrs<framework::StrategyFunction>("CINNStrategy");
+  return strategy[framework::Operator::Get("custom_call")](attrs, inputs, out_type, output_shapes, target);
+}
+}  // namespace
+
 std::shared_ptr<framework::OpStrategy> StrategyForSort(const framework::NodeAttr &attrs,
                                                        const std::vector<ir::Tensor> &inputs,
                                                        const std::vector<Type> &out_type,
                                                        const std::vector<std::vector<int>> &output_shapes,
                                                        const Target &target) {
+  if (UseHostKernel("sort", attrs, inputs, target)) {
+    return StrategyForHostKernel(attrs, inputs, out_type, output_shapes, target);
+  }
   auto attr_store = attrs.attr_store;
   std::string op_name("sort");
 
@@ -228,6 +289,9 @@ std::shared_ptr<framework::OpStrategy> StrategyForArgSort(const framework::NodeA
                                                           const std::vector<Type> &out_type,
                                                           const std::vector<std::vector<int>> &output_shapes,
                                                           const Target &target) {
+  if (UseHostKernel("argsort", attrs, inputs, target)) {
+    return StrategyForHostKernel(attrs, inputs, out_type, output_shapes, target);
+  }
   auto attr_store = attrs.attr_store;
   CHECK(attr_store.count("axis")) << "find no attr of axis";
   int axis       = absl::get<int>(attr_store.at("axis"));
@@ -304,6 +368,77 @@ std::shared_ptr<framework::OpStrategy> StrategyForArgSort(const framework::NodeA
   return strategy;
 }
 
+std::shared_ptr<framework::OpStrategy> StrategyForTopK(const framework::NodeAttr &attrs,
+                                                       const std::vector<ir::Tensor> &inputs,
+                                                       const std::vector<Type> &out_type,
+                                                       const std::vector<std::vector<int>> &output_shapes,
+                                                       const Target &target) {
+  if (UseHostKernel("top_k", attrs, inputs, target)) {
+    return StrategyForHostKernel(attrs, inputs, out_type, output_shapes, target);
+  }
+  auto attr_store = attrs.attr_store;
+  CHECK(attr_store.count("k")) << "find no attr of k";
+  CHECK(attr_store.count("axis")) << "find no attr of axis";
+  int k        = absl::get<int>(attr_store.at("k"));
+  int axis     = absl::get<int>(attr_store.at("axis"));
+  bool largest = true;
+  if (attr_store.count("largest")) {
+    largest = absl::get<bool>(attr_store.at("largest"));
+  }
+
+  framework::CINNCompute top_k_compute([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input arguments of TopK compute is empty! Please check.\n";
+    CINNValuePack pack_args = args[0];
+    CHECK_GE(pack_args.size(), 1U) << "At least 1 input tensors for TopK compute\n";
+    Expr A = pack_args[0];
+    CHECK(A.as_tensor());
+    auto tensor_A    = A.as_tensor_ref();
+    auto stages      = CreateStages({tensor_A});
+    auto value_name  = UniqName("TopK_out");
+    auto index_name  = UniqName("TopK_index");
+    if (FLAGS_cinn_ir_schedule) {
+      CHECK_EQ(pack_args.size(), 3U);
+      CHECK(pack_args[1].is_string() && pack_args[2].is_string());
+      value_name = pack_args[1].operator std::string();
+      index_name = pack_args[2].operator std::string();
+    }
+    auto out = TopK(tensor_A, target, stages, k, axis, largest, value_name, index_name);
+    std::vector<CINNValue> res;
+    for (auto &t : out) {
+      stages->InsertLazily(t);
+      res.push_back(CINNValue(t));
+    }
+    res.push_back(CINNValue(stages));
+    *ret = CINNValuePack{res};
+  });
+
+  framework::CINNSchedule top_k_schedule([=](lang::Args args, lang::RetValue *ret) {
+    CHECK(!args.empty()) << "The input argument of top_k_schedule is empty! Please check.\n";
+    CINNValuePack arg_pack = args[0];
+    if (FLAGS_cinn_ir_schedule) {
+      std::vector<Expr> vec_ast;
+      for (int i = 0; i < arg_pack.size(); i++) {
+        if (arg_pack[i].is_expr()) {
+          Expr temp = arg_pack[i];
+          vec_ast.emplace_back(temp);
+        }
+      }
+      CHECK(!vec_ast.empty());
+      ir::ModuleExpr mod_expr(vec_ast);
+      ir::IRSchedule ir_sch(mod_expr);
+      ir_sch.MergeExprs();
+      std::vector<common::CINNValue> res{common::CINNValue(ir_sch.GetModule().GetExprs().at(0))};
+      *ret = common::CINNValuePack{res};
+    } else {
+      *ret = arg_pack;
+    }
+  });
+
+  auto strategy = std::make_shared<framework::OpStrategy>();
+  strategy->AddImpl(top_k_compute, top_k_schedule, "strategy.top_k", 1);
+  return strategy;
+}
+
 std::vector<std::vector<int>> InferShapeForSort(const std::vector<std::vector<int>> &inputs_shape,
                                                 const framework::AttrMapType &attrs) {
   CHECK_EQ(inputs_shape.size(), 1UL) << "The input's shape size should be 1! Please check again.";
@@ -403,6 +538,7 @@ CINN_REGISTER_HELPER(sort_ops) {
       .describe("Find values and indices of the k largest entries for the last dimension..")
       .set_num_inputs(1)
       .set_num_outputs(2)
+      .set_attr<cinn::hlir::framework::StrategyFunction>("CINNStrategy", cinn::hlir::op::StrategyForTopK)
       .set_attr("infershape", MakeOpFunction(cinn::hlir::op::InferShapeForTopK))
       .set_attr("inferdtype", MakeOpFunction(cinn::hlir::op::InferDtypeForTopK))
       .set_attr<cinn::hlir::framework::OpPatternKind>("OpPattern", cinn::hlir::framework::OpPatternKind::kNonFusible)
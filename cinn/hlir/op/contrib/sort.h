@@ -39,6 +39,20 @@ std::vector<ir::Tensor> Sort(const ir::Tensor& A,
                              const bool& is_ascend,
                              const std::string& name);
 
+/**
+ * @brief Select the k largest (or smallest) elements along the axis, based on `ArgSort`. With IR schedule the X86
+ * strategy calls the host `cinn_call_top_k_host` kernel instead, this is the fallback of the old lowering.
+ * @return {values, int64 indices, sorted indices, positions}
+ */
+std::vector<ir::Tensor> TopK(const ir::Tensor& A,
+                             const common::Target& target,
+                             poly::StageMap stages,
+                             int k,
+                             int axis,
+                             bool largest,
+                             const std::string& value_name,
+                             const std::string& index_name);
+
 }  // namespace op
 }  // namespace hlir
 }  // namespace cinn
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+
 #include "cinn/backends/codegen_cuda_util.h"
 #include "cinn/common/cas.h"
 #include "cinn/hlir/framework/node.h"
@@ -24,6 +26,7 @@
 #include "cinn/hlir/pe/schedule.h"
 #include "cinn/hlir/pe/transform.h"
 #include "cinn/ir/ir_printer.h"
+#include "cinn/runtime/intrinsic.h"
 #include "cinn/utils/string.h"
 
 #ifdef CINN_WITH_CUDNN
@@ -605,6 +608,170 @@ std::vector<ir::Expr> CustomCallArgsForAssertTrue(const framework::NodeAttr &att
   return args;
 }
 
+namespace {
+// view the input of sort/argsort/top_k/scan/softmax as [outer, axis_size, inner]
+std::vector<ir::Expr> GetSortRowArgs(const ir::Tensor &x, int axis) {
+  int ndim = static_cast<int>(x->shape.size());
+  if (axis < 0) {
+    axis += ndim;
+  }
+  CHECK(axis >= 0 && axis < ndim) << "The axis " << axis << " is out of the range of input's rank " << ndim;
+  int outer = 1, inner = 1;
+  for (int i = 0; i < axis; i++) {
+    outer *= x->shape[i].as_int32();
+  }
+  for (int i = axis + 1; i < ndim; i++) {
+    inner *= x->shape[i].as_int32();
+  }
+  return {ir::Expr(outer), ir::Expr(x->shape[axis].as_int32()), ir::Expr(inner)};
+}
+
+std::vector<ir::Expr> GetSortTypeArgs(const ir::Tensor &x) {
+  auto type = runtime::ToRuntimeType(x->type());
+  return {ir::Expr(static_cast<int>(type.code)), ir::Expr(static_cast<int>(type.bits))};
+}
+}  // namespace
+
+std::vector<ir::Expr> CustomCallArgsForSort(const framework::NodeAttr &attrs,
+                                            const std::vector<ir::Tensor> &inputs,
+                                            const std::vector<std::vector<int>> &output_shapes) {
+  CHECK_EQ(inputs.size(), 1UL);
+  const auto &attr_store = attrs.attr_store;
+  CHECK(attr_store.count("axis"));
+
+  int axis       = absl::get<int>(attr_store.at("axis"));
+  bool is_ascend = attr_store.count("is_ascend") ? absl::get<bool>(attr_store.at("is_ascend")) : true;
+
+  std::vector<ir::Expr> args = GetSortRowArgs(inputs.front(), axis);
+  args.emplace_back(is_ascend);
+  auto type_args = GetSortTypeArgs(inputs.front());
+  args.insert(args.end(), type_args.begin(), type_args.end());
+
+  return args;
+}
+
+std::vector<ir::Expr> CustomCallArgsForTopK(const framework::NodeAttr &attrs,
+                                            const std::vector<ir::Tensor> &inputs,
+                                            const std::vector<std::vector<int>> &output_shapes) {
+  CHECK_EQ(inputs.size(), 1UL);
+  const auto &attr_store = attrs.attr_store;
+  CHECK(attr_store.count("k"));
+  CHECK(attr_store.count("axis"));
+
+  int k        = absl::get<int>(attr_store.at("k"));
+  int axis     = absl::get<int>(attr_store.at("axis"));
+  bool largest = attr_store.count("largest") ? absl::get<bool>(attr_store.at("largest")) : true;
+
+  std::vector<ir::Expr> args = GetSortRowArgs(inputs.front(), axis);
+  args.emplace_back(k);
+  args.emplace_back(largest);
+  auto type_args = GetSortTypeArgs(inputs.front());
+  args.insert(args.end(), type_args.begin(), type_args.end());
+
+  return args;
+}
+
+std::vector<ir::Expr> CustomCallArgsForScan(const framework::NodeAttr &attrs,
+                                            const std::vector<ir::Tensor> &inputs,
+                                            const std::vector<std::vector<int>> &output_shapes) {
+  CHECK_EQ(inputs.size(), 1UL);
+  const auto &attr_store = attrs.attr_store;
+  CHECK(attr_store.count("axis"));
+
+  int axis              = absl::get<int>(attr_store.at("axis"));
+  std::string scan_type = attr_store.count("scan_type") ? absl::get<std::string>(attr_store.at("scan_type")) : "sum";
+  bool exclusive        = attr_store.count("exclusive") ? absl::get<bool>(attr_store.at("exclusive")) : false;
+  bool reverse          = attr_store.count("reverse") ? absl::get<bool>(attr_store.at("reverse")) : false;
+
+  // the scan types are numbered as `cinn_call_scan_host` expects
+  static const std::vector<std::string> scan_types = {"sum", "prod", "max", "min"};
+  auto it = std::find(scan_types.begin(), scan_types.end(), scan_type);
+  CHECK(it != scan_types.end()) << "Unsupported scan type " << scan_type;
+
+  std::vector<ir::Expr> args = GetSortRowArgs(inputs.front(), axis);
+  args.emplace_back(static_cast<int>(it - scan_types.begin()));
+  args.emplace_back(exclusive);
+  args.emplace_back(reverse);
+  auto type_args = GetSortTypeArgs(inputs.front());
+  args.insert(args.end(), type_args.begin(), type_args.end());
+
+  return args;
+}
+
+namespace {
+// view the input of layer_norm/rms_norm as [rows, cols], where the axes from begin_norm_axis are the columns
+std::vector<ir::Expr> GetNormRowArgs(const ir::Tensor &x, int begin_norm_axis) {
+  int ndim = static_cast<int>(x->shape.size());
+  if (begin_norm_axis < 0) {
+    begin_norm_axis += ndim;
+  }
+  CHECK(begin_norm_axis >= 0 && begin_norm_axis < ndim)
+      << "The begin_norm_axis " << begin_norm_axis << " is out of the range of input's rank " << ndim;
+  int rows = 1, cols = 1;
+  for (int i = 0; i < begin_norm_axis; i++) {
+    rows *= x->shape[i].as_int32();
+  }
+  for (int i = begin_norm_axis; i < ndim; i++) {
+    cols *= x->shape[i].as_int32();
+  }
+  return {ir::Expr(rows), ir::Expr(cols)};
+}
+}  // namespace
+
+std::vector<ir::Expr> CustomCallArgsForLayerNorm(const framework::NodeAttr &attrs,
+                                                 const std::vector<ir::Tensor> &inputs,
+                                                 const std::vector<std::vector<int>> &output_shapes) {
+  CHECK_EQ(inputs.size(), 3UL);
+  const auto &attr_store = attrs.attr_store;
+
+  float epsilon       = attr_store.count("epsilon") ? absl::get<float>(attr_store.at("epsilon")) : 1e-5f;
+  int begin_norm_axis = attr_store.count("begin_norm_axis") ? absl::get<int>(attr_store.at("begin_norm_axis")) : 1;
+
+  std::vector<ir::Expr> args = GetNormRowArgs(inputs.front(), begin_norm_axis);
+  args.emplace_back(epsilon);
+  auto type_args = GetSortTypeArgs(inputs.front());
+  args.insert(args.end(), type_args.begin(), type_args.end());
+
+  return args;
+}
+
+std::vector<ir::Expr> CustomCallArgsForRmsNorm(const framework::NodeAttr &attrs,
+                                               const std::vector<ir::Tensor> &inputs,
+                                               const std::vector<std::vector<int>> &output_shapes) {
+  CHECK_EQ(inputs.size(), 2UL);
+  const auto &attr_store = attrs.attr_store;
+
+  float epsilon       = attr_store.count("epsilon") ? absl::get<float>(attr_store.at("epsilon")) : 1e-6f;
+  int begin_norm_axis = attr_store.count("begin_norm_axis") ? absl::get<int>(attr_store.at("begin_norm_axis")) : -1;
+
+  std::vector<ir::Expr> args = GetNormRowArgs(inputs.front(), begin_norm_axis);
+  args.emplace_back(epsilon);
+  auto type_args = GetSortTypeArgs(inputs.front());
+  args.insert(args.end(), type_args.begin(), type_args.end());
+
+  return args;
+}
+
+std::vector<ir::Expr> CustomCallArgsForSoftmax(const framework::NodeAttr &attrs,
+                                               const std::vector<ir::Tensor> &inputs,
+                                               const std::vector<std::vector<int>> &output_shapes) {
+  CHECK_EQ(inputs.size(), 1UL);
+  const auto &attr_store = attrs.attr_store;
+
+  int axis = attr_store.count("axis") ? absl::get<int>(attr_store.at("axis")) : -1;
+  if (attr_store.count("axes")) {
+    auto axes = absl::get<std::vector<int>>(attr_store.at("axes"));
+    CHECK_EQ(axes.size(), 1UL) << "The softmax custom call supports a single axis only, but received " << axes.size();
+    axis = axes.front();
+  }
+
+  std::vector<ir::Expr> args = GetSortRowArgs(inputs.front(), axis);
+  auto type_args             = GetSortTypeArgs(inputs.front());
+  args.insert(args.end(), type_args.begin(), type_args.end());
+
+  return args;
+}
+
 std::vector<ir::Expr> CustomCallArgsForGaussianRandom(const framework::NodeAttr &attrs,
                                                       const std::vector<ir::Tensor> &inputs,
                                                       const std::vector<std::vector<int>> &output_shapes) {
@@ -834,6 +1001,20 @@ bool RegisteryCustomCallArgsFunc() {
 
   CustomCallArgsFuncRegistry::Global().Register(
       "cinn_assert_true_host", common::DefaultHostTarget(), CustomCallArgsForAssertTrue);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_sort_host", common::DefaultHostTarget(), CustomCallArgsForSort);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_argsort_host", common::DefaultHostTarget(), CustomCallArgsForSort);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_top_k_host", common::DefaultHostTarget(), CustomCallArgsForTopK);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_scan_host", common::DefaultHostTarget(), CustomCallArgsForScan);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_layer_norm_host", common::DefaultHostTarget(), CustomCallArgsForLayerNorm);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_rms_norm_host", common::DefaultHostTarget(), CustomCallArgsForRmsNorm);
+  CustomCallArgsFuncRegistry::Global().Register(
+      "cinn_call_softmax_host", common::DefaultHostTarget(), CustomCallArgsForSoftmax);
 
   return true;
 }
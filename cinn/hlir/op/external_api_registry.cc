@@ -23,8 +23,12 @@ ExternalApiInfo& ExternalApiRegistry::Register(const std::string& op_name, const
 }
 
 std::string ExternalApiRegistry::GetExternalApi(const framework::Node* op_node, const common::Target& target) {
-  CHECK(op_node->attrs.attr_store.count("original_op")) << "a custom_call op must store its original op name";
-  std::string op_name                      = absl::get<std::string>(op_node->attrs.attr_store.at("original_op"));
+  // the other ops calling their external api directly, such as sort on X86, are looked up by their own names
+  std::string op_name = op_node->op()->name;
+  if (op_name == "custom_call") {
+    CHECK(op_node->attrs.attr_store.count("original_op")) << "a custom_call op must store its original op name";
+    op_name = absl::get<std::string>(op_node->attrs.attr_store.at("original_op"));
+  }
   const ExternalApiInfo* external_api_info = Find(GenKey(op_name, target));
   CHECK(external_api_info) << "Op:" << op_name << " doesn't register external_api on " << target;
   std::string external_api = external_api_info->api_name;
@@ -36,17 +40,57 @@ std::string ExternalApiRegistry::GetExternalApi(const framework::Node* op_node,
   return external_api;
 }
 
+bool ExternalApiRegistry::IsSupported(const std::string& op_name,
+                                      const framework::NodeAttr& attrs,
+                                      const std::vector<common::Type>& input_types,
+                                      const common::Target& target) {
+  const ExternalApiInfo* external_api_info = Find(GenKey(op_name, target));
+  if (!external_api_info) {
+    return false;
+  }
+  return !external_api_info->support_func || external_api_info->support_func(attrs, input_types);
+}
+
 std::string ExternalApiRegistry::GenKey(const std::string& op_name, const common::Target& target) {
   std::ostringstream oss;
   oss << target;
   return op_name + "_" + oss.str();
 }
 
+namespace {
+// the host kernels of sort/argsort/top_k/scan are instantiated for float32, float64, int32 and int64
+bool IsHostSortType(const common::Type& type) {
+  return type.is_float(32) || type.is_float(64) || type.is_int(32) || type.is_int(64);
+}
+
+// the host kernels of layer_norm/rms_norm/softmax are instantiated for float32 and float64
+bool IsHostFloatType(const common::Type& type) { return type.is_float(32) || type.is_float(64); }
+
+bool HostSortSupported(const framework::NodeAttr& attrs, const std::vector<common::Type>& input_types) {
+  return !input_types.empty() && IsHostSortType(input_types.front());
+}
+
+bool HostNormSupported(const framework::NodeAttr& attrs, const std::vector<common::Type>& input_types) {
+  return !input_types.empty() && IsHostFloatType(input_types.front());
+}
+
+bool HostSoftmaxSupported(const framework::NodeAttr& attrs, const std::vector<common::Type>& input_types) {
+  // the host kernel normalizes a single axis
+  if (attrs.attr_store.count("axes") && absl::get<std::vector<int>>(attrs.attr_store.at("axes")).size() != 1) {
+    return false;
+  }
+  return HostNormSupported(attrs, input_types);
+}
+}  // namespace
+
 }  // namespace op
 }  // namespace hlir
 }  // namespace cinn
 
 CINN_REGISTER_HELPER(op_external_api) {
+  using ::cinn::hlir::op::HostNormSupported;
+  using ::cinn::hlir::op::HostSoftmaxSupported;
+  using ::cinn::hlir::op::HostSortSupported;
   const auto& default_nvgpu = ::cinn::common::DefaultNVGPUTarget();
   const auto& default_host  = ::cinn::common::DefaultHostTarget();
 
@@ -62,6 +106,27 @@ CINN_REGISTER_HELPER(op_external_api) {
   CINN_OP_REGISTER_EXTERNAL_API(triangular_solve, default_nvgpu).set_api_name("cinn_call_triangular_solve_nvgpu");
   CINN_OP_REGISTER_EXTERNAL_API(assert_true, default_nvgpu).set_api_name("cinn_assert_true_nvgpu");
   CINN_OP_REGISTER_EXTERNAL_API(assert_true, default_host).set_api_name("cinn_assert_true_host");
+  CINN_OP_REGISTER_EXTERNAL_API(sort, default_host)
+      .set_api_name("cinn_call_sort_host")
+      .set_support_func(HostSortSupported);
+  CINN_OP_REGISTER_EXTERNAL_API(argsort, default_host)
+      .set_api_name("cinn_call_argsort_host")
+      .set_support_func(HostSortSupported);
+  CINN_OP_REGISTER_EXTERNAL_API(top_k, default_host)
+      .set_api_name("cinn_call_top_k_host")
+      .set_support_func(HostSortSupported);
+  CINN_OP_REGISTER_EXTERNAL_API(scan, default_host)
+      .set_api_name("cinn_call_scan_host")
+      .set_support_func(HostSortSupported);
+  CINN_OP_REGISTER_EXTERNAL_API(layer_norm, default_host)
+      .set_api_name("cinn_call_layer_norm_host")
+      .set_support_func(HostNormSupported);
+  CINN_OP_REGISTER_EXTERNAL_API(rms_norm, default_host)
+      .set_api_name("cinn_call_rms_norm_host")
+      .set_support_func(HostNormSupported);
+  CINN_OP_REGISTER_EXTERNAL_API(softmax, default_host)
+      .set_api_name("cinn_call_softmax_host")
+      .set_support_func(HostSoftmaxSupported);
 #ifdef CINN_WITH_CUDNN
   CINN_OP_REGISTER_EXTERNAL_API(conv2d, default_nvgpu).set_trans_func([](const ::cinn::hlir::framework::Node* node) {
     CHECK(node->attrs.attr_store.count("conv_type"));
@@ -14,6 +14,8 @@
 
 #pragma once
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "cinn/common/target.h"
 #include "cinn/hlir/framework/node.h"
@@ -28,14 +30,19 @@ namespace hlir {
 namespace op {
 
 using OpNodeTransToExternalApiFunction = std::function<std::string(const framework::Node* op_node)>;
+using ExternalApiSupportFunction =
+    std::function<bool(const framework::NodeAttr& attrs, const std::vector<common::Type>& input_types)>;
 
 // This class contains detail external api information of a specified Operator.
 // To provide the external api name, we can directly set it through `set_api_name`
-// or set a transform function wth `set_trans_func` that return a api name finally
+// or set a transform function wth `set_trans_func` that return a api name finally.
+// If the external api only supports part of the dtypes or attributes of the op, set a check function with
+// `set_support_func`, the other nodes are left to the compute implement.
 struct ExternalApiInfo {
   std::string name;
   std::string api_name;
   OpNodeTransToExternalApiFunction trans_func;
+  ExternalApiSupportFunction support_func;
 
   inline ExternalApiInfo& set_api_name(const std::string& name) {
     this->api_name = name;
@@ -46,6 +53,11 @@ struct ExternalApiInfo {
     this->trans_func = func;
     return *this;
   }
+
+  inline ExternalApiInfo& set_support_func(ExternalApiSupportFunction func) {
+    this->support_func = func;
+    return *this;
+  }
 };
 
 // A registry that stores external api for ops supported by vendor library
@@ -62,6 +74,12 @@ class ExternalApiRegistry : public Registry<ExternalApiInfo> {
     return nullptr != Registry<ExternalApiInfo>::Find(GenKey(op_name, target));
   }
 
+  // whether the external api on the specified target supports the op with the attributes and input dtypes
+  bool IsSupported(const std::string& op_name,
+                   const framework::NodeAttr& attrs,
+                   const std::vector<common::Type>& input_types,
+                   const common::Target& target);
+
   // return the api name on the specified target
   std::string GetExternalApi(const framework::Node* op_node, const common::Target& target);
 
@@ -1872,6 +1872,15 @@ std::shared_ptr<OpStrategy> StrategyForSoftmax(const framework::NodeAttr &attrs,
   if (attrs.attr_store.count("axis")) {
     axis = absl::get<int>(attrs.attr_store.at("axis"));
   }
+  // NetBuilder::Softmax sets the attr axes, the softmax along several axes is decomposed
+  if (attrs.attr_store.count("axes")) {
+    auto axes = absl::get<std::vector<int>>(attrs.attr_store.at("axes"));
+    CHECK_EQ(axes.size(), 1UL) << "The softmax op supports a single axis only, but received " << axes.size();
+    axis = axes.front();
+  }
+  if (axis < -1) {
+    axis += static_cast<int>(output_shapes[0].size());
+  }
   if (attrs.attr_store.count("use_mkldnn")) {
     use_mkldnn = absl::get<bool>(attrs.attr_store.at("use_mkldnn"));
   }
@@ -41,3 +41,6 @@ CINN_USE_REGISTER(bitcast_convert_ops)
 CINN_USE_REGISTER(op_external_api)
 CINN_USE_REGISTER(resize_ops)
 CINN_USE_REGISTER(assert_true_ops)
+CINN_USE_REGISTER(quantize_ops)
+CINN_USE_REGISTER(scan_ops)
+CINN_USE_REGISTER(layer_norm_ops)
@@ -12,16 +12,21 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "cinn/hlir/framework/graph.h"
 #include "cinn/hlir/framework/node.h"
 #include "cinn/hlir/framework/op.h"
-#include "cinn/hlir/framework/op_lowering_util.h"
 #include "cinn/hlir/framework/pass.h"
 #include "cinn/hlir/pass/use_pass.h"
+#include "cinn/utils/functional.h"
 #include "cinn/utils/string.h"
+#include "cinn/utils/timer.h"
 
 namespace cinn {
 namespace hlir {
@@ -31,11 +36,9 @@ using framework::Graph;
 using framework::Node;
 using framework::NodeData;
 
-using common::GraphEdge;
 using common::GraphNode;
 
-using InputToNodeMap = std::unordered_map<std::string, std::unordered_set<Node*>>;
-using shape_dict_t   = absl::flat_hash_map<std::string, framework::shape_t>;
+using shape_dict_t = absl::flat_hash_map<std::string, framework::shape_t>;
 
 std::unordered_set<std::string> unordered_ops = {
     "elementwise_add",
@@ -65,232 +68,291 @@ std::unordered_map<std::string, int> special_attrs = {
     {"axes", 2},
     {"perm", 2}};
 
-bool IsSameSubexpression(Node* op1, Node* op2, shape_dict_t& shape_dict) {
-  // Get the input edges for op1 and op2 in order.
-  auto op1_in_edges = op1->inlinks_in_order();
-  auto op2_in_edges = op2->inlinks_in_order();
-  // Get the number of input edges for op1 and op2
-  auto op1_inputs_size = op1_in_edges.size();
-  auto op2_inputs_size = op2_in_edges.size();
-  // If the number of input edges is not the same, the subexpression is not the same.
-  if (op1_inputs_size != op2_inputs_size) {
-    return false;
-  }
-  // Get the number of attributes for op1 and op2.
-  auto op1_attrs_size = op1->attrs.attr_store.size();
-  auto op2_attrs_size = op2->attrs.attr_store.size();
-  // If the number of attributes is not the same, the subexpression is not the same.
-  if (op1_attrs_size != op2_attrs_size) {
-    return false;
+// Those ops are not pure, the same inputs and attributes may produce different outputs.
+std::unordered_set<std::string> nondeterministic_ops = {
+    "uniform_random",
+    "gaussian_random",
+    "randint",
+};
+
+// The structural key of the value computed by an op node. Two nodes with the same key compute the same outputs, so
+// the later one is replaced by the former.
+struct ValueKey {
+  std::string op_name;
+  // The value numbers of the inputs, sorted for the unordered ops.
+  std::vector<int> inputs;
+  // The attributes sorted by name, with the special attrs canonicalized.
+  std::vector<std::pair<std::string, utils::Attribute>> attrs;
+  std::vector<framework::shape_t> output_shapes;
+  std::vector<common::Type> output_dtypes;
+
+  bool operator==(const ValueKey& other) const {
+    return op_name == other.op_name && inputs == other.inputs && attrs == other.attrs &&
+           output_shapes == other.output_shapes && output_dtypes == other.output_dtypes;
   }
-  // Check if the input nodes match.
-  if (unordered_ops.count(op1->op()->name)) {
-    // For unordered ops, check if any input node of op2 matches any input node of op1.
-    for (auto& op1_edge : op1_in_edges) {
-      auto* op1_source_node = op1_edge->source()->safe_as<NodeData>();
-      CHECK(op1_source_node);
-      bool op1_equal_op2 = std::any_of(op2_in_edges.begin(), op2_in_edges.end(), [&](common::Shared<GraphEdge>& edge) {
-        auto* op2_source_node = edge->source()->safe_as<NodeData>();
-        CHECK(op2_source_node);
-        if (op1_source_node->id() == op2_source_node->id()) {
-          return true;
-        }
-        return false;
-      });
-      if (!op1_equal_op2) {
-        return false;
-      }
+};
+
+struct ValueKeyHash {
+  size_t operator()(const ValueKey& key) const {
+    uint64_t seed = std::hash<std::string>()(key.op_name);
+    for (int input : key.inputs) {
+      seed = utils::HashCombine(seed, input);
     }
-  } else {
-    // For ordered ops, check if the input nodes match one-to-one.
-    for (int i = 0; i < op1_inputs_size; ++i) {
-      auto* op1_source_node = op1_in_edges[i]->source()->safe_as<NodeData>();
-      auto* op2_source_node = op2_in_edges[i]->source()->safe_as<NodeData>();
-      CHECK(op1_source_node);
-      CHECK(op2_source_node);
-      if (op1_source_node->id() != op2_source_node->id()) {
-        return false;
+    for (auto& attr : key.attrs) {
+      seed = utils::HashCombine(seed, attr.first);
+      // the string is only used to hash, the attributes are compared exactly by operator==
+      seed = utils::HashCombine(seed, utils::Attribute2String(attr.second));
+    }
+    for (auto& shape : key.output_shapes) {
+      for (int dim : shape) {
+        seed = utils::HashCombine(seed, dim);
       }
     }
+    return seed;
   }
+};
 
-  // Check if the number of dimensions is the same.
-  auto* op1_sink_node = GetNodeData(op1);
-  auto* op2_sink_node = GetNodeData(op2);
-  if (shape_dict[op1_sink_node->id()].size() != shape_dict[op2_sink_node->id()].size()) {
-    return false;
+// The op name used to check the properties, the custom call ops keep their original op in the attributes.
+std::string GetOriginalOpName(const Node* node) {
+  auto iter = node->attrs.attr_store.find("original_op");
+  if (node->op()->name == "custom_call" && iter != node->attrs.attr_store.end()) {
+    return absl::get<std::string>(iter->second);
   }
-  if (reshape_ops.count(op1->op()->name)) {
-    // For reshape ops, check if the reshaped shape is the same.
-    return shape_dict[op1_sink_node->id()] == shape_dict[op2_sink_node->id()];
-  } else {
-    // For non-reshape ops, check if the attributes is the same.
-    return std::all_of(op1->attrs.attr_store.begin(), op1->attrs.attr_store.end(), [&](auto attr) {
-      if (!op2->attrs.attr_store.count(attr.first)) {
-        return false;
-      }
-      auto& attr1 = attr.second;
-      auto& attr2 = op2->attrs.attr_store[attr.first];
-      auto ndim   = static_cast<int>(shape_dict[op1_sink_node->id()].size());
-      if (special_attrs.count(attr.first)) {
-        switch (special_attrs[attr.first]) {
-          case 1: {
-            auto op1_axis = absl::get<int>(attr1);
-            auto op2_axis = absl::get<int>(attr2);
-            if (op1_axis < 0) {
-              op1_axis += ndim;
-            }
-            if (op2_axis < 0) {
-              op2_axis += ndim;
-            }
-            return op2_axis == op1_axis;
-          }
-          case 2: {
-            auto& op1_axes = absl::get<std::vector<int>>(attr1);
-            auto& op2_axes = absl::get<std::vector<int>>(attr2);
-            auto op1_size  = op1_axes.size();
-            auto op2_size  = op2_axes.size();
-            if (op1_size != op2_size) {
-              return false;
-            }
-            for (int i = 0; i < op1_axes.size(); ++i) {
-              int op1_axis = op1_axes[i];
-              int op2_axis = op2_axes[i];
-              if (op1_axis < 0) {
-                op1_axis += ndim;
-              }
-              if (op2_axis < 0) {
-                op2_axis += ndim;
-              }
-              if (op2_axis != op1_axis) {
-                return false;
-              }
-            }
-            return true;
-          }
-        }
+  return node->op()->name;
+}
+
+utils::Attribute CanonicalizeAttr(const std::string& name, const utils::Attribute& attr, int ndim) {
+  if (!special_attrs.count(name)) {
+    return attr;
+  }
+  auto normalize = [ndim](int axis) { return axis < 0 ? axis + ndim : axis; };
+  switch (special_attrs[name]) {
+    case 1:
+      return absl::holds_alternative<int>(attr) ? utils::Attribute(normalize(absl::get<int>(attr))) : attr;
+    case 2: {
+      if (!absl::holds_alternative<std::vector<int>>(attr)) {
+        return attr;
       }
-      return attr1 == attr2;
-    });
+      auto axes = absl::get<std::vector<int>>(attr);
+      std::transform(axes.begin(), axes.end(), axes.begin(), normalize);
+      return axes;
+    }
   }
+  return attr;
 }
 
-void RemoveNodes(framework::Graph* graph, GraphNode* node) {
-  auto in_edges = node->inlinks();
+// A variable written by more than one op holds different values in its lifetime, the ops reading or writing it cannot
+// be numbered by the variable.
+bool IsMultiVersion(const NodeData* data) { return data->inlinks().size() > 1; }
+
+// Replace the inputs of node by replace_map, and keep the order of the inputs.
+void ReplaceInputs(Node* node, const std::unordered_map<NodeData*, NodeData*>& replace_map) {
+  auto in_edges = node->inlinks_in_order();
+  std::vector<NodeData*> inputs;
+  bool changed = false;
   for (auto& edge : in_edges) {
-    auto* in_node = edge->source();
-    in_node->UnLinkSingleTo(node);
+    auto* source = edge->source()->safe_as<NodeData>();
+    CHECK(source);
+    auto iter = replace_map.find(source);
+    changed   = changed || iter != replace_map.end();
+    inputs.push_back(iter != replace_map.end() ? iter->second : source);
   }
-  auto out_edges = node->outlinks();
-  for (auto& edge : out_edges) {
-    auto* out_node = edge->sink();
-    node->UnLinkSingleTo(out_node);
+  if (!changed) {
+    return;
+  }
+  // LinkTo appends the input at the end, so relink all the inputs to keep their order.
+  for (auto& edge : in_edges) {
+    edge->source()->UnLinkAllTo(node);
+  }
+  for (auto* input : inputs) {
+    input->LinkTo(node);
   }
-  graph->DropNode(node);
 }
 
-void RemoveNodes(framework::Graph* graph, std::vector<Node*>& nodes) {
-  for (auto* node : nodes) {
-    RemoveNodes(graph, node);
+// Global value numbering over the graph in topological order: every variable gets a value number, and the op nodes
+// with the same key of the value numbers of their inputs are merged. A duplicated subgraph is merged as a whole in one
+// traversal, because the outputs of a merged node get the value numbers of the node it is merged into.
+class GlobalValueNumbering {
+ public:
+  explicit GlobalValueNumbering(Graph* graph)
+      : graph_(graph),
+        shape_dict_(graph->GetAttrs<shape_dict_t>("infershape")),
+        dtype_dict_(graph->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype")) {
+    for (auto* output : graph->outputs) {
+      fetch_outputs_.insert(output);
+    }
   }
-}
 
-void RemoveNodes(framework::Graph* graph, std::vector<NodeData*>& nodes_data) {
-  for (auto* data : nodes_data) {
-    if (std::find(graph->outputs.begin(), graph->outputs.end(), data) != graph->outputs.end()) {
-      return;
+  // Return the number of the eliminated op nodes.
+  int operator()() {
+    auto store_nodes = graph_->CachedTopologicalOrder();
+    for (auto* graph_node : store_nodes) {
+      auto* node = graph_node->safe_as<Node>();
+      if (node && node->op()) {
+        ++num_op_nodes_;
+        NumberNode(node);
+      }
     }
-    RemoveNodes(graph, data);
+    RemoveDuplicates();
+    return remove_nodes_.size();
   }
-}
 
-void ReplaceNode(NodeData* src_new, NodeData* src_old, Node* trt) {
-  std::vector<NodeData*> in_nodes;
-  for (auto& in_edge : trt->inlinks_in_order()) {
-    auto* in_node = in_edge->source()->safe_as<NodeData>();
-    if (in_node->id() == src_old->id()) {
-      in_node->UnLinkSingleTo(trt);
-      src_new->LinkTo(trt);
+  int num_op_nodes() const { return num_op_nodes_; }
+
+ private:
+  int GetValueNumber(NodeData* data) {
+    auto iter = value_numbers_.find(data);
+    if (iter != value_numbers_.end()) {
+      return iter->second;
     }
+    // the inputs and parameters of the graph are different values
+    return value_numbers_[data] = next_value_number_++;
   }
-}
 
-void CommonSubexpressionElimination(Graph* graph, std::vector<GraphNode*> store_nodes, InputToNodeMap in2node) {
-  std::unordered_map<std::string, std::vector<Node*>> candidates_map;
-  auto shape_dict = graph->GetAttrs<absl::flat_hash_map<std::string, framework::shape_t>>("infershape");
-  std::vector<Node*> remove_nodes;
-  std::vector<NodeData*> remove_nodes_data;
+  std::vector<NodeData*> GetOutputs(Node* node) {
+    std::vector<NodeData*> outputs;
+    for (auto& edge : node->outlinks_in_order()) {
+      auto* sink = edge->sink()->safe_as<NodeData>();
+      CHECK(sink);
+      outputs.push_back(sink);
+    }
+    return outputs;
+  }
 
-  while (!store_nodes.empty()) {
-    auto* graph_node = store_nodes[0];
-    store_nodes.erase(store_nodes.begin());
-    VLOG(4) << "size of store_nodes is " << store_nodes.size();
-    auto node = graph_node->safe_as<Node>();
-    if (node) {
-      auto& node_type  = node->op()->name;
-      auto& candidates = candidates_map[node_type];
-      bool found       = false;
-      for (auto* candidate_node : candidates) {
-        // If node is same with candidate_node, continue the next.
-        if (node->id() == candidate_node->id()) continue;
-        // If node is different from candidate_node, continue the next.
-        if (!IsSameSubexpression(node, candidate_node, shape_dict)) continue;
-        found = true;
-        for (int k = 0; k < node->outlinks_in_order().size(); ++k) {
-          const auto& out_links           = node->outlinks_in_order();
-          const auto& candidate_out_links = candidate_node->outlinks_in_order();
-          CHECK(out_links.size() == candidate_out_links.size());
-          auto* sink_node           = out_links[k]->sink()->safe_as<NodeData>();
-          auto* candidate_sink_node = candidate_out_links[k]->sink()->safe_as<NodeData>();
-          CHECK(sink_node);
-          CHECK(candidate_sink_node);
-          auto iter_sink_node = std::find(graph->outputs.begin(), graph->outputs.end(), sink_node);
-          if (iter_sink_node != graph->outputs.end()) {
-            // If sink node in outputs, the node cannot be removed.
-            continue;
-          }
-          remove_nodes_data.push_back(sink_node);
-          // Replace sink_node with candidate_sink_node in nodes linked by sink_node.
-          auto out_nodes = in2node[sink_node->id()];
-          for (auto out_node : out_nodes) {
-            ReplaceNode(candidate_sink_node, sink_node, out_node);
-            // The changed out node will be detected again.
-            if (std::find(store_nodes.begin(), store_nodes.end(), out_node) == store_nodes.end()) {
-              store_nodes.insert(store_nodes.begin(), out_node);
-            }
-          }
-        }
-        remove_nodes.push_back(node);
-        VLOG(4) << "remove " << node->id() << " node.";
-        break;
+  bool CanNumber(Node* node, const std::vector<NodeData*>& outputs) {
+    if (nondeterministic_ops.count(GetOriginalOpName(node)) || outputs.empty()) {
+      return false;
+    }
+    for (auto& edge : node->inlinks()) {
+      if (IsMultiVersion(edge->source()->safe_as<NodeData>())) {
+        return false;
+      }
+    }
+    return std::none_of(outputs.begin(), outputs.end(), IsMultiVersion);
+  }
+
+  ValueKey BuildKey(Node* node, const std::vector<NodeData*>& outputs) {
+    ValueKey key;
+    key.op_name = node->op()->name;
+    int ndim    = -1;
+    for (auto& edge : node->inlinks_in_order()) {
+      auto* source = edge->source()->safe_as<NodeData>();
+      key.inputs.push_back(GetValueNumber(source));
+      if (ndim < 0) {
+        ndim = shape_dict_.at(source->id()).size();
       }
-      if (!found) {
-        candidates_map[node_type].push_back(node);
+    }
+    auto op_name = GetOriginalOpName(node);
+    // the order of the inputs matters when they are broadcast along a given axis
+    auto axis_iter = node->attrs.attr_store.find("axis");
+    bool is_default_axis =
+        axis_iter == node->attrs.attr_store.end() || !absl::holds_alternative<int>(axis_iter->second) ||
+        absl::get<int>(axis_iter->second) == -1;
+    if (unordered_ops.count(op_name) && is_default_axis) {
+      std::sort(key.inputs.begin(), key.inputs.end());
+    }
+    for (auto* output : outputs) {
+      key.output_shapes.push_back(shape_dict_.at(output->id()));
+      key.output_dtypes.push_back(dtype_dict_.at(output->id()));
+    }
+    if (ndim < 0) {
+      ndim = key.output_shapes[0].size();
+    }
+    // When all the inputs are the same, the reshape ops are determined by the output shapes.
+    if (!reshape_ops.count(op_name)) {
+      for (auto& attr : node->attrs.attr_store) {
+        key.attrs.emplace_back(attr.first, CanonicalizeAttr(attr.first, attr.second, ndim));
       }
+      std::sort(key.attrs.begin(), key.attrs.end(), [](auto& a, auto& b) { return a.first < b.first; });
     }
+    return key;
   }
-  // Node should be deleted before node data.
-  RemoveNodes(graph, remove_nodes);
-  RemoveNodes(graph, remove_nodes_data);
-}
 
-void CommonSubexpressionEliminationPass(Graph* graph) {
-  VLOG(3) << "CommonSubexpressionEliminationPass...!";
-  std::unordered_map<std::string, std::vector<Node*>> candidates_map;
-  InputToNodeMap in2node;
-  auto store_nodes = std::get<0>(graph->topological_order());
+  void NumberNode(Node* node) {
+    auto outputs = GetOutputs(node);
+    if (!CanNumber(node, outputs)) {
+      for (auto* output : outputs) {
+        value_numbers_[output] = next_value_number_++;
+      }
+      return;
+    }
+    auto key  = BuildKey(node, outputs);
+    auto iter = value_table_.find(key);
+    if (iter == value_table_.end()) {
+      for (auto* output : outputs) {
+        value_numbers_[output] = next_value_number_++;
+      }
+      value_table_.emplace(std::move(key), node);
+      return;
+    }
+    auto* origin_node    = iter->second;
+    auto origin_outputs  = GetOutputs(origin_node);
+    bool is_fetch_output = false;
+    for (int i = 0; i < outputs.size(); ++i) {
+      value_numbers_[outputs[i]] = value_numbers_.at(origin_outputs[i]);
+      is_fetch_output            = is_fetch_output || fetch_outputs_.count(outputs[i]);
+    }
+    // The fetched outputs should be kept, the node still shares the value numbers for its consumers to be merged.
+    if (is_fetch_output) {
+      return;
+    }
+    VLOG(4) << "Replace " << node->id() << " by " << origin_node->id();
+    for (int i = 0; i < outputs.size(); ++i) {
+      replace_map_[outputs[i]] = origin_outputs[i];
+    }
+    remove_nodes_.push_back(node);
+  }
 
-  for (auto& graph_node : store_nodes) {
-    auto node = graph_node->safe_as<Node>();
-    if (node) {
-      for (auto& in_edge : node->inlinks_in_order()) {
-        auto* source_node = in_edge->source()->safe_as<NodeData>();
-        in2node[source_node->id()].insert(node);
+  void RemoveDuplicates() {
+    std::unordered_set<GraphNode*> drop_nodes(remove_nodes_.begin(), remove_nodes_.end());
+    for (auto& item : replace_map_) {
+      drop_nodes.insert(item.first);
+    }
+    std::unordered_set<Node*> consumers;
+    for (auto& item : replace_map_) {
+      for (auto& edge : item.first->outlinks()) {
+        auto* consumer = edge->sink()->safe_as<Node>();
+        if (!drop_nodes.count(consumer)) {
+          consumers.insert(consumer);
+        }
       }
     }
+    for (auto* consumer : consumers) {
+      ReplaceInputs(consumer, replace_map_);
+    }
+    // unlink the removed op nodes and their outputs from the rest of the graph
+    for (auto* node : remove_nodes_) {
+      for (auto& edge : node->inlinks_in_order()) {
+        edge->source()->UnLinkAllTo(node);
+      }
+      for (auto* output : GetOutputs(node)) {
+        node->UnLinkAllTo(output);
+      }
+    }
+    graph_->DropNodes(drop_nodes);
   }
 
-  CommonSubexpressionElimination(graph, store_nodes, in2node);
+  Graph* graph_;
+  const shape_dict_t& shape_dict_;
+  const absl::flat_hash_map<std::string, common::Type>& dtype_dict_;
+  std::unordered_set<NodeData*> fetch_outputs_;
+
+  int next_value_number_{0};
+  int num_op_nodes_{0};
+  std::unordered_map<NodeData*, int> value_numbers_;
+  std::unordered_map<ValueKey, Node*, ValueKeyHash> value_table_;
+  std::unordered_map<NodeData*, NodeData*> replace_map_;
+  std::vector<Node*> remove_nodes_;
+};
+
+void CommonSubexpressionEliminationPass(Graph* graph) {
+  VLOG(3) << "CommonSubexpressionEliminationPass...!";
+  utils::Timer timer;
+  timer.Start();
+  GlobalValueNumbering gvn(graph);
+  int num_removed = gvn();
+  VLOG(1) << "CommonSubexpressionEliminationPass removes " << num_removed << " of " << gvn.num_op_nodes()
+          << " op nodes in " << timer.Stop() << " ms";
   VLOG(3) << "CommonSubexpressionEliminationPass Finish...!";
 }
 }  // namespace pass
@@ -299,7 +361,7 @@ void CommonSubexpressionEliminationPass(Graph* graph) {
 
 CINN_REGISTER_HELPER(CommonSubexpressionEliminationPass) {
   CINN_REGISTER_PASS(CommonSubexpressionEliminationPass)
-      .describe("This pass  will remove these same sub-expression.")
+      .describe("This pass will remove the same sub-expressions by global value numbering.")
       .set_change_structure(true)
       .set_body(cinn::hlir::pass::CommonSubexpressionEliminationPass);
 
@@ -28,7 +28,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <unordered_set>
 
 #include "cinn/frontend/net_builder.h"
 #include "cinn/frontend/syntax.h"
@@ -36,6 +39,7 @@
 #include "cinn/hlir/framework/graph_compiler.h"
 #include "cinn/hlir/framework/pass.h"
 #include "cinn/utils/data_util.h"
+#include "cinn/utils/timer.h"
 
 DEFINE_string(model_dir, "", "");
 
@@ -134,6 +138,113 @@ TEST(common_subexpression_elimination, common_subexpression_elimination_case2) {
   runtime_program->Execute();
 }
 
+int CountOpNodes(hlir::framework::Graph* graph) {
+  auto nodes = graph->nodes();
+  return std::count_if(nodes.begin(), nodes.end(), [](common::GraphNode* node) {
+    return node->safe_as<hlir::framework::Node>() != nullptr;
+  });
+}
+
+// The same chain built twice, like the position embedding computed in every layer.
+Variable BuildEmbedding(NetBuilder* builder, const Variable& x, const Variable& w, const Variable& b) {
+  auto mul  = builder->Multiply(x, w);
+  auto add  = builder->Add(b, mul);
+  auto relu = builder->Relu(add);
+  auto t    = builder->Transpose(relu, {1, 0});
+  return builder->ReduceSum(t, {-1}, true);
+}
+
+TEST(common_subexpression_elimination, duplicated_subgraph) {
+  NetBuilder builder("duplicated_subgraph");
+  auto x   = builder.CreateInput(Float(32), {32, 32}, "x");
+  auto w   = builder.CreateInput(Float(32), {32, 32}, "w");
+  auto b   = builder.CreateInput(Float(32), {32, 32}, "b");
+  auto e_1 = BuildEmbedding(&builder, x, w, b);
+  auto e_2 = BuildEmbedding(&builder, w, x, b);
+  // the order of the inputs matters for subtract, and the merged inputs keep their order
+  auto sub_1 = builder.Subtract(e_1, x);
+  auto sub_2 = builder.Subtract(x, e_2);
+  auto out   = builder.Add(sub_1, sub_2);
+
+  auto program  = builder.Build();
+  Target target = common::DefaultHostTarget();
+  auto graph    = std::make_shared<hlir::framework::Graph>(program, std::unordered_set<std::string>{out->id}, target);
+  ASSERT_EQ(CountOpNodes(graph.get()), 13);
+
+  hlir::framework::ApplyPass(graph.get(), "InferShape");
+  hlir::framework::ApplyPass(graph.get(), "CommonSubexpressionEliminationPass");
+  LOG(INFO) << "graph:\n" << graph->DebugGroupedGraph({out->id});
+  // the second chain is merged into the first one as a whole
+  ASSERT_EQ(CountOpNodes(graph.get()), 8);
+
+  hlir::framework::ApplyPass(graph.get(), "BuildNonFusedGroupsPass");
+  auto scope = BuildScope(target, graph);
+  hlir::framework::GraphCompiler gc(target, scope, graph);
+  auto runtime_program = gc.Build();
+  for (auto& name : {"x", "w", "b"}) {
+    scope->Var<hlir::framework::Tensor>(name);
+    SetRandData<float>(scope->GetTensor(name), target);
+  }
+  runtime_program->Execute();
+
+  // (e - x) + (x - e) is zero only if the inputs of the subtracts are not swapped
+  auto result = GetTensorData<float>(scope->GetTensor(out->id), target);
+  for (float value : result) {
+    ASSERT_NEAR(value, 0.0f, 1e-5f);
+  }
+}
+
+TEST(common_subexpression_elimination, keep_fetch_and_random) {
+  NetBuilder builder("keep_fetch_and_random");
+  auto x        = builder.CreateInput(Float(32), {8, 8}, "x");
+  auto exp_1    = builder.Exp(x);
+  auto exp_2    = builder.Exp(x);
+  auto sum_1    = builder.ReduceSum(x, {-1});
+  auto sum_2    = builder.ReduceSum(x, {0});
+  auto random_1 = builder.UniformRandom({8, 8}, -1.0f, 1.0f, 0);
+  auto random_2 = builder.UniformRandom({8, 8}, -1.0f, 1.0f, 0);
+
+  auto program = builder.Build();
+  std::unordered_set<std::string> fetch_ids{exp_1->id, exp_2->id, sum_1->id, sum_2->id, random_1->id, random_2->id};
+  auto graph = std::make_shared<hlir::framework::Graph>(program, fetch_ids, common::DefaultHostTarget());
+
+  hlir::framework::ApplyPass(graph.get(), "InferShape");
+  hlir::framework::ApplyPass(graph.get(), "CommonSubexpressionEliminationPass");
+  // the fetched outputs, the different reduced axes of the same rank and the random ops are all kept
+  ASSERT_EQ(CountOpNodes(graph.get()), 6);
+}
+
+TEST(common_subexpression_elimination, large_graph) {
+  int num_layers = 500;
+  NetBuilder builder("large_graph");
+  auto x = builder.CreateInput(Float(32), {32, 32}, "x");
+  auto w = builder.CreateInput(Float(32), {32, 32}, "w");
+  auto b = builder.CreateInput(Float(32), {32, 32}, "b");
+
+  auto out = x;
+  for (int i = 0; i < num_layers; ++i) {
+    // every layer recomputes the same embedding of the inputs
+    auto embedding = BuildEmbedding(&builder, x, w, b);
+    out            = builder.Add(builder.Relu(out), builder.BroadcastTo(embedding, {32, 32}));
+  }
+
+  auto program  = builder.Build();
+  Target target = common::DefaultHostTarget();
+  auto graph    = std::make_shared<hlir::framework::Graph>(program, std::unordered_set<std::string>{out->id}, target);
+  int num_nodes = CountOpNodes(graph.get());
+  ASSERT_EQ(num_nodes, num_layers * 8);
+
+  hlir::framework::ApplyPass(graph.get(), "InferShape");
+  utils::Timer timer;
+  timer.Start();
+  hlir::framework::ApplyPass(graph.get(), "CommonSubexpressionEliminationPass");
+  auto cost = timer.Stop();
+  // a single embedding and broadcast are left
+  ASSERT_EQ(CountOpNodes(graph.get()), 6 + num_layers * 2);
+  LOG(INFO) << "CommonSubexpressionEliminationPass removes " << num_nodes - CountOpNodes(graph.get()) << " of "
+            << num_nodes << " op nodes in " << cost << " ms";
+}
+
 #ifdef CINN_WITH_CUDA
 TEST(common_subexpression_elimination, common_subexpression_elimination_case3) {
   auto strides     = std::vector<int>({2, 2});
@@ -31,7 +31,7 @@ using framework::NodeData;
 using framework::Operator;
 
 void ConstPropagatePass(Graph* graph) {
-  auto store_nodes = std::get<0>(graph->topological_order());
+  const auto& store_nodes = graph->CachedTopologicalOrder();
   for (auto& n : store_nodes) {
     auto node = n->safe_as<Node>();
     if (node) {
@@ -68,6 +68,7 @@ CINN_REGISTER_HELPER(ConstPropagate) {
           "This pass will propagate const node_datas and mark the op_node with the attr[\"pre_run\"] if inputs are all "
           "constants;")
       .set_change_structure(false)
+      .preserve_analysis(cinn::hlir::framework::Graph::kTopologicalOrder)
       .provide_graph_attr("pre_run")
       .set_body(cinn::hlir::pass::ConstPropagatePass);
   return true;
@@ -40,7 +40,8 @@ class ConstantFoldingPassHelper : public FusionHelperBase {
     bool update = false;
     do {
       update             = false;
-      auto nodes_inorder = std::get<0>(graph_->topological_order());
+      // copy the order, the folding below changes the graph and invalidates the cached one
+      auto nodes_inorder = graph_->CachedTopologicalOrder();
       for (auto node : nodes_inorder) {
         if (!node->safe_as<Node>()) {
           continue;
@@ -75,6 +76,7 @@ class ConstantFoldingPassHelper : public FusionHelperBase {
         auto key = GetTypeName(node->safe_as<Node>());
         if (alter_function_.count(key)) {
           alter_function_[key](this, graph_, node->safe_as<Node>());
+          graph_->InvalidateAnalyses();
           update = true;
         }
       }
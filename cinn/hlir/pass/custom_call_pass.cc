@@ -42,8 +42,10 @@ class GraphAlterHelper {
       if (graph_node->safe_as<Node>()) {
         auto node      = graph_node->safe_as<Node>();
         auto&& op_name = node->op()->name;
-        // a op with external_api registered and not excluded explicitly will be selected
-        if (!IsExcluded(op_name) && ExternalApiRegistry::Global()->Has(op_name, target)) {
+        // a op with external_api registered, supported by the external api and not excluded explicitly will be
+        // selected, the others stay on the compute implement
+        if (!IsExcluded(op_name) &&
+            ExternalApiRegistry::Global()->IsSupported(op_name, node->attrs, InputTypes(node), target)) {
           VLOG(4) << "Op:" << op_name << " will use custom_call";
           return true;
         }
@@ -77,6 +79,16 @@ class GraphAlterHelper {
   std::unordered_set<std::string> deny_ops_;
 
   bool IsExcluded(const std::string& op_name) { return deny_ops_.count(op_name); }
+
+  std::vector<common::Type> InputTypes(const Node* node) {
+    const auto& dtype_dict = graph_->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+    std::vector<common::Type> input_types;
+    for (auto& link : node->inlinks_in_order()) {
+      auto it = dtype_dict.find(link->source()->id());
+      input_types.emplace_back(it != dtype_dict.end() ? it->second : common::Type());
+    }
+    return input_types;
+  }
 };
 
 void TransToCustomCallInternal(Graph* graph) {
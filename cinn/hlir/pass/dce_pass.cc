@@ -72,7 +72,7 @@ class DceHelper : public FusionHelperBase {
   }
 
   void RemoveDeadNode() {
-    auto nodes_inorder = std::get<0>(graph_->topological_order());
+    auto nodes_inorder = graph_->CachedTopologicalOrder();
     std::vector<Node*> all_nodes_list;
     for (auto node : nodes_inorder) {
       if (!node->safe_as<Node>()) {
@@ -0,0 +1,154 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/hlir/pass/fusion_cost_model.h"
+
+#include <glog/logging.h>
+
+#include <cmath>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+#include "cinn/utils/string.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+
+int FusionCostModel::GetOpFlopsPerElement(const std::string& op_name) {
+  static const std::unordered_map<std::string, int> op_flops = {
+      {"exp", 16}, {"log", 16}, {"log2", 16}, {"log10", 16}, {"tanh", 16}, {"sigmoid", 16}, {"erf", 16}, {"gelu", 24},
+      {"pow", 24}, {"sqrt", 8}, {"rsqrt", 8}, {"divide", 8}, {"sin", 16}, {"cos", 16}, {"tan", 16}, {"atan", 16},
+      {"mod", 8}, {"remainder", 8}};
+  auto it = op_flops.find(op_name);
+  return it == op_flops.end() ? 1 : it->second;
+}
+
+AnalyticFusionCostModel::AnalyticFusionCostModel(const common::Target& target) {
+  if (target.arch == common::Target::Arch::NVGPU) {
+    // 500 GB/s, 10 TFLOPS and 5 us per launch
+    bytes_per_us_ = 5e5;
+    flops_per_us_ = 1e7;
+    launch_us_    = 5;
+  } else {
+    // 10 GB/s, 10 GFLOPS and 1 us per call of a single core
+    bytes_per_us_ = 1e4;
+    flops_per_us_ = 1e4;
+    launch_us_    = 1;
+  }
+}
+
+AnalyticFusionCostModel::AnalyticFusionCostModel(double bytes_per_us, double flops_per_us, double launch_us)
+    : bytes_per_us_(bytes_per_us), flops_per_us_(flops_per_us), launch_us_(launch_us) {
+  CHECK_GT(bytes_per_us_, 0) << "The memory bandwidth should be positive.";
+  CHECK_GT(flops_per_us_, 0) << "The compute throughput should be positive.";
+  CHECK_GE(launch_us_, 0) << "The launch overhead should not be negative.";
+}
+
+double AnalyticFusionCostModel::Gain(const FusionFeature& feature) const {
+  double saved = feature.saved_bytes / bytes_per_us_ + feature.num_saved_kernels * launch_us_;
+  double cost  = feature.recompute_bytes / bytes_per_us_ + feature.recompute_flops / flops_per_us_;
+  return saved - cost;
+}
+
+bool AnalyticFusionCostModel::Calibrate(const std::vector<KernelSample>& samples) {
+  CHECK_GE(samples.size(), 3UL) << "At least 3 kernels are required to calibrate the cost model.";
+  // the normal equations of time = bytes * x0 + flops * x1 + x2
+  double lhs[3][3] = {{0}};
+  double rhs[3]    = {0};
+  for (auto& sample : samples) {
+    double row[3] = {static_cast<double>(sample.bytes), static_cast<double>(sample.flops), 1.0};
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        lhs[i][j] += row[i] * row[j];
+      }
+      rhs[i] += row[i] * sample.time_us;
+    }
+  }
+  // gaussian elimination with partial pivoting
+  for (int col = 0; col < 3; ++col) {
+    int pivot = col;
+    for (int row = col + 1; row < 3; ++row) {
+      if (std::abs(lhs[row][col]) > std::abs(lhs[pivot][col])) {
+        pivot = row;
+      }
+    }
+    if (std::abs(lhs[pivot][col]) < 1e-12) {
+      LOG(WARNING) << "The measured kernels are degenerate, the cost model is not calibrated.";
+      return false;
+    }
+    std::swap(lhs[col], lhs[pivot]);
+    std::swap(rhs[col], rhs[pivot]);
+    for (int row = col + 1; row < 3; ++row) {
+      double ratio = lhs[row][col] / lhs[col][col];
+      for (int j = col; j < 3; ++j) {
+        lhs[row][j] -= ratio * lhs[col][j];
+      }
+      rhs[row] -= ratio * rhs[col];
+    }
+  }
+  double x[3];
+  for (int i = 2; i >= 0; --i) {
+    x[i] = rhs[i];
+    for (int j = i + 1; j < 3; ++j) {
+      x[i] -= lhs[i][j] * x[j];
+    }
+    x[i] /= lhs[i][i];
+  }
+
+  bool updated = false;
+  if (x[0] > 0) {
+    bytes_per_us_ = 1.0 / x[0];
+    updated       = true;
+  }
+  if (x[1] > 0) {
+    flops_per_us_ = 1.0 / x[1];
+    updated       = true;
+  }
+  if (x[2] >= 0) {
+    launch_us_ = x[2];
+    updated    = true;
+  }
+  VLOG(3) << "Calibrate the fusion cost model by " << samples.size() << " kernels: " << bytes_per_us_ << " bytes/us, "
+          << flops_per_us_ << " flops/us, " << launch_us_ << " us per launch";
+  return updated;
+}
+
+void FusionReport::Add(const FusionDecision& decision) {
+  decisions.push_back(decision);
+  if (decision.accepted) {
+    ++num_accepted;
+    saved_bytes += decision.feature.saved_bytes - decision.feature.recompute_bytes;
+  } else {
+    ++num_rejected;
+  }
+}
+
+std::string FusionReport::DebugString() const {
+  std::stringstream ss;
+  ss << "FusionMergePass accepts " << num_accepted << " and rejects " << num_rejected
+     << " vertical merges, the estimated saved bytes: " << saved_bytes << "\n";
+  for (auto& decision : decisions) {
+    ss << (decision.accepted ? "  accept " : "  reject ") << decision.producer << " -> ["
+       << utils::Join(decision.consumers, ", ") << "]" << (decision.recompute ? " with recompute" : "")
+       << ", saved bytes: " << decision.feature.saved_bytes << ", recompute bytes: " << decision.feature.recompute_bytes
+       << ", recompute flops: " << decision.feature.recompute_flops << ", gain: " << decision.gain_us << " us\n";
+  }
+  return ss.str();
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
@@ -0,0 +1,115 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cinn/common/target.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+
+// The memory traffic and the recomputation of fusing a producer group into its consumer groups.
+struct FusionFeature {
+  // the bytes of the producer outputs which are no longer written to or read from the global memory
+  int64_t saved_bytes{0};
+  // the bytes of the producer inputs read again by the consumers recomputing the producer
+  int64_t recompute_bytes{0};
+  // the arithmetic operations of the producer computed again by the consumers
+  int64_t recompute_flops{0};
+  // the number of the kernel launches removed
+  int num_saved_kernels{0};
+};
+
+// A kernel measured for calibrating the cost model.
+struct KernelSample {
+  int64_t bytes{0};
+  int64_t flops{0};
+  double time_us{0};
+};
+
+/**
+ * FusionCostModel estimates the time gain of a fusion candidate from its features, FusionMergePass rejects the
+ * vertical merges with a negative gain. A model can be plugged into the pass by the graph attr "fusion_cost_model" of
+ * type std::shared_ptr<FusionCostModel>.
+ */
+class FusionCostModel {
+ public:
+  virtual ~FusionCostModel() = default;
+
+  //! The estimated time in microseconds saved by the fusion, a negative one means a slowdown.
+  virtual double Gain(const FusionFeature& feature) const = 0;
+
+  //! The arithmetic operations per output element of an op, the transcendental ops cost more.
+  static int GetOpFlopsPerElement(const std::string& op_name);
+};
+
+// The analytic model estimating the time by the memory bandwidth, the compute throughput and the launch overhead.
+class AnalyticFusionCostModel : public FusionCostModel {
+ public:
+  //! The default parameters of the target.
+  explicit AnalyticFusionCostModel(const common::Target& target);
+
+  AnalyticFusionCostModel(double bytes_per_us, double flops_per_us, double launch_us);
+
+  double Gain(const FusionFeature& feature) const override;
+
+  /**
+   * Fit the parameters to the measured kernels by the least squares of time = bytes / bandwidth + flops / throughput
+   * + launch overhead, the parameters fitted non-positive are kept.
+   * @param samples The measured kernels, at least 3 of them are required.
+   * @return Whether any parameter is updated.
+   */
+  bool Calibrate(const std::vector<KernelSample>& samples);
+
+  double bytes_per_us() const { return bytes_per_us_; }
+  double flops_per_us() const { return flops_per_us_; }
+  double launch_us() const { return launch_us_; }
+
+ private:
+  double bytes_per_us_;
+  double flops_per_us_;
+  double launch_us_;
+};
+
+// The decision on a vertical merge made by FusionMergePass.
+struct FusionDecision {
+  std::string producer;
+  std::vector<std::string> consumers;
+  bool recompute{false};
+  bool accepted{false};
+  FusionFeature feature;
+  double gain_us{0};
+};
+
+// The report of FusionMergePass stored in the graph attr "fusion_merge_report".
+struct FusionReport {
+  std::vector<FusionDecision> decisions;
+  int num_accepted{0};
+  int num_rejected{0};
+  // the estimated bytes of the memory traffic saved by the accepted merges
+  int64_t saved_bytes{0};
+
+  void Add(const FusionDecision& decision);
+
+  std::string DebugString() const;
+};
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
@@ -12,9 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "cinn/hlir/pass/fusion_cost_model.h"
 #include "cinn/hlir/pass/fusion_merge_pass_util.h"
 
 DECLARE_bool(enhance_vertical_fusion_with_recompute);
+DECLARE_bool(cinn_use_fusion_cost_model);
 
 namespace cinn {
 namespace hlir {
@@ -45,6 +47,18 @@ class FusionMergePassHelper : public FusionHelperBase {
  public:
   FusionMergePassHelper(const Graph* graph) : FusionHelperBase(graph) {
     fusion_groups_ = graph->fusion_groups;
+    if (graph->HasAttr("inferdtype")) {
+      type_dict_ = &graph->GetAttrs<absl::flat_hash_map<std::string, common::Type>>("inferdtype");
+    }
+    // a cost model plugged into the graph is always used to decide the vertical merges
+    if (graph->HasAttr("fusion_cost_model")) {
+      cost_model_     = graph->GetAttrs<std::shared_ptr<FusionCostModel>>("fusion_cost_model");
+      use_cost_model_ = true;
+      CHECK(cost_model_) << "The fusion_cost_model of the graph should not be null.";
+    } else {
+      cost_model_     = std::make_shared<AnalyticFusionCostModel>(target_);
+      use_cost_model_ = FLAGS_cinn_use_fusion_cost_model;
+    }
     // init fusion relation.
     InitFusionRelation();
     // init input to consumers.
@@ -68,9 +82,12 @@ class FusionMergePassHelper : public FusionHelperBase {
         VLOG(3) << "  Consumer -> " << consumer->group_id;
       }
     }
+    VLOG(3) << report_.DebugString();
     return fusion_groups_;
   }
 
+  const FusionReport& report() const { return report_; }
+
  private:
   void DoFusionMerge() {
     VLOG(3) << "DoFusionMerge...!";
@@ -438,6 +455,9 @@ class FusionMergePassHelper : public FusionHelperBase {
         return false;
       } else {
         RecomputeEleGraph(producer, fuse_consumers_unsafe);
+        if (!AcceptFusion(producer, fuse_consumers_unsafe, /* recompute=*/true)) {
+          return false;
+        }
         VerticalFuse(producer, fuse_consumers_unsafe);
         return true;
       }
@@ -448,7 +468,7 @@ class FusionMergePassHelper : public FusionHelperBase {
     }
 
     // if fusionable consumers exist
-    if (fuse_consumers.size()) {
+    if (fuse_consumers.size() && AcceptFusion(producer, fuse_consumers, /* recompute=*/fuse_consumers.size() > 1)) {
       VerticalFuse(producer, fuse_consumers);
       return true;
     }
@@ -633,6 +653,82 @@ class FusionMergePassHelper : public FusionHelperBase {
     }
   }
 
+  int64_t GetNodeDataBytes(const NodeData* node_data) const {
+    CHECK(shape_dict_.count(node_data->id())) << "Can't find " << node_data->id() << " 's shape!";
+    auto& shape   = shape_dict_.at(node_data->id());
+    int64_t numel = std::accumulate(shape.begin(), shape.end(), int64_t{1}, std::multiplies<int64_t>());
+    // the dtype is float32 if not inferred
+    int bytes = type_dict_ && type_dict_->count(node_data->id()) ? type_dict_->at(node_data->id()).bytes() : 4;
+    return numel * bytes;
+  }
+
+  // the memory traffic saved and the work recomputed when every consumer computes the producer again.
+  FusionFeature GetFusionFeature(const GroupPtr& producer,
+                                 const std::unordered_set<GroupPtr, Hasher, Comparator>& consumers) const {
+    FusionFeature feature;
+    feature.num_saved_kernels = 1;
+    for (auto node : producer->output_nodes) {
+      int64_t bytes     = GetNodeDataBytes(GetNodeData(node));
+      bool materialized = output_nodes_set_.count(node);
+      for (auto& consumer : producer->consumer_groups) {
+        auto it = consumer->input_nodes.find(node);
+        if (it == consumer->input_nodes.end()) {
+          continue;
+        }
+        if (consumers.count(consumer)) {
+          feature.saved_bytes += bytes * it->second;
+        } else {
+          materialized = true;
+        }
+      }
+      // the output is not written if no other group reads it
+      if (!materialized) {
+        feature.saved_bytes += bytes;
+      }
+    }
+
+    int64_t num_recompute = static_cast<int64_t>(consumers.size()) - 1;
+    if (num_recompute <= 0) {
+      return feature;
+    }
+    auto nodes = producer->CollectNodes();
+    std::unordered_set<Node*> nodes_set(nodes.begin(), nodes.end());
+    std::unordered_set<NodeData*> inputs;
+    for (auto node : nodes) {
+      for (auto input : GetProducerNodeData(node)) {
+        if (!input->source_node.get() || !nodes_set.count(input->source_node.get())) {
+          inputs.insert(input);
+        }
+      }
+      auto shape   = GetNodeDataShape(node);
+      int64_t numel = std::accumulate(shape.begin(), shape.end(), int64_t{1}, std::multiplies<int64_t>());
+      feature.recompute_flops += num_recompute * numel * FusionCostModel::GetOpFlopsPerElement(node->op()->name);
+    }
+    for (auto input : inputs) {
+      feature.recompute_bytes += num_recompute * GetNodeDataBytes(input);
+    }
+    return feature;
+  }
+
+  // score the merge by the cost model and record it in the report, it is rejected only if the cost model is enabled.
+  bool AcceptFusion(const GroupPtr& producer,
+                    const std::unordered_set<GroupPtr, Hasher, Comparator>& consumers,
+                    bool recompute) {
+    FusionDecision decision;
+    decision.producer  = producer->group_id;
+    decision.recompute = recompute;
+    for (auto& consumer : consumers) {
+      decision.consumers.push_back(consumer->group_id);
+    }
+    decision.feature  = GetFusionFeature(producer, consumers);
+    decision.gain_us  = cost_model_->Gain(decision.feature);
+    decision.accepted = !use_cost_model_ || decision.gain_us >= 0;
+    VLOG(4) << (decision.accepted ? "Accept" : "Reject") << " fusing producer " << producer->group_id << " into "
+            << consumers.size() << " consumers, the estimated gain is " << decision.gain_us << " us";
+    report_.Add(decision);
+    return decision.accepted;
+  }
+
   void RecomputeEleGraph(const GroupPtr& producer,
                          std::unordered_set<GroupPtr, Hasher, Comparator>& fusionable_consumers) {
     if (producer->op_pattern_kind != framework::kElementWise) {
@@ -645,24 +741,33 @@ class FusionMergePassHelper : public FusionHelperBase {
     // if is const op
     if (is_const_group(this, producer)) {
       std::unordered_set<GroupPtr, Hasher, Comparator> candidates;
+      std::unordered_set<GroupPtr, Hasher, Comparator> merge_consumers;
       for (auto& consumer : fusionable_consumers) {
         // if can be output node.
         if (is_same_shape(this, producer, consumer)) {
           candidates.insert(consumer);
         } else {
-          VLOG(4) << "Fuse Producer : " << producer->group_id << " into Consumer : " << consumer->group_id;
-          consumer->group_id = producer->group_id + "_" + consumer->group_id;
-          // just merge the node into group.
-          auto& sub_group     = consumer->fused_sub_groups.front();
-          sub_group->group_id = producer->group_id + "_" + sub_group->group_id;
-          sub_group->nodes.insert(sub_group->nodes.begin(), producer->CollectNodes()[0]);
-          sub_group->nodes_set.insert(producer->CollectNodes()[0]);
-          // remove depency.
-          consumer->input_nodes.erase(producer->CollectNodes()[0]);
-          consumer->producer_groups.erase(producer);
-          producer->consumer_groups.erase(consumer);
+          merge_consumers.insert(consumer);
         }
       }
+      // the const node is copied into every merged consumer, score it before the merge changes the dependency.
+      if (!merge_consumers.empty() &&
+          !AcceptFusion(producer, merge_consumers, /* recompute=*/merge_consumers.size() > 1)) {
+        merge_consumers.clear();
+      }
+      for (auto& consumer : merge_consumers) {
+        VLOG(4) << "Fuse Producer : " << producer->group_id << " into Consumer : " << consumer->group_id;
+        consumer->group_id = producer->group_id + "_" + consumer->group_id;
+        // just merge the node into group.
+        auto& sub_group     = consumer->fused_sub_groups.front();
+        sub_group->group_id = producer->group_id + "_" + sub_group->group_id;
+        sub_group->nodes.insert(sub_group->nodes.begin(), producer->CollectNodes()[0]);
+        sub_group->nodes_set.insert(producer->CollectNodes()[0]);
+        // remove depency.
+        consumer->input_nodes.erase(producer->CollectNodes()[0]);
+        consumer->producer_groups.erase(producer);
+        producer->consumer_groups.erase(consumer);
+      }
 
       CHECK_GE(producer->consumer_groups.size(), candidates.size());
       if (producer->consumer_groups.size() == 0 && candidates.size() == 0 &&
@@ -1004,16 +1109,23 @@ class FusionMergePassHelper : public FusionHelperBase {
     std::unordered_map<framework::OpPatternKind, ConditionFunction> horizontal_relation;
   };
   std::unordered_map<framework::OpPatternKind, Relation> fusion_relation_map_;
+
+  const absl::flat_hash_map<std::string, common::Type>* type_dict_{nullptr};
+  std::shared_ptr<FusionCostModel> cost_model_;
+  bool use_cost_model_{false};
+  FusionReport report_;
 };
 
 void FusionMergePassInternal(Graph* graph) {
   if (graph->fusion_groups.size() <= 1) {
     VLOG(3) << "Don't do Fusoin Merge Pass...!";
+    graph->attrs["fusion_merge_report"] = std::make_shared<absl::any>(FusionReport());
     return;
   }
 
   FusionMergePassHelper fusion_merge_pass_helper(graph);
-  graph->fusion_groups = fusion_merge_pass_helper();
+  graph->fusion_groups                = fusion_merge_pass_helper();
+  graph->attrs["fusion_merge_report"] = std::make_shared<absl::any>(fusion_merge_pass_helper.report());
 }
 
 }  // namespace pass
@@ -1026,6 +1138,8 @@ CINN_REGISTER_HELPER(FusionMergePass) {
           "Fusion Merge Pass which performs Fusion-Ops fusion, Producer Fusion-Ops are fused into Consumer Fusion-Ops "
           "with certain conditions.")
       .set_change_structure(false)
+      .preserve_analysis(cinn::hlir::framework::Graph::kTopologicalOrder)
+      .provide_graph_attr("fusion_merge_report")
       .set_body(cinn::hlir::pass::FusionMergePassInternal);
 
   return true;
@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include "cinn/frontend/decomposer/test_helper.h"
+#include "cinn/hlir/pass/fusion_cost_model.h"
 
 namespace cinn {
 namespace frontend {
@@ -483,5 +484,78 @@ TEST(FusionMergePass, Reduce_Test_5) {
   CHECK_EQ(graph->fusion_groups.size(), 1);
 }
 
+class RejectAllCostModel : public hlir::pass::FusionCostModel {
+ public:
+  double Gain(const hlir::pass::FusionFeature& feature) const override { return -1.0; }
+};
+
+TEST(FusionMergePass, CostModel_Reject) {
+  int h = 32, w = 32;
+  NetBuilder net_builder("CostModel_Reject");
+  // create model
+  {
+    auto A = net_builder.CreateInput(Float(32), {h, w}, "A");
+    auto B = net_builder.CreateInput(Float(32), {h, w}, "B");
+    auto C = net_builder.CreateInput(Float(32), {h, w}, "C");
+    auto D = net_builder.CreateInput(Float(32), {h, w}, "D");
+    auto E = net_builder.CreateInput(Float(32), {h, w}, "E");
+    auto F = net_builder.CreateInput(Float(32), {h, w}, "F");
+    auto G = net_builder.Add(A, B);
+    auto H = net_builder.Add(G, C);
+    auto I = net_builder.Add(G, D);
+    auto J = net_builder.Add(G, E);
+    auto K = net_builder.Add(G, F);
+  }
+
+  auto program = net_builder.Build();
+  auto target  = common::DefaultTarget();
+  RunDecomposer(&program, target);
+
+  // the default cost model only reports the merges
+  auto graph = std::make_shared<hlir::framework::Graph>(program, target);
+  hlir::framework::ApplyPasses(graph.get(), {"OpFusionPass", "FusionMergePass"});
+  CHECK_EQ(graph->fusion_groups.size(), 1);
+  auto& report = graph->GetAttrs<hlir::pass::FusionReport>("fusion_merge_report");
+  ASSERT_GT(report.num_accepted, 0);
+  ASSERT_EQ(report.num_rejected, 0);
+  ASSERT_GT(report.saved_bytes, 0);
+  LOG(INFO) << report.DebugString();
+
+  // the consumers are still fused horizontally, but the producer is not fused into them
+  graph = std::make_shared<hlir::framework::Graph>(program, target);
+  graph->attrs["fusion_cost_model"] =
+      std::make_shared<absl::any>(std::shared_ptr<hlir::pass::FusionCostModel>(new RejectAllCostModel));
+  hlir::framework::ApplyPasses(graph.get(), {"OpFusionPass", "FusionMergePass"});
+  CHECK_EQ(graph->fusion_groups.size(), 2);
+  auto& reject_report = graph->GetAttrs<hlir::pass::FusionReport>("fusion_merge_report");
+  ASSERT_EQ(reject_report.num_accepted, 0);
+  ASSERT_GT(reject_report.num_rejected, 0);
+  ASSERT_EQ(reject_report.saved_bytes, 0);
+}
+
+TEST(FusionMergePass, CostModel_Analytic) {
+  hlir::pass::AnalyticFusionCostModel model(100.0, 50.0, 2.0);
+  // recomputing an exp of 1024 elements in 3 more consumers costs more than the traffic it saves
+  hlir::pass::FusionFeature feature;
+  feature.saved_bytes       = 5 * 4096;
+  feature.recompute_bytes   = 3 * 4096;
+  feature.recompute_flops   = 3 * 1024 * hlir::pass::FusionCostModel::GetOpFlopsPerElement("exp");
+  feature.num_saved_kernels = 1;
+  ASSERT_LT(model.Gain(feature), 0);
+  // a cheap producer is worth recomputing
+  feature.recompute_flops = 3 * 1024 * hlir::pass::FusionCostModel::GetOpFlopsPerElement("elementwise_add");
+  ASSERT_GT(model.Gain(feature), 0);
+
+  // the kernels measured on a device of 200 bytes/us, 400 flops/us and 3 us per launch
+  std::vector<hlir::pass::KernelSample> samples;
+  for (auto& work : std::vector<std::pair<int64_t, int64_t>>{{1000, 0}, {0, 2000}, {4000, 1000}, {500, 8000}}) {
+    samples.push_back({work.first, work.second, work.first / 200.0 + work.second / 400.0 + 3.0});
+  }
+  ASSERT_TRUE(model.Calibrate(samples));
+  ASSERT_NEAR(model.bytes_per_us(), 200.0, 1e-3);
+  ASSERT_NEAR(model.flops_per_us(), 400.0, 1e-3);
+  ASSERT_NEAR(model.launch_us(), 3.0, 1e-6);
+}
+
 }  // namespace frontend
 }  // namespace cinn
@@ -0,0 +1,226 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <absl/container/flat_hash_map.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "cinn/hlir/framework/graph.h"
+#include "cinn/hlir/framework/node.h"
+#include "cinn/hlir/framework/op.h"
+#include "cinn/hlir/framework/pass.h"
+
+namespace cinn::hlir::pass {
+
+using framework::Graph;
+using framework::Node;
+using framework::NodeData;
+using framework::OpPatternKind;
+
+using GroupPtr  = std::shared_ptr<Graph::Group>;
+using GroupList = std::vector<GroupPtr>;
+using ShapeDict = absl::flat_hash_map<std::string, framework::shape_t>;
+
+// the groups whose outputs have more elements are worth their own parallel launch
+constexpr int64_t kMaxPackedNumel = 1 << 16;
+// the arguments of a packed function are passed on the stack, whose size is 4K
+constexpr int kMaxPackedArgs = 512;
+
+/**
+ * HorizontalPackingPass packs the independent small groups at the same depth of the graph, such as the parameter
+ * updates of an optimizer, into one group on CPU. The packed group is lowered to one function whose outer parallel
+ * loop dispatches across the functions of its groups, which saves the instruction launches and the fork/join of the
+ * thread pool of each small group.
+ */
+class HorizontalPackingPass {
+ public:
+  explicit HorizontalPackingPass(Graph* graph)
+      : graph_(graph), shape_dict_(graph->GetAttrs<ShapeDict>("infershape")) {}
+
+  GroupList Apply() {
+    // the groups at the same level have no path between each other
+    std::map<int, GroupList> level_groups;
+    for (auto& group : graph_->fusion_groups) {
+      if (CanPack(group)) {
+        level_groups[GetLevel(group)].push_back(group);
+      }
+    }
+
+    std::unordered_map<Graph::Group*, GroupPtr> packed_groups;
+    for (auto& level_group : level_groups) {
+      GroupList members;
+      std::unordered_set<std::string> args;
+      for (auto& group : level_group.second) {
+        auto group_args = GetArgs(group);
+        if (args.size() + group_args.size() > kMaxPackedArgs) {
+          Pack(members, level_group.first, &packed_groups);
+          members.clear();
+          args.clear();
+        }
+        members.push_back(group);
+        args.insert(group_args.begin(), group_args.end());
+      }
+      Pack(members, level_group.first, &packed_groups);
+    }
+    if (packed_groups.empty()) {
+      return graph_->fusion_groups;
+    }
+
+    GroupList fusion_groups;
+    std::unordered_set<Graph::Group*> visited;
+    for (auto& group : graph_->fusion_groups) {
+      auto group_ptr = packed_groups.count(group.get()) ? packed_groups[group.get()] : group;
+      if (visited.insert(group_ptr.get()).second) {
+        fusion_groups.push_back(group_ptr);
+      }
+    }
+    // sort by level to keep the groups in topological order
+    std::stable_sort(fusion_groups.begin(), fusion_groups.end(), [this](const GroupPtr& lhs, const GroupPtr& rhs) {
+      return GetLevel(lhs) < GetLevel(rhs);
+    });
+    return fusion_groups;
+  }
+
+ private:
+  bool CanPack(const GroupPtr& group) const {
+    if (group->op_pattern_kind == framework::kNonFusible || group->op_pattern_kind == framework::kOutFusible) {
+      return false;
+    }
+    int64_t numel = 0;
+    for (auto node : group->output_nodes) {
+      for (auto& link : node->outlinks_in_order()) {
+        auto node_data = link->sink()->safe_as<NodeData>();
+        CHECK(node_data);
+        CHECK(shape_dict_.count(node_data->id())) << "Can't find " << node_data->id() << " 's shape!";
+        auto& shape = shape_dict_.at(node_data->id());
+        numel += std::accumulate(shape.begin(), shape.end(), int64_t{1}, std::multiplies<int64_t>());
+      }
+    }
+    return numel <= kMaxPackedNumel;
+  }
+
+  // the length of the longest path from the graph inputs to the group
+  int GetLevel(const GroupPtr& group) {
+    auto it = levels_.find(group.get());
+    if (it != levels_.end()) {
+      return it->second;
+    }
+    int level = 0;
+    for (auto& producer : group->producer_groups) {
+      level = std::max(level, GetLevel(producer) + 1);
+    }
+    levels_[group.get()] = level;
+    return level;
+  }
+
+  // the names of the node datas read from or written to the global memory by the group
+  std::unordered_set<std::string> GetArgs(const GroupPtr& group) const {
+    std::unordered_set<std::string> args;
+    auto nodes_set = group->NodeSet();
+    for (auto node : nodes_set) {
+      for (auto& link : node->inlinks_in_order()) {
+        auto node_data = link->source()->safe_as<NodeData>();
+        CHECK(node_data);
+        if (!node_data->source_node.get() || !nodes_set.count(node_data->source_node.get())) {
+          args.insert(node_data->id());
+        }
+      }
+    }
+    for (auto node : group->output_nodes) {
+      for (auto& link : node->outlinks_in_order()) {
+        args.insert(link->sink()->id());
+      }
+    }
+    return args;
+  }
+
+  void Pack(const GroupList& members, int level, std::unordered_map<Graph::Group*, GroupPtr>* packed_groups) {
+    if (members.size() <= 1) {
+      return;
+    }
+    VLOG(3) << "Pack " << members.size() << " groups at level " << level;
+    auto packed_group      = std::make_shared<Graph::Group>();
+    packed_group->group_id = members.front()->group_id + "_pack" + std::to_string(members.size());
+    packed_group->depth    = members.front()->depth;
+    for (auto& member : members) {
+      packed_group->packed_groups.push_back(member);
+      packed_group->max_depth = std::max(packed_group->max_depth, member->max_depth);
+      packed_group->min_depth = std::min(packed_group->min_depth, member->min_depth);
+      if (static_cast<int>(member->op_pattern_kind) > static_cast<int>(packed_group->op_pattern_kind)) {
+        packed_group->op_pattern_kind = member->op_pattern_kind;
+      }
+      if (member->fused_sub_groups.empty()) {
+        packed_group->fused_sub_groups.push_back(member);
+      } else {
+        packed_group->fused_sub_groups.insert(
+            packed_group->fused_sub_groups.end(), member->fused_sub_groups.begin(), member->fused_sub_groups.end());
+      }
+      for (auto& input_node : member->input_nodes) {
+        packed_group->input_nodes[input_node.first] += input_node.second;
+      }
+      packed_group->output_nodes.insert(member->output_nodes.begin(), member->output_nodes.end());
+      packed_group->internal_nodes.insert(member->internal_nodes.begin(), member->internal_nodes.end());
+      packed_group->master_nodes.insert(member->master_nodes.begin(), member->master_nodes.end());
+
+      for (auto& producer : member->producer_groups) {
+        packed_group->producer_groups.insert(producer);
+        producer->consumer_groups.erase(member);
+        producer->consumer_groups.insert(packed_group);
+      }
+      for (auto& consumer : member->consumer_groups) {
+        packed_group->consumer_groups.insert(consumer);
+        consumer->producer_groups.erase(member);
+        consumer->producer_groups.insert(packed_group);
+      }
+      member->belong_groups.insert(packed_group);
+      (*packed_groups)[member.get()] = packed_group;
+    }
+    levels_[packed_group.get()] = level;
+  }
+
+  Graph* graph_;
+  const ShapeDict& shape_dict_;
+  std::unordered_map<Graph::Group*, int> levels_;
+};
+
+void HorizontalPackingPassImpl(Graph* graph) {
+  if (graph->target_.arch != common::Target::Arch::X86) {
+    VLOG(3) << "HorizontalPackingPass only works on CPU.";
+    return;
+  }
+  // the packed function has no symbolic arguments
+  if (graph->HasAttr("symbolic_dims") || graph->fusion_groups.size() <= 1) {
+    return;
+  }
+  graph->fusion_groups = HorizontalPackingPass(graph).Apply();
+}
+
+}  // namespace cinn::hlir::pass
+
+CINN_REGISTER_HELPER(HorizontalPackingPass) {
+  CINN_REGISTER_PASS(HorizontalPackingPass)
+      .describe(
+          "Pack the independent small fusion groups at the same depth into one group on CPU, whose function dispatches "
+          "across the functions of the groups in its outer parallel loop.")
+      .set_change_structure(false)
+      .preserve_analysis(cinn::hlir::framework::Graph::kTopologicalOrder)
+      .set_body(cinn::hlir::pass::HorizontalPackingPassImpl);
+
+  return true;
+}
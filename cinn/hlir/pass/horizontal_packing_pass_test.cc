@@ -0,0 +1,104 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "cinn/frontend/decomposer/test_helper.h"
+
+namespace cinn {
+namespace frontend {
+
+namespace {
+
+using DataMap = std::unordered_map<std::string, std::vector<float>>;
+
+// compile the program with the fusion passes and run it `repeat` times, return the average time in milliseconds
+double RunOptimizerStep(Program& program,
+                        bool pack,
+                        const DataMap& inputs,
+                        const std::unordered_set<std::string>& fetch_ids,
+                        int repeat,
+                        DataMap* outputs,
+                        size_t* num_groups) {
+  auto target = common::DefaultHostTarget();
+  auto graph  = std::make_shared<hlir::framework::Graph>(program, fetch_ids, target);
+  std::vector<std::string> passes{"OpFusionPass", "FusionMergePass"};
+  if (pack) {
+    passes.push_back("HorizontalPackingPass");
+  }
+  hlir::framework::ApplyPasses(graph.get(), passes);
+  *num_groups = graph->fusion_groups.size();
+
+  auto scope = BuildScope(target, graph);
+  hlir::framework::GraphCompiler gc(target, scope, graph);
+  auto run_program = gc.Build();
+  for (auto& input : inputs) {
+    scope->Var<hlir::framework::Tensor>(input.first);
+    CopyFromVector(input.second, scope->GetTensor(input.first), target);
+  }
+
+  run_program->Execute();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; ++i) {
+    run_program->Execute();
+  }
+  double time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeat;
+
+  for (auto& id : fetch_ids) {
+    CopyToVector(scope->GetTensor(id), &(*outputs)[id]);
+  }
+  return time_ms;
+}
+
+}  // namespace
+
+TEST(HorizontalPacking, sgd_step) {
+  constexpr int num_params = 48;
+  constexpr int repeat     = 100;
+  NetBuilder net_builder("sgd_step");
+  DataMap inputs;
+  std::unordered_set<std::string> fetch_ids;
+  // the small parameters are packed, and the large one keeps its own function
+  for (int i = 0; i <= num_params; ++i) {
+    std::vector<int> shape = i == num_params ? std::vector<int>{512, 512} : std::vector<int>{16 * (i % 4 + 1), 32};
+    auto param             = net_builder.CreateInput(Float(32), shape, "param_" + std::to_string(i));
+    auto grad              = net_builder.CreateInput(Float(32), shape, "grad_" + std::to_string(i));
+    auto updated           = net_builder.Subtract(param, net_builder.Scale(grad, 0.01f));
+    fetch_ids.insert(updated->id);
+
+    int numel = shape[0] * shape[1];
+    InitRandomVector<float>(&inputs[param->id], numel, -1.0f, 1.0f);
+    InitRandomVector<float>(&inputs[grad->id], numel, -1.0f, 1.0f);
+  }
+  auto program = net_builder.Build();
+
+  DataMap expect, actual;
+  size_t num_groups = 0, num_packed_groups = 0;
+  double time_ms        = RunOptimizerStep(program, false, inputs, fetch_ids, repeat, &expect, &num_groups);
+  double packed_time_ms = RunOptimizerStep(program, true, inputs, fetch_ids, repeat, &actual, &num_packed_groups);
+  LOG(INFO) << "The optimizer step of " << num_params + 1 << " parameters costs " << time_ms << " ms with "
+            << num_groups << " groups, and " << packed_time_ms << " ms with " << num_packed_groups << " groups";
+
+  ASSERT_EQ(num_groups, num_params + 1);
+  ASSERT_EQ(num_packed_groups, 2UL);
+  for (auto& output : expect) {
+    ASSERT_TRUE(actual.count(output.first));
+    CheckOutput<float>(actual[output.first], output.second);
+  }
+}
+
+}  // namespace frontend
+}  // namespace cinn
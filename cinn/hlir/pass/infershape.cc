@@ -96,7 +96,7 @@ void InferShapePass(Graph* graph) {
   VLOG(3) << "Begin InferShapePass";
   auto& shape_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, framework::shape_t>>("infershape");
   auto& dtype_dict = graph->GetMutableAttrs<absl::flat_hash_map<std::string, Type>>("inferdtype");
-  auto store_nodes = std::get<0>(graph->topological_order());
+  const auto& store_nodes = graph->CachedTopologicalOrder();
 
   auto product = [](const framework::shape_t& shape) {
     framework::dim_t numel = 1;
@@ -121,6 +121,7 @@ CINN_REGISTER_HELPER(InferShape) {
           "This pass infer the shape and data type of tensor and save to g.attrs[\"infershape\"] and "
           "g.attrs[\"inferdtype\"].")
       .set_change_structure(false)
+      .preserve_analysis(cinn::hlir::framework::Graph::kTopologicalOrder)
       .provide_graph_attr("infershape")
       .provide_graph_attr("inferdtype")
       .set_body(cinn::hlir::pass::InferShapePass);
@@ -39,11 +39,11 @@ using ConditionFunction = std::function<bool(const FusionHelperBase*, const Node
 // code generation.
 class OpFusionPassHelper : public FusionHelperBase {
  public:
-  OpFusionPassHelper(const Graph* graph) : FusionHelperBase(graph) {
+  OpFusionPassHelper(Graph* graph) : FusionHelperBase(graph) {
     // init fusion relation
     InitFusionRelation();
     // filter node data, create group for each node
-    auto nodes_inorder = std::get<0>(graph->topological_order());
+    const auto& nodes_inorder = graph->CachedTopologicalOrder();
     for (auto graph_node : nodes_inorder) {
       auto node = graph_node->safe_as<Node>();
       if (node) {
@@ -373,11 +373,13 @@ CINN_REGISTER_HELPER(OpFusionPass) {
       .describe(
           "Op Fusion Pass which performs Ops fusion, Producer Ops are fused into Consumer Ops with certain conditions.")
       .set_change_structure(false)
+      .preserve_analysis(cinn::hlir::framework::Graph::kTopologicalOrder)
       .set_body(cinn::hlir::pass::OpFusionPassInternal);
 
   CINN_REGISTER_PASS(BuildNonFusedGroupsPass)
       .describe("Build No Fused Groups.")
       .set_change_structure(false)
+      .preserve_analysis(cinn::hlir::framework::Graph::kTopologicalOrder)
       .set_body(cinn::hlir::pass::BuildNonFusedGroupsPassInternal);
 
   return true;
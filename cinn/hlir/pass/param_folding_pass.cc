@@ -0,0 +1,455 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cinn/common/context.h"
+#include "cinn/frontend/syntax.h"
+#include "cinn/hlir/framework/graph_compiler.h"
+#include "cinn/hlir/framework/scope.h"
+#include "cinn/hlir/op/op_util.h"
+#include "cinn/hlir/pass/fusion_helper_base.h"
+
+namespace cinn {
+namespace hlir {
+namespace pass {
+
+using common::Type;
+using framework::Graph;
+using framework::Node;
+using framework::NodeData;
+using framework::Scope;
+using framework::shape_t;
+using framework::Tensor;
+
+// Param Folding Pass
+//
+// The subgraphs which only depend on parameters, such as the transpose or cast of a weight and the batch_norm scale
+// folded into a conv2d weight, produce the same values in every step. The pass compiles and runs them once at compile
+// time, stores their results in the scope as new parameters and removes them from the graph.
+//
+// The parameters are the input variables of the graph named in the graph attribute "param_names", which the model
+// loader registers, and whose values have been loaded into the scope of the graph attribute "param_scope". The other
+// variables of the scope, such as the feed inputs, are never folded. The pass does nothing without both attributes.
+class ParamFoldingPassHelper : public FusionHelperBase {
+ public:
+  ParamFoldingPassHelper(Graph* graph,
+                         const std::shared_ptr<Scope>& scope,
+                         const std::unordered_set<std::string>& param_names)
+      : FusionHelperBase(graph),
+        graph_(graph),
+        scope_(scope),
+        param_names_(param_names),
+        dtype_dict_(graph->GetAttrs<absl::flat_hash_map<std::string, Type>>("inferdtype")) {}
+
+  int64_t operator()() {
+    auto nodes_inorder = std::get<0>(graph_->topological_order());
+    for (auto graph_node : nodes_inorder) {
+      auto node = graph_node->safe_as<Node>();
+      if (node) {
+        MarkFoldableNode(node);
+      } else {
+        auto node_data = graph_node->safe_as<NodeData>();
+        CHECK(node_data);
+        if (IsParam(node_data)) {
+          param_deps_[node_data] = {node_data};
+        }
+      }
+    }
+
+    std::vector<Node*> nodes;
+    for (auto graph_node : nodes_inorder) {
+      auto node = graph_node->safe_as<Node>();
+      if (node) {
+        nodes.push_back(node);
+      }
+    }
+    RemoveUnprofitableNodes(nodes);
+    if (folded_nodes_.empty()) {
+      VLOG(3) << "No subgraph depends only on parameters.";
+      return 0;
+    }
+
+    // the outputs of the folded nodes which are still used by the graph become new parameters
+    std::vector<NodeData*> results;
+    std::unordered_set<NodeData*> params;
+    std::vector<Node*> subgraph_nodes;
+    int64_t saved_flops = 0;
+    for (auto node : nodes) {
+      if (!folded_nodes_.count(node)) {
+        continue;
+      }
+      saved_flops += EstimateFlops(node);
+      for (auto output : GetNodeDatas(node)) {
+        if (IsUsedByGraph(output)) {
+          results.push_back(output);
+        }
+      }
+      for (auto input : GetProducerNodeData(node)) {
+        if (!input->source_node.get()) {
+          params.insert(input);
+        }
+      }
+    }
+    auto const_nodes = CollectConstNodes();
+    for (auto node : nodes) {
+      if (folded_nodes_.count(node) || const_nodes.count(node)) {
+        subgraph_nodes.push_back(node);
+      }
+    }
+
+    Evaluate(subgraph_nodes, params, results);
+    RemoveFoldedNodes(nodes, params, results);
+    VLOG(3) << "Fold " << folded_nodes_.size() << " nodes depending only on parameters into " << results.size()
+            << " new parameters, which saves about " << saved_flops << " FLOPs per step.";
+    return saved_flops;
+  }
+
+ private:
+  // the parameters registered by the model loader and loaded into the scope
+  bool IsParam(const NodeData* node_data) const {
+    if (node_data->source_node.get() || !param_names_.count(node_data->id())) {
+      return false;
+    }
+    auto* var = scope_->FindVar(node_data->id());
+    if (!var) {
+      return false;
+    }
+    auto& tensor = absl::get<Tensor>(*var);
+    return tensor->buffer()->memory != nullptr;
+  }
+
+  bool IsConstData(const NodeData* node_data) const { return param_deps_.count(node_data); }
+
+  void MarkFoldableNode(Node* node) {
+    // the random ops produce different values in every step, and the fetched values should be computed by the graph,
+    // the values without consumers are fetched as well when the graph is built without fetch ids
+    static std::unordered_set<std::string> unfoldable_ops = {"uniform_random", "gaussian_random", "randint"};
+    if (unfoldable_ops.count(node->op()->name) || output_nodes_set_.count(node)) {
+      return;
+    }
+    auto outputs = GetNodeDatas(node);
+    if (std::any_of(outputs.begin(), outputs.end(), [](NodeData* output) { return output->outlinks().empty(); })) {
+      return;
+    }
+    std::unordered_set<const NodeData*> deps;
+    for (auto input : GetProducerNodeData(node)) {
+      if (!IsConstData(input)) {
+        return;
+      }
+      auto& input_deps = param_deps_.at(input);
+      deps.insert(input_deps.begin(), input_deps.end());
+    }
+    // the nodes without parameters, such as fill_constant, are left to ConstantFolding, they are only evaluated as
+    // the inputs of the folded nodes
+    if (deps.empty()) {
+      const_nodes_.insert(node);
+    } else {
+      folded_nodes_.insert(node);
+    }
+    for (auto output : outputs) {
+      param_deps_[output] = deps;
+    }
+  }
+
+  bool IsFoldedData(const NodeData* node_data) const {
+    auto producer = node_data->source_node.get();
+    if (!producer) {
+      return IsConstData(node_data);
+    }
+    return folded_nodes_.count(producer) || const_nodes_.count(producer);
+  }
+
+  bool IsUsedByGraph(const NodeData* node_data) const {
+    for (auto& link : node_data->outlinks()) {
+      auto consumer = link->sink()->safe_as<Node>();
+      CHECK(consumer);
+      if (!folded_nodes_.count(consumer)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  int64_t GetNumel(const NodeData* node_data) const {
+    CHECK(shape_dict_.count(node_data->id())) << "Can't find " << node_data->id() << " 's shape!";
+    auto& shape = shape_dict_.at(node_data->id());
+    return std::accumulate(shape.begin(), shape.end(), static_cast<int64_t>(1), std::multiplies<int64_t>());
+  }
+
+  // A new parameter larger than the parameters it is computed from, such as the broadcast of a bias, costs more
+  // memory and bandwidth than it saves, so its producer is left in the graph, together with the folded nodes
+  // depending on the producer.
+  void RemoveUnprofitableNodes(const std::vector<Node*>& nodes) {
+    bool update = true;
+    while (update) {
+      update = false;
+      for (auto node : nodes) {
+        if (!folded_nodes_.count(node)) {
+          continue;
+        }
+        bool can_fold = true;
+        for (auto input : GetProducerNodeData(node)) {
+          can_fold = can_fold && IsFoldedData(input);
+        }
+        for (auto output : GetNodeDatas(node)) {
+          if (!can_fold || !IsUsedByGraph(output)) {
+            continue;
+          }
+          int64_t param_numel = 0;
+          for (auto param : param_deps_.at(output)) {
+            param_numel += GetNumel(param);
+          }
+          can_fold = GetNumel(output) <= param_numel;
+        }
+        if (!can_fold) {
+          VLOG(4) << "Do not fold " << node->id();
+          folded_nodes_.erase(node);
+          update = true;
+        }
+      }
+    }
+  }
+
+  // the nodes without parameters whose outputs are used by the folded nodes
+  std::unordered_set<Node*> CollectConstNodes() const {
+    std::unordered_set<Node*> const_nodes;
+    std::vector<Node*> stack(folded_nodes_.begin(), folded_nodes_.end());
+    while (!stack.empty()) {
+      auto node = stack.back();
+      stack.pop_back();
+      for (auto producer : GetProducerNode(node)) {
+        if (const_nodes_.count(producer) && !const_nodes.count(producer)) {
+          const_nodes.insert(producer);
+          stack.push_back(producer);
+        }
+      }
+    }
+    return const_nodes;
+  }
+
+  // A rough estimation of the floating point operations of a node: 2 * M * N * K for the matrix multiplications and
+  // convolutions, and one operation per element read or written for the others.
+  int64_t EstimateFlops(const Node* node) const {
+    auto inputs         = GetProducerNodeData(node);
+    auto outputs        = GetNodeDatas(node);
+    auto& attrs         = node->attrs.attr_store;
+    auto& op_name       = node->op()->name;
+    int64_t out_numel   = GetNumel(outputs[0]);
+    int64_t reduce_size = 0;
+    if (op_name == "matmul" && !inputs.empty()) {
+      auto& x_shape = shape_dict_.at(inputs[0]->id());
+      bool trans_a  = SafeGetAttr(attrs, "trans_a", false);
+      reduce_size   = x_shape.size() > 1 && trans_a ? x_shape[x_shape.size() - 2] : x_shape.back();
+    } else if (op_name == "mul" && !inputs.empty()) {
+      auto& x_shape      = shape_dict_.at(inputs[0]->id());
+      int x_num_col_dims = SafeGetAttr(attrs, "x_num_col_dims", 1);
+      reduce_size = std::accumulate(x_shape.begin() + x_num_col_dims, x_shape.end(), 1, std::multiplies<int>());
+    } else if ((op_name == "conv2d" || op_name == "depthwise_conv2d") && inputs.size() > 1) {
+      auto& w_shape = shape_dict_.at(inputs[1]->id());
+      reduce_size   = GetNumel(inputs[1]) / w_shape[0];
+    }
+    if (reduce_size > 0) {
+      return 2 * out_numel * reduce_size;
+    }
+
+    int64_t in_numel = 0;
+    for (auto input : inputs) {
+      in_numel += GetNumel(input);
+    }
+    out_numel = 0;
+    for (auto output : outputs) {
+      out_numel += GetNumel(output);
+    }
+    return std::max(in_numel, out_numel);
+  }
+
+  frontend::Variable GetVariable(const NodeData* node_data) const {
+    frontend::Variable var(node_data->id());
+    var->shape = shape_dict_.at(node_data->id());
+    CHECK(dtype_dict_.count(node_data->id())) << "Can't find " << node_data->id() << " 's dtype!";
+    var->type = dtype_dict_.at(node_data->id());
+    return var;
+  }
+
+  static void ShareTensor(const Tensor& src, Tensor* dst) {
+    (*dst)->Resize(src->shape());
+    (*dst)->set_type(src->type());
+    (*dst)->set_buffer(src->get_buffer());
+  }
+
+  // Compile the folded nodes into a separate program on the target of the graph and run it once, the parameters and
+  // the results share the buffers with the scope, so nothing is copied.
+  void Evaluate(const std::vector<Node*>& nodes,
+                const std::unordered_set<NodeData*>& params,
+                const std::vector<NodeData*>& results) {
+    // the compilation resets the name ids, which are still used by the passes after this one
+    auto name_ids = common::Context::Global().SaveNameId();
+
+    frontend::Program program;
+    for (auto node : nodes) {
+      frontend::Instruction instr(node->op()->name);
+      instr->attrs = node->attrs.attr_store;
+      std::vector<frontend::Variable> inputs, outputs;
+      for (auto input : GetProducerNodeData(node)) {
+        inputs.push_back(GetVariable(input));
+      }
+      for (auto output : GetNodeDatas(node)) {
+        outputs.push_back(GetVariable(output));
+      }
+      instr.SetInputs(inputs);
+      instr->outputs = outputs;
+      program.AppendInstruction(instr);
+    }
+
+    std::unordered_set<std::string> fetch_ids;
+    for (auto result : results) {
+      fetch_ids.insert(result->id());
+    }
+    auto subgraph = std::make_shared<Graph>(program, fetch_ids, target_);
+    framework::ApplyPasses(subgraph.get(), {"OpFusionPass", "FusionMergePass"});
+
+    auto sub_scope = std::make_shared<Scope>();
+    for (auto param : params) {
+      auto& tensor = absl::get<Tensor>(*sub_scope->Var<Tensor>(param->id()));
+      ShareTensor(scope_->GetTensor(param->id()), &tensor);
+    }
+    framework::BuildScope(target_, subgraph, sub_scope);
+
+    framework::GraphCompiler graph_compiler(target_, sub_scope, subgraph);
+    framework::GraphCompiler::CompileOptions options;
+    options.with_instantiate_variables = true;
+    auto runtime_program = graph_compiler.Build(options, std::move(fetch_ids)).runtime_program;
+    runtime_program->Execute();
+
+    for (auto result : results) {
+      auto& tensor = absl::get<Tensor>(*scope_->Var<Tensor>(result->id()));
+      ShareTensor(sub_scope->GetTensor(result->id()), &tensor);
+    }
+    common::Context::Global().RestoreNameId(name_ids);
+  }
+
+  void RemoveFoldedNodes(const std::vector<Node*>& nodes,
+                         const std::unordered_set<NodeData*>& params,
+                         const std::vector<NodeData*>& results) {
+    std::unordered_set<NodeData*> result_set(results.begin(), results.end());
+    std::vector<common::GraphNode*> dropped;
+    for (auto node : nodes) {
+      if (!folded_nodes_.count(node)) {
+        continue;
+      }
+      for (auto input : GetProducerNodeData(node)) {
+        input->UnLinkSingleTo(node);
+      }
+      for (auto output : GetNodeDatas(node)) {
+        node->UnLinkSingleTo(output);
+        if (result_set.count(output)) {
+          // the result is a parameter now
+          output->source_node.Reset();
+          output->output_index = 0;
+          output->set_const(true);
+        } else {
+          dropped.push_back(output);
+        }
+      }
+      dropped.push_back(node);
+    }
+
+    // the parameters and the constants only used by the folded nodes are useless now
+    for (auto param : params) {
+      if (param->outlinks().empty()) {
+        dropped.push_back(param);
+      }
+    }
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+      auto node = *it;
+      if (!const_nodes_.count(node)) {
+        continue;
+      }
+      auto outputs = GetNodeDatas(node);
+      bool is_used = std::any_of(outputs.begin(), outputs.end(), [](NodeData* output) {
+        return !output->outlinks().empty();
+      });
+      if (is_used) {
+        continue;
+      }
+      for (auto input : GetProducerNodeData(node)) {
+        input->UnLinkSingleTo(node);
+      }
+      for (auto output : outputs) {
+        node->UnLinkSingleTo(output);
+        dropped.push_back(output);
+      }
+      dropped.push_back(node);
+    }
+
+    auto& shape_dict = graph_->GetMutableAttrs<absl::flat_hash_map<std::string, shape_t>>("infershape");
+    auto& dtype_dict = graph_->GetMutableAttrs<absl::flat_hash_map<std::string, Type>>("inferdtype");
+    for (auto graph_node : dropped) {
+      // the dropped node datas should not be created in the scope any more
+      auto node_data = graph_node->safe_as<NodeData>();
+      if (node_data) {
+        shape_dict.erase(node_data->id());
+        dtype_dict.erase(node_data->id());
+      }
+      graph_->DropNode(graph_node);
+    }
+  }
+
+  Graph* graph_;
+  std::shared_ptr<Scope> scope_;
+  const std::unordered_set<std::string>& param_names_;
+  const absl::flat_hash_map<std::string, Type>& dtype_dict_;
+
+  // the parameters each constant node data depends on
+  std::unordered_map<const NodeData*, std::unordered_set<const NodeData*>> param_deps_;
+  std::unordered_set<Node*> folded_nodes_;
+  std::unordered_set<Node*> const_nodes_;
+};
+
+void ParamFoldingPassInternal(Graph* graph) {
+  if (!graph->HasAttr("param_scope") || !graph->HasAttr("param_names")) {
+    VLOG(3) << "The graph has no param_scope or param_names, skip ParamFolding.";
+    return;
+  }
+  auto scope = graph->GetAttrs<std::shared_ptr<Scope>>("param_scope");
+  CHECK(scope) << "The param_scope of the graph should not be null.";
+  const auto& param_names = graph->GetAttrs<std::unordered_set<std::string>>("param_names");
+  ParamFoldingPassHelper param_folding_pass_helper(graph, scope, param_names);
+  int64_t saved_flops = param_folding_pass_helper();
+  graph->attrs["param_folding_saved_flops"] = std::make_shared<absl::any>(saved_flops);
+}
+
+}  // namespace pass
+}  // namespace hlir
+}  // namespace cinn
+
+CINN_REGISTER_HELPER(ParamFolding) {
+  CINN_REGISTER_PASS(ParamFolding)
+      .describe(
+          "This pass evaluates the subgraphs which only depend on the parameters named in graph attr[\"param_names\"] "
+          "at compile time, and replaces them with new parameters in the scope of graph attr[\"param_scope\"].")
+      .set_change_structure(true)
+      .provide_graph_attr("param_folding_saved_flops")
+      .set_body(cinn::hlir::pass::ParamFoldingPassInternal);
+
+  return true;
+}
@@ -0,0 +1,180 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <numeric>
+
+#include "cinn/frontend/decomposer/test_helper.h"
+
+namespace cinn {
+namespace frontend {
+
+namespace {
+
+using DataMap = std::unordered_map<std::string, std::vector<float>>;
+
+DataMap GetRandomData(const std::vector<Variable>& vars) {
+  DataMap data;
+  for (auto& var : vars) {
+    int numel = std::accumulate(var->shape.begin(), var->shape.end(), 1, std::multiplies<int>());
+    InitRandomVector<float>(&data[var->id], numel, 0.0f, 1.0f, 1e-3);
+  }
+  return data;
+}
+
+int CountOp(hlir::framework::Graph* graph, const std::string& op_name) {
+  int count = 0;
+  for (auto graph_node : graph->nodes()) {
+    auto node = graph_node->safe_as<hlir::framework::Node>();
+    if (node && node->op()->name == op_name) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+// The params are loaded into the scope before the passes, the ParamFolding pass only runs with the param_scope and
+// the param_names.
+DataMap RunModelTest(Program& program,
+                     bool fold_params,
+                     const DataMap& params,
+                     const DataMap& inputs,
+                     const std::unordered_set<std::string>& fetch_ids,
+                     std::shared_ptr<hlir::framework::Graph>* folded_graph = nullptr) {
+  auto target = common::DefaultTarget();
+  auto graph  = std::make_shared<hlir::framework::Graph>(program, fetch_ids, target);
+  auto scope  = std::make_shared<hlir::framework::Scope>();
+  auto& shape = graph->GetAttrs<absl::flat_hash_map<std::string, hlir::framework::shape_t>>("infershape");
+  for (auto& param : params) {
+    auto* var    = scope->Var<hlir::framework::Tensor>(param.first);
+    auto& tensor = absl::get<hlir::framework::Tensor>(*var);
+    tensor->Resize(hlir::framework::Shape(shape.at(param.first)));
+    CopyFromVector(param.second, tensor, target);
+  }
+  if (fold_params) {
+    std::unordered_set<std::string> param_names;
+    for (auto& param : params) {
+      param_names.insert(param.first);
+    }
+    graph->attrs["param_scope"] = std::make_shared<absl::any>(scope);
+    graph->attrs["param_names"] = std::make_shared<absl::any>(param_names);
+    hlir::framework::ApplyPass(graph.get(), "ParamFolding");
+  }
+  hlir::framework::ApplyPasses(graph.get(), {"OpFusionPass", "FusionMergePass"});
+
+  BuildScope(target, graph, scope);
+  hlir::framework::GraphCompiler gc(target, scope, graph);
+  auto run_program = gc.Build();
+  for (auto& input : inputs) {
+    scope->Var<hlir::framework::Tensor>(input.first);
+    CopyFromVector(input.second, scope->GetTensor(input.first), target);
+  }
+  run_program->Execute();
+
+  DataMap outputs;
+  for (auto& id : fetch_ids) {
+    CopyToVector(scope->GetTensor(id), &outputs[id]);
+  }
+  if (folded_graph) {
+    *folded_graph = graph;
+  }
+  return outputs;
+}
+
+}  // namespace
+
+TEST(ParamFolding, fold_weight_transpose) {
+  NetBuilder net_builder("fold_weight_transpose");
+  auto X = net_builder.CreateInput(Float(32), {8, 16}, "X");
+  auto W = net_builder.CreateInput(Float(32), {32, 16}, "W");
+  auto B = net_builder.CreateInput(Float(32), {32}, "B");
+  // both the transpose of the weight and the scale of the bias only depend on params
+  auto T = net_builder.Transpose(W, {1, 0});
+  auto S = net_builder.Scale(B, 2.0f, 1.0f);
+  auto Y = net_builder.Matmul(X, T);
+  auto Z = net_builder.Add(Y, S);
+
+  auto program   = net_builder.Build();
+  auto params    = GetRandomData({W, B});
+  auto inputs    = GetRandomData({X});
+  auto fetch_ids = std::unordered_set<std::string>{Z->id};
+
+  std::shared_ptr<hlir::framework::Graph> graph;
+  auto output0 = RunModelTest(program, false, params, inputs, fetch_ids);
+  auto output1 = RunModelTest(program, true, params, inputs, fetch_ids, &graph);
+
+  ASSERT_EQ(CountOp(graph.get(), "transpose"), 0);
+  ASSERT_EQ(CountOp(graph.get(), "scale"), 0);
+  ASSERT_EQ(CountOp(graph.get(), "matmul"), 1);
+  ASSERT_GT(graph->GetAttrs<int64_t>("param_folding_saved_flops"), 0);
+  for (auto& output : output0) {
+    ASSERT_TRUE(output1.count(output.first));
+    CheckOutput<float>(output1[output.first], output.second, 1e-8, 1e-4);
+  }
+}
+
+TEST(ParamFolding, keep_broadcast_of_param) {
+  NetBuilder net_builder("keep_broadcast_of_param");
+  auto X = net_builder.CreateInput(Float(32), {8, 32}, "X");
+  auto B = net_builder.CreateInput(Float(32), {32}, "B");
+  // the broadcast result is 8 times larger than the param, it should be computed in every step
+  auto S = net_builder.Scale(B, 0.5f);
+  auto C = net_builder.BroadcastTo(S, {8, 32}, {1});
+  auto Z = net_builder.Add(X, C);
+
+  auto program   = net_builder.Build();
+  auto params    = GetRandomData({B});
+  auto inputs    = GetRandomData({X});
+  auto fetch_ids = std::unordered_set<std::string>{Z->id};
+
+  std::shared_ptr<hlir::framework::Graph> graph;
+  auto output0 = RunModelTest(program, false, params, inputs, fetch_ids);
+  auto output1 = RunModelTest(program, true, params, inputs, fetch_ids, &graph);
+
+  ASSERT_EQ(CountOp(graph.get(), "scale"), 0);
+  ASSERT_EQ(CountOp(graph.get(), "broadcast_to"), 1);
+  for (auto& output : output0) {
+    ASSERT_TRUE(output1.count(output.first));
+    CheckOutput<float>(output1[output.first], output.second, 1e-8, 1e-4);
+  }
+}
+
+TEST(ParamFolding, keep_feed_input) {
+  NetBuilder net_builder("keep_feed_input");
+  auto X = net_builder.CreateInput(Float(32), {16, 8}, "X");
+  auto W = net_builder.CreateInput(Float(32), {16, 8}, "W");
+  auto Y = net_builder.Add(net_builder.Transpose(X, {1, 0}), net_builder.Transpose(W, {1, 0}));
+
+  auto program = net_builder.Build();
+  auto target  = common::DefaultTarget();
+  auto graph   = std::make_shared<hlir::framework::Graph>(program, std::unordered_set<std::string>{Y->id}, target);
+  // the feed input has been set into the scope as well, but it is not a param
+  auto scope = std::make_shared<hlir::framework::Scope>();
+  for (auto& data : GetRandomData({X, W})) {
+    auto& tensor = absl::get<hlir::framework::Tensor>(*scope->Var<hlir::framework::Tensor>(data.first));
+    tensor->Resize(hlir::framework::Shape({16, 8}));
+    CopyFromVector(data.second, tensor, target);
+  }
+  graph->attrs["param_scope"] = std::make_shared<absl::any>(scope);
+  graph->attrs["param_names"] = std::make_shared<absl::any>(std::unordered_set<std::string>{W->id});
+  hlir::framework::ApplyPass(graph.get(), "ParamFolding");
+
+  ASSERT_EQ(CountOp(graph.get(), "transpose"), 1);
+  ASSERT_EQ(CountOp(graph.get(), "elementwise_add"), 1);
+}
+
+}  // namespace frontend
+}  // namespace cinn
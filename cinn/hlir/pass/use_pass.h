@@ -31,5 +31,7 @@ CINN_USE_REGISTER(CommonSubexpressionEliminationPass)
 CINN_USE_REGISTER(TransToCustomCallPass)
 CINN_USE_REGISTER(DenseMergePass)
 CINN_USE_REGISTER(ConstantFolding)
+CINN_USE_REGISTER(ParamFolding)
 CINN_USE_REGISTER(ReduceSplit)
 CINN_USE_REGISTER(SingleGroupOptimizePass)
+CINN_USE_REGISTER(HorizontalPackingPass)
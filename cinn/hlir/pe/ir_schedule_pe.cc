@@ -22,15 +22,23 @@
 #include <functional>
 #include <iostream>
 #include <numeric>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "cinn/common/cas.h"
 #include "cinn/common/common.h"
+#include "cinn/common/ir_util.h"
 #include "cinn/common/target.h"
 #include "cinn/hlir/pe/load_x86_params.h"
 #include "cinn/hlir/pe/schedule.h"
+#include "cinn/ir/collect_ir_nodes.h"
 #include "cinn/ir/ir.h"
 #include "cinn/ir/ir_base.h"
+#include "cinn/ir/ir_compare.h"
+#include "cinn/ir/ir_schedule_util.h"
+#include "cinn/optim/ir_copy.h"
 #include "cinn/optim/ir_simplify.h"
 #include "cinn/poly/isl_utils.h"
 #include "cinn/utils/string.h"
@@ -1218,6 +1226,317 @@ void IRCudaScheduleConv2(ir::IRSchedule &ir_sch,
   VLOG(3) << "After IRCudaScheduleConv2, expr is: " << ir_sch.GetModule().GetExprs().at(0);
 }
 
+namespace {
+
+// The reductions whose outputs are fewer than this are split along the reduce axes to feed the threads.
+constexpr int kCpuMinParallelTasks = 16;
+// The min number of elements reduced by one partial result of rfactor.
+constexpr int kCpuMinPartialReduceSize = 1024;
+// The max number of vector registers used as the independent accumulators of one reduction.
+constexpr int kCpuMaxAccumulatorRegisters = 4;
+
+// Get the loop nests under the root schedule block, return empty if the exprs are not merged.
+std::vector<Expr> GetRootLoopNests(const ir::IRSchedule &ir_sch) {
+  auto exprs = ir_sch.GetModule().GetExprs();
+  if (exprs.size() != 1U) return {};
+  auto *block = exprs[0].As<ir::Block>();
+  if (!block || block->stmts.size() != 1U) return {};
+  auto *root_realize = block->stmts[0].As<ir::ScheduleBlockRealize>();
+  if (!root_realize) return {};
+  auto &body = root_realize->schedule_block.As<ir::ScheduleBlock>()->body;
+  if (auto *stmts = body.As<ir::Block>()) return stmts->stmts;
+  return {body};
+}
+
+const ir::ScheduleBlock *ScheduleBlockOf(const Expr &realize) {
+  auto *block = realize.As<ir::ScheduleBlockRealize>()->schedule_block.As<ir::ScheduleBlock>();
+  CHECK(block);
+  return block;
+}
+
+std::vector<Expr> GetBlockRealizes(const Expr &expr) {
+  auto realizes =
+      ir::CollectIRNodesWithoutTensor(expr, [](const Expr *x) { return x->As<ir::ScheduleBlockRealize>(); });
+  return std::vector<Expr>(realizes.begin(), realizes.end());
+}
+
+bool IsReduceUpdateBlock(const Expr &realize) {
+  auto *block = ScheduleBlockOf(realize);
+  return !utils::Endswith(block->name, "__reduce_init") &&
+         std::any_of(block->iter_vars.begin(), block->iter_vars.end(), [](const Var &var) {
+           return var->is_reduce_axis;
+         });
+}
+
+// The init tensor of a reduction writes the buffer of the reduction, so the suffix is dropped.
+std::string GetAccessedName(const Expr &tensor) {
+  auto *node = tensor.as_tensor();
+  if (!node) return tensor.as_var() ? tensor.as_var()->name : "";
+  const std::string suffix = "__reduce_init";
+  return utils::Endswith(node->name, suffix) ? node->name.substr(0, node->name.size() - suffix.size()) : node->name;
+}
+
+bool IsLinearOf(const Expr &index, const std::string &loop_var) {
+  return ir::ContainVar({index}, loop_var) &&
+         ir::CollectIRNodes(index, [](const Expr *x) { return x->As<ir::Div>() || x->As<ir::Mod>(); }).empty();
+}
+
+// Whether the iterations of `loop` can run in any order: for every tensor written under the loop there is a dimension
+// indexed by the same linear function of the loop var in all the stores and loads of the tensor, so that different
+// iterations never touch the same element.
+bool IsIndependentLoop(const Expr &loop) {
+  auto *for_node = loop.As<ir::For>();
+  if (!for_node || !for_node->is_serial() || !common::is_zero(for_node->min)) {
+    return false;
+  }
+  const std::string &loop_var = for_node->loop_var->name;
+  auto realizes               = GetBlockRealizes(loop);
+  if (realizes.empty()) return false;
+
+  // the indices of the accesses in terms of the loop vars, keyed by the accessed tensor
+  std::unordered_map<std::string, std::vector<std::vector<Expr>>> stores, loads;
+  bool has_extern_write = false;
+  for (auto &realize : realizes) {
+    auto *realize_node = realize.As<ir::ScheduleBlockRealize>();
+    auto *block        = ScheduleBlockOf(realize);
+    auto substitute    = [&](const std::vector<Expr> &indices) {
+      std::vector<Expr> res;
+      for (auto &index : indices) {
+        res.push_back(optim::IRCopy(index));
+        ir::ReplaceExpr(&res.back(), block->iter_vars, realize_node->iter_values);
+      }
+      return res;
+    };
+    ir::CollectIRNodesWithoutTensor(block->body, [&](const Expr *x) {
+      if (auto *store = x->As<ir::Store>()) {
+        stores[GetAccessedName(store->tensor)].push_back(substitute(store->indices));
+      } else if (auto *load = x->As<ir::Load>()) {
+        loads[GetAccessedName(load->tensor)].push_back(substitute(load->indices));
+      } else if (auto *call = x->As<ir::Call>()) {
+        has_extern_write |= !call->write_args.empty();
+      }
+      return false;
+    });
+  }
+  if (has_extern_write || stores.empty()) return false;
+
+  for (auto &item : stores) {
+    const auto &first = item.second.front();
+    std::vector<std::vector<Expr>> accesses(item.second.begin(), item.second.end());
+    if (loads.count(item.first)) {
+      accesses.insert(accesses.end(), loads[item.first].begin(), loads[item.first].end());
+    }
+    bool found = false;
+    for (int dim = 0; dim < first.size() && !found; ++dim) {
+      if (!IsLinearOf(first[dim], loop_var)) continue;
+      found = std::all_of(accesses.begin(), accesses.end(), [&](const std::vector<Expr> &indices) {
+        return indices.size() == first.size() && ir::IrEqualVisitor().Compare(indices[dim], first[dim]);
+      });
+    }
+    if (!found) return false;
+  }
+  return true;
+}
+
+// Get the outermost reduce loop of the reduction nest `nest` if its spatial loops are too few to feed the threads, and
+// the reduction can be split into partials by rfactor, otherwise return an undefined expr.
+Expr GetRfactorLoop(ir::IRSchedule &ir_sch, const Expr &nest) {
+  if (!nest.As<ir::For>()) return Expr();
+  auto realizes = GetBlockRealizes(nest);
+  if (realizes.size() != 2U) return Expr();
+  Expr update = IsReduceUpdateBlock(realizes[0]) ? realizes[0] : realizes[1];
+  Expr init   = update == realizes[0] ? realizes[1] : realizes[0];
+  auto *block = ScheduleBlockOf(update);
+  if (!IsReduceUpdateBlock(update) || ScheduleBlockOf(init)->name != ir::GenReduceInitTensorNameOf(block->name)) {
+    return Expr();
+  }
+  // the partials are kept in a temp buffer derived from the buffer of the reduction
+  if (!ir::GetTensor(update)->buffer.defined()) return Expr();
+
+  // the final block combines the partials by the same reduce_sum/mul/min/max
+  auto stores = ir::CollectIRNodesWithoutTensor(block->body, [](const Expr *x) { return x->As<ir::Store>(); });
+  if (stores.size() != 1U) return Expr();
+  auto *store = stores.begin()->As<ir::Store>();
+  if (GetAccessedName(store->tensor) != block->name) return Expr();
+  Expr accumulator;
+  if (auto *add = store->value.As<ir::Add>()) {
+    accumulator = add->a();
+  } else if (auto *mul = store->value.As<ir::Mul>()) {
+    accumulator = mul->a();
+  } else if (auto *min = store->value.As<ir::Min>()) {
+    accumulator = min->a();
+  } else if (auto *max = store->value.As<ir::Max>()) {
+    accumulator = max->a();
+  }
+  if (!accumulator.defined() || !accumulator.As<ir::Load>() ||
+      GetAccessedName(accumulator.As<ir::Load>()->tensor) != block->name) {
+    return Expr();
+  }
+
+  auto *realize_node = update.As<ir::ScheduleBlockRealize>();
+  auto loops         = ir_sch.GetLoops(update);
+  int first_reduce   = -1;
+  int spatial_size   = 1;
+  int reduce_size    = 1;
+  for (int i = 0; i < loops.size(); ++i) {
+    auto *loop = loops[i].As<ir::For>();
+    if (!loop->is_serial() || !loop->extent.is_constant() || !common::is_zero(loop->min)) return Expr();
+    int bind_num   = 0;
+    bool is_reduce = false;
+    for (int j = 0; j < realize_node->iter_values.size(); ++j) {
+      if (!ir::ContainVar({realize_node->iter_values[j]}, loop->loop_var->name)) continue;
+      if (!realize_node->iter_values[j].As<ir::_Var_>()) return Expr();
+      is_reduce |= block->iter_vars[j]->is_reduce_axis;
+      ++bind_num;
+    }
+    if (bind_num != 1) return Expr();
+    if (is_reduce) {
+      first_reduce = first_reduce < 0 ? i : first_reduce;
+      reduce_size *= loop->extent.as_int32();
+    } else if (first_reduce >= 0) {
+      return Expr();
+    } else {
+      spatial_size *= loop->extent.as_int32();
+    }
+  }
+  // the reduction without spatial loops keeps its init outside of the nest, which is not supported by rfactor
+  if (first_reduce <= 0 || loops.size() - first_reduce < 2 || ir::Contains(loops[first_reduce], init)) {
+    return Expr();
+  }
+  int partial_num = loops[first_reduce].As<ir::For>()->extent.as_int32();
+  if (spatial_size >= kCpuMinParallelTasks || partial_num < 2 || reduce_size / partial_num < kCpuMinPartialReduceSize) {
+    return Expr();
+  }
+  return loops[first_reduce];
+}
+
+// Vectorize the spatial loop right above the reduce loops of `update`, so that every lane accumulates its own output.
+void VectorizeReduceAccumulator(ir::IRSchedule &ir_sch, const Expr &update, const common::Target &target) {
+  auto *realize_node = update.As<ir::ScheduleBlockRealize>();
+  auto *block        = ScheduleBlockOf(update);
+  auto loops         = ir_sch.GetLoops(update);
+  int first_reduce   = -1;
+  for (int i = 0; i < loops.size() && first_reduce < 0; ++i) {
+    for (int j = 0; j < realize_node->iter_values.size(); ++j) {
+      if (block->iter_vars[j]->is_reduce_axis &&
+          ir::ContainVar({realize_node->iter_values[j]}, loops[i].As<ir::For>()->loop_var->name)) {
+        first_reduce = i;
+        break;
+      }
+    }
+  }
+  if (first_reduce <= 0) return;
+  auto loop      = loops[first_reduce - 1];
+  auto *for_node = loop.As<ir::For>();
+  if (!for_node->is_serial() || !for_node->extent.is_constant() || !common::is_zero(for_node->min)) return;
+
+  // the loop selects the output element by exactly one spatial block var
+  Var bound_var;
+  for (int j = 0; j < realize_node->iter_values.size(); ++j) {
+    if (!ir::ContainVar({realize_node->iter_values[j]}, for_node->loop_var->name)) continue;
+    if (bound_var.defined() || !realize_node->iter_values[j].As<ir::_Var_>() || block->iter_vars[j]->is_reduce_axis) {
+      return;
+    }
+    bound_var = block->iter_vars[j];
+  }
+  if (!bound_var.defined()) return;
+  auto is_bound_var = [&](const Expr &x) { return x.as_var() && x.as_var()->name == bound_var->name; };
+  auto stores = ir::CollectIRNodesWithoutTensor(block->body, [](const Expr *x) { return x->As<ir::Store>(); });
+  if (stores.size() != 1U) return;
+  const auto &store_indices = stores.begin()->As<ir::Store>()->indices;
+  if (std::none_of(store_indices.begin(), store_indices.end(), is_bound_var)) return;
+
+  // nothing but the reduction and its init under the loop
+  for (auto &realize : GetBlockRealizes(loop)) {
+    auto &name = ScheduleBlockOf(realize)->name;
+    if (name != block->name && name != ir::GenReduceInitTensorNameOf(block->name)) return;
+  }
+  if (!ir::CollectIRNodesWithoutTensor(loop, [](const Expr *x) {
+         return x->As<ir::IfThenElse>() || x->As<ir::Let>() || x->As<ir::Call>();
+       }).empty()) {
+    return;
+  }
+
+  // the lanes load contiguous inputs if the bound var indexes their last dimension, otherwise they gather strided
+  // elements and only one vector register is used
+  bool contiguous = true;
+  ir::CollectIRNodesWithoutTensor(block->body, [&](const Expr *x) {
+    auto *load = x->As<ir::Load>();
+    if (load && GetAccessedName(load->tensor) != block->name && ir::ContainVar(load->indices, bound_var->name)) {
+      contiguous &= is_bound_var(load->indices.back());
+    }
+    return false;
+  });
+  int lanes      = GetBasicFactor(ir::GetTensor(update)->type(), target);
+  int max_factor = contiguous ? lanes * kCpuMaxAccumulatorRegisters : lanes;
+  int extent     = for_node->extent.as_int32();
+  int factor     = max_factor;
+  while (factor >= 2 && extent % factor != 0) {
+    factor /= 2;
+  }
+  if (factor < 2) return;
+  VLOG(4) << "Vectorize the accumulators of reduction " << block->name << " by " << factor;
+  if (extent == factor) {
+    ir_sch.Vectorize(loop, factor);
+  } else {
+    auto splited = ir_sch.Split(loop, {-1, factor});
+    ir_sch.Vectorize(splited[1], factor);
+  }
+}
+
+// Fuse the outer independent loops of the nest and run them in parallel.
+void ParallelOuterLoops(ir::IRSchedule &ir_sch, const Expr &nest) {
+  std::vector<Expr> loops;
+  Expr loop = nest;
+  while (IsIndependentLoop(loop)) {
+    loops.push_back(loop);
+    Expr body = loop.As<ir::For>()->body;
+    if (body.As<ir::Block>() && body.As<ir::Block>()->stmts.size() == 1U) {
+      body = body.As<ir::Block>()->stmts[0];
+    }
+    if (!body.As<ir::For>()) break;
+    loop = body;
+  }
+  if (loops.empty()) return;
+  Expr fused = loops.size() > 1U ? ir_sch.Fuse(loops) : loops[0];
+  // the loops over the symbolic dims, such as a dynamic batch, are expected to be large enough
+  if (!fused.As<ir::For>()->extent.is_constant() || ir::GetLoopExtent(fused) >= 2) {
+    ir_sch.Parallel(fused);
+  }
+}
+
+}  // namespace
+
+void IRScheduleReduceCPU(ir::IRSchedule &ir_sch, const common::Target &target) {
+  VLOG(3) << "Before IRScheduleReduceCPU, new ir is : " << ir_sch.GetModule().GetExprs().at(0);
+  // split the reductions with few outputs into partials computed in parallel and a final combine
+  auto nests = GetRootLoopNests(ir_sch);
+  for (int i = 0; i < nests.size(); ++i) {
+    Expr rf_loop = GetRfactorLoop(ir_sch, nests[i]);
+    if (!rf_loop.defined()) continue;
+    VLOG(4) << "Rfactor the reduction nest " << i << " by loop " << rf_loop.As<ir::For>()->loop_var->name;
+    ir_sch.Rfactor(rf_loop, 0);
+    // the nest is replaced by the partial nest and the final nest
+    nests = GetRootLoopNests(ir_sch);
+    ++i;
+  }
+
+  // the blocks are fetched again after each schedule since the loops are replaced
+  auto all_blocks = ir_sch.GetAllBlocks();
+  for (int i = 0; i < all_blocks.size(); ++i) {
+    if (!IsReduceUpdateBlock(all_blocks[i])) continue;
+    VectorizeReduceAccumulator(ir_sch, all_blocks[i], target);
+    all_blocks = ir_sch.GetAllBlocks();
+  }
+
+  nests = GetRootLoopNests(ir_sch);
+  for (int i = 0; i < nests.size(); ++i) {
+    ParallelOuterLoops(ir_sch, nests[i]);
+    nests = GetRootLoopNests(ir_sch);
+  }
+  VLOG(3) << "After IRScheduleReduceCPU, new ir is : " << ir_sch.GetModule().GetExprs().at(0);
+}
+
 }  // namespace pe
 }  // namespace hlir
 }  // namespace cinn
@@ -97,6 +97,11 @@ void IRCudaScheduleConv2(ir::IRSchedule &ir_sch,
 
 void IRCudaScheduleConv(ir::IRSchedule &ir_sch, const common::Target &target);
 
+// Schedule the reductions of a fused group on CPU: the reductions with too few outputs to feed all threads are
+// rfactor-ed into parallel partials plus a final combine, the spatial loop above a reduction is vectorized so that each
+// lane keeps an independent accumulator, and the outer independent loops are fused and parallelized.
+void IRScheduleReduceCPU(ir::IRSchedule &ir_sch, const common::Target &target);
+
 }  // namespace pe
 }  // namespace hlir
 }  // namespace cinn
@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "cinn/common/arena.h"
 #include "cinn/common/common.h"
 #include "cinn/common/object.h"
 #include "cinn/common/shared.h"
@@ -149,6 +150,12 @@ class IrNode : public common::Object {
   explicit IrNode(Type t) : type_(t) {}
   virtual ~IrNode() = default;
 
+  //! The nodes are allocated from the `common::NodeArena` of the current thread if there is one.
+  // @{
+  static void* operator new(size_t size) { return common::NodeArena::Allocate(size); }
+  static void operator delete(void* p, size_t size) { common::NodeArena::Deallocate(p, size); }
+  // @}
+
   virtual IrNodeTy node_type() const { return IrNodeTy::kUnk; }
   virtual Type type() const { return type_; }
   void set_type(Type type) { type_ = type; }
@@ -17,8 +17,11 @@
 #include <math.h>
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <numeric>
 #include <random>
 #include <set>
 #include <string>
@@ -29,16 +32,19 @@
 #include "cinn/common/common.h"
 #include "cinn/common/ir_util.h"
 #include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/intrinsic_ops.h"
 #include "cinn/ir/ir.h"
 #include "cinn/ir/ir_mutator.h"
 #include "cinn/ir/ir_operators.h"
 #include "cinn/ir/ir_printer.h"
 #include "cinn/ir/ir_schedule_util.h"
 #include "cinn/ir/ir_visitor.h"
+#include "cinn/ir/tensor_intrinsic.h"
 #include "cinn/lang/compute.h"
 #include "cinn/optim/ir_copy.h"
 #include "cinn/optim/ir_simplify.h"
 #include "cinn/optim/replace_var_with_expr.h"
+#include "cinn/runtime/intrinsic.h"
 #include "cinn/utils/string.h"
 
 namespace cinn {
@@ -99,6 +105,21 @@ class ScheduleImpl {
   void ReverseComputeInline(const Expr& schedule_block);
   void Bind(const Expr& loop, const std::string& thread_axis);
   Expr Rfactor(const Expr& rf_loop, int rf_axis);
+  void Tensorize(const Expr& loop, const std::string& intrinsic_name);
+  void TransformLayout(const Expr& block,
+                       int write_buffer_index,
+                       const std::vector<int>& factors,
+                       const std::vector<int>& order,
+                       const std::vector<std::string>& output_names);
+  Expr PadAxis(const Expr& block, int axis, int factor);
+  void Prefetch(const Expr& block, int read_buffer_index, const Expr& loop, int distance);
+  void StorageAlign(const Expr& block,
+                    int write_buffer_index,
+                    int axis,
+                    int factor,
+                    int offset,
+                    const std::vector<std::string>& output_names);
+  Expr DecomposeReduction(const Expr& block, const Expr& loop);
   Expr AddUnitLoop(const Expr& block) const;
   void Annotate(const Expr& block, const std::string& key, const attr_t& value);
   void Unannotate(Expr& block, const std::string& key);
@@ -120,34 +141,60 @@ std::vector<Expr> ScheduleImpl::Split(const Expr& loop, const std::vector<int>&
   CHECK(loop.As<ir::For>()) << "Expr param of Split must be For node! Please check.";
   auto* for_node = loop.As<ir::For>();
   CHECK(common::is_zero(for_node->min)) << "The For node must start with 0! Please check.";
-  CHECK(for_node->extent.is_constant()) << "The For node's extent must be constant! Please check.";
-  int tot_extent = for_node->extent.get_constant();
 
-  VLOG(3) << "Try Split loop from (" << for_node->loop_var->name << ", 0, " << tot_extent << ") to ("
+  VLOG(3) << "Try Split loop from (" << for_node->loop_var->name << ", 0, " << for_node->extent << ") to ("
           << cinn::utils::Join(factors, ", ") << ") at loop:\n"
           << loop;
 
-  auto processed_factors = ValidateFactors(factors, tot_extent);
-  int prod_size = std::accumulate(processed_factors.begin(), processed_factors.end(), 1, std::multiplies<int>());
+  std::vector<Expr> extents;
+  bool need_guard = true;
+  if (for_node->extent.is_constant()) {
+    int tot_extent         = for_node->extent.get_constant();
+    auto processed_factors = ValidateFactors(factors, tot_extent);
+    int prod_size          = 1;
+    for (int factor : processed_factors) {
+      prod_size *= factor;
+      extents.emplace_back(factor);
+    }
+    need_guard = tot_extent < prod_size;
+  } else {
+    // the symbolic extent is only known at runtime, its upper bound is unknown here, so exactly one factor must be -1
+    // to cover the extent by ceiling division, and the remainder iterations are skipped by the guard
+    int prod_size   = 1;
+    int num_unknown = 0;
+    for (int factor : factors) {
+      CHECK(factor == -1 || factor > 0) << "The factors of Split should be positive or -1! Please check.";
+      if (factor == -1) {
+        ++num_unknown;
+      } else {
+        prod_size *= factor;
+      }
+    }
+    CHECK_EQ(num_unknown, 1) << "The factors of Split on the symbolic extent " << for_node->extent
+                             << " should contain exactly one -1! Please check.";
+    for (int factor : factors) {
+      extents.push_back(factor == -1 ? common::AutoSimplify((for_node->extent + (prod_size - 1)) / prod_size)
+                                     : Expr(factor));
+    }
+  }
   std::vector<Var> new_loop_vars;
   Expr substitute_value(0);
-  for (int i = 0; i < processed_factors.size(); ++i) {
+  for (int i = 0; i < extents.size(); ++i) {
     Var temp_var(common::UniqName(for_node->loop_var->name));
-    substitute_value = Expr(temp_var) + substitute_value * Expr(processed_factors[i]);
+    substitute_value = Expr(temp_var) + substitute_value * extents[i];
     new_loop_vars.push_back(temp_var);
   }
   substitute_value = common::AutoSimplify(substitute_value);
   Expr new_node    = optim::IRCopy(for_node->body);
   ReplaceExpr(&new_node, {for_node->loop_var}, {substitute_value});
   std::vector<Expr> splited_loops;
-  splited_loops.resize(processed_factors.size());
-  if (tot_extent < prod_size) {
+  splited_loops.resize(extents.size());
+  if (need_guard) {
     new_node = IfThenElse::Make(LT::Make(substitute_value, for_node->extent), new_node);
   }
-  for (int i = processed_factors.size() - 1; i >= 0; i--) {
+  for (int i = extents.size() - 1; i >= 0; i--) {
     if (!new_node.As<ir::Block>()) new_node = Block::Make({new_node});
-    new_node = For::Make(
-        new_loop_vars[i], Expr(0), Expr(processed_factors[i]), for_node->for_type(), for_node->device_api, new_node);
+    new_node = For::Make(new_loop_vars[i], Expr(0), extents[i], for_node->for_type(), for_node->device_api, new_node);
     splited_loops[i] = new_node;
   }
 
@@ -371,7 +418,7 @@ struct RfMutator : public ir::IRMutator<> {
       shape.insert(shape.begin() + rf_axis_, extent);
       domain.insert(domain.begin() + rf_axis_, extent);
       if (tensor->buffer.defined()) {
-        if (tensor->buffer->name.find_first_of("rf") == std::string::npos) {
+        if (!utils::Startswith(tensor->buffer->name, "rf_")) {
           tensor->buffer->name  = "rf_" + tensor->buffer->name;
           tensor->buffer->shape = shape;
         }
@@ -559,11 +606,17 @@ struct RfCreater : public ir::IRMutator<> {
     CHECK(root_realize);
     auto root_block = root_realize->schedule_block.As<ScheduleBlock>();
     CHECK(root_block);
-    Expr root_loop = optim::IRCopy(root_block->body);
-    if (auto block = root_loop.As<Block>()) {
-      CHECK_EQ(block->stmts.size(), 1U) << "rfactor root should only have one block stmt";
-      root_loop = block->stmts[0];
+    // the root may hold several loop nests, only the one containing the rfactor loop is transformed
+    std::vector<Expr> root_stmts;
+    if (auto block = root_block->body.As<Block>()) {
+      root_stmts = block->stmts;
+    } else {
+      root_stmts = {root_block->body};
     }
+    auto rf_stmt = std::find_if(
+        root_stmts.begin(), root_stmts.end(), [&](const Expr& stmt) { return Contains(stmt, rf_loop_); });
+    CHECK(rf_stmt != root_stmts.end()) << "rfactor loop is not found under the root block";
+    Expr root_loop = optim::IRCopy(*rf_stmt);
     auto* root_for = root_loop.As<For>();
     CHECK(root_for);
     auto rf_for = rf_loop_.As<For>();
@@ -580,7 +633,9 @@ struct RfCreater : public ir::IRMutator<> {
     final_mutator(&final_forloop);
     VLOG(3) << "After FinalMuator, final write-back forloop is\n" << final_forloop;
     // combine the new created rfactor forloops with the final write-back forloops and replace
-    root_block->body = Block::Make({new_rf_forloop, final_forloop});
+    rf_stmt = root_stmts.erase(rf_stmt);
+    root_stmts.insert(rf_stmt, {new_rf_forloop, final_forloop});
+    root_block->body = Block::Make(root_stmts);
     return new_rf_tensor;
   }
 
@@ -599,6 +654,15 @@ Expr ScheduleImpl::Rfactor(const Expr& rf_loop, int rf_axis) {
   return rf_create.CreateRfAllStmts();
 }
 
+void ScheduleImpl::Tensorize(const Expr& loop, const std::string& intrinsic_name) {
+  CHECK(loop.As<ir::For>()) << "Expr param of Tensorize must be For node! Please check.";
+  const TensorIntrinsic* intrinsic = TensorIntrinsicRegistry::Global()->Get(intrinsic_name);
+  Expr call                        = intrinsic->Match(loop);
+  CHECK(call.defined()) << "The loop nest doesn't match the tensor intrinsic " << intrinsic_name << ":\n" << loop;
+  VLOG(3) << "Tensorize the loop nest with " << intrinsic_name << ":\n" << loop << "\nto:\n" << call;
+  this->Replace(loop, ir::Block::Make({call}));
+}
+
 struct CacheReadRewriter : public ir::IRMutator<> {
  public:
   static Expr Rewrite(const Expr& root, CacheBlockInfo* info) {
@@ -806,6 +870,465 @@ Expr ScheduleImpl::CacheWrite(const Expr& block, int write_buffer_index, const s
   return *find_cache_block.begin();
 }
 
+// Get the memory type of the buffer of a tensor in the form accepted by _Tensor_::WithBuffer.
+static std::string GetMemoryTypeName(const Tensor& tensor) {
+  if (!tensor->buffer.defined()) return "global";
+  switch (tensor->buffer->memory_type) {
+    case MemoryType::GPUShared:
+      return "shared";
+    case MemoryType::GPULocal:
+      return "local";
+    default:
+      return "global";
+  }
+}
+
+//! Rewrite the accesses to the tensors bound to a buffer to the accesses to the tensors in a new layout.
+struct LayoutRewriter : public ir::IRMutator<> {
+ public:
+  using IndexMap = std::function<std::vector<Expr>(const std::vector<Expr>&)>;
+
+  LayoutRewriter(const std::map<std::string, Tensor>& tensor_map, const IndexMap& index_map)
+      : tensor_map_(tensor_map), index_map_(index_map) {}
+
+  void operator()(Expr* expr) { IRMutator::Visit(expr, expr); }
+
+ private:
+  void Visit(const ir::Load* expr, Expr* op) override {
+    IRMutator::Visit(expr, op);
+    auto* node = op->As<ir::Load>();
+    auto it    = tensor_map_.find(node->tensor.as_tensor_ref()->name);
+    if (it != tensor_map_.end()) {
+      node->tensor  = Expr(it->second);
+      node->indices = index_map_(node->indices);
+    }
+  }
+
+  void Visit(const ir::Store* expr, Expr* op) override {
+    IRMutator::Visit(expr, op);
+    auto* node = op->As<ir::Store>();
+    auto it    = tensor_map_.find(node->tensor.as_tensor_ref()->name);
+    if (it != tensor_map_.end()) {
+      node->tensor  = Expr(it->second);
+      node->indices = index_map_(node->indices);
+    }
+  }
+
+  const std::map<std::string, Tensor>& tensor_map_;
+  IndexMap index_map_;
+};
+
+// Replace the tensors bound to the buffer of a tensor with the ones of a new shape bound to a new buffer, and map the
+// indices accessing them by `index_map`. The tensors sharing the buffer, such as the init tensor of a reduction, are
+// renamed by inserting the suffix after the name of the tensor.
+static void ReplaceBufferTensors(const std::vector<Expr>& exprs,
+                                 const Tensor& tensor,
+                                 const std::vector<Expr>& new_shape,
+                                 const std::string& suffix,
+                                 const LayoutRewriter::IndexMap& index_map,
+                                 const LayoutRewriter::IndexMap& inverse_map) {
+  std::map<std::string, Tensor> tensor_map;
+  for (auto& it_expr : exprs) {
+    auto find_tensor = ir::CollectIRNodesWithoutTensor(it_expr, [&](const Expr* x) {
+      return x->as_tensor() && x->as_tensor()->buffer.defined() &&
+             x->as_tensor()->buffer->name == tensor->buffer->name;
+    });
+    for (auto& t : find_tensor) {
+      Tensor old_tensor = t.as_tensor_ref();
+      if (tensor_map.count(old_tensor->name)) continue;
+
+      std::string new_name = utils::Startswith(old_tensor->name, tensor->name)
+                                 ? tensor->name + suffix + old_tensor->name.substr(tensor->name.size())
+                                 : old_tensor->name + suffix;
+
+      tensor_map[old_tensor->name] = lang::Compute(
+          new_shape, [=](const std::vector<Expr>& dims) { return old_tensor(inverse_map(dims)); }, new_name);
+    }
+  }
+  Tensor new_tensor = tensor_map.at(tensor->name);
+  new_tensor->WithBuffer(GetMemoryTypeName(tensor));
+  for (auto& it : tensor_map) {
+    if (it.second->name != new_tensor->name) {
+      it.second->Bind(new_tensor->buffer);
+    }
+  }
+
+  LayoutRewriter rewriter(tensor_map, index_map);
+  for (auto expr : exprs) {
+    rewriter(&expr);
+  }
+}
+
+// Whether the buffer of the tensor is bound to any output of the lowered functions, including the buffers shared with
+// the outputs such as the init tensor of a reduction. The layouts of the outputs are decided by the callers.
+static bool IsOutputBuffer(const Tensor& tensor, const std::vector<std::string>& output_names) {
+  auto is_output = [&output_names](const std::string& name) {
+    return std::find(output_names.begin(), output_names.end(), name) != output_names.end();
+  };
+  const auto& binded_names = tensor->buffer->binded_tensor_names();
+  return is_output(tensor->name) || std::any_of(binded_names.begin(), binded_names.end(), is_output);
+}
+
+void ScheduleImpl::TransformLayout(const Expr& block,
+                                   int write_buffer_index,
+                                   const std::vector<int>& factors,
+                                   const std::vector<int>& order,
+                                   const std::vector<std::string>& output_names) {
+  CHECK(block.As<ScheduleBlockRealize>()) << "Expr param of TransformLayout must be ScheduleBlockRealize node!";
+  Expr write_expr = GetNthAccessExpr(block, write_buffer_index, true);
+  Tensor tensor   = write_expr.As<ir::Store>()->tensor.as_tensor_ref();
+  CHECK(tensor->buffer.defined()) << "The tensor " << tensor->name << " to transform layout should have a buffer";
+  CHECK(!IsOutputBuffer(tensor, output_names))
+      << "The tensor " << tensor->name << " is an output, only the layout of an intermediate buffer can be transformed";
+  CHECK_EQ(factors.size(), tensor->shape.size())
+      << "The number of factors should be equal to the rank of the tensor " << tensor->name;
+
+  // split the axes of the tensor
+  std::vector<Expr> split_shape;
+  for (int i = 0; i < factors.size(); ++i) {
+    CHECK_GT(factors[i], 0) << "The factor to split an axis should be more than 0";
+    if (factors[i] == 1) {
+      split_shape.push_back(tensor->shape[i]);
+      continue;
+    }
+    CHECK(tensor->shape[i].is_constant() && tensor->shape[i].as_int32() % factors[i] == 0)
+        << "The axis " << i << " of tensor " << tensor->name << " with extent " << tensor->shape[i]
+        << " can't be split by " << factors[i] << ", pad it to a multiple of the factor first";
+    split_shape.push_back(Expr(tensor->shape[i].as_int32() / factors[i]));
+    split_shape.push_back(Expr(factors[i]));
+  }
+  std::vector<int> new_order = order;
+  if (new_order.empty()) {
+    new_order.resize(split_shape.size());
+    std::iota(new_order.begin(), new_order.end(), 0);
+  }
+  CHECK_EQ(new_order.size(), split_shape.size()) << "The order should permute all the " << split_shape.size()
+                                                 << " axes after splitting";
+  // the position of each split axis in the new layout
+  std::vector<int> position(new_order.size(), -1);
+  for (int i = 0; i < new_order.size(); ++i) {
+    CHECK(new_order[i] >= 0 && new_order[i] < static_cast<int>(new_order.size()) && position[new_order[i]] == -1)
+        << "The order " << utils::Join(new_order, ", ") << " is not a permutation of the split axes";
+    position[new_order[i]] = i;
+  }
+  std::vector<Expr> new_shape;
+  for (int i : new_order) {
+    new_shape.push_back(split_shape[i]);
+  }
+
+  auto index_map = [factors, new_order](const std::vector<Expr>& indices) {
+    CHECK_EQ(indices.size(), factors.size());
+    std::vector<Expr> split_indices;
+    for (int i = 0; i < indices.size(); ++i) {
+      if (factors[i] == 1) {
+        split_indices.push_back(indices[i]);
+      } else {
+        Expr factor = common::make_const(indices[i].type(), factors[i]);
+        split_indices.push_back(ir::Div::Make(optim::IRCopy(indices[i]), factor));
+        split_indices.push_back(ir::Mod::Make(optim::IRCopy(indices[i]), factor));
+      }
+    }
+    std::vector<Expr> new_indices;
+    for (int i : new_order) {
+      new_indices.push_back(split_indices[i]);
+    }
+    return new_indices;
+  };
+  auto inverse_map = [factors, position](const std::vector<Expr>& new_indices) {
+    std::vector<Expr> indices;
+    int split_axis = 0;
+    for (int i = 0; i < factors.size(); ++i) {
+      if (factors[i] == 1) {
+        indices.push_back(new_indices[position[split_axis++]]);
+      } else {
+        Expr outer = new_indices[position[split_axis++]];
+        Expr inner = new_indices[position[split_axis++]];
+        indices.push_back(outer * factors[i] + inner);
+      }
+    }
+    return indices;
+  };
+
+  VLOG(3) << "Transform the layout of " << tensor->name << " from [" << utils::Join(tensor->shape, ", ") << "] to ["
+          << utils::Join(new_shape, ", ") << "]";
+  ReplaceBufferTensors(module_expr_.GetExprs(), tensor, new_shape, "_layout", index_map, inverse_map);
+}
+
+// Make the loop nest storing the values computed from the indices to a region of a tensor, the block of the loop nest
+// is named `block_name`.
+static Expr MakeStoreLoops(const Tensor& dst,
+                           const std::vector<IterRange>& ranges,
+                           const std::function<Expr(const std::vector<Expr>&)>& value,
+                           const std::string& block_name,
+                           DeviceAPI device_api) {
+  std::vector<Var> loop_vars;
+  std::vector<Expr> iter_values;
+  std::vector<Var> block_vars;
+  std::vector<Expr> indices;
+  for (int i = 0; i < ranges.size(); ++i) {
+    Var loop_var(common::UniqName("pad_ax" + std::to_string(i)));
+    loop_vars.push_back(loop_var);
+    iter_values.push_back(common::AutoSimplify(ranges[i].min + loop_var));
+    Var block_var(Expr(0), dst->shape[i], "v" + std::to_string(i), false);
+    block_vars.push_back(block_var);
+    indices.push_back(block_var);
+  }
+  Expr body = ir::Store::Make(dst, value(indices), indices);
+
+  Expr new_body =
+      ir::ScheduleBlockRealize::Make(iter_values, ir::ScheduleBlock::Make(block_vars, {}, {}, block_name, body));
+  for (int i = static_cast<int>(loop_vars.size()) - 1; i >= 0; --i) {
+    new_body = For::Make(loop_vars[i],
+                         Expr(0),
+                         common::AutoSimplify(ranges[i].extent),
+                         ir::ForType::Serial,
+                         device_api,
+                         ir::Block::Make({new_body}));
+  }
+  return new_body;
+}
+
+// Make the loop nest copying a region of a tensor to another one at the same indices, the block of the loop nest is
+// named after the tensor written.
+static Expr MakeCopyLoops(const Tensor& dst,
+                          const Tensor& src,
+                          const std::vector<IterRange>& ranges,
+                          DeviceAPI device_api) {
+  return MakeStoreLoops(
+      dst, ranges, [&](const std::vector<Expr>& indices) { return src(indices); }, dst->name, device_api);
+}
+
+Expr ScheduleImpl::PadAxis(const Expr& block, int axis, int factor) {
+  CHECK(block.As<ScheduleBlockRealize>()) << "Expr param of PadAxis must be ScheduleBlockRealize node!";
+  CHECK_GT(factor, 0) << "The factor of PadAxis should be more than 0";
+  auto* block_realize  = block.As<ScheduleBlockRealize>();
+  auto* schedule_block = block_realize->schedule_block.As<ScheduleBlock>();
+  CHECK(axis >= 0 && axis < static_cast<int>(schedule_block->iter_vars.size()))
+      << "The axis " << axis << " is out of the iter vars of block " << schedule_block->name;
+  Var iter_var = schedule_block->iter_vars[axis];
+  CHECK(!iter_var->is_reduce_axis) << "Only the spatial axes can be padded, but " << iter_var->name
+                                   << " is a reduction axis";
+
+  // the loop bound to the axis
+  auto* loop_var = block_realize->iter_values[axis].as_var();
+  CHECK(loop_var) << "The axis " << iter_var->name << " should be bound to a loop directly, but it is bound to "
+                  << block_realize->iter_values[axis];
+  for (int i = 0; i < block_realize->iter_values.size(); ++i) {
+    CHECK(i == axis || !ContainVar({block_realize->iter_values[i]}, loop_var->name))
+        << "The loop " << loop_var->name << " should be bound to the axis " << iter_var->name << " only";
+  }
+  Expr loop;
+  for (auto& it : GetLoops(block)) {
+    if (it.As<ir::For>()->loop_var->name == loop_var->name) {
+      loop = it;
+    }
+  }
+  CHECK(loop.defined()) << "Can't find the loop " << loop_var->name << " of block " << schedule_block->name;
+  auto* for_node = loop.As<ir::For>();
+  CHECK(common::is_zero(for_node->min) && for_node->extent.is_constant())
+      << "The loop " << loop_var->name << " to be padded should start with 0 and have a constant extent";
+  int extent        = for_node->extent.as_int32();
+  int padded_extent = (extent + factor - 1) / factor * factor;
+  if (padded_extent == extent) {
+    return block;
+  }
+
+  auto root = GetRootBlock(block);
+  ChangeBodyToBlock::Change(&root);
+  auto& root_stmts = root.As<ScheduleBlockRealize>()->schedule_block.As<ScheduleBlock>()->body.As<Block>()->stmts;
+  int nest_pos     = -1;
+  for (int i = 0; i < root_stmts.size(); ++i) {
+    if (Contains(root_stmts[i], block)) {
+      nest_pos = i;
+      break;
+    }
+  }
+  CHECK_GE(nest_pos, 0) << "Can't find the loop nest of block " << schedule_block->name;
+  auto blocks_in_nest = ir::CollectIRNodesWithoutTensor(root_stmts[nest_pos],
+                                                        [](const Expr* x) { return x->As<ScheduleBlockRealize>(); });
+  CHECK_EQ(blocks_in_nest.size(), 1U) << "The block to be padded should be the only block in its loop nest";
+
+  // the accessed tensors indexed by the axis and their dimensions indexed
+  std::vector<Expr> accesses;
+  ir::CollectIRNodesWithoutTensor(schedule_block->body, [&](const Expr* x) {
+    if (x->As<ir::Load>() || x->As<ir::Store>()) accesses.push_back(*x);
+    return false;
+  });
+  Expr store;
+  std::vector<Tensor> padded_tensors;
+  std::map<std::string, int> padded_dims;
+  for (auto& access : accesses) {
+    auto* load = access.As<ir::Load>();
+    if (!load) {
+      CHECK(!store.defined() || store == access) << "The block to be padded should write a single tensor";
+      store = access;
+    }
+    Tensor tensor                    = (load ? load->tensor : access.As<ir::Store>()->tensor).as_tensor_ref();
+    const std::vector<Expr>& indices = load ? load->indices : access.As<ir::Store>()->indices;
+    int dim                          = -1;
+    for (int i = 0; i < indices.size(); ++i) {
+      if (ContainVar({indices[i]}, iter_var->name)) {
+        CHECK(dim == -1 && indices[i].as_var() && indices[i].as_var()->name == iter_var->name)
+            << "The axis " << iter_var->name << " should index a single dimension of tensor " << tensor->name
+            << " by itself";
+        dim = i;
+      }
+    }
+    if (dim == -1) continue;
+    auto it = padded_dims.find(tensor->name);
+    if (it == padded_dims.end()) {
+      padded_dims[tensor->name] = dim;
+      padded_tensors.push_back(tensor);
+    } else {
+      CHECK_EQ(it->second, dim) << "The axis " << iter_var->name << " indexes different dimensions of tensor "
+                                << tensor->name;
+    }
+  }
+  CHECK(store.defined()) << "The block to be padded should write a tensor";
+  Tensor output = store.As<ir::Store>()->tensor.as_tensor_ref();
+  CHECK(padded_dims.count(output->name)) << "The axis " << iter_var->name << " should index the output "
+                                         << output->name;
+  for (auto& access : accesses) {
+    CHECK(!access.As<ir::Load>() || access.As<ir::Load>()->tensor.as_tensor_ref()->name != output->name)
+        << "The block to be padded shouldn't read the tensor " << output->name << " it writes";
+  }
+  auto write_ranges = CalculateTensorRegions(block, store.As<ir::Store>()->indices, output, root);
+
+  // make the padded copies of the tensors, the inputs are copied in and the output is written back
+  std::map<std::string, Tensor> tensor_map;
+  std::vector<Expr> copy_in_loops;
+  Expr write_back_loop;
+  for (auto& tensor : padded_tensors) {
+    int dim                 = padded_dims.at(tensor->name);
+    std::vector<Expr> shape = tensor->shape;
+    shape[dim]              = Expr(padded_extent);
+
+    Tensor padded_tensor = lang::Compute(
+        shape, [=](const std::vector<Expr>& dims) { return tensor(dims); }, tensor->name + "_pad");
+    padded_tensor->WithBuffer(GetMemoryTypeName(tensor));
+    tensor_map[tensor->name] = padded_tensor;
+    if (tensor->name == output->name) {
+      write_back_loop = MakeCopyLoops(output, padded_tensor, write_ranges, for_node->device_api);
+    } else {
+      std::vector<IterRange> read_ranges;
+      std::vector<IterRange> tail_ranges;
+      for (int i = 0; i < tensor->shape.size(); ++i) {
+        read_ranges.emplace_back(Expr(0), i == dim ? Expr(extent) : tensor->shape[i]);
+        tail_ranges.emplace_back(i == dim ? Expr(extent) : Expr(0),
+                                 i == dim ? Expr(padded_extent - extent) : tensor->shape[i]);
+      }
+      copy_in_loops.push_back(MakeCopyLoops(padded_tensor, tensor, read_ranges, for_node->device_api));
+      // the padded lanes are computed as well, fill them by zero so the block never reads undefined values
+      copy_in_loops.push_back(MakeStoreLoops(
+          padded_tensor,
+          tail_ranges,
+          [&](const std::vector<Expr>& indices) { return common::make_const(tensor->type(), 0); },
+          padded_tensor->name + "__pad_init",
+          for_node->device_api));
+    }
+  }
+  VLOG(3) << "Pad the axis " << iter_var->name << " of block " << schedule_block->name << " from " << extent << " to "
+          << padded_extent;
+
+  // compute the block on the padded axis and the padded copies
+  for (auto& access : accesses) {
+    if (auto* load = access.As<ir::Load>()) {
+      auto it = tensor_map.find(load->tensor.as_tensor_ref()->name);
+      if (it != tensor_map.end()) load->tensor = Expr(it->second);
+    } else {
+      access.As<ir::Store>()->tensor = Expr(tensor_map.at(output->name));
+    }
+  }
+  schedule_block->name                         = tensor_map.at(output->name)->name;
+  schedule_block->iter_vars[axis]->upper_bound = Expr(padded_extent);
+  for_node->extent                             = Expr(padded_extent);
+  root_stmts.insert(root_stmts.begin() + nest_pos + 1, write_back_loop);
+  root_stmts.insert(root_stmts.begin() + nest_pos, copy_in_loops.begin(), copy_in_loops.end());
+  return block;
+}
+
+void ScheduleImpl::Prefetch(const Expr& block, int read_buffer_index, const Expr& loop, int distance) {
+  CHECK(block.As<ScheduleBlockRealize>()) << "Expr param(block) of Prefetch must be ScheduleBlockRealize node!";
+  CHECK(loop.As<ir::For>()) << "Expr param(loop) of Prefetch must be For node!";
+  CHECK_GT(distance, 0) << "The distance to prefetch should be more than 0";
+  auto* block_realize  = block.As<ScheduleBlockRealize>();
+  auto* schedule_block = block_realize->schedule_block.As<ScheduleBlock>();
+  auto loops           = GetLoops(block);
+  auto loop_it         = std::find(loops.begin(), loops.end(), loop);
+  CHECK(loop_it != loops.end()) << "The loop to prefetch in should be a loop of block " << schedule_block->name;
+
+  // the element read by the block in terms of the loop vars
+  Expr read_expr = optim::IRCopy(GetNthAccessExpr(block, read_buffer_index, false));
+  ReplaceExpr(&read_expr, schedule_block->iter_vars, optim::IRCopy(block_realize->iter_values));
+  auto* for_node = loop.As<ir::For>();
+  std::vector<Var> loop_vars;
+  std::vector<Expr> loop_values;
+  loop_vars.push_back(for_node->loop_var);
+  loop_values.push_back(ir::Min::Make(for_node->loop_var + distance, for_node->min + for_node->extent - 1));
+  for (auto it = loop_it + 1; it != loops.end(); ++it) {
+    loop_vars.push_back(it->As<ir::For>()->loop_var);
+    loop_values.push_back(it->As<ir::For>()->min);
+  }
+  ReplaceExpr(&read_expr, loop_vars, loop_values);
+  auto* load = read_expr.As<ir::Load>();
+  for (auto& index : load->indices) {
+    index = common::AutoSimplify(index);
+  }
+  VLOG(3) << "Prefetch " << read_expr << " in the loop " << for_node->loop_var;
+
+  Expr prefetch =
+      runtime::IntrinsicCall(Void(), runtime::intrinsic::prefetch, {ir::intrinsics::GetAddr::Make(read_expr)});
+  if (!for_node->body.As<ir::Block>()) {
+    for_node->body = ir::Block::Make({for_node->body});
+  }
+  Expr for_loop = loop;
+  InsertBlock(for_loop, prefetch, 0);
+}
+
+void ScheduleImpl::StorageAlign(const Expr& block,
+                                int write_buffer_index,
+                                int axis,
+                                int factor,
+                                int offset,
+                                const std::vector<std::string>& output_names) {
+  CHECK(block.As<ScheduleBlockRealize>()) << "Expr param of StorageAlign must be ScheduleBlockRealize node!";
+  Expr write_expr = GetNthAccessExpr(block, write_buffer_index, true);
+  Tensor tensor   = write_expr.As<ir::Store>()->tensor.as_tensor_ref();
+  int rank        = tensor->shape.size();
+  CHECK(tensor->buffer.defined()) << "The tensor " << tensor->name << " to align storage should have a buffer";
+  CHECK(!IsOutputBuffer(tensor, output_names))
+      << "The tensor " << tensor->name << " is an output, only the storage of an intermediate buffer can be aligned";
+  CHECK(axis >= 0 && axis < rank - 1) << "The axis " << axis << " to align should be an outer axis of tensor "
+                                      << tensor->name << " of rank " << rank;
+  CHECK(factor > 0 && offset >= 0 && offset < factor)
+      << "The offset " << offset << " should be in the range [0, " << factor << ") of the factor";
+
+  // the stride of the axis is the extent of the next axis times its stride, so the next axis is padded
+  int inner_stride = 1;
+  for (int i = axis + 1; i < rank; ++i) {
+    CHECK(tensor->shape[i].is_constant()) << "The inner axes of tensor " << tensor->name << " should be constant";
+    if (i > axis + 1) inner_stride *= tensor->shape[i].as_int32();
+  }
+  int extent        = tensor->shape[axis + 1].as_int32();
+  int padded_extent = extent;
+  while (padded_extent - extent < factor && padded_extent * inner_stride % factor != offset) {
+    ++padded_extent;
+  }
+  CHECK_EQ(padded_extent * inner_stride % factor, offset)
+      << "The stride of axis " << axis << " of tensor " << tensor->name << " can't be aligned by padding the axis "
+      << axis + 1 << " whose stride is " << inner_stride;
+  if (padded_extent == extent) {
+    return;
+  }
+
+  std::vector<Expr> new_shape = tensor->shape;
+  new_shape[axis + 1]         = Expr(padded_extent);
+  VLOG(3) << "Align the storage of " << tensor->name << " from [" << utils::Join(tensor->shape, ", ") << "] to ["
+          << utils::Join(new_shape, ", ") << "]";
+  auto identity = [](const std::vector<Expr>& indices) { return indices; };
+  ReplaceBufferTensors(module_expr_.GetExprs(), tensor, new_shape, "", identity, identity);
+}
+
 struct InsertExpr : public ir::IRMutator<> {
  public:
   static void Insert(const Expr& ir_node, const Expr& insert_node, bool after_node, Expr* expr) {
@@ -859,6 +1382,70 @@ void ScheduleImpl::SyncThreads(const Expr& ir_node, bool after_node) {
   return;
 }
 
+Expr ScheduleImpl::DecomposeReduction(const Expr& block, const Expr& loop) {
+  CHECK(block.As<ScheduleBlockRealize>()) << "Expr param(block) of DecomposeReduction must be ScheduleBlockRealize!";
+  CHECK(loop.As<ir::For>()) << "Expr param(loop) of DecomposeReduction must be For node!";
+  const std::string& block_name = block.As<ScheduleBlockRealize>()->schedule_block.As<ScheduleBlock>()->name;
+  const std::string& loop_name  = loop.As<ir::For>()->loop_var->name;
+  std::string init_name         = GenReduceInitTensorNameOf(block_name);
+  CHECK(HasBlock(init_name)) << "The block " << block_name << " should be a reduction with an init block";
+  auto loops = GetLoops(block);
+  CHECK(std::find(loops.begin(), loops.end(), loop) != loops.end())
+      << "The loop " << loop_name << " should be a loop of block " << block_name;
+  Expr init_block = GetBlock(init_name);
+  auto init_loops = GetLoops(init_block);
+  auto loop_it    = std::find(init_loops.begin(), init_loops.end(), loop);
+  CHECK(loop_it != init_loops.end()) << "The init block " << init_name << " should be inside the loop " << loop_name
+                                     << " to be decomposed out of it";
+
+  // the new init block is computed by the copies of the loops inside the loop that it is bound to, the others, such
+  // as the reduction loops, are dropped
+  Expr new_init     = optim::IRCopy(init_block);
+  auto& iter_values = new_init.As<ScheduleBlockRealize>()->iter_values;
+  std::vector<Expr> kept_loops;
+  std::vector<Var> loop_vars;
+  std::vector<Expr> new_loop_vars;
+  for (auto it = loop_it; it != init_loops.end(); ++it) {
+    const Var& loop_var = it->As<ir::For>()->loop_var;
+    if (!ContainVar(iter_values, loop_var->name)) continue;
+    kept_loops.push_back(*it);
+    loop_vars.push_back(loop_var);
+    new_loop_vars.push_back(Var(common::UniqName(loop_var->name + "_init")));
+  }
+  for (auto& value : iter_values) {
+    ReplaceExpr(&value, loop_vars, new_loop_vars);
+  }
+  Expr new_nest = new_init;
+  for (int i = static_cast<int>(kept_loops.size()) - 1; i >= 0; --i) {
+    auto* for_node = kept_loops[i].As<ir::For>();
+    Expr min       = optim::IRCopy(for_node->min);
+    Expr extent    = optim::IRCopy(for_node->extent);
+    ReplaceExpr(&min, loop_vars, new_loop_vars);
+    ReplaceExpr(&extent, loop_vars, new_loop_vars);
+    new_nest = For::Make(new_loop_vars[i].as_var_ref(),
+                         min,
+                         extent,
+                         for_node->for_type(),
+                         for_node->device_api,
+                         Block::Make({new_nest}),
+                         for_node->vectorize_info(),
+                         for_node->bind_info());
+  }
+
+  // remove the init block from the loop and insert the new one before the loop
+  Expr root = GetRootBlock(block);
+  Expr source_expr{nullptr};
+  Expr target_expr{nullptr};
+  LeafBlockRemovalPlan remove_plan(init_block, &source_expr, &target_expr);
+  remove_plan(&root);
+  CHECK(source_expr.defined()) << "The init block " << init_name << " should be a sibling of the reduction loops";
+  this->Replace(source_expr, target_expr);
+  ChangeBodyToBlock::Change(&root);
+  InsertExpr::Insert(loop, new_nest, false, &root);
+  VLOG(3) << "After DecomposeReduction of " << block_name << " at the loop " << loop_name << ", ir is:\n" << root;
+  return new_init;
+}
+
 /**
  * Replace a For node to another For node.
  * @param src_sref The For node to be changed.
@@ -2222,6 +2809,68 @@ Expr IRSchedule::Rfactor(const Expr& rf_loop, int rf_axis) {
   return result;
 }
 
+void IRSchedule::Tensorize(const Expr& loop, const std::string& intrinsic_name) {
+  impl_->Tensorize(loop, intrinsic_name);
+  trace_.Append(
+      ScheduleDesc::Step("Tensorize", {{"loop", std::vector<Expr>({loop})}}, {{"intrinsic_name", intrinsic_name}}, {}));
+}
+
+void IRSchedule::TransformLayout(const Expr& block,
+                                 int write_buffer_index,
+                                 const std::vector<int>& factors,
+                                 const std::vector<int>& order,
+                                 const std::vector<std::string>& output_names) {
+  impl_->TransformLayout(block, write_buffer_index, factors, order, output_names);
+  trace_.Append(ScheduleDesc::Step("TransformLayout",
+                                   {{"block", std::vector<Expr>({block})}},
+                                   {{"write_buffer_index", write_buffer_index},
+                                    {"factors", factors},
+                                    {"order", order},
+                                    {"output_names", output_names}},
+                                   {}));
+}
+
+Expr IRSchedule::PadAxis(const Expr& block, int axis, int factor) {
+  auto result = impl_->PadAxis(block, axis, factor);
+  trace_.Append(ScheduleDesc::Step(
+      "PadAxis", {{"block", std::vector<Expr>({block})}}, {{"axis", axis}, {"factor", factor}}, {result}));
+  return result;
+}
+
+void IRSchedule::Prefetch(const Expr& block, int read_buffer_index, const Expr& loop, int distance) {
+  impl_->Prefetch(block, read_buffer_index, loop, distance);
+  trace_.Append(ScheduleDesc::Step("Prefetch",
+                                   {{"block", std::vector<Expr>({block})}, {"loop", std::vector<Expr>({loop})}},
+                                   {{"read_buffer_index", read_buffer_index}, {"distance", distance}},
+                                   {}));
+}
+
+void IRSchedule::StorageAlign(const Expr& block,
+                              int write_buffer_index,
+                              int axis,
+                              int factor,
+                              int offset,
+                              const std::vector<std::string>& output_names) {
+  impl_->StorageAlign(block, write_buffer_index, axis, factor, offset, output_names);
+  trace_.Append(ScheduleDesc::Step("StorageAlign",
+                                   {{"block", std::vector<Expr>({block})}},
+                                   {{"write_buffer_index", write_buffer_index},
+                                    {"axis", axis},
+                                    {"factor", factor},
+                                    {"offset", offset},
+                                    {"output_names", output_names}},
+                                   {}));
+}
+
+Expr IRSchedule::DecomposeReduction(const Expr& block, const Expr& loop) {
+  auto result = impl_->DecomposeReduction(block, loop);
+  trace_.Append(ScheduleDesc::Step("DecomposeReduction",
+                                   {{"block", std::vector<Expr>({block})}, {"loop", std::vector<Expr>({loop})}},
+                                   {},
+                                   {result}));
+  return result;
+}
+
 void IRSchedule::Annotate(const Expr& block, const std::string& key, const attr_t& value) {
   impl_->Annotate(block, key, value);
 
@@ -119,7 +119,7 @@ class IRSchedule {
   /**
    * \brief Split a for loop into multiple loops, based on the factors.
    * @param loop The loop to be splited.
-   * @param factors The factors we used to split the loop.
+   * @param factors The factors we used to split the loop. One of them must be -1 if the extent of the loop is symbolic.
    * @return The splited loops.
    */
   std::vector<Expr> Split(const Expr& loop, const std::vector<int>& factors);
@@ -353,6 +353,170 @@ class IRSchedule {
    */
   Expr Rfactor(const Expr& rf_loop, int rf_axis);
 
+  /**
+   * \brief Replace the loop nest rooted at the given loop with a call to the hand-optimized function of a tensor
+   * intrinsic, the loop nest must match the description of the intrinsic registered in TensorIntrinsicRegistry.
+   * @param loop the outermost loop of the loop nest to be replaced.
+   * @param intrinsic_name the name of the tensor intrinsic.
+   *
+   * For example, tensorize the loop i_1 with the intrinsic gemm_6x16_fp32:
+   * \code
+   * for (i_0, 0, 16)
+   *   for (j_0, 0, 4)
+   *     for (i_1, 0, 6)
+   *       for (j_1, 0, 16)
+   *         C_init[i_0 * 6 + i_1, j_0 * 16 + j_1] = 0
+   *         for (k, 0, 64)
+   *           C[i_0 * 6 + i_1, j_0 * 16 + j_1] += A[i_0 * 6 + i_1, k] * B[k, j_0 * 16 + j_1]
+   * \endcode
+   * The loop nest is replaced as follows:
+   * \code
+   * for (i_0, 0, 16)
+   *   for (j_0, 0, 4)
+   *     cinn_host_gemm_6x16_fp32(A, i_0 * 384, 64, B, j_0 * 16, 64, C, i_0 * 384 + j_0 * 16, 64, 64, 0)
+   * \endcode
+   */
+  void Tensorize(const Expr& loop, const std::string& intrinsic_name);
+
+  /**
+   * \brief Transform the layout of the buffer written by a block. Each axis of the buffer is split into an outer axis
+   * and an inner axis of the given factor, then the axes are permuted, and all the blocks reading or writing the buffer
+   * are rewritten to access it in the new layout.
+   * @param block the block writing the buffer.
+   * @param write_buffer_index the index of the buffer in the buffers written by the block.
+   * @param factors the factor to split each axis of the buffer, an axis is not split if its factor is 1.
+   * @param order the order of the axes after splitting, the axes are kept in order if it is empty.
+   * @param output_names the names of the tensors output by the lowered functions, the buffer shouldn't be bound to any
+   * of them since the layouts of the arguments are decided by the callers.
+   *
+   * For example, transform the layout of B from NCHW to NCHW16c with factors [1, 16, 1, 1] and order [0, 1, 3, 4, 2]:
+   * \code
+   * B[n, c, h, w] = A[n, c, h, w] + 1
+   * C[n, c, h, w] = B[n, c, h, w] * 2
+   * \endcode
+   * The accesses to B are rewritten as follows:
+   * \code
+   * B_layout[n, c / 16, h, w, c % 16] = A[n, c, h, w] + 1
+   * C[n, c, h, w] = B_layout[n, c / 16, h, w, c % 16] * 2
+   * \endcode
+   */
+  void TransformLayout(const Expr& block,
+                       int write_buffer_index,
+                       const std::vector<int>& factors,
+                       const std::vector<int>& order,
+                       const std::vector<std::string>& output_names);
+
+  /**
+   * \brief Pad a spatial axis of a block to a multiple of the factor, such as the vector width, so the loop of the
+   * axis can be vectorized or split evenly. The block is computed on the padded copies of the tensors indexed by
+   * the axis, the inputs are copied before its loop nest with their padded tails filled by zero, and the valid part of
+   * the output is written back after it.
+   * @param block the block to be padded, it should be the only block in its loop nest and write a single tensor.
+   * @param axis the index of the iter var to be padded, it should be bound to a loop directly and index the
+   * tensors only by itself.
+   * @param factor the extent of the axis is padded to a multiple of it.
+   * @return the padded block, it writes the padded copy of the output.
+   *
+   * For example, pad the axis j of B with factor 8:
+   * \code
+   * for (i, 0, 32)
+   *   for (j, 0, 30)
+   *     B[i, j] = A[i, j] * 2
+   * \endcode
+   * The loop nest is transformed as follows:
+   * \code
+   * for (i, 0, 32)
+   *   for (j, 0, 30)
+   *     A_pad[i, j] = A[i, j]
+   * for (i, 0, 32)
+   *   for (j, 0, 2)
+   *     A_pad[i, (30 + j)] = 0
+   * for (i, 0, 32)
+   *   for (j, 0, 32)
+   *     B_pad[i, j] = A_pad[i, j] * 2
+   * for (i, 0, 32)
+   *   for (j, 0, 30)
+   *     B[i, j] = B_pad[i, j]
+   * \endcode
+   */
+  Expr PadAxis(const Expr& block, int axis, int factor);
+
+  /**
+   * \brief Prefetch the elements a block reads from a buffer some iterations of a loop ahead on CPU. A prefetch of the
+   * element read `distance` iterations later is inserted at the beginning of the body of the loop, the loops inside it
+   * are taken at their first iterations, and the iterations past the end of the loop are clamped to its last one.
+   * @param block the block reading the buffer.
+   * @param read_buffer_index the index of the buffer in the buffers read by the block.
+   * @param loop the loop to prefetch in, it should be a loop of the block.
+   * @param distance the number of iterations to prefetch ahead.
+   *
+   * For example, prefetch A in the loop i with distance 8:
+   * \code
+   * for (i, 0, 64)
+   *   for (j, 0, 32)
+   *     B[j, i] = A[i, j]
+   * \endcode
+   * The loop nest is transformed as follows:
+   * \code
+   * for (i, 0, 64)
+   *   __builtin_prefetch(&(A[min(i + 8, 63), 0]))
+   *   for (j, 0, 32)
+   *     B[j, i] = A[i, j]
+   * \endcode
+   */
+  void Prefetch(const Expr& block, int read_buffer_index, const Expr& loop, int distance);
+
+  /**
+   * \brief Align the stride of an axis of the buffer written by a block, so the stride is `offset` modulo `factor`.
+   * The storage is padded by enlarging the next axis, and the indices accessing the buffer are kept. It avoids the
+   * cache set conflicts of the buffers whose rows are a multiple of the cache way size apart.
+   * @param block the block writing the buffer.
+   * @param write_buffer_index the index of the buffer in the buffers written by the block.
+   * @param axis the axis whose stride is aligned, it can't be the last axis.
+   * @param factor the factor of the alignment.
+   * @param offset the offset of the alignment, it should be less than the factor.
+   * @param output_names the names of the tensors output by the lowered functions, the buffer shouldn't be bound to any
+   * of them since the strides of the arguments are decided by the callers.
+   *
+   * For example, align the stride of the axis 0 of B[64, 1024] with factor 1024 and offset 16, the storage of B is
+   * changed to [64, 1040], so its rows are 16 elements more apart.
+   */
+  void StorageAlign(const Expr& block,
+                    int write_buffer_index,
+                    int axis,
+                    int factor,
+                    int offset,
+                    const std::vector<std::string>& output_names);
+
+  /**
+   * \brief Decompose the initialization of a reduction block out of a loop. The init block of the reduction is moved
+   * before the loop into a loop nest of its own, which copies the loops inside the loop that the init block is bound
+   * to. The loops of the reduction from the loop down then contain the update only, so the reduction loops can be
+   * reordered outside the spatial ones and the spatial loops can be vectorized or unrolled.
+   * @param block the reduction block, its init block is named after it with the suffix "__reduce_init".
+   * @param loop the loop to decompose the reduction at, it should be a loop of the block containing the init block.
+   * @return the new init block.
+   *
+   * For example, decompose the reduction at the loop j:
+   * \code
+   * for (i, 0, 32)
+   *   for (j, 0, 64)
+   *     C__reduce_init[i, j] = 0
+   *     for (k, 0, 16)
+   *       C[i, j] = C[i, j] + A[i, k] * B[k, j]
+   * \endcode
+   * The loop nest is transformed as follows:
+   * \code
+   * for (i, 0, 32)
+   *   for (j_init, 0, 64)
+   *     C__reduce_init[i, j_init] = 0
+   *   for (j, 0, 64)
+   *     for (k, 0, 16)
+   *       C[i, j] = C[i, j] + A[i, k] * B[k, j]
+   * \endcode
+   */
+  Expr DecomposeReduction(const Expr& block, const Expr& loop);
+
   /*!
    * \brief Annotate a block with a key-value pair to set as its attribute
    * \param block The block to be annotated
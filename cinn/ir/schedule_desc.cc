@@ -420,6 +420,35 @@ CINN_BUILD_STEP_KIND(Rfactor)
     .Attrs({"rf_axis"})
     .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::Rfactor)));
 
+CINN_BUILD_STEP_KIND(Tensorize)
+    .Inputs({"loop"})
+    .Attrs({"intrinsic_name"})
+    .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::Tensorize)));
+
+CINN_BUILD_STEP_KIND(TransformLayout)
+    .Inputs({"block"})
+    .Attrs({"write_buffer_index", "factors", "order", "output_names"})
+    .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::TransformLayout)));
+
+CINN_BUILD_STEP_KIND(PadAxis)
+    .Inputs({"block"})
+    .Attrs({"axis", "factor"})
+    .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::PadAxis)));
+
+CINN_BUILD_STEP_KIND(Prefetch)
+    .Inputs({"block", "loop"})
+    .Attrs({"read_buffer_index", "distance"})
+    .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::Prefetch)));
+
+CINN_BUILD_STEP_KIND(StorageAlign)
+    .Inputs({"block"})
+    .Attrs({"write_buffer_index", "axis", "factor", "offset", "output_names"})
+    .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::StorageAlign)));
+
+CINN_BUILD_STEP_KIND(DecomposeReduction)
+    .Inputs({"block", "loop"})
+    .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::DecomposeReduction)));
+
 CINN_BUILD_STEP_KIND(MergeExprs)
     .SetApplyFn(APPLY_FUNC_UNIFORM(FREE_FUNCTION_CONVERTER(&IRSchedule::MergeExprs)));
 
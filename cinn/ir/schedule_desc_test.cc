@@ -666,6 +666,142 @@ TEST_F(TestScheduleDesc, StepKind_Rfactor) {
   CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
 }
 
+TEST_F(TestScheduleDesc, StepKind_Tensorize) {
+  Expr M(6);
+  Expr N(16);
+  Expr K(32);
+
+  Placeholder<float> A("A", {M, K});
+  Placeholder<float> B("B", {K, N});
+  Var k(32, "k0");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return lang::ReduceSum(A(i, k) * B(k, j), {k}); }, "C");
+
+  lowered_funcs =
+      cinn::lang::LowerVec("test_tensorize", CreateStages({A, B, C}), {A, B, C}, {}, {}, nullptr, target, true);
+
+  cinn::common::Context::Global().ResetNameId();
+  ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+  cinn::common::Context::Global().ResetNameId();
+
+  auto loops = ir_sch.GetLoops("C");
+  trace.Append(ScheduleDesc::Step("GetLoopsWithName", {}, {{"block_name", std::string("C")}}, loops));
+  ir_sch.Tensorize(loops[0], "gemm_6x16_fp32");
+  trace.Append(ScheduleDesc::Step("Tensorize",
+                                  {{"loop", std::vector<Expr>({loops[0]})}},
+                                  {{"intrinsic_name", std::string("gemm_6x16_fp32")}},
+                                  {}));
+  CheckReplayResult(ir_sch, trace);
+  CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
+}
+
+TEST_F(TestScheduleDesc, StepKind_TransformLayout) {
+  lowered_funcs         = LowerCompute({32, 64}, target, true, "elementwise-add_const");
+  ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+
+  auto block_b = ir_sch.GetBlock("B");
+  trace.Append(ScheduleDesc::Step("GetBlock", {}, {{"block_name", std::string("B")}}, {block_b}));
+  ir_sch.TransformLayout(block_b, 0, {1, 16}, {1, 0, 2}, {"C"});
+  trace.Append(ScheduleDesc::Step("TransformLayout",
+                                  {{"block", std::vector<Expr>({block_b})}},
+                                  {{"write_buffer_index", 0},
+                                   {"factors", std::vector<int>({1, 16})},
+                                   {"order", std::vector<int>({1, 0, 2})},
+                                   {"output_names", std::vector<std::string>({"C"})}},
+                                  {}));
+  CheckReplayResult(ir_sch, trace);
+  CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
+}
+
+TEST_F(TestScheduleDesc, StepKind_PadAxis) {
+  lowered_funcs = LowerCompute({32, 30}, target, false, "elementwise-add_const");
+
+  // the copy loops are named uniquely, reset the name id to replay the same names
+  cinn::common::Context::Global().ResetNameId();
+  ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+  cinn::common::Context::Global().ResetNameId();
+
+  auto block_b = ir_sch.GetBlock("B");
+  trace.Append(ScheduleDesc::Step("GetBlock", {}, {{"block_name", std::string("B")}}, {block_b}));
+  auto padded_block = ir_sch.PadAxis(block_b, 1, 8);
+  trace.Append(ScheduleDesc::Step(
+      "PadAxis", {{"block", std::vector<Expr>({block_b})}}, {{"axis", 1}, {"factor", 8}}, {padded_block}));
+  CheckTracingOutputs({padded_block}, trace);
+  CheckTracingOutputs({padded_block}, ir_sch.GetTraceDesc());
+  CheckReplayResult(ir_sch, trace);
+  CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
+}
+
+TEST_F(TestScheduleDesc, StepKind_Prefetch) {
+  lowered_funcs         = LowerCompute({32, 64}, target);
+  ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+
+  auto block_b = ir_sch.GetBlock("B");
+  trace.Append(ScheduleDesc::Step("GetBlock", {}, {{"block_name", std::string("B")}}, {block_b}));
+  auto loops = ir_sch.GetLoops("B");
+  trace.Append(ScheduleDesc::Step("GetLoopsWithName", {}, {{"block_name", std::string("B")}}, loops));
+  ir_sch.Prefetch(block_b, 0, loops[1], 8);
+  trace.Append(ScheduleDesc::Step("Prefetch",
+                                  {{"block", std::vector<Expr>({block_b})}, {"loop", std::vector<Expr>({loops[1]})}},
+                                  {{"read_buffer_index", 0}, {"distance", 8}},
+                                  {}));
+  CheckReplayResult(ir_sch, trace);
+  CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
+}
+
+TEST_F(TestScheduleDesc, StepKind_StorageAlign) {
+  lowered_funcs         = LowerCompute({32, 1024}, target, true, "elementwise-add_const");
+  ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+
+  auto block_b = ir_sch.GetBlock("B");
+  trace.Append(ScheduleDesc::Step("GetBlock", {}, {{"block_name", std::string("B")}}, {block_b}));
+  ir_sch.StorageAlign(block_b, 0, 0, 1024, 16, {"C"});
+  trace.Append(ScheduleDesc::Step("StorageAlign",
+                                  {{"block", std::vector<Expr>({block_b})}},
+                                  {{"write_buffer_index", 0},
+                                   {"axis", 0},
+                                   {"factor", 1024},
+                                   {"offset", 16},
+                                   {"output_names", std::vector<std::string>({"C"})}},
+                                  {}));
+  CheckReplayResult(ir_sch, trace);
+  CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
+}
+
+TEST_F(TestScheduleDesc, StepKind_DecomposeReduction) {
+  Expr M(32);
+  Expr N(64);
+  Expr K(16);
+
+  Placeholder<float> A("A", {M, K});
+  Placeholder<float> B("B", {K, N});
+  Var k(16, "k0");
+  auto C = Compute(
+      {M, N}, [&](Var i, Var j) { return lang::ReduceSum(A(i, k) * B(k, j), {k}); }, "C");
+
+  lowered_funcs = cinn::lang::LowerVec(
+      "test_decompose_reduction", CreateStages({A, B, C}), {A, B, C}, {}, {}, nullptr, target, true);
+
+  // the copied loops are named uniquely, reset the name id to replay the same names
+  cinn::common::Context::Global().ResetNameId();
+  ir::IRSchedule ir_sch = MakeIRSchedule(lowered_funcs);
+  cinn::common::Context::Global().ResetNameId();
+
+  auto block_c = ir_sch.GetBlock("C");
+  trace.Append(ScheduleDesc::Step("GetBlock", {}, {{"block_name", std::string("C")}}, {block_c}));
+  auto loops = ir_sch.GetLoops("C");
+  trace.Append(ScheduleDesc::Step("GetLoopsWithName", {}, {{"block_name", std::string("C")}}, loops));
+  auto init_block = ir_sch.DecomposeReduction(block_c, loops[1]);
+  trace.Append(ScheduleDesc::Step("DecomposeReduction",
+                                  {{"block", std::vector<Expr>({block_c})}, {"loop", std::vector<Expr>({loops[1]})}},
+                                  {},
+                                  {init_block}));
+  CheckTracingOutputs({init_block}, trace);
+  CheckTracingOutputs({init_block}, ir_sch.GetTraceDesc());
+  CheckReplayResult(ir_sch, trace);
+  CheckReplayResult(ir_sch, ir_sch.GetTraceDesc());
+}
+
 TEST_F(TestScheduleDesc, StepKind_MergeExprs) {
   auto funcs_0 = LowerCompute({32, 128}, target);
   auto funcs_1 = LowerCompute({32, 32, 32}, target, true, "elementwise-add_const");
@@ -0,0 +1,328 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cinn/ir/tensor_intrinsic.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "cinn/common/cas.h"
+#include "cinn/common/ir_util.h"
+#include "cinn/ir/collect_ir_nodes.h"
+#include "cinn/ir/ir_mutator.h"
+#include "cinn/ir/ir_operators.h"
+#include "cinn/lang/placeholder.h"
+#include "cinn/optim/ir_copy.h"
+
+namespace cinn {
+namespace ir {
+
+namespace {
+
+// Replace the variables by their names at once, so a replacing expression is never replaced again
+struct VarReplacer : public ir::IRMutator<> {
+  explicit VarReplacer(const std::map<std::string, Expr>& replacements) : replacements_(replacements) {}
+
+  void operator()(Expr* expr) { ir::IRMutator<>::Visit(expr, expr); }
+
+  void Visit(const ir::_Var_* op, Expr* expr) override {
+    auto it = replacements_.find(op->name);
+    if (it != replacements_.end()) {
+      *expr = optim::IRCopy(it->second);
+    }
+  }
+
+  const std::map<std::string, Expr>& replacements_;
+};
+
+Expr ReplaceVars(const Expr& expr, const std::map<std::string, Expr>& replacements) {
+  Expr copied = optim::IRCopy(expr);
+  VarReplacer replacer(replacements);
+  replacer(&copied);
+  return copied;
+}
+
+// Skip the blocks of a single statement, the lowering and the schedule primitives insert them freely
+Expr StripBlock(Expr expr) {
+  while (expr.As<ir::Block>() && expr.As<ir::Block>()->stmts.size() == 1) {
+    expr = expr.As<ir::Block>()->stmts.front();
+  }
+  return expr;
+}
+
+// The tensors of a reduction, such as C and C__reduce_init, are different tensors sharing the same buffer
+std::string BufferName(const Tensor& tensor) { return tensor->buffer.defined() ? tensor->buffer->name : tensor->name; }
+
+bool IsEqual(const Expr& lhs, const Expr& rhs) { return common::is_zero(common::AutoSimplify(lhs - rhs)); }
+
+class TensorIntrinsicMatcher {
+ public:
+  explicit TensorIntrinsicMatcher(const TensorIntrinsic& intrinsic) : intrinsic_(intrinsic) {
+    for (const Var& var : intrinsic.extent_vars) {
+      extent_var_names_.insert(var->name);
+    }
+  }
+
+  Expr Match(const Expr& loop) {
+    if (!MatchStmt(intrinsic_.description, loop)) {
+      return Expr();
+    }
+
+    std::vector<Expr> args;
+    for (const Tensor& operand : intrinsic_.operands) {
+      CHECK(tensor_map_.count(operand->name))
+          << "The operand " << operand->name << " is not accessed in the description of " << intrinsic_.name;
+      const Tensor& tensor = tensor_map_.at(operand->name);
+      const auto& offsets  = offsets_.at(operand->name);
+      Expr offset(0);
+      for (int i = 0; i < offsets.size(); ++i) {
+        offset = offset * tensor->shape[i] + offsets[i];
+      }
+      args.emplace_back(tensor);
+      args.push_back(common::AutoSimplify(offset));
+      args.push_back(tensor->shape.back());
+    }
+    for (const Var& var : intrinsic_.extent_vars) {
+      CHECK(var_map_.count(var->name))
+          << "The extent variable " << var->name << " is not used in the description of " << intrinsic_.name;
+      args.push_back(var_map_.at(var->name));
+    }
+    args.insert(args.end(), intrinsic_.extra_args.begin(), intrinsic_.extra_args.end());
+    return ir::Call::Make(Void(), intrinsic_.func_name, args, {}, ir::CallType::Extern, ir::FunctionRef(), 0);
+  }
+
+ private:
+  bool MatchStmt(const Expr& pattern_stmt, const Expr& actual_stmt) {
+    Expr pattern = StripBlock(pattern_stmt);
+    Expr actual  = StripBlock(actual_stmt);
+    // match the body of a schedule block with its iter vars replaced by the iter values
+    if (auto* realize = actual.As<ir::ScheduleBlockRealize>()) {
+      auto* block = realize->schedule_block.As<ir::ScheduleBlock>();
+      std::map<std::string, Expr> iter_values;
+      for (int i = 0; i < block->iter_vars.size(); ++i) {
+        iter_values[block->iter_vars[i]->name] = realize->iter_values[i];
+      }
+      return MatchStmt(pattern, ReplaceVars(block->body, iter_values));
+    }
+
+    if (auto* pattern_for = pattern.As<ir::For>()) {
+      auto* actual_for = actual.As<ir::For>();
+      if (!actual_for || !common::is_zero(actual_for->min) || actual_for->is_parallel() ||
+          actual_for->is_vectorized() || actual_for->is_binded()) {
+        return false;
+      }
+      auto* extent_var = pattern_for->extent.as_var();
+      if (extent_var && extent_var_names_.count(extent_var->name)) {
+        if (ContainsInnerVar(actual_for->extent) ||
+            (var_map_.count(extent_var->name) && !IsEqual(var_map_.at(extent_var->name), actual_for->extent))) {
+          return false;
+        }
+        var_map_[extent_var->name] = actual_for->extent;
+      } else if (!IsEqual(pattern_for->extent, actual_for->extent)) {
+        return false;
+      }
+      var_map_[pattern_for->loop_var->name] = Expr(actual_for->loop_var);
+      inner_vars_.insert(actual_for->loop_var->name);
+      return MatchStmt(pattern_for->body, actual_for->body);
+    }
+
+    if (auto* pattern_block = pattern.As<ir::Block>()) {
+      auto* actual_block = actual.As<ir::Block>();
+      if (!actual_block || actual_block->stmts.size() != pattern_block->stmts.size()) {
+        return false;
+      }
+      for (int i = 0; i < pattern_block->stmts.size(); ++i) {
+        if (!MatchStmt(pattern_block->stmts[i], actual_block->stmts[i])) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    if (auto* pattern_store = pattern.As<ir::Store>()) {
+      auto* actual_store = actual.As<ir::Store>();
+      return actual_store &&
+             MatchAccess(pattern_store->tensor, pattern_store->indices, actual_store->tensor, actual_store->indices) &&
+             MatchValue(pattern_store->value, actual_store->value);
+    }
+    return false;
+  }
+
+  bool MatchValue(const Expr& pattern, const Expr& actual) {
+    if (pattern.type() != actual.type()) {
+      return false;
+    }
+    if (pattern.is_constant()) {
+      return actual.is_constant() && pattern.get_constant() == actual.get_constant();
+    }
+    if (auto* pattern_load = pattern.As<ir::Load>()) {
+      auto* actual_load = actual.As<ir::Load>();
+      return actual_load &&
+             MatchAccess(pattern_load->tensor, pattern_load->indices, actual_load->tensor, actual_load->indices);
+    }
+    if (auto* pattern_cast = pattern.As<ir::Cast>()) {
+      auto* actual_cast = actual.As<ir::Cast>();
+      return actual_cast && MatchValue(pattern_cast->v(), actual_cast->v());
+    }
+    if (auto* pattern_add = pattern.As<ir::Add>()) {
+      auto* actual_add = actual.As<ir::Add>();
+      return actual_add && MatchCommutative(pattern_add->a(), pattern_add->b(), actual_add->a(), actual_add->b());
+    }
+    if (auto* pattern_mul = pattern.As<ir::Mul>()) {
+      auto* actual_mul = actual.As<ir::Mul>();
+      return actual_mul && MatchCommutative(pattern_mul->a(), pattern_mul->b(), actual_mul->a(), actual_mul->b());
+    }
+    return false;
+  }
+
+  bool MatchCommutative(const Expr& pattern_a, const Expr& pattern_b, const Expr& actual_a, const Expr& actual_b) {
+    auto tensor_map = tensor_map_;
+    auto offsets    = offsets_;
+    if (MatchValue(pattern_a, actual_a) && MatchValue(pattern_b, actual_b)) {
+      return true;
+    }
+    // drop the operands matched by the failed attempt before trying the swapped one
+    tensor_map_ = tensor_map;
+    offsets_    = offsets;
+    return MatchValue(pattern_a, actual_b) && MatchValue(pattern_b, actual_a);
+  }
+
+  // The actual access must be the access in the description with the loop variables mapped, shifted by an offset
+  // invariant in the matched loop nest. The indices of the description are aligned to the last dimensions of the
+  // actual tensor, and the leading dimensions of it must be invariant too.
+  bool MatchAccess(const Expr& pattern_tensor_expr,
+                   const std::vector<Expr>& pattern_indices,
+                   const Expr& actual_tensor_expr,
+                   const std::vector<Expr>& actual_indices) {
+    auto* pattern_tensor = pattern_tensor_expr.as_tensor();
+    auto* actual_tensor  = actual_tensor_expr.as_tensor();
+    if (!pattern_tensor || !actual_tensor || pattern_tensor->type() != actual_tensor->type() ||
+        actual_indices.size() < pattern_indices.size()) {
+      return false;
+    }
+    const std::string& name = pattern_tensor->name;
+    if (tensor_map_.count(name) && BufferName(tensor_map_.at(name)) != BufferName(actual_tensor_expr.as_tensor_ref())) {
+      return false;
+    }
+
+    std::map<std::string, Expr> zeros;
+    for (const std::string& var_name : inner_vars_) {
+      zeros[var_name] = Expr(0);
+    }
+    int num_leading_dims = actual_indices.size() - pattern_indices.size();
+    std::vector<Expr> offsets;
+    for (int i = 0; i < actual_indices.size(); ++i) {
+      Expr shift = actual_indices[i];
+      if (i >= num_leading_dims) {
+        shift = common::AutoSimplify(actual_indices[i] - ReplaceVars(pattern_indices[i - num_leading_dims], var_map_));
+      }
+      if (ContainsInnerVar(shift)) {
+        return false;
+      }
+      offsets.push_back(common::AutoSimplify(ReplaceVars(actual_indices[i], zeros)));
+    }
+
+    if (offsets_.count(name)) {
+      for (int i = 0; i < offsets.size(); ++i) {
+        if (!IsEqual(offsets_.at(name)[i], offsets[i])) {
+          return false;
+        }
+      }
+    } else {
+      tensor_map_[name] = actual_tensor_expr.as_tensor_ref();
+      offsets_[name]    = offsets;
+    }
+    return true;
+  }
+
+  bool ContainsInnerVar(const Expr& expr) const {
+    return !ir::CollectIRNodesWithoutTensor(expr, [&](const Expr* x) {
+              return x->as_var() && inner_vars_.count(x->as_var()->name);
+            }).empty();
+  }
+
+  const TensorIntrinsic& intrinsic_;
+  std::set<std::string> extent_var_names_;
+  // the actual loop variables and extents matched by the variables of the description
+  std::map<std::string, Expr> var_map_;
+  // the names of the loop variables in the matched loop nest
+  std::set<std::string> inner_vars_;
+  // the actual tensor and the offsets of the tile in it matched by each operand
+  std::map<std::string, Tensor> tensor_map_;
+  std::map<std::string, std::vector<Expr>> offsets_;
+};
+
+// Register the tile of GEMM C[i, j] = init + sum_k A[i, k] * B[k, j] of extents [m, n] and any reduction extent, the
+// init is C[i, j] itself if `accumulate` is true, otherwise 0. The inputs are cast to the type of C if they differ.
+void RegisterGemmTile(TensorIntrinsicRegistry* registry,
+                      const std::string& name,
+                      const std::string& func_name,
+                      int m,
+                      int n,
+                      const Type& input_type,
+                      const Type& output_type,
+                      bool accumulate) {
+  Var i("i"), j("j"), k("k"), reduce_extent("K");
+  Tensor A = lang::CreatePlaceHolder({Expr(m), Expr(reduce_extent)}, input_type, "A");
+  Tensor B = lang::CreatePlaceHolder({Expr(reduce_extent), Expr(n)}, input_type, "B");
+  Tensor C = lang::CreatePlaceHolder({Expr(m), Expr(n)}, output_type, "C");
+
+  Expr a = A(Expr(i), Expr(k));
+  Expr b = B(Expr(k), Expr(j));
+  if (input_type != output_type) {
+    a = ir::Cast::Make(output_type, a);
+    b = ir::Cast::Make(output_type, b);
+  }
+  Expr update = ir::Store::Make(C, C(Expr(i), Expr(j)) + a * b, {Expr(i), Expr(j)});
+  Expr k_loop = ir::For::Make(
+      k, Expr(0), Expr(reduce_extent), ForType::Serial, DeviceAPI::Host, ir::Block::Make({update}));
+
+  std::vector<Expr> stmts;
+  if (!accumulate) {
+    stmts.push_back(ir::Store::Make(C, common::make_const(output_type, 0), {Expr(i), Expr(j)}));
+  }
+  stmts.push_back(k_loop);
+  Expr j_loop = ir::For::Make(j, Expr(0), Expr(n), ForType::Serial, DeviceAPI::Host, ir::Block::Make(stmts));
+  Expr i_loop = ir::For::Make(i, Expr(0), Expr(m), ForType::Serial, DeviceAPI::Host, ir::Block::Make({j_loop}));
+
+  registry->Register(name)
+      .set_description(i_loop, {A, B, C}, {reduce_extent})
+      .set_func_name(func_name, {Expr(static_cast<int>(accumulate))});
+}
+
+}  // namespace
+
+Expr TensorIntrinsic::Match(const Expr& loop) const { return TensorIntrinsicMatcher(*this).Match(loop); }
+
+const TensorIntrinsic* TensorIntrinsicRegistry::Get(const std::string& name) {
+  const TensorIntrinsic* intrinsic = Find(name);
+  CHECK(intrinsic) << "The tensor intrinsic " << name << " is not registered";
+  return intrinsic;
+}
+
+TensorIntrinsicRegistry::TensorIntrinsicRegistry() {
+  // 6x16 fp32 is the tile of the classic AVX2 sgemm micro-kernel: the 12 accumulators of 8 lanes, 2 vectors of the
+  // row of B and the broadcast of A take 15 of the 16 ymm registers. The `_update` variants accumulate to C without
+  // initializing it, they match the reduction whose init is decomposed out of the loop nest.
+  RegisterGemmTile(this, "gemm_6x16_fp32", "cinn_host_gemm_6x16_fp32", 6, 16, Float(32), Float(32), false);
+  RegisterGemmTile(this, "gemm_6x16_fp32_update", "cinn_host_gemm_6x16_fp32", 6, 16, Float(32), Float(32), true);
+  // 4x16 int8 with the products accumulated in int32, the tile of the int8 dot-product micro-kernels
+  RegisterGemmTile(this, "dot_4x16_int8", "cinn_host_dot_4x16_int8", 4, 16, Int(8), Int(32), false);
+  RegisterGemmTile(this, "dot_4x16_int8_update", "cinn_host_dot_4x16_int8", 4, 16, Int(8), Int(32), true);
+}
+
+}  // namespace ir
+}  // namespace cinn
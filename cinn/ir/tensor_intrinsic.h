@@ -0,0 +1,84 @@
+// Copyright (c) 2023 CINN Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "cinn/common/macros.h"
+#include "cinn/ir/ir.h"
+#include "cinn/ir/tensor.h"
+#include "cinn/utils/registry.h"
+
+namespace cinn {
+namespace ir {
+
+// A tensor intrinsic is a small loop nest that can be replaced by a call to a hand-optimized function, such as the
+// register-blocked tile of GEMM. The computation is described by the pattern IR `description`: a nest of serial loops
+// over the stores to the placeholder tensors in `operands`, the extents of the loops are constants or the variables
+// in `extent_vars`, which match any extent.
+//
+// The replacing extern function is called with the buffer, the element offset of the tile and the leading dimension
+// of each operand in order, followed by the matched extents of `extent_vars` in order and `extra_args`. The operands
+// of a description are 2-D and the last dimension of each matched tensor must be contiguous.
+struct TensorIntrinsic {
+  std::string name;
+  Expr description;
+  std::vector<Tensor> operands;
+  std::vector<Var> extent_vars;
+  std::string func_name;
+  std::vector<Expr> extra_args;
+
+  inline TensorIntrinsic& set_description(const Expr& description,
+                                          const std::vector<Tensor>& operands,
+                                          const std::vector<Var>& extent_vars = {}) {
+    this->description = description;
+    this->operands    = operands;
+    this->extent_vars = extent_vars;
+    return *this;
+  }
+
+  inline TensorIntrinsic& set_func_name(const std::string& func_name, const std::vector<Expr>& extra_args = {}) {
+    this->func_name  = func_name;
+    this->extra_args = extra_args;
+    return *this;
+  }
+
+  // Match the loop nest rooted at `loop` against the description structurally, that is the loops, the stores and the
+  // loaded values are the same up to the renaming of loop variables and tensors, and every access to an operand is the
+  // access in the description shifted by an offset that is invariant in the loop nest. Return the call replacing the
+  // loop nest if it matches, otherwise an undefined Expr.
+  Expr Match(const Expr& loop) const;
+};
+
+// A registry of the tensor intrinsics, the built-in host micro-kernels are registered on creation
+class TensorIntrinsicRegistry : public Registry<TensorIntrinsic> {
+ public:
+  static TensorIntrinsicRegistry* Global() {
+    static TensorIntrinsicRegistry x;
+    return &x;
+  }
+
+  TensorIntrinsic& Register(const std::string& name) { return __REGISTER__(name); }
+
+  const TensorIntrinsic* Get(const std::string& name);
+
+ private:
+  TensorIntrinsicRegistry();
+  CINN_DISALLOW_COPY_AND_ASSIGN(TensorIntrinsicRegistry);
+};
+
+}  // namespace ir
+}  // namespace cinn
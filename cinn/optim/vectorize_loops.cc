@@ -31,8 +31,10 @@
 #include "cinn/optim/ir_copy.h"
 #include "cinn/optim/ir_replace.h"
 #include "cinn/optim/ir_simplify.h"
+#include "cinn/optim/replace_var_with_expr.h"
 #include "cinn/optim/tensor_write_tell.h"
 #include "cinn/optim/unroll_loops.h"
+#include "cinn/runtime/intrinsic.h"
 #include "cinn/utils/functional.h"
 
 namespace cinn {
@@ -451,6 +453,11 @@ class Vectorizer : public IRMutator<Expr *> {
   }
 
   void Visit(const Call *op, Expr *expr) override {
+    // a prefetch is issued once per vector, for the element of its first lane
+    if (op->name == runtime::intrinsic::prefetch) {
+      ReplaceVarWithExpr(expr, var, make_const(var->type(), 0));
+      return;
+    }
     std::vector<Expr> read_args  = op->read_args;
     std::vector<Expr> write_args = op->write_args;
     auto *node                   = expr->As<Call>();
@@ -507,6 +514,24 @@ class Vectorizer : public IRMutator<Expr *> {
 
   void Visit(const For *op, Expr *expr) override { ir::IRMutator<>::Visit(op, expr); }
 
+  void Visit(const ScheduleBlockRealize *op, Expr *expr) override {
+    auto *node  = expr->As<ScheduleBlockRealize>();
+    auto *block = node->schedule_block.As<ScheduleBlock>();
+    CHECK(block);
+    CHECK_EQ(node->iter_values.size(), block->iter_vars.size());
+    // The loads and stores in the block body are indexed by the block vars, substitute the block vars bound to the
+    // vectorized var with their values so that the body is widened here rather than left scalar until the schedule
+    // block is removed.
+    for (int i = 0; i < node->iter_values.size(); ++i) {
+      auto vars = ir::CollectIRNodes(node->iter_values[i],
+                                     [&](const Expr *x) { return x->as_var() && x->as_var()->name == var->name; });
+      if (!vars.empty()) {
+        ReplaceVarWithExpr(&block->body, block->iter_vars[i], IRCopy(node->iter_values[i]));
+      }
+    }
+    ir::IRMutator<>::Visit(op, expr);
+  }
+
   void Scalarize(Expr *expr) {
     Var idx(var->name + "_s", Int(32));
     std::map<const ir::_Var_ *, Expr> var_map;
@@ -494,6 +494,25 @@ void BindFrontend(pybind11::module *m) {
       .def("top_k", &NetBuilder::TopK, py::arg("x"), py::arg("k"), py::arg("axis"), py::arg("largest"))
       .def("sort", &NetBuilder::Sort, py::arg("operand"), py::arg("axis"), py::arg("is_ascend"))
       .def("argsort", &NetBuilder::ArgSort, py::arg("operand"), py::arg("axis"), py::arg("is_ascend"))
+      .def("scan",
+           &NetBuilder::Scan,
+           py::arg("x"),
+           py::arg("axis"),
+           py::arg("scan_type") = "sum",
+           py::arg("exclusive") = false,
+           py::arg("reverse")   = false)
+      .def("cumsum",
+           &NetBuilder::Cumsum,
+           py::arg("x"),
+           py::arg("axis"),
+           py::arg("exclusive") = false,
+           py::arg("reverse")   = false)
+      .def("cumprod",
+           &NetBuilder::Cumprod,
+           py::arg("x"),
+           py::arg("axis"),
+           py::arg("exclusive") = false,
+           py::arg("reverse")   = false)
       .def("slice",
            &NetBuilder::Slice,
            py::arg("x"),
@@ -643,6 +662,19 @@ void BindFrontend(pybind11::module *m) {
            py::arg("axes")        = std::vector<int>{-1},
            py::arg("mode")        = "fast",
            py::arg("data_format") = "AnyLayout")
+      .def("layer_norm",
+           &NetBuilder::LayerNorm,
+           py::arg("x"),
+           py::arg("scale"),
+           py::arg("bias"),
+           py::arg("epsilon")         = 1e-5f,
+           py::arg("begin_norm_axis") = 1)
+      .def("rms_norm",
+           &NetBuilder::RmsNorm,
+           py::arg("x"),
+           py::arg("scale"),
+           py::arg("epsilon")         = 1e-6f,
+           py::arg("begin_norm_axis") = -1)
       .def("dropout_infer",
            &NetBuilder::DropoutInfer,
            py::arg("x"),
@@ -671,6 +703,33 @@ void BindFrontend(pybind11::module *m) {
            py::arg("output_shape")      = std::vector<int>{})
       .def("cast", &NetBuilder::Cast, py::arg("x"), py::arg("dtype"))
       .def("bitcast_convert", &NetBuilder::BitcastConvert, py::arg("x"), py::arg("dtype"))
+      .def("quantize",
+           &NetBuilder::Quantize,
+           py::arg("x"),
+           py::arg("scale"),
+           py::arg("zero_point") = 0,
+           py::arg("dtype")      = "int8")
+      .def("dequantize",
+           &NetBuilder::Dequantize,
+           py::arg("x"),
+           py::arg("scale"),
+           py::arg("zero_point") = 0,
+           py::arg("dtype")      = "float32")
+      .def("requantize",
+           &NetBuilder::Requantize,
+           py::arg("x"),
+           py::arg("input_scale"),
+           py::arg("output_scale"),
+           py::arg("zero_point") = 0,
+           py::arg("dtype")      = "int8")
+      .def("matmul_int8", &NetBuilder::MatmulInt8, py::arg("x"), py::arg("y"), py::arg("trans_y") = false)
+      .def("conv2d_int8",
+           &NetBuilder::Conv2dInt8,
+           py::arg("x"),
+           py::arg("weights"),
+           py::arg("strides")   = std::vector<int>{1, 1},
+           py::arg("paddings")  = std::vector<int>{0, 0},
+           py::arg("dilations") = std::vector<int>{1, 1})
       .def("arange", &NetBuilder::Arange, py::arg("start"), py::arg("stop"), py::arg("step"), py::arg("dtype"))
       .def("gather_nd", &NetBuilder::GatherNd, py::arg("x"), py::arg("index"))
       .def("cbrt", &NetBuilder::Cbrt, py::arg("x"))
@@ -17,6 +17,18 @@
 #include <glog/logging.h>
 #include <math.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#ifdef CINN_USE_OPENMP
+#include <omp.h>
+#endif  // CINN_USE_OPENMP
+
 #include "cinn/backends/extern_func_jit_register.h"
 #include "cinn/backends/function_prototype.h"
 #include "cinn/common/target.h"
@@ -26,8 +38,731 @@
 #include "cinn/runtime/cpu/mkl_math.h"
 #endif
 
+namespace {
+
+// Map a value to an unsigned key whose natural order is the ascending order of the value, so that every supported
+// type can be radix sorted, and the comparison sort / selection share the same total order (NaN sorts last).
+template <typename T>
+struct OrderedKey {
+  using KeyT = typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type;
+  static constexpr KeyT kSignBit = KeyT(1) << (sizeof(T) * 8 - 1);
+
+  static inline KeyT Get(T value) {
+    KeyT bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    if (std::is_floating_point<T>::value) {
+      return (bits & kSignBit) ? ~bits : (bits | kSignBit);
+    }
+    return bits ^ kSignBit;
+  }
+};
+
+// Rows shorter than this are sorted by std::stable_sort, the histogram passes of radix sort do not pay off for them.
+constexpr int kRadixSortMinSize = 256;
+
+// Sort the rows of a [outer, axis_size, inner] array along the middle axis. All the sorts are stable, so the equal
+// elements keep their original order whatever the sort direction is.
+template <typename T>
+class HostRowSorter {
+ public:
+  using KeyT = typename OrderedKey<T>::KeyT;
+
+  explicit HostRowSorter(int axis_size) : keys_(axis_size), index_(axis_size) {
+    if (axis_size >= kRadixSortMinSize) {
+      tmp_keys_.resize(axis_size);
+      tmp_index_.resize(axis_size);
+    }
+  }
+
+  // Load the row starting at `begin` with `stride`, the keys are negated for descending order.
+  void Load(const T* data, int64_t begin, int stride, bool is_ascend) {
+    int n = keys_.size();
+    for (int i = 0; i < n; ++i) {
+      KeyT key  = OrderedKey<T>::Get(data[begin + static_cast<int64_t>(i) * stride]);
+      keys_[i]  = is_ascend ? key : ~key;
+      index_[i] = i;
+    }
+  }
+
+  // Sort the whole row, return the sorted positions.
+  const std::vector<int>& Sort() {
+    if (keys_.size() >= kRadixSortMinSize) {
+      RadixSort();
+    } else {
+      std::stable_sort(index_.begin(), index_.end(), [this](int a, int b) { return keys_[a] < keys_[b]; });
+    }
+    return index_;
+  }
+
+  // Select the first k positions of the sorted row in O(n + k * log(k)).
+  const std::vector<int>& SelectTopK(int k) {
+    if (k >= static_cast<int>(keys_.size())) {
+      return Sort();
+    }
+    // break the ties by position to keep the same order as the stable sort
+    auto less = [this](int a, int b) { return keys_[a] < keys_[b] || (keys_[a] == keys_[b] && a < b); };
+    std::nth_element(index_.begin(), index_.begin() + k, index_.end(), less);
+    std::sort(index_.begin(), index_.begin() + k, less);
+    return index_;
+  }
+
+ private:
+  // LSD radix sort with 8-bit digits, the passes whose digits are all the same are skipped.
+  void RadixSort() {
+    constexpr int kRadixBits = 8;
+    constexpr int kBuckets   = 1 << kRadixBits;
+    int n                    = keys_.size();
+    // the keys are moved along with the positions, so that every pass streams through contiguous memory
+    for (int shift = 0; shift < static_cast<int>(sizeof(KeyT) * 8); shift += kRadixBits) {
+      int count[kBuckets] = {0};
+      for (int i = 0; i < n; ++i) {
+        ++count[(keys_[i] >> shift) & (kBuckets - 1)];
+      }
+      if (count[(keys_[0] >> shift) & (kBuckets - 1)] == n) {
+        continue;
+      }
+      int offset = 0;
+      for (int b = 0; b < kBuckets; ++b) {
+        int c    = count[b];
+        count[b] = offset;
+        offset += c;
+      }
+      for (int i = 0; i < n; ++i) {
+        int pos         = count[(keys_[i] >> shift) & (kBuckets - 1)]++;
+        tmp_keys_[pos]  = keys_[i];
+        tmp_index_[pos] = index_[i];
+      }
+      std::swap(keys_, tmp_keys_);
+      std::swap(index_, tmp_index_);
+    }
+  }
+
+  std::vector<KeyT> keys_;
+  std::vector<int> index_;
+  std::vector<KeyT> tmp_keys_;
+  std::vector<int> tmp_index_;
+};
+
+// Launch `row_func(sorter, row_begin)` for every row of a [outer, axis_size, inner] array, rows run in parallel.
+template <typename T, typename RowFunc>
+void ForEachSortRow(int outer, int axis_size, int inner, RowFunc&& row_func) {
+  int64_t num_rows = static_cast<int64_t>(outer) * inner;
+#ifdef CINN_USE_OPENMP
+#pragma omp parallel if (num_rows > 1)
+#endif  // CINN_USE_OPENMP
+  {
+    HostRowSorter<T> sorter(axis_size);
+#ifdef CINN_USE_OPENMP
+#pragma omp for schedule(static)
+#endif  // CINN_USE_OPENMP
+    for (int64_t row = 0; row < num_rows; ++row) {
+      int64_t o = row / inner, i = row % inner;
+      row_func(&sorter, o * axis_size * inner + i);
+    }
+  }
+}
+
+template <typename T>
+void HostSort(const cinn_buffer_t* x, cinn_buffer_t* out, int outer, int axis_size, int inner, bool is_ascend) {
+  const T* x_data = reinterpret_cast<const T*>(x->memory);
+  T* out_data     = reinterpret_cast<T*>(out->memory);
+  ForEachSortRow<T>(outer, axis_size, inner, [&](HostRowSorter<T>* sorter, int64_t begin) {
+    sorter->Load(x_data, begin, inner, is_ascend);
+    const auto& index = sorter->Sort();
+    for (int j = 0; j < axis_size; ++j) {
+      out_data[begin + static_cast<int64_t>(j) * inner] = x_data[begin + static_cast<int64_t>(index[j]) * inner];
+    }
+  });
+}
+
+template <typename T>
+void HostArgSort(const cinn_buffer_t* x,
+                 cinn_buffer_t* out_index,
+                 cinn_buffer_t* out_rank,
+                 int outer,
+                 int axis_size,
+                 int inner,
+                 bool is_ascend) {
+  const T* x_data    = reinterpret_cast<const T*>(x->memory);
+  int32_t* idx_data  = reinterpret_cast<int32_t*>(out_index->memory);
+  int32_t* rank_data = out_rank ? reinterpret_cast<int32_t*>(out_rank->memory) : nullptr;
+  ForEachSortRow<T>(outer, axis_size, inner, [&](HostRowSorter<T>* sorter, int64_t begin) {
+    sorter->Load(x_data, begin, inner, is_ascend);
+    const auto& index = sorter->Sort();
+    for (int j = 0; j < axis_size; ++j) {
+      idx_data[begin + static_cast<int64_t>(j) * inner] = index[j];
+    }
+    if (rank_data) {
+      for (int j = 0; j < axis_size; ++j) {
+        rank_data[begin + static_cast<int64_t>(index[j]) * inner] = j;
+      }
+    }
+  });
+}
+
+template <typename T>
+void HostTopK(const cinn_buffer_t* x,
+              cinn_buffer_t* out_value,
+              cinn_buffer_t* out_index,
+              int outer,
+              int axis_size,
+              int inner,
+              int k,
+              bool largest) {
+  const T* x_data     = reinterpret_cast<const T*>(x->memory);
+  T* value_data       = reinterpret_cast<T*>(out_value->memory);
+  int64_t* index_data = reinterpret_cast<int64_t*>(out_index->memory);
+  k                   = std::min(k, axis_size);
+  ForEachSortRow<T>(outer, axis_size, inner, [&](HostRowSorter<T>* sorter, int64_t begin) {
+    sorter->Load(x_data, begin, inner, !largest);
+    const auto& index = sorter->SelectTopK(k);
+    // the output row has k elements along the axis
+    int64_t out_begin = (begin / (static_cast<int64_t>(axis_size) * inner)) * k * inner + begin % inner;
+    for (int j = 0; j < k; ++j) {
+      value_data[out_begin + static_cast<int64_t>(j) * inner] = x_data[begin + static_cast<int64_t>(index[j]) * inner];
+      index_data[out_begin + static_cast<int64_t>(j) * inner] = index[j];
+    }
+  });
+}
+
+// The binary operators of scan, `Init` is the identity, which is the first element of an exclusive scan.
+template <typename T>
+struct ScanSum {
+  static inline T Init() { return T(0); }
+  static inline T Apply(T a, T b) { return a + b; }
+};
+template <typename T>
+struct ScanProd {
+  static inline T Init() { return T(1); }
+  static inline T Apply(T a, T b) { return a * b; }
+};
+// the identities of max and min are the same as the initial values of `ReduceMax` and `ReduceMin`
+template <typename T>
+struct ScanMax {
+  static inline T Init() { return std::numeric_limits<T>::lowest(); }
+  static inline T Apply(T a, T b) { return a > b ? a : b; }
+};
+template <typename T>
+struct ScanMin {
+  static inline T Init() { return std::numeric_limits<T>::max(); }
+  static inline T Apply(T a, T b) { return a < b ? a : b; }
+};
+
+// A long row is split into blocks of at least this size to be scanned by several threads.
+constexpr int64_t kScanMinBlockSize = 4096;
+
+// Scan `n` elements of a row with the stride `stride` (negative for the reverse scan) starting from `init`,
+// `init` is the accumulation of the elements before the row.
+template <typename T, typename Op>
+inline void ScanRow(const T* x, T* out, int64_t n, int64_t stride, T init, bool exclusive) {
+  T acc = init;
+  for (int64_t p = 0; p < n; ++p) {
+    T value = x[p * stride];
+    if (exclusive) {
+      out[p * stride] = acc;
+      acc             = Op::Apply(acc, value);
+    } else {
+      acc             = Op::Apply(acc, value);
+      out[p * stride] = acc;
+    }
+  }
+}
+
+// Scan a single contiguous row with a blocked parallel scan: every thread reduces its block, the block sums are
+// scanned serially, then every thread scans its block again starting from the sum of the blocks before it.
+template <typename T, typename Op>
+void BlockedScanRow(const T* x, T* out, int64_t n, bool exclusive, bool reverse) {
+  int num_blocks = 1;
+#ifdef CINN_USE_OPENMP
+  num_blocks = static_cast<int>(std::min<int64_t>(omp_get_max_threads(), n / kScanMinBlockSize));
+#endif  // CINN_USE_OPENMP
+  if (num_blocks <= 1) {
+    if (reverse) {
+      ScanRow<T, Op>(x + n - 1, out + n - 1, n, -1, Op::Init(), exclusive);
+    } else {
+      ScanRow<T, Op>(x, out, n, 1, Op::Init(), exclusive);
+    }
+    return;
+  }
+  int64_t block_size = (n + num_blocks - 1) / num_blocks;
+  // the position p of the scan order is the element p of the row, or n - 1 - p if reversed
+  auto block_ptr = [&](auto* base, int b) {
+    int64_t begin = b * block_size;
+    return reverse ? base + n - 1 - begin : base + begin;
+  };
+  auto block_len = [&](int b) { return std::min(block_size, n - b * block_size); };
+  int64_t stride = reverse ? -1 : 1;
+
+  std::vector<T> block_sums(num_blocks, Op::Init());
+#ifdef CINN_USE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(num_blocks)
+#endif  // CINN_USE_OPENMP
+  for (int b = 0; b < num_blocks - 1; ++b) {
+    const T* bx = block_ptr(x, b);
+    T acc       = Op::Init();
+    for (int64_t p = 0, len = block_len(b); p < len; ++p) {
+      acc = Op::Apply(acc, bx[p * stride]);
+    }
+    block_sums[b] = acc;
+  }
+  T carry = Op::Init();
+  for (int b = 0; b < num_blocks; ++b) {
+    T sum         = block_sums[b];
+    block_sums[b] = carry;
+    carry         = Op::Apply(carry, sum);
+  }
+#ifdef CINN_USE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(num_blocks)
+#endif  // CINN_USE_OPENMP
+  for (int b = 0; b < num_blocks; ++b) {
+    ScanRow<T, Op>(block_ptr(x, b), block_ptr(out, b), block_len(b), stride, block_sums[b], exclusive);
+  }
+}
+
+// Scan a [outer, axis_size, inner] array along the middle axis.
+template <typename T, typename Op>
+void HostScanImpl(const T* x, T* out, int outer, int axis_size, int inner, bool exclusive, bool reverse) {
+  int64_t row_size = static_cast<int64_t>(axis_size) * inner;
+  if (inner == 1) {
+    if (outer == 1) {
+      BlockedScanRow<T, Op>(x, out, axis_size, exclusive, reverse);
+      return;
+    }
+#ifdef CINN_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif  // CINN_USE_OPENMP
+    for (int o = 0; o < outer; ++o) {
+      const T* ox = x + o * row_size;
+      T* oout     = out + o * row_size;
+      if (reverse) {
+        ScanRow<T, Op>(ox + axis_size - 1, oout + axis_size - 1, axis_size, -1, Op::Init(), exclusive);
+      } else {
+        ScanRow<T, Op>(ox, oout, axis_size, 1, Op::Init(), exclusive);
+      }
+    }
+    return;
+  }
+  // the inner elements are contiguous, every step of the scan combines a whole inner row with the previous output
+  // row, the loops over the inner rows are vectorized
+#ifdef CINN_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif  // CINN_USE_OPENMP
+  for (int o = 0; o < outer; ++o) {
+    for (int p = 0; p < axis_size; ++p) {
+      int a        = reverse ? axis_size - 1 - p : p;
+      int prev     = reverse ? a + 1 : a - 1;
+      T* cur_out   = out + o * row_size + static_cast<int64_t>(a) * inner;
+      const T* cur = x + o * row_size + static_cast<int64_t>(a) * inner;
+      if (p == 0) {
+        for (int i = 0; i < inner; ++i) {
+          cur_out[i] = exclusive ? Op::Init() : cur[i];
+        }
+        continue;
+      }
+      const T* prev_out = out + o * row_size + static_cast<int64_t>(prev) * inner;
+      const T* operand  = exclusive ? x + o * row_size + static_cast<int64_t>(prev) * inner : cur;
+      for (int i = 0; i < inner; ++i) {
+        cur_out[i] = Op::Apply(prev_out[i], operand[i]);
+      }
+    }
+  }
+}
+
+template <typename T>
+void HostScan(const cinn_buffer_t* x,
+              cinn_buffer_t* out,
+              int outer,
+              int axis_size,
+              int inner,
+              int scan_type,
+              bool exclusive,
+              bool reverse) {
+  const T* x_data = reinterpret_cast<const T*>(x->memory);
+  T* out_data     = reinterpret_cast<T*>(out->memory);
+  switch (scan_type) {
+    case 0:
+      HostScanImpl<T, ScanSum<T>>(x_data, out_data, outer, axis_size, inner, exclusive, reverse);
+      break;
+    case 1:
+      HostScanImpl<T, ScanProd<T>>(x_data, out_data, outer, axis_size, inner, exclusive, reverse);
+      break;
+    case 2:
+      HostScanImpl<T, ScanMax<T>>(x_data, out_data, outer, axis_size, inner, exclusive, reverse);
+      break;
+    case 3:
+      HostScanImpl<T, ScanMin<T>>(x_data, out_data, outer, axis_size, inner, exclusive, reverse);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported scan type " << scan_type;
+  }
+}
+
+// The number of independent accumulators of a row, the loops over them are vectorized.
+constexpr int kNormLanes = 8;
+
+// The mean and the sum of the squared deviations of a row by Welford's algorithm in one pass. Every lane accumulates
+// the elements at its offset of the chunks of kNormLanes elements, then the lanes and the tail are merged by Chan's
+// formula, which is as stable as the sequential update.
+template <typename T>
+void WelfordRow(const T* x, int64_t n, T* mean, T* m2) {
+  T lane_mean[kNormLanes] = {0};
+  T lane_m2[kNormLanes]   = {0};
+  int64_t num_chunks      = n / kNormLanes;
+  for (int64_t c = 0; c < num_chunks; ++c) {
+    const T* chunk = x + c * kNormLanes;
+    T inv_count    = T(1) / static_cast<T>(c + 1);
+    for (int l = 0; l < kNormLanes; ++l) {
+      T delta      = chunk[l] - lane_mean[l];
+      lane_mean[l] = lane_mean[l] + delta * inv_count;
+      lane_m2[l]   = lane_m2[l] + delta * (chunk[l] - lane_mean[l]);
+    }
+  }
+
+  T row_mean    = 0;
+  T row_m2      = 0;
+  int64_t count = 0;
+  for (int l = 0; l < kNormLanes && num_chunks > 0; ++l) {
+    int64_t total = count + num_chunks;
+    T delta       = lane_mean[l] - row_mean;
+    T weight      = static_cast<T>(num_chunks) / static_cast<T>(total);
+    row_mean      = row_mean + delta * weight;
+    row_m2        = row_m2 + lane_m2[l] + delta * delta * static_cast<T>(count) * weight;
+    count         = total;
+  }
+  for (int64_t i = num_chunks * kNormLanes; i < n; ++i) {
+    ++count;
+    T delta  = x[i] - row_mean;
+    row_mean = row_mean + delta / static_cast<T>(count);
+    row_m2   = row_m2 + delta * (x[i] - row_mean);
+  }
+  *mean = row_mean;
+  *m2   = row_m2;
+}
+
+// Normalize every row of a [rows, cols] array, the statistics of a row are computed in one pass and the row is
+// normalized in the second pass while it is still in the cache.
+template <typename T>
+void HostLayerNorm(const cinn_buffer_t* x,
+                   const cinn_buffer_t* scale,
+                   const cinn_buffer_t* bias,
+                   cinn_buffer_t* y,
+                   cinn_buffer_t* mean,
+                   cinn_buffer_t* variance,
+                   int rows,
+                   int cols,
+                   float epsilon) {
+  const T* x_data     = reinterpret_cast<const T*>(x->memory);
+  const T* scale_data = reinterpret_cast<const T*>(scale->memory);
+  const T* bias_data  = reinterpret_cast<const T*>(bias->memory);
+  T* y_data           = reinterpret_cast<T*>(y->memory);
+  T* mean_data        = reinterpret_cast<T*>(mean->memory);
+  T* variance_data    = reinterpret_cast<T*>(variance->memory);
+#ifdef CINN_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif  // CINN_USE_OPENMP
+  for (int r = 0; r < rows; ++r) {
+    const T* row_x = x_data + static_cast<int64_t>(r) * cols;
+    T* row_y       = y_data + static_cast<int64_t>(r) * cols;
+    T row_mean, row_m2;
+    WelfordRow<T>(row_x, cols, &row_mean, &row_m2);
+    T row_variance = row_m2 / static_cast<T>(cols);
+    T rstd         = T(1) / std::sqrt(row_variance + static_cast<T>(epsilon));
+    for (int c = 0; c < cols; ++c) {
+      row_y[c] = (row_x[c] - row_mean) * rstd * scale_data[c] + bias_data[c];
+    }
+    mean_data[r]     = row_mean;
+    variance_data[r] = row_variance;
+  }
+}
+
+template <typename T>
+void HostRmsNorm(
+    const cinn_buffer_t* x, const cinn_buffer_t* scale, cinn_buffer_t* y, int rows, int cols, float epsilon) {
+  const T* x_data     = reinterpret_cast<const T*>(x->memory);
+  const T* scale_data = reinterpret_cast<const T*>(scale->memory);
+  T* y_data           = reinterpret_cast<T*>(y->memory);
+#ifdef CINN_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif  // CINN_USE_OPENMP
+  for (int r = 0; r < rows; ++r) {
+    const T* row_x = x_data + static_cast<int64_t>(r) * cols;
+    T* row_y       = y_data + static_cast<int64_t>(r) * cols;
+
+    T lane_sum[kNormLanes] = {0};
+    int num_chunks         = cols / kNormLanes;
+    for (int c = 0; c < num_chunks; ++c) {
+      for (int l = 0; l < kNormLanes; ++l) {
+        lane_sum[l] += row_x[c * kNormLanes + l] * row_x[c * kNormLanes + l];
+      }
+    }
+    T sum = 0;
+    for (int l = 0; l < kNormLanes; ++l) {
+      sum += lane_sum[l];
+    }
+    for (int c = num_chunks * kNormLanes; c < cols; ++c) {
+      sum += row_x[c] * row_x[c];
+    }
+    T rstd = T(1) / std::sqrt(sum / static_cast<T>(cols) + static_cast<T>(epsilon));
+    for (int c = 0; c < cols; ++c) {
+      row_y[c] = row_x[c] * rstd * scale_data[c];
+    }
+  }
+}
+
+// Softmax of a [outer, axis_size, inner] array along the middle axis. The max, the exponentials with their sum and the
+// scaling are three passes over a row in the cache, so that every exponential is computed once.
+template <typename T>
+void HostSoftmax(const cinn_buffer_t* x, cinn_buffer_t* out, int outer, int axis_size, int inner) {
+  const T* x_data  = reinterpret_cast<const T*>(x->memory);
+  T* out_data      = reinterpret_cast<T*>(out->memory);
+  int64_t row_size = static_cast<int64_t>(axis_size) * inner;
+  if (inner == 1) {
+#ifdef CINN_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif  // CINN_USE_OPENMP
+    for (int o = 0; o < outer; ++o) {
+      const T* row_x = x_data + o * row_size;
+      T* row_out     = out_data + o * row_size;
+      T max_value    = std::numeric_limits<T>::lowest();
+      for (int a = 0; a < axis_size; ++a) {
+        max_value = row_x[a] > max_value ? row_x[a] : max_value;
+      }
+      T sum = 0;
+      for (int a = 0; a < axis_size; ++a) {
+        row_out[a] = std::exp(row_x[a] - max_value);
+        sum += row_out[a];
+      }
+      T inv_sum = T(1) / sum;
+      for (int a = 0; a < axis_size; ++a) {
+        row_out[a] *= inv_sum;
+      }
+    }
+    return;
+  }
+  // the inner elements are contiguous, every pass processes a whole inner row at a time, which is vectorized
+#ifdef CINN_USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif  // CINN_USE_OPENMP
+  for (int o = 0; o < outer; ++o) {
+    const T* outer_x = x_data + o * row_size;
+    T* outer_out     = out_data + o * row_size;
+    std::vector<T> max_values(outer_x, outer_x + inner);
+    std::vector<T> sums(inner, T(0));
+    for (int a = 1; a < axis_size; ++a) {
+      const T* cur = outer_x + static_cast<int64_t>(a) * inner;
+      for (int i = 0; i < inner; ++i) {
+        max_values[i] = cur[i] > max_values[i] ? cur[i] : max_values[i];
+      }
+    }
+    for (int a = 0; a < axis_size; ++a) {
+      const T* cur = outer_x + static_cast<int64_t>(a) * inner;
+      T* cur_out   = outer_out + static_cast<int64_t>(a) * inner;
+      for (int i = 0; i < inner; ++i) {
+        cur_out[i] = std::exp(cur[i] - max_values[i]);
+        sums[i] += cur_out[i];
+      }
+    }
+    for (int i = 0; i < inner; ++i) {
+      sums[i] = T(1) / sums[i];
+    }
+    for (int a = 0; a < axis_size; ++a) {
+      T* cur_out = outer_out + static_cast<int64_t>(a) * inner;
+      for (int i = 0; i < inner; ++i) {
+        cur_out[i] *= sums[i];
+      }
+    }
+  }
+}
+
+// A [M, N] tile of C = (accumulate ? C : 0) + A * B with the inputs converted to the accumulator type. The whole tile
+// of C is kept in the local accumulators and every step of k is a rank-1 update by a column of A and a row of B, so
+// the compiler keeps the accumulators in the vector registers and the inner loop is N / lanes vector FMAs per row.
+template <typename InT, typename AccT, int M, int N>
+void HostGemmTile(const InT* a, int lda, const InT* b, int ldb, AccT* c, int ldc, int k, bool accumulate) {
+  AccT acc[M][N];
+  for (int i = 0; i < M; ++i) {
+    for (int j = 0; j < N; ++j) {
+      acc[i][j] = accumulate ? c[i * ldc + j] : AccT(0);
+    }
+  }
+  for (int p = 0; p < k; ++p) {
+    const InT* b_row = b + static_cast<int64_t>(p) * ldb;
+    for (int i = 0; i < M; ++i) {
+      AccT a_value = static_cast<AccT>(a[i * lda + p]);
+      for (int j = 0; j < N; ++j) {
+        acc[i][j] += a_value * static_cast<AccT>(b_row[j]);
+      }
+    }
+  }
+  for (int i = 0; i < M; ++i) {
+    for (int j = 0; j < N; ++j) {
+      c[i * ldc + j] = acc[i][j];
+    }
+  }
+}
+
+}  // namespace
+
+#define CINN_HOST_TYPE_DISPATCH(type_code, type_bits, FUNC, ...)                                      \
+  do {                                                                                                \
+    if (type_code == cinn_type_float && type_bits == 32) {                                            \
+      FUNC<float>(__VA_ARGS__);                                                                       \
+    } else if (type_code == cinn_type_float && type_bits == 64) {                                     \
+      FUNC<double>(__VA_ARGS__);                                                                      \
+    } else if (type_code == cinn_type_int && type_bits == 32) {                                       \
+      FUNC<int32_t>(__VA_ARGS__);                                                                     \
+    } else if (type_code == cinn_type_int && type_bits == 64) {                                       \
+      FUNC<int64_t>(__VA_ARGS__);                                                                     \
+    } else {                                                                                          \
+      LOG(FATAL) << "Unsupported data type (code = " << type_code << ", bits = " << type_bits << ")"; \
+    }                                                                                                 \
+  } while (0)
+
 extern "C" {
 
+void cinn_call_sort_host(
+    void* v_args, int num_args, int outer, int axis_size, int inner, bool is_ascend, int type_code, int type_bits) {
+  CHECK_EQ(num_args, 2) << "The sort custom call should have 1 input and 1 output";
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* x       = args[0].operator cinn_buffer_t*();
+  cinn_buffer_t* out     = args[1].operator cinn_buffer_t*();
+  CINN_HOST_TYPE_DISPATCH(type_code, type_bits, HostSort, x, out, outer, axis_size, inner, is_ascend);
+}
+
+void cinn_call_argsort_host(
+    void* v_args, int num_args, int outer, int axis_size, int inner, bool is_ascend, int type_code, int type_bits) {
+  CHECK(num_args == 2 || num_args == 3) << "The argsort custom call should have 1 input and 1 or 2 outputs";
+  cinn_pod_value_t* args  = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* x        = args[0].operator cinn_buffer_t*();
+  cinn_buffer_t* index    = args[1].operator cinn_buffer_t*();
+  cinn_buffer_t* rank     = num_args == 3 ? args[2].operator cinn_buffer_t*() : nullptr;
+  CINN_HOST_TYPE_DISPATCH(type_code, type_bits, HostArgSort, x, index, rank, outer, axis_size, inner, is_ascend);
+}
+
+void cinn_call_top_k_host(void* v_args,
+                          int num_args,
+                          int outer,
+                          int axis_size,
+                          int inner,
+                          int k,
+                          bool largest,
+                          int type_code,
+                          int type_bits) {
+  CHECK_EQ(num_args, 3) << "The top_k custom call should have 1 input and 2 outputs";
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* x       = args[0].operator cinn_buffer_t*();
+  cinn_buffer_t* value   = args[1].operator cinn_buffer_t*();
+  cinn_buffer_t* index   = args[2].operator cinn_buffer_t*();
+  CINN_HOST_TYPE_DISPATCH(type_code, type_bits, HostTopK, x, value, index, outer, axis_size, inner, k, largest);
+}
+
+void cinn_call_scan_host(void* v_args,
+                         int num_args,
+                         int outer,
+                         int axis_size,
+                         int inner,
+                         int scan_type,
+                         bool exclusive,
+                         bool reverse,
+                         int type_code,
+                         int type_bits) {
+  CHECK_EQ(num_args, 2) << "The scan custom call should have 1 input and 1 output";
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* x       = args[0].operator cinn_buffer_t*();
+  cinn_buffer_t* out     = args[1].operator cinn_buffer_t*();
+  CINN_HOST_TYPE_DISPATCH(
+      type_code, type_bits, HostScan, x, out, outer, axis_size, inner, scan_type, exclusive, reverse);
+}
+
+#undef CINN_HOST_TYPE_DISPATCH
+
+#define CINN_HOST_FLOAT_DISPATCH(type_code, type_bits, FUNC, ...)                                     \
+  do {                                                                                                \
+    if (type_code == cinn_type_float && type_bits == 32) {                                            \
+      FUNC<float>(__VA_ARGS__);                                                                       \
+    } else if (type_code == cinn_type_float && type_bits == 64) {                                     \
+      FUNC<double>(__VA_ARGS__);                                                                      \
+    } else {                                                                                          \
+      LOG(FATAL) << "Unsupported data type (code = " << type_code << ", bits = " << type_bits << ")"; \
+    }                                                                                                 \
+  } while (0)
+
+void cinn_call_layer_norm_host(
+    void* v_args, int num_args, int rows, int cols, float epsilon, int type_code, int type_bits) {
+  CHECK_EQ(num_args, 6) << "The layer_norm custom call should have 3 inputs and 3 outputs";
+  cinn_pod_value_t* args  = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* x        = args[0].operator cinn_buffer_t*();
+  cinn_buffer_t* scale    = args[1].operator cinn_buffer_t*();
+  cinn_buffer_t* bias     = args[2].operator cinn_buffer_t*();
+  cinn_buffer_t* y        = args[3].operator cinn_buffer_t*();
+  cinn_buffer_t* mean     = args[4].operator cinn_buffer_t*();
+  cinn_buffer_t* variance = args[5].operator cinn_buffer_t*();
+  CINN_HOST_FLOAT_DISPATCH(type_code, type_bits, HostLayerNorm, x, scale, bias, y, mean, variance, rows, cols, epsilon);
+}
+
+void cinn_call_rms_norm_host(
+    void* v_args, int num_args, int rows, int cols, float epsilon, int type_code, int type_bits) {
+  CHECK_EQ(num_args, 3) << "The rms_norm custom call should have 2 inputs and 1 output";
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* x       = args[0].operator cinn_buffer_t*();
+  cinn_buffer_t* scale   = args[1].operator cinn_buffer_t*();
+  cinn_buffer_t* y       = args[2].operator cinn_buffer_t*();
+  CINN_HOST_FLOAT_DISPATCH(type_code, type_bits, HostRmsNorm, x, scale, y, rows, cols, epsilon);
+}
+
+void cinn_call_softmax_host(
+    void* v_args, int num_args, int outer, int axis_size, int inner, int type_code, int type_bits) {
+  CHECK_EQ(num_args, 2) << "The softmax custom call should have 1 input and 1 output";
+  cinn_pod_value_t* args = static_cast<cinn_pod_value_t*>(v_args);
+  cinn_buffer_t* x       = args[0].operator cinn_buffer_t*();
+  cinn_buffer_t* out     = args[1].operator cinn_buffer_t*();
+  CINN_HOST_FLOAT_DISPATCH(type_code, type_bits, HostSoftmax, x, out, outer, axis_size, inner);
+}
+
+#undef CINN_HOST_FLOAT_DISPATCH
+
+void cinn_host_gemm_6x16_fp32(const cinn_buffer_t* a,
+                              int a_offset,
+                              int lda,
+                              const cinn_buffer_t* b,
+                              int b_offset,
+                              int ldb,
+                              cinn_buffer_t* c,
+                              int c_offset,
+                              int ldc,
+                              int k,
+                              int accumulate) {
+  HostGemmTile<float, float, 6, 16>(reinterpret_cast<const float*>(a->memory) + a_offset,
+                                    lda,
+                                    reinterpret_cast<const float*>(b->memory) + b_offset,
+                                    ldb,
+                                    reinterpret_cast<float*>(c->memory) + c_offset,
+                                    ldc,
+                                    k,
+                                    accumulate);
+}
+
+void cinn_host_dot_4x16_int8(const cinn_buffer_t* a,
+                             int a_offset,
+                             int lda,
+                             const cinn_buffer_t* b,
+                             int b_offset,
+                             int ldb,
+                             cinn_buffer_t* c,
+                             int c_offset,
+                             int ldc,
+                             int k,
+                             int accumulate) {
+  HostGemmTile<int8_t, int32_t, 4, 16>(reinterpret_cast<const int8_t*>(a->memory) + a_offset,
+                                       lda,
+                                       reinterpret_cast<const int8_t*>(b->memory) + b_offset,
+                                       ldb,
+                                       reinterpret_cast<int32_t*>(c->memory) + c_offset,
+                                       ldc,
+                                       k,
+                                       accumulate);
+}
+
 void __cinn_host_tanh_v(const cinn_buffer_t* x, cinn_buffer_t* out) {
   CINN_CHECK_EQ(x->num_elements(), out->num_elements());
   int xn         = x->num_elements();
@@ -446,6 +1181,111 @@ CINN_REGISTER_HELPER(host_intrinsics) {
       .AddInputType<int>()
       .End();
 
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_sort_host, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<int>()    // outer
+      .AddInputType<int>()    // axis_size
+      .AddInputType<int>()    // inner
+      .AddInputType<bool>()   // is_ascend
+      .AddInputType<int>()    // type_code
+      .AddInputType<int>()    // type_bits
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_argsort_host, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<int>()    // outer
+      .AddInputType<int>()    // axis_size
+      .AddInputType<int>()    // inner
+      .AddInputType<bool>()   // is_ascend
+      .AddInputType<int>()    // type_code
+      .AddInputType<int>()    // type_bits
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_top_k_host, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<int>()    // outer
+      .AddInputType<int>()    // axis_size
+      .AddInputType<int>()    // inner
+      .AddInputType<int>()    // k
+      .AddInputType<bool>()   // largest
+      .AddInputType<int>()    // type_code
+      .AddInputType<int>()    // type_bits
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_scan_host, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<int>()    // outer
+      .AddInputType<int>()    // axis_size
+      .AddInputType<int>()    // inner
+      .AddInputType<int>()    // scan_type
+      .AddInputType<bool>()   // exclusive
+      .AddInputType<bool>()   // reverse
+      .AddInputType<int>()    // type_code
+      .AddInputType<int>()    // type_bits
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_layer_norm_host, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<int>()    // rows
+      .AddInputType<int>()    // cols
+      .AddInputType<float>()  // epsilon
+      .AddInputType<int>()    // type_code
+      .AddInputType<int>()    // type_bits
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_rms_norm_host, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<int>()    // rows
+      .AddInputType<int>()    // cols
+      .AddInputType<float>()  // epsilon
+      .AddInputType<int>()    // type_code
+      .AddInputType<int>()    // type_bits
+      .End();
+
+  REGISTER_EXTERN_FUNC_HELPER(cinn_call_softmax_host, host_target)
+      .SetRetType<void>()
+      .AddInputType<void*>()  // v_args
+      .AddInputType<int>()    // num_args
+      .AddInputType<int>()    // outer
+      .AddInputType<int>()    // axis_size
+      .AddInputType<int>()    // inner
+      .AddInputType<int>()    // type_code
+      .AddInputType<int>()    // type_bits
+      .End();
+
+#define _REGISTER_CINN_HOST_GEMM_TILE(fn__)      \
+  REGISTER_EXTERN_FUNC_HELPER(fn__, host_target) \
+      .SetRetType<void>()                        \
+      .AddInputType<cinn_buffer_t*>()            \
+      .AddInputType<int>()                       \
+      .AddInputType<int>()                       \
+      .AddInputType<cinn_buffer_t*>()            \
+      .AddInputType<int>()                       \
+      .AddInputType<int>()                       \
+      .AddInputType<cinn_buffer_t*>()            \
+      .AddInputType<int>()                       \
+      .AddInputType<int>()                       \
+      .AddInputType<int>()                       \
+      .AddInputType<int>()                       \
+      .End();
+
+  _REGISTER_CINN_HOST_GEMM_TILE(cinn_host_gemm_6x16_fp32);
+  _REGISTER_CINN_HOST_GEMM_TILE(cinn_host_dot_4x16_int8);
+
+#undef _REGISTER_CINN_HOST_GEMM_TILE
+
   // TODO(thisjiang): change msg type from 'int' to 'std::string' when custom call support 'std::string' type
   using cinn::runtime::cinn_assert_true_host;
   REGISTER_EXTERN_FUNC_HELPER(cinn_assert_true_host, host_target)
@@ -25,6 +25,82 @@ extern "C" {
 void __cinn_host_tanh_v(const cinn_buffer_t* x, cinn_buffer_t* out);
 //@}
 
+//! sort extern functions called by custom call, the input is viewed as [outer, axis_size, inner] and every row
+//! along the middle axis is sorted in O(n * log(n)), top_k selects the first k of a row in O(n + k * log(k)).
+//@{
+void cinn_call_sort_host(
+    void* v_args, int num_args, int outer, int axis_size, int inner, bool is_ascend, int type_code, int type_bits);
+
+void cinn_call_argsort_host(
+    void* v_args, int num_args, int outer, int axis_size, int inner, bool is_ascend, int type_code, int type_bits);
+
+void cinn_call_top_k_host(void* v_args,
+                          int num_args,
+                          int outer,
+                          int axis_size,
+                          int inner,
+                          int k,
+                          bool largest,
+                          int type_code,
+                          int type_bits);
+//@}
+
+//! scan extern function called by custom call, the input is viewed as [outer, axis_size, inner] and scanned along the
+//! middle axis in O(n), `scan_type` is 0 for sum, 1 for prod, 2 for max and 3 for min.
+void cinn_call_scan_host(void* v_args,
+                         int num_args,
+                         int outer,
+                         int axis_size,
+                         int inner,
+                         int scan_type,
+                         bool exclusive,
+                         bool reverse,
+                         int type_code,
+                         int type_bits);
+
+//! normalization extern functions called by custom call, layer_norm and rms_norm normalize every row of a
+//! [rows, cols] input with the statistics computed in one pass, softmax views the input as [outer, axis_size, inner]
+//! and normalizes along the middle axis.
+//@{
+void cinn_call_layer_norm_host(
+    void* v_args, int num_args, int rows, int cols, float epsilon, int type_code, int type_bits);
+
+void cinn_call_rms_norm_host(
+    void* v_args, int num_args, int rows, int cols, float epsilon, int type_code, int type_bits);
+
+void cinn_call_softmax_host(
+    void* v_args, int num_args, int outer, int axis_size, int inner, int type_code, int type_bits);
+//@}
+
+//! GEMM micro-kernels called by the loop nests tensorized with the tensor intrinsics, each one computes a tile of
+//! C = (accumulate ? C : 0) + A * B of row-major matrices, the tile of an operand starts at its offset in the buffer
+//! and the rows of it are the leading dimension apart.
+//@{
+void cinn_host_gemm_6x16_fp32(const cinn_buffer_t* a,
+                              int a_offset,
+                              int lda,
+                              const cinn_buffer_t* b,
+                              int b_offset,
+                              int ldb,
+                              cinn_buffer_t* c,
+                              int c_offset,
+                              int ldc,
+                              int k,
+                              int accumulate);
+
+void cinn_host_dot_4x16_int8(const cinn_buffer_t* a,
+                             int a_offset,
+                             int lda,
+                             const cinn_buffer_t* b,
+                             int b_offset,
+                             int ldb,
+                             cinn_buffer_t* c,
+                             int c_offset,
+                             int ldc,
+                             int k,
+                             int accumulate);
+//@}
+
 inline int cinn_host_find_int(const cinn_buffer_t* buf, int size, int num);
 
 inline int cinn_host_find_float(const cinn_buffer_t* buf, int size, float num);
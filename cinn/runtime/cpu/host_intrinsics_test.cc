@@ -16,6 +16,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <vector>
+
 #include "cinn/backends/compiler.h"
 #include "cinn/backends/llvm/execution_engine.h"
 #include "cinn/backends/llvm/simple_jit.h"
@@ -23,6 +31,9 @@
 #include "cinn/common/ir_util.h"
 #include "cinn/common/target.h"
 #include "cinn/common/test_helper.h"
+#include "cinn/ir/ir_schedule.h"
+#include "cinn/lang/lower.h"
+#include "cinn/optim/optimize.h"
 #include "cinn/runtime/cpu/use_extern_funcs.h"
 
 namespace cinn {
@@ -203,6 +214,444 @@ TEST(cinn_host_gt_num_fp32, basic) {
   }
 }
 
+// The reference argsort of every row of a [outer, axis_size, inner] array along the middle axis.
+std::vector<int> ReferenceArgSort(const float* data, int outer, int axis_size, int inner, bool is_ascend) {
+  std::vector<int> res(outer * axis_size * inner);
+  for (int o = 0; o < outer; ++o) {
+    for (int i = 0; i < inner; ++i) {
+      int begin = o * axis_size * inner + i;
+      std::vector<int> index(axis_size);
+      std::iota(index.begin(), index.end(), 0);
+      std::stable_sort(index.begin(), index.end(), [&](int a, int b) {
+        return is_ascend ? data[begin + a * inner] < data[begin + b * inner]
+                         : data[begin + a * inner] > data[begin + b * inner];
+      });
+      for (int j = 0; j < axis_size; ++j) {
+        res[begin + j * inner] = index[j];
+      }
+    }
+  }
+  return res;
+}
+
+void TestHostArgSort(int outer, int axis_size, int inner, bool is_ascend) {
+  auto* x_buf     = common::BufferBuilder(Float(32), {outer, axis_size, inner}).set_random().Build();
+  auto* index_buf = common::BufferBuilder(Int(32), {outer, axis_size, inner}).set_zero().Build();
+  auto* rank_buf  = common::BufferBuilder(Int(32), {outer, axis_size, inner}).set_zero().Build();
+  auto* x_data    = reinterpret_cast<float*>(x_buf->memory);
+  // make a quarter of the elements equal to check the stability
+  for (int i = 0; i < x_buf->num_elements(); i += 4) {
+    x_data[i] = 0.5f;
+  }
+  auto args = common::ArgsBuilder().Add(x_buf).Add(index_buf).Add(rank_buf).Build();
+  cinn_call_argsort_host(args.data(), args.size(), outer, axis_size, inner, is_ascend, cinn_type_float, 32);
+
+  auto expected    = ReferenceArgSort(x_data, outer, axis_size, inner, is_ascend);
+  auto* index_data = reinterpret_cast<int*>(index_buf->memory);
+  auto* rank_data  = reinterpret_cast<int*>(rank_buf->memory);
+  for (int i = 0; i < x_buf->num_elements(); ++i) {
+    ASSERT_EQ(index_data[i], expected[i]) << "at " << i;
+  }
+  for (int o = 0; o < outer; ++o) {
+    for (int i = 0; i < inner; ++i) {
+      int begin = o * axis_size * inner + i;
+      for (int j = 0; j < axis_size; ++j) {
+        ASSERT_EQ(rank_data[begin + index_data[begin + j * inner] * inner], j);
+      }
+    }
+  }
+}
+
+TEST(cinn_call_argsort_host, basic) {
+  // std::stable_sort path
+  TestHostArgSort(3, 17, 5, true);
+  TestHostArgSort(3, 17, 5, false);
+  // radix sort path
+  TestHostArgSort(2, 1000, 3, true);
+  TestHostArgSort(2, 1000, 3, false);
+}
+
+TEST(cinn_call_sort_host, int64) {
+  int outer = 4, axis_size = 600;
+  auto* x_buf   = common::BufferBuilder(Int(64), {outer, axis_size}).set_zero().Build();
+  auto* out_buf = common::BufferBuilder(Int(64), {outer, axis_size}).set_zero().Build();
+  auto* x_data  = reinterpret_cast<int64_t*>(x_buf->memory);
+  for (int i = 0; i < x_buf->num_elements(); ++i) {
+    x_data[i] = (i * 7919LL % 1013 - 500) * (1LL << 33);
+  }
+  auto args = common::ArgsBuilder().Add(x_buf).Add(out_buf).Build();
+  cinn_call_sort_host(args.data(), args.size(), outer, axis_size, 1, true, cinn_type_int, 64);
+
+  auto* out_data = reinterpret_cast<int64_t*>(out_buf->memory);
+  for (int o = 0; o < outer; ++o) {
+    std::vector<int64_t> expected(x_data + o * axis_size, x_data + (o + 1) * axis_size);
+    std::sort(expected.begin(), expected.end());
+    for (int j = 0; j < axis_size; ++j) {
+      ASSERT_EQ(out_data[o * axis_size + j], expected[j]);
+    }
+  }
+}
+
+TEST(cinn_call_top_k_host, basic) {
+  int outer = 3, axis_size = 50000, inner = 2, k = 10;
+  auto* x_buf     = common::BufferBuilder(Float(32), {outer, axis_size, inner}).set_random().Build();
+  auto* value_buf = common::BufferBuilder(Float(32), {outer, k, inner}).set_zero().Build();
+  auto* index_buf = common::BufferBuilder(Int(64), {outer, k, inner}).set_zero().Build();
+  auto* x_data    = reinterpret_cast<float*>(x_buf->memory);
+  auto args       = common::ArgsBuilder().Add(x_buf).Add(value_buf).Add(index_buf).Build();
+
+  for (bool largest : {true, false}) {
+    auto start = std::chrono::steady_clock::now();
+    cinn_call_top_k_host(args.data(), args.size(), outer, axis_size, inner, k, largest, cinn_type_float, 32);
+    auto cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LOG(INFO) << "top_k (k = " << k << ") of " << outer * inner << " rows with " << axis_size
+              << " elements costs " << cost << " ms";
+
+    auto expected    = ReferenceArgSort(x_data, outer, axis_size, inner, !largest);
+    auto* value_data = reinterpret_cast<float*>(value_buf->memory);
+    auto* index_data = reinterpret_cast<int64_t*>(index_buf->memory);
+    for (int o = 0; o < outer; ++o) {
+      for (int j = 0; j < k; ++j) {
+        for (int i = 0; i < inner; ++i) {
+          int out_idx = (o * k + j) * inner + i;
+          int in_idx  = (o * axis_size + j) * inner + i;
+          ASSERT_EQ(index_data[out_idx], expected[in_idx]);
+          ASSERT_EQ(value_data[out_idx], x_data[(o * axis_size + expected[in_idx]) * inner + i]);
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+struct MaxOp {
+  T operator()(T a, T b) const { return std::max(a, b); }
+};
+
+// The reference scan of a [outer, axis_size, inner] array along the middle axis, computed element by element.
+template <typename T, typename Op>
+std::vector<T> ReferenceScan(const T* data, int outer, int axis_size, int inner, bool exclusive, bool reverse, T init) {
+  std::vector<T> res(outer * axis_size * inner);
+  for (int o = 0; o < outer; ++o) {
+    for (int i = 0; i < inner; ++i) {
+      T acc = init;
+      for (int p = 0; p < axis_size; ++p) {
+        int idx = (o * axis_size + (reverse ? axis_size - 1 - p : p)) * inner + i;
+        if (exclusive) {
+          res[idx] = acc;
+          acc      = Op()(acc, data[idx]);
+        } else {
+          acc      = Op()(acc, data[idx]);
+          res[idx] = acc;
+        }
+      }
+    }
+  }
+  return res;
+}
+
+void TestHostScan(int outer, int axis_size, int inner) {
+  auto* x_buf   = common::BufferBuilder(Int(64), {outer, axis_size, inner}).set_zero().Build();
+  auto* out_buf = common::BufferBuilder(Int(64), {outer, axis_size, inner}).set_zero().Build();
+  auto* x_data  = reinterpret_cast<int64_t*>(x_buf->memory);
+  for (int i = 0; i < x_buf->num_elements(); ++i) {
+    x_data[i] = i * 7919LL % 13 - 6;
+  }
+  auto* out_data = reinterpret_cast<int64_t*>(out_buf->memory);
+  auto args      = common::ArgsBuilder().Add(x_buf).Add(out_buf).Build();
+  for (bool exclusive : {false, true}) {
+    for (bool reverse : {false, true}) {
+      cinn_call_scan_host(args.data(), args.size(), outer, axis_size, inner, 0, exclusive, reverse, cinn_type_int, 64);
+      auto expected =
+          ReferenceScan<int64_t, std::plus<int64_t>>(x_data, outer, axis_size, inner, exclusive, reverse, 0);
+      for (int i = 0; i < x_buf->num_elements(); ++i) {
+        ASSERT_EQ(out_data[i], expected[i]) << "sum at " << i << ", exclusive = " << exclusive
+                                            << ", reverse = " << reverse;
+      }
+
+      cinn_call_scan_host(args.data(), args.size(), outer, axis_size, inner, 2, exclusive, reverse, cinn_type_int, 64);
+      expected = ReferenceScan<int64_t, MaxOp<int64_t>>(
+          x_data, outer, axis_size, inner, exclusive, reverse, std::numeric_limits<int64_t>::lowest());
+      for (int i = 0; i < x_buf->num_elements(); ++i) {
+        ASSERT_EQ(out_data[i], expected[i]) << "max at " << i << ", exclusive = " << exclusive
+                                            << ", reverse = " << reverse;
+      }
+    }
+  }
+}
+
+TEST(cinn_call_scan_host, basic) {
+  // rows along the last axis
+  TestHostScan(3, 17, 1);
+  // contiguous inner rows
+  TestHostScan(2, 33, 20);
+  // a single long row scanned by blocks
+  TestHostScan(1, 100000, 1);
+}
+
+TEST(cinn_call_scan_host, benchmark) {
+  int axis_size = 1 << 22;
+  auto* x_buf   = common::BufferBuilder(Float(32), {axis_size}).set_random().Build();
+  auto* out_buf = common::BufferBuilder(Float(32), {axis_size}).set_zero().Build();
+  auto args     = common::ArgsBuilder().Add(x_buf).Add(out_buf).Build();
+
+  auto start = std::chrono::steady_clock::now();
+  cinn_call_scan_host(args.data(), args.size(), 1, axis_size, 1, 0, false, false, cinn_type_float, 32);
+  auto cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  LOG(INFO) << "cumsum of " << axis_size << " elements costs " << cost << " ms";
+
+  auto* x_data   = reinterpret_cast<float*>(x_buf->memory);
+  auto* out_data = reinterpret_cast<float*>(out_buf->memory);
+  double sum     = 0;
+  for (int i = 0; i < axis_size; ++i) {
+    sum += x_data[i];
+  }
+  ASSERT_NEAR(out_data[axis_size - 1], sum, std::abs(sum) * 1e-3 + 1.0);
+}
+
+// The reference layer_norm of a [rows, cols] array in double by the two-pass variance.
+void ReferenceLayerNorm(const float* x,
+                        const float* scale,
+                        const float* bias,
+                        int rows,
+                        int cols,
+                        float epsilon,
+                        std::vector<double>* y,
+                        std::vector<double>* mean,
+                        std::vector<double>* variance) {
+  y->resize(rows * cols);
+  mean->resize(rows);
+  variance->resize(rows);
+  for (int r = 0; r < rows; ++r) {
+    double sum = 0;
+    for (int c = 0; c < cols; ++c) {
+      sum += x[r * cols + c];
+    }
+    (*mean)[r] = sum / cols;
+
+    double square_sum = 0;
+    for (int c = 0; c < cols; ++c) {
+      square_sum += (x[r * cols + c] - (*mean)[r]) * (x[r * cols + c] - (*mean)[r]);
+    }
+    (*variance)[r] = square_sum / cols;
+    for (int c = 0; c < cols; ++c) {
+      (*y)[r * cols + c] =
+          (x[r * cols + c] - (*mean)[r]) / std::sqrt((*variance)[r] + epsilon) * scale[c] + bias[c];
+    }
+  }
+}
+
+void TestHostLayerNorm(int rows, int cols, float offset) {
+  auto* x_buf        = common::BufferBuilder(Float(32), {rows, cols}).set_random().Build();
+  auto* scale_buf    = common::BufferBuilder(Float(32), {cols}).set_random().Build();
+  auto* bias_buf     = common::BufferBuilder(Float(32), {cols}).set_random().Build();
+  auto* y_buf        = common::BufferBuilder(Float(32), {rows, cols}).set_zero().Build();
+  auto* mean_buf     = common::BufferBuilder(Float(32), {rows}).set_zero().Build();
+  auto* variance_buf = common::BufferBuilder(Float(32), {rows}).set_zero().Build();
+  auto* x_data       = reinterpret_cast<float*>(x_buf->memory);
+  for (int i = 0; i < x_buf->num_elements(); ++i) {
+    x_data[i] += offset;
+  }
+  auto args =
+      common::ArgsBuilder().Add(x_buf).Add(scale_buf).Add(bias_buf).Add(y_buf).Add(mean_buf).Add(variance_buf).Build();
+  cinn_call_layer_norm_host(args.data(), args.size(), rows, cols, 1e-5f, cinn_type_float, 32);
+
+  std::vector<double> y, mean, variance;
+  ReferenceLayerNorm(x_data,
+                     reinterpret_cast<float*>(scale_buf->memory),
+                     reinterpret_cast<float*>(bias_buf->memory),
+                     rows,
+                     cols,
+                     1e-5f,
+                     &y,
+                     &mean,
+                     &variance);
+  auto* y_data        = reinterpret_cast<float*>(y_buf->memory);
+  auto* mean_data     = reinterpret_cast<float*>(mean_buf->memory);
+  auto* variance_data = reinterpret_cast<float*>(variance_buf->memory);
+  for (int r = 0; r < rows; ++r) {
+    ASSERT_NEAR(mean_data[r], mean[r], std::abs(mean[r]) * 1e-5 + 1e-5) << "mean of row " << r;
+    ASSERT_NEAR(variance_data[r], variance[r], variance[r] * 1e-3 + 1e-5) << "variance of row " << r;
+  }
+  for (int i = 0; i < rows * cols; ++i) {
+    ASSERT_NEAR(y_data[i], y[i], 1e-3) << "y at " << i;
+  }
+}
+
+TEST(cinn_call_layer_norm_host, basic) {
+  // the tails of the rows are not multiples of the lanes
+  TestHostLayerNorm(7, 13, 0.0f);
+  TestHostLayerNorm(64, 1024, 0.0f);
+  // E[x^2] - E[x]^2 loses all the digits of the variance in float32, while the one-pass Welford statistics keep them
+  TestHostLayerNorm(16, 4099, 1000.0f);
+}
+
+TEST(cinn_call_rms_norm_host, basic) {
+  int rows = 5, cols = 203;
+  auto* x_buf     = common::BufferBuilder(Float(64), {rows, cols}).set_random().Build();
+  auto* scale_buf = common::BufferBuilder(Float(64), {cols}).set_random().Build();
+  auto* y_buf     = common::BufferBuilder(Float(64), {rows, cols}).set_zero().Build();
+  auto args       = common::ArgsBuilder().Add(x_buf).Add(scale_buf).Add(y_buf).Build();
+  cinn_call_rms_norm_host(args.data(), args.size(), rows, cols, 1e-6f, cinn_type_float, 64);
+
+  auto* x_data     = reinterpret_cast<double*>(x_buf->memory);
+  auto* scale_data = reinterpret_cast<double*>(scale_buf->memory);
+  auto* y_data     = reinterpret_cast<double*>(y_buf->memory);
+  for (int r = 0; r < rows; ++r) {
+    double square_sum = 0;
+    for (int c = 0; c < cols; ++c) {
+      square_sum += x_data[r * cols + c] * x_data[r * cols + c];
+    }
+    double rstd = 1.0 / std::sqrt(square_sum / cols + 1e-6f);
+    for (int c = 0; c < cols; ++c) {
+      ASSERT_NEAR(y_data[r * cols + c], x_data[r * cols + c] * rstd * scale_data[c], 1e-9) << "row " << r;
+    }
+  }
+}
+
+void TestHostSoftmax(int outer, int axis_size, int inner) {
+  auto* x_buf   = common::BufferBuilder(Float(32), {outer, axis_size, inner}).set_random().Build();
+  auto* out_buf = common::BufferBuilder(Float(32), {outer, axis_size, inner}).set_zero().Build();
+  auto* x_data  = reinterpret_cast<float*>(x_buf->memory);
+  // the large inputs overflow exp without subtracting the max
+  for (int i = 0; i < x_buf->num_elements(); ++i) {
+    x_data[i] *= 100.0f;
+  }
+  auto args = common::ArgsBuilder().Add(x_buf).Add(out_buf).Build();
+  cinn_call_softmax_host(args.data(), args.size(), outer, axis_size, inner, cinn_type_float, 32);
+
+  auto* out_data = reinterpret_cast<float*>(out_buf->memory);
+  for (int o = 0; o < outer; ++o) {
+    for (int i = 0; i < inner; ++i) {
+      auto index     = [&](int a) { return (o * axis_size + a) * inner + i; };
+      double max_val = x_data[index(0)];
+      for (int a = 1; a < axis_size; ++a) {
+        max_val = std::max<double>(max_val, x_data[index(a)]);
+      }
+      double sum = 0;
+      for (int a = 0; a < axis_size; ++a) {
+        sum += std::exp(x_data[index(a)] - max_val);
+      }
+      for (int a = 0; a < axis_size; ++a) {
+        ASSERT_NEAR(out_data[index(a)], std::exp(x_data[index(a)] - max_val) / sum, 1e-5) << "softmax at " << index(a);
+      }
+    }
+  }
+}
+
+TEST(cinn_call_softmax_host, basic) {
+  // rows along the last axis
+  TestHostSoftmax(9, 77, 1);
+  // contiguous inner rows
+  TestHostSoftmax(3, 10, 17);
+}
+
+// The reference C = (accumulate ? C : 0) + A * B of a [m, n] tile in row-major matrices.
+template <typename InT, typename AccT>
+void ReferenceGemmTile(const InT* a, const InT* b, AccT* c, int lda, int ldb, int ldc, int m, int n, int k, bool acc) {
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      AccT sum = acc ? c[i * ldc + j] : AccT(0);
+      for (int p = 0; p < k; ++p) {
+        sum += static_cast<AccT>(a[i * lda + p]) * static_cast<AccT>(b[p * ldb + j]);
+      }
+      c[i * ldc + j] = sum;
+    }
+  }
+}
+
+TEST(cinn_host_dot_4x16_int8, basic) {
+  // the tile at row 1 and column 2 of the [8, 40] x [40, 24] matrices, reducing over the columns [3, 33) of A
+  int m = 8, n = 24, k = 40;
+
+  auto* a_buf = common::BufferBuilder(Int(8), {m, k}).set_random().Build();
+  auto* b_buf = common::BufferBuilder(Int(8), {k, n}).set_random().Build();
+  auto* c_buf = common::BufferBuilder(Int(32), {m, n}).set_zero().Build();
+  auto* a     = reinterpret_cast<int8_t*>(a_buf->memory);
+  auto* b     = reinterpret_cast<int8_t*>(b_buf->memory);
+  auto* c     = reinterpret_cast<int32_t*>(c_buf->memory);
+
+  int a_offset = 1 * k + 3, b_offset = 3 * n + 2, c_offset = 1 * n + 2;
+  for (int accumulate : {0, 1}) {
+    std::vector<int32_t> expect(c, c + m * n);
+    ReferenceGemmTile(a + a_offset, b + b_offset, expect.data() + c_offset, k, n, n, 4, 16, 30, accumulate);
+    cinn_host_dot_4x16_int8(a_buf, a_offset, k, b_buf, b_offset, n, c_buf, c_offset, n, 30, accumulate);
+    for (int i = 0; i < m * n; ++i) {
+      ASSERT_EQ(c[i], expect[i]) << "C at " << i << " with accumulate = " << accumulate;
+    }
+  }
+}
+
+// Lower C = A * B of [m, k] x [k, n] matrices, the [6, 16] tiles of C are tensorized with gemm_6x16_fp32 if
+// `tensorize` is true.
+ir::LoweredFunc LowerMatmul(const std::string& name, int m, int n, int k, bool tensorize) {
+  Context::Global().ResetNameId();
+  Target target = common::DefaultHostTarget();
+  Placeholder<float> A("A", {Expr(m), Expr(k)});
+  Placeholder<float> B("B", {Expr(k), Expr(n)});
+  Var reduce_k(k, "reduce_k");
+  auto C = Compute(
+      {Expr(m), Expr(n)},
+      [&](Var i, Var j) { return lang::ReduceSum(A(i, reduce_k) * B(reduce_k, j), {reduce_k}); },
+      "C");
+
+  auto funcs = lang::LowerVec(name, CreateStages({A, B, C}), {A, B, C}, {}, {}, nullptr, target, true);
+  CHECK_EQ(funcs.size(), 1U);
+
+  ir::IRSchedule ir_sch(ir::ModuleExpr({funcs[0]->body}));
+  if (tensorize) {
+    ir_sch.Split("C", 0, {-1, 6});
+    ir_sch.Split("C", 2, {-1, 16});
+    auto loops = ir_sch.GetLoops("C");
+    ir_sch.Reorder({loops[2], loops[1]});
+    ir_sch.Tensorize(ir_sch.GetLoops("C")[2], "gemm_6x16_fp32");
+  }
+
+  auto func = ir::_LoweredFunc_::Make(name, funcs[0]->args, ir_sch.GetModule().GetExprs()[0], {});
+  func      = optim::Optimize(Expr(func), target, false).as_lowered_func_ref();
+  func->PrepareBufferCastExprs(/*with_expr_gen_tensor = */ false);
+  return func;
+}
+
+TEST(cinn_host_gemm_6x16_fp32, tensorize_benchmark) {
+  int m = 192, n = 256, k = 256;
+  ir::Module::Builder builder("module1", common::DefaultHostTarget());
+  builder.AddFunction(LowerMatmul("naive_matmul", m, n, k, false));
+  builder.AddFunction(LowerMatmul("tensorized_matmul", m, n, k, true));
+  auto jit = backends::SimpleJIT::Create();
+  jit->Link(builder.Build());
+  auto naive_fn      = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("naive_matmul"));
+  auto tensorized_fn = reinterpret_cast<lower_func_ptr_t>(jit->Lookup("tensorized_matmul"));
+  ASSERT_TRUE(naive_fn);
+  ASSERT_TRUE(tensorized_fn);
+
+  auto* a_buf          = common::BufferBuilder(Float(32), {m, k}).set_random().Build();
+  auto* b_buf          = common::BufferBuilder(Float(32), {k, n}).set_random().Build();
+  auto* expect_buf     = common::BufferBuilder(Float(32), {m, n}).set_zero().Build();
+  auto* out_buf        = common::BufferBuilder(Float(32), {m, n}).set_zero().Build();
+  auto naive_args      = common::ArgsBuilder().Add(a_buf).Add(b_buf).Add(expect_buf).Build();
+  auto tensorized_args = common::ArgsBuilder().Add(a_buf).Add(b_buf).Add(out_buf).Build();
+
+  auto benchmark = [](lower_func_ptr_t fn, std::vector<cinn_pod_value_t>* args, const std::string& tag) {
+    int repeat = 10;
+    fn(args->data(), args->size());
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; ++i) {
+      fn(args->data(), args->size());
+    }
+    auto cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeat;
+    LOG(INFO) << tag << " matmul costs " << cost << " ms";
+  };
+  benchmark(naive_fn, &naive_args, "naive");
+  benchmark(tensorized_fn, &tensorized_args, "tensorized");
+
+  auto* expect = reinterpret_cast<float*>(expect_buf->memory);
+  auto* out    = reinterpret_cast<float*>(out_buf->memory);
+  for (int i = 0; i < m * n; ++i) {
+    ASSERT_NEAR(out[i], expect[i], std::abs(expect[i]) * 1e-4 + 1e-4) << "C at " << i;
+  }
+}
+
 }  // namespace cpu
 }  // namespace runtime
 }  // namespace cinn
@@ -53,7 +53,7 @@ DEFINE_int32(cinn_parallel_compile_thread,
 DEFINE_bool(cinn_use_op_fusion, BoolFromEnv("FLAGS_cinn_use_op_fusion", true), "Whether to use op fusion pass.");
 
 DEFINE_bool(cinn_use_common_subexpression_elimination,
-            BoolFromEnv("FLAGS_cinn_use_common_subexpression_elimination", false),
+            BoolFromEnv("FLAGS_cinn_use_common_subexpression_elimination", true),
             "Whether to use common subexpression elimination pass.");
 
 DEFINE_string(cinn_custom_call_deny_ops,
@@ -68,6 +68,10 @@ DEFINE_bool(cinn_use_fill_constant_folding,
             BoolFromEnv("FLAGS_cinn_use_fill_constant_folding", false),
             "Whether use the FillConstantFolding pass.");
 
+DEFINE_bool(cinn_use_param_folding,
+            BoolFromEnv("FLAGS_cinn_use_param_folding", true),
+            "Whether to evaluate the subgraphs which only depend on parameters at compile time.");
+
 DEFINE_string(cinn_check_fusion_accuracy_pass,
               StringFromEnv("FLAGS_cinn_check_fusion_accuracy_pass", ""),
               "Check the correct of fusion kernels, if the results not satisfied 'allclose(rtol=1e-05f, atol=1e-08f)', "
@@ -77,12 +81,28 @@ DEFINE_bool(cinn_use_cuda_vectorize,
             BoolFromEnv("FLAGS_cinn_use_cuda_vectorize", false),
             "Whether use cuda vectroize on schedule config");
 
+DEFINE_bool(cinn_use_cpu_reduce_schedule,
+            BoolFromEnv("FLAGS_cinn_use_cpu_reduce_schedule", true),
+            "Whether parallelize and vectorize the reduction groups on CPU.");
+
+DEFINE_bool(cinn_use_simplify_cache,
+            BoolFromEnv("FLAGS_cinn_use_simplify_cache", true),
+            "Whether memoize the simplified expressions when lowering the fusion groups.");
+
+DEFINE_bool(cinn_use_ir_node_arena,
+            BoolFromEnv("FLAGS_cinn_use_ir_node_arena", true),
+            "Whether recycle the memory of the IR nodes in a thread local arena when compiling the fusion groups.");
+
 DEFINE_bool(cinn_ir_schedule,
             BoolFromEnv("FLAGS_cinn_ir_schedule", true),
             "Whether use reconstructed schedule primitives.");
 
 DEFINE_bool(use_reduce_split_pass, BoolFromEnv("FLAGS_use_reduce_split_pass", false), "Whether use reduce split pass.");
 
+DEFINE_bool(cinn_use_horizontal_packing,
+            BoolFromEnv("FLAGS_cinn_use_horizontal_packing", false),
+            "Whether pack the independent small fusion groups into one function on CPU.");
+
 DEFINE_bool(cinn_use_dense_merge_pass,
             BoolFromEnv("FLAGS_cinn_use_dense_merge_pass", false),
             "Whether use dense merge pass.");
@@ -122,6 +142,10 @@ DEFINE_string(cinn_pass_visualize_dir,
 
 DEFINE_bool(enable_auto_tuner, BoolFromEnv("FLAGS_enable_auto_tuner", false), "Whether enable auto tuner.");
 
+DEFINE_string(cinn_tuning_record_file,
+              StringFromEnv("FLAGS_cinn_tuning_record_file", ""),
+              "Specify the file of tuning records to replay the recorded schedules without tuning.");
+
 DEFINE_bool(auto_schedule_use_cost_model,
             BoolFromEnv("FLAGS_auto_schedule_use_cost_model", true),
             "Whether to use cost model in auto schedule, this is an on-developing flag and it will be removed when "
@@ -131,6 +155,11 @@ DEFINE_bool(enhance_vertical_fusion_with_recompute,
             BoolFromEnv("FLAGS_enhance_vertical_fusion_with_recompute", true),
             "Whether to enhance check logic on vertical fusion with recompute");
 
+DEFINE_bool(cinn_use_fusion_cost_model,
+            BoolFromEnv("FLAGS_cinn_use_fusion_cost_model", false),
+            "Whether reject the vertical fusions estimated as slowdowns by the cost model of memory traffic and "
+            "recompute.");
+
 DEFINE_bool(verbose_function_register,
             BoolFromEnv("FLAGS_verbose_function_register", false),
             "Whether to verbose function regist log. This will only work if CINN build with flag -DWITH_DEBUG=ON.");
@@ -113,6 +113,9 @@ static const char* debug_log_repr = "cinn_print_debug_string";
 
 static const char* cuda_sync_threads = "__syncthreads";
 
+//! Name of the intrinsic to prefetch the element at an address into the cache on CPU.
+static const char* prefetch = "__builtin_prefetch";
+
 static const char* parallel_launch = "cinn_backend_parallel_launch";
 
 }  // namespace intrinsic
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2023 CINN Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import paddle
+import paddle.nn.functional as F
+import numpy as np
+from cinn.frontend import *
+from cinn.common import *
+from op_test import OpTest
+from op_test_helper import TestCaseHelper
+
+
+class TestLayerNormOp(OpTest):
+    def setUp(self):
+        print(f"\nRunning {self.__class__.__name__}: {self.case}")
+        self.inputs = {}
+        self.prepare_inputs()
+
+    def prepare_inputs(self):
+        shape = self.case["shape"]
+        self.begin_norm_axis = self.case["begin_norm_axis"]
+        # the scale and bias are flattened to the normalized size
+        norm_size = int(np.prod(shape[self.begin_norm_axis:]))
+        self.inputs = {
+            "x":
+            self.random(shape, self.case["dtype"], -1.0, 1.0) +
+            self.case["offset"],
+            "scale":
+            self.random([norm_size], self.case["dtype"], 0.5, 1.5),
+            "bias":
+            self.random([norm_size], self.case["dtype"], -1.0, 1.0),
+        }
+        self.epsilon = self.case["epsilon"]
+
+    def build_paddle_program(self, target):
+        x = paddle.to_tensor(self.inputs["x"], stop_gradient=True)
+        scale = paddle.to_tensor(self.inputs["scale"], stop_gradient=True)
+        bias = paddle.to_tensor(self.inputs["bias"], stop_gradient=True)
+        norm_shape = x.shape[self.begin_norm_axis:]
+        out = F.layer_norm(x, norm_shape, scale.reshape(norm_shape),
+                           bias.reshape(norm_shape), self.epsilon)
+        self.paddle_outputs = [out]
+
+    def build_cinn_program(self, target):
+        builder = NetBuilder("layer_norm")
+        x = builder.create_input(
+            self.nptype2cinntype(self.inputs["x"].dtype),
+            self.inputs["x"].shape, "x")
+        scale = builder.create_input(
+            self.nptype2cinntype(self.inputs["scale"].dtype),
+            self.inputs["scale"].shape, "scale")
+        bias = builder.create_input(
+            self.nptype2cinntype(self.inputs["bias"].dtype),
+            self.inputs["bias"].shape, "bias")
+        out = builder.layer_norm(x, scale, bias, self.epsilon,
+                                 self.begin_norm_axis)
+        prog = builder.build()
+        res = self.get_cinn_output(
+            prog, target, [x, scale, bias],
+            [self.inputs["x"], self.inputs["scale"], self.inputs["bias"]],
+            [out[0]])
+        self.cinn_outputs = res
+
+    def test_check_results(self):
+        self.check_outputs_and_grads(max_relative_error=1e-4)
+
+
+class TestLayerNormOpShape(TestCaseHelper):
+    def init_attrs(self):
+        self.class_name = "TestLayerNormOpShape"
+        self.cls = TestLayerNormOp
+        self.inputs = [
+            {
+                "shape": [16, 1000],
+                "begin_norm_axis": 1,
+            },
+            {
+                "shape": [4, 7, 3],
+                "begin_norm_axis": 1,
+            },
+            {
+                "shape": [8, 16, 768],
+                "begin_norm_axis": 2,
+            },
+        ]
+        self.dtypes = [
+            {
+                "dtype": "float32"
+            },
+            {
+                "dtype": "float64"
+            },
+        ]
+        self.attrs = [
+            {
+                "epsilon": 1e-5,
+                "offset": 0.0,
+            },
+            {
+                # E[x^2] - E[x]^2 loses the variance of the inputs far away from zero
+                "epsilon": 1e-5,
+                "offset": 100.0,
+            },
+        ]
+
+
+if __name__ == "__main__":
+    TestLayerNormOpShape().run()
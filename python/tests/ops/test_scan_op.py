@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2023 CINN Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import paddle
+import numpy as np
+from cinn.frontend import *
+from cinn.common import *
+from op_test import OpTest
+from op_test_helper import TestCaseHelper
+
+
+class TestScanOp(OpTest):
+    def setUp(self):
+        print(f"\nRunning {self.__class__.__name__}: {self.case}")
+        self.inputs = {}
+        self.prepare_inputs()
+
+    def prepare_inputs(self):
+        self.inputs = {
+            "x": self.random(self.case["shape"], self.case["dtype"], -1.0,
+                             1.0)
+        }
+        self.axis = self.case["axis"]
+        self.scan_type = self.case["scan_type"]
+        self.exclusive = self.case["exclusive"]
+        self.reverse = self.case["reverse"]
+
+    def build_paddle_program(self, target):
+        x = self.inputs["x"]
+        if self.reverse:
+            x = np.flip(x, self.axis)
+        if self.scan_type == "sum":
+            out = np.cumsum(x, self.axis)
+            init = 0
+        else:
+            out = np.cumprod(x, self.axis)
+            init = 1
+        if self.exclusive:
+            out = np.roll(out, 1, self.axis)
+            index = [slice(None)] * out.ndim
+            index[self.axis] = 0
+            out[tuple(index)] = init
+        if self.reverse:
+            out = np.flip(out, self.axis)
+        self.paddle_outputs = [
+            paddle.to_tensor(
+                np.ascontiguousarray(out).astype(self.inputs["x"].dtype),
+                stop_gradient=True)
+        ]
+
+    def build_cinn_program(self, target):
+        builder = NetBuilder("scan")
+        x = builder.create_input(
+            self.nptype2cinntype(self.inputs["x"].dtype),
+            self.inputs["x"].shape, "x")
+        out = builder.scan(x, self.axis, self.scan_type, self.exclusive,
+                           self.reverse)
+        prog = builder.build()
+        res = self.get_cinn_output(prog, target, [x], [self.inputs["x"]],
+                                   [out])
+        self.cinn_outputs = res
+
+    def test_check_results(self):
+        self.check_outputs_and_grads()
+
+
+class TestScanOpShape(TestCaseHelper):
+    def init_attrs(self):
+        self.class_name = "TestScanOpShape"
+        self.cls = TestScanOp
+        self.inputs = [
+            {
+                "shape": [1],
+                "axis": 0,
+            },
+            {
+                "shape": [4096],
+                "axis": 0,
+            },
+            {
+                "shape": [8, 1000],
+                "axis": 1,
+            },
+            {
+                "shape": [16, 300, 32],
+                "axis": 1,
+            },
+        ]
+        self.dtypes = [
+            {
+                "dtype": "float32"
+            },
+            {
+                "dtype": "float64"
+            },
+        ]
+        self.attrs = [
+            {
+                "scan_type": "sum",
+                "exclusive": False,
+                "reverse": False,
+            },
+            {
+                "scan_type": "sum",
+                "exclusive": True,
+                "reverse": True,
+            },
+        ]
+
+
+class TestScanOpAttrs(TestCaseHelper):
+    def init_attrs(self):
+        self.class_name = "TestScanOpAttrs"
+        self.cls = TestScanOp
+        self.inputs = [
+            {
+                "shape": [4, 7, 3],
+                "axis": 1,
+            },
+        ]
+        self.dtypes = [
+            {
+                "dtype": "float32"
+            },
+        ]
+        self.attrs = [{
+            "scan_type": scan_type,
+            "exclusive": exclusive,
+            "reverse": reverse,
+        } for scan_type in ["sum", "prod"] for exclusive in [False, True]
+                      for reverse in [False, True]]
+
+
+if __name__ == "__main__":
+    TestScanOpShape().run()
+    TestScanOpAttrs().run()